@@ -9,6 +9,22 @@
 # To run a different test (e.g., fp32_mul):
 #   make run DUT=fp32_mul TEST=random_test
 #
+# Non-UVM testbench tops (e.g. fp_softmax) report a "FAIL :" line instead:
+#   make run DUT=fp_softmax WIDTH=32
+#
+# Extra plusargs are passed with PLUSARGS, e.g.:
+#   make run DUT=fp_mul TEST=random_test PLUSARGS="+SB_VERBOSE"
+#
+# fp_add, fp_mul and fp_classify at all widths in one elaboration, the units
+# and their tests selected with +FP_MULTI (verif/tests/fp_multi):
+#   make run DUT=fp_multi TEST=test PLUSARGS="+FP_MULTI=fp_add:32,fp_mul:64:random_test"
+#
+# To run the DUTS x TESTS x WIDTHS matrix in parallel (scripts/regress.py):
+#   make regress WIDTHS="16 32" SEEDS=4 JOBS=8
+#   make regress SEEDS=4 REGRESS_ARGS="--pack"
+# Passing runs are cached by source hash (build/regress_cache); to rerun all:
+#   make regress REGRESS_ARGS="--force"
+#
 # Verified on:
 # - Windows 11 (64-bit): DSim Studio terminal
 
@@ -31,7 +47,12 @@ WIDTH  ?= 16
 WIDTHS ?= 16 32 64
 
 SRC_FILES_LIST   ?= verif/filelist.libs.txt
-C_MODEL_FILES    ?= verif/lib/fp_model.c verif/lib/fp16_model.c verif/lib/fp32_model.c verif/lib/fp64_model.c verif/lib/fp_dpi_utils.c
+C_MODEL_FILES    ?= verif/lib/fp_model.c verif/lib/fp16_model.c verif/lib/fp32_model.c verif/lib/fp64_model.c verif/lib/fp_dpi_utils.c verif/lib/fp_cov_steer.c verif/lib/fp_inverse.c verif/lib/fp_fast.c verif/lib/fp_softmax_model.cpp verif/lib/fp_reduce_model.cpp verif/lib/fp_sort_model.cpp verif/lib/bfp_model.cpp verif/lib/fp_kulisch_model.cpp
+PLUSARGS         ?=
+
+SEEDS            ?= 1
+REGRESS_ARGS     ?=
+JOBS             ?= $(shell nproc 2>/dev/null || echo 1)
 
 # Set DUTS to a single test if DUT is provided on the command line
 ifeq ($(origin DUT), command line)
@@ -83,13 +104,13 @@ SIMULATOR_FLAGS = \
 	-suppress IneffectiveDynamicCast:UninstVif
 
 # Runtime Plusargs
-RUN_PLUSARGS = +UVM_TESTNAME=$(DUT)_$(TEST)
+RUN_PLUSARGS = +UVM_TESTNAME=$(DUT)_$(TEST) $(PLUSARGS)
 
 #==============================================================================
 # Targets
 #==============================================================================
 
-.PHONY: all compile run clean results
+.PHONY: all compile run clean results regress
 
 all:
 	@echo "--- Running all DUTS: [$(DUTS)] TESTS: [$(TESTS)] WIDTHS: [$(WIDTHS)] ---"
@@ -114,7 +135,7 @@ compile:
 run: compile
 	@# Run simulation and capture result
 	@echo "--- Running Test: $(TEST) on $(DUT) $(WIDTH) ---"
-	@if $(SIMULATOR) $(SIMULATOR_FLAGS) $(RUN_PLUSARGS) 2>&1 | tee sim_$(DUT)_$(WIDTH)_$(TEST).log | grep -E "UVM_ERROR\s+:\s+[1-9]\d*|UVM_FATAL\s+:\s+[1-9]\d*" > /dev/null; then \
+	@if $(SIMULATOR) $(SIMULATOR_FLAGS) $(RUN_PLUSARGS) 2>&1 | tee sim_$(DUT)_$(WIDTH)_$(TEST).log | grep -E "UVM_ERROR\s+:\s+[1-9]\d*|UVM_FATAL\s+:\s+[1-9]\d*|^FAIL :" > /dev/null; then \
 		echo "$(DUT),$(WIDTH),$(TEST),FAIL (sim)" >> $(RESULTS); \
 	else \
 		echo "$(DUT),$(WIDTH),$(TEST),PASS" >> $(RESULTS); \
@@ -144,6 +165,9 @@ results:
 	fi
 	@echo "========================================================================="
 
+regress:
+	@python3 scripts/regress.py --duts $(DUTS) --tests $(TESTS) --widths $(WIDTHS) --seeds $(SEEDS) -j $(JOBS) --plusargs "$(PLUSARGS)" --c-model-files $(C_MODEL_FILES) $(REGRESS_ARGS)
+
 clean:
 	@echo "--- Cleaning up DSim files ---"
 	rm -rf *.log *.syn DSim.sln dsim_work/ *.so *.o *.dll $(RESULTS)
@@ -0,0 +1,256 @@
+# Makefile for building and running the native (simulator-free) C tools.
+#
+# The C reference models in verif/lib are normally linked into the simulator
+# through DPI-C. This Makefile builds them with the host compiler into
+# standalone harnesses, so model-level experiments run without a simulator.
+#
+# Usage:
+#   make -f native.mk              - Builds all native tools.
+#   make -f native.mk cov_steer    - Builds and runs the coverage steering benchmark.
+#   make -f native.mk inverse      - Builds and runs the inverse operand construction self-check.
+#   make -f native.mk vectors      - Writes inverse-constructed vector files to $(VECTOR_DIR).
+#   make -f native.mk fast         - Builds and runs the dual-path predictor benchmark.
+#   make -f native.mk fast_sweep   - Builds and runs the dual-path predictor equivalence sweep.
+#   make -f native.mk systolic     - Builds and runs the multi-precision systolic reference self-check.
+#   make -f native.mk spad         - Builds and runs the systolic tile scratchpad bandwidth study.
+#   make -f native.mk systolic_part - Builds and runs the systolic array partitioning utilization study.
+#   make -f native.mk softmax      - Builds and runs the streaming softmax benchmark.
+#   make -f native.mk reduce       - Builds and runs the reduction tree accuracy benchmark.
+#   make -f native.mk int          - Builds and runs the integer library model self-check.
+#   make -f native.mk sort         - Builds and runs the comparator / sorting network / top-k self-check and benchmark.
+#   make -f native.mk bfp          - Builds and runs the block floating point self-check and error statistics.
+#   make -f native.mk kulisch      - Builds and runs the exact dot product accumulator self-check and benchmark.
+#   make -f native.mk lut          - Builds the LUT generator and checks the reciprocal / inverse square root LUT modules.
+#   make -f native.mk clean        - Removes the build directory.
+#
+# Arguments can be passed to the harness, e.g.:
+#   make -f native.mk cov_steer COV_STEER_ARGS="--op mul --width 32 --report"
+#   make -f native.mk inverse INVERSE_ARGS="--op fma --width 64 --count 10000"
+#   make -f native.mk fast FAST_ARGS="--op mul --width 64"
+#   make -f native.mk systolic SYSTOLIC_ARGS="--jobs 100000"
+#   make -f native.mk spad SPAD_ARGS="--rows 8 --banks 16"
+#   make -f native.mk systolic_part PART_ARGS="--rows 32 --part-rows 4 --part-cols 4"
+#   make -f native.mk softmax SOFTMAX_ARGS="--width 32 --len 1024 --rows 32"
+#   make -f native.mk reduce REDUCE_ARGS="--width 32 --n 4096 --guard 16"
+#   make -f native.mk int INT_ARGS="--count 10000000 --seed 7"
+#   make -f native.mk sort SORT_ARGS="--width 32 --n 64 --k 8" CXXFLAGS="-O2 -std=c++17 -march=native"
+#   make -f native.mk bfp BFP_ARGS="--count 100000" CXXFLAGS="-O2 -std=c++17 -march=native"
+#   make -f native.mk kulisch KULISCH_ARGS="--width 32 --n 4096 --rows 50"
+#   make -f native.mk lut LUT_ARGS="--write"
+
+SHELL := /bin/bash
+MAKEFLAGS += --no-builtin-rules
+
+#==============================================================================
+# Configurable Variables (can be overridden from the command line)
+#==============================================================================
+
+CC            ?= gcc
+CFLAGS        ?= -O2 -Wall
+CXX           ?= g++
+CXXFLAGS      ?= -O2 -Wall -std=c++17
+BUILD_DIR     ?= build/native
+
+# svdpi.h is included by the DPI-C sources (types only, no simulator library is linked)
+DSIM_INCLUDE  ?= /opt/Altair/DSim/2025.1/include
+
+COV_STEER_ARGS ?=
+INVERSE_ARGS   ?=
+FAST_ARGS      ?=
+SYSTOLIC_ARGS  ?=
+SPAD_ARGS      ?=
+PART_ARGS      ?=
+SOFTMAX_ARGS   ?=
+REDUCE_ARGS    ?=
+INT_ARGS       ?=
+SORT_ARGS      ?=
+BFP_ARGS       ?=
+KULISCH_ARGS   ?=
+LUT_ARGS       ?=
+VECTOR_DIR     ?= $(BUILD_DIR)/vectors
+
+#==============================================================================
+# Static Variables (derived from the above)
+#==============================================================================
+
+VERIF_LIB_DIR = verif/lib
+
+INCLUDES      = -I$(VERIF_LIB_DIR) -I$(DSIM_INCLUDE)
+LDLIBS        = -lm
+
+FP_MODEL_SRCS = $(VERIF_LIB_DIR)/fp_model.c
+FP_MODEL_HDRS = $(VERIF_LIB_DIR)/fp_model.h
+
+COV_STEER_BIN  = $(BUILD_DIR)/fp_cov_steer_bench
+COV_STEER_SRCS = $(VERIF_LIB_DIR)/fp_cov_steer_bench.c $(VERIF_LIB_DIR)/fp_cov_steer.c $(FP_MODEL_SRCS)
+COV_STEER_HDRS = $(VERIF_LIB_DIR)/fp_cov_steer.h $(FP_MODEL_HDRS)
+
+INVERSE_BIN    = $(BUILD_DIR)/fp_inverse_gen
+INVERSE_SRCS   = $(VERIF_LIB_DIR)/fp_inverse_gen.c $(VERIF_LIB_DIR)/fp_inverse.c $(FP_MODEL_SRCS)
+INVERSE_HDRS   = $(VERIF_LIB_DIR)/fp_inverse.h $(FP_MODEL_HDRS)
+
+FAST_BIN       = $(BUILD_DIR)/fp_fast_bench
+FAST_SRCS      = $(VERIF_LIB_DIR)/fp_fast_bench.c $(VERIF_LIB_DIR)/fp_fast.c $(FP_MODEL_SRCS)
+FAST_HDRS      = $(VERIF_LIB_DIR)/fp_fast.h $(FP_MODEL_HDRS)
+
+SYSTOLIC_BIN   = $(BUILD_DIR)/systolic_model_check
+SYSTOLIC_SRCS  = $(VERIF_LIB_DIR)/systolic_model_check.cpp $(VERIF_LIB_DIR)/systolic_model.cpp
+SYSTOLIC_HDRS  = $(VERIF_LIB_DIR)/systolic_model.h
+
+SPAD_BIN       = $(BUILD_DIR)/systolic_spad_bench
+SPAD_SRCS      = $(VERIF_LIB_DIR)/systolic_spad_bench.cpp $(VERIF_LIB_DIR)/systolic_spad_model.cpp
+SPAD_HDRS      = $(VERIF_LIB_DIR)/systolic_spad_model.h
+
+PART_BIN       = $(BUILD_DIR)/systolic_part_bench
+PART_SRCS      = $(VERIF_LIB_DIR)/systolic_part_bench.cpp $(VERIF_LIB_DIR)/systolic_model.cpp
+PART_HDRS      = $(VERIF_LIB_DIR)/systolic_model.h
+
+# C++ harness on top of the C model: fp_model.c is compiled as C into its own object
+FP_MODEL_OBJ   = $(BUILD_DIR)/fp_model.o
+
+SOFTMAX_BIN    = $(BUILD_DIR)/fp_softmax_bench
+SOFTMAX_SRCS   = $(VERIF_LIB_DIR)/fp_softmax_bench.cpp $(VERIF_LIB_DIR)/fp_softmax_model.cpp
+SOFTMAX_HDRS   = $(VERIF_LIB_DIR)/fp_softmax_model.h $(FP_MODEL_HDRS)
+
+REDUCE_BIN     = $(BUILD_DIR)/fp_reduce_bench
+REDUCE_SRCS    = $(VERIF_LIB_DIR)/fp_reduce_bench.cpp $(VERIF_LIB_DIR)/fp_reduce_model.cpp
+REDUCE_HDRS    = $(VERIF_LIB_DIR)/fp_reduce_model.h $(FP_MODEL_HDRS)
+
+INT_BIN        = $(BUILD_DIR)/int_model_check
+INT_SRCS       = $(VERIF_LIB_DIR)/int_model_check.c $(VERIF_LIB_DIR)/int_model.c
+INT_HDRS       = $(VERIF_LIB_DIR)/int_model.h
+
+SORT_BIN       = $(BUILD_DIR)/fp_sort_bench
+SORT_SRCS      = $(VERIF_LIB_DIR)/fp_sort_bench.cpp $(VERIF_LIB_DIR)/fp_sort_model.cpp
+SORT_HDRS      = $(VERIF_LIB_DIR)/fp_sort_model.h
+
+BFP_BIN        = $(BUILD_DIR)/bfp_bench
+BFP_SRCS       = $(VERIF_LIB_DIR)/bfp_bench.cpp $(VERIF_LIB_DIR)/bfp_model.cpp
+BFP_HDRS       = $(VERIF_LIB_DIR)/bfp_model.h
+
+KULISCH_BIN    = $(BUILD_DIR)/fp_kulisch_bench
+KULISCH_SRCS   = $(VERIF_LIB_DIR)/fp_kulisch_bench.cpp $(VERIF_LIB_DIR)/fp_kulisch_model.cpp
+KULISCH_HDRS   = $(VERIF_LIB_DIR)/fp_kulisch_model.h $(FP_MODEL_HDRS)
+
+LUT_BIN        = $(BUILD_DIR)/fp_lut_gen
+LUT_SRCS       = $(VERIF_LIB_DIR)/fp_lut_gen.cpp $(VERIF_LIB_DIR)/fp_lut.cpp
+LUT_HDRS       = $(VERIF_LIB_DIR)/fp_lut.h
+
+#==============================================================================
+# Targets
+#==============================================================================
+
+.PHONY: all cov_steer inverse vectors fast fast_sweep systolic spad systolic_part softmax reduce int sort bfp kulisch lut clean
+
+all: $(COV_STEER_BIN) $(INVERSE_BIN) $(FAST_BIN) $(SYSTOLIC_BIN) $(SPAD_BIN) $(PART_BIN) $(SOFTMAX_BIN) $(REDUCE_BIN) \
+     $(INT_BIN) $(SORT_BIN) $(BFP_BIN) $(KULISCH_BIN) $(LUT_BIN)
+
+$(BUILD_DIR):
+	@mkdir -p $@
+
+$(COV_STEER_BIN): $(COV_STEER_SRCS) $(COV_STEER_HDRS) | $(BUILD_DIR)
+	$(CC) $(CFLAGS) $(INCLUDES) -o $@ $(COV_STEER_SRCS) $(LDLIBS)
+
+cov_steer: $(COV_STEER_BIN)
+	@echo "--- Running coverage steering benchmark ---"
+	@$(COV_STEER_BIN) $(COV_STEER_ARGS)
+
+$(INVERSE_BIN): $(INVERSE_SRCS) $(INVERSE_HDRS) | $(BUILD_DIR)
+	$(CC) $(CFLAGS) $(INCLUDES) -o $@ $(INVERSE_SRCS) $(LDLIBS)
+
+inverse: $(INVERSE_BIN)
+	@echo "--- Running inverse operand construction self-check ---"
+	@$(INVERSE_BIN) $(INVERSE_ARGS)
+
+vectors: $(INVERSE_BIN)
+	@mkdir -p $(VECTOR_DIR)
+	@echo "--- Writing inverse-constructed vectors to $(VECTOR_DIR) ---"
+	@$(INVERSE_BIN) --random 0 --out $(VECTOR_DIR) $(INVERSE_ARGS)
+
+$(FAST_BIN): $(FAST_SRCS) $(FAST_HDRS) | $(BUILD_DIR)
+	$(CC) $(CFLAGS) $(INCLUDES) -o $@ $(FAST_SRCS) $(LDLIBS)
+
+fast: $(FAST_BIN)
+	@echo "--- Running dual-path predictor benchmark ---"
+	@$(FAST_BIN) $(FAST_ARGS)
+
+fast_sweep: $(FAST_BIN)
+	@echo "--- Running dual-path predictor equivalence sweep ---"
+	@$(FAST_BIN) --sweep $(FAST_ARGS)
+
+$(SYSTOLIC_BIN): $(SYSTOLIC_SRCS) $(SYSTOLIC_HDRS) | $(BUILD_DIR)
+	$(CXX) $(CXXFLAGS) -I$(VERIF_LIB_DIR) -o $@ $(SYSTOLIC_SRCS)
+
+systolic: $(SYSTOLIC_BIN)
+	@echo "--- Running multi-precision systolic reference self-check ---"
+	@$(SYSTOLIC_BIN) $(SYSTOLIC_ARGS)
+
+$(SPAD_BIN): $(SPAD_SRCS) $(SPAD_HDRS) | $(BUILD_DIR)
+	$(CXX) $(CXXFLAGS) -I$(VERIF_LIB_DIR) -o $@ $(SPAD_SRCS)
+
+spad: $(SPAD_BIN)
+	@echo "--- Running systolic tile scratchpad bandwidth study ---"
+	@$(SPAD_BIN) $(SPAD_ARGS)
+
+$(PART_BIN): $(PART_SRCS) $(PART_HDRS) | $(BUILD_DIR)
+	$(CXX) $(CXXFLAGS) -I$(VERIF_LIB_DIR) -o $@ $(PART_SRCS)
+
+systolic_part: $(PART_BIN)
+	@echo "--- Running systolic array partitioning utilization study ---"
+	@$(PART_BIN) $(PART_ARGS)
+
+$(FP_MODEL_OBJ): $(FP_MODEL_SRCS) $(FP_MODEL_HDRS) | $(BUILD_DIR)
+	$(CC) $(CFLAGS) $(INCLUDES) -c -o $@ $(FP_MODEL_SRCS)
+
+$(SOFTMAX_BIN): $(SOFTMAX_SRCS) $(SOFTMAX_HDRS) $(FP_MODEL_OBJ) | $(BUILD_DIR)
+	$(CXX) $(CXXFLAGS) $(INCLUDES) -o $@ $(SOFTMAX_SRCS) $(FP_MODEL_OBJ) $(LDLIBS)
+
+softmax: $(SOFTMAX_BIN)
+	@echo "--- Running streaming softmax benchmark ---"
+	@$(SOFTMAX_BIN) $(SOFTMAX_ARGS)
+
+$(REDUCE_BIN): $(REDUCE_SRCS) $(REDUCE_HDRS) $(FP_MODEL_OBJ) | $(BUILD_DIR)
+	$(CXX) $(CXXFLAGS) $(INCLUDES) -o $@ $(REDUCE_SRCS) $(FP_MODEL_OBJ) $(LDLIBS)
+
+reduce: $(REDUCE_BIN)
+	@echo "--- Running reduction tree accuracy benchmark ---"
+	@$(REDUCE_BIN) $(REDUCE_ARGS)
+
+$(INT_BIN): $(INT_SRCS) $(INT_HDRS) | $(BUILD_DIR)
+	$(CC) $(CFLAGS) -I$(VERIF_LIB_DIR) -o $@ $(INT_SRCS)
+
+int: $(INT_BIN)
+	@echo "--- Running integer library model self-check ---"
+	@$(INT_BIN) $(INT_ARGS)
+
+$(SORT_BIN): $(SORT_SRCS) $(SORT_HDRS) | $(BUILD_DIR)
+	$(CXX) $(CXXFLAGS) -I$(VERIF_LIB_DIR) -o $@ $(SORT_SRCS)
+
+sort: $(SORT_BIN)
+	@echo "--- Running comparator / sorting network / top-k self-check and benchmark ---"
+	@$(SORT_BIN) $(SORT_ARGS)
+
+$(BFP_BIN): $(BFP_SRCS) $(BFP_HDRS) | $(BUILD_DIR)
+	$(CXX) $(CXXFLAGS) -I$(VERIF_LIB_DIR) -o $@ $(BFP_SRCS)
+
+bfp: $(BFP_BIN)
+	@echo "--- Running block floating point self-check and error statistics ---"
+	@$(BFP_BIN) $(BFP_ARGS)
+
+$(KULISCH_BIN): $(KULISCH_SRCS) $(KULISCH_HDRS) $(FP_MODEL_OBJ) | $(BUILD_DIR)
+	$(CXX) $(CXXFLAGS) $(INCLUDES) -o $@ $(KULISCH_SRCS) $(FP_MODEL_OBJ) $(LDLIBS)
+
+kulisch: $(KULISCH_BIN)
+	@echo "--- Running exact dot product accumulator self-check and benchmark ---"
+	@$(KULISCH_BIN) $(KULISCH_ARGS)
+
+$(LUT_BIN): $(LUT_SRCS) $(LUT_HDRS) | $(BUILD_DIR)
+	$(CXX) $(CXXFLAGS) -I$(VERIF_LIB_DIR) -o $@ $(LUT_SRCS)
+
+lut: $(LUT_BIN)
+	@echo "--- Running reciprocal / inverse square root LUT check ---"
+	@$(LUT_BIN) $(LUT_ARGS)
+
+clean:
+	@echo "--- Cleaning up native build ---"
+	rm -rf $(BUILD_DIR)
@@ -15,9 +15,11 @@
 
 `include "common_inc.vh"
 `include "grs_round.vh"  // \`RNE, etc.
+`include "adders.vh"     // \`ADDER_BEHAVIORAL, etc.
 
 module fp_add #(
-    parameter WIDTH  = 16
+    parameter WIDTH  = 16,
+    parameter ADDER_TOPOLOGY = `ADDER_BEHAVIORAL  // Mantissa adder (see adders.vh)
 ) (
     input clk,
     input rst_n,
@@ -164,6 +166,24 @@ module fp_add #(
     //----------------------------------------------------------------
     // Stage 2: Add or Subtract
     //----------------------------------------------------------------
+
+    // Stage 2 Combinational Logic
+    // s1_mant_a_q holds the larger magnitude, so a subtraction never borrows.
+    wire [ALIGN_MANT_W-1:0]   mant_sum;
+    wire                      mant_carry;
+    fas_vec_prefix #(
+        .WIDTH(ALIGN_MANT_W),
+        .TOPOLOGY(ADDER_TOPOLOGY)
+    ) u_mant_adder (
+        .a(s1_mant_a_q),
+        .b(s1_mant_b_q),
+        .cin(1'b0),
+        .add_nsub(s1_op_is_sub_q),
+        .z(mant_sum),
+        .cout(mant_carry)
+    );
+
+    // Stage 2 Pipeline
     reg  [EXP_W-1:0]          s2_exp_q;
     reg                       s2_sign_q;
     reg  [1+ALIGN_MANT_W-1:0] s2_mant_q;  // 1 bit for carry
@@ -184,13 +204,8 @@ module fp_add #(
             s2_special_result_q <= s1_special_result_q;
             s2_rm_q             <= s1_rm_q;
 
-            if (s1_op_is_sub_q) begin
-                s2_mant_q <= {1'b0, s1_mant_a_q} - {1'b0, s1_mant_b_q};
-                s2_sign_q <= s1_result_sign_q;
-            end else begin
-                s2_mant_q <= {1'b0, s1_mant_a_q} + {1'b0, s1_mant_b_q};
-                s2_sign_q <= s1_result_sign_q;
-            end
+            s2_mant_q <= {mant_carry & ~s1_op_is_sub_q, mant_sum};
+            s2_sign_q <= s1_result_sign_q;
         end
     end
 
@@ -238,6 +253,7 @@ module fp_add #(
     reg                       s3_sign_q;
     reg         [ALIGN_MANT_W-1:0]   s3_final_mant;
     reg  signed [EXP_W:0]            s3_final_exp;
+    reg  signed [EXP_W:0]            s3_final_exp_p1;
     reg                       s3_mant_zero_q;
     reg  [2:0]                s3_rm_q;
 
@@ -248,6 +264,7 @@ module fp_add #(
             s3_sign_q            <= 0;
             s3_final_mant        <= 0;
             s3_final_exp         <= 0;
+            s3_final_exp_p1      <= 0;
             s3_mant_zero_q       <= 0;
             s3_rm_q              <= `RNE;
         end else begin
@@ -256,6 +273,8 @@ module fp_add #(
             s3_sign_q            <= s2_sign_q;
             s3_final_mant        <= final_mant;
             s3_final_exp         <= final_exp;
+            // Exponent for a rounding carry-out, precomputed off the stage 4 path
+            s3_final_exp_p1      <= final_exp + 1;
             s3_mant_zero_q       <= (s2_mant_q == 0);
             s3_rm_q              <= s2_rm_q;
         end
@@ -288,11 +307,14 @@ module fp_add #(
             out_exp = EXP_ALL_ZEROS;
             out_mant = MANT_ALL_ZEROS;
         end else begin
-            // Handle exponent adjustment from rounding overflow
-            final_exp_rounded = s3_final_exp + rounder_overflow;
-
-            // The final mantissa is the output of the rounder, dropping the implicit bit
-            out_mant = rounder_overflow ? rounded_mant_w_implicit[MANT_W:1] : rounded_mant_w_implicit[MANT_W-1:0];
+            // Handle exponent adjustment from rounding overflow (select, no adder)
+            final_exp_rounded = rounder_overflow ? s3_final_exp_p1 : s3_final_exp;
+
+            // The final mantissa is the output of the rounder, dropping the implicit bit.
+            // On a rounding overflow the compound rounder wraps to all zeros,
+            // which is already the correct fraction of 1.0 * 2^(exp+1), so
+            // no re-shift is needed.
+            out_mant = rounded_mant_w_implicit[MANT_W-1:0];
 
             // Check for overflow/underflow on final exponent
             if (final_exp_rounded >= $signed({1'b0,EXP_ALL_ONES})) begin // Overflow -> Infinity
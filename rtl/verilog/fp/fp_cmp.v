@@ -0,0 +1,68 @@
+// rtl/verilog/fp/fp_cmp.v
+//
+// Verilog RTL for a parameterized floating-point comparator (replaces the
+// fp16_cmp / fp32_cmp / fp64_cmp copies).
+//
+// Operation: Compares a and b.
+//
+// Outputs:
+// - lt, eq, gt:  IEEE comparison, -0 == +0; all 0 if unordered
+// - unord:       1 if a or b is NaN
+// - min, max:    IEEE 754-2019 minimumNumber / maximumNumber: -0 < +0, a NaN
+//                operand is ignored, quiet NaN if both are NaN
+// - total_order: IEEE 754 totalOrder(a, b), i.e. a <= b in the order
+//                -NaN < -Inf < ... < -0 < +0 < ... < +Inf < +NaN
+//                (NaNs ordered by payload); 1 for identical encodings
+//
+// totalOrder is an unsigned compare of the encodings mapped to offset binary
+// (negative: all bits inverted, positive: sign bit set), which is also used
+// for lt / gt and min / max of ordered operands.
+//
+// Features:
+// - Combinational logic.
+// - Building block of the sorting network (fp_sort.v, fp_topk.v).
+
+module fp_cmp #(
+    parameter WIDTH = 16
+) (
+    input  [WIDTH-1:0] a,
+    input  [WIDTH-1:0] b,
+
+    output             lt,
+    output             eq,
+    output             gt,
+    output             unord,
+    output [WIDTH-1:0] min,
+    output [WIDTH-1:0] max,
+    output             total_order
+);
+    // Derived parameters for convenience
+    localparam EXP_W  = (WIDTH == 64) ? 11 : (WIDTH == 32) ? 8 : (WIDTH == 16) ? 5 : 0; // IEEE-754
+    localparam MANT_W = WIDTH - 1 - EXP_W;
+
+    localparam [WIDTH-1:0] QNAN = {1'b0, {EXP_W{1'b1}}, {1'b1, {(MANT_W-1){1'b0}}}};
+
+    // Special values
+    wire nan_a  = (&a[WIDTH-2:MANT_W]) && (|a[MANT_W-1:0]);
+    wire nan_b  = (&b[WIDTH-2:MANT_W]) && (|b[MANT_W-1:0]);
+    wire zero_a = ~|a[WIDTH-2:0];
+    wire zero_b = ~|b[WIDTH-2:0];
+
+    // Total order keys
+    wire [WIDTH-1:0] key_a = a[WIDTH-1] ? ~a : {1'b1, a[WIDTH-2:0]};
+    wire [WIDTH-1:0] key_b = b[WIDTH-1] ? ~b : {1'b1, b[WIDTH-2:0]};
+    wire             key_lt = key_a < key_b;
+
+    assign total_order = !(key_b < key_a);
+
+    // IEEE comparison
+    assign unord = nan_a || nan_b;
+    assign eq    = !unord && ((a == b) || (zero_a && zero_b));
+    assign lt    = !unord && !eq && key_lt;
+    assign gt    = !unord && !eq && !key_lt;
+
+    // minimumNumber / maximumNumber
+    assign min = (nan_a && nan_b) ? QNAN : nan_a ? b : nan_b ? a : key_lt ? a : b;
+    assign max = (nan_a && nan_b) ? QNAN : nan_a ? b : nan_b ? a : key_lt ? b : a;
+
+endmodule
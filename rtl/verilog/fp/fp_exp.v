@@ -0,0 +1,277 @@
+// rtl/verilog/fp/fp_exp.v
+//
+// Verilog RTL for a parameterized floating-point exponential, result = e^a.
+//
+// Table-based, without a floating-point multiplier:
+// - a * log2(e) is formed in fixed point with P = MANT_W + 6 fraction bits
+//   and split into the integer n and the fraction f, e^a = 2^n * 2^f.
+// - 2^f = T[j] * 2^r, with j the top LUT_BITS bits of f and r the rest
+//   (r < 2^-LUT_BITS). T[j] = 2^(j / 2^LUT_BITS) is built at elaboration as a
+//   product of the roots 2^(2^-k), each the integer square root of the
+//   previous one, in P + 4 fraction bits rounded to P, and
+//   2^r = 1 + t + t^2 / 2 with t = r * ln(2).
+// - The P-bit significand is rounded to the format by grs_rounder (rm).
+//
+// All intermediate values are truncated integers, verif/lib/fp_softmax_model.cpp
+// (c_fp_exp) is the bit-accurate model. The result is within 1 ulp of e^a for
+// fp16 and fp32 (0.59 and 0.64 ulp measured by fp_softmax_bench); for fp64
+// the quadratic limits it to about 2^-34 relative.
+//
+// Special cases:
+// - NaN -> qNaN, +Inf -> +Inf, -Inf -> +0.
+// - |a| >= 2^(EXP_W-1) -> +Inf or +0 (beyond the format range).
+// - Zero and denormal inputs -> 1.0.
+// - Results below the smallest normal are flushed to zero (as in fp_add).
+
+`include "common_inc.vh"
+`include "grs_round.vh"  // \`RNE, etc.
+
+module fp_exp #(
+    parameter WIDTH  = 16
+) (
+    input clk,
+    input rst_n,
+
+    input  [WIDTH-1:0] a,
+    input  [2:0]       rm, // Rounding mode (see grs_rounder.v for modes)
+
+    output [WIDTH-1:0] result
+);
+    `VERIF_DECLARE_PIPELINE(3)  // Verification support
+
+    // Derived parameters for convenience
+    localparam EXP_W            = (WIDTH == 64) ?   11 : (WIDTH == 32) ?    8 : (WIDTH == 16) ?    5 : 0; // IEEE-754
+    localparam EXP_BIAS         = (WIDTH == 64) ? 1023 : (WIDTH == 32) ?  127 : (WIDTH == 16) ?   15 : 0; // IEEE-754
+    localparam LUT_BITS         = (WIDTH == 64) ?   10 : (WIDTH == 32) ?    8 : 4;  // 2^f table index bits
+
+    localparam MANT_W       = WIDTH - 1 - EXP_W;
+    localparam SIGN_POS     = WIDTH - 1;
+    localparam EXP_POS      = MANT_W;
+
+    // Fixed-point widths
+    localparam P  = MANT_W + 6;                                    // Fraction bits of u = a * log2(e) and of 2^f
+    localparam Q  = P + 4;                                         // Fraction bits while building the table
+    localparam G  = (P + EXP_W > 64) ? 64 : P + EXP_W;             // Fraction bits of log2(e)
+    localparam UW = P + EXP_W + 1;                                 // Two's complement u, |u| < 2^EXP_W
+
+    // Constants for special values
+    localparam [ EXP_W-1:0] EXP_ALL_ONES   = { EXP_W{1'b1}};
+    localparam [ EXP_W-1:0] EXP_ALL_ZEROS  = { EXP_W{1'b0}};
+    localparam [MANT_W-1:0] MANT_ALL_ZEROS = {MANT_W{1'b0}};
+
+    localparam [WIDTH-1:0] QNAN   = {1'b0, EXP_ALL_ONES, {1'b1, {(MANT_W-1){1'b0}}}};
+    localparam [WIDTH-1:0] P_ZERO = {1'b0, {(WIDTH-1){1'b0}}};
+    localparam [WIDTH-1:0] P_INF  = {1'b0, EXP_ALL_ONES, MANT_ALL_ZEROS};
+    localparam [WIDTH-1:0] P_ONE  = {2'b00, {(EXP_W-1){1'b1}}, MANT_ALL_ZEROS};
+
+    // log2(e) * 2^64 and ln(2) * 2^64, truncated to G and P fraction bits
+    localparam [67:0] LOG2E_64 = 68'h1_7154_7652_B82F_E177;
+    localparam [63:0] LN2_64   = 64'hB172_17F7_D1CF_79AB;
+    localparam [G:0]  LOG2E    = LOG2E_64 >> (64 - G);
+    localparam [P-1:0] LN2     = LN2_64 >> (64 - P);
+
+    //----------------------------------------------------------------
+    // 2^(j / 2^LUT_BITS) Table (Q1.P, elaboration time)
+    //----------------------------------------------------------------
+
+    localparam [2*Q+3:0] ONE_W = 1;
+
+    // Integer square root (floor) of a Q2.2Q value, bit by bit from the MSB
+    function [2*Q+3:0] isqrt;
+        input [2*Q+3:0] v;
+        reg   [2*Q+3:0] root, trial;
+        integer b;
+        begin
+            root = 0;
+            for (b = Q; b >= 0; b = b - 1) begin
+                trial = root | (ONE_W << b);
+                if (trial * trial <= v) root = trial;
+            end
+            isqrt = root;
+        end
+    endfunction
+
+    // Bit k-1 of j (from the MSB) selects the root 2^(2^-k)
+    function [P:0] exp2_frac;
+        input integer j;
+        reg   [2*Q+3:0] root, acc;
+        integer k;
+        begin
+            root = ONE_W << (Q + 1);  // 2.0
+            acc  = ONE_W << Q;        // 1.0
+            for (k = 1; k <= LUT_BITS; k = k + 1) begin
+                root = isqrt(root << Q);
+                if (j & (1 << (LUT_BITS - k))) acc = (acc * root) >> Q;
+            end
+            acc = (acc + (ONE_W << (Q - P - 1))) >> (Q - P);  // Round to P fraction bits
+            exp2_frac = acc[P:0];
+        end
+    endfunction
+
+    wire [P:0] exp2_lut [0:(1 << LUT_BITS)-1];
+    genvar gj;
+    generate
+        for (gj = 0; gj < (1 << LUT_BITS); gj = gj + 1) begin : lut
+            assign exp2_lut[gj] = exp2_frac(gj);
+        end
+    endgenerate
+
+    //----------------------------------------------------------------
+    // Input Unpacking
+    //----------------------------------------------------------------
+
+    // Input value parts
+    wire              sign_a = a[SIGN_POS];
+    wire [ EXP_W-1:0] exp_a  = a[SIGN_POS-1:EXP_POS];
+    wire [MANT_W-1:0] mant_a = a[MANT_W-1:0];
+
+    // Detect special values
+    wire is_subnormal_a = (exp_a == EXP_ALL_ZEROS);                                   // Zero or denormal
+    wire is_nan_a       = (exp_a == EXP_ALL_ONES ) && (mant_a != MANT_ALL_ZEROS);
+    wire is_big_a       = (exp_a >= EXP_BIAS + EXP_W - 1);                            // |a| >= 2^(EXP_W-1), Inf, NaN
+
+    //----------------------------------------------------------------
+    // Stage 1: Unpack, Special Cases and |a| * log2(e)
+    //----------------------------------------------------------------
+
+    // Stage 1 - Combinational Logic
+    reg                  s1_special_case_d;
+    reg [WIDTH-1:0]      s1_special_result_d;
+    always @(*) begin
+        s1_special_case_d   = 1'b0;
+        s1_special_result_d = P_ONE;
+
+        if (is_nan_a) begin
+            s1_special_case_d   = 1'b1;
+            s1_special_result_d = QNAN;
+        end else if (is_big_a) begin
+            s1_special_case_d   = 1'b1;
+            s1_special_result_d = sign_a ? P_ZERO : P_INF; // Includes +-Inf
+        end else if (is_subnormal_a) begin
+            s1_special_case_d   = 1'b1;
+            s1_special_result_d = P_ONE;
+        end
+    end
+
+    wire [MANT_W+G+1:0] s1_prod_d = {1'b1, mant_a} * LOG2E;
+
+    // Stage 1 - Pipeline Registers
+    reg [MANT_W+G+1:0] s1_prod_q;
+    reg [EXP_W-1:0]    s1_exp_q;
+    reg                s1_sign_q;
+    reg                s1_special_case_q;
+    reg [WIDTH-1:0]    s1_special_result_q;
+    reg [2:0]          s1_rm_q;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            s1_prod_q           <= '0;
+            s1_exp_q            <= '0;
+            s1_sign_q           <= 1'b0;
+            s1_special_case_q   <= 1'b0;
+            s1_special_result_q <= P_ZERO;
+            s1_rm_q             <= `RNE;
+        end else begin
+            s1_prod_q           <= s1_prod_d;
+            s1_exp_q            <= exp_a;
+            s1_sign_q           <= sign_a;
+            s1_special_case_q   <= s1_special_case_d;
+            s1_special_result_q <= s1_special_result_d;
+            s1_rm_q             <= rm;
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage 2: Fixed-Point u, Table Lookup and t = r * ln(2)
+    //----------------------------------------------------------------
+
+    // |u| = prod * 2^(exp - EXP_BIAS - MANT_W - G) in P fraction bits, truncated.
+    // The shift is positive for every exponent below is_big_a (truncation only).
+    localparam SHIFT_BASE = MANT_W + G - P + EXP_BIAS;
+    wire [EXP_W+1:0]       s2_shift = SHIFT_BASE - s1_exp_q;
+    wire [MANT_W+G+1:0]    s2_mag   = s1_prod_q >> s2_shift;
+    wire [UW-1:0]          s2_u     = s1_sign_q ? -s2_mag[UW-1:0] : s2_mag[UW-1:0];
+
+    // u = n + f: n = floor(u), f = j * 2^-LUT_BITS + r
+    wire signed [EXP_W:0]  s2_n_d = s2_u[UW-1:P];
+    wire [LUT_BITS-1:0]    s2_j   = s2_u[P-1:P-LUT_BITS];
+    wire [P-LUT_BITS-1:0]  s2_r   = s2_u[P-LUT_BITS-1:0];
+    wire [2*P-LUT_BITS-1:0] s2_r_ln2 = s2_r * LN2;
+
+    // Stage 2 - Pipeline Registers
+    reg signed [EXP_W:0]   s2_n_q;
+    reg [P:0]              s2_lut_q;
+    reg [P-LUT_BITS-1:0]   s2_t_q;
+    reg                    s2_special_case_q;
+    reg [WIDTH-1:0]        s2_special_result_q;
+    reg [2:0]              s2_rm_q;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            s2_n_q              <= '0;
+            s2_lut_q            <= '0;
+            s2_t_q              <= '0;
+            s2_special_case_q   <= 1'b0;
+            s2_special_result_q <= P_ZERO;
+            s2_rm_q             <= `RNE;
+        end else begin
+            s2_n_q              <= s2_n_d;
+            s2_lut_q            <= exp2_lut[s2_j];
+            s2_t_q              <= s2_r_ln2[2*P-LUT_BITS-1:P];
+            s2_special_case_q   <= s1_special_case_q;
+            s2_special_result_q <= s1_special_result_q;
+            s2_rm_q             <= s1_rm_q;
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage 3: 2^f = T[j] * (1 + t + t^2 / 2), Round and Pack
+    //----------------------------------------------------------------
+
+    wire [2*P-2*LUT_BITS-1:0] s3_t_sq = s2_t_q * s2_t_q;
+    wire [P:0]                s3_poly = {1'b1, {P{1'b0}}} + s2_t_q + (s3_t_sq >> (P + 1));
+    wire [2*P+1:0]            s3_prod = s2_lut_q * s3_poly;
+    // Q1.P significand of 2^f; truncation keeps it below 2.0, the clamp only guards it
+    wire [P:0]                s3_mant = s3_prod[2*P+1] ? {(P+1){1'b1}} : s3_prod[2*P:P];
+
+    wire [MANT_W:0] rounded_mant_w_implicit;
+    wire            rounder_overflow;
+    grs_rounder #(
+        .INPUT_WIDTH(P + 1),
+        .OUTPUT_WIDTH(MANT_W + 1) // Keep implicit bit for overflow check
+    ) u_rounder (
+        .value_in(s3_mant),
+        .sign_in(1'b0),
+        .mode(s2_rm_q),
+        .value_out(rounded_mant_w_implicit),
+        .overflow_out(rounder_overflow)
+    );
+
+    wire signed [EXP_W+1:0] s3_exp = s2_n_q + EXP_BIAS + $signed({1'b0, rounder_overflow});
+
+    reg [WIDTH-1:0] s3_result_d;
+    always @(*) begin
+        if (s2_special_case_q) begin
+            s3_result_d = s2_special_result_q;
+        end else if (s3_exp >= $signed({2'b0, EXP_ALL_ONES})) begin // Overflow -> Infinity
+            s3_result_d = P_INF;
+        end else if (s3_exp <= 0) begin // Underflow -> Zero (no denormal results)
+            s3_result_d = P_ZERO;
+        end else begin
+            // A rounding overflow wraps the fraction to zero, the fraction of 2^(n+1)
+            s3_result_d = {1'b0, s3_exp[EXP_W-1:0], rounded_mant_w_implicit[MANT_W-1:0]};
+        end
+    end
+
+    // Stage 3 Pipeline
+    reg [WIDTH-1:0] result_q;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            result_q <= P_ZERO;
+        end else begin
+            result_q <= s3_result_d;
+        end
+    end
+
+    // Assign final registered output
+    assign result = result_q;
+
+endmodule
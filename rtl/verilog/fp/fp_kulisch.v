@@ -0,0 +1,429 @@
+// rtl/verilog/fp/fp_kulisch.v
+//
+// Verilog RTL for an exact (Kulisch) floating-point dot product
+// accumulator: result = round(sum of a_i * b_i over a row), one product per
+// cycle, a single rounding per row.
+//
+// The exact products of fp_mul (prod_* outputs, no rounding) are added into a
+// fixed-point accumulator that spans every product, from the smallest
+// denormal product (LSB 2^(2 - 2*EXP_BIAS - 2*MANT_W)) to the largest one,
+// plus CARRY_W carry bits and a sign bit:
+//   FIX_W = 2^(EXP_W+1) - 4 + 2*MANT_W  (80 for fp16, 554 for fp32)
+//   ACC_W = FIX_W + CARRY_W + 1
+// Rows of up to 2^CARRY_W products are summed exactly, so the result does
+// not depend on the order of the products, the row split across tiles or
+// the pipeline timing. verif/lib/fp_kulisch_model.cpp reproduces it.
+//
+// Accumulation is carry-save: every cycle one 3:2 compressor row adds the
+// aligned product (ones' complement for negative products, the +1 enters the
+// free LSB of the carry vector), so the cycle time does not grow with ACC_W.
+// The only carry-propagate adds are in the row end pipeline:
+//   R1 resolve the carry-save sum, R2 absolute value, R3 leading one,
+//   window and sticky, R4 grs_rounder and pack.
+//
+// Rows: in_last marks the last product of a row; rm is taken with it. The
+// next row can start in the following cycle. Latency from the last product
+// to out_valid: 2 (fp_mul) + 2 (align, accumulate) + 4 = 8.
+//
+// Special values: a NaN product or +Inf and -Inf in a row -> quiet NaN; Inf
+// -> Inf with its sign. An exactly zero sum is -0 if all products were -0 or
+// (rm = RNI) unless all were +0, +0 otherwise. Results round to denormals;
+// an exponent overflow gives Inf (as fp_mul).
+
+`include "common_inc.vh"
+`include "grs_round.vh"  // \`RNE, etc.
+`include "adders.vh"     // \`ADDER_BEHAVIORAL, etc.
+
+module fp_kulisch #(
+    parameter WIDTH   = 16,
+    parameter CARRY_W = 16,  // Exact for rows of up to 2^CARRY_W products
+    parameter ADDER_TOPOLOGY = `ADDER_BEHAVIORAL  // Row end adders (see adders.vh)
+) (
+    input clk,
+    input rst_n,
+
+    input  [WIDTH-1:0] a,
+    input  [WIDTH-1:0] b,
+    input              in_valid,
+    input              in_last,   // Last product of the row
+    input  [2:0]       rm,        // Rounding mode (see grs_rounder.v for modes), taken with in_last
+
+    output [WIDTH-1:0] out_data,
+    output             out_valid
+);
+    // Derived parameters for convenience
+    localparam EXP_W    = (WIDTH == 64) ?   11 : (WIDTH == 32) ?    8 : (WIDTH == 16) ?    5 : 0; // IEEE-754
+    localparam EXP_BIAS = (WIDTH == 64) ? 1023 : (WIDTH == 32) ?  127 : (WIDTH == 16) ?   15 : 0; // IEEE-754
+    localparam MANT_W   = WIDTH - 1 - EXP_W;
+
+    localparam PROD_EXP_W  = EXP_W + 2;
+    localparam PROD_MANT_W = 2 * MANT_W + 2;
+
+    localparam FIX_W = (1 << (EXP_W + 1)) - 4 + 2 * MANT_W;
+    localparam ACC_W = FIX_W + CARRY_W + 1;
+    localparam SH_W  = $clog2(FIX_W);
+    localparam POS_W = $clog2(ACC_W) + 1;
+
+    // Accumulator bit of the implicit one of the smallest normal result
+    localparam P_MIN = EXP_BIAS - 1 + 2 * MANT_W;
+
+    localparam PROD_LATENCY = 2;
+    localparam LATENCY      = PROD_LATENCY + 2 + 4;
+
+    localparam [ EXP_W-1:0] EXP_ALL_ONES   = { EXP_W{1'b1}};
+    localparam [MANT_W-1:0] MANT_ALL_ZEROS = {MANT_W{1'b0}};
+
+    localparam [WIDTH-1:0] QNAN   = {1'b0, EXP_ALL_ONES, {1'b1, {(MANT_W-1){1'b0}}}};
+    localparam [WIDTH-1:0] P_ZERO = {1'b0, {(WIDTH-1){1'b0}}};
+
+    `VERIF_DECLARE_PIPELINE(LATENCY)  // Verification support
+
+    //----------------------------------------------------------------
+    // Exact Products (fp_mul, stages 1 - 2)
+    //----------------------------------------------------------------
+
+    wire                   prod_sign;
+    wire [PROD_EXP_W-1:0]  prod_exp;
+    wire [PROD_MANT_W-1:0] prod_mant;
+    wire                   prod_special;
+    wire [WIDTH-1:0]       prod_special_result;
+
+    fp_mul #(
+        .WIDTH(WIDTH)
+    ) u_mul (
+        .clk(clk),
+        .rst_n(rst_n),
+        .a(a),
+        .b(b),
+        .rm(`RNE),
+        .result(),
+        .prod_sign(prod_sign),
+        .prod_exp(prod_exp),
+        .prod_mant(prod_mant),
+        .prod_special(prod_special),
+        .prod_special_result(prod_special_result)
+    );
+
+    // valid / last / rm alongside fp_mul
+    reg       valid_sr [1:PROD_LATENCY];
+    reg       last_sr  [1:PROD_LATENCY];
+    reg [2:0] rm_sr    [1:PROD_LATENCY];
+
+    integer k;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            for (k = 1; k <= PROD_LATENCY; k = k + 1) begin
+                valid_sr[k] <= 1'b0;
+                last_sr[k]  <= 1'b0;
+                rm_sr[k]    <= `RNE;
+            end
+        end else begin
+            valid_sr[1] <= in_valid;
+            last_sr[1]  <= in_last;
+            rm_sr[1]    <= rm;
+            for (k = 2; k <= PROD_LATENCY; k = k + 1) begin
+                valid_sr[k] <= valid_sr[k-1];
+                last_sr[k]  <= last_sr[k-1];
+                rm_sr[k]    <= rm_sr[k-1];
+            end
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage A: Align
+    //----------------------------------------------------------------
+
+    // Product LSB above the accumulator LSB: prod_exp + EXP_BIAS - 2 (>= 0)
+    wire [SH_W-1:0] shift = $signed(prod_exp) + EXP_BIAS - 2;
+    wire [ACC_W-1:0] aligned = {{(ACC_W-PROD_MANT_W){1'b0}}, prod_mant} << shift;
+
+    // Special products
+    wire sp_exp_ones = (prod_special_result[WIDTH-2:MANT_W] == EXP_ALL_ONES);
+    wire sp_frac_nz  = (prod_special_result[MANT_W-1:0] != MANT_ALL_ZEROS);
+    wire sp_sign     = prod_special_result[WIDTH-1];
+
+    reg [ACC_W-1:0] sa_addend;
+    reg             sa_neg;
+    reg             sa_valid, sa_last;
+    reg [2:0]       sa_rm;
+    reg             sa_nan, sa_pinf, sa_ninf, sa_pzero, sa_nzero;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            sa_addend <= {ACC_W{1'b0}};
+            sa_neg    <= 1'b0;
+            sa_valid  <= 1'b0;
+            sa_last   <= 1'b0;
+            sa_rm     <= `RNE;
+            sa_nan    <= 1'b0;
+            sa_pinf   <= 1'b0;
+            sa_ninf   <= 1'b0;
+            sa_pzero  <= 1'b0;
+            sa_nzero  <= 1'b0;
+        end else begin
+            sa_addend <= prod_special ? {ACC_W{1'b0}} : prod_sign ? ~aligned : aligned;
+            sa_neg    <= !prod_special && prod_sign;
+            sa_valid  <= valid_sr[PROD_LATENCY];
+            sa_last   <= last_sr[PROD_LATENCY];
+            sa_rm     <= rm_sr[PROD_LATENCY];
+            sa_nan    <= prod_special && sp_exp_ones && sp_frac_nz;
+            sa_pinf   <= prod_special && sp_exp_ones && !sp_frac_nz && !sp_sign;
+            sa_ninf   <= prod_special && sp_exp_ones && !sp_frac_nz && sp_sign;
+            sa_pzero  <= prod_special && !sp_exp_ones && !sp_sign;
+            sa_nzero  <= prod_special && !sp_exp_ones && sp_sign;
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage B: Carry-Save Accumulate
+    //----------------------------------------------------------------
+
+    // Value of the row so far: acc_s + acc_c
+    reg [ACC_W-1:0] acc_s, acc_c;
+    reg             acc_first;  // Next product starts a row
+    reg             acc_done;   // acc_* hold a complete row
+    reg [2:0]       acc_rm;
+    reg             acc_nan, acc_pinf, acc_ninf, acc_all_pzero, acc_all_nzero;
+
+    wire [ACC_W-1:0] csa_z, csa_carry;
+    fa_vec_carry_save #(
+        .WIDTH(ACC_W)
+    ) u_acc_csa (
+        .a(acc_first ? {ACC_W{1'b0}} : acc_s),
+        .b(acc_first ? {ACC_W{1'b0}} : acc_c),
+        .c(sa_addend),
+        .add_nsub(1'b0),
+        .z(csa_z),
+        .carry(csa_carry)
+    );
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            acc_s         <= {ACC_W{1'b0}};
+            acc_c         <= {ACC_W{1'b0}};
+            acc_first     <= 1'b1;
+            acc_done      <= 1'b0;
+            acc_rm        <= `RNE;
+            acc_nan       <= 1'b0;
+            acc_pinf      <= 1'b0;
+            acc_ninf      <= 1'b0;
+            acc_all_pzero <= 1'b1;
+            acc_all_nzero <= 1'b1;
+        end else begin
+            acc_done <= sa_valid && sa_last;
+            if (sa_valid) begin
+                acc_s         <= csa_z;
+                acc_c         <= {csa_carry[ACC_W-2:0], sa_neg};
+                acc_first     <= sa_last;
+                acc_rm        <= sa_rm;
+                acc_nan       <= (!acc_first && acc_nan)  || sa_nan;
+                acc_pinf      <= (!acc_first && acc_pinf) || sa_pinf;
+                acc_ninf      <= (!acc_first && acc_ninf) || sa_ninf;
+                acc_all_pzero <= (acc_first || acc_all_pzero) && sa_pzero;
+                acc_all_nzero <= (acc_first || acc_all_nzero) && sa_nzero;
+            end
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage R1: Resolve
+    //----------------------------------------------------------------
+
+    wire [ACC_W-1:0] full;
+    fas_vec_prefix #(
+        .WIDTH(ACC_W),
+        .TOPOLOGY(ADDER_TOPOLOGY)
+    ) u_resolve (
+        .a(acc_s),
+        .b(acc_c),
+        .cin(1'b0),
+        .add_nsub(1'b0),
+        .z(full),
+        .cout()
+    );
+
+    reg [ACC_W-1:0] r1_full;
+    reg             r1_valid;
+    reg [2:0]       r1_rm;
+    reg             r1_nan, r1_inf, r1_inf_sign, r1_all_pzero, r1_all_nzero;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            r1_full      <= {ACC_W{1'b0}};
+            r1_valid     <= 1'b0;
+            r1_rm        <= `RNE;
+            r1_nan       <= 1'b0;
+            r1_inf       <= 1'b0;
+            r1_inf_sign  <= 1'b0;
+            r1_all_pzero <= 1'b0;
+            r1_all_nzero <= 1'b0;
+        end else begin
+            r1_full      <= full;
+            r1_valid     <= acc_done;
+            r1_rm        <= acc_rm;
+            r1_nan       <= acc_nan || (acc_pinf && acc_ninf);
+            r1_inf       <= acc_pinf || acc_ninf;
+            r1_inf_sign  <= acc_ninf;
+            r1_all_pzero <= acc_all_pzero;
+            r1_all_nzero <= acc_all_nzero;
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage R2: Absolute Value
+    //----------------------------------------------------------------
+
+    wire             r1_sign = r1_full[ACC_W-1];
+    wire [ACC_W-1:0] mag;
+    fas_vec_prefix #(
+        .WIDTH(ACC_W),
+        .TOPOLOGY(ADDER_TOPOLOGY)
+    ) u_abs (
+        .a({ACC_W{1'b0}}),
+        .b(r1_full),
+        .cin(1'b0),
+        .add_nsub(r1_sign),
+        .z(mag),
+        .cout()
+    );
+
+    reg [ACC_W-1:0] r2_mag;
+    reg             r2_sign;
+    reg             r2_valid;
+    reg [2:0]       r2_rm;
+    reg             r2_nan, r2_inf, r2_inf_sign, r2_all_pzero, r2_all_nzero;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            r2_mag       <= {ACC_W{1'b0}};
+            r2_sign      <= 1'b0;
+            r2_valid     <= 1'b0;
+            r2_rm        <= `RNE;
+            r2_nan       <= 1'b0;
+            r2_inf       <= 1'b0;
+            r2_inf_sign  <= 1'b0;
+            r2_all_pzero <= 1'b0;
+            r2_all_nzero <= 1'b0;
+        end else begin
+            r2_mag       <= mag;
+            r2_sign      <= r1_sign;
+            r2_valid     <= r1_valid;
+            r2_rm        <= r1_rm;
+            r2_nan       <= r1_nan;
+            r2_inf       <= r1_inf;
+            r2_inf_sign  <= r1_inf_sign;
+            r2_all_pzero <= r1_all_pzero;
+            r2_all_nzero <= r1_all_nzero;
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage R3: Leading One, Window and Sticky
+    //----------------------------------------------------------------
+
+    // Leading one, at least P_MIN (denormal results keep the exponent of 1)
+    reg [POS_W-1:0] lead;
+    integer i;
+    always @(*) begin
+        lead = P_MIN;
+        for (i = P_MIN + 1; i < ACC_W; i = i + 1) begin
+            if (r2_mag[i]) lead = i;
+        end
+    end
+
+    // MANT_W + 1 result bits below and at lead, guard and round, then sticky
+    wire [POS_W-1:0] win_lsb = lead - MANT_W - 2;
+    wire [ACC_W-1:0] win     = r2_mag >> win_lsb;
+    wire             sticky  = |(r2_mag & ~({ACC_W{1'b1}} << win_lsb));
+
+    reg [MANT_W+3:0] r3_round_in;
+    reg [POS_W-1:0]  r3_exp;     // Biased exponent before rounding, >= 1
+    reg              r3_zero;
+    reg              r3_sign;
+    reg              r3_valid;
+    reg [2:0]        r3_rm;
+    reg              r3_nan, r3_inf, r3_inf_sign, r3_all_pzero, r3_all_nzero;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            r3_round_in  <= {(MANT_W+4){1'b0}};
+            r3_exp       <= {POS_W{1'b0}};
+            r3_zero      <= 1'b0;
+            r3_sign      <= 1'b0;
+            r3_valid     <= 1'b0;
+            r3_rm        <= `RNE;
+            r3_nan       <= 1'b0;
+            r3_inf       <= 1'b0;
+            r3_inf_sign  <= 1'b0;
+            r3_all_pzero <= 1'b0;
+            r3_all_nzero <= 1'b0;
+        end else begin
+            r3_round_in  <= {win[MANT_W+2:0], sticky};
+            r3_exp       <= lead - P_MIN + 1;
+            r3_zero      <= (r2_mag == {ACC_W{1'b0}});
+            r3_sign      <= r2_sign;
+            r3_valid     <= r2_valid;
+            r3_rm        <= r2_rm;
+            r3_nan       <= r2_nan;
+            r3_inf       <= r2_inf;
+            r3_inf_sign  <= r2_inf_sign;
+            r3_all_pzero <= r2_all_pzero;
+            r3_all_nzero <= r2_all_nzero;
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage R4: Round and Pack
+    //----------------------------------------------------------------
+
+    wire [MANT_W:0] rounded_mant_w_implicit;
+    wire            rounder_overflow;
+    grs_rounder #(
+        .INPUT_WIDTH(MANT_W + 4),
+        .OUTPUT_WIDTH(MANT_W + 1) // Keep implicit bit for overflow check
+    ) u_rounder (
+        .value_in(r3_round_in),
+        .sign_in(r3_sign),
+        .mode(r3_rm),
+        .value_out(rounded_mant_w_implicit),
+        .overflow_out(rounder_overflow)
+    );
+
+    // A rounding overflow wraps the fraction to zero, the fraction of 2^(exp+1)
+    wire [POS_W-1:0] final_exp = r3_exp + rounder_overflow;
+
+    wire zero_sign = r3_all_nzero || ((r3_rm == `RNI) && !r3_all_pzero);
+
+    reg [WIDTH-1:0] result_d;
+    always @(*) begin
+        if (r3_nan) begin
+            result_d = QNAN;
+        end else if (r3_inf) begin
+            result_d = {r3_inf_sign, EXP_ALL_ONES, MANT_ALL_ZEROS};
+        end else if (r3_zero) begin
+            result_d = {zero_sign, {(WIDTH-1){1'b0}}};
+        end else if (final_exp >= EXP_ALL_ONES) begin // Overflow -> Infinity
+            result_d = {r3_sign, EXP_ALL_ONES, MANT_ALL_ZEROS};
+        end else if (final_exp == 1 && !rounded_mant_w_implicit[MANT_W]) begin // Denormal
+            result_d = {r3_sign, {EXP_W{1'b0}}, rounded_mant_w_implicit[MANT_W-1:0]};
+        end else begin
+            result_d = {r3_sign, final_exp[EXP_W-1:0], rounded_mant_w_implicit[MANT_W-1:0]};
+        end
+    end
+
+    reg [WIDTH-1:0] result_q;
+    reg             valid_q;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            result_q <= P_ZERO;
+            valid_q  <= 1'b0;
+        end else begin
+            result_q <= result_d;
+            valid_q  <= r3_valid;
+        end
+    end
+
+    assign out_data  = result_q;
+    assign out_valid = valid_q;
+
+endmodule
@@ -12,12 +12,22 @@
 // - Handles normalized and denormalized numbers.
 // - Handles special cases: NaN, Infinity, and Zero.
 // - TODO: (when needed) Implements GRS rounding for improved accuracy.
+// - Exact product outputs (prod_*, after stage 2) for accumulation without
+//   rounding (fp_kulisch.v): unless prod_special,
+//     product = (-1)^prod_sign * prod_mant * 2^(prod_exp - EXP_BIAS - 2*MANT_W)
+//   with prod_exp the sum of the effective (denormal: 1) biased exponents
+//   minus EXP_BIAS; prod_special_result is the NaN / Inf / zero result.
 
 `include "common_inc.vh"
 `include "grs_round.vh"  // \`RNE, etc.
+`include "adders.vh"     // \`ADDER_BEHAVIORAL, etc.
 
 module fp_mul #(
-    parameter WIDTH  = 16
+    parameter WIDTH  = 16,
+    parameter ADDER_TOPOLOGY = `ADDER_BEHAVIORAL, // Exponent adder (see adders.vh)
+    // Derived (do not override): exact product port widths
+    parameter PROD_EXP_W  = ((WIDTH == 64) ? 11 : (WIDTH == 32) ? 8 : (WIDTH == 16) ? 5 : 0) + 2,
+    parameter PROD_MANT_W = 2 * (WIDTH + 1 - PROD_EXP_W) + 2
 ) (
     input clk,
     input rst_n,
@@ -26,7 +36,14 @@ module fp_mul #(
     input  [WIDTH-1:0] b,
     input  [2:0]       rm, // Rounding mode (see grs_rounder.v for modes)
 
-    output [WIDTH-1:0] result
+    output [WIDTH-1:0] result,
+
+    // Exact product, latency 2
+    output                   prod_sign,
+    output [PROD_EXP_W-1:0]  prod_exp,    // Signed
+    output [PROD_MANT_W-1:0] prod_mant,
+    output                   prod_special,
+    output [WIDTH-1:0]       prod_special_result
 );
     `VERIF_DECLARE_PIPELINE(4)  // Verification support
 
@@ -80,6 +97,38 @@ module fp_mul #(
     // Stage 1: Unpack and Special Case Detection
     //----------------------------------------------------------------
 
+    // Stage 1 - Exponent Sum
+    // Exponents are biased by EXP_BIAS. So, E_res = (E_a - EXP_BIAS) + (E_b - EXP_BIAS) = (E_a + E_b) - 2*EXP_BIAS
+    // New biased exponent = E_res + EXP_BIAS = E_a + E_b - EXP_BIAS.
+    // Need to handle denormalized numbers, where exponent is effectively 1-bias, not 0-bias.
+    // The three operands are compressed by a carry-save row, so a single
+    // carry-propagate adder (of the selected topology) resolves the sum.
+    // EXP_W+2 bits hold the full signed range of the result.
+    localparam [EXP_W+1:0] NEG_EXP_BIAS = -EXP_BIAS;
+    wire [EXP_W+1:0] exp_csa_sum, exp_csa_carry;
+    wire [EXP_W+1:0] exp_sum;
+    fa_vec_carry_save #(
+        .WIDTH(EXP_W+2)
+    ) u_exp_csa (
+        .a({2'b0, effective_exp_a}),
+        .b({2'b0, effective_exp_b}),
+        .c(NEG_EXP_BIAS),
+        .add_nsub(1'b0),
+        .z(exp_csa_sum),
+        .carry(exp_csa_carry)
+    );
+    fas_vec_prefix #(
+        .WIDTH(EXP_W+2),
+        .TOPOLOGY(ADDER_TOPOLOGY)
+    ) u_exp_adder (
+        .a(exp_csa_sum),
+        .b({exp_csa_carry[EXP_W:0], 1'b0}),
+        .cin(1'b0),
+        .add_nsub(1'b0),
+        .z(exp_sum),
+        .cout()
+    );
+
     // Stage 1 - Combinational Logic
     reg signed [EXP_W+1:0] s1_exp_sum_d;
     reg                    s1_sign_d;
@@ -88,10 +137,7 @@ module fp_mul #(
     reg                    s1_special_case_d;
     reg        [WIDTH-1:0] s1_special_result_d;
     always @(*) begin
-        // Exponents are biased by EXP_BIAS. So, E_res = (E_a - EXP_BIAS) + (E_b - EXP_BIAS) = (E_a + E_b) - 2*EXP_BIAS
-        // New biased exponent = E_res + EXP_BIAS = E_a + E_b - EXP_BIAS.
-        // Need to handle denormalized numbers, where exponent is effectively 1-bias, not 0-bias.
-        s1_exp_sum_d = $signed({2'b0,effective_exp_a}) + $signed({2'b0,effective_exp_b}) - $signed({2'b0,EXP_BIAS});
+        s1_exp_sum_d = $signed(exp_sum);
         s1_sign_d = sign_a ^ sign_b;
         s1_mant_a_d = full_mant_a;
         s1_mant_b_d = full_mant_b;
@@ -175,6 +221,12 @@ module fp_mul #(
         end
     end
 
+    assign prod_sign           = s2_sign_q;
+    assign prod_exp            = s2_exp_q;
+    assign prod_mant           = s2_mant_product_q;
+    assign prod_special        = s2_special_case_q;
+    assign prod_special_result = s2_special_result_q;
+
     //----------------------------------------------------------------
     // Stage 3: Normalize and Pack
     //----------------------------------------------------------------
@@ -198,6 +250,7 @@ module fp_mul #(
 
     // Stage 3 - Pipeline Registers
     reg signed [EXP_W+1:0]   s3_exp_q;
+    reg signed [EXP_W+1:0]   s3_exp_p1_q;
     reg                      s3_sign_q;
     reg        [2*MANT_W:0]  s3_mant_q;
     reg                      s3_special_case_q;
@@ -206,6 +259,7 @@ module fp_mul #(
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             s3_exp_q            <= '0;
+            s3_exp_p1_q         <= '0;
             s3_sign_q           <= 1'b0;
             s3_mant_q           <= '0;
             s3_special_case_q   <= 1'b0;
@@ -213,6 +267,7 @@ module fp_mul #(
             s3_rm_q             <= `RNE;
         end else begin
             s3_exp_q            <= s3_exp_d;
+            s3_exp_p1_q         <= s3_exp_d + 1; // Exponent for a rounding carry-out
             s3_sign_q           <= s2_sign_q;
             s3_mant_q           <= s3_mant_d;
             s3_special_case_q   <= s2_special_case_q;
@@ -246,9 +301,11 @@ module fp_mul #(
         .overflow_out(rounder_overflow)
     );
 
-    // 3. Calculate the final exponent after rounding.
-    // wire signed [EXP_W+1:0] final_exp_rounded = s3_exp_q + $signed({{(EXP_W+1){1'b0}},rounder_overflow});
-    wire signed [EXP_W+1:0] final_exp_rounded = s3_exp_q + rounder_overflow;
+    // 3. Select the final exponent after rounding.
+    //    Both candidates are registered in stage 3, the rounder carry only
+    //    drives the select. On overflow the rounded mantissa has wrapped to
+    //    zero, which is the correct fraction for exp+1.
+    wire signed [EXP_W+1:0] final_exp_rounded = rounder_overflow ? s3_exp_p1_q : s3_exp_q;
 
     // 4. Pack the final result based on all conditions.
     reg [EXP_W-1:0] out_exp;
@@ -260,14 +317,10 @@ module fp_mul #(
             out_mant = MANT_ALL_ZEROS;
         end else if (is_underflow) begin // Underflow -> Denormalized or Zero
             // After rounding a denormalized number, it's possible it rounds
-            // back up to the smallest normal number.
-            if (final_exp_rounded > $signed({(EXP_W+2){1'b0}})) begin
-                out_exp = 1;
-                out_mant = MANT_ALL_ZEROS; // Smallest normal number
-            end else begin
-                out_exp = EXP_ALL_ZEROS;
-                out_mant = rounded_mant_w_implicit[MANT_W-1:0];
-            end
+            // back up to the smallest normal number: the carry lands in the
+            // implicit bit position, which is exactly the exponent LSB.
+            out_exp = {{(EXP_W-1){1'b0}}, rounded_mant_w_implicit[MANT_W]};
+            out_mant = rounded_mant_w_implicit[MANT_W-1:0];
         end else begin // Normal number
             // The result is a normal number.
             out_exp = final_exp_rounded[EXP_W-1:0];
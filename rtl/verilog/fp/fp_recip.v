@@ -0,0 +1,230 @@
+// rtl/verilog/fp/fp_recip.v
+//
+// Verilog RTL for a parameterized floating-point reciprocal, result = 1 / a.
+//
+// The significand quotient 2^(2*MANT_W+3) / 1.m is formed by a pipelined
+// restoring divider, STEPS_PER_STAGE quotient bits per stage, followed by
+// GRS rounding (the remainder is the sticky bit). The result is the correctly
+// rounded reciprocal in every rounding mode of grs_rounder.
+//
+// Features:
+// - Parameterized for various precisions (fp16, fp32, fp64).
+// - Latency DIV_STAGES + 2 = ceil((MANT_W + 4) / STEPS_PER_STAGE) + 2.
+// - Special cases: NaN -> qNaN, +-Inf -> +-0, +-0 -> +-Inf.
+// - Denormal inputs are treated as zero (-> +-Inf), results below the
+//   smallest normal are flushed to zero (as in fp_add).
+
+`include "common_inc.vh"
+`include "grs_round.vh"  // \`RNE, etc.
+
+module fp_recip #(
+    parameter WIDTH  = 16,
+    parameter STEPS_PER_STAGE = 4  // Quotient bits per pipeline stage
+) (
+    input clk,
+    input rst_n,
+
+    input  [WIDTH-1:0] a,
+    input  [2:0]       rm, // Rounding mode (see grs_rounder.v for modes)
+
+    output [WIDTH-1:0] result
+);
+    // Derived parameters for convenience
+    localparam EXP_W            = (WIDTH == 64) ?   11 : (WIDTH == 32) ?    8 : (WIDTH == 16) ?    5 : 0; // IEEE-754
+    localparam EXP_BIAS         = (WIDTH == 64) ? 1023 : (WIDTH == 32) ?  127 : (WIDTH == 16) ?   15 : 0; // IEEE-754
+
+    localparam MANT_W       = WIDTH - 1 - EXP_W;
+    localparam SIGN_POS     = WIDTH - 1;
+    localparam EXP_POS      = MANT_W;
+
+    // Quotient bits: 2^(MANT_W+3) for 1/1.0, otherwise implicit bit, MANT_W fraction, guard and round
+    localparam DIV_STEPS    = MANT_W + 4;
+    localparam DIV_STAGES   = (DIV_STEPS + STEPS_PER_STAGE - 1) / STEPS_PER_STAGE;
+
+    `VERIF_DECLARE_PIPELINE(DIV_STAGES + 2)  // Verification support
+
+    // Constants for special values
+    localparam [ EXP_W-1:0] EXP_ALL_ONES   = { EXP_W{1'b1}};
+    localparam [ EXP_W-1:0] EXP_ALL_ZEROS  = { EXP_W{1'b0}};
+    localparam [MANT_W-1:0] MANT_ALL_ZEROS = {MANT_W{1'b0}};
+
+    localparam [WIDTH-1:0] QNAN   = {1'b0, EXP_ALL_ONES, {1'b1, {(MANT_W-1){1'b0}}}};
+    localparam [WIDTH-1:0] P_ZERO = {1'b0, {(WIDTH-1){1'b0}}};
+
+    //----------------------------------------------------------------
+    // Input Unpacking
+    //----------------------------------------------------------------
+
+    // Input value parts
+    wire              sign_a = a[SIGN_POS];
+    wire [ EXP_W-1:0] exp_a  = a[SIGN_POS-1:EXP_POS];
+    wire [MANT_W-1:0] mant_a = a[MANT_W-1:0];
+
+    // Detect special values
+    wire is_subnormal_a = (exp_a == EXP_ALL_ZEROS);                                   // Zero or denormal
+    wire is_inf_a       = (exp_a == EXP_ALL_ONES ) && (mant_a == MANT_ALL_ZEROS);
+    wire is_nan_a       = (exp_a == EXP_ALL_ONES ) && (mant_a != MANT_ALL_ZEROS);
+
+    //----------------------------------------------------------------
+    // Stage 1: Unpack and Special Case Detection
+    //----------------------------------------------------------------
+
+    // Stage 1 - Combinational Logic
+    reg                  s1_special_case_d;
+    reg [WIDTH-1:0]      s1_special_result_d;
+    always @(*) begin
+        s1_special_case_d   = 1'b0;
+        s1_special_result_d = QNAN;
+
+        if (is_nan_a) begin
+            s1_special_case_d   = 1'b1;
+            s1_special_result_d = QNAN;
+        end else if (is_inf_a) begin
+            s1_special_case_d   = 1'b1;
+            s1_special_result_d = {sign_a, {(WIDTH-1){1'b0}}};                  // 1 / Inf = 0
+        end else if (is_subnormal_a) begin
+            s1_special_case_d   = 1'b1;
+            s1_special_result_d = {sign_a, EXP_ALL_ONES, MANT_ALL_ZEROS};       // 1 / 0 = Inf
+        end
+    end
+
+    // Divider state per stage boundary: [0] holds the stage 1 registers,
+    // [DIV_STAGES] the complete quotient and remainder
+    reg [MANT_W+1:0]       st_rem             [0:DIV_STAGES]; // Partial remainder, < 2 * divisor
+    reg [DIV_STEPS-1:0]    st_quo             [0:DIV_STAGES];
+    reg [MANT_W:0]         st_div             [0:DIV_STAGES]; // Divisor 1.m
+    reg signed [EXP_W+1:0] st_exp             [0:DIV_STAGES]; // 2 * EXP_BIAS - exp (exponent of 1 / 1.0)
+    reg                    st_sign            [0:DIV_STAGES];
+    reg                    st_special_case    [0:DIV_STAGES];
+    reg [WIDTH-1:0]        st_special_result  [0:DIV_STAGES];
+    reg [2:0]              st_rm              [0:DIV_STAGES];
+
+    // Stage 1 - Pipeline Registers
+    // The remainder starts at 2^(2*MANT_W+3) >> DIV_STEPS, below the divisor
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            st_rem[0]            <= '0;
+            st_quo[0]            <= '0;
+            st_div[0]            <= '0;
+            st_exp[0]            <= '0;
+            st_sign[0]           <= 1'b0;
+            st_special_case[0]   <= 1'b0;
+            st_special_result[0] <= P_ZERO;
+            st_rm[0]             <= `RNE;
+        end else begin
+            st_rem[0]            <= {2'b01, {(MANT_W-1){1'b0}}};
+            st_quo[0]            <= '0;
+            st_div[0]            <= {1'b1, mant_a};
+            st_exp[0]            <= 2 * EXP_BIAS - exp_a;
+            st_sign[0]           <= sign_a;
+            st_special_case[0]   <= s1_special_case_d;
+            st_special_result[0] <= s1_special_result_d;
+            st_rm[0]             <= rm;
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stages 2 .. DIV_STAGES+1: Restoring Division
+    //----------------------------------------------------------------
+
+    genvar gs;
+    generate
+        for (gs = 0; gs < DIV_STAGES; gs = gs + 1) begin : div_stage
+            reg [MANT_W+1:0]    rem_d;
+            reg [DIV_STEPS-1:0] quo_d;
+            integer t;
+            always @(*) begin
+                rem_d = st_rem[gs];
+                quo_d = st_quo[gs];
+                for (t = 0; t < STEPS_PER_STAGE; t = t + 1) begin
+                    if (gs * STEPS_PER_STAGE + t < DIV_STEPS) begin
+                        rem_d = rem_d << 1;
+                        if (rem_d >= st_div[gs]) begin
+                            rem_d = rem_d - st_div[gs];
+                            quo_d = {quo_d[DIV_STEPS-2:0], 1'b1};
+                        end else begin
+                            quo_d = {quo_d[DIV_STEPS-2:0], 1'b0};
+                        end
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (!rst_n) begin
+                    st_rem[gs+1]            <= '0;
+                    st_quo[gs+1]            <= '0;
+                    st_div[gs+1]            <= '0;
+                    st_exp[gs+1]            <= '0;
+                    st_sign[gs+1]           <= 1'b0;
+                    st_special_case[gs+1]   <= 1'b0;
+                    st_special_result[gs+1] <= P_ZERO;
+                    st_rm[gs+1]             <= `RNE;
+                end else begin
+                    st_rem[gs+1]            <= rem_d;
+                    st_quo[gs+1]            <= quo_d;
+                    st_div[gs+1]            <= st_div[gs];
+                    st_exp[gs+1]            <= st_exp[gs];
+                    st_sign[gs+1]           <= st_sign[gs];
+                    st_special_case[gs+1]   <= st_special_case[gs];
+                    st_special_result[gs+1] <= st_special_result[gs];
+                    st_rm[gs+1]             <= st_rm[gs];
+                end
+            end
+        end
+    endgenerate
+
+    //----------------------------------------------------------------
+    // Final Stage: Normalize, Round and Pack
+    //----------------------------------------------------------------
+
+    wire [DIV_STEPS-1:0] quo    = st_quo[DIV_STAGES];
+    wire                 sticky = (st_rem[DIV_STAGES] != 0);
+
+    // The quotient is 2^(MANT_W+3) for 1.0 (exponent 2 * EXP_BIAS - exp) and
+    // 1x.xxx with the leading one at MANT_W+2 otherwise (one exponent less)
+    wire                 quo_top = quo[DIV_STEPS-1];
+    wire [DIV_STEPS-1:0] mant_to_round = quo_top ? {quo[DIV_STEPS-1:1], quo[0] | sticky} : {quo[DIV_STEPS-2:0], sticky};
+
+    wire [MANT_W:0] rounded_mant_w_implicit;
+    wire            rounder_overflow;
+    grs_rounder #(
+        .INPUT_WIDTH(DIV_STEPS),
+        .OUTPUT_WIDTH(MANT_W + 1) // Keep implicit bit for overflow check
+    ) u_rounder (
+        .value_in(mant_to_round),
+        .sign_in(st_sign[DIV_STAGES]),
+        .mode(st_rm[DIV_STAGES]),
+        .value_out(rounded_mant_w_implicit),
+        .overflow_out(rounder_overflow)
+    );
+
+    wire signed [EXP_W+1:0] final_exp = st_exp[DIV_STAGES] - $signed({1'b0, !quo_top}) + $signed({1'b0, rounder_overflow});
+
+    reg [WIDTH-1:0] result_d;
+    always @(*) begin
+        if (st_special_case[DIV_STAGES]) begin
+            result_d = st_special_result[DIV_STAGES];
+        end else if (final_exp >= $signed({2'b0, EXP_ALL_ONES})) begin // Overflow -> Infinity
+            result_d = {st_sign[DIV_STAGES], EXP_ALL_ONES, MANT_ALL_ZEROS};
+        end else if (final_exp <= 0) begin // Underflow -> Zero (no denormal results)
+            result_d = {st_sign[DIV_STAGES], {(WIDTH-1){1'b0}}};
+        end else begin
+            // A rounding overflow wraps the fraction to zero, the fraction of 2^(exp+1)
+            result_d = {st_sign[DIV_STAGES], final_exp[EXP_W-1:0], rounded_mant_w_implicit[MANT_W-1:0]};
+        end
+    end
+
+    // Final Pipeline
+    reg [WIDTH-1:0] result_q;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            result_q <= P_ZERO;
+        end else begin
+            result_q <= result_d;
+        end
+    end
+
+    // Assign final registered output
+    assign result = result_q;
+
+endmodule
@@ -0,0 +1,281 @@
+// rtl/verilog/fp/fp_reduce.v
+//
+// Verilog RTL for a pipelined floating-point reduction tree, result = sum of
+// the N elements of a vector.
+//
+// The elements are summed by a balanced pairwise tree, one new vector per
+// cycle. The tree order is fixed: with N padded to the next power of two
+// with -0 (an identity of the adders), level 1 adds elements (2k, 2k + 1),
+// each next level adds neighbouring sums the same way, left operand first.
+// The result of a vector therefore never depends on the timing or on the
+// other vectors, and verif/lib/fp_reduce_model.cpp reproduces it bit-exactly.
+//
+// WIDE selects the node arithmetic:
+// - WIDE = 0: fp_add nodes, every partial sum is rounded to the format (rm).
+//   Latency 4 * LEVELS.
+// - WIDE = 1: fp_reduce_add nodes on an unrounded internal format with a
+//   2-bit wider exponent and GUARD_BITS more mantissa bits plus a sticky bit;
+//   only the root rounds to the format (rm). Partial sums cannot overflow and
+//   lose far less to intermediate rounding. Latency 1 + 3 * LEVELS + 1
+//   (unpack, nodes, round).
+//
+// In both modes denormal results are flushed to zero (as in fp_add); WIDE = 1
+// also takes denormal inputs at their value.
+
+`include "common_inc.vh"
+`include "grs_round.vh"  // \`RNE, etc.
+`include "adders.vh"     // \`ADDER_BEHAVIORAL, etc.
+
+module fp_reduce #(
+    parameter WIDTH  = 16,
+    parameter N      = 8,    // Elements per vector, >= 2
+    parameter WIDE   = 0,    // 1: unrounded internal format, rounding at the root
+    parameter GUARD_BITS = 8,  // WIDE = 1: extra mantissa bits of the internal format
+    parameter ADDER_TOPOLOGY = `ADDER_BEHAVIORAL  // Mantissa adders (see adders.vh)
+) (
+    input clk,
+    input rst_n,
+
+    input  [N*WIDTH-1:0] in_data,  // Element i at [i*WIDTH +: WIDTH]
+    input                in_valid,
+    input  [2:0]         rm,       // Rounding mode (see grs_rounder.v for modes), taken with the vector
+
+    output [WIDTH-1:0]   out_data,
+    output               out_valid
+);
+    // Derived parameters for convenience
+    localparam EXP_W            = (WIDTH == 64) ?   11 : (WIDTH == 32) ?    8 : (WIDTH == 16) ?    5 : 0; // IEEE-754
+    localparam EXP_BIAS         = (WIDTH == 64) ? 1023 : (WIDTH == 32) ?  127 : (WIDTH == 16) ?   15 : 0; // IEEE-754
+
+    localparam MANT_W       = WIDTH - 1 - EXP_W;
+    localparam SIGN_POS     = WIDTH - 1;
+    localparam EXP_POS      = MANT_W;
+
+    // Tree shape, node i adds nodes 2i+1 and 2i+2, leaves at N_P2-1 .. 2*N_P2-2
+    localparam LEVELS       = $clog2(N);
+    localparam N_P2         = 1 << LEVELS;
+
+    localparam LATENCY      = WIDE ? 2 + 3 * LEVELS : 4 * LEVELS;
+
+    `VERIF_DECLARE_PIPELINE(LATENCY)  // Verification support
+
+    // Internal format of the WIDE nodes (see fp_reduce_add.v)
+    localparam I_EXP_W      = EXP_W + 2;
+    localparam I_MANT_W     = MANT_W + 1 + GUARD_BITS;
+    localparam I_W          = I_EXP_W + I_MANT_W + 4;
+
+    // Constants for special values
+    localparam [ EXP_W-1:0] EXP_ALL_ONES   = { EXP_W{1'b1}};
+    localparam [ EXP_W-1:0] EXP_ALL_ZEROS  = { EXP_W{1'b0}};
+    localparam [MANT_W-1:0] MANT_ALL_ZEROS = {MANT_W{1'b0}};
+
+    localparam [WIDTH-1:0] QNAN   = {1'b0, EXP_ALL_ONES, {1'b1, {(MANT_W-1){1'b0}}}};
+    localparam [WIDTH-1:0] P_ZERO = {1'b0, {(WIDTH-1){1'b0}}};
+    localparam [WIDTH-1:0] N_ZERO = {1'b1, {(WIDTH-1){1'b0}}};
+
+    //----------------------------------------------------------------
+    // Valid and Rounding Mode Sideband
+    //----------------------------------------------------------------
+
+    // rm_sr[k] / valid_sr[k] belong to the vector that entered k cycles earlier
+    reg [2:0] rm_sr    [1:LATENCY];
+    reg       valid_sr [1:LATENCY];
+
+    integer k;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            for (k = 1; k <= LATENCY; k = k + 1) begin
+                rm_sr[k]    <= `RNE;
+                valid_sr[k] <= 1'b0;
+            end
+        end else begin
+            rm_sr[1]    <= rm;
+            valid_sr[1] <= in_valid;
+            for (k = 2; k <= LATENCY; k = k + 1) begin
+                rm_sr[k]    <= rm_sr[k-1];
+                valid_sr[k] <= valid_sr[k-1];
+            end
+        end
+    end
+
+    assign out_valid = valid_sr[LATENCY];
+
+    // rm of the vector that entered k cycles earlier, including the input cycle
+    wire [2:0] rm_at [0:LATENCY];
+    assign rm_at[0] = rm;
+
+    // Elements, padded with -0
+    wire [WIDTH-1:0] element [0:N_P2-1];
+
+    genvar gi;
+    generate
+        for (gi = 1; gi <= LATENCY; gi = gi + 1) begin : rm_tap
+            assign rm_at[gi] = rm_sr[gi];
+        end
+
+        for (gi = 0; gi < N_P2; gi = gi + 1) begin : elem
+            if (gi < N) begin : g_in
+                assign element[gi] = in_data[gi*WIDTH +: WIDTH];
+            end else begin : g_pad
+                assign element[gi] = N_ZERO;
+            end
+        end
+
+        if (!WIDE) begin : g_round
+            //----------------------------------------------------------------
+            // fp_add Tree
+            //----------------------------------------------------------------
+
+            wire [WIDTH-1:0] node [0:2*N_P2-2];
+
+            for (gi = 0; gi < N_P2; gi = gi + 1) begin : leaf
+                assign node[N_P2-1+gi] = element[gi];
+            end
+
+            // A node at depth d gets its operands 4 * (LEVELS-1-d) cycles after the input
+            for (gi = 0; gi < N_P2 - 1; gi = gi + 1) begin : add
+                localparam DEPTH = $clog2(gi + 2) - 1;
+                localparam RM_AT = 4 * (LEVELS - 1 - DEPTH);
+                fp_add #(
+                    .WIDTH(WIDTH),
+                    .ADDER_TOPOLOGY(ADDER_TOPOLOGY)
+                ) u_add (
+                    .clk(clk),
+                    .rst_n(rst_n),
+                    .a(node[2*gi+1]),
+                    .b(node[2*gi+2]),
+                    .rm(rm_at[RM_AT]),
+                    .result(node[gi])
+                );
+            end
+
+            assign out_data = node[0];
+
+        end else begin : g_wide
+            //----------------------------------------------------------------
+            // Stage 1: Unpack to the Internal Format
+            //----------------------------------------------------------------
+
+            wire [I_W-1:0] node [0:2*N_P2-2];
+
+            for (gi = 0; gi < N_P2; gi = gi + 1) begin : leaf
+                wire [WIDTH-1:0]  x      = element[gi];
+                wire              sign_x = x[SIGN_POS];
+                wire [ EXP_W-1:0] exp_x  = x[SIGN_POS-1:EXP_POS];
+                wire [MANT_W-1:0] mant_x = x[MANT_W-1:0];
+
+                wire is_nan_x = (exp_x == EXP_ALL_ONES) && (mant_x != MANT_ALL_ZEROS);
+                wire is_inf_x = (exp_x == EXP_ALL_ONES) && (mant_x == MANT_ALL_ZEROS);
+
+                // Denormals are normalized from exponent 1
+                wire [I_MANT_W-1:0] full_mant = {(exp_x != EXP_ALL_ZEROS), mant_x, {GUARD_BITS{1'b0}}};
+
+                reg [I_MANT_W-1:0]        norm_mant;
+                reg signed [I_EXP_W-1:0]  norm_exp;
+                integer                   msb_pos;
+                integer                   i;
+                always @(*) begin
+                    msb_pos = 0;
+                    for (i = I_MANT_W - 1; i >= 0; i = i - 1) begin
+                        if (full_mant[i]) begin
+                            msb_pos = i;
+                            i = -1; // Verilog equivalent to break
+                        end
+                    end
+                    norm_mant = full_mant << ((I_MANT_W-1) - msb_pos);
+                    norm_exp  = ((exp_x == EXP_ALL_ZEROS) ? 1 : exp_x) - ((I_MANT_W-1) - msb_pos);
+                    if (full_mant == 0 || exp_x == EXP_ALL_ONES) begin  // Zero, Inf, NaN
+                        norm_mant = '0;
+                        norm_exp  = '0;
+                    end
+                end
+
+                reg [I_W-1:0] leaf_q;
+                always @(posedge clk or negedge rst_n) begin
+                    if (!rst_n) begin
+                        leaf_q <= '0;
+                    end else begin
+                        leaf_q <= {is_nan_x, is_inf_x, sign_x, norm_exp, norm_mant, 1'b0};
+                    end
+                end
+
+                assign node[N_P2-1+gi] = leaf_q;
+            end
+
+            //----------------------------------------------------------------
+            // Stages 2 .. 1 + 3 * LEVELS: Unrounded Adder Tree
+            //----------------------------------------------------------------
+
+            for (gi = 0; gi < N_P2 - 1; gi = gi + 1) begin : add
+                fp_reduce_add #(
+                    .EXP_W(I_EXP_W),
+                    .MANT_W(I_MANT_W),
+                    .ADDER_TOPOLOGY(ADDER_TOPOLOGY)
+                ) u_add (
+                    .clk(clk),
+                    .rst_n(rst_n),
+                    .a(node[2*gi+1]),
+                    .b(node[2*gi+2]),
+                    .result(node[gi])
+                );
+            end
+
+            //----------------------------------------------------------------
+            // Final Stage: Round and Pack
+            //----------------------------------------------------------------
+
+            wire                      root_nan    = node[0][I_W-1];
+            wire                      root_inf    = node[0][I_W-2];
+            wire                      root_sign   = node[0][I_W-3];
+            wire signed [I_EXP_W-1:0] root_exp    = node[0][I_W-4:I_MANT_W+1];
+            wire [I_MANT_W:0]         root_mant   = node[0][I_MANT_W:0];  // Mantissa and sticky
+            wire                      root_zero   = (root_mant[I_MANT_W:1] == 0);
+            wire [2:0]                root_rm     = rm_at[LATENCY-1];
+
+            wire [MANT_W:0] rounded_mant_w_implicit;
+            wire            rounder_overflow;
+            grs_rounder #(
+                .INPUT_WIDTH(I_MANT_W + 1),
+                .OUTPUT_WIDTH(MANT_W + 1) // Keep implicit bit for overflow check
+            ) u_rounder (
+                .value_in(root_mant),
+                .sign_in(root_sign),
+                .mode(root_rm),
+                .value_out(rounded_mant_w_implicit),
+                .overflow_out(rounder_overflow)
+            );
+
+            wire signed [I_EXP_W-1:0] final_exp = root_exp + $signed({1'b0, rounder_overflow});
+
+            reg [WIDTH-1:0] result_d;
+            always @(*) begin
+                if (root_nan) begin
+                    result_d = QNAN;
+                end else if (root_inf) begin
+                    result_d = {root_sign, EXP_ALL_ONES, MANT_ALL_ZEROS};
+                end else if (root_zero) begin
+                    result_d = {root_sign, {(WIDTH-1){1'b0}}};
+                end else if (final_exp >= $signed({2'b0, EXP_ALL_ONES})) begin // Overflow -> Infinity
+                    result_d = {root_sign, EXP_ALL_ONES, MANT_ALL_ZEROS};
+                end else if (final_exp <= 0) begin // Underflow -> Zero (no denormal results)
+                    result_d = {root_sign, {(WIDTH-1){1'b0}}};
+                end else begin
+                    // A rounding overflow wraps the fraction to zero, the fraction of 2^(exp+1)
+                    result_d = {root_sign, final_exp[EXP_W-1:0], rounded_mant_w_implicit[MANT_W-1:0]};
+                end
+            end
+
+            reg [WIDTH-1:0] result_q;
+            always @(posedge clk or negedge rst_n) begin
+                if (!rst_n) begin
+                    result_q <= P_ZERO;
+                end else begin
+                    result_q <= result_d;
+                end
+            end
+
+            assign out_data = result_q;
+        end
+    endgenerate
+
+endmodule
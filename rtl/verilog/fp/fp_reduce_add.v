@@ -0,0 +1,215 @@
+// rtl/verilog/fp/fp_reduce_add.v
+//
+// Verilog RTL for the internal adder node of fp_reduce (WIDE = 1).
+//
+// Adds two values of the unrounded internal format of fp_reduce and returns
+// the sum in the same format, without rounding:
+//   {nan, inf, sign, exp[EXP_W-1:0] (signed, biased as the IEEE format),
+//    mant[MANT_W-1:0] (leading one at MANT_W-1, or zero), sticky}
+// value = (-1)^sign * mant * 2^(exp - EXP_BIAS - (MANT_W-1)), plus a nonzero
+// remainder below the LSB when sticky is set. The exponent is wider than the
+// IEEE one, so sums inside the tree neither overflow nor underflow.
+//
+// The smaller operand is aligned into MANT_W + 3 bits with the sticky bit
+// jammed into the LSB (the bits shifted out and the operand sticky), added to
+// or subtracted from the larger one and normalized; the 3 extra bits fold into
+// the result sticky. The result depends only on the two operands, so a tree
+// of nodes has a fixed rounding behaviour (model: verif/lib/fp_reduce_model.cpp).
+//
+// Special values: NaN or +Inf + -Inf -> nan; Inf -> inf with its sign.
+// Zero is mant == 0: +-0 + +-0 = -0 only for -0 + -0, an exact cancellation
+// gives +0.
+//
+// Latency 3: align, add, normalize.
+
+`include "common_inc.vh"
+`include "adders.vh"     // \`ADDER_BEHAVIORAL, etc.
+
+module fp_reduce_add #(
+    parameter EXP_W  = 7,   // Internal exponent bits (signed)
+    parameter MANT_W = 19,  // Internal mantissa bits, leading one included
+    parameter ADDER_TOPOLOGY = `ADDER_BEHAVIORAL  // Mantissa adder (see adders.vh)
+) (
+    input clk,
+    input rst_n,
+
+    input  [EXP_W+MANT_W+3:0] a,
+    input  [EXP_W+MANT_W+3:0] b,
+
+    output [EXP_W+MANT_W+3:0] result
+);
+    `VERIF_DECLARE_PIPELINE(3)  // Verification support
+
+    localparam W       = EXP_W + MANT_W + 4;
+    localparam ALIGN_W = MANT_W + 3;  // Mantissa, guard, round and jammed sticky bit
+
+    // Field positions
+    localparam NAN_POS  = W - 1;
+    localparam INF_POS  = W - 2;
+    localparam SIGN_POS = W - 3;
+    localparam EXP_POS  = MANT_W + 1;
+
+    //----------------------------------------------------------------
+    // Input Unpacking
+    //----------------------------------------------------------------
+
+    wire                    nan_a    = a[NAN_POS];
+    wire                    inf_a    = a[INF_POS];
+    wire                    sign_a   = a[SIGN_POS];
+    wire signed [EXP_W-1:0] exp_a    = a[SIGN_POS-1:EXP_POS];
+    wire [MANT_W-1:0]       mant_a   = a[EXP_POS-1:1];
+    wire                    sticky_a = a[0];
+
+    wire                    nan_b    = b[NAN_POS];
+    wire                    inf_b    = b[INF_POS];
+    wire                    sign_b   = b[SIGN_POS];
+    wire signed [EXP_W-1:0] exp_b    = b[SIGN_POS-1:EXP_POS];
+    wire [MANT_W-1:0]       mant_b   = b[EXP_POS-1:1];
+    wire                    sticky_b = b[0];
+
+    wire zero_a = (mant_a == 0);
+    wire zero_b = (mant_b == 0);
+
+    //----------------------------------------------------------------
+    // Stage 1: Compare and Align
+    //----------------------------------------------------------------
+
+    // Stage 1 Combinational Logic
+    // The sticky bit takes part in the compare, so a subtraction never borrows
+    wire a_larger = zero_b || (!zero_a && (exp_a > exp_b || (exp_a == exp_b && {mant_a, sticky_a} >= {mant_b, sticky_b})));
+
+    wire signed [EXP_W-1:0] larger_exp    = a_larger ? exp_a : exp_b;
+    wire [ALIGN_W-1:0]      larger_mant   = a_larger ? {mant_a, 2'b00, sticky_a} : {mant_b, 2'b00, sticky_b};
+    wire [ALIGN_W-1:0]      smaller_mant  = a_larger ? {mant_b, 2'b00, sticky_b} : {mant_a, 2'b00, sticky_a};
+    wire [EXP_W:0]          exp_diff      = a_larger ? exp_a - exp_b : exp_b - exp_a;  // Any value for a zero smaller
+
+    wire [ALIGN_W-1:0]      smaller_shift = smaller_mant >> exp_diff;
+    wire                    smaller_lost  = ((smaller_shift << exp_diff) != smaller_mant);
+    wire [ALIGN_W-1:0]      smaller_align = {smaller_shift[ALIGN_W-1:1], smaller_shift[0] | smaller_lost};
+
+    // Special values: NaN, Inf - Inf, else Inf
+    wire nan_d      = nan_a || nan_b || (inf_a && inf_b && (sign_a != sign_b));
+    wire inf_d      = !nan_d && (inf_a || inf_b);
+    wire inf_sign_d = inf_a ? sign_a : sign_b;
+
+    // Stage 1 Pipeline
+    reg                     s1_nan_q, s1_inf_q;
+    reg                     s1_sign_q;
+    reg                     s1_op_is_sub_q;
+    reg                     s1_zero_sign_q;  // Sign of a zero sum of two zeros
+    reg signed [EXP_W-1:0]  s1_exp_q;
+    reg [ALIGN_W-1:0]       s1_mant_a_q, s1_mant_b_q;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            s1_nan_q       <= 1'b0;
+            s1_inf_q       <= 1'b0;
+            s1_sign_q      <= 1'b0;
+            s1_op_is_sub_q <= 1'b0;
+            s1_zero_sign_q <= 1'b0;
+            s1_exp_q       <= '0;
+            s1_mant_a_q    <= '0;
+            s1_mant_b_q    <= '0;
+        end else begin
+            s1_nan_q       <= nan_d;
+            s1_inf_q       <= inf_d;
+            s1_sign_q      <= inf_d ? inf_sign_d : (a_larger ? sign_a : sign_b);
+            s1_op_is_sub_q <= (sign_a != sign_b);
+            s1_zero_sign_q <= sign_a && sign_b;
+            s1_exp_q       <= larger_exp;
+            s1_mant_a_q    <= larger_mant;
+            s1_mant_b_q    <= smaller_align;  // A zero (mant and sticky clear) aligns to zero
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage 2: Add or Subtract
+    //----------------------------------------------------------------
+
+    // s1_mant_a_q holds the larger magnitude, so a subtraction never borrows.
+    wire [ALIGN_W-1:0] mant_sum;
+    wire               mant_carry;
+    fas_vec_prefix #(
+        .WIDTH(ALIGN_W),
+        .TOPOLOGY(ADDER_TOPOLOGY)
+    ) u_mant_adder (
+        .a(s1_mant_a_q),
+        .b(s1_mant_b_q),
+        .cin(1'b0),
+        .add_nsub(s1_op_is_sub_q),
+        .z(mant_sum),
+        .cout(mant_carry)
+    );
+
+    // Stage 2 Pipeline
+    reg                     s2_nan_q, s2_inf_q;
+    reg                     s2_sign_q;
+    reg                     s2_zero_sign_q;
+    reg signed [EXP_W-1:0]  s2_exp_q;
+    reg [ALIGN_W:0]         s2_mant_q;  // 1 bit for carry
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            s2_nan_q       <= 1'b0;
+            s2_inf_q       <= 1'b0;
+            s2_sign_q      <= 1'b0;
+            s2_zero_sign_q <= 1'b0;
+            s2_exp_q       <= '0;
+            s2_mant_q      <= '0;
+        end else begin
+            s2_nan_q       <= s1_nan_q;
+            s2_inf_q       <= s1_inf_q;
+            s2_sign_q      <= s1_sign_q;
+            s2_zero_sign_q <= s1_zero_sign_q;
+            s2_exp_q       <= s1_exp_q;
+            s2_mant_q      <= {mant_carry & ~s1_op_is_sub_q, mant_sum};
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage 3: Normalize
+    //----------------------------------------------------------------
+
+    // Stage 3 Combinational Logic
+    reg  [ALIGN_W-1:0]      norm_mant;
+    reg  signed [EXP_W-1:0] norm_exp;
+    integer                 msb_pos;
+    integer                 i;
+    always @(*) begin
+        // Find MSB for normalization shift
+        msb_pos = 0;
+        for (i = ALIGN_W; i >= 0; i = i - 1) begin
+            if (s2_mant_q[i]) begin
+                msb_pos = i;
+                i = -1; // Verilog equivalent to break
+            end
+        end
+
+        if (s2_mant_q[ALIGN_W]) begin
+            // Carry out: shift right by one, the LSB jams into the sticky bit
+            norm_mant = {s2_mant_q[ALIGN_W:2], s2_mant_q[1] | s2_mant_q[0]};
+            norm_exp  = s2_exp_q + 1'b1;
+        end else begin
+            norm_mant = s2_mant_q[ALIGN_W-1:0] << ((ALIGN_W-1) - msb_pos);
+            norm_exp  = s2_exp_q - ((ALIGN_W-1) - msb_pos);
+        end
+    end
+
+    wire                    s3_zero   = (s2_mant_q == 0);
+    wire [MANT_W-1:0]       s3_mant   = s3_zero ? '0 : norm_mant[ALIGN_W-1:3];
+    wire                    s3_sticky = !s3_zero && (norm_mant[2:0] != 0);
+    wire                    s3_sign   = s3_zero && !s2_inf_q ? s2_zero_sign_q : s2_sign_q;
+    wire signed [EXP_W-1:0] s3_exp    = s3_zero ? '0 : norm_exp;
+
+    // Stage 3 Pipeline
+    reg [W-1:0] result_q;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            result_q <= '0;
+        end else begin
+            result_q <= {s2_nan_q, s2_inf_q, s3_sign, s3_exp, s3_mant, s3_sticky};
+        end
+    end
+
+    // Assign final registered output
+    assign result = result_q;
+
+endmodule
@@ -0,0 +1,453 @@
+// rtl/verilog/fp/fp_softmax.v
+//
+// Verilog RTL for a streaming row-wise softmax, y[i] = e^(x[i] - max) / sum.
+//
+// Rows stream in one element per cycle (in_valid / in_ready, in_last on the
+// last element) and are read once: the max and the sum are tracked online
+// while the row is written to a row buffer, and the normalized row streams
+// out of the buffer afterwards, one element per cycle, in input order.
+//
+// Accumulation (online normalizer, bit-accurate model fp_softmax_row in
+// verif/lib/fp_softmax_model.cpp, which documents the same order):
+// - Element i goes to slot i % SLOTS, each slot keeps a running max m and a
+//   sum d relative to it. The first element of a slot sets m = x, d = 1.
+//   Every other element x updates the slot with one exponential:
+//     e = fp_exp(fp_add(min(x, m), -max(x, m)))
+//     x >  m: d = fp_add(fp_mul(d, e), 1), m = x
+//     x <= m: d = fp_add(fp_mul(1, e), d)
+//   SLOTS = LAT_MUL + LAT_ADD, the latency of the d recurrence, so the slots
+//   take one element per cycle without stalls.
+// - At the end of the row the slots are merged pairwise with the same
+//   datapath, the incoming weight being the sum of the merged slot instead
+//   of 1: round r merges slot k + 2^r into slot k for k = 0, 2^(r+1), ...
+// - The output is y[i] = fp_mul(fp_exp(fp_add(x[i], -m)), fp_recip(d)).
+//
+// Throughput: a row of N elements occupies the accumulator for about
+// N + 76 cycles (pipeline drains between the merge rounds). Two row buffers
+// let the next row stream in while the previous one is normalized, so the
+// output of a row overlaps the input of the next. Independent rows scale by
+// instantiating one unit per lane.
+//
+// Restrictions:
+// - Rows must have 1 .. MAX_LEN elements (MAX_LEN a power of two).
+// - No output backpressure: out_valid pulses follow the pipeline.
+// - rm must be stable while rows are in flight.
+// - Inputs are expected to be finite, NaN ordering is not defined.
+
+`include "common_inc.vh"
+`include "grs_round.vh"  // \`RNE, etc.
+`include "adders.vh"     // \`ADDER_BEHAVIORAL, etc.
+
+module fp_softmax #(
+    parameter WIDTH   = 16,
+    parameter MAX_LEN = 4096,  // Row buffer depth (elements per row), power of two
+    parameter ADDER_TOPOLOGY = `ADDER_BEHAVIORAL  // fp_add / fp_mul exponent adders (see adders.vh)
+) (
+    input clk,
+    input rst_n,
+
+    input  [2:0]       rm, // Rounding mode (see grs_rounder.v for modes)
+
+    // Input row stream
+    input  [WIDTH-1:0] in_data,
+    input              in_valid,
+    input              in_last,
+    output             in_ready,
+
+    // Output row stream
+    output [WIDTH-1:0] out_data,
+    output             out_valid,
+    output             out_last
+);
+    // Derived parameters for convenience
+    localparam EXP_W            = (WIDTH == 64) ?   11 : (WIDTH == 32) ?    8 : (WIDTH == 16) ?    5 : 0; // IEEE-754
+    localparam EXP_BIAS         = (WIDTH == 64) ? 1023 : (WIDTH == 32) ?  127 : (WIDTH == 16) ?   15 : 0; // IEEE-754
+    localparam MANT_W           = WIDTH - 1 - EXP_W;
+
+    localparam [WIDTH-1:0] P_ONE = {2'b00, {(EXP_W-1){1'b1}}, {MANT_W{1'b0}}};
+
+    // Unit latencies (PIPELINE_LATENCY of fp_add, fp_mul, fp_exp, fp_recip)
+    localparam LAT_ADD   = 4;
+    localparam LAT_MUL   = 4;
+    localparam LAT_EXP   = 3;
+    localparam LAT_RECIP = (MANT_W + 4 + 3) / 4 + 2;
+
+    // Accumulator slots and merge rounds
+    localparam SLOTS     = LAT_MUL + LAT_ADD;
+    localparam SLOT_W    = $clog2(SLOTS);
+    localparam ROUNDS    = SLOT_W;
+
+    // Cycles from issue to the exponential, to the updated sum and to the output
+    localparam E_AT      = 1 + LAT_ADD + LAT_EXP;
+    localparam ACC_AT    = E_AT + LAT_MUL + LAT_ADD;
+    localparam OUT_AT    = E_AT + LAT_MUL;
+
+    localparam ADDR_W    = $clog2(MAX_LEN);
+
+    `VERIF_DECLARE_PIPELINE(OUT_AT)  // Verification support: buffer read to output
+
+    // Sign-magnitude order key, x > y <=> key(x) > key(y) for non-NaN values
+    function [WIDTH-1:0] ord_key;
+        input [WIDTH-1:0] v;
+        begin
+            ord_key = v[WIDTH-1] ? ~v : {1'b1, v[WIDTH-2:0]};
+        end
+    endfunction
+
+    // Row buffers, buffer b at b * MAX_LEN
+    reg [WIDTH-1:0] row_buf [0:2*MAX_LEN-1];
+    reg [1:0]       buf_busy;  // Row waiting for or in normalization
+
+    // Accumulated row, handed from the accumulator to the normalizer
+    reg              job_valid;
+    reg [WIDTH-1:0]  job_m, job_d;
+    reg [ADDR_W-1:0] job_last;  // Index of the last element
+    reg              job_buf;
+
+    //----------------------------------------------------------------
+    // Accumulator: Slots, Issue and Merge Control
+    //----------------------------------------------------------------
+
+    localparam [1:0] A_FILL  = 2'd0, // Accept the row
+                     A_WAIT  = 2'd1, // Wait for the pipeline to drain
+                     A_MERGE = 2'd2, // Issue one merge round
+                     A_DONE  = 2'd3; // Hand the row to the normalizer
+
+    reg [1:0]            a_state;
+    reg [ADDR_W-1:0]     a_len;   // Index of the next element
+    reg                  a_buf;
+    reg [$clog2(ROUNDS+1)-1:0] a_round;
+    reg [SLOT_W-1:0]     a_idx;   // Merge within the round
+    reg [SLOTS-1:0]      used;
+    reg [WIDTH-1:0]      slot_m [0:SLOTS-1];
+    reg [WIDTH-1:0]      slot_d [0:SLOTS-1];
+
+    assign in_ready = (a_state == A_FILL) && !buf_busy[a_buf];
+    wire accept = in_valid && in_ready;
+
+    // Sideband of the accumulator pipeline, sb_*[k] belongs to the entry issued k cycles earlier
+    reg               sb_valid [1:ACC_AT];
+    reg [SLOT_W-1:0]  sb_slot  [1:ACC_AT];
+    reg               sb_swap  [1:E_AT];
+    reg [WIDTH-1:0]   sb_w     [1:E_AT];
+    reg [WIDTH-1:0]   q_sr     [1:LAT_MUL];  // Addend, from E_AT to the adder
+    reg [WIDTH-1:0]   s0_min, s0_max;
+
+    reg acc_busy;
+    integer bk;
+    always @(*) begin
+        acc_busy = 1'b0;
+        for (bk = 1; bk <= ACC_AT; bk = bk + 1) acc_busy = acc_busy | sb_valid[bk];
+    end
+
+    // Merge of round a_round: slot a_idx << (a_round + 1) takes slot + 2^a_round
+    wire [SLOT_W-1:0] merge_dst = a_idx << (a_round + 1);
+    wire [SLOT_W-1:0] merge_src = merge_dst + (1 << a_round);
+    wire [SLOT_W-1:0] merge_cnt = SLOTS >> (a_round + 1);
+
+    // Issue: an element into a used slot or a merge of two used slots. The used
+    // slots are a prefix, so a used source always merges into a used destination.
+    reg               iss_valid;
+    reg               iss_init;   // First element of a slot
+    reg [SLOT_W-1:0]  iss_slot;
+    reg [WIDTH-1:0]   iss_x, iss_w;
+    always @(*) begin
+        iss_valid = 1'b0;
+        iss_init  = 1'b0;
+        iss_slot  = a_len[SLOT_W-1:0];
+        iss_x     = in_data;
+        iss_w     = P_ONE;
+        if (a_state == A_FILL) begin
+            if (accept) begin
+                iss_valid = used[iss_slot];
+                iss_init  = !used[iss_slot];
+            end
+        end else if (a_state == A_MERGE) begin
+            iss_slot  = merge_dst;
+            iss_x     = slot_m[merge_src];
+            iss_w     = slot_d[merge_src];
+            iss_valid = used[merge_src];
+        end
+    end
+
+    wire             iss_swap = ord_key(iss_x) > ord_key(slot_m[iss_slot]);
+    wire [WIDTH-1:0] iss_max  = iss_swap ? iss_x : slot_m[iss_slot];
+    wire [WIDTH-1:0] iss_min  = iss_swap ? slot_m[iss_slot] : iss_x;
+
+    //----------------------------------------------------------------
+    // Accumulator: Datapath
+    //----------------------------------------------------------------
+
+    wire [WIDTH-1:0] acc_diff, acc_e, acc_prod, acc_sum;
+
+    fp_add #(.WIDTH(WIDTH), .ADDER_TOPOLOGY(ADDER_TOPOLOGY)) u_acc_sub (
+        .clk(clk), .rst_n(rst_n),
+        .a(s0_min), .b({~s0_max[WIDTH-1], s0_max[WIDTH-2:0]}), .rm(rm),
+        .result(acc_diff)
+    );
+
+    fp_exp #(.WIDTH(WIDTH)) u_acc_exp (
+        .clk(clk), .rst_n(rst_n),
+        .a(acc_diff), .rm(rm),
+        .result(acc_e)
+    );
+
+    // Sum of the slot, bypassed from the adder for the entry SLOTS cycles ahead
+    wire             e_bypass = sb_valid[ACC_AT] && (sb_slot[ACC_AT] == sb_slot[E_AT]);
+    wire [WIDTH-1:0] e_d      = e_bypass ? acc_sum : slot_d[sb_slot[E_AT]];
+
+    fp_mul #(.WIDTH(WIDTH), .ADDER_TOPOLOGY(ADDER_TOPOLOGY)) u_acc_mul (
+        .clk(clk), .rst_n(rst_n),
+        .a(sb_swap[E_AT] ? e_d : sb_w[E_AT]), .b(acc_e), .rm(rm),
+        .result(acc_prod)
+    );
+
+    fp_add #(.WIDTH(WIDTH), .ADDER_TOPOLOGY(ADDER_TOPOLOGY)) u_acc_add (
+        .clk(clk), .rst_n(rst_n),
+        .a(acc_prod), .b(q_sr[LAT_MUL]), .rm(rm),
+        .result(acc_sum)
+    );
+
+    integer sk;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            for (sk = 1; sk <= ACC_AT; sk = sk + 1) begin
+                sb_valid[sk] <= 1'b0;
+                sb_slot[sk]  <= '0;
+            end
+            for (sk = 1; sk <= E_AT; sk = sk + 1) begin
+                sb_swap[sk] <= 1'b0;
+                sb_w[sk]    <= '0;
+            end
+            for (sk = 1; sk <= LAT_MUL; sk = sk + 1) q_sr[sk] <= '0;
+            s0_min <= '0;
+            s0_max <= '0;
+        end else begin
+            sb_valid[1] <= iss_valid;
+            sb_slot[1]  <= iss_slot;
+            sb_swap[1]  <= iss_swap;
+            sb_w[1]     <= iss_w;
+            s0_min      <= iss_min;
+            s0_max      <= iss_max;
+            for (sk = 2; sk <= ACC_AT; sk = sk + 1) begin
+                sb_valid[sk] <= sb_valid[sk-1];
+                sb_slot[sk]  <= sb_slot[sk-1];
+            end
+            for (sk = 2; sk <= E_AT; sk = sk + 1) begin
+                sb_swap[sk] <= sb_swap[sk-1];
+                sb_w[sk]    <= sb_w[sk-1];
+            end
+            q_sr[1] <= sb_swap[E_AT] ? sb_w[E_AT] : e_d;
+            for (sk = 2; sk <= LAT_MUL; sk = sk + 1) q_sr[sk] <= q_sr[sk-1];
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Accumulator: State
+    //----------------------------------------------------------------
+
+    // Row buffer write
+    always @(posedge clk) begin
+        if (accept) row_buf[{a_buf, a_len}] <= in_data;
+    end
+
+    wire a_give = (a_state == A_DONE) && !job_valid;
+
+    integer ak;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            a_state <= A_FILL;
+            a_len   <= '0;
+            a_buf   <= 1'b0;
+            a_round <= '0;
+            a_idx   <= '0;
+            used    <= '0;
+            for (ak = 0; ak < SLOTS; ak = ak + 1) begin
+                slot_m[ak] <= '0;
+                slot_d[ak] <= '0;
+            end
+        end else begin
+            // Updated sums leave the adder
+            if (sb_valid[ACC_AT]) slot_d[sb_slot[ACC_AT]] <= acc_sum;
+
+            if (iss_valid) slot_m[iss_slot] <= iss_max;
+            if (iss_init) begin
+                slot_m[iss_slot] <= in_data;
+                slot_d[iss_slot] <= P_ONE;
+                used[iss_slot]   <= 1'b1;
+            end
+
+            case (a_state)
+                A_FILL: begin
+                    if (accept) begin
+                        a_len <= a_len + 1'b1;
+                        if (in_last) begin
+                            a_state <= A_WAIT;
+                            a_round <= '0;
+                            a_idx   <= '0;
+                        end
+                    end
+                end
+                A_WAIT: begin
+                    if (!acc_busy) a_state <= (a_round == ROUNDS) ? A_DONE : A_MERGE;
+                end
+                A_MERGE: begin
+                    a_idx <= a_idx + 1'b1;
+                    if (a_idx == merge_cnt - 1) begin
+                        a_idx   <= '0;
+                        a_round <= a_round + 1'b1;
+                        a_state <= A_WAIT;
+                    end
+                end
+                A_DONE: begin
+                    if (a_give) begin
+                        a_state <= A_FILL;
+                        a_len   <= '0;
+                        a_buf   <= !a_buf;
+                        used    <= '0;
+                    end
+                end
+            endcase
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Normalizer: Reciprocal and Output Stream
+    //----------------------------------------------------------------
+
+    localparam [1:0] N_IDLE  = 2'd0, // Wait for a row
+                     N_RECIP = 2'd1, // Wait for 1 / d
+                     N_OUT   = 2'd2, // Stream the row out of the buffer
+                     N_FLUSH = 2'd3; // Wait for the output pipeline to drain
+
+    reg [1:0]        n_state;
+    reg [WIDTH-1:0]  n_m, n_d, n_r;
+    reg [ADDR_W-1:0] n_last, n_idx;
+    reg              n_buf;
+    reg [$clog2(LAT_RECIP+1)-1:0] n_cnt;
+
+    wire n_take    = (n_state == N_IDLE) && job_valid;
+    wire n_release = (n_state == N_OUT) && (n_idx == n_last);
+
+    // Output sideband, ob_*[k] belongs to the buffer read issued k cycles earlier
+    reg             ob_valid [1:OUT_AT];
+    reg             ob_last  [1:OUT_AT];
+    reg [WIDTH-1:0] o_x;
+
+    reg out_busy;
+    integer ok;
+    always @(*) begin
+        out_busy = 1'b0;
+        for (ok = 1; ok <= OUT_AT; ok = ok + 1) out_busy = out_busy | ob_valid[ok];
+    end
+
+    wire [WIDTH-1:0] n_recip, out_diff, out_e;
+
+    fp_recip #(.WIDTH(WIDTH)) u_recip (
+        .clk(clk), .rst_n(rst_n),
+        .a(n_d), .rm(rm),
+        .result(n_recip)
+    );
+
+    fp_add #(.WIDTH(WIDTH), .ADDER_TOPOLOGY(ADDER_TOPOLOGY)) u_out_sub (
+        .clk(clk), .rst_n(rst_n),
+        .a(o_x), .b({~n_m[WIDTH-1], n_m[WIDTH-2:0]}), .rm(rm),
+        .result(out_diff)
+    );
+
+    fp_exp #(.WIDTH(WIDTH)) u_out_exp (
+        .clk(clk), .rst_n(rst_n),
+        .a(out_diff), .rm(rm),
+        .result(out_e)
+    );
+
+    fp_mul #(.WIDTH(WIDTH), .ADDER_TOPOLOGY(ADDER_TOPOLOGY)) u_out_mul (
+        .clk(clk), .rst_n(rst_n),
+        .a(out_e), .b(n_r), .rm(rm),
+        .result(out_data)
+    );
+
+    assign out_valid = ob_valid[OUT_AT];
+    assign out_last  = ob_last[OUT_AT];
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            n_state <= N_IDLE;
+            n_m     <= '0;
+            n_d     <= '0;
+            n_r     <= '0;
+            n_last  <= '0;
+            n_idx   <= '0;
+            n_buf   <= 1'b0;
+            n_cnt   <= '0;
+            o_x     <= '0;
+            for (ok = 1; ok <= OUT_AT; ok = ok + 1) begin
+                ob_valid[ok] <= 1'b0;
+                ob_last[ok]  <= 1'b0;
+            end
+        end else begin
+            ob_valid[1] <= (n_state == N_OUT);
+            ob_last[1]  <= n_release;
+            for (ok = 2; ok <= OUT_AT; ok = ok + 1) begin
+                ob_valid[ok] <= ob_valid[ok-1];
+                ob_last[ok]  <= ob_last[ok-1];
+            end
+
+            case (n_state)
+                N_IDLE: begin
+                    if (n_take) begin
+                        n_m     <= job_m;
+                        n_d     <= job_d;
+                        n_last  <= job_last;
+                        n_buf   <= job_buf;
+                        n_cnt   <= LAT_RECIP;
+                        n_state <= N_RECIP;
+                    end
+                end
+                N_RECIP: begin
+                    n_cnt <= n_cnt - 1'b1;
+                    if (n_cnt == 0) begin
+                        n_r     <= n_recip;
+                        n_idx   <= '0;
+                        n_state <= N_OUT;
+                    end
+                end
+                N_OUT: begin
+                    o_x   <= row_buf[{n_buf, n_idx}];
+                    n_idx <= n_idx + 1'b1;
+                    if (n_release) n_state <= N_FLUSH;
+                end
+                N_FLUSH: begin
+                    if (!out_busy) n_state <= N_IDLE;
+                end
+            endcase
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Row Hand-Off
+    //----------------------------------------------------------------
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            job_valid <= 1'b0;
+            job_m     <= '0;
+            job_d     <= '0;
+            job_last  <= '0;
+            job_buf   <= 1'b0;
+            buf_busy  <= 2'b00;
+        end else begin
+            if (n_take) job_valid <= 1'b0;
+            if (n_release) buf_busy[n_buf] <= 1'b0;
+            if (a_give) begin
+                job_valid       <= 1'b1;
+                job_m           <= slot_m[0];
+                job_d           <= slot_d[0];
+                job_last        <= a_len - 1'b1;
+                job_buf         <= a_buf;
+                buf_busy[a_buf] <= 1'b1;
+            end
+        end
+    end
+
+endmodule
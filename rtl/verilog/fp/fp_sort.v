@@ -0,0 +1,136 @@
+// rtl/verilog/fp/fp_sort.v
+//
+// Verilog RTL for a pipelined floating-point bitonic sorting network: sorts
+// the N elements of a vector and returns their original positions.
+//
+// Sort order (fp_sort_cx.v): IEEE totalOrder, descending by default
+// (DESCENDING = 0: ascending); identical encodings by input position. The
+// order is total, so the result is unique and verif/lib/fp_sort_model.cpp
+// reproduces it bit-exactly.
+//
+// Network: for N = 2^LOG_N, phase p = 0 .. LOG_N-1 merges bitonic blocks of
+// 2^(p+1) elements in p+1 layers of N/2 compare-exchanges (partner distance
+// 2^p .. 1), blocks alternately in and against the sort order; the last
+// phase sorts the whole vector. LAYERS = LOG_N * (LOG_N + 1) / 2.
+// A pipeline register follows every LAYERS_PER_STAGE layers and the last one:
+//   Latency ceil(LAYERS / LAYERS_PER_STAGE), one new vector per cycle.
+
+`include "common_inc.vh"
+
+module fp_sort #(
+    parameter WIDTH      = 16,
+    parameter N          = 8,  // Elements per vector, power of two >= 2
+    parameter DESCENDING = 1,
+    parameter LAYERS_PER_STAGE = 1,
+    parameter IDX_W      = $clog2(N)
+) (
+    input clk,
+    input rst_n,
+
+    input  [N*WIDTH-1:0] in_data,   // Element i at [i*WIDTH +: WIDTH]
+    input                in_valid,
+
+    output [N*WIDTH-1:0] out_data,  // Sorted, rank r at [r*WIDTH +: WIDTH]
+    output [N*IDX_W-1:0] out_idx,   // Input position of rank r at [r*IDX_W +: IDX_W]
+    output               out_valid
+);
+    localparam LOG_N   = $clog2(N);
+    localparam LAYERS  = LOG_N * (LOG_N + 1) / 2;
+    localparam STAGES  = (LAYERS + LAYERS_PER_STAGE - 1) / LAYERS_PER_STAGE;
+    localparam LATENCY = STAGES;
+
+    // Network element: {data, index}
+    localparam EW = WIDTH + IDX_W;
+
+    `VERIF_DECLARE_PIPELINE(LATENCY)  // Verification support
+
+    //----------------------------------------------------------------
+    // Valid Sideband
+    //----------------------------------------------------------------
+
+    reg valid_sr [1:LATENCY];
+
+    integer k;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            for (k = 1; k <= LATENCY; k = k + 1) valid_sr[k] <= 1'b0;
+        end else begin
+            valid_sr[1] <= in_valid;
+            for (k = 2; k <= LATENCY; k = k + 1) valid_sr[k] <= valid_sr[k-1];
+        end
+    end
+
+    assign out_valid = valid_sr[LATENCY];
+
+    //----------------------------------------------------------------
+    // Network
+    //----------------------------------------------------------------
+
+    // lay[t]: elements at the input of layer t, lay[LAYERS]: sorted
+    wire [N*EW-1:0] lay [0:LAYERS];
+
+    genvar i, p, r;
+    generate
+        for (i = 0; i < N; i = i + 1) begin : elem
+            localparam [IDX_W-1:0] IDX = i;
+            assign lay[0][i*EW +: EW] = {in_data[i*WIDTH +: WIDTH], IDX};
+        end
+
+        for (p = 0; p < LOG_N; p = p + 1) begin : phase
+            for (r = 0; r <= p; r = r + 1) begin : layer
+                localparam integer T    = p * (p + 1) / 2 + r;  // Layer number
+                localparam integer DIST = 1 << (p - r);         // Partner distance
+
+                wire [N*EW-1:0] d_in = lay[T];
+                wire [N*EW-1:0] d_out;
+
+                for (i = 0; i < N; i = i + 1) begin : node
+                    if ((i & DIST) == 0) begin : cx
+                        // Blocks of 2^(p+1) alternate direction; the last phase is one block
+                        localparam UP = ((i & (2 << p)) == 0);
+
+                        wire [WIDTH-1:0] first, second;
+                        wire [IDX_W-1:0] first_idx, second_idx;
+
+                        fp_sort_cx #(
+                            .WIDTH(WIDTH),
+                            .IDX_W(IDX_W),
+                            .DESCENDING(DESCENDING)
+                        ) u_cx (
+                            .x(d_in[i*EW+IDX_W +: WIDTH]),
+                            .x_idx(d_in[i*EW +: IDX_W]),
+                            .y(d_in[(i+DIST)*EW+IDX_W +: WIDTH]),
+                            .y_idx(d_in[(i+DIST)*EW +: IDX_W]),
+                            .first(first),
+                            .first_idx(first_idx),
+                            .second(second),
+                            .second_idx(second_idx)
+                        );
+
+                        assign d_out[i*EW +: EW]        = UP ? {first, first_idx} : {second, second_idx};
+                        assign d_out[(i+DIST)*EW +: EW] = UP ? {second, second_idx} : {first, first_idx};
+                    end
+                end
+
+                if (((T + 1) % LAYERS_PER_STAGE == 0) || (T == LAYERS - 1)) begin : pipe
+                    reg [N*EW-1:0] d_q;
+                    always @(posedge clk or negedge rst_n) begin
+                        if (!rst_n)
+                            d_q <= '0;
+                        else
+                            d_q <= d_out;
+                    end
+                    assign lay[T+1] = d_q;
+                end else begin : comb
+                    assign lay[T+1] = d_out;
+                end
+            end
+        end
+
+        for (i = 0; i < N; i = i + 1) begin : rank
+            assign out_data[i*WIDTH +: WIDTH] = lay[LAYERS][i*EW+IDX_W +: WIDTH];
+            assign out_idx[i*IDX_W +: IDX_W]  = lay[LAYERS][i*EW +: IDX_W];
+        end
+    endgenerate
+
+endmodule
@@ -0,0 +1,55 @@
+// rtl/verilog/fp/fp_sort_cx.v
+//
+// Verilog RTL for the compare-exchange node of the sorting network
+// (fp_sort.v, fp_topk.v).
+//
+// Orders two (element, index) pairs: first / first_idx is the pair that
+// comes first in the sort order, second / second_idx the other one.
+// - DESCENDING = 1: x comes first if it is after y in IEEE totalOrder
+//   (+NaN, +Inf, ..., +0, -0, ..., -NaN).
+// - DESCENDING = 0: x comes first if it is before y in totalOrder.
+// Identical encodings are ordered by index, smaller index first, so the
+// order is total and the network result does not depend on the network
+// (verif/lib/fp_sort_model.cpp).
+//
+// Features:
+// - Combinational logic, one fp_cmp.
+
+module fp_sort_cx #(
+    parameter WIDTH      = 16,
+    parameter IDX_W      = 3,
+    parameter DESCENDING = 1
+) (
+    input  [WIDTH-1:0] x,
+    input  [IDX_W-1:0] x_idx,
+    input  [WIDTH-1:0] y,
+    input  [IDX_W-1:0] y_idx,
+
+    output [WIDTH-1:0] first,
+    output [IDX_W-1:0] first_idx,
+    output [WIDTH-1:0] second,
+    output [IDX_W-1:0] second_idx
+);
+    wire x_le_y;  // totalOrder(x, y)
+
+    fp_cmp #(.WIDTH(WIDTH)) cmp (
+        .a(x),
+        .b(y),
+        .lt(),
+        .eq(),
+        .gt(),
+        .unord(),
+        .min(),
+        .max(),
+        .total_order(x_le_y)
+    );
+
+    wire same    = (x == y);
+    wire x_first = same ? (x_idx < y_idx) : (DESCENDING ? !x_le_y : x_le_y);
+
+    assign first      = x_first ? x : y;
+    assign first_idx  = x_first ? x_idx : y_idx;
+    assign second     = x_first ? y : x;
+    assign second_idx = x_first ? y_idx : x_idx;
+
+endmodule
@@ -0,0 +1,169 @@
+// rtl/verilog/fp/fp_to_bfp.v
+//
+// Verilog RTL for a pipelined floating-point to block floating point
+// (microscaling, MX-style) converter: one block of BLOCK fp16 / fp32 elements
+// per cycle to a shared 8-bit exponent and BLOCK narrow signed mantissas.
+//
+// Format (as MXINT8 for MANT_W = 8):
+// - out_exp:  E8M0 block scale X = 2^(out_exp - 127); 0xFF (NaN) if any
+//             element is an infinity or a NaN, all mantissas 0 then
+// - out_mant: two's complement, MANT_W-2 fraction bits, so element i is
+//             m_i * 2^(out_exp - 127 - (MANT_W-2)), |m_i| <= 2^(MANT_W-1) - 1
+//
+// Conversion: out_exp is the largest element exponent (denormals and zeros
+// count as the smallest normal, an all-zero block gets that scale), and
+// every element is shifted right to it and rounded to nearest even;
+// magnitudes that round up to 2^(MANT_W-1) saturate.
+// verif/lib/bfp_model.cpp reproduces it bit-exactly.
+//
+// Features:
+// - WIDTH 16 or 32, MANT_W from 2 to the input mantissa width + 2.
+// - Maximum exponent by a tree of comparators, one block per cycle.
+// - Latency 2: stage 1 maximum exponent, stage 2 shift, round and saturate.
+
+`include "common_inc.vh"
+
+module fp_to_bfp #(
+    parameter WIDTH  = 16,
+    parameter BLOCK  = 32,  // Elements per block
+    parameter MANT_W = 8    // Element mantissa bits, sign included
+) (
+    input clk,
+    input rst_n,
+
+    input  [BLOCK*WIDTH-1:0]  in_data,   // Element i at [i*WIDTH +: WIDTH]
+    input                     in_valid,
+
+    output [7:0]              out_exp,   // Shared E8M0 exponent
+    output [BLOCK*MANT_W-1:0] out_mant,  // Element i at [i*MANT_W +: MANT_W]
+    output                    out_valid
+);
+    // Derived parameters for convenience
+    localparam EXP_W  = (WIDTH == 32) ? 8 : (WIDTH == 16) ? 5 : 0; // IEEE-754
+    localparam FRAC_W = WIDTH - 1 - EXP_W;
+    localparam BIAS   = (1 << (EXP_W - 1)) - 1;
+    localparam SIG_W  = FRAC_W + 1;
+
+    // Right shift of an element with the block exponent: SH0 + (emax - exp)
+    localparam SH0    = FRAC_W - (MANT_W - 2);
+    localparam SH_MAX = SIG_W + 1;            // Shifts beyond round to zero
+    localparam SH_W   = $clog2(SH_MAX + 1);
+    localparam [SH_W-1:0] SH_CAP = SH_MAX;
+
+    localparam LOG_B  = (BLOCK > 1) ? $clog2(BLOCK) : 1;
+    localparam P      = 1 << LOG_B;           // BLOCK padded to a power of two (>= 2)
+
+    localparam LATENCY = 2;
+
+    `VERIF_DECLARE_PIPELINE(LATENCY)  // Verification support
+
+    //----------------------------------------------------------------
+    // Stage 1: Maximum Exponent
+    //----------------------------------------------------------------
+
+    // Effective exponent: denormals and zeros at the smallest normal
+    function [EXP_W-1:0] eff_exp(input [WIDTH-1:0] x);
+        eff_exp = (x[WIDTH-2:FRAC_W] == 0) ? 1 : x[WIDTH-2:FRAC_W];
+    endfunction
+
+    // mx[l]: maxima of 2^l elements each, mx[LOG_B][0]: block maximum
+    wire [P*EXP_W-1:0] mx [0:LOG_B];
+    wire [BLOCK-1:0]   special;
+
+    genvar i, l;
+    generate
+        for (i = 0; i < P; i = i + 1) begin : elem
+            if (i < BLOCK) begin : used
+                assign mx[0][i*EXP_W +: EXP_W] = eff_exp(in_data[i*WIDTH +: WIDTH]);
+                assign special[i] = &in_data[i*WIDTH+WIDTH-2 : i*WIDTH+FRAC_W];
+            end else begin : pad
+                assign mx[0][i*EXP_W +: EXP_W] = {EXP_W{1'b0}};
+            end
+        end
+
+        for (l = 0; l < LOG_B; l = l + 1) begin : level
+            for (i = 0; i < (P >> (l + 1)); i = i + 1) begin : node
+                wire [EXP_W-1:0] x = mx[l][(2*i)*EXP_W +: EXP_W];
+                wire [EXP_W-1:0] y = mx[l][(2*i+1)*EXP_W +: EXP_W];
+                assign mx[l+1][i*EXP_W +: EXP_W] = (x < y) ? y : x;
+            end
+            for (i = (P >> (l + 1)); i < P; i = i + 1) begin : unused
+                assign mx[l+1][i*EXP_W +: EXP_W] = {EXP_W{1'b0}};
+            end
+        end
+    endgenerate
+
+    reg [BLOCK*WIDTH-1:0] s1_data;
+    reg [EXP_W-1:0]       s1_emax;
+    reg                   s1_special;
+    reg                   s1_valid;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            s1_data    <= {(BLOCK*WIDTH){1'b0}};
+            s1_emax    <= {EXP_W{1'b0}};
+            s1_special <= 1'b0;
+            s1_valid   <= 1'b0;
+        end else begin
+            s1_data    <= in_data;
+            s1_emax    <= mx[LOG_B][EXP_W-1:0];
+            s1_special <= |special;
+            s1_valid   <= in_valid;
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stage 2: Align, Round, Saturate
+    //----------------------------------------------------------------
+
+    wire [BLOCK*MANT_W-1:0] mant;
+
+    generate
+        for (i = 0; i < BLOCK; i = i + 1) begin : align
+            wire [WIDTH-1:0] x    = s1_data[i*WIDTH +: WIDTH];
+            wire             sign = x[WIDTH-1];
+            wire [EXP_W-1:0] e    = eff_exp(x);
+            wire [SIG_W-1:0] sig  = {x[WIDTH-2:FRAC_W] != 0, x[FRAC_W-1:0]};
+
+            // Shift capped at SH_MAX (s1_emax >= e)
+            wire [EXP_W:0]   d    = s1_emax - e;
+            wire [SH_W-1:0]  sh   = (d > SH_MAX - SH0) ? SH_CAP : SH0 + d;
+
+            // {q, round} = {sig, 0} >> sh, sticky: the bits shifted out below round
+            wire [SIG_W:0]   ext     = {sig, 1'b0};
+            wire [SIG_W:0]   shifted = ext >> sh;
+            wire             sticky  = |(ext & ~({(SIG_W+1){1'b1}} << sh));
+            wire [MANT_W-2:0] q      = shifted[MANT_W-1:1];
+            wire             rnd     = shifted[0];
+            wire             inc     = rnd && (sticky || q[0]);
+
+            // Magnitude, saturated to 2^(MANT_W-1) - 1, then the sign
+            wire [MANT_W-1:0] mag     = {1'b0, q} + inc;
+            wire [MANT_W-1:0] mag_sat = mag[MANT_W-1] ? {1'b0, {(MANT_W-1){1'b1}}} : mag;
+
+            assign mant[i*MANT_W +: MANT_W] = s1_special ? {MANT_W{1'b0}} :
+                                              sign       ? -mag_sat : mag_sat;
+        end
+    endgenerate
+
+    reg [7:0]              s2_exp;
+    reg [BLOCK*MANT_W-1:0] s2_mant;
+    reg                    s2_valid;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            s2_exp   <= 8'd0;
+            s2_mant  <= {(BLOCK*MANT_W){1'b0}};
+            s2_valid <= 1'b0;
+        end else begin
+            s2_exp   <= s1_special ? 8'hFF : s1_emax - BIAS + 127;
+            s2_mant  <= mant;
+            s2_valid <= s1_valid;
+        end
+    end
+
+    assign out_exp   = s2_exp;
+    assign out_mant  = s2_mant;
+    assign out_valid = s2_valid;
+
+endmodule
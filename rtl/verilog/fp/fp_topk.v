@@ -0,0 +1,199 @@
+// rtl/verilog/fp/fp_topk.v
+//
+// Verilog RTL for a streaming floating-point top-k unit: the K first
+// elements (in the sort order of fp_sort_cx.v, by default the K largest in
+// IEEE totalOrder) of a row that arrives as a stream of N-element vectors,
+// with their positions in the row.
+//
+// One vector per cycle (in_valid); in_last marks the last vector of a row.
+// Each vector is sorted by fp_sort; its K first elements, with row positions
+// vector_number * N + input_position, are merged into the running top-k of
+// the row in one cycle: the running list (in order) against the new list
+// reversed, the better of each pair, gives a bitonic sequence, which a
+// bitonic merger (log2(K) layers) puts in order. This merge is the feedback
+// path of the unit (1 + log2(K) compare-exchanges). Ties between identical
+// encodings go to the smaller row position, so the result is unique
+// (verif/lib/fp_sort_model.cpp).
+//
+// The top-k of a row is presented with out_valid for one cycle:
+//   Latency fp_sort + 1 after the last vector of the row.
+// Rows longer than 2^IDX_W elements wrap the positions.
+
+`include "common_inc.vh"
+
+module fp_topk #(
+    parameter WIDTH      = 16,
+    parameter N          = 8,   // Elements per vector, power of two >= 2
+    parameter K          = 4,   // Power of two, <= N
+    parameter DESCENDING = 1,   // 1: K largest, 0: K smallest
+    parameter LAYERS_PER_STAGE = 1,  // Sorting network layers per pipeline stage
+    parameter IDX_W      = 16   // Row position bits
+) (
+    input clk,
+    input rst_n,
+
+    input  [N*WIDTH-1:0] in_data,   // Element i at [i*WIDTH +: WIDTH]
+    input                in_valid,
+    input                in_last,   // Last vector of the row
+
+    output [K*WIDTH-1:0] out_data,  // Rank r at [r*WIDTH +: WIDTH]
+    output [K*IDX_W-1:0] out_idx,   // Row position of rank r at [r*IDX_W +: IDX_W]
+    output               out_valid
+);
+    localparam LOG_N        = $clog2(N);
+    localparam LOG_K        = $clog2(K);
+    localparam SORT_LAYERS  = LOG_N * (LOG_N + 1) / 2;
+    localparam SORT_LATENCY = (SORT_LAYERS + LAYERS_PER_STAGE - 1) / LAYERS_PER_STAGE;
+    localparam LATENCY      = SORT_LATENCY + 1;
+
+    // Merge element: {data, row position}
+    localparam EW = WIDTH + IDX_W;
+
+    `VERIF_DECLARE_PIPELINE(LATENCY)  // Verification support
+
+    //----------------------------------------------------------------
+    // Sort Each Vector
+    //----------------------------------------------------------------
+
+    wire [N*WIDTH-1:0] sort_data;
+    wire [N*LOG_N-1:0] sort_idx;
+    wire               sort_valid;
+
+    fp_sort #(
+        .WIDTH(WIDTH),
+        .N(N),
+        .DESCENDING(DESCENDING),
+        .LAYERS_PER_STAGE(LAYERS_PER_STAGE)
+    ) sorter (
+        .clk(clk),
+        .rst_n(rst_n),
+        .in_data(in_data),
+        .in_valid(in_valid),
+        .out_data(sort_data),
+        .out_idx(sort_idx),
+        .out_valid(sort_valid)
+    );
+
+    // in_last alongside the sorter
+    reg last_sr [1:SORT_LATENCY];
+
+    integer k;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            for (k = 1; k <= SORT_LATENCY; k = k + 1) last_sr[k] <= 1'b0;
+        end else begin
+            last_sr[1] <= in_last;
+            for (k = 2; k <= SORT_LATENCY; k = k + 1) last_sr[k] <= last_sr[k-1];
+        end
+    end
+
+    wire sort_last = last_sr[SORT_LATENCY];
+
+    //----------------------------------------------------------------
+    // Running Top-k
+    //----------------------------------------------------------------
+
+    reg [IDX_W-1:0] vec_base;     // Row position of element 0 of the sorted vector
+    reg             row_first;    // Sorted vector is the first of its row
+    reg [K*EW-1:0]  run;          // Running top-k, rank r at [r*EW +: EW]
+
+    wire [K*EW-1:0] vec_top;      // Top-k of the sorted vector
+    wire [K*EW-1:0] merged;       // Top-k of run and vec_top, in order
+
+    // mrg[0]: better of run[i] and vec_top[K-1-i] (bitonic), mrg[LOG_K]: in order
+    wire [K*EW-1:0] mrg [0:LOG_K];
+
+    genvar i, d;
+    generate
+        for (i = 0; i < K; i = i + 1) begin : top
+            wire [IDX_W-1:0] pos = vec_base | sort_idx[i*LOG_N +: LOG_N];
+            assign vec_top[i*EW +: EW] = {sort_data[i*WIDTH +: WIDTH], pos};
+        end
+
+        for (i = 0; i < K; i = i + 1) begin : pick
+            wire [WIDTH-1:0] first;
+            wire [IDX_W-1:0] first_idx;
+
+            fp_sort_cx #(
+                .WIDTH(WIDTH),
+                .IDX_W(IDX_W),
+                .DESCENDING(DESCENDING)
+            ) u_cx (
+                .x(run[i*EW+IDX_W +: WIDTH]),
+                .x_idx(run[i*EW +: IDX_W]),
+                .y(vec_top[(K-1-i)*EW+IDX_W +: WIDTH]),
+                .y_idx(vec_top[(K-1-i)*EW +: IDX_W]),
+                .first(first),
+                .first_idx(first_idx),
+                .second(),
+                .second_idx()
+            );
+
+            assign mrg[0][i*EW +: EW] = {first, first_idx};
+        end
+
+        for (d = 0; d < LOG_K; d = d + 1) begin : merge
+            localparam integer DIST = K >> (d + 1);
+
+            for (i = 0; i < K; i = i + 1) begin : node
+                if ((i & DIST) == 0) begin : cx
+                    wire [WIDTH-1:0] first, second;
+                    wire [IDX_W-1:0] first_idx, second_idx;
+
+                    fp_sort_cx #(
+                        .WIDTH(WIDTH),
+                        .IDX_W(IDX_W),
+                        .DESCENDING(DESCENDING)
+                    ) u_cx (
+                        .x(mrg[d][i*EW+IDX_W +: WIDTH]),
+                        .x_idx(mrg[d][i*EW +: IDX_W]),
+                        .y(mrg[d][(i+DIST)*EW+IDX_W +: WIDTH]),
+                        .y_idx(mrg[d][(i+DIST)*EW +: IDX_W]),
+                        .first(first),
+                        .first_idx(first_idx),
+                        .second(second),
+                        .second_idx(second_idx)
+                    );
+
+                    assign mrg[d+1][i*EW +: EW]        = {first, first_idx};
+                    assign mrg[d+1][(i+DIST)*EW +: EW] = {second, second_idx};
+                end
+            end
+        end
+    endgenerate
+
+    assign merged = mrg[LOG_K];
+
+    wire [K*EW-1:0] run_next = row_first ? vec_top : merged;
+
+    reg [K*EW-1:0] result_q;
+    reg            out_valid_q;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            vec_base    <= '0;
+            row_first   <= 1'b1;
+            run         <= '0;
+            result_q    <= '0;
+            out_valid_q <= 1'b0;
+        end else begin
+            out_valid_q <= sort_valid && sort_last;
+            if (sort_valid) begin
+                run       <= run_next;
+                row_first <= sort_last;
+                vec_base  <= sort_last ? '0 : vec_base + N;
+                if (sort_last) result_q <= run_next;
+            end
+        end
+    end
+
+    generate
+        for (i = 0; i < K; i = i + 1) begin : rank
+            assign out_data[i*WIDTH +: WIDTH] = result_q[i*EW+IDX_W +: WIDTH];
+            assign out_idx[i*IDX_W +: IDX_W]  = result_q[i*EW +: IDX_W];
+        end
+    endgenerate
+
+    assign out_valid = out_valid_q;
+
+endmodule
@@ -16,7 +16,11 @@
 // - Handles all special cases (NaN, Infinity, Zero).
 // - Truncates the result (no rounding). // TODO: (when needed) rounding.
 
-module fp16_mul_add (
+`include "adders.vh"  // \`ADDER_BEHAVIORAL, etc.
+
+module fp16_mul_add #(
+    parameter ADDER_TOPOLOGY = `ADDER_BEHAVIORAL  // Mantissa adder (see adders.vh)
+) (
     input clk,
     input rst_n,
 
@@ -163,14 +167,62 @@ module fp16_mul_add (
     //----------------------------------------------------------------
     // Stage 3: Align and Add
     //----------------------------------------------------------------
+
+    // Stage 3 Combinational Logic
+    // Align the operand with the smaller exponent, then order the magnitudes
+    // so that a subtraction always takes the smaller from the larger one and
+    // the result carries the sign of the larger.
+    reg signed [5:0] exp_diff;
+    reg        [47:0] mant_ab_extended, mant_c_extended;
+    reg        [47:0] add_op_big, add_op_small;
+    reg        [5:0] add_res_exp;
+    reg               add_res_sign;
+    reg               add_is_sub;
+    always @(*) begin
+        if(s2_norm_exp_ab >= s2_exp_c) begin
+            add_res_exp = s2_norm_exp_ab;
+            exp_diff = s2_norm_exp_ab - s2_exp_c;
+            mant_ab_extended = {s2_norm_mant_ab, 26'b0};
+            mant_c_extended = {s2_mant_c, 37'b0} >> exp_diff;
+        end else begin
+            add_res_exp = s2_exp_c;
+            exp_diff = s2_exp_c - s2_norm_exp_ab;
+            mant_ab_extended = {s2_norm_mant_ab, 26'b0} >> exp_diff;
+            mant_c_extended = {s2_mant_c, 37'b0};
+        end
+
+        add_is_sub = (s2_sign_ab != s2_sign_c);
+        if (s2_norm_exp_ab > s2_exp_c || (s2_norm_exp_ab == s2_exp_c && s2_norm_mant_ab >= {s2_mant_c, 11'b0})) begin
+            add_op_big   = mant_ab_extended;
+            add_op_small = mant_c_extended;
+            add_res_sign = s2_sign_ab;
+        end else begin
+            add_op_big   = mant_c_extended;
+            add_op_small = mant_ab_extended;
+            add_res_sign = s2_sign_c;
+        end
+    end
+
+    wire [47:0] add_sum;
+    fas_vec_prefix #(
+        .WIDTH(48),
+        .TOPOLOGY(ADDER_TOPOLOGY)
+    ) u_mant_adder (
+        .a(add_op_big),
+        .b(add_op_small),
+        .cin(1'b0),
+        .add_nsub(add_is_sub),
+        .z(add_sum),
+        .cout()
+    );
+
+    // Stage 3 Pipeline
     reg [ 5:0] s3_res_exp;
     reg        s3_res_sign;
     reg [47:0] s3_mant_sum; // Wide mantissa for calculation
     
     reg        s3_special_case;
     reg [15:0] s3_special_result;
-    reg signed [5:0] exp_diff;
-    reg [47:0] mant_ab_extended, mant_c_extended;
     always @(posedge clk or negedge rst_n) begin
         if (!rst_n) begin
             s3_res_exp        <= 0;
@@ -178,9 +230,6 @@ module fp16_mul_add (
             s3_mant_sum       <= 0;
             s3_special_case   <= 0;
             s3_special_result <= `FP16_ZERO;
-            exp_diff          <= 0;
-            mant_ab_extended  <= 0;
-            mant_c_extended   <= 0;
         end else begin
             // Logic to handle special case propagation before alignment
             if (s2_prop_is_nan || s2_is_nan_c) begin
@@ -206,26 +255,9 @@ module fp16_mul_add (
             end else begin
                 // Normal path: Align and add/subtract
                 s3_special_case <= 0;
-                
-                if(s2_norm_exp_ab >= s2_exp_c) begin
-                    s3_res_exp <= s2_norm_exp_ab;
-                    s3_res_sign <= s2_sign_ab;
-                    exp_diff <= s2_norm_exp_ab - s2_exp_c;
-                    mant_ab_extended = {s2_norm_mant_ab, 26'b0};
-                    mant_c_extended = {s2_mant_c, 37'b0} >> exp_diff;
-                end else begin
-                    s3_res_exp <= s2_exp_c;
-                    s3_res_sign <= s2_sign_c;
-                    exp_diff <= s2_exp_c - s2_norm_exp_ab;
-                    mant_ab_extended = {s2_norm_mant_ab, 26'b0} >> exp_diff;
-                    mant_c_extended = {s2_mant_c, 37'b0};
-                end
-
-                if (s2_sign_ab == s3_res_sign) begin // Add magnitudes
-                    s3_mant_sum <= mant_ab_extended + mant_c_extended;
-                end else begin // Subtract magnitudes
-                    s3_mant_sum <= mant_ab_extended - mant_c_extended;
-                end
+                s3_res_exp <= add_res_exp;
+                s3_res_sign <= add_res_sign;
+                s3_mant_sum <= add_sum;
             end
         end
     end
@@ -25,6 +25,11 @@ Functions:
 
 This script is part of a larger hardware description language (HDL) library
 for implementing floating-point arithmetic operations in digital circuits.
+
+Note: The in-tree LUT modules were generated by this script. The native
+verif/lib/fp_lut_gen.cpp (`make -f native.mk lut`) checks them against exact
+integer arithmetic: the double computation here is off by up to 3 units of the
+last place in some fp64 entries, which fp_lut_gen reports.
 """
 # rtl/verilog/generate_lut.py
 
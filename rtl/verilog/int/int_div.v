@@ -0,0 +1,183 @@
+// rtl/verilog/int/int_div.v
+//
+// Verilog RTL for a pipelined integer divider with remainder.
+//
+// Operation: quotient = a / b, remainder = a % b, truncating as in C, on
+// unsigned or two's complement operands (is_signed, per operation).
+//
+// Radix-4 digit recurrence on the magnitudes: every digit shifts the next two
+// dividend bits into the partial remainder r' = 4r + bits, compares r' with
+// d, 2d and 3d in parallel and subtracts the largest multiple that fits, so
+// the remainder never goes negative and no restoring step is needed.
+// DIGITS_PER_STAGE digits are computed per pipeline stage:
+//   Latency 2 + ceil(ceil(WIDTH/2) / DIGITS_PER_STAGE)
+//   (operand magnitudes, digit stages, sign correction), one new operation
+//   per cycle.
+//
+// Special cases (as RISC-V): x / 0 gives quotient all ones, remainder x;
+// signed MIN / -1 gives quotient MIN, remainder 0 (falls out of the
+// magnitudes).
+//
+// With is_signed = 0 this is a plain unsigned divider, e.g. for mantissas
+// (a nonzero remainder is the sticky bit). Model: verif/lib/int_model.c.
+
+`include "common_inc.vh"
+
+module int_div #(
+    parameter WIDTH = 32,
+    parameter DIGITS_PER_STAGE = 1  // Radix-4 digits (2 quotient bits each) per pipeline stage
+) (
+    input clk,
+    input rst_n,
+
+    input  [WIDTH-1:0] a,          // Dividend
+    input  [WIDTH-1:0] b,          // Divisor
+    input              is_signed,
+
+    output [WIDTH-1:0] quotient,
+    output [WIDTH-1:0] remainder
+);
+    localparam DIGITS   = (WIDTH + 1) / 2;
+    localparam NUM_W    = 2 * DIGITS;  // Dividend bits, WIDTH rounded up to whole digits
+    localparam STAGES   = (DIGITS + DIGITS_PER_STAGE - 1) / DIGITS_PER_STAGE;
+    localparam LATENCY  = STAGES + 2;
+
+    `VERIF_DECLARE_PIPELINE(LATENCY)  // Verification support
+
+    //----------------------------------------------------------------
+    // Stage 1: Operand Magnitudes
+    //----------------------------------------------------------------
+
+    wire             neg_a = is_signed && a[WIDTH-1];
+    wire             neg_b = is_signed && b[WIDTH-1];
+    wire [WIDTH-1:0] mag_a = neg_a ? -a : a;  // -MIN = MIN is 2^(WIDTH-1) unsigned
+    wire [WIDTH-1:0] mag_b = neg_b ? -b : b;
+
+    // Digit pipeline: partial remainder, remaining dividend bits, quotient
+    // digits so far, divisor multiples and the sideband of each operation
+    reg [WIDTH-1:0] rem_pipe     [0:STAGES];
+    reg [NUM_W-1:0] num_pipe     [0:STAGES];
+    reg [NUM_W-1:0] quo_pipe     [0:STAGES];
+    reg [WIDTH-1:0] d1_pipe      [0:STAGES];
+    reg [WIDTH+1:0] d3_pipe      [0:STAGES];
+    reg             neg_q_pipe   [0:STAGES];
+    reg             neg_r_pipe   [0:STAGES];
+    reg             div_zero_pipe[0:STAGES];
+    reg [WIDTH-1:0] a_pipe       [0:STAGES];  // Remainder of a division by zero
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            rem_pipe[0]      <= '0;
+            num_pipe[0]      <= '0;
+            quo_pipe[0]      <= '0;
+            d1_pipe[0]       <= '0;
+            d3_pipe[0]       <= '0;
+            neg_q_pipe[0]    <= 1'b0;
+            neg_r_pipe[0]    <= 1'b0;
+            div_zero_pipe[0] <= 1'b0;
+            a_pipe[0]        <= '0;
+        end else begin
+            rem_pipe[0]      <= '0;
+            num_pipe[0]      <= {{(NUM_W-WIDTH){1'b0}}, mag_a};
+            quo_pipe[0]      <= '0;
+            d1_pipe[0]       <= mag_b;
+            d3_pipe[0]       <= {2'b00, mag_b} + {1'b0, mag_b, 1'b0};
+            neg_q_pipe[0]    <= neg_a ^ neg_b;
+            neg_r_pipe[0]    <= neg_a;
+            div_zero_pipe[0] <= (b == 0);
+            a_pipe[0]        <= a;
+        end
+    end
+
+    //----------------------------------------------------------------
+    // Stages 2 .. STAGES+1: Radix-4 Digits
+    //----------------------------------------------------------------
+
+    genvar s;
+    generate
+        for (s = 0; s < STAGES; s = s + 1) begin : stage
+            wire [WIDTH+1:0] d1 = {2'b00, d1_pipe[s]};
+            wire [WIDTH+1:0] d2 = {1'b0, d1_pipe[s], 1'b0};
+            wire [WIDTH+1:0] d3 = d3_pipe[s];
+
+            reg [WIDTH-1:0] r;
+            reg [NUM_W-1:0] n;
+            reg [NUM_W-1:0] q;
+            reg [WIDTH+1:0] r_shift;
+            integer         k;
+            always @(*) begin
+                r = rem_pipe[s];
+                n = num_pipe[s];
+                q = quo_pipe[s];
+                for (k = 0; k < DIGITS_PER_STAGE; k = k + 1) begin
+                    if (s * DIGITS_PER_STAGE + k < DIGITS) begin
+                        r_shift = {r, n[NUM_W-1:NUM_W-2]};
+                        n = n << 2;
+                        if (r_shift >= d3) begin
+                            q = {q[NUM_W-3:0], 2'd3};
+                            r_shift = r_shift - d3;
+                        end else if (r_shift >= d2) begin
+                            q = {q[NUM_W-3:0], 2'd2};
+                            r_shift = r_shift - d2;
+                        end else if (r_shift >= d1) begin
+                            q = {q[NUM_W-3:0], 2'd1};
+                            r_shift = r_shift - d1;
+                        end else begin
+                            q = {q[NUM_W-3:0], 2'd0};
+                        end
+                        r = r_shift[WIDTH-1:0];  // < d
+                    end
+                end
+            end
+
+            always @(posedge clk or negedge rst_n) begin
+                if (!rst_n) begin
+                    rem_pipe[s+1]      <= '0;
+                    num_pipe[s+1]      <= '0;
+                    quo_pipe[s+1]      <= '0;
+                    d1_pipe[s+1]       <= '0;
+                    d3_pipe[s+1]       <= '0;
+                    neg_q_pipe[s+1]    <= 1'b0;
+                    neg_r_pipe[s+1]    <= 1'b0;
+                    div_zero_pipe[s+1] <= 1'b0;
+                    a_pipe[s+1]        <= '0;
+                end else begin
+                    rem_pipe[s+1]      <= r;
+                    num_pipe[s+1]      <= n;
+                    quo_pipe[s+1]      <= q;
+                    d1_pipe[s+1]       <= d1_pipe[s];
+                    d3_pipe[s+1]       <= d3_pipe[s];
+                    neg_q_pipe[s+1]    <= neg_q_pipe[s];
+                    neg_r_pipe[s+1]    <= neg_r_pipe[s];
+                    div_zero_pipe[s+1] <= div_zero_pipe[s];
+                    a_pipe[s+1]        <= a_pipe[s];
+                end
+            end
+        end
+    endgenerate
+
+    //----------------------------------------------------------------
+    // Final Stage: Signs and Special Cases
+    //----------------------------------------------------------------
+
+    wire [WIDTH-1:0] q_mag = quo_pipe[STAGES][WIDTH-1:0];
+    wire [WIDTH-1:0] r_mag = rem_pipe[STAGES];
+
+    reg [WIDTH-1:0] quotient_q, remainder_q;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            quotient_q  <= '0;
+            remainder_q <= '0;
+        end else if (div_zero_pipe[STAGES]) begin
+            quotient_q  <= {WIDTH{1'b1}};
+            remainder_q <= a_pipe[STAGES];
+        end else begin
+            quotient_q  <= neg_q_pipe[STAGES] ? -q_mag : q_mag;
+            remainder_q <= neg_r_pipe[STAGES] ? -r_mag : r_mag;
+        end
+    end
+
+    assign quotient  = quotient_q;
+    assign remainder = remainder_q;
+
+endmodule
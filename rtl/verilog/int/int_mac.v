@@ -0,0 +1,117 @@
+// rtl/verilog/int/int_mac.v
+//
+// Verilog RTL for a pipelined integer multiply-accumulate.
+//
+// Operation: result = c + a * b (sub = 0) or c - a * b (sub = 1), modulo
+// 2^ACC_WIDTH, on unsigned or two's complement operands (is_signed, per
+// operation; c is ACC_WIDTH bits in the same representation).
+//
+// The 2*WIDTH-bit product is built over MUL_STAGES pipeline stages; stage s
+// adds a * b[s*SLICE +: SLICE] (SLICE = ceil(WIDTH / MUL_STAGES), slices of b
+// taken as unsigned) at offset s*SLICE to the running partial product. For a
+// negative signed b the first stage starts from -(a << WIDTH), since b is
+// b_unsigned - 2^WIDTH. The last stage adds or subtracts the product,
+// sign- or zero-extended to ACC_WIDTH, to c:
+//   Latency MUL_STAGES + 1, one new operation per cycle.
+// Model: verif/lib/int_model.c.
+
+`include "common_inc.vh"
+
+module int_mac #(
+    parameter WIDTH      = 16,
+    parameter ACC_WIDTH  = 2 * WIDTH,
+    parameter MUL_STAGES = 2
+) (
+    input clk,
+    input rst_n,
+
+    input  [WIDTH-1:0]     a,
+    input  [WIDTH-1:0]     b,
+    input  [ACC_WIDTH-1:0] c,
+    input                  is_signed,
+    input                  sub,        // 1: c - a * b
+
+    output [ACC_WIDTH-1:0] result
+);
+    localparam PROD_W  = 2 * WIDTH;
+    localparam SLICE   = (WIDTH + MUL_STAGES - 1) / MUL_STAGES;
+    localparam B_W     = SLICE * MUL_STAGES;  // b padded to whole slices
+    localparam LATENCY = MUL_STAGES + 1;
+
+    `VERIF_DECLARE_PIPELINE(LATENCY)  // Verification support
+
+    //----------------------------------------------------------------
+    // Stages 1 .. MUL_STAGES: Partial Products
+    //----------------------------------------------------------------
+
+    wire [PROD_W-1:0] a_ext = {{WIDTH{is_signed && a[WIDTH-1]}}, a};
+    wire [PROD_W-1:0] p_init = (is_signed && b[WIDTH-1]) ? -(a_ext << WIDTH) : '0;
+
+    reg [PROD_W-1:0]    p_pipe     [0:MUL_STAGES];
+    reg [PROD_W-1:0]    a_pipe     [0:MUL_STAGES];
+    reg [B_W-1:0]       b_pipe     [0:MUL_STAGES];
+    reg [ACC_WIDTH-1:0] c_pipe     [0:MUL_STAGES];
+    reg                 signed_pipe[0:MUL_STAGES];
+    reg                 sub_pipe   [0:MUL_STAGES];
+
+    always @(*) begin
+        p_pipe[0]      = p_init;
+        a_pipe[0]      = a_ext;
+        b_pipe[0]      = {{(B_W-WIDTH){1'b0}}, b};
+        c_pipe[0]      = c;
+        signed_pipe[0] = is_signed;
+        sub_pipe[0]    = sub;
+    end
+
+    genvar s;
+    generate
+        for (s = 0; s < MUL_STAGES; s = s + 1) begin : stage
+            wire [SLICE-1:0]  b_slice = b_pipe[s][s*SLICE +: SLICE];
+            wire [PROD_W-1:0] pp      = (a_pipe[s] * {{(PROD_W-SLICE){1'b0}}, b_slice}) << (s * SLICE);
+
+            always @(posedge clk or negedge rst_n) begin
+                if (!rst_n) begin
+                    p_pipe[s+1]      <= '0;
+                    a_pipe[s+1]      <= '0;
+                    b_pipe[s+1]      <= '0;
+                    c_pipe[s+1]      <= '0;
+                    signed_pipe[s+1] <= 1'b0;
+                    sub_pipe[s+1]    <= 1'b0;
+                end else begin
+                    p_pipe[s+1]      <= p_pipe[s] + pp;
+                    a_pipe[s+1]      <= a_pipe[s];
+                    b_pipe[s+1]      <= b_pipe[s];
+                    c_pipe[s+1]      <= c_pipe[s];
+                    signed_pipe[s+1] <= signed_pipe[s];
+                    sub_pipe[s+1]    <= sub_pipe[s];
+                end
+            end
+        end
+    endgenerate
+
+    //----------------------------------------------------------------
+    // Final Stage: Accumulate
+    //----------------------------------------------------------------
+
+    wire [PROD_W-1:0] prod = p_pipe[MUL_STAGES];
+
+    wire [ACC_WIDTH-1:0] prod_acc;
+    generate
+        if (ACC_WIDTH > PROD_W) begin : extend
+            assign prod_acc = {{(ACC_WIDTH-PROD_W){signed_pipe[MUL_STAGES] && prod[PROD_W-1]}}, prod};
+        end else begin : truncate
+            assign prod_acc = prod[ACC_WIDTH-1:0];
+        end
+    endgenerate
+
+    reg [ACC_WIDTH-1:0] result_q;
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n)
+            result_q <= '0;
+        else
+            result_q <= sub_pipe[MUL_STAGES] ? c_pipe[MUL_STAGES] - prod_acc : c_pipe[MUL_STAGES] + prod_acc;
+    end
+
+    assign result = result_q;
+
+endmodule
@@ -0,0 +1,146 @@
+// rtl/verilog/int/int_shift.v
+//
+// Verilog RTL for a log-stage barrel shifter with rotate and arithmetic modes.
+//
+// Operation (op):
+//   INT_SHIFT_SLL - Logical shift left,  zero fill
+//   INT_SHIFT_SRL - Logical shift right, zero fill
+//   INT_SHIFT_SRA - Arithmetic shift right, sign fill
+//   INT_SHIFT_ROL - Rotate left
+//   INT_SHIFT_ROR - Rotate right
+//
+// $clog2(WIDTH) levels, level l shifts by 2^l when amount[l] is set. Only a
+// right shifter is built: left operations bit-reverse the operand in front of
+// the network and the result behind it (wiring only). The levels compose, so
+// for a WIDTH that is not a power of two an amount >= WIDTH still gives all
+// fill bits for shifts and rotates by amount mod WIDTH.
+//
+// LATENCY (0 .. $clog2(WIDTH)) pipeline registers are spread evenly over the
+// levels, the last one behind the final level; LATENCY = 0 is combinational.
+// One new operation per cycle. Model: verif/lib/int_model.c.
+
+`include "common_inc.vh"
+
+module int_shift #(
+    parameter WIDTH   = 32,              // At least 2
+    parameter LATENCY = 1,
+    parameter LEVELS  = $clog2(WIDTH)    // Shift amount bits
+) (
+    input clk,
+    input rst_n,
+
+    input  [WIDTH-1:0]  a,
+    input  [LEVELS-1:0] amount,
+    input  [2:0]        op,
+
+    output [WIDTH-1:0]  result
+);
+    localparam [2:0] INT_SHIFT_SLL = 3'd0;
+    localparam [2:0] INT_SHIFT_SRL = 3'd1;
+    localparam [2:0] INT_SHIFT_SRA = 3'd2;
+    localparam [2:0] INT_SHIFT_ROL = 3'd3;
+    localparam [2:0] INT_SHIFT_ROR = 3'd4;
+
+    `VERIF_DECLARE_PIPELINE(LATENCY)  // Verification support
+
+    //----------------------------------------------------------------
+    // Operand Conditioning
+    //----------------------------------------------------------------
+
+    wire left   = (op == INT_SHIFT_SLL) || (op == INT_SHIFT_ROL);
+    wire rotate = (op == INT_SHIFT_ROL) || (op == INT_SHIFT_ROR);
+    wire fill   = (op == INT_SHIFT_SRA) && a[WIDTH-1];
+
+    wire [WIDTH-1:0] a_rev;
+    genvar i;
+    generate
+        for (i = 0; i < WIDTH; i = i + 1) begin : rev_in
+            assign a_rev[i] = a[WIDTH-1-i];
+        end
+    endgenerate
+
+    wire [WIDTH-1:0] x0 = left ? a_rev : a;
+
+    //----------------------------------------------------------------
+    // Shift Levels
+    //----------------------------------------------------------------
+
+    genvar l;
+    generate
+        for (l = 0; l < LEVELS; l = l + 1) begin : level
+            localparam integer K = 1 << l;
+
+            // Level input: operand or previous level
+            wire [WIDTH-1:0]  x;
+            wire [LEVELS-1:0] amt;
+            wire              rot, fil, lft;
+            if (l == 0) begin : first
+                assign x   = x0;
+                assign amt = amount;
+                assign rot = rotate;
+                assign fil = fill;
+                assign lft = left;
+            end else begin : chain
+                assign x   = level[l-1].y;
+                assign amt = level[l-1].y_amt;
+                assign rot = level[l-1].y_rot;
+                assign fil = level[l-1].y_fil;
+                assign lft = level[l-1].y_lft;
+            end
+
+            wire [WIDTH-1:0] shifted = rot ? {x[K-1:0], x[WIDTH-1:K]} : {{K{fil}}, x[WIDTH-1:K]};
+            wire [WIDTH-1:0] next    = amt[l] ? shifted : x;
+
+            // Level output, registered where a pipeline boundary falls
+            wire [WIDTH-1:0]  y;
+            wire [LEVELS-1:0] y_amt;
+            wire              y_rot, y_fil, y_lft;
+            if (((l + 1) * LATENCY) / LEVELS != (l * LATENCY) / LEVELS) begin : pipe
+                reg [WIDTH-1:0]  y_q;
+                reg [LEVELS-1:0] amt_q;
+                reg              rot_q, fil_q, lft_q;
+                always @(posedge clk or negedge rst_n) begin
+                    if (!rst_n) begin
+                        y_q   <= '0;
+                        amt_q <= '0;
+                        rot_q <= 1'b0;
+                        fil_q <= 1'b0;
+                        lft_q <= 1'b0;
+                    end else begin
+                        y_q   <= next;
+                        amt_q <= amt;
+                        rot_q <= rot;
+                        fil_q <= fil;
+                        lft_q <= lft;
+                    end
+                end
+                assign y     = y_q;
+                assign y_amt = amt_q;
+                assign y_rot = rot_q;
+                assign y_fil = fil_q;
+                assign y_lft = lft_q;
+            end else begin : comb
+                assign y     = next;
+                assign y_amt = amt;
+                assign y_rot = rot;
+                assign y_fil = fil;
+                assign y_lft = lft;
+            end
+        end
+    endgenerate
+
+    //----------------------------------------------------------------
+    // Result: Undo the Reversal of Left Operations
+    //----------------------------------------------------------------
+
+    wire [WIDTH-1:0] y_last = level[LEVELS-1].y;
+    wire [WIDTH-1:0] y_rev;
+    generate
+        for (i = 0; i < WIDTH; i = i + 1) begin : rev_out
+            assign y_rev[i] = y_last[WIDTH-1-i];
+        end
+    endgenerate
+
+    assign result = level[LEVELS-1].y_lft ? y_rev : y_last;
+
+endmodule
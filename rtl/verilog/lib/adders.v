@@ -3,13 +3,15 @@
 // fas_vec_cla #(parameter WIDTH = 8) (
 // fas_vec_carry_skip #(parameter WIDTH=8, parameter BLOCK_SIZE=4) (
 // fas_vec_carry_select #(parameter WIDTH=8, parameter BLOCK_SIZE=4) (
-// fas_vec_prefix #(parameter WIDTH=8) (
+// fas_vec_prefix #(parameter WIDTH=8, parameter TOPOLOGY=`ADDER_KOGGE_STONE) (
 // fa_vec_carry_save #(parameter WIDTH=8) (
 //     input wire [WIDTH-1:0] a, b, c,
 //     output wire [WIDTH-1:0] z,
 //     input  wire add_nsub,       // 0: add, 1: subtract // TODO: (now) Implement subtraction
 //     output wire [WIDTH-1:0] carry)
 
+`include "adders.vh"  // \`ADDER_KOGGE_STONE, etc.
+
 // Basic 1-bit full adder
 module fa (
     input  wire a, b, cin,
@@ -168,20 +170,85 @@ module fas_vec_carry_select #(parameter WIDTH=8, parameter BLOCK_SIZE=4) (
     assign cout = cin_arr[WIDTH] ^ add_nsub;
 endmodule
 
-// Prefix Adder (Kogge-Stone simplified example)
-module fas_vec_prefix #(parameter WIDTH=8) (
+// Parallel-Prefix Adder generator
+// Builds a Kogge-Stone, Brent-Kung, Han-Carlson or Sklansky carry network at
+// any WIDTH, selected by TOPOLOGY (see adders.vh). TOPOLOGY = `ADDER_BEHAVIORAL
+// falls back to a behavioral '+'.
+// The carry in is folded into the bit 0 generate, so every prefix output
+// G[i] is directly the carry into bit i+1.
+// scripts/prefix_adder_report.py mirrors prefix_partner() for depth and
+// node-count reports and equivalence checks.
+module fas_vec_prefix #(parameter WIDTH=8, parameter TOPOLOGY=`ADDER_KOGGE_STONE) (
     input wire [WIDTH-1:0] a, b,
     input wire cin,
     input  wire add_nsub,       // 0: add, 1: subtract
     output wire [WIDTH-1:0] z,
     output wire cout
 );
+    // Number of prefix levels (logic depth in prefix cells)
+    function integer prefix_levels;
+        input integer topology, width;
+        integer lg;
+        begin
+            lg = (width > 1) ? $clog2(width) : 0;
+            if (lg == 0)
+                prefix_levels = 0;
+            else if (topology == `ADDER_BRENT_KUNG)
+                prefix_levels = 2 * lg - 1;
+            else if (topology == `ADDER_HAN_CARLSON)
+                prefix_levels = lg + 1;
+            else
+                prefix_levels = lg;
+        end
+    endfunction
+
+    // Lower-significance partner combined into bit i at a level, -1: pass through
+    function integer prefix_partner;
+        input integer topology, width, level, i;
+        integer lg, span;
+        begin
+            lg = (width > 1) ? $clog2(width) : 0;
+            prefix_partner = -1;
+            case (topology)
+                `ADDER_KOGGE_STONE: begin
+                    span = 1 << level;
+                    if (i >= span) prefix_partner = i - span;
+                end
+                `ADDER_SKLANSKY: begin
+                    if ((i >> level) & 1) prefix_partner = ((i >> level) << level) - 1;
+                end
+                `ADDER_BRENT_KUNG: begin
+                    if (level < lg) begin // Up-sweep: build power-of-two blocks
+                        span = 1 << level;
+                        if ((i + 1) % (2 * span) == 0) prefix_partner = i - span;
+                    end else begin // Down-sweep: fill in the remaining positions
+                        span = 1 << (2 * lg - 2 - level);
+                        if (((i + 1) % (2 * span) == span) && (i + 1 > 2 * span)) prefix_partner = i - span;
+                    end
+                end
+                `ADDER_HAN_CARLSON: begin
+                    if (level == 0) begin // Pair up: odd bits take their even neighbour
+                        if (i % 2 == 1) prefix_partner = i - 1;
+                    end else if (level < lg) begin // Kogge-Stone among the odd bits
+                        span = 1 << level;
+                        if ((i % 2 == 1) && (i - span >= 1)) prefix_partner = i - span;
+                    end else begin // Fix up even bits
+                        if ((i % 2 == 0) && (i >= 2)) prefix_partner = i - 1;
+                    end
+                end
+                default: prefix_partner = -1;
+            endcase
+        end
+    endfunction
+
+    localparam LEVELS = (TOPOLOGY == `ADDER_BEHAVIORAL) ? 0 : prefix_levels(TOPOLOGY, WIDTH);
+
     wire [WIDTH-1:0] b_eff;
     wire [WIDTH-1:0] p, g;
     wire [WIDTH:0] c;
     assign c[0] = cin ^ add_nsub;
 
-    genvar i;
+    genvar i, l;
     generate
         for(i=0; i<WIDTH; i=i+1) begin : prefix_b_eff
             assign b_eff[i] = b[i] ^ add_nsub;
@@ -194,12 +261,44 @@ module fas_vec_prefix #(parameter WIDTH=8) (
         end
     endgenerate
 
-    // Prefix network (Kogge-Stone simplified, log2)
-    // Level-wise propagate and generate signals omitted for brevity
-    // Here, doing simple carry ripple as placeholder
     generate
-        for(i=0; i<WIDTH; i=i+1) begin : carry_calc
-            assign c[i+1] = g[i] | (p[i] & c[i]);
+        if (TOPOLOGY == `ADDER_BEHAVIORAL) begin : behavioral
+            wire [WIDTH:0] sum = {1'b0, a} + {1'b0, b_eff} + c[0];
+            // Recover the internal carries so the shared sum logic below applies
+            for(i=1; i<WIDTH; i=i+1) begin : carry
+                assign c[i] = sum[i] ^ p[i];
+            end
+            assign c[WIDTH] = sum[WIDTH];
+        end else begin : network
+            // Group generate / propagate per level, flattened: [level*WIDTH + bit]
+            wire [(LEVELS+1)*WIDTH-1:0] gl, pl;
+
+            // Level 0: bit generate / propagate, carry in folded into bit 0
+            for(i=0; i<WIDTH; i=i+1) begin : level0
+                if (i == 0) begin : bit0
+                    assign gl[0] = g[0] | (p[0] & c[0]);
+                end else begin : bitn
+                    assign gl[i] = g[i];
+                end
+                assign pl[i] = p[i];
+            end
+
+            // Prefix levels: black cell where a partner exists, wire otherwise
+            for(l=0; l<LEVELS; l=l+1) begin : level
+                for(i=0; i<WIDTH; i=i+1) begin : cell
+                    localparam integer J = prefix_partner(TOPOLOGY, WIDTH, l, i);
+                    if (J >= 0) begin : black
+                        assign gl[(l+1)*WIDTH+i] = gl[l*WIDTH+i] | (pl[l*WIDTH+i] & gl[l*WIDTH+J]);
+                        assign pl[(l+1)*WIDTH+i] = pl[l*WIDTH+i] & pl[l*WIDTH+J];
+                    end else begin : buffer
+                        assign gl[(l+1)*WIDTH+i] = gl[l*WIDTH+i];
+                        assign pl[(l+1)*WIDTH+i] = pl[l*WIDTH+i];
+                    end
+                end
+            end
+
+            // Group generate over bits [i:0] is the carry into bit i+1
+            assign c[WIDTH:1] = gl[LEVELS*WIDTH +: WIDTH];
         end
     endgenerate
 
@@ -0,0 +1,14 @@
+// rtl/verilog/lib/adders.vh
+// Adder topology encodings for the TOPOLOGY parameter of fas_vec_prefix and
+// the ADDER_TOPOLOGY parameter of the FP units.
+
+`ifndef _ADDERS_VH
+`define _ADDERS_VH
+
+`define ADDER_BEHAVIORAL  0 // Behavioral '+' / '-', architecture left to synthesis
+`define ADDER_KOGGE_STONE 1 // log2(N) levels, N*log2(N)-N+1 cells, fan-out 2
+`define ADDER_BRENT_KUNG  2 // 2*log2(N)-1 levels, ~2N cells, fan-out 2
+`define ADDER_HAN_CARLSON 3 // log2(N)+1 levels, Kogge-Stone on odd bits
+`define ADDER_SKLANSKY    4 // log2(N) levels, N/2*log2(N) cells, high fan-out
+
+`endif // _ADDERS_VH
@@ -0,0 +1,40 @@
+// rtl/verilog/lib/compound_inc.v
+// Compound incrementer: produces value and value+1 in parallel.
+//
+// Used by rounders to take the carry-propagate increment off the critical
+// path: the +1 result is formed from a prefix-AND of the input (the
+// trailing-ones mask) at the same time as the rounding decision is
+// computed, and the decision then only drives a final select mux.
+//
+// The carry output is the all-ones detection of the input, so a mantissa
+// overflow is known without waiting for the incremented sum.
+//
+// Parameters:
+//   WIDTH - The bit width of value_in and of the outputs.
+//
+
+module compound_inc #(
+    parameter WIDTH = 24
+) (
+    input  wire [WIDTH-1:0] value_in,
+    output wire [WIDTH-1:0] value_p1,  // value_in + 1 (modulo 2^WIDTH)
+    output wire             carry_p1   // Carry out of value_in + 1
+);
+
+    // Prefix AND of the input: ones_below[i] = &value_in[i-1:0].
+    // Bit i of value_in+1 toggles exactly when all lower bits are ones.
+    // The loop is a plain AND-prefix, synthesis tools restructure it into a
+    // log-depth tree as needed.
+    reg [WIDTH:0] ones_below;
+    integer i;
+    always @(*) begin
+        ones_below[0] = 1'b1;
+        for (i = 0; i < WIDTH; i = i + 1) begin
+            ones_below[i+1] = ones_below[i] & value_in[i];
+        end
+    end
+
+    assign value_p1 = value_in ^ ones_below[WIDTH-1:0];
+    assign carry_p1 = ones_below[WIDTH];
+
+endmodule
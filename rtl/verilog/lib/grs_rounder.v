@@ -46,13 +46,21 @@ module grs_rounder #(
     wire [OUTPUT_WIDTH-1:0] base_mantissa;
     assign base_mantissa = value_in[INPUT_WIDTH-1 : SHIFT_AMOUNT];
 
-    // --- 3. Final Output Calculation with Overflow Detection ---
-    // Use a vector one bit wider than the output to capture the carry-out.
-    wire [OUTPUT_WIDTH:0] sum;
-    assign sum = {1'b0, base_mantissa} + increment;
+    // --- 3. Compound Increment with Overflow Detection ---
+    // base+1 and the all-ones carry are formed in parallel with the rounding
+    // decision, so 'increment' only drives the final select instead of a
+    // carry-propagate adder. A set carry means the mantissa wrapped to zero.
+    wire [OUTPUT_WIDTH-1:0] base_plus_one;
+    wire                    base_all_ones;
+    compound_inc #(
+        .WIDTH(OUTPUT_WIDTH)
+    ) u_compound_inc (
+        .value_in(base_mantissa),
+        .value_p1(base_plus_one),
+        .carry_p1(base_all_ones)
+    );
 
-    // Assign the sum to the outputs. The MSB is the overflow.
-    assign overflow_out = sum[OUTPUT_WIDTH];
-    assign value_out    = sum[OUTPUT_WIDTH-1:0];
+    assign overflow_out = increment & base_all_ones;
+    assign value_out    = increment ? base_plus_one : base_mantissa;
 
 endmodule
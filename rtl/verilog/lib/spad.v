@@ -0,0 +1,159 @@
+/*
+ * Banked Scratchpad
+ * DEPTH words of DATA_WIDTH bits in NUM_BANKS single-port-per-direction banks
+ * (one read and one write per bank per cycle), low-order interleaved:
+ * bank = addr % NUM_BANKS, row = addr / NUM_BANKS.
+ *
+ * Read and write ports have LANES lanes each. Requests are served in lane
+ * order: a lane is granted if all lanes below it were granted and its bank is
+ * not used by one of them, so the granted lanes always form a prefix. The
+ * requester retries the rest in the next cycle. A lane that stops the prefix
+ * on a bank already in use is a bank conflict (rd_conflict / wr_conflict).
+ *
+ * Reads have one cycle of latency: rd_data / rd_data_valid of a lane belong
+ * to the request granted on that lane in the previous cycle.
+ * NUM_BANKS and DEPTH must be powers of two.
+ */
+module spad #(
+    parameter DATA_WIDTH = 16,
+    parameter DEPTH = 256,
+    parameter NUM_BANKS = 4,
+    parameter LANES = NUM_BANKS,
+    parameter ADDR_WIDTH = $clog2(DEPTH)
+) (
+    input  wire                        clk,
+    input  wire                        rst_n,
+    // Write port
+    input  wire [LANES-1:0]            wr_req,
+    input  wire [LANES*ADDR_WIDTH-1:0] wr_addr,
+    input  wire [LANES*DATA_WIDTH-1:0] wr_data,
+    output reg  [LANES-1:0]            wr_grant,
+    output reg                         wr_conflict,
+    // Read port
+    input  wire [LANES-1:0]            rd_req,
+    input  wire [LANES*ADDR_WIDTH-1:0] rd_addr,
+    output reg  [LANES-1:0]            rd_grant,
+    output reg                         rd_conflict,
+    output wire [LANES*DATA_WIDTH-1:0] rd_data,
+    output reg  [LANES-1:0]            rd_data_valid
+);
+
+    localparam BANK_BITS = (NUM_BANKS > 1) ? $clog2(NUM_BANKS) : 1;
+    localparam BANK_DEPTH = DEPTH / NUM_BANKS;
+    localparam ROW_BITS = (BANK_DEPTH > 1) ? $clog2(BANK_DEPTH) : 1;
+
+    function [BANK_BITS-1:0] bank_of(input [ADDR_WIDTH-1:0] addr);
+        bank_of = (NUM_BANKS > 1) ? addr % NUM_BANKS : 0;
+    endfunction
+
+    function [ROW_BITS-1:0] row_of(input [ADDR_WIDTH-1:0] addr);
+        row_of = addr / NUM_BANKS;
+    endfunction
+
+    //-------------------------------------------------------------------------
+    // In-order arbitration
+    //-------------------------------------------------------------------------
+    reg [NUM_BANKS-1:0] wr_used, rd_used;
+    reg wr_stop, rd_stop;
+    reg [LANES*BANK_BITS-1:0] wr_lane_bank, rd_lane_bank;  // Bank of each lane
+    integer wn, rn;
+
+    always @(*) begin
+        wr_used = {NUM_BANKS{1'b0}};
+        wr_stop = 1'b0;
+        wr_conflict = 1'b0;
+        for (wn = 0; wn < LANES; wn = wn + 1) begin
+            wr_lane_bank[wn*BANK_BITS +: BANK_BITS] = bank_of(wr_addr[wn*ADDR_WIDTH +: ADDR_WIDTH]);
+            wr_grant[wn] = 1'b0;
+            if (!wr_req[wn]) begin
+                wr_stop = 1'b1;
+            end else if (!wr_stop) begin
+                if (wr_used[wr_lane_bank[wn*BANK_BITS +: BANK_BITS]]) begin
+                    wr_conflict = 1'b1;
+                    wr_stop = 1'b1;
+                end else begin
+                    wr_grant[wn] = 1'b1;
+                    wr_used[wr_lane_bank[wn*BANK_BITS +: BANK_BITS]] = 1'b1;
+                end
+            end
+        end
+    end
+
+    always @(*) begin
+        rd_used = {NUM_BANKS{1'b0}};
+        rd_stop = 1'b0;
+        rd_conflict = 1'b0;
+        for (rn = 0; rn < LANES; rn = rn + 1) begin
+            rd_lane_bank[rn*BANK_BITS +: BANK_BITS] = bank_of(rd_addr[rn*ADDR_WIDTH +: ADDR_WIDTH]);
+            rd_grant[rn] = 1'b0;
+            if (!rd_req[rn]) begin
+                rd_stop = 1'b1;
+            end else if (!rd_stop) begin
+                if (rd_used[rd_lane_bank[rn*BANK_BITS +: BANK_BITS]]) begin
+                    rd_conflict = 1'b1;
+                    rd_stop = 1'b1;
+                end else begin
+                    rd_grant[rn] = 1'b1;
+                    rd_used[rd_lane_bank[rn*BANK_BITS +: BANK_BITS]] = 1'b1;
+                end
+            end
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Banks
+    //-------------------------------------------------------------------------
+    wire [DATA_WIDTH-1:0] bank_rd_data [NUM_BANKS-1:0];
+    reg  [LANES*BANK_BITS-1:0] rd_lane_bank_q;
+
+    genvar b, l;
+    generate
+        for (b = 0; b < NUM_BANKS; b = b + 1) begin : bank
+            reg [DATA_WIDTH-1:0] mem [BANK_DEPTH-1:0];
+            reg [DATA_WIDTH-1:0] rd_q;
+            reg                  we, re;
+            reg [ROW_BITS-1:0]   wr_row, rd_row;
+            reg [DATA_WIDTH-1:0] wr_word;
+            integer m;
+
+            // Lane routed to this bank (at most one of each kind is granted)
+            always @(*) begin
+                we = 1'b0; wr_row = 0; wr_word = 0;
+                re = 1'b0; rd_row = 0;
+                for (m = 0; m < LANES; m = m + 1) begin
+                    if (wr_grant[m] && wr_lane_bank[m*BANK_BITS +: BANK_BITS] == b) begin
+                        we = 1'b1;
+                        wr_row = row_of(wr_addr[m*ADDR_WIDTH +: ADDR_WIDTH]);
+                        wr_word = wr_data[m*DATA_WIDTH +: DATA_WIDTH];
+                    end
+                    if (rd_grant[m] && rd_lane_bank[m*BANK_BITS +: BANK_BITS] == b) begin
+                        re = 1'b1;
+                        rd_row = row_of(rd_addr[m*ADDR_WIDTH +: ADDR_WIDTH]);
+                    end
+                end
+            end
+
+            always @(posedge clk) begin
+                if (we) mem[wr_row] <= wr_word;
+                if (re) rd_q <= mem[rd_row];
+            end
+
+            assign bank_rd_data[b] = rd_q;
+        end
+
+        for (l = 0; l < LANES; l = l + 1) begin : lane
+            assign rd_data[l*DATA_WIDTH +: DATA_WIDTH] = bank_rd_data[rd_lane_bank_q[l*BANK_BITS +: BANK_BITS]];
+        end
+    endgenerate
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            rd_data_valid <= {LANES{1'b0}};
+            rd_lane_bank_q <= {(LANES*BANK_BITS){1'b0}};
+        end else begin
+            rd_data_valid <= rd_grant;
+            rd_lane_bank_q <= rd_lane_bank;
+        end
+    end
+
+endmodule
@@ -1,12 +1,26 @@
 /*
  * Processing Element (PE2), with weight double-buffering
  * Performs MAC operation: cout = a * b + cin
+ *
+ * MUL_STAGED = 0: the product is computed combinationally and delayed by
+ * MUL_LATENCY registers (relies on retiming to split the multiplier).
+ * MUL_STAGED = 1 (MUL_LATENCY > 0): the product is built over the
+ * MUL_LATENCY registers, stage s adding a * b[s*SLICE +: SLICE] at offset
+ * s*SLICE (SLICE = ceil(WIDTH / MUL_LATENCY)) to the running partial product.
+ * Both give the same c_out in every cycle (see
+ * verif/tests/systolic/pe2_mul_equiv.sv).
+ *
+ * MUL_SIGNED = 1: a and b are two's complement (block floating point
+ * mantissas, see systolic_bfp.v) and the product is sign-extended to
+ * ACC_WIDTH before accumulation.
  */
 module pe2 #(
     parameter WIDTH = 4,
     parameter ACC_WIDTH = 9,
     parameter MUL_LATENCY = 0,
-    parameter ADD_LATENCY = 1
+    parameter ADD_LATENCY = 1,
+    parameter MUL_STAGED = 0,
+    parameter MUL_SIGNED = 0
 ) (
     input  wire       clk,
     input  wire       rst_n,
@@ -54,12 +68,65 @@ module pe2 #(
     // Multiplier Pipeline
     wire [2*WIDTH-1:0] mul_result;
     wire [2*WIDTH-1:0] mul_result_delayed;
-    
-    assign mul_result = a_in * b_active;
 
     generate
+        if (MUL_SIGNED) begin : mul_signed
+            assign mul_result = $signed(a_in) * $signed(b_active);
+        end else begin : mul_unsigned
+            assign mul_result = a_in * b_active;
+        end
+
         if (MUL_LATENCY == 0) begin : no_mul_lat
             assign mul_result_delayed = mul_result;
+        end else if (MUL_STAGED) begin : mul_staged
+            localparam SLICE = (WIDTH + MUL_LATENCY - 1) / MUL_LATENCY;
+            localparam B_W = SLICE * MUL_LATENCY; // b padded to whole slices
+
+            // Stage s holds the partial product of slices 0..s and the operands
+            reg [2*WIDTH-1:0] psum_pipe [MUL_LATENCY-1:0];
+            reg [WIDTH-1:0]   a_pipe    [MUL_LATENCY-1:0];
+            reg [B_W-1:0]     b_pipe    [MUL_LATENCY-1:0];
+
+            wire [B_W-1:0] b_ext = {{(B_W-WIDTH){1'b0}}, b_active};
+
+            // Signed: the slices take b as unsigned, so a * b = a * b_u - (a << WIDTH)
+            // when b is negative; the correction seeds the first stage
+            wire [2*WIDTH-1:0] a_in_ext = {{WIDTH{MUL_SIGNED[0] & a_in[WIDTH-1]}}, a_in};
+            wire [2*WIDTH-1:0] psum_init = (MUL_SIGNED && b_active[WIDTH-1]) ? -(a_in_ext << WIDTH)
+                                                                             : {(2*WIDTH){1'b0}};
+
+            genvar s;
+            for (s = 0; s < MUL_LATENCY; s = s + 1) begin : stage
+                wire [WIDTH-1:0]   a_s;
+                wire [B_W-1:0]     b_s;
+                wire [2*WIDTH-1:0] psum_s;
+                if (s == 0) begin : first
+                    assign a_s    = a_in;
+                    assign b_s    = b_ext;
+                    assign psum_s = psum_init;
+                end else begin : chain
+                    assign a_s    = a_pipe[s-1];
+                    assign b_s    = b_pipe[s-1];
+                    assign psum_s = psum_pipe[s-1];
+                end
+
+                wire [SLICE-1:0]   slice  = b_s[s*SLICE +: SLICE];
+                wire [2*WIDTH-1:0] a_ext  = {{WIDTH{MUL_SIGNED[0] & a_s[WIDTH-1]}}, a_s};
+                wire [2*WIDTH-1:0] pp     = (a_ext * {{(2*WIDTH-SLICE){1'b0}}, slice}) << (s*SLICE);
+
+                always @(posedge clk or negedge rst_n) begin
+                    if (!rst_n) begin
+                        psum_pipe[s] <= {(2*WIDTH){1'b0}};
+                        a_pipe[s]    <= {WIDTH{1'b0}};
+                        b_pipe[s]    <= {B_W{1'b0}};
+                    end else begin
+                        psum_pipe[s] <= psum_s + pp;
+                        a_pipe[s]    <= a_s;
+                        b_pipe[s]    <= b_s;
+                    end
+                end
+            end
+            assign mul_result_delayed = psum_pipe[MUL_LATENCY-1];
         end else begin : mul_lat
             reg [2*WIDTH-1:0] mul_pipe [MUL_LATENCY-1:0];
             integer m;
@@ -77,7 +144,18 @@ module pe2 #(
 
     // Adder Pipeline
     wire [ACC_WIDTH-1:0] add_result;
-    assign add_result = mul_result_delayed + c_in;
+    wire [ACC_WIDTH-1:0] mul_result_ext;
+
+    generate
+        if (ACC_WIDTH > 2*WIDTH) begin : mul_ext
+            assign mul_result_ext = {{(ACC_WIDTH-2*WIDTH){MUL_SIGNED[0] & mul_result_delayed[2*WIDTH-1]}},
+                                     mul_result_delayed};
+        end else begin : mul_trunc
+            assign mul_result_ext = mul_result_delayed[ACC_WIDTH-1:0];
+        end
+    endgenerate
+
+    assign add_result = mul_result_ext + c_in;
 
     generate
         if (ADD_LATENCY == 0) begin : no_add_lat
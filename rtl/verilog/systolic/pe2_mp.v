@@ -0,0 +1,192 @@
+/*
+ * Multi-Precision Processing Element (PE2_MP), with weight double-buffering
+ * Same interface and timing as pe2, but the WIDTH-bit operands can be split
+ * at runtime into packed sub-word lanes:
+ *   prec = 0: 1 lane  of WIDTH   bits (cout = a * b + cin, as pe2)
+ *   prec = 1: 2 lanes of WIDTH/2 bits
+ *   prec = 2: 4 lanes of WIDTH/4 bits (3 is treated as 2)
+ * With lane_sum set, the lane products are summed into one ACC_WIDTH
+ * accumulator (packed dot product, cout = sum(a[l] * b[l]) + cin). Otherwise
+ * the lanes are independent MACs on ACC_WIDTH/lanes-bit fields of cin/cout.
+ *
+ * The multiplier is built from the 16 (WIDTH/4 x WIDTH/4) partial products of
+ * the operand quarters. A lane uses the partial products of its own quarters
+ * only; at their natural shift they land in separate fields of the product:
+ * lane l of n at bits [l*2*WIDTH/n +: 2*WIDTH/n].
+ *
+ * The mode is latched together with the active weight (b_update), so every
+ * job carries its own precision through the staggered update wavefront.
+ * WIDTH and ACC_WIDTH must be multiples of 4.
+ */
+module pe2_mp #(
+    parameter WIDTH = 16,
+    parameter ACC_WIDTH = 40,
+    parameter MUL_LATENCY = 0,
+    parameter ADD_LATENCY = 1
+) (
+    input  wire       clk,
+    input  wire       rst_n,
+    input  wire       b_load,   // Enable shifting in new weights to shadow register
+    input  wire       b_update, // Update active weight (and mode) from shadow register
+    input  wire [1:0] prec,     // Precision mode of the next job, sampled on b_update
+    input  wire       lane_sum, // Sum the lane products of the next job, sampled on b_update
+    input  wire [WIDTH-1:0] a_in,     // Activation input (from left)
+    input  wire [WIDTH-1:0] b_in,     // Weight input (from top)
+    input  wire [ACC_WIDTH-1:0] c_in,     // Partial sum input (from top)
+    output reg  [WIDTH-1:0] a_out,    // Activation output (to right)
+    output reg  [WIDTH-1:0] b_out,    // Weight output (to bottom)
+    output wire [ACC_WIDTH-1:0] c_out,    // Partial sum output (to bottom)
+    output reg        b_update_out  // Forwarded update signal (to right)
+);
+
+    localparam ALU_LATENCY = MUL_LATENCY + ADD_LATENCY;
+    localparam Q = WIDTH / 4;       // Quarter (smallest lane) width
+    localparam AQ = ACC_WIDTH / 4;  // Accumulator segment width
+
+    reg [WIDTH-1:0] b_active;
+    reg [1:0] prec_active;
+    reg       lane_sum_active;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            a_out    <= {WIDTH{1'b0}};
+            b_out    <= {WIDTH{1'b0}};
+            b_active <= {WIDTH{1'b0}};
+            prec_active <= 2'd0;
+            lane_sum_active <= 1'b0;
+            b_update_out <= 1'b0;
+        end else begin
+            // Forward activation to the right
+            a_out <= a_in;
+
+            // Weight Loading Logic (Double Buffering)
+            if (b_load) begin
+                b_out <= b_in;
+            end
+
+            // Weight and Mode Update Logic
+            if (b_update) begin
+                b_active <= b_out;
+                prec_active <= (prec == 2'd3) ? 2'd2 : prec;
+                lane_sum_active <= lane_sum;
+            end
+
+            // Forward b_update to the right
+            b_update_out <= b_update;
+        end
+    end
+
+
+    // Split Multiplier
+    // Partial product (i, j) = a quarter i * b quarter j, used if both
+    // quarters belong to the same lane
+    wire [2*WIDTH-1:0] pp_term [0:15];
+
+    genvar i, j;
+    generate
+        for (i = 0; i < 4; i = i + 1) begin : pp_row
+            for (j = 0; j < 4; j = j + 1) begin : pp_col
+                wire [2*Q-1:0] pp = a_in[i*Q +: Q] * b_active[j*Q +: Q];
+                wire pp_en = (prec_active == 2'd0) ||
+                             (prec_active == 2'd1 && (i / 2) == (j / 2)) ||
+                             (i == j);
+                wire [2*WIDTH-1:0] pp_ext = pp;
+                assign pp_term[i*4 + j] = pp_en ? (pp_ext << (Q*(i + j))) : {(2*WIDTH){1'b0}};
+            end
+        end
+    endgenerate
+
+    reg [2*WIDTH-1:0] mul_result;
+    integer t;
+    always @(*) begin
+        mul_result = {(2*WIDTH){1'b0}};
+        for (t = 0; t < 16; t = t + 1) mul_result = mul_result + pp_term[t];
+    end
+
+    // Multiplier Pipeline (the mode travels with the product)
+    wire [2*WIDTH-1:0] mul_result_delayed;
+    wire [1:0] prec_delayed;
+    wire       lane_sum_delayed;
+
+    generate
+        if (MUL_LATENCY == 0) begin : no_mul_lat
+            assign mul_result_delayed = mul_result;
+            assign prec_delayed = prec_active;
+            assign lane_sum_delayed = lane_sum_active;
+        end else begin : mul_lat
+            reg [2*WIDTH+2:0] mul_pipe [MUL_LATENCY-1:0];
+            integer m;
+            always @(posedge clk or negedge rst_n) begin
+                if (!rst_n) begin
+                    for (m=0; m<MUL_LATENCY; m=m+1) mul_pipe[m] <= {(2*WIDTH+3){1'b0}};
+                end else begin
+                    mul_pipe[0] <= {lane_sum_active, prec_active, mul_result};
+                    for (m=1; m<MUL_LATENCY; m=m+1) mul_pipe[m] <= mul_pipe[m-1];
+                end
+            end
+            assign {lane_sum_delayed, prec_delayed, mul_result_delayed} = mul_pipe[MUL_LATENCY-1];
+        end
+    endgenerate
+
+    // Addend: lane products summed, or placed into their accumulator fields
+    wire [WIDTH-1:0]   p2 [0:1];  // 2-lane products
+    wire [WIDTH/2-1:0] p4 [0:3];  // 4-lane products
+    wire [2*AQ-1:0]    p2_field [0:1];
+    wire [AQ-1:0]      p4_field [0:3];
+
+    generate
+        for (i = 0; i < 2; i = i + 1) begin : lane2
+            assign p2[i] = mul_result_delayed[i*WIDTH +: WIDTH];
+            assign p2_field[i] = p2[i];
+        end
+        for (i = 0; i < 4; i = i + 1) begin : lane4
+            assign p4[i] = mul_result_delayed[i*(WIDTH/2) +: WIDTH/2];
+            assign p4_field[i] = p4[i];
+        end
+    endgenerate
+
+    reg [ACC_WIDTH-1:0] addend;
+    always @(*) begin
+        case (prec_delayed)
+            2'd0:    addend = mul_result_delayed;
+            2'd1:    addend = lane_sum_delayed ? p2[0] + p2[1] : {p2_field[1], p2_field[0]};
+            default: addend = lane_sum_delayed ? p4[0] + p4[1] + p4[2] + p4[3]
+                                               : {p4_field[3], p4_field[2], p4_field[1], p4_field[0]};
+        endcase
+    end
+
+    // Segmented Adder: carries between the AQ-bit segments are killed at the
+    // lane boundaries of independent lanes
+    wire independent = lane_sum_delayed == 1'b0 && prec_delayed != 2'd0;
+    wire [4:0] seg_carry;
+    wire [ACC_WIDTH-1:0] add_result;
+
+    assign seg_carry[0] = 1'b0;
+    generate
+        for (i = 0; i < 4; i = i + 1) begin : seg
+            wire kill = independent && (i == 2 || (i != 0 && prec_delayed != 2'd1));
+            wire [AQ:0] seg_sum = c_in[i*AQ +: AQ] + addend[i*AQ +: AQ] + (kill ? 1'b0 : seg_carry[i]);
+            assign add_result[i*AQ +: AQ] = seg_sum[AQ-1:0];
+            assign seg_carry[i+1] = seg_sum[AQ];
+        end
+    endgenerate
+
+    generate
+        if (ADD_LATENCY == 0) begin : no_add_lat
+            assign c_out = add_result;
+        end else begin : add_lat
+            reg [ACC_WIDTH-1:0] add_pipe [ADD_LATENCY-1:0];
+            integer a;
+            always @(posedge clk or negedge rst_n) begin
+                if (!rst_n) begin
+                    for (a=0; a<ADD_LATENCY; a=a+1) add_pipe[a] <= {ACC_WIDTH{1'b0}};
+                end else begin
+                    add_pipe[0] <= add_result;
+                    for (a=1; a<ADD_LATENCY; a=a+1) add_pipe[a] <= add_pipe[a-1];
+                end
+            end
+            assign c_out = add_pipe[ADD_LATENCY-1];
+        end
+    endgenerate
+
+endmodule
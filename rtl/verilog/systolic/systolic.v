@@ -1,5 +1,24 @@
 /*
  * Systolic Array Block
+ * MULTI_PRECISION builds the array from multi-precision PEs (pe2_mp): prec and
+ * lane_sum then select the precision mode per job (see systolic_controller).
+ * MUL_STAGED builds the products of pe2 over the MUL_LATENCY registers
+ * instead of delaying a combinational product (see pe2). MUL_SIGNED makes
+ * the pe2 operands two's complement, with C sign-extended (see systolic_bfp).
+ *
+ * Partitioning: with PART_ROWS x PART_COLS > 1 the array can also run as
+ * independent SUB_ROWS x SUB_COLS sub-arrays (SUB_ROWS = ROWS / PART_ROWS,
+ * SUB_COLS = COLS / PART_COLS), each with its own controller and its own job
+ * port (part_*): partition k takes A (SUB_ROWS x SUB_ROWS) and B (SUB_ROWS x
+ * SUB_COLS) on segment k of part_a / part_b and returns C (SUB_ROWS x
+ * SUB_COLS) on segment k of part_c with part_out_valid[k] and the tag of the
+ * job. part_mode selects the partitioned (1) or whole-array (0) operation;
+ * part_active follows it once all jobs of the other mode have drained. Jobs
+ * are only accepted on the ports of the active mode.
+ *
+ * Performance counters: csr_addr = {sel, reg} reaches the counter CSRs (reg,
+ * see systolic_controller) of the whole-array controller (sel = 0) or of the
+ * controller of partition k (sel = k + 1).
  */
 module systolic #(
     parameter ROWS = 2,
@@ -7,22 +26,66 @@ module systolic #(
     parameter WIDTH = 4,
     parameter ACC_WIDTH = 9,
     parameter MUL_LATENCY = 0,
-    parameter ADD_LATENCY = 1
+    parameter ADD_LATENCY = 1,
+    parameter MULTI_PRECISION = 0,
+    parameter MUL_STAGED = 0,
+    parameter MUL_SIGNED = 0,
+    parameter PART_ROWS = 1,
+    parameter PART_COLS = 1,
+    parameter TAG_WIDTH = 1,
+    parameter NUM_PARTS = PART_ROWS * PART_COLS,
+    parameter SUB_ROWS = ROWS / PART_ROWS,
+    parameter SUB_COLS = COLS / PART_COLS,
+    parameter CSR_ADDR_W = 4 + $clog2(NUM_PARTS + 1)
 ) (
     input  wire       clk,
     input  wire       rst_n,
     input  wire [ROWS*ROWS*WIDTH-1:0] a, // Flattened A matrix
     input  wire [ROWS*COLS*WIDTH-1:0] b, // Flattened B matrix
+    input  wire [1:0] prec,      // Lanes per operand: 1 << prec (MULTI_PRECISION only)
+    input  wire       lane_sum,  // Sum the lane products (packed dot product)
+    input  wire [TAG_WIDTH-1:0] in_tag,
     input  wire       in_valid,  // Strobe input data into buffers
     output wire       in_ready,  // Indicates input buffers can accept new data
     output wire [ROWS*COLS*ACC_WIDTH-1:0] c, // Flattened C matrix
-    output wire       out_valid  // Indicates output data is ready to be read
+    output wire       out_valid, // Indicates output data is ready to be read
+    output wire [TAG_WIDTH-1:0] out_tag,
+    // Partitioned operation (PART_ROWS x PART_COLS > 1)
+    input  wire       part_mode,
+    output wire       part_active,
+    input  wire [NUM_PARTS*SUB_ROWS*SUB_ROWS*WIDTH-1:0] part_a,
+    input  wire [NUM_PARTS*SUB_ROWS*SUB_COLS*WIDTH-1:0] part_b,
+    input  wire [2*NUM_PARTS-1:0]                       part_prec,
+    input  wire [NUM_PARTS-1:0]                         part_lane_sum,
+    input  wire [NUM_PARTS*TAG_WIDTH-1:0]               part_in_tag,
+    input  wire [NUM_PARTS-1:0]                         part_in_valid,
+    output wire [NUM_PARTS-1:0]                         part_in_ready,
+    output wire [NUM_PARTS*SUB_ROWS*SUB_COLS*ACC_WIDTH-1:0] part_c,
+    output wire [NUM_PARTS-1:0]                         part_out_valid,
+    output wire [NUM_PARTS*TAG_WIDTH-1:0]               part_out_tag,
+    // Performance counter CSRs
+    input  wire [CSR_ADDR_W-1:0] csr_addr,
+    input  wire                  csr_wr,
+    input  wire [31:0]           csr_wdata,
+    output wire [31:0]           csr_rdata
 );
 
-    wire b_load, b_update, b_update_done;
+    wire b_load, b_update;
+    wire [NUM_PARTS-1:0] b_update_done;
+    wire [1:0] pe_prec;
+    wire pe_lane_sum;
     wire [ROWS*WIDTH-1:0] a_row;
     wire [COLS*WIDTH-1:0] b_col;
-    wire [COLS*ACC_WIDTH-1:0] c_col;
+    wire [PART_ROWS*COLS*ACC_WIDTH-1:0] c_col;
+    wire whole_ready, whole_idle;
+
+    // CSR select: 0 whole-array controller, k + 1 partition k
+    wire [CSR_ADDR_W-5:0] csr_sel = csr_addr[CSR_ADDR_W-1:4];
+    wire [31:0] whole_csr_rdata;
+    wire [NUM_PARTS*32-1:0] part_csr_rdata;
+
+    assign csr_rdata = (csr_sel == 0) ? whole_csr_rdata :
+                       (csr_sel <= NUM_PARTS) ? part_csr_rdata[(csr_sel - 1)*32 +: 32] : 32'd0;
 
     systolic_controller #(
         .ROWS(ROWS),
@@ -30,34 +93,149 @@ module systolic #(
         .WIDTH(WIDTH),
         .ACC_WIDTH(ACC_WIDTH),
         .MUL_LATENCY(MUL_LATENCY),
-        .ADD_LATENCY(ADD_LATENCY)
+        .ADD_LATENCY(ADD_LATENCY),
+        .MULTI_PRECISION(MULTI_PRECISION),
+        .TAG_WIDTH(TAG_WIDTH)
     ) controller (
         .clk(clk), .rst_n(rst_n),
-        .in_valid(in_valid),
-        .in_ready(in_ready),
+        .in_valid(in_valid && in_ready),
+        .in_ready(whole_ready),
+        .in_request(in_valid),
         .a_flat(a),
         .b_flat(b),
-        .b_load(b_load), .b_update(b_update), .b_update_done(b_update_done),
+        .prec(prec), .lane_sum(lane_sum),
+        .in_tag(in_tag),
+        .b_load(b_load), .b_update(b_update), .b_update_done(b_update_done[0]),
+        .pe_prec(pe_prec), .pe_lane_sum(pe_lane_sum),
         .a_row_flat(a_row),
         .b_col_flat(b_col),
-        .c_col_flat(c_col),
+        .c_col_flat(c_col[(PART_ROWS-1)*COLS*ACC_WIDTH +: COLS*ACC_WIDTH]),
         .c_flat(c),
-        .out_valid(out_valid)
+        .out_valid(out_valid),
+        .out_tag(out_tag),
+        .idle(whole_idle),
+        .csr_addr(csr_addr[3:0]),
+        .csr_wr(csr_wr && csr_sel == 0),
+        .csr_wdata(csr_wdata),
+        .csr_rdata(whole_csr_rdata)
     );
 
+    // Array inputs, driven by the whole-array controller or by the partition controllers
+    wire [NUM_PARTS-1:0]           arr_b_load;
+    wire [NUM_PARTS-1:0]           arr_b_update;
+    wire [2*NUM_PARTS-1:0]         arr_prec;
+    wire [NUM_PARTS-1:0]           arr_lane_sum;
+    wire [PART_COLS*ROWS*WIDTH-1:0] arr_a_row;
+    wire [PART_ROWS*COLS*WIDTH-1:0] arr_b_col;
+
+    generate
+        if (NUM_PARTS > 1) begin : partitioned
+            wire [NUM_PARTS-1:0]           p_b_load, p_b_update, p_lane_sum, p_idle, p_ready;
+            wire [2*NUM_PARTS-1:0]         p_prec;
+            wire [PART_COLS*ROWS*WIDTH-1:0] p_a_row;
+            wire [PART_ROWS*COLS*WIDTH-1:0] p_b_col;
+            wire all_idle = whole_idle && (&p_idle);
+            reg  mode_q;
+
+            // Mode switch once the array has drained
+            always @(posedge clk or negedge rst_n) begin
+                if (!rst_n) mode_q <= 1'b0;
+                else if (all_idle) mode_q <= part_mode;
+            end
+
+            assign part_active = mode_q;
+
+            assign in_ready = whole_ready && !part_active && !part_mode;
+
+            genvar pr, pc;
+            for (pr = 0; pr < PART_ROWS; pr = pr + 1) begin : part_row
+                for (pc = 0; pc < PART_COLS; pc = pc + 1) begin : part_col
+                    localparam K = pr*PART_COLS + pc;
+
+                    assign part_in_ready[K] = p_ready[K] && part_active && part_mode;
+
+                    systolic_controller #(
+                        .ROWS(SUB_ROWS),
+                        .COLS(SUB_COLS),
+                        .WIDTH(WIDTH),
+                        .ACC_WIDTH(ACC_WIDTH),
+                        .MUL_LATENCY(MUL_LATENCY),
+                        .ADD_LATENCY(ADD_LATENCY),
+                        .MULTI_PRECISION(MULTI_PRECISION),
+                        .TAG_WIDTH(TAG_WIDTH)
+                    ) controller (
+                        .clk(clk), .rst_n(rst_n),
+                        .in_valid(part_in_valid[K] && part_in_ready[K]),
+                        .in_ready(p_ready[K]),
+                        .in_request(part_in_valid[K]),
+                        .a_flat(part_a[K*SUB_ROWS*SUB_ROWS*WIDTH +: SUB_ROWS*SUB_ROWS*WIDTH]),
+                        .b_flat(part_b[K*SUB_ROWS*SUB_COLS*WIDTH +: SUB_ROWS*SUB_COLS*WIDTH]),
+                        .prec(part_prec[2*K +: 2]), .lane_sum(part_lane_sum[K]),
+                        .in_tag(part_in_tag[K*TAG_WIDTH +: TAG_WIDTH]),
+                        .b_load(p_b_load[K]), .b_update(p_b_update[K]), .b_update_done(b_update_done[K]),
+                        .pe_prec(p_prec[2*K +: 2]), .pe_lane_sum(p_lane_sum[K]),
+                        // Rows pr*SUB_ROWS.. of a_row segment pc, columns pc*SUB_COLS.. of b_col / c_col segment pr
+                        .a_row_flat(p_a_row[(pc*ROWS + pr*SUB_ROWS)*WIDTH +: SUB_ROWS*WIDTH]),
+                        .b_col_flat(p_b_col[(pr*COLS + pc*SUB_COLS)*WIDTH +: SUB_COLS*WIDTH]),
+                        .c_col_flat(c_col[(pr*COLS + pc*SUB_COLS)*ACC_WIDTH +: SUB_COLS*ACC_WIDTH]),
+                        .c_flat(part_c[K*SUB_ROWS*SUB_COLS*ACC_WIDTH +: SUB_ROWS*SUB_COLS*ACC_WIDTH]),
+                        .out_valid(part_out_valid[K]),
+                        .out_tag(part_out_tag[K*TAG_WIDTH +: TAG_WIDTH]),
+                        .idle(p_idle[K]),
+                        .csr_addr(csr_addr[3:0]),
+                        .csr_wr(csr_wr && csr_sel == K + 1),
+                        .csr_wdata(csr_wdata),
+                        .csr_rdata(part_csr_rdata[K*32 +: 32])
+                    );
+                end
+            end
+
+            // The whole-array controller drives partition 0 / segment 0 (zero-extended)
+            assign arr_b_load   = part_active ? p_b_load : b_load;
+            assign arr_b_update = part_active ? p_b_update : b_update;
+            assign arr_prec     = part_active ? p_prec : pe_prec;
+            assign arr_lane_sum = part_active ? p_lane_sum : pe_lane_sum;
+            assign arr_a_row    = part_active ? p_a_row : a_row;
+            assign arr_b_col    = part_active ? p_b_col : b_col;
+        end else begin : whole
+            assign part_active = 1'b0;
+
+            assign in_ready = whole_ready;
+            assign part_in_ready = 1'b0;
+            assign part_c = {(SUB_ROWS*SUB_COLS*ACC_WIDTH){1'b0}};
+            assign part_out_valid = 1'b0;
+            assign part_out_tag = {TAG_WIDTH{1'b0}};
+            assign part_csr_rdata = 32'd0;
+
+            assign arr_b_load   = b_load;
+            assign arr_b_update = b_update;
+            assign arr_prec     = pe_prec;
+            assign arr_lane_sum = pe_lane_sum;
+            assign arr_a_row    = a_row;
+            assign arr_b_col    = b_col;
+        end
+    endgenerate
+
     systolic_array #(
         .ROWS(ROWS),
         .COLS(COLS),
         .WIDTH(WIDTH),
         .ACC_WIDTH(ACC_WIDTH),
         .MUL_LATENCY(MUL_LATENCY),
-        .ADD_LATENCY(ADD_LATENCY)
+        .ADD_LATENCY(ADD_LATENCY),
+        .MULTI_PRECISION(MULTI_PRECISION),
+        .MUL_STAGED(MUL_STAGED),
+        .MUL_SIGNED(MUL_SIGNED),
+        .PART_ROWS(PART_ROWS),
+        .PART_COLS(PART_COLS)
     ) array (
         .clk(clk), .rst_n(rst_n),
-        .b_load(b_load), .b_update(b_update), .b_update_done(b_update_done),
-        .a_row(a_row),
-        .b_col(b_col),
+        .part_mode(part_active),
+        .b_load(arr_b_load), .b_update(arr_b_update), .b_update_done(b_update_done),
+        .prec(arr_prec), .lane_sum(arr_lane_sum),
+        .a_row(arr_a_row),
+        .b_col(arr_b_col),
         .c_col(c_col)
     );
 
-endmodule
\ No newline at end of file
+endmodule
@@ -1,6 +1,19 @@
 /*
  * 2x2 Systolic Array
  * Instantiates 4 PEs in a 2*2 grid.
+ * MULTI_PRECISION selects the multi-precision PE (pe2_mp), prec and lane_sum
+ * are its mode inputs (ignored by pe2). MUL_STAGED selects the staged
+ * multiplier of pe2 and MUL_SIGNED its two's complement operands (see pe2.v,
+ * both ignored by pe2_mp).
+ *
+ * Partitioning: with part_mode = 1 the grid splits into PART_ROWS x PART_COLS
+ * independent sub-arrays of SUB_ROWS x SUB_COLS PEs. Partition k (row p,
+ * column q, k = p*PART_COLS + q) has its own b_load / b_update / mode inputs
+ * and b_update_done, takes A from a_row segment q (rows p*SUB_ROWS..) and B
+ * from b_col segment p, and its C leaves on c_col segment p; the A, B, C and
+ * b_update paths are cut at the partition boundaries. With part_mode = 0 the
+ * inputs of partition 0 drive the whole array, A enters on a_row segment 0,
+ * B on b_col segment 0, and C leaves on c_col segment PART_ROWS-1.
  */
 module systolic_array #(
     parameter ROWS = 2,
@@ -8,63 +21,102 @@ module systolic_array #(
     parameter WIDTH = 4,
     parameter ACC_WIDTH = 9,
     parameter MUL_LATENCY = 0,
-    parameter ADD_LATENCY = 1
+    parameter ADD_LATENCY = 1,
+    parameter MULTI_PRECISION = 0,
+    parameter MUL_STAGED = 0,
+    parameter MUL_SIGNED = 0,
+    parameter PART_ROWS = 1, // Must divide ROWS
+    parameter PART_COLS = 1, // Must divide COLS
+    parameter NUM_PARTS = PART_ROWS * PART_COLS
 ) (
     input  wire       clk,
     input  wire       rst_n,
-    input  wire       b_load,
-    input  wire       b_update,
-    // Row inputs for A (Activation) - Flattened
-    input  wire [ROWS*WIDTH-1:0] a_row,
-    // Column inputs for B (Weight loading) - Flattened
-    input  wire [COLS*WIDTH-1:0] b_col,
-    // Column outputs for C (Result) - Flattened
-    output wire [COLS*ACC_WIDTH-1:0] c_col,
-    output wire       b_update_done
+    input  wire       part_mode,
+    input  wire [NUM_PARTS-1:0] b_load,
+    input  wire [NUM_PARTS-1:0] b_update,
+    // Precision mode, sampled by each PE with its staggered b_update
+    input  wire [2*NUM_PARTS-1:0] prec,
+    input  wire [NUM_PARTS-1:0] lane_sum,
+    // Row inputs for A (Activation) - Flattened, one segment per partition column
+    input  wire [PART_COLS*ROWS*WIDTH-1:0] a_row,
+    // Column inputs for B (Weight loading) - Flattened, one segment per partition row
+    input  wire [PART_ROWS*COLS*WIDTH-1:0] b_col,
+    // Column outputs for C (Result) - Flattened, one segment per partition row
+    output wire [PART_ROWS*COLS*ACC_WIDTH-1:0] c_col,
+    output wire [NUM_PARTS-1:0] b_update_done
 );
 
     localparam ALU_LATENCY = MUL_LATENCY + ADD_LATENCY;
+    localparam SUB_ROWS = ROWS / PART_ROWS;
+    localparam SUB_COLS = COLS / PART_COLS;
 
     // Interconnect wires
     // a_wire[i][j] connects PE(i,j-1) to PE(i,j)
     // b_wire[i][j] connects PE(i-1,j) to PE(i,j)
     // c_wire[i][j] connects PE(i-1,j) to PE(i,j)
-    
+    // The *_in wires are the PE inputs (edge inputs at partition boundaries)
+
     wire [WIDTH-1:0] a_wire [ROWS-1:0][COLS:0];
     wire [WIDTH-1:0] b_wire [ROWS:0][COLS-1:0];
     wire [ACC_WIDTH-1:0] c_wire [ROWS:0][COLS-1:0];
+    wire [WIDTH-1:0] a_in [ROWS-1:0][COLS-1:0];
+    wire [WIDTH-1:0] b_in [ROWS-1:0][COLS-1:0];
+    wire [ACC_WIDTH-1:0] c_in [ROWS-1:0][COLS-1:0];
 
     // Staggered b_update signals
-    // [i][0] is the input to the row, [i][j+1] is the output from PE(i,j)
+    // [i][j+1] is the output from PE(i,j), bu_in[i][j] the input of PE(i,j)
     wire b_update_chain [ROWS-1:0][COLS:0];
+    wire bu_in [ROWS-1:0][COLS-1:0];
+    // v_chain[q][i] enters row i at the first column of partition column q
+    wire v_chain [PART_COLS-1:0][ROWS-1:0];
+    wire v_delayed [PART_COLS-1:0][ROWS-1:0];
 
-    genvar i, j;
+    genvar i, j, p, q;
     generate
         // b_update propagation logic
-        // (0,0) receives the global signal
-        assign b_update_done = b_update_chain[ROWS-1][COLS];
-
-        assign b_update_chain[0][0] = b_update;
+        for (p = 0; p < PART_ROWS; p = p + 1) begin : done_row
+            for (q = 0; q < PART_COLS; q = q + 1) begin : done_col
+                if (p == 0 && q == 0) begin : whole
+                    assign b_update_done[0] = part_mode ? b_update_chain[SUB_ROWS-1][SUB_COLS]
+                                                        : b_update_chain[ROWS-1][COLS];
+                end else begin : part
+                    assign b_update_done[p*PART_COLS + q] = b_update_chain[(p+1)*SUB_ROWS-1][(q+1)*SUB_COLS];
+                end
+            end
+        end
 
-        // Vertical propagation for Column 0 (Row 1 to ROWS-1)
+        // Vertical propagation down the first column of each partition column
         // Delays match ADD_LATENCY to align with row start times (skewed by controller)
-        for (i = 1; i < ROWS; i = i + 1) begin : v_prop
-            if (ADD_LATENCY == 0) begin
-                 assign b_update_chain[i][0] = b_update_chain[i-1][0];
-            end else begin : delay_logic
-                 reg [ADD_LATENCY-1:0] v_sr;
-                 if (ADD_LATENCY == 1) begin : lat1
-                     always @(posedge clk or negedge rst_n) begin
-                         if (!rst_n) v_sr <= 1'b0;
-                         else v_sr <= b_update_chain[i-1][0];
-                     end
-                 end else begin : lat_n
-                     always @(posedge clk or negedge rst_n) begin
-                         if (!rst_n) v_sr <= {ADD_LATENCY{1'b0}};
-                         else v_sr <= {v_sr[ALU_LATENCY-2:0], b_update_chain[i-1][0]};
-                     end
-                 end
-                 assign b_update_chain[i][0] = v_sr[ADD_LATENCY-1];
+        for (q = 0; q < PART_COLS; q = q + 1) begin : v_col
+            for (i = 0; i < ROWS; i = i + 1) begin : v_prop
+                if (i == 0) begin : first
+                    assign v_delayed[q][i] = 1'b0;
+                end else if (ADD_LATENCY == 0) begin : no_delay
+                    assign v_delayed[q][i] = v_chain[q][i-1];
+                end else begin : delay_logic
+                    reg [ADD_LATENCY-1:0] v_sr;
+                    if (ADD_LATENCY == 1) begin : lat1
+                        always @(posedge clk or negedge rst_n) begin
+                            if (!rst_n) v_sr <= 1'b0;
+                            else v_sr <= v_chain[q][i-1];
+                        end
+                    end else begin : lat_n
+                        always @(posedge clk or negedge rst_n) begin
+                            if (!rst_n) v_sr <= {ADD_LATENCY{1'b0}};
+                            else v_sr <= {v_sr[ADD_LATENCY-2:0], v_chain[q][i-1]};
+                        end
+                    end
+                    assign v_delayed[q][i] = v_sr[ADD_LATENCY-1];
+                end
+
+                if (i == 0 && q == 0) begin : global
+                    // (0,0) receives the global signal
+                    assign v_chain[q][i] = b_update[0];
+                end else if (i % SUB_ROWS == 0) begin : part_top
+                    assign v_chain[q][i] = part_mode ? b_update[(i/SUB_ROWS)*PART_COLS + q] : v_delayed[q][i];
+                end else begin : inner
+                    assign v_chain[q][i] = v_delayed[q][i];
+                end
             end
         end
 
@@ -72,26 +124,68 @@ module systolic_array #(
 
         // Assign inputs to the edges
         for (i = 0; i < ROWS; i = i + 1) begin : row_inputs
-            assign a_wire[i][0] = a_row[i*WIDTH +: WIDTH];
+            for (j = 0; j < COLS; j = j + 1) begin : col_inputs
+                // A and b_update enter at column 0, or at a partition column edge
+                if (j == 0) begin : a_edge
+                    assign a_in[i][j] = a_row[i*WIDTH +: WIDTH];
+                    assign bu_in[i][j] = v_chain[0][i];
+                end else if (j % SUB_COLS == 0) begin : a_part
+                    assign a_in[i][j] = part_mode ? a_row[((j/SUB_COLS)*ROWS + i)*WIDTH +: WIDTH] : a_wire[i][j];
+                    assign bu_in[i][j] = part_mode ? v_chain[j/SUB_COLS][i] : b_update_chain[i][j];
+                end else begin : a_inner
+                    assign a_in[i][j] = a_wire[i][j];
+                    assign bu_in[i][j] = b_update_chain[i][j];
+                end
+
+                // B and C (top C input is 0) enter at row 0, or at a partition row edge
+                if (i == 0) begin : bc_edge
+                    assign b_in[i][j] = b_col[j*WIDTH +: WIDTH];
+                    assign c_in[i][j] = {ACC_WIDTH{1'b0}};
+                end else if (i % SUB_ROWS == 0) begin : bc_part
+                    assign b_in[i][j] = part_mode ? b_col[((i/SUB_ROWS)*COLS + j)*WIDTH +: WIDTH] : b_wire[i][j];
+                    assign c_in[i][j] = part_mode ? {ACC_WIDTH{1'b0}} : c_wire[i][j];
+                end else begin : bc_inner
+                    assign b_in[i][j] = b_wire[i][j];
+                    assign c_in[i][j] = c_wire[i][j];
+                end
+            end
         end
-        for (j = 0; j < COLS; j = j + 1) begin : col_inputs
-            assign b_wire[0][j] = b_col[j*WIDTH +: WIDTH];
-            assign c_wire[0][j] = {ACC_WIDTH{1'b0}}; // Top C input is 0
-            assign c_col[j*ACC_WIDTH +: ACC_WIDTH] = c_wire[ROWS][j]; // Bottom C output
+        // Bottom C output of each partition row
+        for (p = 0; p < PART_ROWS; p = p + 1) begin : c_outputs
+            for (j = 0; j < COLS; j = j + 1) begin : c_col_out
+                assign c_col[(p*COLS + j)*ACC_WIDTH +: ACC_WIDTH] = c_wire[(p+1)*SUB_ROWS][j];
+            end
         end
 
         // Instantiate PEs
         for (i = 0; i < ROWS; i = i + 1) begin : row_gen
             for (j = 0; j < COLS; j = j + 1) begin : col_gen
-                pe2 #(.WIDTH(WIDTH), .ACC_WIDTH(ACC_WIDTH), .MUL_LATENCY(MUL_LATENCY), .ADD_LATENCY(ADD_LATENCY)) pe (
-                    .clk(clk), .rst_n(rst_n),
-                    .b_load(b_load), .b_update(b_update_chain[i][j]),
-                    .a_in(a_wire[i][j]), .b_in(b_wire[i][j]), .c_in(c_wire[i][j]),
-                    .a_out(a_wire[i][j+1]), .b_out(b_wire[i+1][j]), .c_out(c_wire[i+1][j]),
-                    .b_update_out(b_update_chain[i][j+1])
-                );
+                // Control inputs of the partition the PE belongs to (partition 0 drives the whole array)
+                localparam PK = (i/SUB_ROWS)*PART_COLS + j/SUB_COLS;
+                wire       pe_b_load   = part_mode ? b_load[PK] : b_load[0];
+                wire [1:0] pe_prec     = part_mode ? prec[2*PK +: 2] : prec[1:0];
+                wire       pe_lane_sum = part_mode ? lane_sum[PK] : lane_sum[0];
+
+                if (MULTI_PRECISION) begin : mp
+                    pe2_mp #(.WIDTH(WIDTH), .ACC_WIDTH(ACC_WIDTH), .MUL_LATENCY(MUL_LATENCY), .ADD_LATENCY(ADD_LATENCY)) pe (
+                        .clk(clk), .rst_n(rst_n),
+                        .b_load(pe_b_load), .b_update(bu_in[i][j]),
+                        .prec(pe_prec), .lane_sum(pe_lane_sum),
+                        .a_in(a_in[i][j]), .b_in(b_in[i][j]), .c_in(c_in[i][j]),
+                        .a_out(a_wire[i][j+1]), .b_out(b_wire[i+1][j]), .c_out(c_wire[i+1][j]),
+                        .b_update_out(b_update_chain[i][j+1])
+                    );
+                end else begin : fixed
+                    pe2 #(.WIDTH(WIDTH), .ACC_WIDTH(ACC_WIDTH), .MUL_LATENCY(MUL_LATENCY), .ADD_LATENCY(ADD_LATENCY), .MUL_STAGED(MUL_STAGED), .MUL_SIGNED(MUL_SIGNED)) pe (
+                        .clk(clk), .rst_n(rst_n),
+                        .b_load(pe_b_load), .b_update(bu_in[i][j]),
+                        .a_in(a_in[i][j]), .b_in(b_in[i][j]), .c_in(c_in[i][j]),
+                        .a_out(a_wire[i][j+1]), .b_out(b_wire[i+1][j]), .c_out(c_wire[i+1][j]),
+                        .b_update_out(b_update_chain[i][j+1])
+                    );
+                end
             end
         end
     endgenerate
 
-endmodule
\ No newline at end of file
+endmodule
@@ -0,0 +1,110 @@
+/*
+ * Block Floating Point Systolic Array
+ * Runs C = A * B on block floating point operands (shared-exponent blocks,
+ * e.g. from fp_to_bfp): every row i of A and every column j of B is one
+ * block of ROWS MANT_W-bit two's complement mantissas (MANT_W-2 fraction
+ * bits) with an 8-bit E8M0 exponent a_exp[i] / b_exp[j].
+ *
+ * The array multiplies the mantissas as integers (systolic with signed pe2,
+ * MUL_SIGNED = 1). The block exponents travel with the job in the systolic
+ * tag and are applied where the accumulation over k leaves the array: C
+ * element (i, j) is
+ *   c[i][j] * 2^(c_exp[i][j] - 254 - 2*(MANT_W-2)),  c_exp[i][j] = a_exp[i] + b_exp[j]
+ * and c_nan[i][j] is set if either block scale is NaN (0xFF). c is exact
+ * with the default ACC_WIDTH, so accumulation over several jobs (K > ROWS)
+ * only has to align c_exp.
+ *
+ * Compared to fp16 operands, the array moves MANT_W + 8/ROWS bits per element
+ * (8.25 for MANT_W = 8, ROWS = 32) and its PEs multiply MANT_W-bit integers.
+ */
+module systolic_bfp #(
+    parameter ROWS = 2,
+    parameter COLS = 2,
+    parameter MANT_W = 8,
+    parameter ACC_WIDTH = 2*MANT_W - 1 + $clog2(ROWS),
+    parameter MUL_LATENCY = 0,
+    parameter ADD_LATENCY = 1,
+    parameter MUL_STAGED = 0,
+    parameter TAG_WIDTH = 1
+) (
+    input  wire       clk,
+    input  wire       rst_n,
+    input  wire [ROWS*ROWS*MANT_W-1:0] a_mant, // Flattened A mantissas, row i is a block
+    input  wire [ROWS*8-1:0]           a_exp,  // Block exponent of row i at [i*8 +: 8]
+    input  wire [ROWS*COLS*MANT_W-1:0] b_mant, // Flattened B mantissas, column j is a block
+    input  wire [COLS*8-1:0]           b_exp,  // Block exponent of column j at [j*8 +: 8]
+    input  wire [TAG_WIDTH-1:0] in_tag,
+    input  wire       in_valid,
+    output wire       in_ready,
+    output wire [ROWS*COLS*ACC_WIDTH-1:0] c,   // Flattened C mantissas (two's complement)
+    output wire [ROWS*COLS*9-1:0]         c_exp,
+    output wire [ROWS*COLS-1:0]           c_nan,
+    output wire       out_valid,
+    output wire [TAG_WIDTH-1:0] out_tag
+);
+
+    // Systolic tag: {b_exp, a_exp, in_tag}
+    localparam SYS_TAG_WIDTH = TAG_WIDTH + 8*(ROWS + COLS);
+
+    wire [SYS_TAG_WIDTH-1:0] sys_out_tag;
+
+    systolic #(
+        .ROWS(ROWS),
+        .COLS(COLS),
+        .WIDTH(MANT_W),
+        .ACC_WIDTH(ACC_WIDTH),
+        .MUL_LATENCY(MUL_LATENCY),
+        .ADD_LATENCY(ADD_LATENCY),
+        .MUL_STAGED(MUL_STAGED),
+        .MUL_SIGNED(1),
+        .TAG_WIDTH(SYS_TAG_WIDTH)
+    ) sys (
+        .clk(clk),
+        .rst_n(rst_n),
+        .a(a_mant),
+        .b(b_mant),
+        .prec(2'd0),
+        .lane_sum(1'b0),
+        .in_tag({b_exp, a_exp, in_tag}),
+        .in_valid(in_valid),
+        .in_ready(in_ready),
+        .c(c),
+        .out_valid(out_valid),
+        .out_tag(sys_out_tag),
+        .part_mode(1'b0),
+        .part_active(),
+        .part_a('0),
+        .part_b('0),
+        .part_prec('0),
+        .part_lane_sum('0),
+        .part_in_tag('0),
+        .part_in_valid('0),
+        .part_in_ready(),
+        .part_c(),
+        .part_out_valid(),
+        .part_out_tag(),
+        .csr_addr('0),
+        .csr_wr(1'b0),
+        .csr_wdata(32'd0),
+        .csr_rdata()
+    );
+
+    wire [ROWS*8-1:0] out_a_exp = sys_out_tag[TAG_WIDTH +: ROWS*8];
+    wire [COLS*8-1:0] out_b_exp = sys_out_tag[TAG_WIDTH + ROWS*8 +: COLS*8];
+
+    assign out_tag = sys_out_tag[TAG_WIDTH-1:0];
+
+    // Block exponents of the accumulated C
+    genvar i, j;
+    generate
+        for (i = 0; i < ROWS; i = i + 1) begin : row
+            for (j = 0; j < COLS; j = j + 1) begin : col
+                wire [7:0] ea = out_a_exp[i*8 +: 8];
+                wire [7:0] eb = out_b_exp[j*8 +: 8];
+                assign c_exp[(i*COLS + j)*9 +: 9] = {1'b0, ea} + {1'b0, eb};
+                assign c_nan[i*COLS + j]          = (&ea) || (&eb);
+            end
+        end
+    endgenerate
+
+endmodule
@@ -1,6 +1,34 @@
 /*
  * Systolic Array Controller
  * Handles sequencing of weight loading, input skewing, and output collection.
+ *
+ * With MULTI_PRECISION, each job carries a precision mode (prec, lane_sum, see
+ * pe2_mp) through the input FIFO. In lane-sum mode with n = 1 << prec lanes,
+ * a_flat and b_flat hold A (ROWS x n*ROWS) and B (n*ROWS x COLS) as row-major
+ * WIDTH/n-bit elements, i.e. the reduction is n times deeper in the same
+ * number of cycles. A needs no repacking (the n elements of a PE row are
+ * adjacent); the n B elements of a PE are gathered from n rows of B here.
+ * With independent lanes, every WIDTH-bit element is a packed lane vector and
+ * passes through unchanged.
+ *
+ * in_tag travels with the job and comes out as out_tag with its C. idle is
+ * high when no job is queued or in the array (systolic switches the array
+ * partitioning only then).
+ *
+ * Performance counters (32 bits, wrapping), read through the CSR port at the
+ * word address csr_addr (csr_rdata is combinational):
+ *   0 PERF_CTRL        bit 0: count enable (1 after reset), writing bit 1 clears all counters
+ *   1 PERF_CYCLES      cycles counted
+ *   2 PERF_BUSY        cycles with a job queued or in the array (!idle)
+ *   3 PERF_STALL       cycles with a job on the port that was not accepted (in_request && !in_valid)
+ *   4 PERF_B_LOAD      cycles loading B into the shadow registers
+ *   5 PERF_B_UPDATE    cycles from b_update until the wavefront has passed the last PE
+ *   6 PERF_DRAIN       cycles collecting C from the bottom of the array
+ *   7 PERF_FIFO_FULL   cycles with the input FIFO full
+ *   8 PERF_FIFO_EMPTY  cycles with the input FIFO empty
+ *   9 PERF_JOBS        results (out_valid)
+ * verif/lib/systolic_model.cpp has a cycle model of the controller with the
+ * same counters and addresses.
  */
 module systolic_controller #(
     parameter ROWS = 2,
@@ -8,45 +36,66 @@ module systolic_controller #(
     parameter WIDTH = 4,
     parameter ACC_WIDTH = 9,
     parameter MUL_LATENCY = 0,
-    parameter ADD_LATENCY = 1
+    parameter ADD_LATENCY = 1,
+    parameter MULTI_PRECISION = 0,
+    parameter TAG_WIDTH = 1
 ) (
     input  wire       clk,
     input  wire       rst_n,
     input  wire       in_valid,
     output wire       in_ready,
+    input  wire       in_request,   // Job on the port, accepted or not (PERF_STALL only)
     // Inputs A
     input  wire [ROWS*ROWS*WIDTH-1:0] a_flat,
     // Inputs B
     input  wire [ROWS*COLS*WIDTH-1:0] b_flat,
+    // Precision mode of the job (MULTI_PRECISION only)
+    input  wire [1:0] prec,
+    input  wire       lane_sum,
+    input  wire [TAG_WIDTH-1:0] in_tag,
     // Array Interface
     output reg        b_load,
     output reg        b_update,
+    output reg  [1:0] pe_prec,      // Mode of the job being switched in by b_update
+    output reg        pe_lane_sum,
     output reg  [ROWS*WIDTH-1:0] a_row_flat,
     output reg  [COLS*WIDTH-1:0] b_col_flat,
     input  wire [COLS*ACC_WIDTH-1:0] c_col_flat,
     input  wire       b_update_done,
     // System Outputs
     output reg  [ROWS*COLS*ACC_WIDTH-1:0] c_flat,
-    output reg        out_valid
+    output reg        out_valid,
+    output reg  [TAG_WIDTH-1:0] out_tag,
+    output wire       idle,
+    // Performance counter CSRs
+    input  wire [3:0]  csr_addr,
+    input  wire        csr_wr,
+    input  wire [31:0] csr_wdata,
+    output reg  [31:0] csr_rdata
 );
 
     localparam ALU_LATENCY = MUL_LATENCY + ADD_LATENCY;
     localparam FIFO_DEPTH = 4;
+    localparam MODE_BITS = 3;
 
     //-------------------------------------------------------------------------
-    // Input FIFO (Stores A and B matrices)
+    // Input FIFO (Stores tag, mode, A and B matrices)
     //-------------------------------------------------------------------------
-    wire [ROWS*ROWS*WIDTH + ROWS*COLS*WIDTH - 1 : 0] fifo_in;
-    wire [ROWS*ROWS*WIDTH + ROWS*COLS*WIDTH - 1 : 0] fifo_out;
+    localparam FIFO_WIDTH = TAG_WIDTH + MODE_BITS + ROWS*ROWS*WIDTH + ROWS*COLS*WIDTH;
+    wire [FIFO_WIDTH-1:0] fifo_in;
+    wire [FIFO_WIDTH-1:0] fifo_out;
     wire fifo_full, fifo_empty;
     wire fifo_push, fifo_pop;
+    wire [MODE_BITS-1:0] job_mode;
 
-    assign fifo_in = {a_flat, b_flat};
+    // The mode inputs are don't-care without MULTI_PRECISION
+    assign job_mode = MULTI_PRECISION ? {(prec == 2'd3) ? 2'd2 : prec, lane_sum} : {MODE_BITS{1'b0}};
+    assign fifo_in = {in_tag, job_mode, a_flat, b_flat};
     assign fifo_push = in_valid;
     assign in_ready = !fifo_full;
 
     fifo1 #(
-        .WIDTH(ROWS*ROWS*WIDTH + ROWS*COLS*WIDTH),
+        .WIDTH(FIFO_WIDTH),
         .DEPTH(FIFO_DEPTH)
     ) input_fifo (
         .clk(clk), .rst_n(rst_n),
@@ -68,19 +117,39 @@ module systolic_controller #(
     reg start_job;
     reg [$clog2(ROWS):0] load_cnt;
     reg [ROWS*ROWS*WIDTH-1:0] current_a;
+    reg [1:0] current_prec;
+    reg current_lane_sum;
+    reg [TAG_WIDTH-1:0] current_tag;
     
     // Unpack B head for loading
+    wire [TAG_WIDTH-1:0] head_tag;
+    wire [1:0] head_prec;
+    wire head_lane_sum;
     wire [ROWS*ROWS*WIDTH-1:0] a_head;
     wire [ROWS*COLS*WIDTH-1:0] b_head;
-    assign {a_head, b_head} = fifo_out;
+    assign {head_tag, head_prec, head_lane_sum, a_head, b_head} = fifo_out;
 
     wire [WIDTH-1:0] b_head_unpacked [ROWS-1:0][COLS-1:0];
     
-    genvar r, c_idx;
+    genvar r, c_idx, l;
     generate
         for (r=0; r<ROWS; r=r+1) begin : b_unpack_row
             for (c_idx=0; c_idx<COLS; c_idx=c_idx+1) begin : b_unpack_col
-                assign b_head_unpacked[r][c_idx] = b_head[(r*COLS + c_idx)*WIDTH +: WIDTH];
+                wire [WIDTH-1:0] b_word = b_head[(r*COLS + c_idx)*WIDTH +: WIDTH];
+                if (MULTI_PRECISION) begin : mp
+                    // Lane-sum mode: lane l of PE row r is element (r*n + l) of the B column
+                    wire [WIDTH-1:0] b_k2, b_k4;
+                    for (l=0; l<2; l=l+1) begin : k2
+                        assign b_k2[l*(WIDTH/2) +: WIDTH/2] = b_head[((r*2 + l)*COLS + c_idx)*(WIDTH/2) +: WIDTH/2];
+                    end
+                    for (l=0; l<4; l=l+1) begin : k4
+                        assign b_k4[l*(WIDTH/4) +: WIDTH/4] = b_head[((r*4 + l)*COLS + c_idx)*(WIDTH/4) +: WIDTH/4];
+                    end
+                    assign b_head_unpacked[r][c_idx] = (!head_lane_sum || head_prec == 2'd0) ? b_word :
+                                                       (head_prec == 2'd1) ? b_k2 : b_k4;
+                end else begin : fixed
+                    assign b_head_unpacked[r][c_idx] = b_word;
+                end
             end
         end
     endgenerate
@@ -99,6 +168,11 @@ module systolic_controller #(
             b_load <= 0;
             b_update <= 0;
             current_a <= 0;
+            current_prec <= 0;
+            current_lane_sum <= 0;
+            current_tag <= 0;
+            pe_prec <= 0;
+            pe_lane_sum <= 0;
             start_job <= 0;
         end else begin
             // Default assignments
@@ -112,7 +186,10 @@ module systolic_controller #(
                         state <= S_LOAD;
                         load_cnt <= 0;
                         b_load <= 1;
-                        current_a <= a_head; // Latch A for the upcoming job
+                        current_a <= a_head; // Latch A, mode and tag for the upcoming job
+                        current_prec <= head_prec;
+                        current_lane_sum <= head_lane_sum;
+                        current_tag <= head_tag;
                     end
                 end
 
@@ -124,6 +201,9 @@ module systolic_controller #(
                             state <= S_UPDATE;
                             b_update <= 1; // Pulse update next cycle
                             start_job <= 1;
+                            // Held until the next update, after the wavefront has passed all PEs
+                            pe_prec <= current_prec;
+                            pe_lane_sum <= current_lane_sum;
                         end else begin
                             state <= S_WAIT_A;
                         end
@@ -137,6 +217,8 @@ module systolic_controller #(
                         state <= S_UPDATE;
                         b_update <= 1; // Pulse update next cycle
                         start_job <= 1;
+                        pe_prec <= current_prec;
+                        pe_lane_sum <= current_lane_sum;
                     end
                 end
 
@@ -151,7 +233,10 @@ module systolic_controller #(
                             state <= S_LOAD;
                             load_cnt <= 0;
                             b_load <= 1;
-                            current_a <= a_head; // Latch next A
+                            current_a <= a_head; // Latch next A, mode and tag
+                            current_prec <= head_prec;
+                            current_lane_sum <= head_lane_sum;
+                            current_tag <= head_tag;
                         end else begin
                             state <= S_IDLE;
                         end
@@ -233,27 +318,40 @@ module systolic_controller #(
     // Triggered by start_job delayed by latency of the array.
 
     wire start_c_collection;
+    wire [TAG_WIDTH-1:0] start_c_tag;
+    wire c_pending;
     localparam C_START_DELAY = ROWS*ADD_LATENCY + MUL_LATENCY;
     
-    // Delay line for start signal
+    // Delay line for start signal (and the job tag)
     if (C_START_DELAY > 0) begin : c_delay_gen
         reg [C_START_DELAY-1:0] c_start_sr;
+        reg [C_START_DELAY*TAG_WIDTH-1:0] c_tag_sr;
         always @(posedge clk or negedge rst_n) begin
-            if (!rst_n) c_start_sr <= 0;
-            else begin
-                if (C_START_DELAY == 1)
+            if (!rst_n) begin
+                c_start_sr <= 0;
+                c_tag_sr <= 0;
+            end else begin
+                if (C_START_DELAY == 1) begin
                     c_start_sr <= start_job;
-                else
+                    c_tag_sr <= current_tag;
+                end else begin
                     c_start_sr <= {c_start_sr[C_START_DELAY-2:0], start_job};
+                    c_tag_sr <= {c_tag_sr[(C_START_DELAY-1)*TAG_WIDTH-1:0], current_tag};
+                end
             end
         end
         assign start_c_collection = c_start_sr[C_START_DELAY-1];
+        assign start_c_tag = c_tag_sr[(C_START_DELAY-1)*TAG_WIDTH +: TAG_WIDTH];
+        assign c_pending = |c_start_sr;
     end else begin : c_no_delay
         assign start_c_collection = start_job;
+        assign start_c_tag = current_tag;
+        assign c_pending = 1'b0;
     end
 
     reg [7:0] c_timer;
     reg [ROWS*COLS*ACC_WIDTH-1:0] c_buffer;
+    reg [TAG_WIDTH-1:0] c_tag;
     integer c_j;
 
     always @(posedge clk or negedge rst_n) begin
@@ -263,12 +361,15 @@ module systolic_controller #(
             c_buffer <= 0;
             out_valid <= 0;
             c_flat <= 0;
+            c_tag <= 0;
+            out_tag <= 0;
         end else begin
             out_valid <= 0;
 
             if (start_c_collection) begin
                 c_active <= 1;
                 c_timer <= 0;
+                c_tag <= start_c_tag;
             end
 
             if (c_active) begin
@@ -290,9 +391,91 @@ module systolic_controller #(
                     c_active <= 0;
                     out_valid <= 1;
                     c_flat <= c_buffer;
+                    out_tag <= c_tag;
                 end
             end
         end
     end
+
+    assign idle = (state == S_IDLE) && fifo_empty && !start_job && !a_active && !c_pending && !c_active;
+
+    //-------------------------------------------------------------------------
+    // Performance Counters
+    //-------------------------------------------------------------------------
+    localparam PERF_CTRL       = 4'd0;
+    localparam PERF_CYCLES     = 4'd1;
+    localparam PERF_BUSY       = 4'd2;
+    localparam PERF_STALL      = 4'd3;
+    localparam PERF_B_LOAD     = 4'd4;
+    localparam PERF_B_UPDATE   = 4'd5;
+    localparam PERF_DRAIN      = 4'd6;
+    localparam PERF_FIFO_FULL  = 4'd7;
+    localparam PERF_FIFO_EMPTY = 4'd8;
+    localparam PERF_JOBS       = 4'd9;
+
+    reg        perf_enable;
+    reg [31:0] perf_cycles, perf_busy, perf_stall, perf_b_load, perf_b_update;
+    reg [31:0] perf_drain, perf_fifo_full, perf_fifo_empty, perf_jobs;
+
+    wire perf_ctrl_wr = csr_wr && (csr_addr == PERF_CTRL);
+    wire perf_clear = perf_ctrl_wr && csr_wdata[1];
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            perf_enable <= 1;
+        end else if (perf_ctrl_wr) begin
+            perf_enable <= csr_wdata[0];
+        end
+    end
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            perf_cycles <= 0;
+            perf_busy <= 0;
+            perf_stall <= 0;
+            perf_b_load <= 0;
+            perf_b_update <= 0;
+            perf_drain <= 0;
+            perf_fifo_full <= 0;
+            perf_fifo_empty <= 0;
+            perf_jobs <= 0;
+        end else if (perf_clear) begin
+            perf_cycles <= 0;
+            perf_busy <= 0;
+            perf_stall <= 0;
+            perf_b_load <= 0;
+            perf_b_update <= 0;
+            perf_drain <= 0;
+            perf_fifo_full <= 0;
+            perf_fifo_empty <= 0;
+            perf_jobs <= 0;
+        end else if (perf_enable) begin
+            perf_cycles <= perf_cycles + 1;
+            perf_busy <= perf_busy + !idle;
+            perf_stall <= perf_stall + (in_request && !in_valid);
+            perf_b_load <= perf_b_load + (state == S_LOAD);
+            perf_b_update <= perf_b_update + (state == S_UPDATE || state == S_WAIT);
+            perf_drain <= perf_drain + c_active;
+            perf_fifo_full <= perf_fifo_full + fifo_full;
+            perf_fifo_empty <= perf_fifo_empty + fifo_empty;
+            perf_jobs <= perf_jobs + out_valid;
+        end
+    end
+
+    always @(*) begin
+        case (csr_addr)
+            PERF_CTRL:       csr_rdata = {31'd0, perf_enable};
+            PERF_CYCLES:     csr_rdata = perf_cycles;
+            PERF_BUSY:       csr_rdata = perf_busy;
+            PERF_STALL:      csr_rdata = perf_stall;
+            PERF_B_LOAD:     csr_rdata = perf_b_load;
+            PERF_B_UPDATE:   csr_rdata = perf_b_update;
+            PERF_DRAIN:      csr_rdata = perf_drain;
+            PERF_FIFO_FULL:  csr_rdata = perf_fifo_full;
+            PERF_FIFO_EMPTY: csr_rdata = perf_fifo_empty;
+            PERF_JOBS:       csr_rdata = perf_jobs;
+            default:         csr_rdata = 32'd0;
+        endcase
+    end
  
 endmodule
\ No newline at end of file
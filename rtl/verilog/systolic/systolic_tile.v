@@ -0,0 +1,465 @@
+/*
+ * Systolic Tile Subsystem
+ * Banked on-chip scratchpads for A, B and C tiles in front of the systolic
+ * block, with double-buffered (ping-pong) regions.
+ *
+ * - AB scratchpad: 2 halves of AB_HALF_DEPTH WIDTH-bit words. The host writes
+ *   A and B tiles into the fill half (wr_*) and submits a job (job_*) with the
+ *   tile base addresses and row strides within that half. Submitting a job
+ *   flips the fill half, so the host loads the next tiles while the current
+ *   ones are fetched. wr_ready and job_ready are low while the fill half
+ *   still has a job waiting for (or in) its fetch.
+ * - Fetch: tile_agu reads the A tile (ROWS x ROWS) and then the B tile
+ *   (ROWS x COLS) with NUM_BANKS read lanes per cycle (bank conflicts stall
+ *   lanes, see spad), assembles a_flat / b_flat and hands the job to the
+ *   systolic controller.
+ * - C scratchpad: 2 halves of C_HALF_DEPTH ACC_WIDTH-bit words. Each result
+ *   is written back as a ROWS x COLS tile at the job's C base / stride in the
+ *   half of the job, then done pulses with done_half. The host reads C
+ *   through c_rd_* (one cycle latency).
+ *
+ * Jobs handed to the systolic block are limited to JOBS_IN_FLIGHT, the depth
+ * of the result buffer, since systolic has no output backpressure.
+ *
+ * The perf_* counters are cumulative. verif/lib/systolic_spad_model.cpp
+ * models them (and the resulting job period) from the job addresses.
+ */
+module systolic_tile #(
+    parameter ROWS = 2,
+    parameter COLS = 2,
+    parameter WIDTH = 4,
+    parameter ACC_WIDTH = 9,
+    parameter MUL_LATENCY = 0,
+    parameter ADD_LATENCY = 1,
+    parameter MULTI_PRECISION = 0,
+    parameter MUL_STAGED = 0,
+    parameter NUM_BANKS = 4,
+    parameter AB_HALF_DEPTH = 64,
+    parameter C_HALF_DEPTH = 64,
+    parameter JOBS_IN_FLIGHT = 8,
+    parameter AB_OFFSET_WIDTH = $clog2(AB_HALF_DEPTH),
+    parameter C_OFFSET_WIDTH = $clog2(C_HALF_DEPTH)
+) (
+    input  wire                       clk,
+    input  wire                       rst_n,
+    // Host AB tile writes (into the fill half, one word per cycle)
+    input  wire                       wr_valid,
+    input  wire [AB_OFFSET_WIDTH-1:0] wr_addr,
+    input  wire [WIDTH-1:0]           wr_data,
+    output wire                       wr_ready,
+    output reg                        fill_half,
+    // Job submission
+    input  wire                       job_valid,
+    output wire                       job_ready,
+    input  wire [AB_OFFSET_WIDTH-1:0] job_a_base,
+    input  wire [AB_OFFSET_WIDTH-1:0] job_a_stride,
+    input  wire [AB_OFFSET_WIDTH-1:0] job_b_base,
+    input  wire [AB_OFFSET_WIDTH-1:0] job_b_stride,
+    input  wire [C_OFFSET_WIDTH-1:0]  job_c_base,
+    input  wire [C_OFFSET_WIDTH-1:0]  job_c_stride,
+    input  wire [1:0]                 job_prec,
+    input  wire                       job_lane_sum,
+    // Job completion (C tile written)
+    output reg                        done,
+    output reg                        done_half,
+    // Host C reads ({half, offset})
+    input  wire                       c_rd_valid,
+    input  wire [C_OFFSET_WIDTH:0]    c_rd_addr,
+    output wire [ACC_WIDTH-1:0]       c_rd_data,
+    output wire                       c_rd_data_valid,
+    // Performance counters
+    output reg  [31:0]                perf_jobs,
+    output reg  [31:0]                perf_fetch_cycles,    // Cycles with AB reads granted
+    output reg  [31:0]                perf_fetch_conflicts, // ... of them cut short by a bank conflict
+    output reg  [31:0]                perf_wb_cycles,       // Cycles with C writes granted
+    output reg  [31:0]                perf_wb_conflicts,
+    output reg  [31:0]                perf_issue_stalls     // Cycles a fetched job waited for the controller
+);
+
+    localparam AB_AW = AB_OFFSET_WIDTH + 1;
+    localparam C_AW = C_OFFSET_WIDTH + 1;
+    localparam A_IDX = $clog2(ROWS*ROWS + NUM_BANKS + 1);
+    localparam B_IDX = $clog2(ROWS*COLS + NUM_BANKS + 1);
+    localparam IDX = (A_IDX > B_IDX) ? A_IDX : B_IDX;
+    localparam TAG_BITS = 1 + 2*C_OFFSET_WIDTH;
+
+    //-------------------------------------------------------------------------
+    // Job submission (one pending job per half)
+    //-------------------------------------------------------------------------
+    reg [1:0] job_pending;
+    reg [AB_OFFSET_WIDTH-1:0] cfg_a_base [1:0];
+    reg [AB_OFFSET_WIDTH-1:0] cfg_a_stride [1:0];
+    reg [AB_OFFSET_WIDTH-1:0] cfg_b_base [1:0];
+    reg [AB_OFFSET_WIDTH-1:0] cfg_b_stride [1:0];
+    reg [C_OFFSET_WIDTH-1:0]  cfg_c_base [1:0];
+    reg [C_OFFSET_WIDTH-1:0]  cfg_c_stride [1:0];
+    reg [1:0]                 cfg_prec [1:0];
+    reg                       cfg_lane_sum [1:0];
+
+    // The fill half is free once the fetch of its previous job has finished
+    assign wr_ready = !job_pending[fill_half];
+    assign job_ready = !job_pending[fill_half];
+    wire job_accept = job_valid && job_ready;
+    wire fetch_release;  // Fetch of the job on fetch_half has finished
+    reg  fetch_half;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            fill_half <= 1'b0;
+            job_pending <= 2'b00;
+        end else begin
+            if (job_accept) begin
+                job_pending[fill_half] <= 1'b1;
+                cfg_a_base[fill_half] <= job_a_base;
+                cfg_a_stride[fill_half] <= job_a_stride;
+                cfg_b_base[fill_half] <= job_b_base;
+                cfg_b_stride[fill_half] <= job_b_stride;
+                cfg_c_base[fill_half] <= job_c_base;
+                cfg_c_stride[fill_half] <= job_c_stride;
+                cfg_prec[fill_half] <= job_prec;
+                cfg_lane_sum[fill_half] <= job_lane_sum;
+                fill_half <= !fill_half;
+            end
+            if (fetch_release) begin
+                job_pending[fetch_half] <= 1'b0;
+            end
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // AB scratchpad
+    //-------------------------------------------------------------------------
+    wire [NUM_BANKS-1:0]          ab_rd_req;
+    wire [NUM_BANKS*AB_AW-1:0]    ab_rd_addr;
+    wire [NUM_BANKS-1:0]          ab_rd_grant;
+    wire                          ab_rd_conflict;
+    wire [NUM_BANKS*WIDTH-1:0]    ab_rd_data;
+    wire [NUM_BANKS-1:0]          ab_rd_data_valid;
+    wire [NUM_BANKS-1:0]          ab_wr_grant;
+    wire                          ab_wr_conflict;
+
+    // Host writes use lane 0 (zero-extended to all lanes)
+    wire [NUM_BANKS-1:0]          ab_wr_req = wr_valid && wr_ready;
+    wire [NUM_BANKS*AB_AW-1:0]    ab_wr_addr = {fill_half, wr_addr};
+    wire [NUM_BANKS*WIDTH-1:0]    ab_wr_data = wr_data;
+
+    spad #(
+        .DATA_WIDTH(WIDTH),
+        .DEPTH(2*AB_HALF_DEPTH),
+        .NUM_BANKS(NUM_BANKS)
+    ) ab_spad (
+        .clk(clk), .rst_n(rst_n),
+        .wr_req(ab_wr_req), .wr_addr(ab_wr_addr), .wr_data(ab_wr_data),
+        .wr_grant(ab_wr_grant), .wr_conflict(ab_wr_conflict),
+        .rd_req(ab_rd_req), .rd_addr(ab_rd_addr),
+        .rd_grant(ab_rd_grant), .rd_conflict(ab_rd_conflict),
+        .rd_data(ab_rd_data), .rd_data_valid(ab_rd_data_valid)
+    );
+
+    //-------------------------------------------------------------------------
+    // Fetch engine
+    //-------------------------------------------------------------------------
+    localparam F_IDLE    = 3'd0;
+    localparam F_A       = 3'd1;
+    localparam F_B       = 3'd2;
+    localparam F_DRAIN   = 3'd3; // Last read data returns
+    localparam F_PRESENT = 3'd4; // Hand the job to the controller
+
+    reg [2:0] f_state;
+    reg [ROWS*ROWS*WIDTH-1:0] stage_a;
+    reg [ROWS*COLS*WIDTH-1:0] stage_b;
+    reg [1:0] stage_prec;
+    reg stage_lane_sum;
+    reg [TAG_BITS-1:0] stage_tag;
+
+    wire [NUM_BANKS-1:0] a_req, b_req;
+    wire [NUM_BANKS*AB_OFFSET_WIDTH-1:0] a_addr, b_addr;
+    wire [NUM_BANKS*A_IDX-1:0] a_idx;
+    wire [NUM_BANKS*B_IDX-1:0] b_idx;
+    wire a_busy, b_busy, a_done, b_done;
+
+    tile_agu #(
+        .TILE_ROWS(ROWS), .TILE_COLS(ROWS), .LANES(NUM_BANKS),
+        .ADDR_WIDTH(AB_OFFSET_WIDTH), .IDX_WIDTH(A_IDX)
+    ) a_agu (
+        .clk(clk), .rst_n(rst_n),
+        .start(f_state == F_IDLE && job_pending[fetch_half]),
+        .base(cfg_a_base[fetch_half]), .stride(cfg_a_stride[fetch_half]),
+        .busy(a_busy), .req(a_req), .addr(a_addr), .idx(a_idx),
+        .grant(ab_rd_grant), .done(a_done)
+    );
+
+    tile_agu #(
+        .TILE_ROWS(ROWS), .TILE_COLS(COLS), .LANES(NUM_BANKS),
+        .ADDR_WIDTH(AB_OFFSET_WIDTH), .IDX_WIDTH(B_IDX)
+    ) b_agu (
+        .clk(clk), .rst_n(rst_n),
+        .start(a_done),
+        .base(cfg_b_base[fetch_half]), .stride(cfg_b_stride[fetch_half]),
+        .busy(b_busy), .req(b_req), .addr(b_addr), .idx(b_idx),
+        .grant(ab_rd_grant), .done(b_done)
+    );
+
+    // One AGU owns the read port at a time (A, then B)
+    genvar n;
+    generate
+        for (n = 0; n < NUM_BANKS; n = n + 1) begin : rd_lane
+            assign ab_rd_req[n] = a_busy ? a_req[n] : b_req[n];
+            assign ab_rd_addr[n*AB_AW +: AB_AW] = {fetch_half, a_busy ? a_addr[n*AB_OFFSET_WIDTH +: AB_OFFSET_WIDTH]
+                                                                      : b_addr[n*AB_OFFSET_WIDTH +: AB_OFFSET_WIDTH]};
+        end
+    endgenerate
+
+    assign fetch_release = b_done;
+
+    // Read data lands one cycle after the grant
+    reg [NUM_BANKS*IDX-1:0] rd_idx_q;
+    reg rd_is_b_q;
+    integer k, kd, kw;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            rd_idx_q <= 0;
+            rd_is_b_q <= 1'b0;
+        end else begin
+            rd_is_b_q <= !a_busy;
+            for (k = 0; k < NUM_BANKS; k = k + 1) begin
+                rd_idx_q[k*IDX +: IDX] <= a_busy ? a_idx[k*A_IDX +: A_IDX] : b_idx[k*B_IDX +: B_IDX];
+            end
+        end
+    end
+
+    always @(posedge clk) begin
+        for (kd = 0; kd < NUM_BANKS; kd = kd + 1) begin
+            if (ab_rd_data_valid[kd]) begin
+                if (rd_is_b_q)
+                    stage_b[rd_idx_q[kd*IDX +: IDX]*WIDTH +: WIDTH] <= ab_rd_data[kd*WIDTH +: WIDTH];
+                else
+                    stage_a[rd_idx_q[kd*IDX +: IDX]*WIDTH +: WIDTH] <= ab_rd_data[kd*WIDTH +: WIDTH];
+            end
+        end
+    end
+
+    // Controller handshake. systolic takes the ungated request as in_valid
+    // (its PERF_STALL counts the cycles it is not ready for it), sys_in_valid
+    // is the accepted job.
+    wire sys_in_ready;
+    wire sys_in_request;
+    wire sys_in_valid;
+    reg [$clog2(JOBS_IN_FLIGHT+1)-1:0] in_flight;
+    wire wb_release;  // A result left the result buffer
+
+    assign sys_in_request = (f_state == F_PRESENT) && (in_flight < JOBS_IN_FLIGHT);
+    assign sys_in_valid = sys_in_request && sys_in_ready;
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            f_state <= F_IDLE;
+            fetch_half <= 1'b0;
+            stage_prec <= 2'd0;
+            stage_lane_sum <= 1'b0;
+            stage_tag <= {TAG_BITS{1'b0}};
+            in_flight <= 0;
+        end else begin
+            case (f_state)
+                F_IDLE: begin
+                    if (job_pending[fetch_half]) begin
+                        f_state <= F_A;
+                        stage_prec <= cfg_prec[fetch_half];
+                        stage_lane_sum <= cfg_lane_sum[fetch_half];
+                        stage_tag <= {fetch_half, cfg_c_base[fetch_half], cfg_c_stride[fetch_half]};
+                    end
+                end
+                F_A:       if (a_done) f_state <= F_B;
+                F_B:       if (b_done) f_state <= F_DRAIN;
+                F_DRAIN:   f_state <= F_PRESENT;
+                F_PRESENT: begin
+                    if (sys_in_valid) begin
+                        f_state <= F_IDLE;
+                        fetch_half <= !fetch_half;
+                    end
+                end
+                default:   f_state <= F_IDLE;
+            endcase
+
+            in_flight <= in_flight + sys_in_valid - wb_release;
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Systolic block
+    //-------------------------------------------------------------------------
+    wire [ROWS*COLS*ACC_WIDTH-1:0] sys_c;
+    wire sys_out_valid;
+
+    systolic #(
+        .ROWS(ROWS),
+        .COLS(COLS),
+        .WIDTH(WIDTH),
+        .ACC_WIDTH(ACC_WIDTH),
+        .MUL_LATENCY(MUL_LATENCY),
+        .ADD_LATENCY(ADD_LATENCY),
+        .MULTI_PRECISION(MULTI_PRECISION),
+        .MUL_STAGED(MUL_STAGED)
+    ) sys (
+        .clk(clk), .rst_n(rst_n),
+        .a(stage_a),
+        .b(stage_b),
+        .prec(stage_prec),
+        .lane_sum(stage_lane_sum),
+        .in_tag(1'b0),
+        .in_valid(sys_in_request),
+        .in_ready(sys_in_ready),
+        .c(sys_c),
+        .out_valid(sys_out_valid),
+        .out_tag(),
+        // Whole-array jobs only
+        .part_mode(1'b0),
+        .part_active(),
+        .part_a({(ROWS*ROWS*WIDTH){1'b0}}),
+        .part_b({(ROWS*COLS*WIDTH){1'b0}}),
+        .part_prec(2'd0),
+        .part_lane_sum(1'b0),
+        .part_in_tag(1'b0),
+        .part_in_valid(1'b0),
+        .part_in_ready(),
+        .part_c(),
+        .part_out_valid(),
+        .part_out_tag(),
+        // Counter CSRs not used here
+        .csr_addr('0),
+        .csr_wr(1'b0),
+        .csr_wdata(32'd0),
+        .csr_rdata()
+    );
+
+    //-------------------------------------------------------------------------
+    // Result buffer and tags (in job order)
+    //-------------------------------------------------------------------------
+    wire [TAG_BITS-1:0] tag_head;
+    wire [ROWS*COLS*ACC_WIDTH-1:0] c_head;
+    wire tag_full, tag_empty, res_full, res_empty;
+
+    fifo1 #(
+        .WIDTH(TAG_BITS),
+        .DEPTH(JOBS_IN_FLIGHT)
+    ) tag_fifo (
+        .clk(clk), .rst_n(rst_n),
+        .push(sys_in_valid), .pop(wb_release),
+        .d_in(stage_tag), .d_out(tag_head),
+        .full(tag_full), .empty(tag_empty)
+    );
+
+    fifo1 #(
+        .WIDTH(ROWS*COLS*ACC_WIDTH),
+        .DEPTH(JOBS_IN_FLIGHT)
+    ) res_fifo (
+        .clk(clk), .rst_n(rst_n),
+        .push(sys_out_valid), .pop(wb_release),
+        .d_in(sys_c), .d_out(c_head),
+        .full(res_full), .empty(res_empty)
+    );
+
+    wire                      head_half = tag_head[TAG_BITS-1];
+    wire [C_OFFSET_WIDTH-1:0] head_c_base = tag_head[2*C_OFFSET_WIDTH-1:C_OFFSET_WIDTH];
+    wire [C_OFFSET_WIDTH-1:0] head_c_stride = tag_head[C_OFFSET_WIDTH-1:0];
+
+    //-------------------------------------------------------------------------
+    // Writeback engine and C scratchpad
+    //-------------------------------------------------------------------------
+    localparam C_IDX = $clog2(ROWS*COLS + NUM_BANKS + 1);
+
+    reg wb_active;
+    wire [NUM_BANKS-1:0] c_req;
+    wire [NUM_BANKS*C_OFFSET_WIDTH-1:0] c_addr;
+    wire [NUM_BANKS*C_IDX-1:0] c_idx;
+    wire [NUM_BANKS-1:0] c_wr_grant;
+    wire c_wr_conflict;
+    wire c_busy, c_done;
+    wire [NUM_BANKS*C_AW-1:0] c_wr_addr;
+    reg  [NUM_BANKS*ACC_WIDTH-1:0] c_wr_data;
+    wire [NUM_BANKS*ACC_WIDTH-1:0] c_rd_lanes;
+    wire [NUM_BANKS-1:0] c_rd_lanes_valid;
+    wire [NUM_BANKS-1:0] c_rd_req = c_rd_valid;      // Host reads use lane 0
+    wire [NUM_BANKS*C_AW-1:0] c_rd_lane_addr = c_rd_addr;
+
+    tile_agu #(
+        .TILE_ROWS(ROWS), .TILE_COLS(COLS), .LANES(NUM_BANKS),
+        .ADDR_WIDTH(C_OFFSET_WIDTH), .IDX_WIDTH(C_IDX)
+    ) c_agu (
+        .clk(clk), .rst_n(rst_n),
+        .start(!wb_active && !res_empty),
+        .base(head_c_base), .stride(head_c_stride),
+        .busy(c_busy), .req(c_req), .addr(c_addr), .idx(c_idx),
+        .grant(c_wr_grant), .done(c_done)
+    );
+
+    generate
+        for (n = 0; n < NUM_BANKS; n = n + 1) begin : wr_lane
+            assign c_wr_addr[n*C_AW +: C_AW] = {head_half, c_addr[n*C_OFFSET_WIDTH +: C_OFFSET_WIDTH]};
+        end
+    endgenerate
+
+    always @(*) begin
+        for (kw = 0; kw < NUM_BANKS; kw = kw + 1) begin
+            c_wr_data[kw*ACC_WIDTH +: ACC_WIDTH] = c_head[c_idx[kw*C_IDX +: C_IDX]*ACC_WIDTH +: ACC_WIDTH];
+        end
+    end
+
+    assign wb_release = c_done;
+
+    spad #(
+        .DATA_WIDTH(ACC_WIDTH),
+        .DEPTH(2*C_HALF_DEPTH),
+        .NUM_BANKS(NUM_BANKS)
+    ) c_spad (
+        .clk(clk), .rst_n(rst_n),
+        .wr_req(c_req), .wr_addr(c_wr_addr), .wr_data(c_wr_data),
+        .wr_grant(c_wr_grant), .wr_conflict(c_wr_conflict),
+        .rd_req(c_rd_req), .rd_addr(c_rd_lane_addr),
+        .rd_grant(), .rd_conflict(),
+        .rd_data(c_rd_lanes), .rd_data_valid(c_rd_lanes_valid)
+    );
+
+    assign c_rd_data = c_rd_lanes[ACC_WIDTH-1:0];
+    assign c_rd_data_valid = c_rd_lanes_valid[0];
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            wb_active <= 1'b0;
+            done <= 1'b0;
+            done_half <= 1'b0;
+        end else begin
+            done <= 1'b0;
+            if (!wb_active && !res_empty) begin
+                wb_active <= 1'b1;
+            end else if (c_done) begin
+                wb_active <= 1'b0;
+                done <= 1'b1;
+                done_half <= head_half;
+            end
+        end
+    end
+
+    //-------------------------------------------------------------------------
+    // Performance counters
+    //-------------------------------------------------------------------------
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            perf_jobs <= 0;
+            perf_fetch_cycles <= 0;
+            perf_fetch_conflicts <= 0;
+            perf_wb_cycles <= 0;
+            perf_wb_conflicts <= 0;
+            perf_issue_stalls <= 0;
+        end else begin
+            perf_jobs <= perf_jobs + c_done;
+            perf_fetch_cycles <= perf_fetch_cycles + (|ab_rd_grant);
+            perf_fetch_conflicts <= perf_fetch_conflicts + ab_rd_conflict;
+            perf_wb_cycles <= perf_wb_cycles + (|c_wr_grant);
+            perf_wb_conflicts <= perf_wb_conflicts + c_wr_conflict;
+            perf_issue_stalls <= perf_issue_stalls + (f_state == F_PRESENT && !sys_in_valid);
+        end
+    end
+
+endmodule
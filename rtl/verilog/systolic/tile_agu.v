@@ -0,0 +1,106 @@
+/*
+ * Tile Address Generator
+ * Walks a TILE_ROWS x TILE_COLS tile stored row-major with a row stride in a
+ * word-addressed memory (element (r, c) at base + r * stride + c, modulo
+ * 2^ADDR_WIDTH) and presents the next LANES elements per cycle to a banked
+ * scratchpad (spad). The granted lanes are a prefix, the generator advances
+ * past them and re-presents the rest in the next cycle.
+ *
+ * idx is the element index (r * TILE_COLS + c) of each lane, i.e. the
+ * position of the element in the flat tile vector.
+ */
+module tile_agu #(
+    parameter TILE_ROWS = 2,
+    parameter TILE_COLS = 2,
+    parameter LANES = 4,
+    parameter ADDR_WIDTH = 8,
+    parameter IDX_WIDTH = $clog2(TILE_ROWS*TILE_COLS + LANES + 1)
+) (
+    input  wire                        clk,
+    input  wire                        rst_n,
+    input  wire                        start,  // Load base / stride and begin (ignored while busy)
+    input  wire [ADDR_WIDTH-1:0]       base,
+    input  wire [ADDR_WIDTH-1:0]       stride, // Words between tile rows
+    output reg                         busy,
+    output reg  [LANES-1:0]            req,
+    output reg  [LANES*ADDR_WIDTH-1:0] addr,
+    output reg  [LANES*IDX_WIDTH-1:0]  idx,
+    input  wire [LANES-1:0]            grant,
+    output wire                        done    // Last element granted this cycle
+);
+
+    localparam TOTAL = TILE_ROWS * TILE_COLS;
+    localparam COL_WIDTH = $clog2(TILE_COLS + 1);
+
+    reg [IDX_WIDTH-1:0]  ptr;       // Element index of lane 0
+    reg [COL_WIDTH-1:0]  col;       // Column of lane 0
+    reg [ADDR_WIDTH-1:0] row_addr;  // Address of column 0 in the row of lane 0
+    reg [ADDR_WIDTH-1:0] stride_q;
+
+    // Position after n elements, n = 0..LANES
+    reg [(LANES+1)*IDX_WIDTH-1:0]  step_ptr;
+    reg [(LANES+1)*COL_WIDTH-1:0]  step_col;
+    reg [(LANES+1)*ADDR_WIDTH-1:0] step_row_addr;
+    reg [IDX_WIDTH-1:0]  e;
+    reg [COL_WIDTH-1:0]  c;
+    reg [ADDR_WIDTH-1:0] ra;
+    integer n, g;
+
+    always @(*) begin
+        e = ptr; c = col; ra = row_addr;
+        for (n = 0; n < LANES; n = n + 1) begin
+            step_ptr[n*IDX_WIDTH +: IDX_WIDTH] = e;
+            step_col[n*COL_WIDTH +: COL_WIDTH] = c;
+            step_row_addr[n*ADDR_WIDTH +: ADDR_WIDTH] = ra;
+            req[n] = busy && (e < TOTAL);
+            addr[n*ADDR_WIDTH +: ADDR_WIDTH] = ra + c;
+            idx[n*IDX_WIDTH +: IDX_WIDTH] = e;
+            // Next element
+            e = e + 1;
+            if (c == TILE_COLS - 1) begin
+                c = 0;
+                ra = ra + stride_q;
+            end else begin
+                c = c + 1;
+            end
+        end
+        step_ptr[LANES*IDX_WIDTH +: IDX_WIDTH] = e;
+        step_col[LANES*COL_WIDTH +: COL_WIDTH] = c;
+        step_row_addr[LANES*ADDR_WIDTH +: ADDR_WIDTH] = ra;
+    end
+
+    // Number of granted lanes (a prefix)
+    reg [$clog2(LANES+1)-1:0] granted;
+    always @(*) begin
+        granted = 0;
+        for (g = 0; g < LANES; g = g + 1) begin
+            if (grant[g] && req[g]) granted = g + 1;
+        end
+    end
+
+    assign done = busy && (step_ptr[granted*IDX_WIDTH +: IDX_WIDTH] == TOTAL);
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            busy <= 1'b0;
+            ptr <= 0;
+            col <= 0;
+            row_addr <= 0;
+            stride_q <= 0;
+        end else if (!busy) begin
+            if (start) begin
+                busy <= 1'b1;
+                ptr <= 0;
+                col <= 0;
+                row_addr <= base;
+                stride_q <= stride;
+            end
+        end else begin
+            ptr <= step_ptr[granted*IDX_WIDTH +: IDX_WIDTH];
+            col <= step_col[granted*COL_WIDTH +: COL_WIDTH];
+            row_addr <= step_row_addr[granted*ADDR_WIDTH +: ADDR_WIDTH];
+            if (done) busy <= 1'b0;
+        end
+    end
+
+endmodule
@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+# scripts/prefix_adder_report.py
+
+"""
+Reports logic depth and node count of the parallel-prefix adder topologies
+generated by fas_vec_prefix (rtl/verilog/lib/adders.v), and checks each
+network exhaustively against integer '+' / '-' at small widths.
+
+The prefix-cell placement rules below mirror the constant function
+prefix_partner() in adders.v one-to-one, so the report and the equivalence
+check describe exactly the networks that the RTL generates.
+
+Usage:
+    scripts/prefix_adder_report.py                    # Report for common mantissa widths
+    scripts/prefix_adder_report.py --widths 11 24 53  # Report for given widths
+    scripts/prefix_adder_report.py --check 8          # Exhaustive check up to 8 bits
+"""
+
+import argparse
+import random
+import sys
+from typing import Callable, Dict, List, Tuple
+
+# Topology encodings, matching rtl/verilog/lib/adders.vh
+ADDER_BEHAVIORAL = 0
+ADDER_KOGGE_STONE = 1
+ADDER_BRENT_KUNG = 2
+ADDER_HAN_CARLSON = 3
+ADDER_SKLANSKY = 4
+
+TOPOLOGIES: Dict[int, str] = {
+    ADDER_KOGGE_STONE: "Kogge-Stone",
+    ADDER_BRENT_KUNG: "Brent-Kung",
+    ADDER_HAN_CARLSON: "Han-Carlson",
+    ADDER_SKLANSKY: "Sklansky",
+}
+
+
+def clog2(value: int) -> int:
+    """Ceiling log2, same as $clog2 (clog2(1) == 0)."""
+    return (value - 1).bit_length() if value > 1 else 0
+
+
+def prefix_levels(topology: int, width: int) -> int:
+    """Number of prefix levels (logic depth in prefix cells), as in adders.v."""
+    lg = clog2(width)
+    if lg == 0:
+        return 0
+    if topology == ADDER_BRENT_KUNG:
+        return 2 * lg - 1
+    if topology == ADDER_HAN_CARLSON:
+        return lg + 1
+    return lg  # Kogge-Stone, Sklansky
+
+
+def prefix_partner(topology: int, width: int, level: int, i: int) -> int:
+    """
+    Index of the lower-significance partner combined into bit i at 'level',
+    or -1 when bit i passes through the level unchanged.
+    """
+    lg = clog2(width)
+    if topology == ADDER_KOGGE_STONE:
+        span = 1 << level
+        return i - span if i >= span else -1
+    if topology == ADDER_SKLANSKY:
+        if (i >> level) & 1:
+            return ((i >> level) << level) - 1
+        return -1
+    if topology == ADDER_BRENT_KUNG:
+        if level < lg:  # Up-sweep: build power-of-two blocks
+            span = 1 << level
+            return i - span if (i + 1) % (2 * span) == 0 else -1
+        k = 2 * lg - 2 - level  # Down-sweep: fill in the remaining positions
+        span = 1 << k
+        if (i + 1) % (2 * span) == span and i + 1 > 2 * span:
+            return i - span
+        return -1
+    if topology == ADDER_HAN_CARLSON:
+        if level == 0:  # Pair up: odd bits take their even neighbour
+            return i - 1 if i % 2 == 1 else -1
+        if level < lg:  # Kogge-Stone among the odd bits
+            span = 1 << level
+            return i - span if (i % 2 == 1 and i - span >= 1) else -1
+        return i - 1 if (i % 2 == 0 and i >= 2) else -1  # Fix up even bits
+    raise ValueError(f"Unknown topology {topology}")
+
+
+def network_stats(topology: int, width: int) -> Tuple[int, int, int, bool]:
+    """
+    Returns (levels, prefix cells, max fan-out, spans_ok) of the generated network.
+
+    spans_ok is a structural proof of correctness at any width: every cell must
+    combine two adjacent bit ranges, and every output must end up covering
+    bits [i:0].
+    """
+    levels = prefix_levels(topology, width)
+    cells = 0
+    max_fanout = 0
+    spans_ok = True
+    lo = list(range(width))  # Bit range [lo[i], i] covered by the group signals of bit i
+    for level in range(levels):
+        fanout: Dict[int, int] = {}
+        new_lo = list(lo)
+        for i in range(width):
+            j = prefix_partner(topology, width, level, i)
+            if j >= 0:
+                cells += 1
+                fanout[j] = fanout.get(j, 0) + 1
+                if j != lo[i] - 1:
+                    spans_ok = False
+                new_lo[i] = lo[j]
+        lo = new_lo
+        if fanout:
+            # +1 for the partner's own pass-through to the next level
+            max_fanout = max(max_fanout, max(fanout.values()) + 1)
+    spans_ok = spans_ok and all(x == 0 for x in lo)
+    return levels, cells, max_fanout, spans_ok
+
+
+def prefix_add(
+    topology: int, width: int, a: int, b: int, cin: int, add_nsub: int
+) -> Tuple[int, int]:
+    """
+    Evaluates the generated prefix network (same ports as fas_vec_prefix).
+    Returns (z, cout); for subtraction cout is the borrow.
+    """
+    mask = (1 << width) - 1
+    b_eff = (b ^ (mask if add_nsub else 0)) & mask
+    c0 = cin ^ add_nsub
+    p = [((a >> i) ^ (b_eff >> i)) & 1 for i in range(width)]
+    g = [((a >> i) & (b_eff >> i)) & 1 for i in range(width)]
+    g[0] = g[0] | (p[0] & c0)  # Fold the carry in into bit 0
+    gg, pp = list(g), list(p)
+    for level in range(prefix_levels(topology, width)):
+        ng, np_ = list(gg), list(pp)
+        for i in range(width):
+            j = prefix_partner(topology, width, level, i)
+            if j >= 0:
+                ng[i] = gg[i] | (pp[i] & gg[j])
+                np_[i] = pp[i] & pp[j]
+        gg, pp = ng, np_
+    carries = [c0] + gg  # carries[i] is the carry into bit i
+    z = 0
+    for i in range(width):
+        z |= (p[i] ^ carries[i]) << i
+    return z, carries[width] ^ add_nsub
+
+
+def reference_add(width: int, a: int, b: int, cin: int, add_nsub: int) -> Tuple[int, int]:
+    """Integer reference for fas_vec_* semantics."""
+    mask = (1 << width) - 1
+    if add_nsub:
+        diff = a - b - cin
+        return diff & mask, int(diff < 0)
+    total = a + b + cin
+    return total & mask, total >> width
+
+
+def check_topology(topology: int, width: int, vectors: Callable[[], List[Tuple[int, int]]]) -> int:
+    """Compares one topology against the reference, returning the error count."""
+    errors = 0
+    for a, b in vectors():
+        for cin in (0, 1):
+            for add_nsub in (0, 1):
+                if prefix_add(topology, width, a, b, cin, add_nsub) != reference_add(
+                    width, a, b, cin, add_nsub
+                ):
+                    errors += 1
+    return errors
+
+
+def main() -> int:
+    """Main entry point."""
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument(
+        "--widths",
+        type=int,
+        nargs="+",
+        # Mantissa datapaths: fp_add (ALIGN_MANT_W), FMA (48/96/212) and fp_mul exponents
+        default=[7, 10, 13, 31, 43, 48, 60, 96, 212],
+        help="Widths to report depth and node count for.",
+    )
+    parser.add_argument(
+        "--check",
+        type=int,
+        default=8,
+        help="Check all widths 1..N exhaustively (default 8).",
+    )
+    parser.add_argument(
+        "--random",
+        type=int,
+        default=2000,
+        help="Random vectors per reported width (default 2000).",
+    )
+    args = parser.parse_args()
+
+    # Depth / node-count report
+    sep = " | "
+    col_widths = [6, 12, 7, 6, 8, 6, 7]
+    headings = ["Width", "Topology", "Levels", "Cells", "Fan-out", "Spans", "Random"]
+    print(sep.join(f"{h:<{col_widths[i]}}" for i, h in enumerate(headings)))
+    print("-" * (sum(col_widths) + len(sep) * (len(col_widths) - 1)))
+    total_errors = 0
+    for width in args.widths:
+        rng = random.Random(width)
+
+        def random_vectors(w: int = width, r: random.Random = rng) -> List[Tuple[int, int]]:
+            return [(r.getrandbits(w), r.getrandbits(w)) for _ in range(args.random)]
+
+        for topology, name in TOPOLOGIES.items():
+            levels, cells, fanout, spans_ok = network_stats(topology, width)
+            errors = check_topology(topology, width, random_vectors)
+            total_errors += errors + (0 if spans_ok else 1)
+            row = [
+                width,
+                name,
+                levels,
+                cells,
+                fanout,
+                "PASS" if spans_ok else "FAIL",
+                "PASS" if errors == 0 else f"FAIL {errors}",
+            ]
+            print(sep.join(f"{str(f):<{col_widths[i]}}" for i, f in enumerate(row)))
+
+    # Exhaustive equivalence at small widths
+    print()
+    for width in range(1, args.check + 1):
+
+        def all_vectors(w: int = width) -> List[Tuple[int, int]]:
+            return [(a, b) for a in range(1 << w) for b in range(1 << w)]
+
+        for topology, name in TOPOLOGIES.items():
+            errors = check_topology(topology, width, all_vectors)
+            total_errors += errors
+            verdict = "PASS" if errors == 0 else "FAIL"
+            print(f"{verdict} : {name:<12} width {width:>2} exhaustive, {errors} errors")
+
+    print()
+    print(f"{'FAIL' if total_errors else 'PASS'} : TOTAL {total_errors} errors")
+    return min(total_errors, 255)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
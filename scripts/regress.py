@@ -0,0 +1,650 @@
+#!/usr/bin/env python3
+# scripts/regress.py
+
+"""
+Runs the DSim regression matrix (DUTS x TESTS x WIDTHS x seeds) in parallel.
+
+Compared to the serial `make -f dsim.mk all`, every artifact is built once and
+shared by the runs that need it:
+
+  - the C model library (dsim.mk C_MODEL_FILES) is compiled once, one job
+    per source (gcc for .c, g++ for .cpp), and linked into a shared library
+    that all simulations load with -sv_lib,
+  - each DUT is compiled once (dvlcom) into its own work library,
+  - each (DUT, WIDTH) is elaborated once into a DSim image (-genimage),
+
+and the simulations then run from that image, each in its own directory, on
+all local cores. A job starts as soon as the artifact it depends on is ready,
+so the wall time is close to that of the longest chain rather than the sum of
+all jobs.
+
+With --pack, the fp_add, fp_mul and fp_classify runs of the same test and
+seed share one simulation of the combined testbench top (verif/tests/fp_multi),
+which is compiled and elaborated once for all three units and widths. Its
+result is reported as DUT fp_multi.
+
+Passing simulations are cached (--cache, build/regress_cache by default),
+keyed by a hash of everything the run depends on: the files of the library
+and DUT filelists (verif/filelist.libs.txt, verif/tests/<DUT>/filelist.txt),
+the testbench sources in the verif include directories, the headers in the
+RTL include directories, the C model sources (--c-model-files), the tools and
+their flags, the width, the plusargs and the seed. A simulation whose key is in the cache is not run; its
+stored log is reused, so it still counts in the results and the merged
+coverage. Only the DUTs whose sources changed are compiled, elaborated and
+simulated again. Failures are never cached, and --force runs everything
+(refreshing the cache).
+
+When everything has finished, the script writes into the output directory:
+
+  results.csv   - dut,width,test,seed,result,seconds for every simulation
+  coverage.txt  - scoreboard bins (rounding mode x operand classes) merged
+                  over all runs of each (DUT, WIDTH), see base_scoreboard
+  failures.log  - the first error lines of each failing job and its log path
+
+and prints the same summary table as `make -f dsim.mk results`. The exit code
+is non-zero if any job failed.
+
+Usage:
+    scripts/regress.py                                   # Default matrix of dsim.mk
+    scripts/regress.py --duts fp_add fp_mul --widths 32 --seeds 8
+    scripts/regress.py --tests random_test --seed-list 1 2 3 -j 4
+    scripts/regress.py --plusargs "+SB_VERBOSE" --dry-run
+    scripts/regress.py --pack --seeds 4
+    scripts/regress.py --force                           # Ignore cached results
+"""
+
+import argparse
+import concurrent.futures as cf
+import csv
+import hashlib
+import json
+import os
+import re
+import shlex
+import shutil
+import subprocess
+import sys
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+project_root = Path(__file__).resolve().parent.parent
+
+
+def dsim_mk_var(name: str) -> List[str]:
+    """
+    Value of a "NAME ?= ..." variable of dsim.mk, split into words, so the
+    defaults below are not restated here.
+    """
+    with (project_root / "dsim.mk").open("r", encoding="utf-8") as f:
+        text = f.read().replace("\\\n", " ").replace("\\\r\n", " ")
+    m = re.search(rf"^{name}\s*\?=(.*)$", text, re.MULTILINE)
+    if not m:
+        raise SystemExit(f"Error: {name} not found in dsim.mk")
+    return m.group(1).split()
+
+
+# Defaults of dsim.mk (overridden on the command line by `make -f dsim.mk regress`)
+DEFAULT_DUTS = dsim_mk_var("DUTS")
+DEFAULT_TESTS = dsim_mk_var("TESTS")
+DEFAULT_WIDTHS = [int(width) for width in dsim_mk_var("WIDTHS")]
+SRC_FILES_LIST = dsim_mk_var("SRC_FILES_LIST")[0]
+C_MODEL_FILES = dsim_mk_var("C_MODEL_FILES")
+# Units of the combined testbench top (--pack)
+MULTI_DUTS = ["fp_add", "fp_mul", "fp_classify"]
+MULTI_WIDTHS = [16, 32, 64]
+COMPILER_FLAGS = [
+    "-uvm", "1.2",
+    "+incdir+rtl/verilog/fp",
+    "+incdir+rtl/verilog/systolic",
+    "+incdir+rtl/verilog/lib",
+    "+incdir+verif/lib",
+]
+# Cache key sources: everything in the verif include directories, the headers
+# of the RTL ones
+VERIF_SOURCES = ("*.sv", "*.svh", "*.vh", "*.h")
+RTL_HEADERS = ("*.vh", "*.svh")
+ELAB_FLAGS = ["-uvm", "1.2", "+acc+b", "-suppress", "IneffectiveDynamicCast:UninstVif"]
+
+# Same pass / fail criterion as dsim.mk
+ERROR_SUMMARY = re.compile(r"UVM_(ERROR|FATAL)\s+:\s+([0-9]+)")
+ERROR_LINE = re.compile(r"^(UVM_ERROR|UVM_FATAL|Error|\*E|FAIL :)")
+# Verdict of the non-UVM testbench tops (e.g. fp_softmax), as checked by dsim.mk
+FAIL_LINE = re.compile(r"^FAIL :")
+# Bin lines of the base_scoreboard summary: "  <bin> <pass> <fail>"
+SUMMARY_HEADER = re.compile(r"SCOREBOARD.*Summary (.+?): [0-9]+ transactions")
+SUMMARY_BIN = re.compile(r"^\s+(\S+)\s+([0-9]+)\s+([0-9]+)\s*$")
+MAX_ERROR_LINES = 10
+
+
+@dataclass
+class Job:
+    """One step of the regression: a command run in a directory, with a log."""
+
+    name: str
+    cmd: List[str]
+    cwd: Path
+    log: Path
+    deps: List["Job"] = field(default_factory=list)
+    dut: str = ""
+    width: int = 0
+    test: str = ""
+    seed: Optional[int] = None
+    result: str = ""
+    seconds: float = 0.0
+    key: str = ""
+    cached: bool = False
+
+
+def dsim_home() -> Optional[Path]:
+    """DSim installation directory, from DSIM_HOME or the dsim executable."""
+    if os.environ.get("DSIM_HOME"):
+        return Path(os.environ["DSIM_HOME"])
+    exe = shutil.which("dsim")
+    return Path(exe).resolve().parent.parent if exe else None
+
+
+def build_jobs(args: argparse.Namespace) -> Tuple[List[Job], List[Job]]:
+    """
+    Builds the job graph.
+
+    Args:
+        args (argparse.Namespace): Parsed command line arguments.
+
+    Returns:
+        Tuple[List[Job], List[Job]]: All jobs in dependency order, and the simulation jobs.
+    """
+    out = args.out.resolve()
+    jobs: List[Job] = []
+    sims: List[Job] = []
+
+    home = dsim_home()
+    include = [f"-I{home / 'include'}"] if home else []
+    model_lib = out / "lib" / "libfp_model.so"
+    objects: List[Job] = []
+    object_files: List[str] = []
+    for source in args.c_model_files:
+        obj = out / "lib" / "obj" / Path(source).with_suffix(".o").name
+        object_files.append(str(obj))
+        compiler = [args.cxx, "-std=c++17"] if Path(source).suffix == ".cpp" else [args.cc]
+        objects.append(Job(
+            name=f"cc {Path(source).name}",
+            cmd=[*compiler, "-O2", "-fPIC", *include, "-c", "-o", str(obj), source],
+            cwd=project_root,
+            log=obj.with_suffix(".log"),
+        ))
+    jobs += objects
+    # Linked by the C++ driver so that the C++ models pull in libstdc++
+    model = Job(
+        name="model",
+        cmd=[args.cxx, "-shared", "-o", str(model_lib),
+             *object_files, "-lm"],
+        cwd=project_root,
+        log=out / "lib" / "model.log",
+        deps=objects,
+    )
+    jobs.append(model)
+
+    seeds = args.seed_list if args.seed_list else list(range(1, args.seeds + 1))
+    duts = args.duts
+    if args.pack:
+        packed = [dut for dut in duts if dut in MULTI_DUTS]
+        duts = [dut for dut in duts if dut not in MULTI_DUTS]
+        if packed:
+            sims += build_packed_jobs(args, packed, seeds, model, model_lib, jobs)
+    for dut in duts:
+        work = out / dut / "dsim_work"
+        compile_job = Job(
+            name=f"compile {dut}",
+            cmd=[args.compiler, "-lib", "work", "-work", str(work), *COMPILER_FLAGS,
+                 f"+incdir+verif/tests/{dut}",
+                 "-F", SRC_FILES_LIST, "-F", f"verif/tests/{dut}/filelist.txt"],
+            cwd=project_root,
+            log=out / dut / "compile.log",
+            dut=dut,
+        )
+        jobs.append(compile_job)
+        for width in args.widths:
+            image = f"{dut}_{width}"
+            elab = Job(
+                name=f"elab {dut} {width}",
+                cmd=[args.simulator, "-work", str(work), "-top", f"work.{dut}_tb_top",
+                     *ELAB_FLAGS, "-defparam", f"WIDTH={width}", "-genimage", image],
+                cwd=out / dut,
+                log=out / dut / f"elab_{width}.log",
+                deps=[compile_job],
+                dut=dut,
+                width=width,
+            )
+            jobs.append(elab)
+            # A non-UVM top ignores the test name, so it runs once per seed
+            tests = [test for test in args.tests if has_test(dut, test)] if is_uvm_top(dut) else args.tests[:1]
+            for test in tests:
+                for seed in seeds:
+                    run_dir = out / dut / f"{width}_{test}_{seed}"
+                    sim = Job(
+                        name=f"run {dut} {width} {test} {seed}",
+                        cmd=[args.simulator, "-work", str(work), "-image", image,
+                             "-sv_lib", str(model_lib.with_suffix("")), "-sv_seed", str(seed),
+                             f"+UVM_TESTNAME={dut}_{test}", *shlex.split(args.plusargs)],
+                        cwd=run_dir,
+                        log=run_dir / "sim.log",
+                        deps=[model, elab],
+                        dut=dut,
+                        width=width,
+                        test=test,
+                        seed=seed,
+                    )
+                    jobs.append(sim)
+                    sims.append(sim)
+    return jobs, sims
+
+
+def has_test(dut: str, test: str) -> bool:
+    """Whether the DUT has the test (e.g. fp_classify has no burst_test)."""
+    return (project_root / "verif" / "tests" / dut / f"{dut}_{test}.sv").is_file()
+
+
+def is_uvm_top(dut: str) -> bool:
+    """Whether the DUT has UVM tests, as opposed to a self-checking top such as fp_softmax."""
+    return any((project_root / "verif" / "tests" / dut).glob(f"{dut}_*_test.sv"))
+
+
+def build_packed_jobs(args: argparse.Namespace, duts: List[str], seeds: List[int],
+                      model: Job, model_lib: Path, jobs: List[Job]) -> List[Job]:
+    """
+    Adds the jobs of the combined testbench top: one compile, one elaboration
+    and, per test and seed, one simulation of every selected (DUT, WIDTH).
+
+    Returns:
+        List[Job]: The simulation jobs.
+    """
+    out = args.out.resolve()
+    dut = "fp_multi"
+    work = out / dut / "dsim_work"
+    compile_job = Job(
+        name=f"compile {dut}",
+        cmd=[args.compiler, "-lib", "work", "-work", str(work), *COMPILER_FLAGS,
+             f"+incdir+verif/tests/{dut}",
+             "-F", SRC_FILES_LIST, "-F", f"verif/tests/{dut}/filelist.txt"],
+        cwd=project_root,
+        log=out / dut / "compile.log",
+        dut=dut,
+    )
+    elab = Job(
+        name=f"elab {dut}",
+        cmd=[args.simulator, "-work", str(work), "-top", f"work.{dut}_tb_top",
+             *ELAB_FLAGS, "-genimage", dut],
+        cwd=out / dut,
+        log=out / dut / "elab.log",
+        deps=[compile_job],
+        dut=dut,
+    )
+    jobs += [compile_job, elab]
+
+    sims = []
+    widths = [width for width in args.widths if width in MULTI_WIDTHS]
+    for test in args.tests:
+        units = [f"{d}:{w}:{test}" for d in duts if has_test(d, test) for w in widths]
+        if not units:
+            continue
+        for seed in seeds:
+            run_dir = out / dut / f"{test}_{seed}"
+            sim = Job(
+                name=f"run {dut} {test} {seed}",
+                cmd=[args.simulator, "-work", str(work), "-image", dut,
+                     "-sv_lib", str(model_lib.with_suffix("")), "-sv_seed", str(seed),
+                     "+UVM_TESTNAME=fp_multi_test", f"+FP_MULTI={','.join(units)}",
+                     *shlex.split(args.plusargs)],
+                cwd=run_dir,
+                log=run_dir / "sim.log",
+                deps=[model, elab],
+                dut=dut,
+                test=test,
+                seed=seed,
+            )
+            jobs.append(sim)
+            sims.append(sim)
+    return sims
+
+
+def filelist_sources(filelist: Path) -> Tuple[List[Path], List[Path]]:
+    """
+    Reads a DSim filelist.
+
+    Returns:
+        Tuple[List[Path], List[Path]]: Source files and +incdir+ directories,
+        resolved relative to the filelist.
+    """
+    files: List[Path] = []
+    incdirs: List[Path] = []
+    with filelist.open("r", encoding="utf-8") as f:
+        for line in f:
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            if line.startswith("+incdir+"):
+                incdirs.append((filelist.parent / line[len("+incdir+"):]).resolve())
+            else:
+                files.append((filelist.parent / line).resolve())
+    return files, incdirs
+
+
+def cache_sources(dut: str, c_model_files: List[str]) -> List[Path]:
+    """
+    Every file a simulation of the DUT depends on: the files of its filelists,
+    all testbench sources of the verif include directories (packages `include
+    them), the headers of the RTL include directories and the C model sources
+    the library is built from (--c-model-files).
+    """
+    incdirs = [project_root / arg[len("+incdir+"):] for arg in COMPILER_FLAGS if arg.startswith("+incdir+")]
+    incdirs.append(project_root / "verif" / "tests" / dut)
+    files = [project_root / path for path in c_model_files]
+    for filelist in (project_root / SRC_FILES_LIST, project_root / "verif" / "tests" / dut / "filelist.txt"):
+        listed, listed_incdirs = filelist_sources(filelist)
+        files += [filelist, *listed]
+        incdirs += listed_incdirs
+    verif = (project_root / "verif").resolve()
+    for incdir in incdirs:
+        incdir = incdir.resolve()
+        patterns = VERIF_SOURCES if verif in (incdir, *incdir.parents) else RTL_HEADERS
+        for pattern in patterns:
+            files += incdir.glob(pattern)
+    return sorted(set(path.resolve() for path in files))
+
+
+def sim_key(sim: Job, args: argparse.Namespace, digests: Dict[Path, str]) -> str:
+    """
+    Cache key of a simulation: hash of its sources (see cache_sources), the
+    tools and their flags, the width, the plusargs and the seed.
+    """
+    h = hashlib.sha256()
+    for path in cache_sources(sim.dut, args.c_model_files):
+        if path not in digests:
+            digests[path] = hashlib.sha256(path.read_bytes()).hexdigest() if path.is_file() else "missing"
+        h.update(f"{path.relative_to(project_root)} {digests[path]}\n".encode())
+    plusargs = [arg for arg in sim.cmd if arg.startswith("+")]
+    config = [sim.cmd[0], args.cc, args.cxx, *COMPILER_FLAGS, *ELAB_FLAGS, sim.dut, sim.width, sim.test, sim.seed, *plusargs]
+    h.update(json.dumps(config).encode())
+    return h.hexdigest()
+
+
+def apply_cache(jobs: List[Job], sims: List[Job], args: argparse.Namespace, cache: Path) -> List[Job]:
+    """
+    Marks the simulations found in the cache as passed and drops the build
+    jobs no remaining simulation needs. The stored logs are restored by
+    restore_cache().
+
+    Returns:
+        List[Job]: The jobs left to run.
+    """
+    digests: Dict[Path, str] = {}
+    for sim in sims:
+        sim.key = sim_key(sim, args, digests)
+        entry = cache / sim.key
+        if args.force or not (entry / "result.json").is_file():
+            continue
+        stored = json.loads((entry / "result.json").read_text(encoding="utf-8"))
+        sim.result = "PASS"
+        sim.seconds = stored["seconds"]
+        sim.cached = True
+
+    needed = set()
+    stack = [sim for sim in sims if not sim.cached]
+    while stack:
+        job = stack.pop()
+        if id(job) not in needed:
+            needed.add(id(job))
+            stack += job.deps
+    return [job for job in jobs if id(job) in needed]
+
+
+def restore_cache(sims: List[Job], cache: Path) -> None:
+    """Copies the stored logs of the cached simulations to their run directories."""
+    for sim in sims:
+        if sim.cached:
+            sim.log.parent.mkdir(parents=True, exist_ok=True)
+            shutil.copyfile(cache / sim.key / "sim.log", sim.log)
+
+
+def store_cache(sims: List[Job], cache: Path) -> int:
+    """
+    Stores the log and time of every simulation that ran and passed.
+
+    Returns:
+        int: Number of stored simulations.
+    """
+    stored = 0
+    for sim in sims:
+        if sim.cached or sim.result != "PASS" or not sim.key:
+            continue
+        entry = cache / sim.key
+        entry.mkdir(parents=True, exist_ok=True)
+        shutil.copyfile(sim.log, entry / "sim.log")
+        result = {"dut": sim.dut, "width": sim.width, "test": sim.test, "seed": sim.seed,
+                  "seconds": sim.seconds}
+        (entry / "result.json").write_text(json.dumps(result, indent=2), encoding="utf-8")
+        stored += 1
+    return stored
+
+
+def run_job(job: Job) -> Job:
+    """Runs one job, writing its output to job.log, and sets job.result."""
+    job.cwd.mkdir(parents=True, exist_ok=True)
+    job.log.parent.mkdir(parents=True, exist_ok=True)
+    start = time.monotonic()
+    with job.log.open("w", encoding="utf-8") as log:
+        try:
+            rc = subprocess.run(job.cmd, cwd=job.cwd, stdout=log, stderr=subprocess.STDOUT).returncode
+        except OSError as e:
+            log.write(f"Error: cannot run {job.cmd[0]}: {e}\n")
+            rc = -1
+    job.seconds = time.monotonic() - start
+    if job.seed is None:
+        job.result = "PASS" if rc == 0 else f"FAIL ({job.name.split()[0]})"
+    else:
+        job.result = "PASS" if rc == 0 and sim_passed(job.log) else "FAIL (sim)"
+    return job
+
+
+def sim_passed(log_path: Path) -> bool:
+    """
+    Same criterion as dsim.mk: a simulation that exited cleanly fails only on
+    a non-zero UVM_ERROR / UVM_FATAL count or a "FAIL :" line.
+    """
+    with log_path.open("r", encoding="utf-8", errors="ignore") as f:
+        for line in f:
+            m = ERROR_SUMMARY.search(line)
+            if (m and int(m.group(2))) or FAIL_LINE.match(line):
+                return False
+    return True
+
+
+def schedule(jobs: List[Job], num_jobs: int) -> None:
+    """
+    Runs the jobs on num_jobs workers, each as soon as all its dependencies
+    passed. Jobs with a failed dependency are marked as skipped.
+    """
+    pending = list(jobs)
+    running: Dict[cf.Future, Job] = {}
+    with cf.ThreadPoolExecutor(max_workers=num_jobs) as pool:
+        while pending or running:
+            for job in list(pending):
+                failed = [dep for dep in job.deps if dep.result.startswith(("FAIL", "SKIP"))]
+                if failed:
+                    job.result = f"SKIP ({failed[0].name})"
+                    pending.remove(job)
+                elif all(dep.result == "PASS" for dep in job.deps):
+                    running[pool.submit(run_job, job)] = job
+                    pending.remove(job)
+            if not running:
+                continue
+            done, _ = cf.wait(running, return_when=cf.FIRST_COMPLETED)
+            for future in done:
+                job = running.pop(future)
+                future.result()
+                print(f"{job.result:<15} {job.name:<45} {job.seconds:8.1f}s", flush=True)
+
+
+def error_lines(log_path: Path) -> List[str]:
+    """First error lines of a log (or its tail if there are none)."""
+    if not log_path.is_file():
+        return []
+    with log_path.open("r", encoding="utf-8", errors="ignore") as f:
+        lines = [line.rstrip() for line in f]
+    errors = [line for line in lines if ERROR_LINE.match(line)]
+    return errors[:MAX_ERROR_LINES] if errors else lines[-MAX_ERROR_LINES:]
+
+
+def merge_coverage(sims: List[Job]) -> Dict[Tuple[str, int, str], Dict[str, List[int]]]:
+    """
+    Sums the base_scoreboard summary bins over all runs.
+
+    Returns:
+        Dict: (dut, width, model) -> bin -> [pass, fail].
+    """
+    merged: Dict[Tuple[str, int, str], Dict[str, List[int]]] = {}
+    for sim in sims:
+        if not sim.log.is_file():
+            continue
+        bins = None
+        with sim.log.open("r", encoding="utf-8", errors="ignore") as f:
+            for line in f:
+                m = SUMMARY_HEADER.search(line)
+                if m:
+                    bins = merged.setdefault((sim.dut, sim.width, m.group(1)), {})
+                    continue
+                m = SUMMARY_BIN.match(line) if bins is not None else None
+                if m and m.group(1) != "BIN":
+                    counts = bins.setdefault(m.group(1), [0, 0])
+                    counts[0] += int(m.group(2))
+                    counts[1] += int(m.group(3))
+                elif not line.strip().startswith("BIN"):
+                    bins = None
+    return merged
+
+
+def write_reports(out: Path, jobs: List[Job], sims: List[Job]) -> int:
+    """
+    Writes results.csv, coverage.txt and failures.log, prints the summary.
+
+    Returns:
+        int: Number of failed (or skipped) jobs.
+    """
+    with (out / "results.csv").open("w", newline="", encoding="utf-8") as f:
+        writer = csv.writer(f)
+        writer.writerow(["dut", "width", "test", "seed", "result", "seconds", "cached"])
+        for sim in sims:
+            writer.writerow([sim.dut, sim.width, sim.test, sim.seed, sim.result, f"{sim.seconds:.1f}",
+                             int(sim.cached)])
+
+    with (out / "coverage.txt").open("w", encoding="utf-8") as f:
+        for (dut, width, model), bins in sorted(merge_coverage(sims).items()):
+            total_pass = sum(c[0] for c in bins.values())
+            total_fail = sum(c[1] for c in bins.values())
+            f.write(f"{dut} WIDTH={width} {model}: {len(bins)} bins hit, "
+                    f"{total_pass} passed, {total_fail} failed\n")
+            f.write(f"  {'BIN':<24} {'PASS':>10} {'FAIL':>10}\n")
+            for name, (num_pass, num_fail) in sorted(bins.items()):
+                f.write(f"  {name:<24} {num_pass:>10} {num_fail:>10}\n")
+
+    failed = [job for job in jobs if job.result != "PASS"]
+    with (out / "failures.log").open("w", encoding="utf-8") as f:
+        for job in failed:
+            f.write(f"=== {job.result} {job.name}\n")
+            f.write(f"    log: {job.log}\n")
+            if job.result.startswith("SKIP"):
+                continue
+            if job.seed is not None and job.dut in ("fp_add", "fp_mul"):
+                f.write(f"    replay: make -f verilator.mk replay DUT={job.dut} WIDTH={job.width} "
+                        f"REPLAY_ARGS=\"--log {job.log}\"\n")
+            for line in error_lines(job.log):
+                f.write(f"    {line}\n")
+
+    print("")
+    print("Simulation Summary")
+    print("=" * 89)
+    print(f"{'RESULT':<15} | {'DUT':<15} | {'WIDTH':<9} | {'TEST':<25} | {'SEED':<6} | {'TIME':>6}")
+    print(f"{'-' * 15} | {'-' * 15} | {'-' * 9} | {'-' * 25} | {'-' * 6} | {'-' * 6}")
+    for sim in sims:
+        result = "PASS (cached)" if sim.cached else sim.result
+        print(f"{result:<15} | {sim.dut:<15} | {sim.width:<9} | {sim.test:<25} | {sim.seed:<6} | {sim.seconds:6.1f}")
+    print("=" * 89)
+    num_fail = sum(1 for sim in sims if sim.result != "PASS")
+    verdict = "FAIL" if failed else "PASS"
+    print(f"{verdict:<15} | Total: {len(sims):<8d} | Pass: {len(sims) - num_fail:<3d} | Fail: {num_fail:<3d}")
+    print("=" * 89)
+    print(f"Results: {out / 'results.csv'}, coverage: {out / 'coverage.txt'}, failures: {out / 'failures.log'}")
+    return len(failed)
+
+
+def parse_args() -> argparse.Namespace:
+    """
+    Parse command line arguments.
+
+    Returns:
+        argparse.Namespace: Parsed command line arguments.
+    """
+    parser = argparse.ArgumentParser(
+        description="Run the DSim regression matrix in parallel with shared compiled artifacts."
+    )
+    parser.add_argument("--duts", nargs="+", default=DEFAULT_DUTS, help="DUTs to run.")
+    parser.add_argument("--tests", nargs="+", default=DEFAULT_TESTS,
+                        help="Tests to run (without the DUT prefix, missing ones are skipped per DUT).")
+    parser.add_argument("--widths", nargs="+", type=int, default=DEFAULT_WIDTHS, help="Widths to run.")
+    parser.add_argument("--seeds", type=int, default=1, help="Number of seeds per test (1..N).")
+    parser.add_argument("--seed-list", nargs="+", type=int, help="Explicit seeds (overrides --seeds).")
+    parser.add_argument("--c-model-files", nargs="+", default=C_MODEL_FILES,
+                        help="C model sources of the DPI-C library (default: dsim.mk C_MODEL_FILES).")
+    parser.add_argument("--plusargs", default="", help="Extra plusargs for every simulation.")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1, help="Parallel jobs.")
+    parser.add_argument("--out", type=Path, default=project_root / "build" / "regress",
+                        help="Output directory (removed first).")
+    parser.add_argument("--compiler", default="dvlcom", help="DSim compiler.")
+    parser.add_argument("--simulator", default="dsim", help="DSim simulator.")
+    parser.add_argument("--cc", default="gcc", help="C compiler for the C sources of the model library.")
+    parser.add_argument("--cxx", default="g++", help="C++ compiler for the C++ sources and the link of the model library.")
+    parser.add_argument("--pack", action="store_true",
+                        help="Run fp_add, fp_mul and fp_classify in one simulation per test and seed.")
+    parser.add_argument("--cache", type=Path, default=project_root / "build" / "regress_cache",
+                        help="Cache of passed simulations.")
+    parser.add_argument("--force", action="store_true", help="Run every simulation, ignoring the cache.")
+    parser.add_argument("--dry-run", action="store_true", help="Print the jobs and exit.")
+    return parser.parse_args()
+
+
+def main() -> None:
+    """Program entry point."""
+    args = parse_args()
+    jobs, sims = build_jobs(args)
+    cache = args.cache.resolve()
+    jobs = apply_cache(jobs, sims, args, cache)
+    num_cached = sum(1 for sim in sims if sim.cached)
+
+    if args.dry_run:
+        print(f"{num_cached} of {len(sims)} simulations cached in {cache}")
+        for job in jobs:
+            deps = ", ".join(dep.name for dep in job.deps)
+            print(f"[{job.name}]{' after ' + deps if deps else ''}\n  cd {job.cwd} && {shlex.join(job.cmd)}")
+        return
+
+    out = args.out.resolve()
+    if out.exists():
+        shutil.rmtree(out)
+    out.mkdir(parents=True)
+    restore_cache(sims, cache)
+
+    start = time.monotonic()
+    print(f"--- Running {len(sims) - num_cached} simulations of DUTS: {args.duts} TESTS: {args.tests} "
+          f"WIDTHS: {args.widths} on {args.jobs} jobs ({num_cached} cached) ---")
+    schedule(jobs, max(1, args.jobs))
+    num_failed = write_reports(out, jobs, sims)
+    print(f"Cached {store_cache(sims, cache)} new passing simulations in {cache}")
+    print(f"Wall time: {time.monotonic() - start:.1f}s, "
+          f"sum of job times: {sum(job.seconds for job in jobs):.1f}s")
+    sys.exit(1 if num_failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,9 +1,20 @@
 // verif/lib/base_scoreboard.sv
 // Generic, reusable scoreboard for comparing transactions.
+//
+// Every transaction is counted per statistics bin of T_TRANS (for
+// fp_transaction: rounding mode x operand classes) and report_phase() prints
+// the counters. Messages are only formatted when they are logged: FAIL always,
+// PASS only at UVM_HIGH, so by default the summary replaces the
+// per-transaction PASS lines. +SB_VERBOSE logs them at UVM_LOW.
+//
+// Predictions are written into one preallocated golden transaction, and the
+// obj_pool statistics of T_TRANS are part of the report.
 
 `include "uvm_macros.svh"
 import uvm_pkg::*;
 
+`uvm_analysis_imp_decl(_batch)
+
 class base_scoreboard #(
     type T_TRANS = uvm_sequence_item,
     type T_MODEL = uvm_object
@@ -11,32 +22,82 @@ class base_scoreboard #(
     `uvm_component_param_utils(base_scoreboard #(T_TRANS, T_MODEL))
 
     uvm_analysis_imp #(T_TRANS, base_scoreboard #(T_TRANS, T_MODEL)) ap;
+    uvm_analysis_imp_batch #(trans_batch #(T_TRANS), base_scoreboard #(T_TRANS, T_MODEL)) batch_ap;  // Burst mode
     T_MODEL model;
+    T_TRANS golden;                    // Reused by every prediction
+
+    bit verbose;                       // +SB_VERBOSE
+    uvm_verbosity pass_verbosity;
+    int unsigned pass_count[];         // Per T_TRANS::stat_bin()
+    int unsigned fail_count[];
 
     function new(string name, uvm_component parent);
         super.new(name, parent);
         ap = new("ap", this);
+        batch_ap = new("batch_ap", this);
     endfunction
 
     function void build_phase(uvm_phase phase);
         super.build_phase(phase);
         if(!uvm_config_db#(T_MODEL)::get(this, "*", "model", model))
             `uvm_fatal("NO_MODEL", "Could not get model handle in scoreboard")
+
+        verbose = $test$plusargs("SB_VERBOSE");
+        pass_verbosity = verbose ? UVM_LOW : UVM_HIGH;
+        pass_count = new[T_TRANS::num_stat_bins()];
+        fail_count = new[T_TRANS::num_stat_bins()];
+        golden = T_TRANS::type_id::create("golden");
     endfunction
 
     virtual function void write(T_TRANS dut_trans);
-        T_TRANS golden_trans;
+        T_TRANS golden_trans = golden;
         bit is_match;
-        string log_message;
+        int bin;
 
         model.predict(dut_trans, golden_trans);
+        golden = golden_trans;  // Models without in-place prediction return a new object
 
         // Delegate comparison to the transaction object itself.
-        log_message = dut_trans.compare(golden_trans, is_match);
+        is_match = dut_trans.matches(golden_trans);
+        bin = dut_trans.stat_bin();
+        if (is_match)
+            pass_count[bin]++;
+        else
+            fail_count[bin]++;
 
+        // `uvm_info evaluates the message (and so compare()) only if pass_verbosity is enabled
         if (is_match)
-            `uvm_info("SCOREBOARD", $sformatf("PASS %s", log_message), UVM_LOW)
+            `uvm_info("SCOREBOARD", $sformatf("PASS %s", dut_trans.compare(golden_trans, is_match)), pass_verbosity)
         else
-            `uvm_error("SCOREBOARD", $sformatf("FAIL %s", log_message))
+            `uvm_error("SCOREBOARD", $sformatf("FAIL %s", dut_trans.compare(golden_trans, is_match)))
+    endfunction
+
+    virtual function void write_batch(trans_batch #(T_TRANS) batch);
+        foreach (batch.items[i]) begin
+            write(batch.items[i]);
+        end
+    endfunction
+
+    // Pass / fail counters of the non-empty bins
+    virtual function void report_phase(uvm_phase phase);
+        int unsigned total_pass, total_fail;
+        string s;
+        string model_report;
+        fp_model_base #(T_TRANS) model_base;
+
+        super.report_phase(phase);
+        foreach (pass_count[i]) begin
+            total_pass += pass_count[i];
+            total_fail += fail_count[i];
+            if (pass_count[i] || fail_count[i])
+                s = {s, $sformatf("\n  %-24s %10d %10d", T_TRANS::stat_bin_name(i), pass_count[i], fail_count[i])};
+        end
+        `uvm_info("SCOREBOARD", $sformatf("Summary %s: %0d transactions, %0d passed, %0d failed\n  %-24s %10s %10s%s",
+            $typename(T_MODEL), total_pass + total_fail, total_pass, total_fail, "BIN", "PASS", "FAIL", s), UVM_NONE)
+        `uvm_info("SCOREBOARD", $sformatf("Object pool %s", obj_pool #(T_TRANS)::stats()), UVM_NONE)
+        if ($cast(model_base, model))
+            model_report = model_base.report();
+        if (model_report != "")
+            `uvm_info("SCOREBOARD", model_report, UVM_NONE)
     endfunction
 endclass
\ No newline at end of file
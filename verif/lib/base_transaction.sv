@@ -32,6 +32,39 @@ virtual class base_transaction #(
         return s;
     endfunction
 
+    // Compares this transaction (DUT) with a golden transaction without
+    // formatting a message. The scoreboard calls compare() only for messages
+    // it actually logs.
+    virtual function bit matches(uvm_sequence_item golden_trans_item);
+        base_transaction #(NUM_INPUTS, INPUT_WIDTH, OUTPUT_WIDTH) golden_trans;
+        if (!$cast(golden_trans, golden_trans_item)) return 0;
+        return this.result == golden_trans.result;
+    endfunction
+
+    // Bins of the scoreboard pass / fail counters (see base_scoreboard).
+    // A single bin by default, subclasses split by rounding mode, operand class, etc.
+    static function int num_stat_bins();
+        return 1;
+    endfunction
+
+    static function string stat_bin_name(int bin);
+        return "all";
+    endfunction
+
+    virtual function int stat_bin();
+        return 0;
+    endfunction
+
+    // Burst mode (see fp_driver_base::drive_burst()): number of operand sets
+    // the item carries, 0 for a single transaction. prepare_burst() is called
+    // by the driver before burst_size(), e.g. to load a vector file.
+    virtual function int burst_size();
+        return 0;
+    endfunction
+
+    virtual function void prepare_burst();
+    endfunction
+
     // Compares this transaction (DUT) with a golden transaction, generates a
     // formatted log message, and indicates if they match.
     virtual function string compare(input uvm_sequence_item golden_trans_item, output bit is_match);
@@ -0,0 +1,372 @@
+// verif/lib/bfp_bench.cpp
+//
+// Native self-check, conversion error statistics and benchmark of the block
+// floating point format (fp_to_bfp.v, systolic_bfp.v; reference model in
+// bfp_model.cpp).
+//
+// Self-checks:
+//   encode - bfp_encode() for fp16 / fp32 against the format definition in
+//            double (scale by the largest element exponent, round to nearest
+//            even, saturate), blocks of 1 .. 32, every mantissa width;
+//   simd   - bfp_encode_f32() / bfp_decode_f32() against bfp_encode() /
+//            bfp_value() for blocks of 8 / 16 / 32;
+//   gemm   - bfp_gemm() values against the exact product of the decoded
+//            blocks, NaN blocks included.
+// Elements are random encodings over a few binades with zeros, denormals
+// and one block in sixteen holding an infinity or a NaN.
+//
+// Then the conversion error of fp32 data per distribution, block size and
+// mantissa width (SQNR, RMS relative error, elements flushed to zero, error
+// of a block dot product) next to the operand bits per element, and the
+// elements per second of the scalar and SIMD converters.
+//
+// Build and run (see native.mk):
+//   make -f native.mk bfp
+//   build/native/bfp_bench [--count N] [--seed N]
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bfp_model.h"
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static double rand_unit(uint64_t* state) {
+    return (double)(rand_u64(state) >> 11) * 0x1.0p-53;
+}
+
+static double rand_normal(uint64_t* state) {
+    const double u = rand_unit(state) + 0x1.0p-54;
+    const double v = rand_unit(state);
+    return sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+}
+
+static int exp_w_of(int width) {
+    return (width == 32) ? 8 : 5;
+}
+
+// Random encoding: exponents over a few binades around base, with zeros and
+// denormals; special = 1 makes it an infinity or a NaN
+static uint64_t rand_element(uint64_t* state, int width, int base, int special) {
+    const int exp_w = exp_w_of(width);
+    const int frac_w = width - 1 - exp_w;
+    const uint64_t exp_all = (1ULL << exp_w) - 1;
+    const uint64_t r = rand_u64(state);
+    const uint64_t sign = (r & 1) << (width - 1);
+    const uint64_t frac = (r >> 8) & ((1ULL << frac_w) - 1);
+    if (special) return sign | (exp_all << frac_w) | ((r & 2) ? frac : 0);
+    switch ((r >> 1) & 15) {
+        case 0: return sign;          // Zero
+        case 1: return sign | frac;   // Denormal
+        default: break;
+    }
+    int exp = base - (int)((r >> 40) % 12);
+    if (exp < 1) exp = 1;
+    return sign | ((uint64_t)exp << frac_w) | frac;
+}
+
+static double to_double(uint64_t x, int width) {
+    const int exp_w = exp_w_of(width);
+    const int frac_w = width - 1 - exp_w;
+    const int bias = (1 << (exp_w - 1)) - 1;
+    const int sign = (int)((x >> (width - 1)) & 1);
+    const int exp = (int)((x >> frac_w) & ((1 << exp_w) - 1));
+    const uint64_t frac = x & ((1ULL << frac_w) - 1);
+    const double m = exp ? ldexp((double)(frac | (1ULL << frac_w)), exp - bias - frac_w)
+                         : ldexp((double)frac, 1 - bias - frac_w);
+    return sign ? -m : m;
+}
+
+//----------------------------------------------------------------------------
+// Self-checks
+//----------------------------------------------------------------------------
+
+// Format definition: m = RNE(x / 2^(emax - bias - (mant_w-2))), saturated
+static uint8_t reference_encode(const uint64_t* x, int n, int width, int mant_w, int32_t* mant) {
+    const int exp_w = exp_w_of(width);
+    const int frac_w = width - 1 - exp_w;
+    const int bias = (1 << (exp_w - 1)) - 1;
+    const int exp_all = (1 << exp_w) - 1;
+    const double mag_max = ldexp(1.0, mant_w - 1) - 1;
+    int emax = 1;
+    for (int i = 0; i < n; i++) {
+        const int e = (int)((x[i] >> frac_w) & exp_all);
+        if (e == exp_all) {
+            for (int j = 0; j < n; j++) mant[j] = 0;
+            return BFP_EXP_NAN;
+        }
+        if (e > emax) emax = e;
+    }
+    for (int i = 0; i < n; i++) {
+        double m = nearbyint(ldexp(to_double(x[i], width), -(emax - bias - (mant_w - 2))));
+        if (m > mag_max) m = mag_max;
+        if (m < -mag_max) m = -mag_max;
+        mant[i] = (int32_t)m;
+    }
+    return (uint8_t)(emax - bias + 127);
+}
+
+static long check_encode(int width, long blocks, uint64_t seed) {
+    const int exp_w = exp_w_of(width);
+    const int frac_w = width - 1 - exp_w;
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + width;
+    uint64_t x[32];
+    int32_t mant[32], ref[32];
+    long mismatches = 0;
+    for (long b = 0; b < blocks; b++) {
+        const int n = 1 + (int)(rand_u64(&state) % 32);
+        const int mant_w = 2 + (int)(rand_u64(&state) % (frac_w + 1));
+        const int base = 1 + (int)(rand_u64(&state) % ((1 << exp_w) - 2));
+        const int special_at = (rand_u64(&state) % 16) ? -1 : (int)(rand_u64(&state) % n);
+        for (int i = 0; i < n; i++) x[i] = rand_element(&state, width, base, i == special_at);
+        const uint8_t e = bfp_encode(x, n, width, mant_w, mant);
+        const uint8_t e_ref = reference_encode(x, n, width, mant_w, ref);
+        bool ok = e == e_ref;
+        for (int i = 0; ok && i < n; i++) ok = mant[i] == ref[i];
+        if (!ok) {
+            if (mismatches < 5)
+                printf("  fp%d encode n %d mant_w %d: exp %02x, expected %02x\n", width, n, mant_w, e, e_ref);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+static long check_simd(long blocks, uint64_t seed) {
+    static const int block_list[] = {8, 16, 32};
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+    float x[32], dec[32];
+    uint64_t enc[32];
+    int32_t ref[32];
+    int8_t mant[32];
+    uint8_t e;
+    long mismatches = 0;
+    for (long b = 0; b < blocks; b++) {
+        const int n = block_list[b % 3];
+        const int mant_w = 2 + (int)(rand_u64(&state) % 7);
+        const int base = 1 + (int)(rand_u64(&state) % 254);
+        const int special_at = (rand_u64(&state) % 16) ? -1 : (int)(rand_u64(&state) % n);
+        for (int i = 0; i < n; i++) {
+            enc[i] = rand_element(&state, 32, base, i == special_at);
+            const uint32_t u = (uint32_t)enc[i];
+            memcpy(&x[i], &u, sizeof(u));
+        }
+        bfp_encode_f32(x, n, n, mant_w, &e, mant);
+        bfp_decode_f32(&e, mant, n, n, mant_w, dec);
+        const uint8_t e_ref = bfp_encode(enc, n, 32, mant_w, ref);
+        bool ok = e == e_ref;
+        for (int i = 0; ok && i < n; i++) {
+            const double v = bfp_value(e_ref, ref[i], mant_w);
+            ok = mant[i] == ref[i] && (std::isnan(v) ? std::isnan(dec[i]) : dec[i] == v);
+        }
+        if (!ok) {
+            if (mismatches < 5) printf("  simd n %d mant_w %d: exp %02x, expected %02x\n", n, mant_w, e, e_ref);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+static long check_gemm(long jobs, uint64_t seed) {
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 2;
+    long mismatches = 0;
+    for (long j = 0; j < jobs; j++) {
+        const int rows = 1 << (1 + rand_u64(&state) % 5);
+        const int cols = 1 << (1 + rand_u64(&state) % 5);
+        const int mant_w = 2 + (int)(rand_u64(&state) % 7);
+        const int32_t mag_max = (1 << (mant_w - 1)) - 1;
+        std::vector<int32_t> a(rows * rows), b(rows * cols);
+        std::vector<uint8_t> ea(rows), eb(cols);
+        std::vector<int64_t> c(rows * cols);
+        std::vector<int> ec(rows * cols), nan(rows * cols);
+        for (auto& m : a) m = (int32_t)(rand_u64(&state) % (2 * mag_max + 1)) - mag_max;
+        for (auto& m : b) m = (int32_t)(rand_u64(&state) % (2 * mag_max + 1)) - mag_max;
+        for (auto& e : ea) e = (rand_u64(&state) % 16) ? (uint8_t)(64 + rand_u64(&state) % 128) : BFP_EXP_NAN;
+        for (auto& e : eb) e = (rand_u64(&state) % 16) ? (uint8_t)(64 + rand_u64(&state) % 128) : BFP_EXP_NAN;
+        bfp_gemm(rows, cols, a.data(), ea.data(), b.data(), eb.data(), c.data(), ec.data(), nan.data());
+        bool ok = true;
+        for (int r = 0; ok && r < rows; r++) {
+            for (int q = 0; ok && q < cols; q++) {
+                double sum = 0.0;  // Exact: products of mant_w <= 8 bit mantissas
+                for (int k = 0; k < rows; k++)
+                    sum += bfp_value(ea[r], a[r * rows + k], mant_w) * bfp_value(eb[q], b[k * cols + q], mant_w);
+                const int i = r * cols + q;
+                ok = std::isnan(sum) ? nan[i] == 1 : (nan[i] == 0 && bfp_gemm_value(c[i], ec[i], mant_w) == sum);
+            }
+        }
+        if (!ok) {
+            if (mismatches < 5) printf("  gemm %dx%d mant_w %d differs\n", rows, cols, mant_w);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+//----------------------------------------------------------------------------
+// Conversion error statistics
+//----------------------------------------------------------------------------
+
+static const char* dist_names[] = {"uniform", "normal", "normal+1% x64", "lognormal"};
+
+static float rand_dist(uint64_t* state, int dist) {
+    switch (dist) {
+        case 0: return (float)(2.0 * rand_unit(state) - 1.0);
+        case 1: return (float)rand_normal(state);
+        case 2: return (float)(rand_normal(state) * ((rand_u64(state) % 100) ? 1.0 : 64.0));
+        default: {
+            const double m = exp(2.0 * rand_normal(state));
+            return (float)((rand_u64(state) & 1) ? m : -m);
+        }
+    }
+}
+
+struct err_stats_s {
+    double sqnr_db;
+    double rms_rel;     // Over the non-zero elements
+    double flushed;     // Fraction of non-zero elements converted to zero
+    double dot_rel;     // Mean |error| / sum |a_k b_k| of a block dot product
+};
+
+static err_stats_s error_stats(int dist, int block, int mant_w, long blocks, uint64_t seed) {
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + dist * 100 + block + mant_w;
+    const size_t count = (size_t)blocks * block;
+    std::vector<float> x(count), y(count), xd(count), yd(count);
+    std::vector<uint8_t> ex(blocks), ey(blocks);
+    std::vector<int8_t> mx(count), my(count);
+    for (size_t i = 0; i < count; i++) {
+        x[i] = rand_dist(&state, dist);
+        y[i] = rand_dist(&state, dist);
+    }
+    bfp_encode_f32(x.data(), count, block, mant_w, ex.data(), mx.data());
+    bfp_encode_f32(y.data(), count, block, mant_w, ey.data(), my.data());
+    bfp_decode_f32(ex.data(), mx.data(), count, block, mant_w, xd.data());
+    bfp_decode_f32(ey.data(), my.data(), count, block, mant_w, yd.data());
+
+    double sig = 0.0, noise = 0.0, rel2 = 0.0, dot_rel = 0.0;
+    long nonzero = 0, flushed = 0;
+    for (size_t i = 0; i < count; i++) {
+        const double e = (double)xd[i] - x[i];
+        sig += (double)x[i] * x[i];
+        noise += e * e;
+        if (x[i] != 0.0f) {
+            nonzero++;
+            rel2 += (e / x[i]) * (e / x[i]);
+            flushed += xd[i] == 0.0f;
+        }
+    }
+    for (long b = 0; b < blocks; b++) {
+        double exact = 0.0, approx = 0.0, mag = 0.0;
+        for (int k = 0; k < block; k++) {
+            const size_t i = (size_t)b * block + k;
+            exact += (double)x[i] * y[i];
+            approx += (double)xd[i] * yd[i];
+            mag += fabs((double)x[i] * y[i]);
+        }
+        dot_rel += mag > 0 ? fabs(approx - exact) / mag : 0.0;
+    }
+    err_stats_s s;
+    s.sqnr_db = noise > 0 ? 10.0 * log10(sig / noise) : INFINITY;
+    s.rms_rel = nonzero ? sqrt(rel2 / nonzero) : 0.0;
+    s.flushed = nonzero ? (double)flushed / nonzero : 0.0;
+    s.dot_rel = dot_rel / blocks;
+    return s;
+}
+
+//----------------------------------------------------------------------------
+// Benchmark
+//----------------------------------------------------------------------------
+
+static double elements_per_s(int simd, long blocks, uint64_t seed) {
+    const int block = 32, mant_w = 8;
+    uint64_t state = seed;
+    std::vector<float> x(block * 256);
+    std::vector<uint64_t> enc(x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        x[i] = rand_dist(&state, 1);
+        uint32_t u;
+        memcpy(&u, &x[i], sizeof(u));
+        enc[i] = u;
+    }
+    uint8_t e = 0;
+    int8_t mant[32];
+    int32_t mant32[32];
+    unsigned sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (long b = 0; b < blocks; b++) {
+        const size_t off = (size_t)(b & 255) * block;
+        if (simd) {
+            bfp_encode_f32(&x[off], block, block, mant_w, &e, mant);
+            sink += e + mant[0];
+        } else {
+            sink += bfp_encode(&enc[off], block, 32, mant_w, mant32) + mant32[0];
+        }
+    }
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (sink == 1) printf(" ");  // Keep the work
+    return s > 0 ? blocks * (double)block / s : 0.0;
+}
+
+int main(int argc, char** argv) {
+    long count = 20000;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+            count = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [--count N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (count < 1) {
+        fprintf(stderr, "--count must be at least 1\n");
+        return 2;
+    }
+
+    long total_mismatches = 0;
+    printf("%-16s | %-10s | %s\n", "CHECK", "COUNT", "MISMATCHES");
+    const long m16 = check_encode(16, count, seed);
+    printf("%-16s | %-10ld | %ld\n", "encode fp16", count, m16);
+    const long m32 = check_encode(32, count, seed);
+    printf("%-16s | %-10ld | %ld\n", "encode fp32", count, m32);
+    const long ms = check_simd(count, seed);
+    printf("%-16s | %-10ld | %ld\n", "simd fp32", count, ms);
+    const long mg = check_gemm(count / 20 + 1, seed);
+    printf("%-16s | %-10ld | %ld\n", "gemm (jobs)", count / 20 + 1, mg);
+    total_mismatches = m16 + m32 + ms + mg;
+
+    printf("\nfp32 conversion error, %ld blocks per row; BITS: operand bits per element (fp16: 16)\n\n", count);
+    printf("%-14s | %-5s | %-6s | %-6s | %-8s | %-9s | %-9s | %-9s\n", "DATA", "BLOCK", "MANT_W", "BITS", "SQNR dB",
+           "RMS REL", "FLUSHED", "DOT REL");
+    for (int dist = 0; dist < 4; dist++) {
+        for (int block : {16, 32}) {
+            for (int mant_w : {4, 6, 8}) {
+                const err_stats_s s = error_stats(dist, block, mant_w, count, seed);
+                printf("%-14s | %-5d | %-6d | %-6.2f | %-8.2f | %-9.3g | %-9.3g | %-9.3g\n", dist_names[dist], block,
+                       mant_w, mant_w + 8.0 / block, s.sqnr_db, s.rms_rel, s.flushed, s.dot_rel);
+            }
+        }
+    }
+
+    const long blocks = 20000000L / 32;
+    printf("\nfp32 to MXINT8 (block 32) elements per second (one thread), RTL: one block per cycle\n\n");
+    printf("%-12s | %-12s\n", "SCALAR", "SIMD");
+    printf("%-12.3g | %-12.3g\n", elements_per_s(0, blocks, seed), elements_per_s(1, blocks, seed));
+
+    printf("\n%s : block floating point converter and GEMM match the format definition\n",
+           total_mismatches ? "FAIL" : "PASS");
+    return total_mismatches ? 1 : 0;
+}
@@ -0,0 +1,193 @@
+// verif/lib/bfp_model.cpp
+//
+// Reference of the block floating point converter and systolic array.
+// See bfp_model.h.
+//
+
+#include "bfp_model.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+static int fp_exp_w(int width) {
+    return (width == 32) ? 8 : 5;
+}
+
+int fp_to_bfp_latency() {
+    return 2;
+}
+
+//----------------------------------------------------------------------------
+// Scalar converter (fp_to_bfp.v)
+//----------------------------------------------------------------------------
+
+uint8_t bfp_encode(const uint64_t* x, int n, int width, int mant_w, int32_t* mant) {
+    const int exp_w = fp_exp_w(width);
+    const int frac_w = width - 1 - exp_w;
+    const int bias = (1 << (exp_w - 1)) - 1;
+    const int exp_all = (1 << exp_w) - 1;
+    const int sh0 = frac_w - (mant_w - 2);
+    const int sh_max = frac_w + 2;
+    const int64_t mag_max = (1LL << (mant_w - 1)) - 1;
+
+    // Stage 1: maximum effective exponent, specials
+    int emax = 0;
+    int special = 0;
+    for (int i = 0; i < n; i++) {
+        const int e = (int)((x[i] >> frac_w) & exp_all);
+        const int eff = e ? e : 1;
+        special |= (e == exp_all);
+        if (eff > emax) emax = eff;
+    }
+    if (special) {
+        for (int i = 0; i < n; i++) mant[i] = 0;
+        return BFP_EXP_NAN;
+    }
+
+    // Stage 2: align, round to nearest even, saturate
+    for (int i = 0; i < n; i++) {
+        const int sign = (int)((x[i] >> (width - 1)) & 1);
+        const int e = (int)((x[i] >> frac_w) & exp_all);
+        const int eff = e ? e : 1;
+        const uint64_t sig = (x[i] & ((1ULL << frac_w) - 1)) | ((uint64_t)(e != 0) << frac_w);
+        const int sh = (sh0 + emax - eff < sh_max) ? sh0 + emax - eff : sh_max;
+
+        const uint64_t ext = sig << 1;
+        const uint64_t shifted = ext >> sh;
+        const int sticky = (ext & ((1ULL << sh) - 1)) != 0;
+        const uint64_t q = shifted >> 1;
+        const int inc = (shifted & 1) && (sticky || (q & 1));
+
+        int64_t mag = (int64_t)(q + inc);
+        if (mag > mag_max) mag = mag_max;
+        mant[i] = (int32_t)(sign ? -mag : mag);
+    }
+    return (uint8_t)(emax - bias + 127);
+}
+
+double bfp_value(uint8_t exp, int32_t mant, int mant_w) {
+    if (exp == BFP_EXP_NAN) return NAN;
+    return ldexp((double)mant, exp - 127 - (mant_w - 2));
+}
+
+//----------------------------------------------------------------------------
+// fp32 arrays, GCC vector extensions
+//----------------------------------------------------------------------------
+
+typedef int32_t v8si __attribute__((vector_size(32)));
+typedef float   v8sf __attribute__((vector_size(32)));
+
+void bfp_encode_f32(const float* x, size_t count, int block, int mant_w, uint8_t* exp, int8_t* mant) {
+    const int32_t sh0 = 23 - (mant_w - 2);
+    const v8si zero = {};
+    const v8si one = zero + 1;
+    const v8si sh_max = zero + 25;
+    const v8si mag_max = zero + ((1 << (mant_w - 1)) - 1);
+
+    for (size_t b = 0; b < count / block; b++) {
+        const float* xb = x + b * block;
+        int8_t* mb = mant + b * block;
+
+        // Maximum effective exponent, specials
+        v8si vmax = zero;
+        v8si vspec = zero;
+        for (int c = 0; c < block; c += 8) {
+            v8si bits;
+            memcpy(&bits, xb + c, sizeof(bits));
+            const v8si e = (bits >> 23) & 0xFF;
+            const v8si eff = e + ((e == 0) & 1);
+            vmax = (vmax > eff) ? vmax : eff;
+            vspec |= (e == 0xFF);
+        }
+        int32_t emax = 0;
+        int32_t special = 0;
+        for (int l = 0; l < 8; l++) {
+            if (vmax[l] > emax) emax = vmax[l];
+            special |= vspec[l];
+        }
+        if (special) {
+            exp[b] = BFP_EXP_NAN;
+            memset(mb, 0, block);
+            continue;
+        }
+        exp[b] = (uint8_t)emax;
+
+        // Align, round to nearest even, saturate
+        for (int c = 0; c < block; c += 8) {
+            v8si bits;
+            memcpy(&bits, xb + c, sizeof(bits));
+            const v8si e = (bits >> 23) & 0xFF;
+            const v8si eff = e + ((e == 0) & 1);
+            const v8si sig = (bits & 0x7FFFFF) | ((e != 0) & 0x800000);
+            v8si sh = sh0 + (emax - eff);
+            sh = (sh < sh_max) ? sh : sh_max;
+
+            const v8si ext = sig << 1;
+            const v8si shifted = ext >> sh;
+            const v8si sticky = (ext & ((one << sh) - 1)) != 0;
+            const v8si q = shifted >> 1;
+            const v8si inc = shifted & (sticky | q) & 1;
+
+            v8si mag = q + inc;
+            mag = (mag < mag_max) ? mag : mag_max;
+            const v8si m = (bits < 0) ? -mag : mag;
+            for (int l = 0; l < 8; l++) mb[c + l] = (int8_t)m[l];
+        }
+    }
+}
+
+void bfp_decode_f32(const uint8_t* exp, const int8_t* mant, size_t count, int block, int mant_w, float* out) {
+    for (size_t b = 0; b < count / block; b++) {
+        const float scale = (exp[b] == BFP_EXP_NAN) ? NAN : ldexpf(1.0f, exp[b] - 127 - (mant_w - 2));
+        for (int c = 0; c < block; c += 8) {
+            v8si m;
+            for (int l = 0; l < 8; l++) m[l] = mant[b * block + c + l];
+            const v8sf v = __builtin_convertvector(m, v8sf) * scale;
+            memcpy(out + b * block + c, &v, sizeof(v));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+// systolic_bfp
+//----------------------------------------------------------------------------
+
+void bfp_gemm(int rows, int cols, const int32_t* a_mant, const uint8_t* a_exp,
+              const int32_t* b_mant, const uint8_t* b_exp, int64_t* c, int* c_exp, int* c_nan) {
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int64_t sum = 0;
+            for (int k = 0; k < rows; k++) sum += (int64_t)a_mant[i * rows + k] * b_mant[k * cols + j];
+            c[i * cols + j] = sum;
+            c_exp[i * cols + j] = a_exp[i] + b_exp[j];
+            c_nan[i * cols + j] = (a_exp[i] == BFP_EXP_NAN) || (b_exp[j] == BFP_EXP_NAN);
+        }
+    }
+}
+
+double bfp_gemm_value(int64_t c, int c_exp, int mant_w) {
+    return ldexp((double)c, c_exp - 254 - 2 * (mant_w - 2));
+}
+
+//----------------------------------------------------------------------------
+// DPI-C API
+//----------------------------------------------------------------------------
+
+static std::vector<uint64_t> dpi_block;
+static std::vector<int32_t> dpi_mant;
+
+extern "C" void c_bfp_element(uint64_t x) {
+    dpi_block.push_back(x);
+}
+
+extern "C" int c_bfp_encode(const int width, const int mant_w) {
+    dpi_mant.assign(dpi_block.size(), 0);
+    const int exp = bfp_encode(dpi_block.data(), (int)dpi_block.size(), width, mant_w, dpi_mant.data());
+    dpi_block.clear();
+    return exp;
+}
+
+extern "C" int c_bfp_mant(const int i) {
+    return dpi_mant[i];
+}
@@ -0,0 +1,61 @@
+// verif/lib/bfp_model.h
+//
+// Reference of the block floating point (microscaling, MX-style) format:
+// the fp16 / fp32 converter (fp_to_bfp.v) and the block floating point
+// systolic array (systolic_bfp.v).
+//
+// Format: a block of n elements shares an 8-bit E8M0 exponent e (scale
+// 2^(e - 127), 0xFF: NaN block) and holds mant_w-bit two's complement
+// mantissas with mant_w-2 fraction bits, element i = m_i * 2^(e - 127 - (mant_w-2)).
+// MXINT8 is mant_w = 8 with blocks of 32.
+//
+// bfp_encode() follows the RTL bit-exactly for any width / mant_w / block;
+// bfp_encode_f32() / bfp_decode_f32() are the same conversion for fp32
+// arrays with GCC vector extensions, eight elements per instruction.
+//
+// Used natively by bfp_bench.cpp and from the fp_to_bfp testbench through
+// DPI-C (c_bfp_*).
+//
+
+#ifndef BFP_MODEL_H
+#define BFP_MODEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define BFP_EXP_NAN 0xFF
+
+// Pipeline latency of fp_to_bfp
+int fp_to_bfp_latency();
+
+// Converts the n fp16 / fp32 encodings of x to one block: returns the
+// shared exponent, mant[i] the mantissa of x[i] (fp_to_bfp.v)
+uint8_t bfp_encode(const uint64_t* x, int n, int width, int mant_w, int32_t* mant);
+
+// Value of one element
+double bfp_value(uint8_t exp, int32_t mant, int mant_w);
+
+// Converts count fp32 values, blocks of block elements (a multiple of 8,
+// count a multiple of block), mant_w <= 8: exp[count / block], mant[count].
+// Same result as bfp_encode().
+void bfp_encode_f32(const float* x, size_t count, int block, int mant_w, uint8_t* exp, int8_t* mant);
+
+// Inverse of bfp_encode_f32() (NaN blocks decode to NaN)
+void bfp_decode_f32(const uint8_t* exp, const int8_t* mant, size_t count, int block, int mant_w, float* out);
+
+// systolic_bfp: C (rows x cols) = A (rows x rows, row i a block with
+// exponent a_exp[i]) * B (rows x cols, column j a block with exponent
+// b_exp[j]), mantissas row-major. c[i*cols + j] is the exact mantissa sum,
+// c_exp[i*cols + j] = a_exp[i] + b_exp[j], c_nan set if either is NaN.
+void bfp_gemm(int rows, int cols, const int32_t* a_mant, const uint8_t* a_exp,
+              const int32_t* b_mant, const uint8_t* b_exp, int64_t* c, int* c_exp, int* c_nan);
+
+// Value of one element of bfp_gemm()
+double bfp_gemm_value(int64_t c, int c_exp, int mant_w);
+
+// DPI-C API
+extern "C" void c_bfp_element(uint64_t x);                              // Next element of the block
+extern "C" int  c_bfp_encode(const int width, const int mant_w);        // Converts the block, returns the exponent
+extern "C" int  c_bfp_mant(const int i);                                // Mantissa i of the last block
+
+#endif // BFP_MODEL_H
@@ -0,0 +1,168 @@
+// verif/lib/fp_batch_vl.cpp
+//
+// Batch API to a Verilated floating-point unit, built as a shared library
+// for Python (verif/lib/fp_rtl.py, ctypes and NumPy).
+//
+// fp_batch_run() streams arrays of operands through the unit, one operation
+// per cycle (a new operation enters every cycle, as the units are fully
+// pipelined), and returns the results in input order. fp_batch_model() runs
+// the same arrays through the bit-accurate C model, so the RTL, the C model
+// and the Python model (fp_model.py) can be compared on the same vectors.
+//
+// The unit is Verilated with --prefix Vbatch and selected at build time (see
+// verilator.mk):
+//   BATCH_DUT   - Unit name (top module): fp_add, fp_mul, fp_exp or fp_recip
+//   BATCH_WIDTH - WIDTH the model was Verilated with
+//   BATCH_UNARY - 1 for units without a b input (fp_exp, fp_recip)
+//   BATCH_MODEL - C model function, e.g. c_fp_add
+//
+// The pipeline latency is measured when the unit is opened: a NaN operand
+// enters an idle pipeline and the cycles until the NaN result appear are
+// counted, so units whose latency is a parameter expression need no table.
+//
+// Build:
+//   make -f verilator.mk pylib DUT=fp_mul WIDTH=32
+//   -> build/verilator/batch/fp_mul_32/libfp_batch.so
+//
+
+#include <cstddef>
+#include <cstdint>
+
+#include "verilated.h"
+#include "Vbatch.h"
+
+extern "C" {
+#include "fp_model.h"
+}
+
+#include "fp_softmax_model.h"  // c_fp_exp, c_fp_recip
+
+#define BATCH_STR2(x) #x
+#define BATCH_STR(x) BATCH_STR2(x)
+
+// Cycles without an operation before the latency probe, and the longest
+// latency the probe waits for
+static const int probe_max = 256;
+
+struct fp_batch_s {
+    VerilatedContext* ctx;
+    Vbatch* dut;
+    int latency;
+    uint64_t cycles;  // Cycles clocked since the unit was opened
+};
+
+static bool is_nan(uint64_t x) {
+    const int exp_w = (BATCH_WIDTH == 64) ? 11 : (BATCH_WIDTH == 32) ? 8 : 5;
+    const int mant_w = BATCH_WIDTH - 1 - exp_w;
+    const uint64_t exp = (x >> mant_w) & ((1ULL << exp_w) - 1);
+    return exp == (1ULL << exp_w) - 1 && (x & ((1ULL << mant_w) - 1));
+}
+
+static void drive(Vbatch* dut, uint64_t a, uint64_t b, int rm) {
+    dut->a = a;
+#if !BATCH_UNARY
+    dut->b = b;
+#else
+    (void)b;
+#endif
+    dut->rm = rm;
+}
+
+static uint64_t qnan() {
+    const int exp_w = (BATCH_WIDTH == 64) ? 11 : (BATCH_WIDTH == 32) ? 8 : 5;
+    const int mant_w = BATCH_WIDTH - 1 - exp_w;
+    return (((1ULL << exp_w) - 1) << mant_w) | (1ULL << (mant_w - 1));
+}
+
+// Operation t is driven in cycle t and its result is at the outputs in cycle
+// t + latency, before that cycle's rising edge
+static int probe_latency(fp_batch_s* h) {
+    for (int t = 0; t < 2 * probe_max; t++) {
+        drive(h->dut, (t == probe_max) ? qnan() : 0, 0, RNE);
+        h->dut->clk = 0;
+        h->dut->eval();
+        if (t >= probe_max && is_nan(h->dut->result)) return t - probe_max;
+        h->dut->clk = 1;
+        h->dut->eval();
+        h->cycles++;
+    }
+    return -1;
+}
+
+extern "C" {
+
+const char* fp_batch_dut() { return BATCH_STR(BATCH_DUT); }
+int fp_batch_width() { return BATCH_WIDTH; }
+int fp_batch_unary() { return BATCH_UNARY; }
+
+// Opens (resets) an instance of the unit, NULL if the latency probe failed
+void* fp_batch_open() {
+    fp_batch_s* h = new fp_batch_s;
+    h->ctx = new VerilatedContext;
+    h->dut = new Vbatch(h->ctx);
+    h->cycles = 0;
+
+    h->dut->clk = 0;
+    h->dut->rst_n = 0;
+    drive(h->dut, 0, 0, RNE);
+    h->dut->eval();
+    h->dut->rst_n = 1;
+    h->dut->eval();
+
+    h->latency = probe_latency(h);
+    if (h->latency < 0) {
+        h->dut->final();
+        delete h->dut;
+        delete h->ctx;
+        delete h;
+        return nullptr;
+    }
+    return h;
+}
+
+void fp_batch_close(void* handle) {
+    fp_batch_s* h = static_cast<fp_batch_s*>(handle);
+    if (!h) return;
+    h->dut->final();
+    delete h->dut;
+    delete h->ctx;
+    delete h;
+}
+
+int fp_batch_latency(void* handle) { return static_cast<fp_batch_s*>(handle)->latency; }
+
+uint64_t fp_batch_cycles(void* handle) { return static_cast<fp_batch_s*>(handle)->cycles; }
+
+// out[i] = unit(a[i], b[i], rm[i]), i < n (b ignored by unary units).
+// Clocks n + latency cycles.
+void fp_batch_run(void* handle, const uint64_t* a, const uint64_t* b, const uint8_t* rm, uint64_t* out, size_t n) {
+    fp_batch_s* h = static_cast<fp_batch_s*>(handle);
+    const size_t lat = (size_t)h->latency;
+    for (size_t t = 0; t < n + lat; t++) {
+        if (t < n) {
+            drive(h->dut, a[t], b ? b[t] : 0, rm[t]);
+        } else {
+            drive(h->dut, 0, 0, RNE);
+        }
+        h->dut->clk = 0;
+        h->dut->eval();
+        if (t >= lat) out[t - lat] = h->dut->result;
+        h->dut->clk = 1;
+        h->dut->eval();
+        h->cycles++;
+    }
+}
+
+// Same with the C model
+void fp_batch_model(const uint64_t* a, const uint64_t* b, const uint8_t* rm, uint64_t* out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+#if BATCH_UNARY
+        (void)b;
+        out[i] = BATCH_MODEL(a[i], BATCH_WIDTH, rm[i]);
+#else
+        out[i] = BATCH_MODEL(a[i], b ? b[i] : 0, BATCH_WIDTH, rm[i]);
+#endif
+    }
+}
+
+}  // extern "C"
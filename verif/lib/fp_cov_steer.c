@@ -0,0 +1,734 @@
+// verif/lib/fp_cov_steer.c
+//
+// Closed-loop coverage model and stimulus steering for fp_add / fp_mul.
+// See fp_cov_steer.h for the overview.
+//
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Standard DPI-C inclusion for simulator integration
+#include "svdpi.h"
+
+#include "fp_model.h"
+#include "fp_cov_steer.h"
+
+// Open upper end of a bin range
+#define COV_INF INT_MAX
+
+// Exponent relation requested from the steered generator
+#define EXP_FREE 0
+#define EXP_DIFF 1  // fp_add: exp_a - exp_b in [lo, hi]
+#define EXP_SUM  2  // fp_mul: product exponent in [lo, hi]
+
+// Sign relation requested from the steered generator
+#define SIGN_FREE 0
+#define SIGN_SAME 1  // fp_add: effective addition
+#define SIGN_OPP  2  // fp_add: effective subtraction
+
+// Mantissa styles used by the steered generator
+#define MANT_UNIFORM   0  // Uniformly random
+#define MANT_TRAILING0 1  // Random with a random number of trailing zeros (exact results)
+#define MANT_ALL_ONES  2  // All ones (rounding overflow)
+#define MANT_SHARED    3  // b only: a's mantissa with the bits below the top k re-randomized
+#define MANT_BORROW    4  // b only: top k bits ones, a gets its top k bits cleared (cancellation at exp_diff 1)
+#define MANT_RECIP     5  // b only: largest significand with sig_a * sig_b < 2.0 (product rounds up to 2.0)
+#define MANT_EQUAL     6  // b only: a's mantissa (exact cancellation)
+
+// Generation hints derived from the target bin
+typedef struct {
+    int class_a, class_b;  // FP_CLASS_* or -1: finite non-zero
+    int exp_mode;          // EXP_*
+    int exp_lo, exp_hi;
+    int exp_top;           // fp_add: larger exponent at the top of the range
+    int sign_rel;          // SIGN_*
+    int sign_res;          // Required result sign, -1: free
+    int mant_a, mant_b;    // MANT_* styles
+    int k;                 // Parameter of the MANT_SHARED / MANT_BORROW styles
+    int rm;                // Rounding mode, -1: random
+} cov_hint_s;
+
+static const char* const cov_class_names[FP_NUM_CLASSES] = {"zero", "denormal", "normal", "inf", "nan"};
+static const char* const cov_rm_names[5] = {"RNE", "RTZ", "RPI", "RNI", "RNA"};
+static const char* const cov_group_names[FP_COV_NUM_GROUPS] = {"CLASS", "EXP", "NORM", "GRS", "ROVF"};
+static const char* const cov_gen_names[3] = {"dist", "uniform", "steered"};
+
+//------------------------------------------------------------------------------
+// Random numbers (xorshift64*)
+//------------------------------------------------------------------------------
+
+static uint64_t cov_rand(fp_cov_s* cov) {
+    cov->rng ^= cov->rng >> 12;
+    cov->rng ^= cov->rng << 25;
+    cov->rng ^= cov->rng >> 27;
+    return cov->rng * 0x2545F4914F6CDD1DULL;
+}
+
+// Uniform integer in [lo, hi]
+static int cov_rand_range(fp_cov_s* cov, int lo, int hi) {
+    if (hi <= lo) {
+        return lo;
+    }
+    return lo + (int)(cov_rand(cov) % (uint64_t)(hi - lo + 1));
+}
+
+static uint64_t cov_rand_bits(fp_cov_s* cov, int bits) {
+    if (bits <= 0) {
+        return 0;
+    }
+    return (bits >= 64) ? cov_rand(cov) : (cov_rand(cov) & ((1ULL << bits) - 1));
+}
+
+//------------------------------------------------------------------------------
+// Coverage bins
+//------------------------------------------------------------------------------
+
+static void cov_add_bin(fp_cov_s* cov, int group, int p0, int p1, int lo, int hi) {
+    fp_cov_bin_s* bin = &cov->bins[cov->num_bins++];
+    bin->group = group;
+    bin->p0 = p0;
+    bin->p1 = p1;
+    bin->lo = lo;
+    bin->hi = hi;
+    bin->hits = 0;
+}
+
+int fp_cov_init(fp_cov_s* cov, int op, int width, int gen, uint64_t seed) {
+    int exp_w;
+    switch (width) {
+        case 64: exp_w = 11; break;
+        case 32: exp_w =  8; break;
+        case 16: exp_w =  5; break;
+        default: return -1;
+    }
+    if ((op != FP_COV_OP_ADD && op != FP_COV_OP_MUL) || gen < FP_COV_GEN_DIST || gen > FP_COV_GEN_STEERED) {
+        return -1;
+    }
+
+    memset(cov, 0, sizeof(*cov));
+    cov->op = op;
+    cov->width = width;
+    cov->gen = gen;
+    cov->candidates = 32;
+    cov->exp_w = exp_w;
+    cov->mant_w = width - 1 - exp_w;
+    cov->bias = (1 << (exp_w - 1)) - 1;
+    cov->exp_max = (1 << exp_w) - 1;
+    cov->precision_bits = (width == 16) ? 32 : 7;  // As in c_fp_add()
+    cov->rng = (seed + 1) * 0x9E3779B97F4A7C15ULL;
+
+    const int M = cov->mant_w;
+
+    // Operand class pairs
+    for (int class_a = 0; class_a < FP_NUM_CLASSES; class_a++) {
+        for (int class_b = 0; class_b < FP_NUM_CLASSES; class_b++) {
+            cov_add_bin(cov, FP_COV_GRP_CLASS, class_a, class_b, 0, 0);
+        }
+    }
+
+    if (op == FP_COV_OP_ADD) {
+        // Exponent difference, by sign and magnitude. Ranges that the effective
+        // exponents 1..exp_max-1 cannot reach are left out.
+        const int max_diff = cov->exp_max - 2;
+        const int align_w = M + 1 + cov->precision_bits;
+        const int ranges[5][2] = {{1, 1}, {2, 2}, {3, M}, {M + 1, align_w - 1}, {align_w, COV_INF}};
+        cov_add_bin(cov, FP_COV_GRP_EXP, 0, 0, 0, 0);
+        for (int sign = 1; sign >= -1; sign -= 2) {
+            for (int r = 0; r < 5; r++) {
+                if (ranges[r][0] <= max_diff) {
+                    cov_add_bin(cov, FP_COV_GRP_EXP, sign, 0, ranges[r][0], ranges[r][1]);
+                }
+            }
+        }
+
+        // Normalization: carry out, cancellation depth, exact zero
+        cov_add_bin(cov, FP_COV_GRP_NORM, 0, 0, -1, -1);
+        cov_add_bin(cov, FP_COV_GRP_NORM, 0, 0, 0, 0);
+        cov_add_bin(cov, FP_COV_GRP_NORM, 0, 0, 1, 1);
+        cov_add_bin(cov, FP_COV_GRP_NORM, 0, 0, 2, 2);
+        cov_add_bin(cov, FP_COV_GRP_NORM, 0, 0, 3, M);
+        cov_add_bin(cov, FP_COV_GRP_NORM, 0, 0, M + 1, COV_INF);
+        cov_add_bin(cov, FP_COV_GRP_NORM, 1, 0, 0, 0);
+    } else {
+        // Product exponent: flushed, denormal, min normal, normal, max normal, overflow
+        const int min_exp = 2 - cov->bias;
+        cov_add_bin(cov, FP_COV_GRP_EXP, 0, 0, min_exp, -M - 1);
+        cov_add_bin(cov, FP_COV_GRP_EXP, 0, 0, -M, 0);
+        cov_add_bin(cov, FP_COV_GRP_EXP, 0, 0, 1, 1);
+        cov_add_bin(cov, FP_COV_GRP_EXP, 0, 0, 2, cov->exp_max - 2);
+        cov_add_bin(cov, FP_COV_GRP_EXP, 0, 0, cov->exp_max - 1, cov->exp_max - 1);
+        cov_add_bin(cov, FP_COV_GRP_EXP, 0, 0, cov->exp_max, COV_INF);
+
+        // Product normalization: [1, 2) or [2, 4)
+        cov_add_bin(cov, FP_COV_GRP_NORM, 0, 0, 0, 0);
+        cov_add_bin(cov, FP_COV_GRP_NORM, 0, 0, 1, 1);
+    }
+
+    // GRS pattern x rounding mode
+    for (int rm = RNE; rm <= RNA; rm++) {
+        for (int grs = 0; grs < 8; grs++) {
+            cov_add_bin(cov, FP_COV_GRP_GRS, grs, rm, 0, 0);
+        }
+    }
+
+    // Rounding overflow for every mode that can increment, and into infinity
+    cov_add_bin(cov, FP_COV_GRP_ROVF, RNE, 0, 0, 0);
+    cov_add_bin(cov, FP_COV_GRP_ROVF, RPI, 0, 0, 0);
+    cov_add_bin(cov, FP_COV_GRP_ROVF, RNI, 0, 0, 0);
+    cov_add_bin(cov, FP_COV_GRP_ROVF, RNA, 0, 0, 0);
+    cov_add_bin(cov, FP_COV_GRP_ROVF, -1, 1, 0, 0);
+
+    return cov->num_bins;
+}
+
+static void cov_eval(const fp_cov_s* cov, uint64_t a, uint64_t b, int rm, fp_trace_s* trace) {
+    if (cov->op == FP_COV_OP_ADD) {
+        c_fp_add_trace(a, b, cov->width, rm, trace);
+    } else {
+        c_fp_mul_trace(a, b, cov->width, rm, trace);
+    }
+}
+
+// Collects the bins hit by one operation into hit[], returns their count
+static int cov_match(const fp_cov_s* cov, const fp_trace_s* t, int rm, int* hit) {
+    const int datapath = !t->special;
+    const int rounded = datapath && !t->exact_zero;
+    int n = 0;
+    for (int i = 0; i < cov->num_bins; i++) {
+        const fp_cov_bin_s* bin = &cov->bins[i];
+        int match = 0;
+        switch (bin->group) {
+            case FP_COV_GRP_CLASS:
+                match = (bin->p0 == t->class_a && bin->p1 == t->class_b);
+                break;
+            case FP_COV_GRP_EXP:
+                if (!datapath) {
+                    break;
+                }
+                if (cov->op == FP_COV_OP_ADD) {
+                    int sign = (t->exp_diff > 0) - (t->exp_diff < 0);
+                    int mag = abs(t->exp_diff);
+                    match = (sign == bin->p0 && mag >= bin->lo && mag <= bin->hi);
+                } else {
+                    match = (t->exp_res >= bin->lo && t->exp_res <= bin->hi);
+                }
+                break;
+            case FP_COV_GRP_NORM:
+                if (!datapath) {
+                    break;
+                }
+                if (bin->p0) {
+                    match = t->exact_zero;
+                } else {
+                    match = (!t->exact_zero && t->norm_shift >= bin->lo && t->norm_shift <= bin->hi);
+                }
+                break;
+            case FP_COV_GRP_GRS:
+                match = (rounded && bin->p0 == t->grs && bin->p1 == rm);
+                break;
+            case FP_COV_GRP_ROVF:
+                if (!rounded || !t->round_ovf) {
+                    break;
+                }
+                match = bin->p1 ? t->exp_ovf : (bin->p0 == rm);
+                break;
+            default:
+                break;
+        }
+        if (match) {
+            hit[n++] = i;
+        }
+    }
+    return n;
+}
+
+int fp_cov_sample(fp_cov_s* cov, uint64_t a, uint64_t b, int rm) {
+    fp_trace_s trace;
+    int hit[FP_COV_MAX_BINS];
+    int new_bins = 0;
+
+    cov_eval(cov, a, b, rm, &trace);
+    int n = cov_match(cov, &trace, rm, hit);
+    for (int i = 0; i < n; i++) {
+        if (cov->bins[hit[i]].hits++ == 0) {
+            new_bins++;
+        }
+    }
+    cov->num_hit += new_bins;
+    cov->samples++;
+    return new_bins;
+}
+
+//------------------------------------------------------------------------------
+// Baseline generators
+//------------------------------------------------------------------------------
+
+static uint64_t cov_pack(const fp_cov_s* cov, int sign, unsigned int exp, uint64_t mant) {
+    return ((uint64_t)sign << (cov->width - 1)) | ((uint64_t)exp << cov->mant_w) | mant;
+}
+
+// One operand as fp_transaction2 draws it (category_dist_c and values_c)
+static uint64_t cov_dist_operand(fp_cov_s* cov) {
+    const int M = cov->mant_w;
+    const int sign = cov_rand(cov) & 1;
+    const int r = cov_rand_range(cov, 0, 99);
+    if (r < 80) {  // NORMAL
+        return cov_pack(cov, sign, cov_rand_range(cov, 1, cov->exp_max - 1), cov_rand_bits(cov, M));
+    }
+    if (r < 85) {  // ZERO
+        return cov_pack(cov, sign, 0, 0);
+    }
+    if (r < 95) {  // INF
+        return cov_pack(cov, sign, cov->exp_max, 0);
+    }
+    uint64_t mant = cov_rand_bits(cov, M);  // QNAN (any non-zero mantissa)
+    return cov_pack(cov, sign, cov->exp_max, mant ? mant : 1);
+}
+
+//------------------------------------------------------------------------------
+// Steered generator
+//------------------------------------------------------------------------------
+
+static uint64_t cov_mant(fp_cov_s* cov, int style) {
+    const int M = cov->mant_w;
+    const uint64_t mask = (1ULL << M) - 1;
+    switch (style) {
+        case MANT_TRAILING0: {
+            int tz = cov_rand_range(cov, 0, M);
+            return (tz >= M) ? 0 : ((cov_rand_bits(cov, M) >> tz) << tz);
+        }
+        case MANT_ALL_ONES:
+            return mask;
+        default:
+            return cov_rand_bits(cov, M);
+    }
+}
+
+// Packs an operand of the given class; exp/mant are used where the class allows
+static uint64_t cov_operand(fp_cov_s* cov, int sign, int cls, int exp, uint64_t mant) {
+    switch (cls) {
+        case FP_CLASS_ZERO:
+            return cov_pack(cov, sign, 0, 0);
+        case FP_CLASS_DENORMAL:
+            return cov_pack(cov, sign, 0, mant ? mant : 1);
+        case FP_CLASS_INF:
+            return cov_pack(cov, sign, cov->exp_max, 0);
+        case FP_CLASS_NAN:
+            return cov_pack(cov, sign, cov->exp_max, mant ? mant : 1);
+        default:
+            return cov_pack(cov, sign, exp, mant);
+    }
+}
+
+// Turns the target bin into generation hints
+static void cov_hint(fp_cov_s* cov, int target, cov_hint_s* h) {
+    const fp_cov_bin_s* bin = &cov->bins[target];
+    const int M = cov->mant_w;
+    const int max_diff = cov->exp_max - 2;
+
+    memset(h, 0, sizeof(*h));
+    h->class_a = -1;
+    h->class_b = -1;
+    h->sign_res = -1;
+    h->rm = -1;
+    h->mant_a = (cov_rand(cov) & 1) ? MANT_TRAILING0 : MANT_UNIFORM;
+    h->mant_b = (cov_rand(cov) & 1) ? MANT_TRAILING0 : MANT_UNIFORM;
+
+    switch (bin->group) {
+        case FP_COV_GRP_CLASS:
+            h->class_a = bin->p0;
+            h->class_b = bin->p1;
+            break;
+
+        case FP_COV_GRP_EXP:
+            if (cov->op == FP_COV_OP_ADD) {
+                int hi = (bin->hi > max_diff) ? max_diff : bin->hi;
+                h->exp_mode = EXP_DIFF;
+                h->exp_lo = (bin->p0 < 0) ? -hi : bin->lo;
+                h->exp_hi = (bin->p0 < 0) ? -bin->lo : hi;
+            } else {
+                h->exp_mode = EXP_SUM;
+                h->exp_lo = bin->lo;
+                h->exp_hi = (bin->hi == COV_INF) ? bin->lo + M : bin->hi;
+            }
+            break;
+
+        case FP_COV_GRP_NORM:
+            if (cov->op == FP_COV_OP_MUL) {
+                break;  // About half of all products are >= 2.0
+            }
+            h->exp_mode = EXP_DIFF;
+            if (bin->p0) {  // Exact zero: x - x
+                h->sign_rel = SIGN_OPP;
+                h->mant_b = MANT_EQUAL;
+            } else if (bin->hi < 0) {  // Carry out: equal exponents always carry
+                h->sign_rel = SIGN_SAME;
+            } else if (bin->hi == 0) {  // No shift
+                h->exp_lo = 2;
+                h->exp_hi = (M < max_diff) ? M : max_diff;
+            } else {  // Cancellation of about k leading bits
+                int hi = (bin->hi > M + 2) ? M + 2 : bin->hi;
+                h->sign_rel = SIGN_OPP;
+                h->k = cov_rand_range(cov, bin->lo, hi);
+                if (h->k > M || (cov_rand(cov) & 1)) {
+                    h->exp_lo = h->exp_hi = 1;
+                    h->mant_b = MANT_BORROW;
+                    h->k = (h->k > M) ? M : h->k - 1;
+                } else {
+                    h->mant_b = MANT_SHARED;
+                }
+            }
+            break;
+
+        case FP_COV_GRP_GRS:
+            h->rm = bin->p1;
+            if (cov->op == FP_COV_OP_ADD) {
+                int span = cov->precision_bits + 3;
+                span = (span > max_diff) ? max_diff : span;
+                h->exp_mode = EXP_DIFF;
+                h->exp_lo = -span;
+                h->exp_hi = span;
+            }
+            break;
+
+        case FP_COV_GRP_ROVF:
+            h->rm = (bin->p0 >= 0) ? bin->p0 : ((cov_rand(cov) & 1) ? RPI : RNE);
+            h->sign_res = (h->rm == RPI) ? 0 : (h->rm == RNI) ? 1 : -1;
+            if (cov->op == FP_COV_OP_ADD) {
+                // All-ones mantissa plus a value that only reaches the GRS bits
+                int hi = M + cov->precision_bits + 1;
+                h->exp_mode = EXP_DIFF;
+                h->exp_lo = (M + 1 > max_diff) ? max_diff : M + 1;
+                h->exp_hi = (hi > max_diff) ? max_diff : hi;
+                h->exp_top = bin->p1;
+                h->sign_rel = SIGN_SAME;
+                h->mant_a = MANT_ALL_ONES;
+                h->mant_b = MANT_UNIFORM;
+            } else {
+                // Product just below 2.0
+                h->exp_mode = EXP_SUM;
+                h->exp_lo = bin->p1 ? cov->exp_max - 1 : 2;
+                h->exp_hi = bin->p1 ? cov->exp_max - 1 : cov->exp_max - 2;
+                h->mant_a = MANT_UNIFORM;
+                h->mant_b = MANT_RECIP;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Builds one candidate operand pair from the hints
+static void cov_build(fp_cov_s* cov, const cov_hint_s* h, uint64_t* a, uint64_t* b, int* rm) {
+    const int M = cov->mant_w;
+    const uint64_t mask = (1ULL << M) - 1;
+    const int top = cov->exp_max - 1;
+    int class_a = (h->class_a < 0) ? FP_CLASS_NORMAL : h->class_a;
+    int class_b = (h->class_b < 0) ? FP_CLASS_NORMAL : h->class_b;
+
+    // Exponents (effective, 1..exp_max-1)
+    int exp_a = cov_rand_range(cov, 1, top);
+    int exp_b = cov_rand_range(cov, 1, top);
+    if (h->exp_mode == EXP_DIFF) {
+        int d = cov_rand_range(cov, h->exp_lo, h->exp_hi);
+        int m = abs(d);
+        int big = h->exp_top ? top : cov_rand_range(cov, 1 + m, top);
+        exp_a = (d >= 0) ? big : big - m;
+        exp_b = (d >= 0) ? big - m : big;
+    } else if (h->exp_mode == EXP_SUM) {
+        // The product exponent is exp_a + exp_b - bias, +1 when the product is >= 2.0
+        int sum = cov_rand_range(cov, h->exp_lo, h->exp_hi) + cov->bias - (int)(cov_rand(cov) & 1);
+        int lo = (sum - top > 1) ? sum - top : 1;
+        int hi = (sum - 1 < top) ? sum - 1 : top;
+        exp_a = (lo <= hi) ? cov_rand_range(cov, lo, hi) : ((sum < 2) ? 1 : top);
+        exp_b = sum - exp_a;
+        exp_b = (exp_b < 1) ? 1 : (exp_b > top) ? top : exp_b;
+    }
+
+    // Finite operands at the minimum exponent are sometimes denormal
+    if (h->class_a < 0 && exp_a == 1 && (cov_rand(cov) & 3) == 0) {
+        class_a = FP_CLASS_DENORMAL;
+    }
+    if (h->class_b < 0 && exp_b == 1 && (cov_rand(cov) & 3) == 0 && h->mant_b != MANT_RECIP) {
+        class_b = FP_CLASS_DENORMAL;
+    }
+
+    // Mantissas
+    uint64_t mant_a = cov_mant(cov, h->mant_a);
+    uint64_t mant_b;
+    switch (h->mant_b) {
+        case MANT_SHARED: {
+            int low = M - h->k + 1;
+            uint64_t low_mask = (low <= 0) ? 0 : (low >= M) ? mask : ((1ULL << low) - 1);
+            mant_b = (mant_a & ~low_mask) | (cov_rand_bits(cov, M) & low_mask);
+            break;
+        }
+        case MANT_BORROW:
+            mant_a &= mask >> h->k;
+            mant_b = mask ^ cov_rand_bits(cov, M - h->k);
+            break;
+        case MANT_RECIP: {
+            unsigned __int128 two = (unsigned __int128)1 << (2 * M + 1);
+            uint64_t sig_a = (class_a == FP_CLASS_DENORMAL) ? mant_a : ((1ULL << M) | mant_a);
+            uint64_t sig_b = sig_a ? (uint64_t)((two - 1) / sig_a) : mask;
+            mant_b = sig_b & mask;
+            break;
+        }
+        case MANT_EQUAL:
+            mant_b = mant_a;
+            break;
+        default:
+            mant_b = cov_mant(cov, h->mant_b);
+            break;
+    }
+
+    // Signs
+    int sign_a = cov_rand(cov) & 1;
+    int sign_b = cov_rand(cov) & 1;
+    if (h->sign_rel == SIGN_SAME) {
+        sign_b = sign_a;
+    } else if (h->sign_rel == SIGN_OPP) {
+        sign_b = !sign_a;
+    }
+    if (h->sign_res >= 0) {
+        if (cov->op == FP_COV_OP_MUL) {
+            sign_b = sign_a ^ h->sign_res;
+        } else if (h->sign_rel == SIGN_SAME) {
+            sign_a = sign_b = h->sign_res;
+        }
+    }
+
+    *a = cov_operand(cov, sign_a, class_a, exp_a, mant_a);
+    *b = cov_operand(cov, sign_b, class_b, exp_b, mant_b);
+    *rm = (h->rm >= 0) ? h->rm : cov_rand_range(cov, RNE, RNA);
+}
+
+static void cov_next_steered(fp_cov_s* cov, uint64_t* a, uint64_t* b, int* rm) {
+    // Target a random unhit bin, or once all are hit, a random least-hit bin
+    uint64_t min_hits = UINT64_MAX;
+    int num_min = 0;
+    for (int i = 0; i < cov->num_bins; i++) {
+        if (cov->bins[i].hits < min_hits) {
+            min_hits = cov->bins[i].hits;
+            num_min = 0;
+        }
+        num_min += (cov->bins[i].hits == min_hits);
+    }
+    int pick = cov_rand_range(cov, 0, num_min - 1);
+    int target = 0;
+    for (int i = 0; i < cov->num_bins; i++) {
+        if (cov->bins[i].hits == min_hits && pick-- == 0) {
+            target = i;
+            break;
+        }
+    }
+
+    // Evaluate a batch of candidates on the model, keep the first one that hits
+    // the target, else the one that hits the most unhit bins
+    cov_hint_s hint;
+    cov_hint(cov, target, &hint);
+    int best_new = -1;
+    for (int c = 0; c < cov->candidates; c++) {
+        uint64_t ca, cb;
+        int crm;
+        fp_trace_s trace;
+        int hit[FP_COV_MAX_BINS];
+
+        cov_build(cov, &hint, &ca, &cb, &crm);
+        cov_eval(cov, ca, cb, crm, &trace);
+        int n = cov_match(cov, &trace, crm, hit);
+        int new_bins = 0;
+        int on_target = 0;
+        for (int i = 0; i < n; i++) {
+            new_bins += (cov->bins[hit[i]].hits == 0);
+            on_target |= (hit[i] == target);
+        }
+        if (on_target || new_bins > best_new) {
+            *a = ca;
+            *b = cb;
+            *rm = crm;
+            best_new = new_bins;
+        }
+        if (on_target) {
+            break;
+        }
+    }
+}
+
+void fp_cov_generate(fp_cov_s* cov, uint64_t* a, uint64_t* b, int* rm) {
+    switch (cov->gen) {
+        case FP_COV_GEN_DIST:
+            *a = cov_dist_operand(cov);
+            *b = cov_dist_operand(cov);
+            *rm = cov_rand_range(cov, RNE, RNA);
+            break;
+        case FP_COV_GEN_UNIFORM:
+            *a = cov_rand_bits(cov, cov->width);
+            *b = cov_rand_bits(cov, cov->width);
+            *rm = cov_rand_range(cov, RNE, RNA);
+            break;
+        default:
+            cov_next_steered(cov, a, b, rm);
+            break;
+    }
+}
+
+void fp_cov_next(fp_cov_s* cov, uint64_t* a, uint64_t* b, int* rm) {
+    fp_cov_generate(cov, a, b, rm);
+    fp_cov_sample(cov, *a, *b, *rm);
+}
+
+//------------------------------------------------------------------------------
+// Reporting
+//------------------------------------------------------------------------------
+
+static void cov_range_name(char* buf, int len, const char* prefix, int lo, int hi) {
+    if (lo == hi) {
+        snprintf(buf, len, "%s=%d", prefix, lo);
+    } else if (hi == COV_INF) {
+        snprintf(buf, len, "%s=[%d:inf]", prefix, lo);
+    } else {
+        snprintf(buf, len, "%s=[%d:%d]", prefix, lo, hi);
+    }
+}
+
+void fp_cov_bin_name(const fp_cov_s* cov, int bin_idx, char* buf, int len) {
+    const fp_cov_bin_s* bin = &cov->bins[bin_idx];
+    switch (bin->group) {
+        case FP_COV_GRP_CLASS:
+            snprintf(buf, len, "%s,%s", cov_class_names[bin->p0], cov_class_names[bin->p1]);
+            break;
+        case FP_COV_GRP_EXP:
+            if (cov->op == FP_COV_OP_ADD) {
+                cov_range_name(buf, len, (bin->p0 < 0) ? "exp_diff-" : (bin->p0 > 0) ? "exp_diff+" : "exp_diff", bin->lo, bin->hi);
+            } else {
+                cov_range_name(buf, len, "exp", bin->lo, bin->hi);
+            }
+            break;
+        case FP_COV_GRP_NORM:
+            if (bin->p0) {
+                snprintf(buf, len, "exact_zero");
+            } else if (cov->op == FP_COV_OP_MUL) {
+                snprintf(buf, len, bin->lo ? "product>=2" : "product<2");
+            } else if (bin->hi < 0) {
+                snprintf(buf, len, "carry_out");
+            } else {
+                cov_range_name(buf, len, "shift", bin->lo, bin->hi);
+            }
+            break;
+        case FP_COV_GRP_GRS:
+            snprintf(buf, len, "grs=%d%d%d/%s", (bin->p0 >> 2) & 1, (bin->p0 >> 1) & 1, bin->p0 & 1, cov_rm_names[bin->p1]);
+            break;
+        case FP_COV_GRP_ROVF:
+            if (bin->p1) {
+                snprintf(buf, len, "round_ovf_to_inf");
+            } else {
+                snprintf(buf, len, "round_ovf/%s", cov_rm_names[bin->p0]);
+            }
+            break;
+        default:
+            snprintf(buf, len, "?");
+            break;
+    }
+}
+
+void fp_cov_report(const fp_cov_s* cov, FILE* out) {
+    fprintf(out, "FP_COV: %s%d gen=%s samples=%llu coverage=%d/%d (%.1f%%)\n",
+            (cov->op == FP_COV_OP_ADD) ? "fp_add" : "fp_mul", cov->width, cov_gen_names[cov->gen],
+            (unsigned long long)cov->samples, cov->num_hit, cov->num_bins,
+            cov->num_bins ? 100.0 * cov->num_hit / cov->num_bins : 0.0);
+    for (int g = 0; g < FP_COV_NUM_GROUPS; g++) {
+        int total = 0, hit = 0;
+        for (int i = 0; i < cov->num_bins; i++) {
+            if (cov->bins[i].group == g) {
+                total++;
+                hit += (cov->bins[i].hits != 0);
+            }
+        }
+        fprintf(out, "FP_COV:   %-5s %3d/%-3d", cov_group_names[g], hit, total);
+        int listed = 0;
+        for (int i = 0; i < cov->num_bins; i++) {
+            if (cov->bins[i].group == g && cov->bins[i].hits == 0) {
+                char name[64];
+                fp_cov_bin_name(cov, i, name, sizeof(name));
+                fprintf(out, "%s%s", listed++ ? ", " : "  unhit: ", name);
+            }
+        }
+        fprintf(out, "\n");
+    }
+}
+
+//------------------------------------------------------------------------------
+// DPI-C API
+//------------------------------------------------------------------------------
+
+// One context per c_fp_cov_init() call, so that steered sequences running
+// side by side (e.g. in the fp_multi top) keep separate coverage
+static fp_cov_s* g_cov[FP_COV_MAX_CONTEXTS];
+static int g_cov_count = 0;
+
+static fp_cov_s* cov_context(int handle) {
+    return (handle >= 0 && handle < g_cov_count) ? g_cov[handle] : NULL;
+}
+
+// Returns the handle of a new context, or -1 for an unsupported op/width/gen
+// or when all FP_COV_MAX_CONTEXTS contexts are in use
+int c_fp_cov_init(const int op, const int width, const int gen, const int seed) {
+    fp_cov_s* cov;
+    if (g_cov_count == FP_COV_MAX_CONTEXTS) {
+        return -1;
+    }
+    cov = (fp_cov_s*)malloc(sizeof(fp_cov_s));
+    if (cov == NULL) {
+        return -1;
+    }
+    if (fp_cov_init(cov, op, width, gen, (uint64_t)(uint32_t)seed) <= 0) {
+        free(cov);
+        return -1;
+    }
+    g_cov[g_cov_count] = cov;
+    return g_cov_count++;
+}
+
+// Generates the next operands. They are not sampled: the testbench samples
+// the operations the DUT actually ran with c_fp_cov_sample().
+void c_fp_cov_next(const int handle, uint64_t* a, uint64_t* b, int* rm) {
+    fp_cov_s* cov = cov_context(handle);
+    if (cov == NULL) {
+        *a = 0;
+        *b = 0;
+        *rm = RNE;
+        return;
+    }
+    fp_cov_generate(cov, a, b, rm);
+}
+
+// Samples one operation into the coverage
+void c_fp_cov_sample(const int handle, const uint64_t a, const uint64_t b, const int rm) {
+    fp_cov_s* cov = cov_context(handle);
+    if (cov != NULL) {
+        fp_cov_sample(cov, a, b, rm);
+    }
+}
+
+int c_fp_cov_bins(const int handle) {
+    fp_cov_s* cov = cov_context(handle);
+    return cov != NULL ? cov->num_bins : 0;
+}
+
+int c_fp_cov_hit(const int handle) {
+    fp_cov_s* cov = cov_context(handle);
+    return cov != NULL ? cov->num_hit : 0;
+}
+
+void c_fp_cov_report(const int handle) {
+    fp_cov_s* cov = cov_context(handle);
+    if (cov != NULL) {
+        fp_cov_report(cov, stdout);
+        fflush(stdout);
+    }
+}
@@ -0,0 +1,89 @@
+// verif/lib/fp_cov_steer.h
+//
+// Closed-loop coverage model and stimulus steering for the fp_add / fp_mul
+// testbenches.
+//
+// Coverage bins are computed from the datapath trace of the bit-accurate C
+// models (fp_trace_s), so they see internal events such as the alignment
+// shift, cancellation depth, GRS pattern and rounding overflow, not only the
+// operand encodings. The steered generator picks an unhit bin, builds a batch
+// of candidate operands biased toward it and keeps the candidate that hits it
+// (or the one that hits the most unhit bins).
+//
+// The same code serves the UVM sequences (DPI-C wrappers c_fp_cov_*, on the
+// context whose handle c_fp_cov_init() returned) and native harnesses
+// (fp_cov_* on a caller-owned context).
+// Natively every generated operation is sampled (fp_cov_next()); in the
+// testbench the generator only draws operands (c_fp_cov_next()) and the
+// model samples the operations observed at the DUT (c_fp_cov_sample()), so
+// the coverage and the steering follow what the DUT actually ran.
+//
+
+#ifndef FP_COV_STEER_H
+#define FP_COV_STEER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "fp_model.h"
+
+// Operation under test
+#define FP_COV_OP_ADD 0
+#define FP_COV_OP_MUL 1
+
+// Stimulus generators
+#define FP_COV_GEN_DIST    0  // Category distribution of fp_transaction2 (80/5/10/5)
+#define FP_COV_GEN_UNIFORM 1  // Uniformly random bit patterns
+#define FP_COV_GEN_STEERED 2  // Coverage-steered
+
+// Coverage groups
+#define FP_COV_GRP_CLASS 0  // Operand class pair (zero/denormal/normal/inf/nan)
+#define FP_COV_GRP_EXP   1  // fp_add: exponent difference, fp_mul: product exponent range
+#define FP_COV_GRP_NORM  2  // fp_add: carry out / cancellation depth, fp_mul: product >= 2.0
+#define FP_COV_GRP_GRS   3  // GRS pattern x rounding mode
+#define FP_COV_GRP_ROVF  4  // Rounding overflow per rounding mode, and into infinity
+#define FP_COV_NUM_GROUPS 5
+
+#define FP_COV_MAX_BINS 128
+#define FP_COV_MAX_CANDIDATES 256
+#define FP_COV_MAX_CONTEXTS 64  // DPI-C contexts (c_fp_cov_init() calls) per simulation
+
+// One coverage bin. The meaning of p0/p1/lo/hi depends on the group.
+typedef struct {
+    int group;
+    int p0, p1;  // CLASS: class_a/class_b, GRS: pattern/rm, ROVF: rm/into_inf, EXP(add): sign of exp_diff, NORM(add): exact zero
+    int lo, hi;  // EXP/NORM: inclusive value range
+    uint64_t hits;
+} fp_cov_bin_s;
+
+// Coverage and generator state
+typedef struct {
+    int op;
+    int width;
+    int gen;
+    int candidates;  // Candidates evaluated per steered operation
+    int exp_w, mant_w, bias, exp_max, precision_bits;
+    uint64_t rng;
+    int num_bins;
+    int num_hit;
+    uint64_t samples;
+    fp_cov_bin_s bins[FP_COV_MAX_BINS];
+} fp_cov_s;
+
+// Native API
+int  fp_cov_init(fp_cov_s* cov, int op, int width, int gen, uint64_t seed);
+int  fp_cov_sample(fp_cov_s* cov, uint64_t a, uint64_t b, int rm);
+void fp_cov_generate(fp_cov_s* cov, uint64_t* a, uint64_t* b, int* rm);  // Without sampling
+void fp_cov_next(fp_cov_s* cov, uint64_t* a, uint64_t* b, int* rm);      // fp_cov_generate() + fp_cov_sample()
+void fp_cov_bin_name(const fp_cov_s* cov, int bin, char* buf, int len);
+void fp_cov_report(const fp_cov_s* cov, FILE* out);
+
+// DPI-C API (handle returned by c_fp_cov_init(), -1 on failure)
+int  c_fp_cov_init(int op, int width, int gen, int seed);
+void c_fp_cov_next(int handle, uint64_t* a, uint64_t* b, int* rm);
+void c_fp_cov_sample(int handle, uint64_t a, uint64_t b, int rm);
+int  c_fp_cov_bins(int handle);
+int  c_fp_cov_hit(int handle);
+void c_fp_cov_report(int handle);
+
+#endif // FP_COV_STEER_H
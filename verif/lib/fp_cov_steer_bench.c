@@ -0,0 +1,119 @@
+// verif/lib/fp_cov_steer_bench.c
+//
+// Native harness for the coverage steering in fp_cov_steer.c.
+//
+// Runs each stimulus generator on the C models until all coverage bins are
+// hit (or --max operations) and reports the operations and time it took.
+// The "dist" generator is the fp_transaction2 category distribution used by
+// fp_sequence2_random, "uniform" draws random bit patterns and "steered"
+// closes the loop through the coverage bins.
+//
+// Build and run (see native.mk):
+//   make -f native.mk cov_steer
+//   build/native/fp_cov_steer_bench [--op add|mul] [--width 16|32|64] [--max N] [--trials N] [--seed N] [--report]
+//
+// Returns non-zero if the steered generator misses any bin.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fp_model.h"
+#include "fp_cov_steer.h"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char** argv) {
+    int ops[2] = {FP_COV_OP_ADD, FP_COV_OP_MUL};
+    int num_ops = 2;
+    int widths[3] = {16, 32, 64};
+    int num_widths = 3;
+    uint64_t max_samples = 1000000;
+    int trials = 3;
+    uint64_t seed = 1;
+    int report = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--op") && i + 1 < argc) {
+            ops[0] = strcmp(argv[++i], "mul") ? FP_COV_OP_ADD : FP_COV_OP_MUL;
+            num_ops = 1;
+        } else if (!strcmp(argv[i], "--width") && i + 1 < argc) {
+            widths[0] = atoi(argv[++i]);
+            num_widths = 1;
+        } else if (!strcmp(argv[i], "--max") && i + 1 < argc) {
+            max_samples = strtoull(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--trials") && i + 1 < argc) {
+            trials = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--report")) {
+            report = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--op add|mul] [--width 16|32|64] [--max N] [--trials N] [--seed N] [--report]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    static const char* const gen_names[3] = {"dist", "uniform", "steered"};
+    int steered_misses = 0;
+
+    printf("%-6s | %-5s | %-8s | %-9s | %-12s | %-10s\n", "OP", "WIDTH", "GEN", "BINS", "OPS TO 100%", "TIME (ms)");
+    printf("-------+-------+----------+-----------+--------------+-----------\n");
+    for (int o = 0; o < num_ops; o++) {
+        for (int w = 0; w < num_widths; w++) {
+            for (int gen = FP_COV_GEN_DIST; gen <= FP_COV_GEN_STEERED; gen++) {
+                uint64_t total_samples = 0;
+                double total_time = 0.0;
+                int reached = 0;
+                int min_hit = -1;
+                fp_cov_s cov;
+
+                for (int t = 0; t < trials; t++) {
+                    if (fp_cov_init(&cov, ops[o], widths[w], gen, seed + t) < 0) {
+                        fprintf(stderr, "Unsupported width %d\n", widths[w]);
+                        return 2;
+                    }
+                    double start = now_sec();
+                    while (cov.num_hit < cov.num_bins && cov.samples < max_samples) {
+                        uint64_t a, b;
+                        int rm;
+                        fp_cov_next(&cov, &a, &b, &rm);
+                    }
+                    total_time += now_sec() - start;
+                    total_samples += cov.samples;
+                    reached += (cov.num_hit == cov.num_bins);
+                    if (min_hit < 0 || cov.num_hit < min_hit) {
+                        min_hit = cov.num_hit;
+                    }
+                    if (report && t == 0) {
+                        fp_cov_report(&cov, stdout);
+                    }
+                }
+
+                char bins[16], samples[24];
+                snprintf(bins, sizeof(bins), "%d/%d", min_hit, cov.num_bins);
+                if (reached == trials) {
+                    snprintf(samples, sizeof(samples), "%llu", (unsigned long long)(total_samples / trials));
+                } else {
+                    snprintf(samples, sizeof(samples), ">%llu", (unsigned long long)max_samples);
+                }
+                printf("%-6s | %-5d | %-8s | %-9s | %-12s | %-10.1f\n", (ops[o] == FP_COV_OP_ADD) ? "fp_add" : "fp_mul",
+                       widths[w], gen_names[gen], bins, samples, 1000.0 * total_time / trials);
+                if (gen == FP_COV_GEN_STEERED && reached != trials) {
+                    steered_misses++;
+                }
+            }
+        }
+    }
+
+    printf("\n%s : steered generator reached full coverage in %s\n", steered_misses ? "FAIL" : "PASS",
+           steered_misses ? "not all runs" : "all runs");
+    return steered_misses ? 1 : 0;
+}
@@ -11,4 +11,25 @@ package fp_dpi_pkg;
     import "DPI-C" function int unsigned      c_real_to_fp32_bits(real val);
     import "DPI-C" function longint unsigned  c_real_to_fp64_bits(real val);
 
+    // Coverage-steered stimulus (fp_cov_steer.c)
+    // op : 0 - fp_add, 1 - fp_mul
+    // gen: 0 - fp_transaction2 distribution, 1 - uniform bit patterns, 2 - steered
+    // c_fp_cov_init returns the handle of a new coverage context (-1 on failure)
+    import "DPI-C" function int  c_fp_cov_init(int op, int width, int gen, int seed);
+    import "DPI-C" function void c_fp_cov_next(int handle, output longint unsigned a, output longint unsigned b, output int rm);
+    import "DPI-C" function void c_fp_cov_sample(int handle, longint unsigned a, longint unsigned b, int rm);
+    import "DPI-C" function int  c_fp_cov_bins(int handle);
+    import "DPI-C" function int  c_fp_cov_hit(int handle);
+    import "DPI-C" function void c_fp_cov_report(int handle);
+
+    // Inverse operand construction (fp_inverse.c)
+    // op    : 0 - fp_add, 1 - fp_mul, 2 - FMA (c is the addend)
+    // target: FP_INV_* in fp_inverse.h, exp: 32'h8000_0000 for a random exponent, sign: -1 for random
+    import "DPI-C" function int  c_fp_inv_init(int op, int width, int seed);
+    import "DPI-C" function int  c_fp_inv_make(int target, int param, int exp, int rm, int sign,
+                                               output longint unsigned a, output longint unsigned b, output longint unsigned c);
+
+    // Dual-path predictor counters (fp_fast.c), op: 0 - fp_add, 1 - fp_mul
+    import "DPI-C" function void c_fp_fast_counts(int op, output longint unsigned calls, output longint unsigned hits);
+
 endpackage
\ No newline at end of file
@@ -2,6 +2,10 @@
 //
 // Generic, parameterized base class for a driver. It contains a pure
 // virtual task 'drive_transfer' that MUST be implemented by a child class.
+//
+// Items with burst_size() > 0 are streamed one operand set per clock through
+// 'drive_burst_element' (implemented by drivers that support burst mode),
+// with a single sequencer handshake and broadcast for the whole burst.
 
 `include "uvm_macros.svh"
 import uvm_pkg::*;
@@ -33,12 +37,34 @@ virtual class fp_driver_base #(
             @(posedge vif.clk);
             seq_item_port.get_next_item(req);
             pre_drive();
-            drive_transfer(req);
-            ap.write(req); // Broadcast the driven transaction
+            req.prepare_burst();
+            if (req.burst_size() > 0) begin
+                drive_burst(req);
+            end else begin
+                drive_transfer(req);
+                ap.write(req); // Broadcast the driven transaction
+            end
             seq_item_port.item_done();
         end
     endtask
 
+    // Streams a burst, one element per clock. The burst item is broadcast once,
+    // up front, so the monitor knows how many results belong to it.
+    virtual task drive_burst(T_TRANS trans);
+        ap.write(trans);
+        for (int i = 0; i < trans.burst_size(); i++) begin
+            if (i > 0) begin
+                @(posedge vif.clk);
+                pre_drive();
+            end
+            drive_burst_element(trans, i);
+        end
+    endtask
+
+    virtual task drive_burst_element(T_TRANS trans, int i);
+        `uvm_fatal("NO_BURST", $sformatf("%s does not support burst mode", get_type_name()))
+    endtask
+
     // This task provides the #epsilon delay. It can be overridden in child
     // classes if a different delay is needed.
     virtual task pre_drive();
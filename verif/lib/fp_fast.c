@@ -0,0 +1,269 @@
+// verif/lib/fp_fast.c
+//
+// Dual-path golden predictor for fp_add / fp_mul.
+// See fp_fast.h for the overview and the fallback rules.
+//
+
+#include <fenv.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Standard DPI-C inclusion for simulator integration
+#include "svdpi.h"
+
+#include "fp_model.h"
+#include "fp_fast.h"
+
+#define FAST_ADD_PRECISION_BITS 7  // As in c_fp_add() for WIDTH 32 / 64
+
+// Operands per native kernel call
+#define FAST_CHUNK 256
+
+static const char* const fast_path_names[FP_FAST_NUM_PATHS] = {
+    "native", "width", "rm", "special", "denormal", "align", "sticky", "range"};
+static const char* const fast_op_names[2] = {"fp_add", "fp_mul"};
+
+// Format constants of a native width
+typedef struct {
+    int mant_w;
+    uint64_t exp_max;     // All-ones exponent field
+    uint64_t abs_mask;    // All bits but the sign
+    uint64_t max_finite;  // Largest finite magnitude
+} fast_fmt_s;
+
+static int fast_fmt(int width, fast_fmt_s* f) {
+    switch (width) {
+        case 32: f->mant_w = 23; f->exp_max = 0xFF;  break;
+        case 64: f->mant_w = 52; f->exp_max = 0x7FF; break;
+        default: return 0;
+    }
+    f->abs_mask = (width == 64) ? ~0ULL >> 1 : (1ULL << (width - 1)) - 1;
+    f->max_finite = ((f->exp_max - 1) << f->mant_w) | ((1ULL << f->mant_w) - 1);
+    return 1;
+}
+
+// <fenv.h> rounding mode of rm, -1 if the host has none
+static int fast_fe_mode(int rm) {
+    switch (rm) {
+        case RNE: return FE_TONEAREST;
+#if defined(FE_TOWARDZERO) && defined(FE_UPWARD) && defined(FE_DOWNWARD)
+        case RTZ: return FE_TOWARDZERO;
+        case RPI: return FE_UPWARD;
+        case RNI: return FE_DOWNWARD;
+#endif
+        default:  return -1;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Native kernels. They are kept out of line and work through memory, so the
+// compiler cannot move the arithmetic across the fesetround() calls around
+// them (the C model files are not built with -frounding-math).
+//------------------------------------------------------------------------------
+
+__attribute__((noinline))
+static void fast_native(int op, int width, const uint64_t* a, const uint64_t* b, uint64_t* r, int n) {
+    if (width == 32) {
+        for (int i = 0; i < n; i++) {
+            float_conv x = {.u = (uint32_t)a[i]}, y = {.u = (uint32_t)b[i]}, z;
+            z.f = (op == FP_FAST_OP_MUL) ? x.f * y.f : x.f + y.f;
+            r[i] = z.u;
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            double_conv x = {.u = a[i]}, y = {.u = b[i]}, z;
+            z.d = (op == FP_FAST_OP_MUL) ? x.d * y.d : x.d + y.d;
+            r[i] = z.u;
+        }
+    }
+}
+
+// Runs the native kernel in the rounding mode of rm and restores the caller's mode
+static void fast_native_rm(int op, int width, int fe_mode, const uint64_t* a, const uint64_t* b, uint64_t* r, int n) {
+    const int saved = fegetround();
+    if (saved != fe_mode) {
+        fesetround(fe_mode);
+    }
+    fast_native(op, width, a, b, r, n);
+    if (saved != fe_mode) {
+        fesetround(saved);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Classification
+//------------------------------------------------------------------------------
+
+// Path from the operands alone (FP_FAST_HIT: the native result still has to pass fast_check_result())
+static int fast_classify(int op, const fast_fmt_s* f, int rm, uint64_t a, uint64_t b) {
+    const int M = f->mant_w;
+    const uint64_t exp_a = (a >> M) & f->exp_max;
+    const uint64_t exp_b = (b >> M) & f->exp_max;
+
+    if (exp_a == f->exp_max || exp_b == f->exp_max || !(a & f->abs_mask) || !(b & f->abs_mask)) {
+        return FP_FAST_SPECIAL;
+    }
+
+    if (op == FP_FAST_OP_ADD) {
+        // The model aligns into precision_bits below the mantissa and drops the
+        // rest. Shifts up to precision_bits - 1 keep every bit (and leave the
+        // LSB free for the carry-out shift). From M + 3 on, the smaller operand
+        // is below a quarter ULP, which only RNE ignores both with and without
+        // the dropped bits.
+        const int eff_a = exp_a ? (int)exp_a : 1;
+        const int eff_b = exp_b ? (int)exp_b : 1;
+        const int diff = (eff_a > eff_b) ? eff_a - eff_b : eff_b - eff_a;
+        if (diff >= FAST_ADD_PRECISION_BITS && !(rm == RNE && diff >= M + 3)) {
+            return FP_FAST_ALIGN;
+        }
+        return FP_FAST_HIT;
+    }
+
+    if (!exp_a || !exp_b) {
+        return FP_FAST_DENORMAL;
+    }
+    // With the product >= 2.0 the model shifts it right by one before rounding,
+    // so its LSB is missing from the sticky bit. That only matters if it is the
+    // only set bit below the round bit.
+    if (a & b & 1) {
+        const uint64_t mant_mask = (1ULL << M) - 1;
+        const unsigned __int128 product = (unsigned __int128)((a & mant_mask) | (1ULL << M)) *
+                                          ((b & mant_mask) | (1ULL << M));
+        const uint64_t below_round = (uint64_t)product & ((1ULL << (M - 1)) - 1);
+        if (((product >> (2 * M + 1)) & 1) && below_round == 1) {
+            return FP_FAST_STICKY;
+        }
+    }
+    return FP_FAST_HIT;
+}
+
+// The model flushes denormal results and overflows to Inf also where IEEE
+// rounds to the largest finite value, so results next to either end fall back
+static int fast_check_result(const fast_fmt_s* f, uint64_t r) {
+    const uint64_t mag = r & f->abs_mask;
+    return ((mag >> f->mant_w) <= 1 || mag >= f->max_finite) ? FP_FAST_RANGE : FP_FAST_HIT;
+}
+
+static uint64_t fast_model(int op, int width, int rm, uint64_t a, uint64_t b) {
+    return (op == FP_FAST_OP_MUL) ? c_fp_mul(a, b, width, rm) : c_fp_add(a, b, width, rm);
+}
+
+//------------------------------------------------------------------------------
+// Native API
+//------------------------------------------------------------------------------
+
+// Predicts a[0..n-1] op b[0..n-1]. path (may be NULL) receives the path of
+// each pair, stats (may be NULL) is incremented.
+void fp_fast_batch(int op, int width, int rm, const uint64_t* a, const uint64_t* b, uint64_t* result, int n,
+                   int* path, fp_fast_stats_s* stats) {
+    fast_fmt_s f;
+    const int fe_mode = fast_fe_mode(rm);
+    const int fixed_path = !fast_fmt(width, &f) ? FP_FAST_WIDTH : (fe_mode < 0) ? FP_FAST_RM : FP_FAST_HIT;
+
+    if (fixed_path != FP_FAST_HIT) {
+        for (int i = 0; i < n; i++) {
+            result[i] = fast_model(op, width, rm, a[i], b[i]);
+            if (path) {
+                path[i] = fixed_path;
+            }
+        }
+        if (stats) {
+            stats->calls += n;
+            stats->paths[fixed_path] += n;
+        }
+        return;
+    }
+
+    // The whole batch goes through the FPU (vectorized, one rounding mode
+    // switch), the pairs that fail the classification are then recomputed
+    for (int i = 0; i < n; i += FAST_CHUNK) {
+        fast_native_rm(op, width, fe_mode, a + i, b + i, result + i, (n - i < FAST_CHUNK) ? n - i : FAST_CHUNK);
+    }
+    for (int i = 0; i < n; i++) {
+        int p = fast_classify(op, &f, rm, a[i], b[i]);
+        if (p == FP_FAST_HIT) {
+            p = fast_check_result(&f, result[i]);
+        }
+        if (p != FP_FAST_HIT) {
+            result[i] = fast_model(op, width, rm, a[i], b[i]);
+        }
+        if (path) {
+            path[i] = p;
+        }
+        if (stats) {
+            stats->paths[p]++;
+        }
+    }
+    if (stats) {
+        stats->calls += n;
+    }
+}
+
+// Single pair, the FPU is only used if the operands pass the classification
+uint64_t fp_fast_one(int op, int width, int rm, uint64_t a, uint64_t b, int* path, fp_fast_stats_s* stats) {
+    fast_fmt_s f;
+    const int fe_mode = fast_fe_mode(rm);
+    uint64_t result = 0;
+    int p;
+
+    if (!fast_fmt(width, &f)) {
+        p = FP_FAST_WIDTH;
+    } else if (fe_mode < 0) {
+        p = FP_FAST_RM;
+    } else {
+        p = fast_classify(op, &f, rm, a, b);
+        if (p == FP_FAST_HIT) {
+            fast_native_rm(op, width, fe_mode, &a, &b, &result, 1);
+            p = fast_check_result(&f, result);
+        }
+    }
+    if (p != FP_FAST_HIT) {
+        result = fast_model(op, width, rm, a, b);
+    }
+    if (path) {
+        *path = p;
+    }
+    if (stats) {
+        stats->calls++;
+        stats->paths[p]++;
+    }
+    return result;
+}
+
+// Hit rate and fallback reasons
+void fp_fast_report(FILE* out, int op, const fp_fast_stats_s* stats) {
+    const double calls = stats->calls ? (double)stats->calls : 1.0;
+    fprintf(out, "%s: %llu predictions, %.1f%% native", fast_op_names[op], (unsigned long long)stats->calls,
+            100.0 * stats->paths[FP_FAST_HIT] / calls);
+    for (int p = 1; p < FP_FAST_NUM_PATHS; p++) {
+        if (stats->paths[p]) {
+            fprintf(out, ", %s %.1f%%", fast_path_names[p], 100.0 * stats->paths[p] / calls);
+        }
+    }
+    fprintf(out, "\n");
+}
+
+const char* fp_fast_path_name(int path) {
+    return (path >= 0 && path < FP_FAST_NUM_PATHS) ? fast_path_names[path] : "?";
+}
+
+//------------------------------------------------------------------------------
+// DPI-C API
+//------------------------------------------------------------------------------
+
+static fp_fast_stats_s g_fast_stats[2];
+
+uint64_t c_fp_add_fast(uint64_t a, uint64_t b, const int width, const int rm) {
+    return fp_fast_one(FP_FAST_OP_ADD, width, rm, a, b, NULL, &g_fast_stats[FP_FAST_OP_ADD]);
+}
+
+uint64_t c_fp_mul_fast(uint64_t a, uint64_t b, const int width, const int rm) {
+    return fp_fast_one(FP_FAST_OP_MUL, width, rm, a, b, NULL, &g_fast_stats[FP_FAST_OP_MUL]);
+}
+
+void c_fp_fast_counts(int op, uint64_t* calls, uint64_t* hits) {
+    const fp_fast_stats_s* stats = &g_fast_stats[op == FP_FAST_OP_MUL];
+    *calls = stats->calls;
+    *hits = stats->paths[FP_FAST_HIT];
+}
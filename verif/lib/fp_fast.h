@@ -0,0 +1,65 @@
+// verif/lib/fp_fast.h
+//
+// Dual-path golden predictor for fp_add / fp_mul at WIDTH 32 and 64.
+//
+// Most operand pairs give the same result on the host FPU (float / double in
+// the requested rounding mode) as on the bit-accurate C models. Each operand
+// pair is classified cheaply and the native result is used only where the two
+// provably agree; everything else is recomputed with c_fp_add / c_fp_mul:
+//   - fp16 (no native format) and RNA (no native rounding mode);
+//   - zero, Inf or NaN operands (signed zero and NaN encodings differ);
+//   - fp_add: alignment shifts that drop bits the model truncates (it keeps
+//     only precision_bits below the mantissa, without sticky);
+//   - fp_mul: denormal operands (the model does not prenormalize them) and
+//     products whose last bit is dropped by the model's normalization shift
+//     when it decides the rounding;
+//   - results near the underflow / overflow boundary (the model flushes
+//     denormal results and overflows to Inf in every rounding mode).
+// fp_fast_bench.c proves the rules by comparing both paths over a sweep.
+//
+// The same code serves the UVM models (DPI-C wrappers c_fp_*_fast with global
+// counters, enabled with +FAST_MODEL) and native harnesses (fp_fast_batch).
+//
+
+#ifndef FP_FAST_H
+#define FP_FAST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "fp_model.h"
+
+// Operation
+#define FP_FAST_OP_ADD 0
+#define FP_FAST_OP_MUL 1
+
+// Path taken by one operand pair: FP_FAST_HIT or the reason for the fallback
+#define FP_FAST_HIT       0  // Native FPU result
+#define FP_FAST_WIDTH     1  // No native format (fp16)
+#define FP_FAST_RM        2  // No native rounding mode (RNA)
+#define FP_FAST_SPECIAL   3  // Zero, Inf or NaN operand
+#define FP_FAST_DENORMAL  4  // fp_mul: denormal operand
+#define FP_FAST_ALIGN     5  // fp_add: alignment shift truncated by the model
+#define FP_FAST_STICKY    6  // fp_mul: product LSB dropped by the model
+#define FP_FAST_RANGE     7  // Result near the underflow / overflow boundary
+#define FP_FAST_NUM_PATHS 8
+
+// Operand pairs per path
+typedef struct {
+    uint64_t calls;
+    uint64_t paths[FP_FAST_NUM_PATHS];
+} fp_fast_stats_s;
+
+// Native API
+void        fp_fast_batch(int op, int width, int rm, const uint64_t* a, const uint64_t* b, uint64_t* result, int n,
+                          int* path, fp_fast_stats_s* stats);
+uint64_t    fp_fast_one(int op, int width, int rm, uint64_t a, uint64_t b, int* path, fp_fast_stats_s* stats);
+void        fp_fast_report(FILE* out, int op, const fp_fast_stats_s* stats);
+const char* fp_fast_path_name(int path);
+
+// DPI-C API (counters shared by all callers)
+uint64_t c_fp_add_fast(uint64_t a, uint64_t b, const int width, const int rm);
+uint64_t c_fp_mul_fast(uint64_t a, uint64_t b, const int width, const int rm);
+void     c_fp_fast_counts(int op, uint64_t* calls, uint64_t* hits);
+
+#endif // FP_FAST_H
@@ -0,0 +1,323 @@
+// verif/lib/fp_fast_bench.c
+//
+// Native harness for the dual-path predictor in fp_fast.c.
+//
+// The benchmark runs fp_add / fp_mul at WIDTH 32 and 64 in every rounding
+// mode over two operand distributions ("uniform" random finite bit patterns,
+// "close" operands within a few binades of each other) and reports the native
+// hit rate and the time per prediction of the bit-accurate model, of
+// fp_fast_one() (the DPI-C path) and of fp_fast_batch(). Every prediction is
+// also checked against the model.
+//
+// --sweep instead proves the fallback rules: it runs structured operands
+// around every boundary the rules rely on (exponent differences up to past the
+// alignment window, product exponents around underflow and overflow, mantissa
+// patterns for ties and dropped sticky bits, zero / denormal / Inf / NaN) plus
+// random operands through both paths, and reports the pairs and mismatches per
+// path.
+//
+// Build and run (see native.mk):
+//   make -f native.mk fast
+//   build/native/fp_fast_bench [--op add|mul] [--width 32|64] [--count N] [--seed N] [--sweep]
+//
+// Returns non-zero if any prediction differs from the model.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fp_model.h"
+#include "fp_fast.h"
+
+#define BATCH 4096
+
+static const char* const op_names[2] = {"fp_add", "fp_mul"};
+static const char* const rm_names[5] = {"RNE", "RTZ", "RPI", "RNI", "RNA"};
+static const char* const dist_names[2] = {"uniform", "close"};
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static int mant_width(int width) {
+    return (width == 64) ? 52 : 23;
+}
+
+static int exp_max(int width) {
+    return (width == 64) ? 0x7FF : 0xFF;
+}
+
+static uint64_t pack(int width, int sign, int exp, uint64_t mant) {
+    const int M = mant_width(width);
+    return ((uint64_t)sign << (width - 1)) | ((uint64_t)exp << M) | (mant & ((1ULL << M) - 1));
+}
+
+// Operand pair of a distribution: uniform finite bit patterns, or b within 4 binades of a
+static void random_pair(int width, int dist, uint64_t* state, uint64_t* a, uint64_t* b) {
+    const int M = mant_width(width);
+    const int E = exp_max(width);
+    const uint64_t r = rand_u64(state);
+    const int exp_a = 1 + (int)(rand_u64(state) % (E - 1));
+    *a = pack(width, r & 1, exp_a, rand_u64(state));
+    if (dist == 0) {
+        *b = pack(width, (r >> 1) & 1, 1 + (int)(rand_u64(state) % (E - 1)), rand_u64(state));
+        if (rand_u64(state) % 16 == 0) {
+            *a = pack(width, r & 1, (int)(rand_u64(state) % (E + 1)), rand_u64(state) >> (rand_u64(state) % M));
+        }
+    } else {
+        int exp_b = exp_a + (int)(rand_u64(state) % 9) - 4;
+        exp_b = (exp_b < 1) ? 1 : (exp_b > E - 1) ? E - 1 : exp_b;
+        *b = pack(width, (r >> 1) & 1, exp_b, rand_u64(state));
+    }
+}
+
+static uint64_t model(int op, int width, int rm, uint64_t a, uint64_t b) {
+    return (op == FP_FAST_OP_MUL) ? c_fp_mul(a, b, width, rm) : c_fp_add(a, b, width, rm);
+}
+
+//------------------------------------------------------------------------------
+// Sweep
+//------------------------------------------------------------------------------
+
+typedef struct {
+    int op, width, rm;
+    uint64_t pairs[FP_FAST_NUM_PATHS];
+    uint64_t mismatches[FP_FAST_NUM_PATHS];
+    int printed;
+} sweep_s;
+
+static void sweep_check(sweep_s* s, uint64_t a, uint64_t b) {
+    int path;
+    const uint64_t fast = fp_fast_one(s->op, s->width, s->rm, a, b, &path, NULL);
+    const uint64_t slow = model(s->op, s->width, s->rm, a, b);
+    s->pairs[path]++;
+    if (fast != slow) {
+        s->mismatches[path]++;
+        if (s->printed++ < 5) {
+            printf("  MISMATCH %s %d %s path=%s a=%llx b=%llx fast=%llx model=%llx\n", op_names[s->op], s->width,
+                   rm_names[s->rm], fp_fast_path_name(path), (unsigned long long)a, (unsigned long long)b,
+                   (unsigned long long)fast, (unsigned long long)slow);
+        }
+    }
+}
+
+// Mantissa patterns: exact values, ties, all ones, lone LSBs and random bits
+static int mant_patterns(int width, uint64_t* state, uint64_t* pats) {
+    const int M = mant_width(width);
+    const uint64_t ones = (1ULL << M) - 1;
+    const uint64_t half = 1ULL << (M - 1);
+    int n = 0;
+    pats[n++] = 0;
+    pats[n++] = 1;
+    pats[n++] = 3;
+    pats[n++] = half;
+    pats[n++] = half | 1;
+    pats[n++] = ones;
+    pats[n++] = ones - 1;
+    pats[n++] = ones >> 1;
+    pats[n++] = ones & 0x5555555555555555ULL;
+    pats[n++] = ones & 0xAAAAAAAAAAAAAAABULL;
+    pats[n++] = (1ULL << (M / 2)) | 1;            // Odd significands whose product ends in ...0001
+    pats[n++] = ones ^ ((1ULL << (M / 2)) - 1);
+    while (n < 16) {
+        pats[n++] = rand_u64(state) & ones;
+    }
+    return n;
+}
+
+static void sweep_exponents(sweep_s* s, int exp_a, int exp_b, const uint64_t* pats, int num_pats) {
+    const int E = exp_max(s->width);
+    if (exp_b < 0 || exp_b > E) {
+        return;
+    }
+    for (int i = 0; i < num_pats; i++) {
+        for (int j = 0; j < num_pats; j++) {
+            for (int sign_b = 0; sign_b < 2; sign_b++) {
+                sweep_check(s, pack(s->width, 0, exp_a, pats[i]), pack(s->width, sign_b, exp_b, pats[j]));
+            }
+        }
+    }
+}
+
+static int run_sweep(int op, int width, int rm, uint64_t count, uint64_t seed) {
+    const int M = mant_width(width);
+    const int E = exp_max(width);
+    const int bias = E >> 1;
+    uint64_t state = seed;
+    uint64_t pats[16];
+    const int num_pats = mant_patterns(width, &state, pats);
+    sweep_s s = {.op = op, .width = width, .rm = rm};
+    const int exps[] = {0, 1, 2, 3, M, bias - 1, bias, bias + 1, E - M - 2, E - 3, E - 2, E - 1, E};
+    const int num_exps = sizeof(exps) / sizeof(exps[0]);
+    const double start = now_sec();
+
+    for (int i = 0; i < num_exps; i++) {
+        const int exp_a = exps[i];
+        for (int k = 0; k < num_exps; k++) {
+            sweep_exponents(&s, exp_a, exps[k], pats, num_pats);
+        }
+        if (op == FP_FAST_OP_ADD) {
+            // Exponent differences through the alignment window and past the mantissa
+            for (int d = -(M + 12); d <= M + 12; d++) {
+                sweep_exponents(&s, exp_a, exp_a + d, pats, num_pats);
+            }
+        } else {
+            // Product exponents around underflow and overflow
+            for (int d = -(M + 4); d <= 4; d++) {
+                sweep_exponents(&s, exp_a, bias - exp_a + d, pats, num_pats);
+            }
+            for (int d = -4; d <= 4; d++) {
+                sweep_exponents(&s, exp_a, bias + E - 1 - exp_a + d, pats, num_pats);
+            }
+        }
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t a, b;
+        random_pair(width, i & 1, &state, &a, &b);
+        sweep_check(&s, a, b);
+    }
+
+    uint64_t total = 0, errors = 0;
+    for (int p = 0; p < FP_FAST_NUM_PATHS; p++) {
+        total += s.pairs[p];
+        errors += s.mismatches[p];
+    }
+    printf("%-6s | %-5d | %-3s | %-10llu |", op_names[op], width, rm_names[rm], (unsigned long long)total);
+    for (int p = 0; p < FP_FAST_NUM_PATHS; p++) {
+        if (s.pairs[p]) {
+            printf(" %s %llu/%llu", fp_fast_path_name(p), (unsigned long long)s.mismatches[p],
+                   (unsigned long long)s.pairs[p]);
+        }
+    }
+    printf(" | %.0f ms\n", 1000.0 * (now_sec() - start));
+    return errors ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+// Benchmark
+//------------------------------------------------------------------------------
+
+static int run_bench(int op, int width, int rm, int dist, uint64_t count, uint64_t seed) {
+    uint64_t* a = malloc(count * sizeof(uint64_t));
+    uint64_t* b = malloc(count * sizeof(uint64_t));
+    uint64_t* slow = malloc(count * sizeof(uint64_t));
+    uint64_t* one = malloc(count * sizeof(uint64_t));
+    uint64_t* batch = malloc(count * sizeof(uint64_t));
+    uint64_t state = seed;
+    fp_fast_stats_s stats = {0};
+    uint64_t errors = 0;
+
+    for (uint64_t i = 0; i < count; i++) {
+        random_pair(width, dist, &state, &a[i], &b[i]);
+    }
+
+    double start = now_sec();
+    for (uint64_t i = 0; i < count; i++) {
+        slow[i] = model(op, width, rm, a[i], b[i]);
+    }
+    const double t_slow = now_sec() - start;
+
+    start = now_sec();
+    for (uint64_t i = 0; i < count; i++) {
+        one[i] = fp_fast_one(op, width, rm, a[i], b[i], NULL, &stats);
+    }
+    const double t_one = now_sec() - start;
+
+    start = now_sec();
+    for (uint64_t i = 0; i < count; i += BATCH) {
+        const int n = (count - i < BATCH) ? (int)(count - i) : BATCH;
+        fp_fast_batch(op, width, rm, a + i, b + i, batch + i, n, NULL, NULL);
+    }
+    const double t_batch = now_sec() - start;
+
+    for (uint64_t i = 0; i < count; i++) {
+        errors += (one[i] != slow[i]) + (batch[i] != slow[i]);
+    }
+
+    printf("%-6s | %-5d | %-3s | %-7s | %7.1f%% | %9.1f | %9.1f | %9.1f | %6.1fx | %llu\n", op_names[op], width,
+           rm_names[rm], dist_names[dist], 100.0 * stats.paths[FP_FAST_HIT] / count, 1e9 * t_slow / count,
+           1e9 * t_one / count, 1e9 * t_batch / count, t_slow / t_batch, (unsigned long long)errors);
+
+    free(a);
+    free(b);
+    free(slow);
+    free(one);
+    free(batch);
+    return errors ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    int ops[2] = {FP_FAST_OP_ADD, FP_FAST_OP_MUL};
+    int num_ops = 2;
+    int widths[2] = {32, 64};
+    int num_widths = 2;
+    uint64_t count = 1000000;
+    uint64_t seed = 1;
+    int sweep = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--op") && i + 1 < argc) {
+            ops[0] = strcmp(argv[++i], "mul") ? FP_FAST_OP_ADD : FP_FAST_OP_MUL;
+            num_ops = 1;
+        } else if (!strcmp(argv[i], "--width") && i + 1 < argc) {
+            widths[0] = atoi(argv[++i]);
+            num_widths = 1;
+        } else if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+            count = strtoull(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--sweep")) {
+            sweep = 1;
+        } else {
+            fprintf(stderr, "Usage: %s [--op add|mul] [--width 32|64] [--count N] [--seed N] [--sweep]\n", argv[0]);
+            return 2;
+        }
+    }
+    for (int w = 0; w < num_widths; w++) {
+        if (widths[w] != 32 && widths[w] != 64) {
+            fprintf(stderr, "Unsupported width %d (the native path covers 32 and 64)\n", widths[w]);
+            return 2;
+        }
+    }
+
+    int failed = 0;
+    if (sweep) {
+        printf("%-6s | %-5s | %-3s | %-10s | %s\n", "OP", "WIDTH", "RM", "PAIRS", "PATH MISMATCHES/PAIRS");
+        printf("-------+-------+-----+------------+---------------------------------------------\n");
+        for (int o = 0; o < num_ops; o++) {
+            for (int w = 0; w < num_widths; w++) {
+                for (int rm = RNE; rm <= RNA; rm++) {
+                    failed |= run_sweep(ops[o], widths[w], rm, count, seed);
+                }
+            }
+        }
+    } else {
+        printf("%-6s | %-5s | %-3s | %-7s | %-8s | %-9s | %-9s | %-9s | %-7s | %s\n", "OP", "WIDTH", "RM", "DIST",
+               "NATIVE", "MODEL ns", "ONE ns", "BATCH ns", "SPEEDUP", "ERRORS");
+        printf("-------+-------+-----+---------+----------+-----------+-----------+-----------+---------+-------\n");
+        for (int o = 0; o < num_ops; o++) {
+            for (int w = 0; w < num_widths; w++) {
+                for (int dist = 0; dist < 2; dist++) {
+                    for (int rm = RNE; rm <= RNA; rm++) {
+                        failed |= run_bench(ops[o], widths[w], rm, dist, count, seed);
+                    }
+                }
+            }
+        }
+    }
+
+    printf("\n%s : fast path %s the bit-accurate model\n", failed ? "FAIL" : "PASS", failed ? "differs from" : "matches");
+    return failed;
+}
@@ -0,0 +1,793 @@
+// verif/lib/fp_inverse.c
+//
+// Inverse operand construction for fp_add / fp_mul / FMA.
+// See fp_inverse.h for the overview.
+//
+// Values are handled as sig * 2^exp with an integer significand (up to 128
+// bits), so every construction and check is exact.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Standard DPI-C inclusion for simulator integration
+#include "svdpi.h"
+
+#include "fp_model.h"
+#include "fp_inverse.h"
+
+typedef unsigned __int128 u128;
+typedef __int128 i128;
+
+static const char* const inv_target_names[FP_INV_NUM_TARGETS] = {
+    "exact", "grs", "tie", "round_ovf", "ovf_after_round", "cancel", "zero", "min_normal", "max_denormal", "denorm_round_up"};
+
+//------------------------------------------------------------------------------
+// Random numbers (xorshift64*)
+//------------------------------------------------------------------------------
+
+static uint64_t inv_rand(fp_inv_s* s) {
+    s->rng ^= s->rng >> 12;
+    s->rng ^= s->rng << 25;
+    s->rng ^= s->rng >> 27;
+    return s->rng * 0x2545F4914F6CDD1DULL;
+}
+
+// Uniform integer in [lo, hi]
+static int inv_rand_range(fp_inv_s* s, int lo, int hi) {
+    if (hi <= lo) {
+        return lo;
+    }
+    return lo + (int)(inv_rand(s) % (uint64_t)(hi - lo + 1));
+}
+
+static uint64_t inv_rand_bits(fp_inv_s* s, int bits) {
+    if (bits <= 0) {
+        return 0;
+    }
+    return (bits >= 64) ? inv_rand(s) : (inv_rand(s) & ((1ULL << bits) - 1));
+}
+
+// Random significand of the given length with the top bit set
+static u128 inv_rand_sig(fp_inv_s* s, int bits) {
+    if (bits <= 0) {
+        return 0;
+    }
+    u128 sig = (u128)1 << (bits - 1);
+    if (bits > 64) {
+        sig |= (u128)inv_rand_bits(s, bits - 65) << 64;
+        sig |= inv_rand(s);
+    } else {
+        sig |= inv_rand_bits(s, bits - 1);
+    }
+    return sig;
+}
+
+// Random odd significand of the given length with the top bit set
+static uint64_t inv_rand_odd_sig(fp_inv_s* s, int bits) {
+    return (uint64_t)inv_rand_sig(s, bits) | 1;
+}
+
+//------------------------------------------------------------------------------
+// Integer helpers
+//------------------------------------------------------------------------------
+
+static u128 inv_mask(int bits) {
+    return (bits >= 128) ? ~(u128)0 : (((u128)1 << bits) - 1);
+}
+
+static int inv_bitlen(u128 x) {
+    uint64_t hi = (uint64_t)(x >> 64);
+    if (hi) {
+        return 128 - __builtin_clzll(hi);
+    }
+    return x ? 64 - __builtin_clzll((uint64_t)x) : 0;
+}
+
+// Inverse of an odd number modulo 2^64 (Newton iteration, each step doubles the correct bits)
+static uint64_t inv_odd_inverse(uint64_t x) {
+    uint64_t y = x;  // Correct to 3 bits
+    for (int i = 0; i < 5; i++) {
+        y *= 2 - x * y;
+    }
+    return y;
+}
+
+//------------------------------------------------------------------------------
+// Packing: value = (-1)^sign * sig * 2^exp
+//------------------------------------------------------------------------------
+
+// Encodes an exact value, fails if it is not representable (too many bits,
+// below the denormal step or above the largest normal)
+static int inv_pack(const fp_inv_s* s, int sign, u128 sig, int exp, uint64_t* out) {
+    const int M = s->mant_w;
+    const uint64_t sign_bit = (uint64_t)(sign & 1) << (s->width - 1);
+
+    if (sig == 0) {
+        *out = sign_bit;
+        return 0;
+    }
+    const int top = exp + inv_bitlen(sig) - 1;
+    if (top > s->emax) {
+        return -1;
+    }
+    const int lsb = (top >= s->emin) ? top - M : s->emin - M;  // Exponent of the last significand bit
+    if (exp < lsb) {
+        if (sig & inv_mask(lsb - exp)) {
+            return -1;
+        }
+        sig >>= lsb - exp;
+    } else {
+        sig <<= exp - lsb;
+    }
+    const uint64_t biased = (top >= s->emin) ? (uint64_t)(top + s->bias) : 0;
+    *out = sign_bit | (biased << M) | ((uint64_t)sig & ((1ULL << M) - 1));
+    return 0;
+}
+
+static void inv_unpack(const fp_inv_s* s, uint64_t bits, int* sign, u128* sig, int* exp) {
+    const int M = s->mant_w;
+    const uint64_t biased = (bits >> M) & (uint64_t)s->exp_max;
+    const uint64_t mant = bits & ((1ULL << M) - 1);
+    *sign = (bits >> (s->width - 1)) & 1;
+    if (biased == 0) {
+        *sig = mant;
+        *exp = s->emin - M;
+    } else {
+        *sig = mant | (1ULL << M);
+        *exp = (int)biased - s->bias - M;
+    }
+}
+
+static int inv_is_finite(const fp_inv_s* s, uint64_t bits) {
+    return ((bits >> s->mant_w) & (uint64_t)s->exp_max) != (uint64_t)s->exp_max;
+}
+
+// Top bit exponent of sig * 2^exp
+static int inv_top(u128 sig, int exp) {
+    return sig ? exp + inv_bitlen(sig) - 1 : INT_MIN;
+}
+
+//------------------------------------------------------------------------------
+// Exact arithmetic and IEEE rounding (reference for the checks)
+//------------------------------------------------------------------------------
+
+typedef struct {
+    int sign;
+    u128 sig;
+    int exp;
+} inv_val_s;
+
+// Exact sum of two values, fails if it needs more than 126 bits
+static int inv_sum(inv_val_s x, inv_val_s y, inv_val_s* z, int* op_is_sub, int* cancel) {
+    *op_is_sub = (x.sign != y.sign) && x.sig && y.sig;
+    if (!x.sig || !y.sig) {
+        *z = x.sig ? x : y;
+        *cancel = 0;
+        return 0;
+    }
+    const int e = (x.exp < y.exp) ? x.exp : y.exp;
+    const int top = (inv_top(x.sig, x.exp) > inv_top(y.sig, y.exp)) ? inv_top(x.sig, x.exp) : inv_top(y.sig, y.exp);
+    if (top - e + 1 > 126) {
+        return -1;
+    }
+    const i128 vx = (i128)(x.sig << (x.exp - e));
+    const i128 vy = (i128)(y.sig << (y.exp - e));
+    const i128 v = (x.sign ? -vx : vx) + (y.sign ? -vy : vy);
+    z->sign = v < 0;
+    z->sig = (u128)(v < 0 ? -v : v);
+    z->exp = e;
+    *cancel = z->sig ? top - inv_top(z->sig, z->exp) : 0;
+    return 0;
+}
+
+// Exact result of the operation. Operands must be finite.
+static int inv_exact(const fp_inv_s* s, uint64_t a, uint64_t b, uint64_t c, inv_val_s* r, int* op_is_sub, int* cancel) {
+    inv_val_s va, vb, vc, vp;
+    inv_unpack(s, a, &va.sign, &va.sig, &va.exp);
+    inv_unpack(s, b, &vb.sign, &vb.sig, &vb.exp);
+    inv_unpack(s, c, &vc.sign, &vc.sig, &vc.exp);
+
+    if (s->op == FP_INV_OP_ADD) {
+        return inv_sum(va, vb, r, op_is_sub, cancel);
+    }
+    vp.sign = va.sign ^ vb.sign;
+    vp.sig = va.sig * vb.sig;
+    vp.exp = va.exp + vb.exp;
+    if (s->op == FP_INV_OP_MUL) {
+        *r = vp;
+        *op_is_sub = 0;
+        *cancel = 0;
+        return 0;
+    }
+    return inv_sum(vp, vc, r, op_is_sub, cancel);
+}
+
+// IEEE 754 rounding of an exact value (with denormals), filling the trace
+// fields the targets are checked on
+static uint64_t inv_round(const fp_inv_s* s, inv_val_s v, int rm, fp_trace_s* t) {
+    const int M = s->mant_w;
+    const uint64_t sign_bit = (uint64_t)(v.sign & 1) << (s->width - 1);
+
+    *t = (fp_trace_s){0};
+    t->class_a = t->class_b = FP_CLASS_NORMAL;
+    t->sign = v.sign;
+    if (v.sig == 0) {
+        t->exact_zero = 1;
+        t->exp_unf = 1;
+        return sign_bit;
+    }
+
+    const int top = inv_top(v.sig, v.exp);
+    int lsb = (top >= s->emin) ? top - M : s->emin - M;
+    u128 kept;
+    int g = 0, r = 0, st = 0;
+    if (v.exp >= lsb) {
+        kept = v.sig << (v.exp - lsb);
+    } else {
+        const int drop = lsb - v.exp;
+        kept = (drop >= 128) ? 0 : (v.sig >> drop);
+        g = (int)((v.sig >> (drop - 1)) & 1);
+        r = (drop >= 2) ? (int)((v.sig >> (drop - 2)) & 1) : 0;
+        st = (drop >= 3) ? ((v.sig & inv_mask(drop - 2)) != 0) : 0;
+    }
+    t->grs = (g << 2) | (r << 1) | st;
+
+    int inc;
+    switch (rm) {
+        case RTZ: inc = 0; break;
+        case RPI: inc = !v.sign && (g | r | st); break;
+        case RNI: inc = v.sign && (g | r | st); break;
+        case RNA: inc = g; break;
+        case RNE:
+        default:  inc = g && (r | st | (int)(kept & 1)); break;
+    }
+    t->round_inc = inc;
+    kept += inc;
+    if (kept >> (M + 1)) {
+        kept >>= 1;
+        lsb++;
+        t->round_ovf = 1;
+    }
+    t->exp_unf = top < s->emin;
+
+    const uint64_t mant = (uint64_t)kept & ((1ULL << M) - 1);
+    if (!(kept >> M)) {
+        return sign_bit | mant;  // Denormal
+    }
+    const int biased = lsb + M + s->bias;
+    if (biased >= s->exp_max) {
+        t->exp_ovf = 1;
+        const int to_max = (rm == RTZ) || (rm == RPI && v.sign) || (rm == RNI && !v.sign);
+        return to_max ? (sign_bit | ((uint64_t)(s->exp_max - 1) << M) | ((1ULL << M) - 1))
+                      : (sign_bit | ((uint64_t)s->exp_max << M));
+    }
+    return sign_bit | ((uint64_t)biased << M) | mant;
+}
+
+//------------------------------------------------------------------------------
+// Target properties
+//------------------------------------------------------------------------------
+
+static int inv_is_round_ovf(int target) {
+    return target == FP_INV_ROUND_OVF || target == FP_INV_OVF_AFTER_ROUND || target == FP_INV_DENORM_ROUND_UP;
+}
+
+// Targets that fix the result exponent
+static int inv_fixed_exp(int target) {
+    return target == FP_INV_OVF_AFTER_ROUND || target == FP_INV_MIN_NORMAL || target == FP_INV_MAX_DENORMAL ||
+           target == FP_INV_DENORM_ROUND_UP || target == FP_INV_ZERO;
+}
+
+int fp_inv_supported(int op, int target, int rm) {
+    if (target < 0 || target >= FP_INV_NUM_TARGETS || rm < RNE || rm > RNA) {
+        return 0;
+    }
+    if (inv_is_round_ovf(target) && rm == RTZ) {
+        return 0;  // Never rounds up
+    }
+    switch (op) {
+        case FP_INV_OP_ADD:
+            // A sum of two finite values below the smallest normal is exact
+            return target != FP_INV_DENORM_ROUND_UP;
+        case FP_INV_OP_MUL:
+            return target != FP_INV_CANCEL && target != FP_INV_ZERO && target != FP_INV_MAX_DENORMAL;
+        case FP_INV_OP_FMA:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Largest param of the target (0 if it takes none)
+int fp_inv_max_param(const fp_inv_s* s, int target) {
+    if (target == FP_INV_GRS) {
+        return 7;
+    }
+    if (target == FP_INV_CANCEL) {
+        // fp_add: the result of an exact cancellation keeps at least one bit of MANT_W+1,
+        // FMA: cancellation below the top of the (2*MANT_W+2)-bit product
+        return (s->op == FP_INV_OP_FMA) ? 2 * s->mant_w + 1 : s->mant_w;
+    }
+    return 0;
+}
+
+// Checks the property on a trace (model or IEEE) and the result encoding
+static int inv_holds(const fp_inv_s* s, const fp_inv_req_s* req, const fp_trace_s* t, uint64_t result) {
+    const uint64_t magnitude = result & ((1ULL << (s->width - 1)) - 1);
+    const uint64_t min_normal = 1ULL << s->mant_w;
+
+    if (t->special) {
+        return 0;
+    }
+    switch (req->target) {
+        case FP_INV_EXACT:           return !t->exact_zero && t->grs == 0 && !t->exp_ovf && !t->exp_unf;
+        case FP_INV_GRS:             return !t->exact_zero && t->grs == req->param;
+        case FP_INV_TIE:             return !t->exact_zero && t->grs == 4;
+        case FP_INV_ROUND_OVF:       return t->round_ovf && !t->exp_ovf;
+        case FP_INV_OVF_AFTER_ROUND: return t->round_ovf && t->exp_ovf;
+        case FP_INV_CANCEL:          return t->op_is_sub && !t->exact_zero && t->norm_shift == req->param;
+        case FP_INV_ZERO:            return t->exact_zero;
+        case FP_INV_MIN_NORMAL:      return t->grs == 0 && magnitude == min_normal;
+        case FP_INV_MAX_DENORMAL:    return t->grs == 0 && magnitude == min_normal - 1;
+        case FP_INV_DENORM_ROUND_UP: return t->exp_unf && t->round_inc && magnitude == min_normal;
+        default:                     return 0;
+    }
+}
+
+int fp_inv_check(const fp_inv_s* s, const fp_inv_req_s* req, uint64_t a, uint64_t b, uint64_t c, uint64_t* result) {
+    inv_val_s exact;
+    fp_trace_s ieee, model;
+    int op_is_sub, cancel;
+
+    if (!inv_is_finite(s, a) || !inv_is_finite(s, b) || !inv_is_finite(s, c)) {
+        return 0;
+    }
+    if (inv_exact(s, a, b, c, &exact, &op_is_sub, &cancel) < 0) {
+        return 0;
+    }
+    if (exact.sig == 0) {
+        exact.sign = op_is_sub ? (req->rm == RNI) : exact.sign;  // x - x is +0, -0 under RNI
+    }
+    const uint64_t ieee_result = inv_round(s, exact, req->rm, &ieee);
+    ieee.op_is_sub = op_is_sub;
+    ieee.norm_shift = cancel;
+
+    if (req->exp != FP_INV_EXP_ANY && !inv_fixed_exp(req->target) && inv_top(exact.sig, exact.exp) != req->exp) {
+        return 0;
+    }
+
+    if (s->op == FP_INV_OP_FMA) {
+        if (result) {
+            *result = ieee_result;
+        }
+        return inv_holds(s, req, &ieee, ieee_result);
+    }
+
+    const uint64_t model_result = (s->op == FP_INV_OP_ADD) ? c_fp_add_trace(a, b, s->width, req->rm, &model)
+                                                           : c_fp_mul_trace(a, b, s->width, req->rm, &model);
+    if (result) {
+        *result = model_result;
+    }
+    if (req->target == FP_INV_MAX_DENORMAL) {
+        // The fp_add model flushes denormal results to zero, the property is on the exact result
+        return inv_holds(s, req, &ieee, ieee_result);
+    }
+    // The vector must land on the same rounding event in the model as in IEEE arithmetic
+    return model_result == ieee_result && inv_holds(s, req, &model, model_result);
+}
+
+//------------------------------------------------------------------------------
+// Construction
+//------------------------------------------------------------------------------
+
+// Dropped bits (q of them) below the kept significand for the target.
+// Sticky bits are placed at or above sticky_lo.
+static int inv_dropped(fp_inv_s* s, const fp_inv_req_s* req, int q, int sticky_lo, u128* dropped) {
+    int grs;
+    switch (req->target) {
+        case FP_INV_GRS: grs = req->param; break;
+        case FP_INV_TIE: grs = 4; break;
+        case FP_INV_ROUND_OVF:
+        case FP_INV_OVF_AFTER_ROUND:
+        case FP_INV_DENORM_ROUND_UP:
+            // Nearest modes need the guard bit, directed modes any inexact tail
+            grs = (req->rm == RNE || req->rm == RNA) ? 4 | (int)inv_rand_bits(s, 2) : inv_rand_range(s, 1, 7);
+            break;
+        default: grs = 0; break;
+    }
+    *dropped = 0;
+    if (grs == 0) {
+        return 0;
+    }
+    if (q < 3) {
+        return -1;
+    }
+    *dropped = ((u128)((grs >> 2) & 1) << (q - 1)) | ((u128)((grs >> 1) & 1) << (q - 2));
+    if (grs & 1) {
+        const int bits = q - 2 - sticky_lo;
+        if (bits <= 0) {
+            return -1;
+        }
+        uint64_t sticky = inv_rand_bits(s, (bits > 64) ? 64 : bits);
+        *dropped |= (u128)(sticky ? sticky : 1) << sticky_lo;
+    }
+    return 0;
+}
+
+// Result significand: kept_bits (all ones for the rounding overflow targets)
+// followed by q dropped bits
+static int inv_result_sig(fp_inv_s* s, const fp_inv_req_s* req, int kept_bits, int q, u128* sig) {
+    u128 dropped;
+    if (inv_dropped(s, req, q, 0, &dropped) < 0) {
+        return -1;
+    }
+    const u128 kept = inv_is_round_ovf(req->target) ? inv_mask(kept_bits) : inv_rand_sig(s, kept_bits);
+    *sig = (kept << q) | dropped;
+    return 0;
+}
+
+// Significands sig_a, sig_b (MANT_W+1 bits, top bit set) with
+// sig_a * sig_b = low (mod 2^(MANT_W+1))
+static int inv_mul_low_bits(fp_inv_s* s, uint64_t low, uint64_t* sig_a, uint64_t* sig_b) {
+    const int W = s->mant_w + 1;
+
+    if (low == 0) {
+        // At least W trailing zeros between the two significands
+        const int ta = inv_rand_range(s, 1, W - 1);
+        const int tb = inv_rand_range(s, W - ta, W - 1);
+        *sig_a = inv_rand_odd_sig(s, W - ta) << ta;
+        *sig_b = inv_rand_odd_sig(s, W - tb) << tb;
+        return 0;
+    }
+
+    // Trailing zeros of low are split between a and b, the odd parts are
+    // solved modulo 2^(W-t): odd_b = (low >> t) * odd_a^-1
+    const int t = __builtin_ctzll(low);
+    const int ta = inv_rand_range(s, 0, t);
+    const int tb = t - ta;
+    const int mod_bits = W - t;
+    const int top = W - tb - 1;  // Top bit of sig_b >> tb
+    const uint64_t odd_a = inv_rand_odd_sig(s, W - ta);
+    uint64_t odd_b = ((low >> t) * inv_odd_inverse(odd_a)) & ((1ULL << mod_bits) - 1);
+
+    if (ta > 0) {
+        // ta free bits above the solved ones, the top one must be set
+        odd_b |= (inv_rand_bits(s, ta) << mod_bits) | (1ULL << top);
+    } else if (!((odd_b >> top) & 1)) {
+        return -1;
+    }
+    *sig_a = odd_a << ta;
+    *sig_b = odd_b << tb;
+    return 0;
+}
+
+// Splits an exponent sum between two normal operands
+static int inv_split_exp(fp_inv_s* s, int sum, int* ea, int* eb) {
+    const int lo = (sum - s->emax > s->emin) ? sum - s->emax : s->emin;
+    const int hi = (sum - s->emin < s->emax) ? sum - s->emin : s->emax;
+    if (lo > hi) {
+        return -1;
+    }
+    *ea = inv_rand_range(s, lo, hi);
+    *eb = sum - *ea;
+    return 0;
+}
+
+static int inv_pick_exp(fp_inv_s* s, const fp_inv_req_s* req, int lo, int hi) {
+    return (req->exp != FP_INV_EXP_ANY) ? req->exp : inv_rand_range(s, lo, hi);
+}
+
+// fp_add cancellation: a = {H, T} has the top bit, b = -(H - D) * 2^L,
+// a + b = {D, T} = sig (n bits, n <= MANT_W) with the top bit at er
+static int inv_add_cancel(fp_inv_s* s, u128 sig, int n, int er, int sign, uint64_t* a, uint64_t* b) {
+    const int M = s->mant_w;
+    const int ex = er - n + 1;
+    const int L = inv_rand_range(s, 0, n);
+    const u128 lo = sig & inv_mask(L);
+    const u128 d = sig >> L;
+    const u128 h = inv_rand_sig(s, M + 1 - L);
+
+    if (h <= d || inv_pack(s, sign, (h << L) | lo, ex, a) < 0 || inv_pack(s, !sign, h - d, ex + L, b) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static int inv_make_add(fp_inv_s* s, const fp_inv_req_s* req, int sign, uint64_t* a, uint64_t* b) {
+    const int M = s->mant_w;
+    const int q_max = (M < s->precision_bits) ? M : s->precision_bits;  // Tail of a within the alignment window
+
+    switch (req->target) {
+        case FP_INV_ZERO: {
+            const u128 sig = inv_rand_sig(s, M + 1);
+            if (inv_pack(s, sign, sig, inv_rand_range(s, s->emin, s->emax) - M, a) < 0) {
+                return -1;
+            }
+            *b = *a ^ (1ULL << (s->width - 1));
+            return 0;
+        }
+        case FP_INV_CANCEL: {
+            const int n = M + 1 - req->param;
+            return inv_add_cancel(s, inv_rand_sig(s, n), n, inv_pick_exp(s, req, s->emin, s->emax), sign, a, b);
+        }
+        case FP_INV_MIN_NORMAL:
+        case FP_INV_MAX_DENORMAL: {
+            const uint64_t total = (req->target == FP_INV_MIN_NORMAL) ? (1ULL << M) : (1ULL << M) - 1;
+            if (inv_rand_bits(s, 1)) {
+                // Two denormals
+                const uint64_t m = 1 + inv_rand(s) % (total - 1);
+                *a = ((uint64_t)sign << (s->width - 1)) | m;
+                *b = ((uint64_t)sign << (s->width - 1)) | (total - m);
+                return 0;
+            }
+            // Cancellation of two normals
+            if (req->target == FP_INV_MIN_NORMAL) {
+                return inv_add_cancel(s, 1, 1, s->emin, sign, a, b);
+            }
+            return inv_add_cancel(s, total, M, s->emin - 1, sign, a, b);
+        }
+        default: {
+            // a = {H, T} carries the q dropped bits, b = (D - H) * 2^q, a + b = {D, T}
+            const int q = inv_rand_range(s, (req->target == FP_INV_EXACT) ? 0 : 3, q_max);
+            const int n = M + 1 + q;
+            u128 sig;
+            if (inv_result_sig(s, req, M + 1, q, &sig) < 0) {
+                return -1;
+            }
+            const int er = (req->target == FP_INV_OVF_AFTER_ROUND) ? s->emax : inv_pick_exp(s, req, s->emin, s->emax - 1);
+            const int ex = er - n + 1;
+            const u128 lo = sig & inv_mask(q);
+            const u128 d = sig >> q;
+            const u128 h = inv_rand_sig(s, M + 1 - q);
+            const i128 diff = (i128)d - (i128)h;
+            if (diff == 0 || inv_pack(s, sign, (h << q) | lo, ex, a) < 0 ||
+                inv_pack(s, sign ^ (diff < 0), (u128)(diff < 0 ? -diff : diff), ex + q, b) < 0) {
+                return -1;
+            }
+            return 0;
+        }
+    }
+}
+
+static int inv_make_mul(fp_inv_s* s, const fp_inv_req_s* req, int sign, uint64_t* a, uint64_t* b) {
+    const int M = s->mant_w;
+    const int sign_a = (int)inv_rand_bits(s, 1);
+    uint64_t sig_a, sig_b;
+    int er, ge2, ea, eb;
+
+    switch (req->target) {
+        case FP_INV_MIN_NORMAL:
+            sig_a = sig_b = 1ULL << M;
+            er = s->emin;
+            ge2 = 0;
+            break;
+        case FP_INV_ROUND_OVF:
+        case FP_INV_OVF_AFTER_ROUND:
+        case FP_INV_DENORM_ROUND_UP: {
+            // Largest sig_b with sig_a * sig_b < 2.0: the top MANT_W+1 bits are all ones when the gap to 2.0 is
+            // at most 2^MANT_W, and the guard bit is set when it is at most 2^(MANT_W-1)
+            const u128 two = (u128)1 << (2 * M + 1);
+            sig_a = (uint64_t)inv_rand_sig(s, M + 1);
+            sig_b = (uint64_t)((two - 1) / sig_a);
+            const u128 gap = two - (u128)sig_a * sig_b;
+            const int need_guard = (req->rm == RNE || req->rm == RNA);
+            if (need_guard ? gap > ((u128)1 << (M - 1)) : gap >= ((u128)1 << M)) {
+                return -1;
+            }
+            er = (req->target == FP_INV_ROUND_OVF) ? inv_pick_exp(s, req, s->emin, s->emax - 1)
+               : (req->target == FP_INV_OVF_AFTER_ROUND) ? s->emax : s->emin - 1;
+            ge2 = 0;
+            break;
+        }
+        default: {
+            // Low MANT_W+1 bits of the product: product >= 2.0 drops all of them (the model drops the
+            // LSB without sticky, so it stays zero), otherwise the kept LSB and MANT_W dropped bits
+            u128 dropped;
+            ge2 = (int)inv_rand_bits(s, 1);
+            if (inv_dropped(s, req, ge2 ? M + 1 : M, ge2, &dropped) < 0) {
+                return -1;
+            }
+            const uint64_t low = ge2 ? (uint64_t)dropped : (inv_rand_bits(s, 1) << M) | (uint64_t)dropped;
+            if (inv_mul_low_bits(s, low, &sig_a, &sig_b) < 0) {
+                return -1;
+            }
+            if ((int)(((u128)sig_a * sig_b) >> (2 * M + 1)) != ge2) {
+                return -1;
+            }
+            er = inv_pick_exp(s, req, s->emin, s->emax - 1);
+            break;
+        }
+    }
+
+    if (inv_split_exp(s, er - ge2, &ea, &eb) < 0 || inv_pack(s, sign_a, sig_a, ea - M, a) < 0 ||
+        inv_pack(s, sign ^ sign_a, sig_b, eb - M, b) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+// FMA: a * b has the low MANT_W+1 bits of the result significand sig (n bits,
+// top bit at er), c = (D - H) * 2^(MANT_W+1) removes the top of the product
+static int inv_make_fma(fp_inv_s* s, const fp_inv_req_s* req, int sign, uint64_t* a, uint64_t* b, uint64_t* c) {
+    const int M = s->mant_w;
+    const int W = M + 1;
+    u128 sig;
+    int n, er, ge2 = -1;
+
+    switch (req->target) {
+        case FP_INV_ZERO:
+            sig = 0;
+            n = 0;
+            er = inv_rand_range(s, s->emin, s->emax);
+            break;
+        case FP_INV_MIN_NORMAL:
+            sig = 1;
+            n = 1;
+            er = s->emin;
+            break;
+        case FP_INV_MAX_DENORMAL:
+            sig = inv_mask(M);
+            n = M;
+            er = s->emin - 1;
+            break;
+        case FP_INV_CANCEL: {
+            // Product top bit at 2*MANT_W (+1 if >= 2.0), the result param bits below
+            ge2 = (int)inv_rand_bits(s, 1);
+            n = 2 * M + ge2 + 1 - req->param;
+            if (n < 1) {
+                return -1;
+            }
+            sig = inv_rand_sig(s, n);
+            er = inv_pick_exp(s, req, s->emin, s->emax - 1);
+            break;
+        }
+        case FP_INV_DENORM_ROUND_UP: {
+            // MANT_W kept bits below the smallest normal
+            const int q = inv_rand_range(s, 3, W);
+            if (inv_result_sig(s, req, M, q, &sig) < 0) {
+                return -1;
+            }
+            n = M + q;
+            er = s->emin - 1;
+            break;
+        }
+        default: {
+            // At the largest exponent neither a * b nor c can exceed the result: no cancellation
+            const int q = (req->target == FP_INV_OVF_AFTER_ROUND) ? W : inv_rand_range(s, (req->target == FP_INV_EXACT) ? 0 : 3, W);
+            if (inv_result_sig(s, req, W, q, &sig) < 0) {
+                return -1;
+            }
+            n = W + q;
+            er = (req->target == FP_INV_OVF_AFTER_ROUND) ? s->emax : inv_pick_exp(s, req, s->emin, s->emax - 1);
+            break;
+        }
+    }
+
+    uint64_t sig_a, sig_b;
+    if (inv_mul_low_bits(s, (uint64_t)(sig & inv_mask(W)), &sig_a, &sig_b) < 0) {
+        return -1;
+    }
+    const u128 product = (u128)sig_a * sig_b;
+    if (ge2 >= 0 && (int)(product >> (2 * M + 1)) != ge2) {
+        return -1;
+    }
+    const i128 sig_c = (i128)(sig >> W) - (i128)(product >> W);
+    if (sig_c == 0 || (req->target == FP_INV_CANCEL && sig_c > 0)) {
+        return -1;
+    }
+
+    // Product exponent: exact zero has no result exponent, er places the product instead
+    int ex = (req->target == FP_INV_ZERO) ? er - inv_bitlen(product) + 1 : er - n + 1;
+    int ea, eb;
+    const int sign_a = (int)inv_rand_bits(s, 1);
+    if (inv_split_exp(s, ex + 2 * M, &ea, &eb) < 0 || inv_pack(s, sign ^ sign_a, sig_a, ea - M, a) < 0 ||
+        inv_pack(s, sign_a, sig_b, eb - M, b) < 0 ||
+        inv_pack(s, sign ^ (sig_c < 0), (u128)(sig_c < 0 ? -sig_c : sig_c), ex + W, c) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Native API
+//------------------------------------------------------------------------------
+
+int fp_inv_init(fp_inv_s* s, int op, int width, uint64_t seed) {
+    int exp_w;
+    switch (width) {
+        case 64: exp_w = 11; break;
+        case 32: exp_w =  8; break;
+        case 16: exp_w =  5; break;
+        default: return -1;
+    }
+    if (op != FP_INV_OP_ADD && op != FP_INV_OP_MUL && op != FP_INV_OP_FMA) {
+        return -1;
+    }
+
+    memset(s, 0, sizeof(*s));
+    s->op = op;
+    s->width = width;
+    s->exp_w = exp_w;
+    s->mant_w = width - 1 - exp_w;
+    s->bias = (1 << (exp_w - 1)) - 1;
+    s->exp_max = (1 << exp_w) - 1;
+    s->emin = 1 - s->bias;
+    s->emax = s->exp_max - 1 - s->bias;
+    s->precision_bits = (width == 16) ? 32 : 7;  // As in c_fp_add()
+    s->rng = (seed + 1) * 0x9E3779B97F4A7C15ULL;
+    return 0;
+}
+
+int fp_inv_make(fp_inv_s* s, const fp_inv_req_s* req, uint64_t* a, uint64_t* b, uint64_t* c) {
+    if (!fp_inv_supported(s->op, req->target, req->rm)) {
+        return FP_INV_UNSUPPORTED;
+    }
+    const int max_param = fp_inv_max_param(s, req->target);
+    const int min_param = (req->target == FP_INV_CANCEL) ? 1 : 0;
+    if (max_param && (req->param < min_param || req->param > max_param)) {
+        return FP_INV_UNSUPPORTED;
+    }
+
+    for (int attempt = 0; attempt < FP_INV_MAX_ATTEMPTS; attempt++) {
+        int sign = (req->sign < 0) ? (int)inv_rand_bits(s, 1) : (req->sign & 1);
+        if (inv_is_round_ovf(req->target) && (req->rm == RPI || req->rm == RNI)) {
+            sign = (req->rm == RNI);  // Directed rounding only rounds up the magnitude on this side
+        }
+
+        int rc;
+        *c = 0;
+        s->attempts++;
+        switch (s->op) {
+            case FP_INV_OP_ADD: rc = inv_make_add(s, req, sign, a, b); break;
+            case FP_INV_OP_MUL: rc = inv_make_mul(s, req, sign, a, b); break;
+            default:            rc = inv_make_fma(s, req, sign, a, b, c); break;
+        }
+        if (rc == 0) {
+            return fp_inv_check(s, req, *a, *b, *c, NULL) ? FP_INV_OK : FP_INV_CHECK_FAILED;
+        }
+    }
+    return FP_INV_GAVE_UP;
+}
+
+const char* fp_inv_target_name(int target) {
+    return (target >= 0 && target < FP_INV_NUM_TARGETS) ? inv_target_names[target] : "?";
+}
+
+int fp_inv_target_by_name(const char* name) {
+    for (int i = 0; i < FP_INV_NUM_TARGETS; i++) {
+        if (!strcmp(name, inv_target_names[i])) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+// DPI-C API
+//------------------------------------------------------------------------------
+
+static fp_inv_s g_inv;
+static int g_inv_valid = 0;
+
+// Returns 0 on success
+int c_fp_inv_init(const int op, const int width, const int seed) {
+    g_inv_valid = (fp_inv_init(&g_inv, op, width, (uint64_t)seed) == 0);
+    return g_inv_valid ? 0 : -1;
+}
+
+// Returns FP_INV_OK or one of the FP_INV_* error codes, the operands are zero on error
+int c_fp_inv_make(const int target, const int param, const int exp, const int rm, const int sign, uint64_t* a, uint64_t* b, uint64_t* c) {
+    fp_inv_req_s req = {target, param, exp, rm, sign};
+    *a = *b = *c = 0;
+    if (!g_inv_valid) {
+        return FP_INV_UNSUPPORTED;
+    }
+    const int rc = fp_inv_make(&g_inv, &req, a, b, c);
+    if (rc != FP_INV_OK) {
+        *a = *b = *c = 0;
+    }
+    return rc;
+}
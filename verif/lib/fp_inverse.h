@@ -0,0 +1,89 @@
+// verif/lib/fp_inverse.h
+//
+// Solver-free inverse construction of operands for fp_add, fp_mul and FMA.
+//
+// Instead of drawing random operands and filtering them through the model,
+// the exact result is chosen first (its significand bits, GRS pattern and
+// exponent) and the operands are derived from it analytically:
+//   - fp_add: a carries the low bits of the result, b = result - a;
+//   - fp_mul: the low bits of sig_a * sig_b are set through the inverse of an
+//     odd significand modulo 2^(MANT_W+1);
+//   - FMA: a * b is built as for fp_mul, c = result - a * b.
+// Every constructed vector is checked before it is returned: fp_add / fp_mul
+// against the datapath trace of the bit-accurate C models (which must also
+// agree with IEEE rounding of the exact result), FMA against the exact result.
+//
+// The same code serves the UVM sequences (DPI-C wrappers c_fp_inv_*, one
+// global context) and native tools (fp_inv_* on a caller-owned context).
+//
+
+#ifndef FP_INVERSE_H
+#define FP_INVERSE_H
+
+#include <limits.h>
+#include <stdint.h>
+
+#include "fp_model.h"
+
+// Operation
+#define FP_INV_OP_ADD 0
+#define FP_INV_OP_MUL 1
+#define FP_INV_OP_FMA 2
+
+// Targeted result properties
+#define FP_INV_EXACT           0  // Exact result (GRS = 000)
+#define FP_INV_GRS             1  // GRS pattern = param (0..7) at the rounder input
+#define FP_INV_TIE             2  // Exact tie (GRS = 100)
+#define FP_INV_ROUND_OVF       3  // Mantissa all ones that rounds up to 2.0 under rm
+#define FP_INV_OVF_AFTER_ROUND 4  // ROUND_OVF at the largest exponent: overflows only after rounding
+#define FP_INV_CANCEL          5  // Effective subtraction cancelling param leading bits (fp_add, FMA)
+#define FP_INV_ZERO            6  // Total cancellation to exactly zero (fp_add, FMA)
+#define FP_INV_MIN_NORMAL      7  // Exactly the smallest normal
+#define FP_INV_MAX_DENORMAL    8  // Exactly the largest denormal (fp_add, FMA)
+#define FP_INV_DENORM_ROUND_UP 9  // Below the smallest normal, rounds up to it (fp_mul, FMA)
+#define FP_INV_NUM_TARGETS    10
+
+// Free result exponent
+#define FP_INV_EXP_ANY INT_MIN
+
+// Return codes of fp_inv_make()
+#define FP_INV_OK            0
+#define FP_INV_UNSUPPORTED  -1  // Target not reachable for this op / rm / param
+#define FP_INV_GAVE_UP      -2  // No representable operands found (e.g. exponent out of reach)
+#define FP_INV_CHECK_FAILED -3  // Constructed vector does not have the property (construction bug)
+
+#define FP_INV_MAX_ATTEMPTS 256
+
+// Requested result property
+typedef struct {
+    int target;  // FP_INV_*
+    int param;   // FP_INV_GRS: pattern, FP_INV_CANCEL: cancelled bits
+    int exp;     // Unbiased exponent of the exact result, FP_INV_EXP_ANY: random.
+                 // Ignored by the boundary targets, which fix it.
+    int rm;      // Rounding mode the property refers to
+    int sign;    // Result sign, -1: random. Forced by rm for the rounding overflow targets.
+} fp_inv_req_s;
+
+// Generator state
+typedef struct {
+    int op;
+    int width;
+    int exp_w, mant_w, bias, exp_max, emin, emax, precision_bits;
+    uint64_t rng;
+    uint64_t attempts;  // Constructions tried, including the rejected ones
+} fp_inv_s;
+
+// Native API
+int         fp_inv_init(fp_inv_s* s, int op, int width, uint64_t seed);
+int         fp_inv_supported(int op, int target, int rm);
+int         fp_inv_max_param(const fp_inv_s* s, int target);
+int         fp_inv_make(fp_inv_s* s, const fp_inv_req_s* req, uint64_t* a, uint64_t* b, uint64_t* c);
+int         fp_inv_check(const fp_inv_s* s, const fp_inv_req_s* req, uint64_t a, uint64_t b, uint64_t c, uint64_t* result);
+const char* fp_inv_target_name(int target);
+int         fp_inv_target_by_name(const char* name);
+
+// DPI-C API (single global context)
+int c_fp_inv_init(int op, int width, int seed);
+int c_fp_inv_make(int target, int param, int exp, int rm, int sign, uint64_t* a, uint64_t* b, uint64_t* c);
+
+#endif // FP_INVERSE_H
@@ -0,0 +1,208 @@
+// verif/lib/fp_inverse_gen.c
+//
+// Native vector generator and self-check for the inverse operand construction
+// in fp_inverse.c.
+//
+// For every op / width / target it constructs --count vectors, checks each one
+// (fp_add / fp_mul on the C models, FMA on the exact result) and compares with
+// how often uniformly random finite operands hit the same target. With --out
+// the vectors are also written to <dir>/fp_<op>_<width>_<target>.vec, one per
+// line as hex fields:
+//   a b c rm expected
+// c is 0 for fp_add / fp_mul. expected is the C model result for fp_add /
+// fp_mul and the IEEE 754 result for FMA. Lines starting with '#' are comments.
+// The files are read by fp_sequence2_inverse (+INV_VECTORS=<file>).
+//
+// Build and run (see native.mk):
+//   make -f native.mk inverse
+//   build/native/fp_inverse_gen [--op add|mul|fma] [--width 16|32|64] [--target NAME] [--count N] [--random N] [--seed N] [--out DIR]
+//
+// Returns non-zero if a constructed vector fails its check or a supported
+// target could not be constructed.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "fp_model.h"
+#include "fp_inverse.h"
+
+static const char* const op_names[3] = {"add", "mul", "fma"};
+static const int rm_list[5] = {RNE, RTZ, RPI, RNI, RNA};
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+// Request for the i-th vector of a target: cycles the rounding modes the
+// target supports and its param range
+static int next_req(const fp_inv_s* s, int target, int i, fp_inv_req_s* req) {
+    int rms[5], num_rms = 0;
+    for (int r = 0; r < 5; r++) {
+        if (fp_inv_supported(s->op, target, rm_list[r])) {
+            rms[num_rms++] = rm_list[r];
+        }
+    }
+    if (!num_rms) {
+        return -1;
+    }
+    const int max_param = fp_inv_max_param(s, target);
+    const int min_param = (target == FP_INV_CANCEL) ? 1 : 0;
+
+    req->target = target;
+    req->param = max_param ? min_param + i % (max_param - min_param + 1) : 0;
+    req->exp = FP_INV_EXP_ANY;
+    req->rm = rms[(i / (max_param - min_param + 1)) % num_rms];
+    req->sign = -1;
+    return 0;
+}
+
+// Uniformly random finite operand
+static uint64_t random_operand(const fp_inv_s* s, uint64_t* state) {
+    const uint64_t mask = (s->width == 64) ? ~0ULL : ((1ULL << s->width) - 1);
+    uint64_t v;
+    do {
+        v = rand_u64(state) & mask;
+    } while (((v >> s->mant_w) & (uint64_t)s->exp_max) == (uint64_t)s->exp_max);
+    return v;
+}
+
+int main(int argc, char** argv) {
+    int ops[3] = {FP_INV_OP_ADD, FP_INV_OP_MUL, FP_INV_OP_FMA};
+    int num_ops = 3;
+    int widths[3] = {16, 32, 64};
+    int num_widths = 3;
+    int only_target = -1;
+    int count = 1000;
+    int random_samples = 100000;
+    uint64_t seed = 1;
+    const char* out_dir = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--op") && i + 1 < argc) {
+            const char* name = argv[++i];
+            ops[0] = !strcmp(name, "mul") ? FP_INV_OP_MUL : !strcmp(name, "fma") ? FP_INV_OP_FMA : FP_INV_OP_ADD;
+            num_ops = 1;
+        } else if (!strcmp(argv[i], "--width") && i + 1 < argc) {
+            widths[0] = atoi(argv[++i]);
+            num_widths = 1;
+        } else if (!strcmp(argv[i], "--target") && i + 1 < argc) {
+            only_target = fp_inv_target_by_name(argv[++i]);
+            if (only_target < 0) {
+                fprintf(stderr, "Unknown target %s\n", argv[i]);
+                return 2;
+            }
+        } else if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+            count = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--random") && i + 1 < argc) {
+            random_samples = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "--out") && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--op add|mul|fma] [--width 16|32|64] [--target NAME] [--count N] [--random N] [--seed N] [--out DIR]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int failures = 0;
+
+    printf("%-6s | %-5s | %-15s | %-7s | %-9s | %-6s | %-11s | %-9s\n", "OP", "WIDTH", "TARGET", "VECTORS", "TRIES/VEC", "FAILED", "RANDOM HITS", "TIME (ms)");
+    printf("-------+-------+-----------------+---------+-----------+--------+-------------+----------\n");
+    for (int o = 0; o < num_ops; o++) {
+        for (int w = 0; w < num_widths; w++) {
+            for (int target = 0; target < FP_INV_NUM_TARGETS; target++) {
+                if (only_target >= 0 && target != only_target) {
+                    continue;
+                }
+                fp_inv_s s;
+                fp_inv_req_s req;
+                if (fp_inv_init(&s, ops[o], widths[w], seed) < 0) {
+                    fprintf(stderr, "Unsupported width %d\n", widths[w]);
+                    return 2;
+                }
+                if (next_req(&s, target, 0, &req) < 0) {
+                    printf("fp_%-3s | %-5d | %-15s | %-7s |\n", op_names[ops[o]], widths[w], fp_inv_target_name(target), "n/a");
+                    continue;
+                }
+
+                FILE* out = NULL;
+                if (out_dir) {
+                    char path[1024];
+                    snprintf(path, sizeof(path), "%s/fp_%s_%d_%s.vec", out_dir, op_names[ops[o]], widths[w], fp_inv_target_name(target));
+                    out = fopen(path, "w");
+                    if (!out) {
+                        perror(path);
+                        return 2;
+                    }
+                    fprintf(out, "# fp_%s width=%d target=%s seed=%llu\n", op_names[ops[o]], widths[w], fp_inv_target_name(target), (unsigned long long)seed);
+                    fprintf(out, "# a b c rm expected\n");
+                }
+
+                int made = 0, failed = 0;
+                double start = now_sec();
+                for (int i = 0; i < count; i++) {
+                    uint64_t a, b, c, result;
+                    next_req(&s, target, i, &req);
+                    const int rc = fp_inv_make(&s, &req, &a, &b, &c);
+                    if (rc == FP_INV_UNSUPPORTED) {
+                        continue;
+                    }
+                    if (rc != FP_INV_OK) {
+                        if (failed++ < 3) {
+                            fprintf(stderr, "fp_%s %d %s param=%d rm=%d: %s\n", op_names[ops[o]], widths[w], fp_inv_target_name(target), req.param, req.rm,
+                                    (rc == FP_INV_GAVE_UP) ? "gave up" : "check failed");
+                        }
+                        continue;
+                    }
+                    made++;
+                    if (out) {
+                        fp_inv_check(&s, &req, a, b, c, &result);
+                        const int digits = widths[w] / 4;
+                        fprintf(out, "%0*llx %0*llx %0*llx %d %0*llx\n", digits, (unsigned long long)a, digits, (unsigned long long)b,
+                                digits, (unsigned long long)c, req.rm, digits, (unsigned long long)result);
+                    }
+                }
+                const double elapsed = now_sec() - start;
+                const uint64_t attempts = s.attempts;
+                if (out) {
+                    fclose(out);
+                }
+
+                // Uniformly random finite operands hitting the same target
+                uint64_t state = (seed + 1) * 0xD1B54A32D192ED03ULL;
+                int hits = 0;
+                for (int i = 0; i < random_samples; i++) {
+                    next_req(&s, target, i, &req);
+                    const uint64_t a = random_operand(&s, &state);
+                    const uint64_t b = random_operand(&s, &state);
+                    const uint64_t c = (s.op == FP_INV_OP_FMA) ? random_operand(&s, &state) : 0;
+                    hits += fp_inv_check(&s, &req, a, b, c, NULL);
+                }
+
+                char tries[16], random_hits[24];
+                snprintf(tries, sizeof(tries), "%.2f", made ? (double)attempts / made : 0.0);
+                snprintf(random_hits, sizeof(random_hits), "%d/%d", hits, random_samples);
+                printf("fp_%-3s | %-5d | %-15s | %-7d | %-9s | %-6d | %-11s | %-9.1f\n", op_names[ops[o]], widths[w], fp_inv_target_name(target), made,
+                       tries, failed, random_hits, 1000.0 * elapsed);
+                failures += failed;
+            }
+        }
+    }
+
+    printf("\n%s : %d constructed vectors failed their check or could not be constructed\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,386 @@
+// verif/lib/fp_kulisch_bench.cpp
+//
+// Native benchmark of the exact dot product accumulator (fp_kulisch.v,
+// reference model in fp_kulisch_model.cpp).
+//
+// Self-check first: random rows (1 .. 64 products) against an independent
+// exact dot product in __int128 fixed point, rounded here, in all five
+// rounding modes:
+//   fp16 - operands over the whole range (denormals, zeros, one row in eight
+//          with an infinity or a NaN), so the products cover the full
+//          accumulator;
+//   fp32 - operand exponents within 2^[-12, 12] (the exact sum must fit in
+//          the 128-bit reference).
+// Overflow gives infinity in every rounding mode, as in fp_mul.
+//
+// Then, for row lengths 16 .. 1024 and two input distributions
+//   uniform - uniform in [-1, 1] (below 2^-10: zero),
+//   spread  - random sign, magnitude 2^[-3, 3] (fp32: 2^[-12, 12]),
+// it compares a sequential c_fp_mul / c_fp_add chain with the Kulisch
+// accumulator against the exact dot product: mean and max error in ulps
+// (RNE) and the percentage of rows whose result changes when the products
+// are shuffled (order sensitivity).
+//
+// Build and run (see native.mk):
+//   make -f native.mk kulisch
+//   build/native/fp_kulisch_bench [--width 16|32] [--n N] [--rows N] [--carry N] [--seed N]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "fp_model.h"
+}
+
+#include "fp_kulisch_model.h"
+
+typedef __int128 s128;
+typedef unsigned __int128 u128;
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static const int n_list[] = {16, 64, 256, 1024};
+
+struct fp_fmt_s {
+    int exp_w;
+    int bias;
+    int mant_w;
+};
+
+static fp_fmt_s fp_fmt(int width) {
+    if (width == 64) return {11, 1023, 52};
+    if (width == 32) return {8, 127, 23};
+    return {5, 15, 10};
+}
+
+// LSB exponent of the reference fixed point: every product of the operands
+// generated below is a multiple of it
+static int ref_lsb(int width) { return (width == 16) ? -48 : -80; }
+
+static long double fp_to_ld(uint64_t v, int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    const int sign = (v >> (width - 1)) & 1;
+    const int exp = (int)((v >> f.mant_w) & ((1ULL << f.exp_w) - 1));
+    const uint64_t mant = v & ((1ULL << f.mant_w) - 1);
+    long double m;
+    if (exp == (1 << f.exp_w) - 1) {
+        m = mant ? NAN : INFINITY;
+    } else if (exp == 0) {
+        m = ldexpl((long double)mant, 1 - f.bias - f.mant_w);
+    } else {
+        m = ldexpl((long double)((1ULL << f.mant_w) | mant), exp - f.bias - f.mant_w);
+    }
+    return sign ? -m : m;
+}
+
+// Error of y in ulps of the exact value ref (normal ref only)
+static double ulp_err(uint64_t y, long double ref, int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    int e;
+    frexpl(ref, &e);
+    return (double)(fabsl(fp_to_ld(y, width) - ref) / ldexpl(1.0L, e - 1 - f.mant_w));
+}
+
+// Random encoding, unbiased exponent in [lo, hi] (below the normal range:
+// denormal)
+static uint64_t rand_fp(uint64_t* state, int width, int lo, int hi) {
+    const fp_fmt_s f = fp_fmt(width);
+    const uint64_t r = rand_u64(state);
+    const int exp = lo + (int)(rand_u64(state) % (hi - lo + 1)) + f.bias;
+    const uint64_t sign = (r >> 63) << (width - 1);
+    return sign | ((uint64_t)std::max(exp, 0) << f.mant_w) | (r & ((1ULL << f.mant_w) - 1));
+}
+
+//----------------------------------------------------------------------------
+// Reference
+//----------------------------------------------------------------------------
+
+struct ref_dot_s {
+    s128 sum;  // Exact dot product in units of 2^ref_lsb(width)
+    bool nan;
+    bool pinf;
+    bool ninf;
+    bool all_pzero;
+    bool all_nzero;
+};
+
+static ref_dot_s ref_dot(const uint64_t* a, const uint64_t* b, int n, int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    const int all_ones = (1 << f.exp_w) - 1;
+    ref_dot_s r = {0, false, false, false, true, true};
+    for (int i = 0; i < n; i++) {
+        const uint64_t x[2] = {a[i], b[i]};
+        int exp[2];
+        uint64_t frac[2];
+        for (int j = 0; j < 2; j++) {
+            exp[j] = (int)((x[j] >> f.mant_w) & all_ones);
+            frac[j] = x[j] & ((1ULL << f.mant_w) - 1);
+        }
+        const bool neg = ((a[i] ^ b[i]) >> (width - 1)) & 1;
+        const bool is_nan = (exp[0] == all_ones && frac[0]) || (exp[1] == all_ones && frac[1]);
+        const bool is_inf = (exp[0] == all_ones) || (exp[1] == all_ones);
+        const bool is_zero = (exp[0] == 0 && !frac[0]) || (exp[1] == 0 && !frac[1]);
+        if (is_nan || (is_inf && is_zero)) {
+            r.nan = true;
+        } else if (is_inf) {
+            (neg ? r.ninf : r.pinf) = true;
+        } else if (!is_zero) {
+            // Value of operand j: m_j * 2^(max(exp_j, 1) - bias - mant_w)
+            s128 p = 1;
+            int e = -ref_lsb(width);
+            for (int j = 0; j < 2; j++) {
+                p *= (s128)((exp[j] ? (1ULL << f.mant_w) : 0) | frac[j]);
+                e += std::max(exp[j], 1) - f.bias - f.mant_w;
+            }
+            p <<= e;
+            r.sum += neg ? -p : p;
+        }
+        r.all_pzero = r.all_pzero && is_zero && !is_inf && !is_nan && !neg;
+        r.all_nzero = r.all_nzero && is_zero && !is_inf && !is_nan && neg;
+    }
+    return r;
+}
+
+// Correctly rounded ref (overflow to infinity in every mode)
+static uint64_t ref_round(const ref_dot_s& r, int width, int rm) {
+    const fp_fmt_s f = fp_fmt(width);
+    const uint64_t all_ones = (1ULL << f.exp_w) - 1;
+    if (r.nan || (r.pinf && r.ninf)) return (all_ones << f.mant_w) | (1ULL << (f.mant_w - 1));
+    if (r.pinf || r.ninf) return ((uint64_t)r.ninf << (width - 1)) | (all_ones << f.mant_w);
+    if (r.sum == 0) {
+        const bool zero_sign = r.all_nzero || (rm == RNI && !r.all_pzero);
+        return (uint64_t)zero_sign << (width - 1);
+    }
+
+    const bool sign = r.sum < 0;
+    const u128 m = sign ? (u128)(-r.sum) : (u128)r.sum;
+    int p = 127;
+    while (!((m >> p) & 1)) p--;
+    const int e = std::max(p + ref_lsb(width), 1 - f.bias);  // Exponent of the result (denormals: emin)
+    const int sh = e - f.mant_w - ref_lsb(width);          // Quantum above the reference LSB
+
+    u128 t;
+    bool inc = false;
+    if (sh <= 0) {
+        t = m << -sh;
+    } else {
+        t = m >> sh;
+        const u128 rem = m & (((u128)1 << sh) - 1);
+        const u128 half = (u128)1 << (sh - 1);
+        if (rm == RNE) inc = rem > half || (rem == half && (t & 1));
+        if (rm == RPI) inc = !sign && rem;
+        if (rm == RNI) inc = sign && rem;
+        if (rm == RNA) inc = rem >= half;
+    }
+    t += inc;
+
+    uint64_t exp = (uint64_t)(e + f.bias);
+    if (t >> (f.mant_w + 1)) {
+        t >>= 1;
+        exp++;
+    }
+    const uint64_t sign_bit = (uint64_t)sign << (width - 1);
+    if (exp >= all_ones) return sign_bit | (all_ones << f.mant_w);
+    if (!(t >> f.mant_w)) exp = 0;  // Denormal
+    return sign_bit | (exp << f.mant_w) | ((uint64_t)t & ((1ULL << f.mant_w) - 1));
+}
+
+// v in the format (RNE), through the reference fixed point
+static uint64_t fp_from_ld(long double v, int width) {
+    const ref_dot_s r = {(s128)ldexpl(v, -ref_lsb(width)), false, false, false, true, false};
+    return ref_round(r, width, RNE);
+}
+
+static long double ref_value(const ref_dot_s& r, int width) { return ldexpl((long double)r.sum, ref_lsb(width)); }
+
+//----------------------------------------------------------------------------
+// Self-check
+//----------------------------------------------------------------------------
+
+static int self_check(int width, int carry_w, int count, uint64_t seed) {
+    const fp_fmt_s f = fp_fmt(width);
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + width;
+    int mismatches = 0;
+    std::vector<uint64_t> a, b;
+    for (int v = 0; v < count; v++) {
+        const int n = 1 + (int)(rand_u64(&state) % 64);
+        const bool special = (rand_u64(&state) % 8) == 0;
+        a.resize(n);
+        b.resize(n);
+        for (int i = 0; i < n; i++) {
+            if (width == 16) {
+                a[i] = rand_fp(&state, width, -f.bias, f.bias);
+                b[i] = rand_fp(&state, width, -f.bias, f.bias);
+            } else {
+                a[i] = rand_fp(&state, width, -12, 12);
+                b[i] = rand_fp(&state, width, -12, 12);
+            }
+            if (rand_u64(&state) % 16 == 0) a[i] &= 1ULL << (width - 1);  // Signed zero
+        }
+        if (special) {
+            const uint64_t all_ones = (1ULL << f.exp_w) - 1;
+            const int i = (int)(rand_u64(&state) % n);
+            a[i] = (a[i] & (1ULL << (width - 1))) | (all_ones << f.mant_w) | ((rand_u64(&state) % 4 == 0) ? 1 : 0);
+        }
+
+        const ref_dot_s r = ref_dot(a.data(), b.data(), n, width);
+        for (int rm = RNE; rm <= RNA; rm++) {
+            const uint64_t expected = ref_round(r, width, rm);
+            const uint64_t got = fp_kulisch_dot(a.data(), b.data(), n, width, rm, carry_w);
+            if (got != expected) {
+                if (mismatches < 5)
+                    printf("  fp%d rm %d, n %d: %llx, expected %llx\n", width, rm, n, (unsigned long long)got,
+                           (unsigned long long)expected);
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+//----------------------------------------------------------------------------
+// Benchmark
+//----------------------------------------------------------------------------
+
+static uint64_t chain_dot(const uint64_t* a, const uint64_t* b, int n, int width, int rm) {
+    uint64_t acc = c_fp_mul(a[0], b[0], width, rm);
+    for (int i = 1; i < n; i++) acc = c_fp_add(acc, c_fp_mul(a[i], b[i], width, rm), width, rm);
+    return acc;
+}
+
+struct method_stats_s {
+    double sum_ulp;
+    double max_ulp;
+    int order_changed;
+    int rows;
+};
+
+static void record(method_stats_s& s, uint64_t y, long double exact, int width, bool changed) {
+    const double err = ulp_err(y, exact, width);
+    s.sum_ulp += err;
+    s.max_ulp = std::max(s.max_ulp, err);
+    s.order_changed += changed;
+    s.rows++;
+}
+
+int main(int argc, char** argv) {
+    int width = 0;
+    int n_one = 0;
+    int rows = 200;
+    int carry_w = 16;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--width") && i + 1 < argc) {
+            width = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--n") && i + 1 < argc) {
+            n_one = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--rows") && i + 1 < argc) {
+            rows = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--carry") && i + 1 < argc) {
+            carry_w = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [--width 16|32] [--n N] [--rows N] [--carry N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if ((width && width != 16 && width != 32) || n_one < 0 || n_one > 4096 || rows < 1 || carry_w < 12 ||
+        carry_w > 64) {
+        fprintf(stderr, "--width must be 16 or 32, --n at most 4096, --rows at least 1, --carry 12 .. 64\n");
+        return 2;
+    }
+
+    std::vector<int> widths;
+    if (width) {
+        widths.push_back(width);
+    } else {
+        widths = {16, 32};
+    }
+    std::vector<int> ns;
+    if (n_one) {
+        ns.push_back(n_one);
+    } else {
+        ns.assign(n_list, n_list + sizeof(n_list) / sizeof(n_list[0]));
+    }
+
+    bool pass = true;
+    for (int w : widths) {
+        const int mismatches = self_check(w, carry_w, 20000, seed);
+        printf("Self-check fp%d: accumulator %d bits vs correctly rounded exact dot product, 5 rounding modes: %d mismatches\n",
+               w, fp_kulisch_acc_w(w, carry_w), mismatches);
+        if (mismatches) pass = false;
+    }
+
+    printf("\nErrors vs the exact dot product in ulps (RNE), %d rows, latency %d, ORDER%% = results changed by a shuffle\n\n",
+           rows, fp_kulisch_latency());
+    printf("%-5s | %-7s | %-5s | %-26s | %-26s\n", "WIDTH", "DIST", "N", "CHAIN MEAN/MAX/ORDER%",
+           "KULISCH MEAN/MAX/ORDER%");
+    for (int w : widths) {
+        const fp_fmt_s f = fp_fmt(w);
+        const long double max_finite = ldexpl(2.0L - ldexpl(1.0L, -f.mant_w), f.bias);
+        for (int dist = 0; dist < 2; dist++) {
+            for (int n : ns) {
+                uint64_t state = seed * 0x9E3779B97F4A7C15ULL + n * 2 + dist;
+                method_stats_s chain = {}, kulisch = {};
+                std::vector<uint64_t> a(n), b(n), as(n), bs(n);
+                for (int v = 0; v < rows; v++) {
+                    for (int i = 0; i < n; i++) {
+                        if (dist == 0) {
+                            for (uint64_t* x : {&a[i], &b[i]}) {
+                                const long double u = (long double)(rand_u64(&state) >> 11) / (long double)(1ULL << 53);
+                                const long double x_ld = 2 * u - 1;
+                                *x = (fabsl(x_ld) < 1.0L / 1024) ? 0 : fp_from_ld(x_ld, w);
+                            }
+                        } else {
+                            a[i] = rand_fp(&state, w, (w == 16) ? -3 : -12, (w == 16) ? 3 : 12);
+                            b[i] = rand_fp(&state, w, (w == 16) ? -3 : -12, (w == 16) ? 3 : 12);
+                        }
+                    }
+                    const long double exact = ref_value(ref_dot(a.data(), b.data(), n, w), w);
+                    if (fabsl(exact) < ldexpl(1.0L, 1 - f.bias) || fabsl(exact) > max_finite) continue;
+
+                    as = a;
+                    bs = b;
+                    for (int i = n - 1; i > 0; i--) {
+                        const int j = (int)(rand_u64(&state) % (i + 1));
+                        std::swap(as[i], as[j]);
+                        std::swap(bs[i], bs[j]);
+                    }
+
+                    const uint64_t c = chain_dot(a.data(), b.data(), n, w, RNE);
+                    const uint64_t k = fp_kulisch_dot(a.data(), b.data(), n, w, RNE, carry_w);
+                    record(chain, c, exact, w, c != chain_dot(as.data(), bs.data(), n, w, RNE));
+                    record(kulisch, k, exact, w, k != fp_kulisch_dot(as.data(), bs.data(), n, w, RNE, carry_w));
+                    if (kulisch.max_ulp > 0.5) pass = false;
+                    if (kulisch.order_changed) pass = false;
+                }
+
+                char cs[32], ks[32];
+                const method_stats_s* stats[2] = {&chain, &kulisch};
+                char* out[2] = {cs, ks};
+                for (int m = 0; m < 2; m++) {
+                    const method_stats_s& s = *stats[m];
+                    snprintf(out[m], 32, "%.2f/%.2f/%.0f", s.rows ? s.sum_ulp / s.rows : 0.0, s.max_ulp,
+                             s.rows ? 100.0 * s.order_changed / s.rows : 0.0);
+                }
+                printf("%-5d | %-7s | %-5d | %-26s | %-26s\n", w, dist ? "spread" : "uniform", n, cs, ks);
+            }
+        }
+    }
+
+    printf("\n%s : Kulisch dot product correctly rounded and order independent\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+// verif/lib/fp_kulisch_model.cpp
+//
+// Bit-accurate reference of fp_kulisch.v (see fp_kulisch_model.h).
+//
+
+#include <cstddef>
+
+extern "C" {
+#include "fp_model.h"
+}
+
+#include "fp_kulisch_model.h"
+
+struct fp_fmt_s {
+    int exp_w;
+    int bias;
+    int mant_w;
+};
+
+static fp_fmt_s fp_fmt(int width) {
+    if (width == 64) return {11, 1023, 52};
+    if (width == 32) return {8, 127, 23};
+    return {5, 15, 10};
+}
+
+int fp_kulisch_latency() { return 2 + 2 + 4; }
+
+int fp_kulisch_acc_w(int width, int carry_w) {
+    const fp_fmt_s f = fp_fmt(width);
+    return (1 << (f.exp_w + 1)) - 4 + 2 * f.mant_w + carry_w + 1;
+}
+
+static bool acc_bit(const std::vector<uint64_t>& acc, int i) { return (acc[i / 64] >> (i % 64)) & 1; }
+
+// Keeps the accumulator modulo 2^acc_w
+static void acc_wrap(fp_kulisch_s* k) {
+    const int top = k->acc_w % 64;
+    if (top) k->acc.back() &= (1ULL << top) - 1;
+}
+
+void fp_kulisch_reset(fp_kulisch_s* k, int width, int carry_w) {
+    k->width = width;
+    k->carry_w = carry_w;
+    k->acc_w = fp_kulisch_acc_w(width, carry_w);
+    k->acc.assign((k->acc_w + 63) / 64, 0);
+    k->nan = false;
+    k->pinf = false;
+    k->ninf = false;
+    k->all_pzero = true;
+    k->all_nzero = true;
+}
+
+void fp_kulisch_push(fp_kulisch_s* k, uint64_t a, uint64_t b) {
+    const fp_fmt_s f = fp_fmt(k->width);
+    const uint64_t exp_all_ones = (1ULL << f.exp_w) - 1;
+    const uint64_t exp_a = (a >> f.mant_w) & exp_all_ones;
+    const uint64_t exp_b = (b >> f.mant_w) & exp_all_ones;
+    const uint64_t frac_a = a & ((1ULL << f.mant_w) - 1);
+    const uint64_t frac_b = b & ((1ULL << f.mant_w) - 1);
+    const int sign = ((a ^ b) >> (k->width - 1)) & 1;
+
+    const bool nan = (exp_a == exp_all_ones && frac_a) || (exp_b == exp_all_ones && frac_b);
+    const bool inf_a = (exp_a == exp_all_ones && !frac_a);
+    const bool inf_b = (exp_b == exp_all_ones && !frac_b);
+    const bool zero_a = (exp_a == 0 && !frac_a);
+    const bool zero_b = (exp_b == 0 && !frac_b);
+
+    // Special products (fp_mul stage 1)
+    if (nan || (inf_a && zero_b) || (zero_a && inf_b)) {
+        k->nan = true;
+        k->all_pzero = k->all_nzero = false;
+        return;
+    }
+    if (inf_a || inf_b) {
+        (sign ? k->ninf : k->pinf) = true;
+        k->all_pzero = k->all_nzero = false;
+        return;
+    }
+    if (zero_a || zero_b) {
+        k->all_pzero = k->all_pzero && !sign;
+        k->all_nzero = k->all_nzero && sign;
+        return;
+    }
+    k->all_pzero = k->all_nzero = false;
+
+    // Exact product, LSB at accumulator bit prod_exp + bias - 2 (fp_mul stage 2)
+    const uint64_t mant_a = (exp_a ? (1ULL << f.mant_w) : 0) | frac_a;
+    const uint64_t mant_b = (exp_b ? (1ULL << f.mant_w) : 0) | frac_b;
+    const unsigned __int128 prod = (unsigned __int128)mant_a * mant_b;
+    const int prod_exp = (exp_a ? (int)exp_a : 1) + (exp_b ? (int)exp_b : 1) - f.bias;
+    const int shift = prod_exp + f.bias - 2;
+
+    // Three limbs hold the shifted product (2*mant_w + 2 <= 106 bits)
+    uint64_t part[3];
+    const int s = shift % 64;
+    const uint64_t lo = (uint64_t)prod;
+    const uint64_t hi = (uint64_t)(prod >> 64);
+    part[0] = lo << s;
+    part[1] = s ? (hi << s) | (lo >> (64 - s)) : hi;
+    part[2] = s ? hi >> (64 - s) : 0;
+
+    // Two's complement add / subtract from limb shift / 64 upwards
+    const size_t n = k->acc.size();
+    uint64_t carry = sign ? 1 : 0;
+    for (size_t i = shift / 64, j = 0; i < n; i++, j++) {
+        uint64_t p = (j < 3) ? part[j] : 0;
+        if (sign) p = ~p;
+        if (!sign && j >= 3 && !carry) break;
+        const uint64_t sum = k->acc[i] + p;
+        const uint64_t c1 = sum < p;
+        k->acc[i] = sum + carry;
+        carry = c1 | (k->acc[i] < sum);
+    }
+    acc_wrap(k);
+}
+
+uint64_t fp_kulisch_result(const fp_kulisch_s* k, int rm) {
+    const fp_fmt_s f = fp_fmt(k->width);
+    const uint64_t exp_all_ones = (1ULL << f.exp_w) - 1;
+    const uint64_t qnan = (exp_all_ones << f.mant_w) | (1ULL << (f.mant_w - 1));
+    const int sign_pos = k->width - 1;
+
+    if (k->nan || (k->pinf && k->ninf)) return qnan;
+    if (k->pinf || k->ninf) return ((uint64_t)k->ninf << sign_pos) | (exp_all_ones << f.mant_w);
+
+    // Magnitude and sign
+    std::vector<uint64_t> mag = k->acc;
+    const int sign = acc_bit(mag, k->acc_w - 1);
+    if (sign) {
+        uint64_t carry = 1;
+        for (uint64_t& limb : mag) {
+            limb = ~limb + carry;
+            carry = carry && limb == 0;
+        }
+        const int top = k->acc_w % 64;
+        if (top) mag.back() &= (1ULL << top) - 1;
+    }
+
+    int lead = -1;
+    for (int i = k->acc_w - 1; i >= 0; i--) {
+        if (acc_bit(mag, i)) {
+            lead = i;
+            break;
+        }
+    }
+    if (lead < 0) {
+        const int zero_sign = k->all_nzero || (rm == RNI && !k->all_pzero);
+        return (uint64_t)zero_sign << sign_pos;
+    }
+
+    // Window: implicit bit, mant_w fraction bits, guard and round, then sticky
+    const int p_min = f.bias - 1 + 2 * f.mant_w;
+    const int p_eff = (lead > p_min) ? lead : p_min;
+    const int win_lsb = p_eff - f.mant_w - 2;
+    uint64_t win = 0;
+    for (int i = f.mant_w + 2; i >= 0; i--) {
+        win = (win << 1) | acc_bit(mag, win_lsb + i);
+    }
+    int sticky = 0;
+    for (int i = 0; i < win_lsb && !sticky; i++) {
+        sticky = acc_bit(mag, i);
+    }
+
+    const uint64_t rounded = c_grs_rounder((win << 1) | sticky, sign, rm, f.mant_w + 4, f.mant_w + 1, 1);
+    const uint64_t mant = rounded & ((1ULL << (f.mant_w + 1)) - 1);
+    const int ovf = (rounded >> (f.mant_w + 1)) & 1;
+    const uint64_t exp = (uint64_t)(p_eff - p_min + 1 + ovf);
+
+    const uint64_t sign_bit = (uint64_t)sign << sign_pos;
+    if (exp >= exp_all_ones) return sign_bit | (exp_all_ones << f.mant_w);
+    const uint64_t frac = mant & ((1ULL << f.mant_w) - 1);
+    if (exp == 1 && !(mant >> f.mant_w)) return sign_bit | frac;  // Denormal
+    return sign_bit | (exp << f.mant_w) | frac;
+}
+
+uint64_t fp_kulisch_dot(const uint64_t* a, const uint64_t* b, int n, int width, int rm, int carry_w) {
+    fp_kulisch_s k;
+    fp_kulisch_reset(&k, width, carry_w);
+    for (int i = 0; i < n; i++) fp_kulisch_push(&k, a[i], b[i]);
+    return fp_kulisch_result(&k, rm);
+}
+
+// DPI-C API
+
+static fp_kulisch_s dpi_k;
+
+extern "C" void c_fp_kulisch_reset(const int width, const int carry_w) { fp_kulisch_reset(&dpi_k, width, carry_w); }
+
+extern "C" void c_fp_kulisch_push(uint64_t a, uint64_t b) { fp_kulisch_push(&dpi_k, a, b); }
+
+extern "C" uint64_t c_fp_kulisch_finish(const int rm) {
+    const uint64_t r = fp_kulisch_result(&dpi_k, rm);
+    fp_kulisch_reset(&dpi_k, dpi_k.width, dpi_k.carry_w);
+    return r;
+}
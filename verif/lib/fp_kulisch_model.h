@@ -0,0 +1,59 @@
+// verif/lib/fp_kulisch_model.h
+//
+// Bit-accurate reference of the exact (Kulisch) dot product accumulator
+// (rtl/verilog/fp/fp_kulisch.v).
+//
+// Every product a_i * b_i is exact (fp_mul's unrounded product) and is added
+// into a two's complement fixed-point accumulator of
+//   acc_w = 2^(exp_w+1) - 4 + 2*mant_w + carry_w + 1
+// bits, LSB 2^(2 - 2*bias - 2*mant_w), modulo 2^acc_w like the RTL (exact
+// for up to 2^carry_w products). The row result is rounded once with
+// c_grs_rounder (fp_model.c), so it is the correctly rounded exact dot
+// product, independent of the order of the products.
+//
+// Used natively by fp_kulisch_bench.cpp and from the fp_kulisch testbench
+// through DPI-C (c_fp_kulisch_*).
+//
+
+#ifndef FP_KULISCH_MODEL_H
+#define FP_KULISCH_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+struct fp_kulisch_s {
+    int width;
+    int carry_w;
+    int acc_w;
+    std::vector<uint64_t> acc;  // Two's complement, low limb first
+    bool nan;
+    bool pinf;
+    bool ninf;
+    bool all_pzero;  // Every product so far was +0
+    bool all_nzero;  // Every product so far was -0
+};
+
+// Pipeline latency of fp_kulisch, last product to result
+int fp_kulisch_latency();
+
+// Accumulator width in bits
+int fp_kulisch_acc_w(int width, int carry_w);
+
+// Starts a row
+void fp_kulisch_reset(fp_kulisch_s* k, int width, int carry_w);
+
+// Adds the exact product a * b
+void fp_kulisch_push(fp_kulisch_s* k, uint64_t a, uint64_t b);
+
+// Row result rounded with rm (the accumulator is unchanged)
+uint64_t fp_kulisch_result(const fp_kulisch_s* k, int rm);
+
+// Correctly rounded sum of a[i] * b[i], i < n
+uint64_t fp_kulisch_dot(const uint64_t* a, const uint64_t* b, int n, int width, int rm, int carry_w);
+
+// DPI-C API: push the products of one row, then read the result
+extern "C" void     c_fp_kulisch_reset(const int width, const int carry_w);
+extern "C" void     c_fp_kulisch_push(uint64_t a, uint64_t b);
+extern "C" uint64_t c_fp_kulisch_finish(const int rm);
+
+#endif // FP_KULISCH_MODEL_H
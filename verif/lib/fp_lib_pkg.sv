@@ -8,6 +8,10 @@ package fp_lib_pkg;
     `include "fp_utils.sv"
     `include "fp_pkg_utils.sv"
     `include "common_inc.svh"
+    `include "obj_pool.sv"
+    `include "trans_batch.sv"
+    // base_scoreboard reports through fp_model_base, included further down
+    typedef class fp_model_base;
     `include "base_scoreboard.sv"
     `include "base_test.sv"
     `include "base_transaction.sv"
@@ -17,4 +21,7 @@ package fp_lib_pkg;
     `include "fp_model_base.sv"
     `include "fp_transaction2.sv"
     `include "fp_sequence2_random.sv"
+    `include "fp_sequence2_steered.sv"
+    `include "fp_sequence2_inverse.sv"
+    `include "fp_sequence2_burst.sv"
 endpackage
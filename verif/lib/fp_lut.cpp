@@ -0,0 +1,149 @@
+// verif/lib/fp_lut.cpp
+//
+// Reciprocal and inverse square root initial-guess tables (see fp_lut.h).
+//
+
+#include <cmath>
+
+#include "fp_lut.h"
+
+typedef unsigned __int128 u128;
+
+// Largest address: 2*frac_w + mant_addr_w + 2 must stay below 128 bits
+static const int addr_w_max = 20;
+
+bool fp_lut_spec(const std::string& type, const std::string& precision, int addr_w, fp_lut_spec_s* s) {
+    s->type = type;
+    s->precision = precision;
+    if (precision == "fp16") {
+        s->addr_w = (type == "invsqrt") ? 5 : 4;
+        s->frac_w = 12;
+    } else if (precision == "fp32") {
+        s->addr_w = 8;
+        s->frac_w = 25;
+    } else if (precision == "fp64") {
+        s->addr_w = 10;
+        s->frac_w = 54;
+    } else {
+        return false;
+    }
+    if (type != "recip" && type != "invsqrt") return false;
+    if (addr_w > 0) s->addr_w = addr_w;
+    if (s->addr_w < 2 || s->addr_w > addr_w_max) return false;
+    s->mant_addr_w = (type == "invsqrt") ? s->addr_w - 1 : s->addr_w;
+    return true;
+}
+
+std::vector<fp_lut_spec_s> fp_lut_specs() {
+    std::vector<fp_lut_spec_s> specs;
+    for (const char* precision : {"fp16", "fp32", "fp64"}) {
+        for (const char* type : {"recip", "invsqrt"}) {
+            fp_lut_spec_s s;
+            fp_lut_spec(type, precision, 0, &s);
+            specs.push_back(s);
+        }
+    }
+    return specs;
+}
+
+std::string fp_lut_module(const fp_lut_spec_s& s) {
+    return (s.type == "recip" ? "reciprocal_lut_" : "invsqrt_lut_") + s.precision.substr(2) + "b";
+}
+
+std::string fp_lut_path(const fp_lut_spec_s& s) { return "rtl/verilog/" + s.precision + "/" + fp_lut_module(s) + ".v"; }
+
+static u128 isqrt(u128 n) {
+    u128 x = (u128)sqrtl((long double)n);
+    while (x * x > n) x--;
+    while ((x + 1) * (x + 1) <= n) x++;
+    return x;
+}
+
+uint64_t fp_lut_entry(const fp_lut_spec_s& s, uint32_t addr) {
+    const uint32_t mant = addr & ((1u << s.mant_addr_w) - 1);
+    const u128 m = ((u128)1 << s.mant_addr_w) + mant;  // M * 2^mant_addr_w
+    if (s.type == "recip") return (uint64_t)((((u128)1) << (s.frac_w + s.mant_addr_w)) / m);
+    const int e = addr >> s.mant_addr_w;
+    return (uint64_t)isqrt((((u128)1) << (2 * s.frac_w + s.mant_addr_w)) / (m << e));
+}
+
+std::vector<uint64_t> fp_lut_table(const fp_lut_spec_s& s) {
+    std::vector<uint64_t> table((size_t)1 << s.addr_w);
+    for (size_t i = 0; i < table.size(); i++) table[i] = fp_lut_entry(s, (uint32_t)i);
+    return table;
+}
+
+uint64_t fp_lut_entry_double(const fp_lut_spec_s& s, uint32_t addr) {
+    const uint32_t mant = addr & ((1u << s.mant_addr_w) - 1);
+    const double m = 1.0 + mant / (double)(1u << s.mant_addr_w);
+    const double scale = ldexp(1.0, s.frac_w);
+    if (s.type == "recip") return (uint64_t)(1.0 / m * scale);
+    const int e = addr >> s.mant_addr_w;
+    return (uint64_t)(1.0 / sqrt(m * ldexp(1.0, e)) * scale);
+}
+
+static std::string hex(uint64_t v, int bits) {
+    static const char digits[] = "0123456789abcdef";
+    std::string s((bits + 3) / 4, '0');
+    for (size_t i = s.size(); i-- > 0; v >>= 4) s[i] = digits[v & 15];
+    return s;
+}
+
+std::string fp_lut_verilog(const fp_lut_spec_s& s, const std::vector<uint64_t>& table) {
+    const bool recip = (s.type == "recip");
+    const int data_w = s.frac_w + 1;
+    const std::string a = std::to_string(s.addr_w);
+    const std::string d = std::to_string(data_w);
+    std::string v;
+
+    v += "// " + fp_lut_path(s) + "\n";
+    v += "//======================================================================\n";
+    v += "//\n";
+    v += "// WARNING: THIS MODULE IS AUTO-GENERATED BY verif/lib/fp_lut_gen.cpp.\n";
+    v += "//          DO NOT EDIT THIS MODULE MANUALLY.\n";
+    v += "//          MANUAL EDITS WILL BE OVERWRITTEN ON THE NEXT SCRIPT RUN.\n";
+    v += "//\n";
+    v += "//======================================================================\n";
+    v += "// Verilog RTL Generated by fp_lut_gen (make -f native.mk lut LUT_ARGS=--write)\n";
+    v += "// LUT for " + s.precision + (recip ? " reciprocal" : " inverse square root") + " initial guess.\n";
+    v += std::string("// Function: ") + (recip ? "1/M" : "1/sqrt(M)") + "\n";
+    v += recip ? "// M is constructed from the mantissa MSBs.\n"
+               : "// M is constructed from the exponent LSB and mantissa MSBs.\n";
+    v += "// Entries: floor(2^" + std::to_string(s.frac_w) + " * " + (recip ? "1/M" : "1/sqrt(M)") + "), exact.\n";
+    v += "\n";
+    v += "module " + fp_lut_module(s) + " (\n";
+    v += "    input  [" + std::to_string(s.addr_w - 1) + ":0] addr,\n";
+    v += "    output reg [" + std::to_string(data_w - 1) + ":0] data\n";
+    v += ");\n";
+    v += "\n";
+    if (!recip) {
+        v += "    // This is a large (" + std::to_string(table.size()) + "-entry) but synthesizable LUT.\n";
+        v += "    // It will typically be implemented as a ROM in an FPGA or ASIC.\n";
+    }
+    v += "    always @(*) begin\n";
+    v += "        case (addr)\n";
+    for (size_t i = 0; i < table.size(); i++) {
+        v += "                " + a + "'h" + hex(i, s.addr_w) + ": data = " + d + "'h" + hex(table[i], data_w) + ";\n";
+    }
+    v += "            default: data = " + d + "'h" + hex(1ULL << s.frac_w, data_w) + ";" +
+         (recip ? "" : " // Should not be reached") + "\n";
+    v += "        endcase\n";
+    v += "    end\n";
+    v += "\n";
+    v += "endmodule\n";
+    return v;
+}
+
+std::string fp_lut_c_array(const fp_lut_spec_s& s, const std::vector<uint64_t>& table) {
+    std::string c;
+    c += "// " + fp_lut_module(s) + ": " + (s.type == "recip" ? "1/M" : "1/sqrt(M)") + ", 1." +
+         std::to_string(s.frac_w) + " fixed point, " + std::to_string(s.addr_w) + " address bits\n";
+    c += "static const uint64_t " + fp_lut_module(s) + "[" + std::to_string(table.size()) + "] = {\n";
+    for (size_t i = 0; i < table.size(); i++) {
+        if (i % 4 == 0) c += "   ";
+        c += " 0x" + hex(table[i], s.frac_w + 1) + "ULL,";
+        if (i % 4 == 3 || i + 1 == table.size()) c += "\n";
+    }
+    c += "};\n";
+    return c;
+}
@@ -0,0 +1,55 @@
+// verif/lib/fp_lut.h
+//
+// Initial-guess tables of the reciprocal and inverse square root units
+// (rtl/verilog/fpNN/reciprocal_lut_NNb.v, invsqrt_lut_NNb.v), the single
+// source of the Verilog modules and of the C arrays.
+//
+// Entries are 1.frac_w fixed point, truncated like the original generator,
+// but computed with exact integer arithmetic instead of doubles:
+//   recip   - addr = mantissa MSBs, M = 1 + addr / 2^addr_w,
+//             entry = floor(2^frac_w / M) = floor(2^(frac_w + addr_w) / (2^addr_w + addr))
+//   invsqrt - addr = {exponent LSB, mantissa MSBs}, M = (1 + mant / 2^mant_addr_w) * 2^e
+//             in [1, 4), entry = floor(2^frac_w / sqrt(M)) = isqrt(floor(2^(2*frac_w + mant_addr_w) / ((2^mant_addr_w + mant) << e)))
+//
+// Used by fp_lut_gen.cpp, which writes and checks the in-tree modules.
+//
+
+#ifndef FP_LUT_H
+#define FP_LUT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct fp_lut_spec_s {
+    std::string type;       // "recip" or "invsqrt"
+    std::string precision;  // "fp16", "fp32" or "fp64"
+    int addr_w;             // Address bits
+    int mant_addr_w;        // Mantissa MSBs in the address (invsqrt: addr_w - 1)
+    int frac_w;             // Fraction bits of an entry, data width frac_w + 1
+};
+
+// Table of the in-tree module, or with addr_w address bits if addr_w > 0.
+// False for an unknown type / precision or an address too wide for the
+// 128-bit arithmetic.
+bool fp_lut_spec(const std::string& type, const std::string& precision, int addr_w, fp_lut_spec_s* s);
+
+// The six in-tree tables
+std::vector<fp_lut_spec_s> fp_lut_specs();
+
+// Module name and path of the Verilog file, e.g. rtl/verilog/fp64/reciprocal_lut_64b.v
+std::string fp_lut_module(const fp_lut_spec_s& s);
+std::string fp_lut_path(const fp_lut_spec_s& s);
+
+// Exact entry, and the whole table
+uint64_t fp_lut_entry(const fp_lut_spec_s& s, uint32_t addr);
+std::vector<uint64_t> fp_lut_table(const fp_lut_spec_s& s);
+
+// Entry computed in double precision, as generate_lut.py did
+uint64_t fp_lut_entry_double(const fp_lut_spec_s& s, uint32_t addr);
+
+// Verilog module (path comment first) and C array definition of the table
+std::string fp_lut_verilog(const fp_lut_spec_s& s, const std::vector<uint64_t>& table);
+std::string fp_lut_c_array(const fp_lut_spec_s& s, const std::vector<uint64_t>& table);
+
+#endif // FP_LUT_H
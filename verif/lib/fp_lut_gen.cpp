@@ -0,0 +1,248 @@
+// verif/lib/fp_lut_gen.cpp
+//
+// Native generator and checker of the reciprocal and inverse square root
+// LUT modules (rtl/verilog/fpNN/reciprocal_lut_NNb.v, invsqrt_lut_NNb.v),
+// from the exact tables of fp_lut.cpp.
+//
+// By default it reads the entries of every in-tree module and compares them
+// with the exact table: how many differ and by how many units of the last
+// place at most. The in-tree modules were generated by the double-precision
+// computation of generate_lut.py, so they must hold either the exact or that
+// table; the DOUBLE DIFF column counts the entries where the two differ.
+// Then it times the generation of fp64 tables with 8 to 16 address bits.
+// It fails if a module is missing, incomplete or matches neither table.
+//
+//   --write             - Rewrites the selected in-tree modules with the
+//                         exact tables instead (changes the fp64 units)
+//   --type recip|invsqrt, --precision fp16|fp32|fp64
+//                       - Selects the tables (default: all six)
+//   --addr-bits N       - Address bits (with -o / --c only)
+//   -o FILE             - Writes the Verilog module of one selected table to FILE
+//   --c FILE            - Writes the selected tables as C arrays to FILE
+//
+// Build and run from the repository root (see native.mk):
+//   make -f native.mk lut
+//   make -f native.mk lut LUT_ARGS="--write"
+//   build/native/fp_lut_gen --type recip --precision fp64 --addr-bits 14 -o recip14.v
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "fp_lut.h"
+
+static bool read_file(const std::string& path, std::string* text) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    std::stringstream ss;
+    ss << f.rdbuf();
+    *text = ss.str();
+    return true;
+}
+
+static bool write_file(const std::string& path, const std::string& text) {
+    std::ofstream f(path, std::ios::binary);
+    f << text;
+    return (bool)f;
+}
+
+static std::string strip_cr(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (char c : text) {
+        if (c != '\r') out += c;
+    }
+    return out;
+}
+
+static std::string to_crlf(const std::string& text) {
+    std::string out;
+    out.reserve(text.size() + text.size() / 32);
+    for (char c : text) {
+        if (c == '\n') out += '\r';
+        out += c;
+    }
+    return out;
+}
+
+// Entries of a LUT module, false unless every address of the table is found once
+static bool read_entries(const std::string& text, size_t size, std::vector<uint64_t>* entries) {
+    std::istringstream in(text);
+    std::string line;
+    std::vector<bool> seen(size, false);
+    size_t found = 0;
+    entries->assign(size, 0);
+    while (std::getline(in, line)) {
+        unsigned addr;
+        unsigned long long data;
+        if (sscanf(line.c_str(), " %*d'h%x: data = %*d'h%llx;", &addr, &data) != 2) continue;
+        if (addr >= size || seen[addr]) return false;
+        seen[addr] = true;
+        (*entries)[addr] = data;
+        found++;
+    }
+    return found == size;
+}
+
+static size_t gen_bytes;  // Keeps the generated text live
+
+static double gen_ms(const fp_lut_spec_s& s) {
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::vector<uint64_t> table = fp_lut_table(s);
+    const std::string v = fp_lut_verilog(s, table);
+    const auto t1 = std::chrono::steady_clock::now();
+    gen_bytes += v.size();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main(int argc, char** argv) {
+    bool write = false;
+    std::string type, precision, out_v, out_c;
+    int addr_w = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--write")) {
+            write = true;
+        } else if (!strcmp(argv[i], "--type") && i + 1 < argc) {
+            type = argv[++i];
+        } else if (!strcmp(argv[i], "--precision") && i + 1 < argc) {
+            precision = argv[++i];
+        } else if (!strcmp(argv[i], "--addr-bits") && i + 1 < argc) {
+            addr_w = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            out_v = argv[++i];
+        } else if (!strcmp(argv[i], "--c") && i + 1 < argc) {
+            out_c = argv[++i];
+        } else {
+            fprintf(stderr,
+                    "Usage: %s [--write] [--type recip|invsqrt] [--precision fp16|fp32|fp64] [--addr-bits N] [-o FILE] [--c FILE]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<fp_lut_spec_s> specs;
+    for (const fp_lut_spec_s& t : fp_lut_specs()) {
+        if ((!type.empty() && t.type != type) || (!precision.empty() && t.precision != precision)) continue;
+        fp_lut_spec_s s;
+        if (!fp_lut_spec(t.type, t.precision, addr_w, &s)) {
+            fprintf(stderr, "Error: no %s %s table with %d address bits\n", t.type.c_str(), t.precision.c_str(), addr_w);
+            return 2;
+        }
+        specs.push_back(s);
+    }
+    if (specs.empty()) {
+        fprintf(stderr, "Error: no table matches --type '%s' --precision '%s'\n", type.c_str(), precision.c_str());
+        return 2;
+    }
+
+    // Explicit outputs
+    if (!out_v.empty() || !out_c.empty()) {
+        if (!out_v.empty()) {
+            if (specs.size() != 1) {
+                fprintf(stderr, "Error: -o needs --type and --precision\n");
+                return 2;
+            }
+            if (!write_file(out_v, fp_lut_verilog(specs[0], fp_lut_table(specs[0])))) {
+                fprintf(stderr, "Error: cannot write %s\n", out_v.c_str());
+                return 1;
+            }
+            printf("Wrote %s (%s, %d address bits)\n", out_v.c_str(), fp_lut_module(specs[0]).c_str(), specs[0].addr_w);
+        }
+        if (!out_c.empty()) {
+            std::string c = "// " + out_c + "\n// Generated by verif/lib/fp_lut_gen.cpp, do not edit.\n\n#include <stdint.h>\n";
+            for (const fp_lut_spec_s& s : specs) c += "\n" + fp_lut_c_array(s, fp_lut_table(s));
+            if (!write_file(out_c, c)) {
+                fprintf(stderr, "Error: cannot write %s\n", out_c.c_str());
+                return 1;
+            }
+            printf("Wrote %s (%zu tables)\n", out_c.c_str(), specs.size());
+        }
+        return 0;
+    }
+    if (addr_w > 0) {
+        fprintf(stderr, "Error: --addr-bits applies to -o / --c only (the in-tree modules have fixed sizes)\n");
+        return 2;
+    }
+
+    // In-tree modules
+    bool pass = true;
+    printf("--- In-tree LUT modules (%s) ---\n", write ? "write" : "check");
+    printf("%-20s %5s %5s %8s %12s %10s %8s  %s\n", "MODULE", "ADDR", "DATA", "ENTRIES", "DOUBLE DIFF", "EXACT DIFF",
+           "MAX ULP", "FILE");
+    for (const fp_lut_spec_s& s : specs) {
+        const std::vector<uint64_t> table = fp_lut_table(s);
+        const std::string text = fp_lut_verilog(s, table);
+        const std::string path = fp_lut_path(s);
+        std::vector<uint64_t> double_table(table.size());
+        int double_diffs = 0;
+        for (size_t i = 0; i < table.size(); i++) {
+            double_table[i] = fp_lut_entry_double(s, (uint32_t)i);
+            double_diffs += double_table[i] != table[i];
+        }
+
+        std::string current;
+        const bool exists = read_file(path, &current);
+        std::vector<uint64_t> entries;
+        int exact_diffs = -1;
+        uint64_t max_ulp = 0;
+        if (exists && read_entries(strip_cr(current), table.size(), &entries)) {
+            exact_diffs = 0;
+            for (size_t i = 0; i < table.size(); i++) {
+                const uint64_t ulp = entries[i] > table[i] ? entries[i] - table[i] : table[i] - entries[i];
+                exact_diffs += ulp != 0;
+                if (ulp > max_ulp) max_ulp = ulp;
+            }
+        }
+        std::string status;
+        if (write) {
+            // Keep the line endings of the file in the tree
+            const bool crlf = exists && current.find("\r\n") != std::string::npos;
+            const std::string out = crlf ? to_crlf(text) : text;
+            if (exists && current == out) {
+                status = "unchanged";
+            } else if (write_file(path, out)) {
+                status = "written";
+            } else {
+                status = "ERROR (cannot write)";
+                pass = false;
+            }
+        } else if (!exists) {
+            status = "MISSING";
+            pass = false;
+        } else if (exact_diffs < 0) {
+            status = "ERROR (incomplete table)";
+            pass = false;
+        } else if (exact_diffs == 0) {
+            status = "OK (exact)";
+        } else if (entries == double_table) {
+            status = "OK (double)";
+        } else {
+            status = "DIFFERS";
+            pass = false;
+        }
+        printf("%-20s %5d %5d %8zu %12d %10d %8llu  %s: %s\n", fp_lut_module(s).c_str(), s.addr_w, s.frac_w + 1,
+               table.size(), double_diffs, exact_diffs, (unsigned long long)max_ulp, path.c_str(), status.c_str());
+    }
+
+    // Larger tables
+    printf("\n--- Generation time, fp64 tables (exact entries and Verilog text) ---\n");
+    printf("%5s %8s %12s %12s\n", "ADDR", "ENTRIES", "RECIP ms", "INVSQRT ms");
+    for (int a = 8; a <= 16; a += 2) {
+        fp_lut_spec_s r, q;
+        fp_lut_spec("recip", "fp64", a, &r);
+        fp_lut_spec("invsqrt", "fp64", a, &q);
+        printf("%5d %8d %12.2f %12.2f\n", a, 1 << a, gen_ms(r), gen_ms(q));
+    }
+
+    printf("\n%s : LUT modules %s\n", pass ? "PASS" : "FAIL",
+           write ? "written from the exact tables" : (pass ? "hold the exact or the double tables" : "differ from both tables"));
+    return pass ? 0 : 1;
+}
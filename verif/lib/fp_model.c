@@ -6,6 +6,7 @@
 // trusted IEEE 754 hardware, and converting the result back.
 //
 
+#include <stddef.h>
 #include <stdint.h>
 #include <math.h>
 
@@ -269,17 +270,15 @@ void c_fp_classify(const uint64_t in, const int width, fp_classify_outputs_s* ou
     }
 }
 
-// Helper function for GRS rounding logic, mirroring Python's grs_round
-static int grs_round_c(uint_ap_t value_in, int sign_in, int mode, int input_width, int output_width) {
+// Returns the {Guard, Round, Sticky} bits of value_in when it is rounded from
+// input_width down to output_width bits, packed as g << 2 | r << 1 | s.
+static int grs_pattern_c(uint_ap_t value_in, int input_width, int output_width) {
     int shift_amount = input_width - output_width;
 
     if (shift_amount <= 0) {
         return 0;
     }
 
-    // LSB of the part that will be kept (bit at position 'shift_amount')
-    int lsb = uint_ap_get_bit(value_in, shift_amount);
-
     // Guard bit: The most significant bit of the truncated portion (bit at position 'shift_amount - 1')
     int g = (shift_amount >= 1) ? uint_ap_get_bit(value_in, shift_amount - 1) : 0;
 
@@ -292,6 +291,24 @@ static int grs_round_c(uint_ap_t value_in, int sign_in, int mode, int input_widt
         // Check if any bit from 0 to (shift_amount - 3) is set.
         s = uint_ap_is_any_bit_set_up_to(value_in, shift_amount - 3);
     }
+    return (g << 2) | (r << 1) | s;
+}
+
+// Helper function for GRS rounding logic, mirroring Python's grs_round
+static int grs_round_c(uint_ap_t value_in, int sign_in, int mode, int input_width, int output_width) {
+    int shift_amount = input_width - output_width;
+
+    if (shift_amount <= 0) {
+        return 0;
+    }
+
+    // LSB of the part that will be kept (bit at position 'shift_amount')
+    int lsb = uint_ap_get_bit(value_in, shift_amount);
+
+    int grs = grs_pattern_c(value_in, input_width, output_width);
+    int g = (grs >> 2) & 1;
+    int r = (grs >> 1) & 1;
+    int s = grs & 1;
 
     int inexact = g | r | s;
     int increment = 0;
@@ -319,9 +336,97 @@ static int grs_round_c(uint_ap_t value_in, int sign_in, int mode, int input_widt
     return increment;
 }
 
-// The exported DPI-C function that will be called from SystemVerilog
-// This is a bit-accurate model of fp_add.v for parameterized fp, with configurable intermediate precision.
-uint64_t c_fp_add_ex(uint64_t a_val, uint64_t b_val, const int width, const int rm, const int precision_bits) {
+// Bit-accurate model of grs_rounder.v.
+// The compound incrementer forms base and base+1 in parallel with the rounding
+// decision, which then only selects between them. The carry out is the
+// all-ones detection of base, and the value wraps to zero on overflow.
+// output_width must not exceed 64 bits.
+static uint64_t grs_rounder_c(uint_ap_t value_in, int sign_in, int mode, int input_width, int output_width, int* overflow_out) {
+    const uint64_t mask = (output_width >= 64) ? ~0ULL : ((1ULL << output_width) - 1);
+    int increment = grs_round_c(value_in, sign_in, mode, input_width, output_width);
+    int shift_amount = input_width - output_width;
+    uint64_t base = uint_ap_to_uint64(uint_ap_rshift(value_in, shift_amount > 0 ? shift_amount : 0)) & mask;
+    uint64_t base_plus_one = (base + 1) & mask;
+    int base_all_ones = (base == mask);
+
+    *overflow_out = increment & base_all_ones;
+    return increment ? base_plus_one : base;
+}
+
+// DPI-C / ctypes entry point for the rounder alone.
+// compound=1 evaluates the C model of grs_rounder.v (GRS decision, compound
+// incrementer), compound=0 an independent reference: the magnitude
+// value_in / 2^(input_width - output_width) rounded exactly per mode, by
+// comparing the discarded remainder with one half, without the GRS bits.
+// Returns {overflow, value} packed as value | overflow << output_width.
+uint64_t c_grs_rounder(uint64_t value_in, const int sign_in, const int rm, const int input_width, const int output_width, const int compound) {
+    int overflow;
+    uint64_t value;
+    if (compound) {
+        value = grs_rounder_c(uint_ap_from_uint64(value_in), sign_in, rm, input_width, output_width, &overflow);
+    } else {
+        const int shift = input_width - output_width;
+        const uint64_t quotient = value_in >> shift;
+        const uint64_t remainder = value_in & ((1ULL << shift) - 1);
+        const uint64_t half = (shift > 0) ? 1ULL << (shift - 1) : 0;
+        int up;
+        switch (shift > 0 ? rm : RTZ) {
+            case RNE: up = remainder > half || (remainder == half && (quotient & 1)); break;
+            case RPI: up = remainder != 0 && !sign_in; break;
+            case RNI: up = remainder != 0 && sign_in; break;
+            case RNA: up = remainder >= half; break;
+            default:  up = 0; break;  // RTZ
+        }
+        const uint64_t sum = quotient + up;
+        overflow = (sum >> output_width) & 1;
+        value = sum & ((1ULL << output_width) - 1);
+    }
+    return value | ((uint64_t)overflow << output_width);
+}
+
+// Exhaustive sweep of the C model of grs_rounder.v against the exact
+// rounding reference of c_grs_rounder(): all input values, both signs and all
+// five rounding modes. Returns the number of mismatches. This checks the C
+// model's rounding decision and incrementer, not the RTL, which is checked
+// against the C model by the testbenches.
+// Limited to input_width <= 24 and output_width < input_width.
+int c_grs_rounder_sweep(const int input_width, const int output_width) {
+    if (input_width > 24 || output_width < 1 || output_width >= input_width) {
+        return -1;
+    }
+    int mismatches = 0;
+    for (uint64_t value = 0; value < (1ULL << input_width); value++) {
+        for (int sign = 0; sign < 2; sign++) {
+            for (int rm = RNE; rm <= RNA; rm++) {
+                if (c_grs_rounder(value, sign, rm, input_width, output_width, 1) !=
+                    c_grs_rounder(value, sign, rm, input_width, output_width, 0)) {
+                    mismatches++;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+// Returns the FP_CLASS_* of an unpacked operand
+static int fp_class_c(unsigned int exp, uint64_t mant, uint64_t exp_all_ones) {
+    if (exp == exp_all_ones) {
+        return mant ? FP_CLASS_NAN : FP_CLASS_INF;
+    }
+    if (exp == 0) {
+        return mant ? FP_CLASS_DENORMAL : FP_CLASS_ZERO;
+    }
+    return FP_CLASS_NORMAL;
+}
+
+// Bit-accurate model of fp_add.v for parameterized fp, with configurable intermediate precision.
+// Records the datapath events into *trace (may be NULL).
+static uint64_t fp_add_traced(uint64_t a_val, uint64_t b_val, const int width, const int rm, const int precision_bits, fp_trace_s* trace) {
+    fp_trace_s trace_unused;
+    if (!trace) {
+        trace = &trace_unused;
+    }
+
     // FP constants based on width
     int EXP_W;
     // const int EXP_BIAS = 15, 127, 1023; // Not directly used in this bit-accurate logic
@@ -358,6 +463,11 @@ uint64_t c_fp_add_ex(uint64_t a_val, uint64_t b_val, const int width, const int
     int is_inf_b = (exp_b == EXP_ALL_ONES && mant_b == 0);
     int is_zero_b = (exp_b == 0 && mant_b == 0);
 
+    *trace = (fp_trace_s){0};
+    trace->class_a = fp_class_c(exp_a, mant_a, EXP_ALL_ONES);
+    trace->class_b = fp_class_c(exp_b, mant_b, EXP_ALL_ONES);
+    trace->special = 1;
+
     if (is_nan_a || is_nan_b) {
         // Return canonical qNaN
         return ((uint64_t)EXP_ALL_ONES << MANT_W) | (1ULL << (MANT_W - 1));
@@ -382,6 +492,7 @@ uint64_t c_fp_add_ex(uint64_t a_val, uint64_t b_val, const int width, const int
     if (is_zero_b) {
         return a_val;
     }
+    trace->special = 0;
 
     // Add implicit bit (1 for normal, 0 for denormal)
     uint64_t full_mant_a = ((uint64_t)(exp_a != 0) << MANT_W) | mant_a;  // width=MANT_W+1
@@ -413,6 +524,10 @@ uint64_t c_fp_add_ex(uint64_t a_val, uint64_t b_val, const int width, const int
         }
         res_exp = eff_exp_b;
     }
+    trace->exp_diff = exp_diff;
+    trace->exp_res = res_exp;
+    trace->mant_a = mant_a_aligned;
+    trace->mant_b = mant_b_aligned;
 
     // Add or Subtract
     int op_is_sub = sign_a != sign_b;
@@ -432,7 +547,13 @@ uint64_t c_fp_add_ex(uint64_t a_val, uint64_t b_val, const int width, const int
         res_sign = sign_a; // Sign is the same as operands
     }
 
+    trace->op_is_sub = op_is_sub;
+    trace->sign = res_sign;
+    trace->mant_res[0] = res_mant;
+
     if (res_mant == 0) {
+        trace->exact_zero = 1;
+        trace->exp_unf = 1;
         // Result is exact zero. Handle signed zero for RNI mode if it was a subtraction.
         return (rm == RNI && op_is_sub) ? (1ULL << SIGN_POS) : 0;
     }
@@ -462,38 +583,39 @@ uint64_t c_fp_add_ex(uint64_t a_val, uint64_t b_val, const int width, const int
         }
     }
     res_exp -= shift;
+    trace->norm_shift = shift;
 
     // Rounding
     // The implicit bit is at ALIGN_MANT_W-1, mantissa is below it.
-    // We want to round to MANT_W bits.
-    // The input to the rounder is the mantissa without the implicit bit.
-    int rounder_input_width = ALIGN_MANT_W - 1; // Bits from 0 to ALIGN_MANT_W-2
-    int rounder_output_width = MANT_W;
-
-    // Extract the portion of res_mant that goes into the rounder
-    // This is the mantissa *after* the implicit bit, extended by precision_bits
-    uint64_t rounder_input = res_mant & ((1ULL << rounder_input_width) - 1);
-    // Convert to arbitrary precision type for grs_round_c
-    uint_ap_t rounder_input_ap = uint_ap_from_uint64(rounder_input);
-
-    int increment = grs_round_c(rounder_input_ap, res_sign, rm, rounder_input_width, rounder_output_width);
-
-    uint64_t rounded_mant_no_implicit = (rounder_input >> (rounder_input_width - rounder_output_width)) + increment;
-
-    // Check for mantissa overflow from rounding
-    if ((rounded_mant_no_implicit >> MANT_W) != 0) { // If bit MANT_W is set (i.e., 1 << MANT_W)
+    // We want to round to MANT_W bits, the rounder keeps the implicit bit
+    // (MANT_W+1 bits) so its carry out flags the mantissa overflow.
+    int rounder_input_width = ALIGN_MANT_W;
+    int rounder_output_width = MANT_W + 1;
+    uint_ap_t rounder_input_ap = uint_ap_from_uint64(res_mant & ((1ULL << rounder_input_width) - 1));
+    trace->round_in[0] = rounder_input_ap.parts[0];
+
+    int rounder_overflow;
+    uint64_t rounded_mant_w_implicit = grs_rounder_c(rounder_input_ap, res_sign, rm, rounder_input_width, rounder_output_width, &rounder_overflow);
+    trace->grs = grs_pattern_c(rounder_input_ap, rounder_input_width, rounder_output_width);
+    trace->round_inc = grs_round_c(rounder_input_ap, res_sign, rm, rounder_input_width, rounder_output_width);
+    trace->round_ovf = rounder_overflow;
+
+    // On mantissa overflow the rounded value has wrapped to zero, which is the
+    // fraction of 1.0 * 2^(exp+1): only the exponent is selected, no re-shift.
+    if (rounder_overflow) {
         res_exp += 1;
-        rounded_mant_no_implicit >>= 1; // Shift right to keep MANT_W bits
     }
 
-    uint64_t final_mant = rounded_mant_no_implicit & MANT_MASK; // Extract MANT_W bits
+    uint64_t final_mant = rounded_mant_w_implicit & MANT_MASK; // Extract MANT_W bits
 
     // Final checks for overflow/underflow
     uint64_t final_exp;
     if (res_exp >= (int)EXP_ALL_ONES) { // Overflow to infinity
         final_exp = EXP_ALL_ONES;
         final_mant = 0;
+        trace->exp_ovf = 1;
     } else if (res_exp <= 0) { // Underflow to denormal or zero
+        trace->exp_unf = 1;
         // Simplified: flush to zero. A full model would create denormals.
         // TODO: (when needed) Implement denormal values result
         final_exp = 0;
@@ -507,21 +629,40 @@ uint64_t c_fp_add_ex(uint64_t a_val, uint64_t b_val, const int width, const int
     return result_int;
 }
 
+// The exported DPI-C function that will be called from SystemVerilog
+// This is a bit-accurate model of fp_add.v for parameterized fp, with configurable intermediate precision.
+uint64_t c_fp_add_ex(uint64_t a_val, uint64_t b_val, const int width, const int rm, const int precision_bits) {
+    return fp_add_traced(a_val, b_val, width, rm, precision_bits, NULL);
+}
 
-// Bit-accurate fp_add model with default precision_bits
-uint64_t c_fp_add(uint64_t a, uint64_t b, const int width, const int rm) {
-    int precision_bits;
-    switch (width) { 
-        case 64: precision_bits = 7; break;
-        case 32: precision_bits = 7; break;
+// Default fp_add precision_bits per width, as instantiated in the testbenches
+static int fp_add_precision_bits(const int width) {
+    switch (width) {
+        case 64: return 7;
+        case 32: return 7;
         case 16:
-        default: precision_bits = 32; break;
+        default: return 32;
     }
-    return c_fp_add_ex(a, b, width, rm, precision_bits);
 }
 
-// Bit-accurate fp_mul model
-uint64_t c_fp_mul(uint64_t a_val, uint64_t b_val, const int width, const int rm) {
+
+// Bit-accurate fp_add model with default precision_bits
+uint64_t c_fp_add(uint64_t a, uint64_t b, const int width, const int rm) {
+    return c_fp_add_ex(a, b, width, rm, fp_add_precision_bits(width));
+}
+
+// fp_add model with default precision_bits that also returns the datapath trace
+uint64_t c_fp_add_trace(uint64_t a, uint64_t b, const int width, const int rm, fp_trace_s* trace) {
+    return fp_add_traced(a, b, width, rm, fp_add_precision_bits(width), trace);
+}
+
+// Bit-accurate fp_mul model that also returns the datapath trace (trace may be NULL)
+uint64_t c_fp_mul_trace(uint64_t a_val, uint64_t b_val, const int width, const int rm, fp_trace_s* trace) {
+    fp_trace_s trace_unused;
+    if (!trace) {
+        trace = &trace_unused;
+    }
+
     // FP constants based on width
     int EXP_W, EXP_BIAS;
     switch (width) {
@@ -556,6 +697,11 @@ uint64_t c_fp_mul(uint64_t a_val, uint64_t b_val, const int width, const int rm)
 
     int res_sign = sign_a ^ sign_b;
 
+    *trace = (fp_trace_s){0};
+    trace->class_a = fp_class_c(exp_a, mant_a, EXP_ALL_ONES);
+    trace->class_b = fp_class_c(exp_b, mant_b, EXP_ALL_ONES);
+    trace->special = 1;
+
     if (is_nan_a || is_nan_b) {
         return is_nan_a ? a_val : b_val; // Propagate NaN
     }
@@ -568,6 +714,8 @@ uint64_t c_fp_mul(uint64_t a_val, uint64_t b_val, const int width, const int rm)
     if (is_zero_a || is_zero_b) {
         return (uint64_t)res_sign << SIGN_POS; // +/- Zero
     }
+    trace->special = 0;
+    trace->sign = res_sign;
 
     // Exponent sum
     unsigned int eff_exp_a = (exp_a != 0) ? exp_a : 1;
@@ -580,6 +728,10 @@ uint64_t c_fp_mul(uint64_t a_val, uint64_t b_val, const int width, const int rm)
 
     // Stage 2: Mantissa Multiplication
     uint_ap_t mant_product = uint_ap_mul_u64(full_mant_a, full_mant_b); // Result is up to 2*(MANT_W+1) bits
+    trace->mant_a = full_mant_a;
+    trace->mant_b = full_mant_b;
+    trace->mant_res[0] = mant_product.parts[0];
+    trace->mant_res[1] = mant_product.parts[1];
 
     // Stage 3: Normalize
     int norm_exp;
@@ -591,6 +743,8 @@ uint64_t c_fp_mul(uint64_t a_val, uint64_t b_val, const int width, const int rm)
         norm_exp = exp_sum;
         norm_mant = mant_product;
     }
+    trace->exp_res = norm_exp;
+    trace->norm_shift = (norm_exp != exp_sum);
 
     // Final Stage: Round and Pack
     int is_underflow = norm_exp <= 0;
@@ -604,23 +758,36 @@ uint64_t c_fp_mul(uint64_t a_val, uint64_t b_val, const int width, const int rm)
 
     int rounder_input_width = 2 * MANT_W + 1;
     int rounder_output_width = MANT_W + 1; // Keep implicit bit
-    int increment = grs_round_c(mant_to_round, res_sign, rm, rounder_input_width, rounder_output_width);
-    uint_ap_t rounded_mant_w_implicit = uint_ap_add_u64(uint_ap_rshift(mant_to_round, rounder_input_width - rounder_output_width), increment);
-
-    int rounder_overflow = uint_ap_get_bit(rounded_mant_w_implicit, MANT_W + 1);
-    int final_exp_rounded = norm_exp + rounder_overflow;
+    trace->round_in[0] = mant_to_round.parts[0];
+    trace->round_in[1] = mant_to_round.parts[1];
+    int rounder_overflow;
+    uint64_t rounded_mant_w_implicit = grs_rounder_c(mant_to_round, res_sign, rm, rounder_input_width, rounder_output_width, &rounder_overflow);
+    trace->grs = grs_pattern_c(mant_to_round, rounder_input_width, rounder_output_width);
+    trace->round_inc = grs_round_c(mant_to_round, res_sign, rm, rounder_input_width, rounder_output_width);
+    trace->round_ovf = rounder_overflow;
+    trace->exp_unf = is_underflow;
+
+    // Exponent is selected by the rounder carry (the mantissa wrapped to zero)
+    int final_exp_rounded = rounder_overflow ? norm_exp + 1 : norm_exp;
 
     uint64_t out_exp, out_mant;
     if (final_exp_rounded >= (int)EXP_ALL_ONES) { // Overflow
         out_exp = EXP_ALL_ONES;
         out_mant = 0;
+        trace->exp_ovf = 1;
     } else if (is_underflow) {
-        out_exp = 0;
-        out_mant = uint_ap_to_uint64(rounded_mant_w_implicit) & MANT_MASK;
+        // A denormal that rounds up into the implicit bit becomes the smallest normal
+        out_exp = (rounded_mant_w_implicit >> MANT_W) & 1;
+        out_mant = rounded_mant_w_implicit & MANT_MASK;
     } else { // Normal number
         out_exp = final_exp_rounded;
-        out_mant = uint_ap_to_uint64(rounded_mant_w_implicit) & MANT_MASK;
+        out_mant = rounded_mant_w_implicit & MANT_MASK;
     }
 
     return ((uint64_t)res_sign << SIGN_POS) | (out_exp << MANT_W) | out_mant;
 }
+
+// Bit-accurate fp_mul model
+uint64_t c_fp_mul(uint64_t a_val, uint64_t b_val, const int width, const int rm) {
+    return c_fp_mul_trace(a_val, b_val, width, rm, NULL);
+}
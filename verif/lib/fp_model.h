@@ -22,6 +22,48 @@ typedef union {
 #define RNI 3  // Round Towards Negative Infinity
 #define RNA 4  // Round to Nearest, Ties Away from Zero
 
+// Operand classes reported in fp_trace_s
+#define FP_CLASS_ZERO     0
+#define FP_CLASS_DENORMAL 1
+#define FP_CLASS_NORMAL   2
+#define FP_CLASS_INF      3
+#define FP_CLASS_NAN      4
+#define FP_NUM_CLASSES    5
+
+// Datapath trace of one fp_add / fp_mul evaluation, filled by c_fp_add_trace()
+// and c_fp_mul_trace(). Used by the coverage model (fp_cov_steer.c) to see the
+// internal events of the bit-accurate models, and printed next to the RTL
+// signals by the replay harness (fp_replay.c). All fields after 'special' are
+// only valid when special == 0.
+typedef struct {
+    int class_a;     // FP_CLASS_* of operand a
+    int class_b;     // FP_CLASS_* of operand b
+    int special;     // 1 if the result came from the special-case path
+    int exp_diff;    // fp_add: eff_exp_a - eff_exp_b (alignment shift); fp_mul: 0
+    int exp_res;     // fp_add: exponent after alignment; fp_mul: normalized product exponent
+    int op_is_sub;   // fp_add: effective subtraction; fp_mul: 0
+    int norm_shift;  // fp_add: left shift to normalize (-1 on carry out); fp_mul: 1 if product >= 2.0
+    int exact_zero;  // fp_add: the effective subtraction cancelled to exactly zero
+    int sign;        // Sign of the (non-special) result
+    int grs;         // {Guard, Round, Sticky} bits at the rounder input
+    int round_inc;   // Rounder increment decision
+    int round_ovf;   // Rounder carry out (mantissa rounded up to 2.0)
+    int exp_ovf;     // Result overflowed to infinity
+    int exp_unf;     // Result underflowed (denormal or zero)
+    uint64_t mant_a;       // fp_add: aligned mantissa of a; fp_mul: significand of a
+    uint64_t mant_b;       // fp_add: aligned mantissa of b; fp_mul: significand of b
+    uint64_t mant_res[2];  // fp_add: sum / difference; fp_mul: product (low word first)
+    uint64_t round_in[2];  // Rounder input (low word first)
+} fp_trace_s;
+
+uint64_t c_fp_add(uint64_t a, uint64_t b, const int width, const int rm);
+uint64_t c_fp_mul(uint64_t a_val, uint64_t b_val, const int width, const int rm);
+uint64_t c_fp_add_trace(uint64_t a, uint64_t b, const int width, const int rm, fp_trace_s* trace);
+uint64_t c_fp_mul_trace(uint64_t a, uint64_t b, const int width, const int rm, fp_trace_s* trace);
+
+// grs_rounder.v alone, returns value | overflow << output_width (input_width <= 64)
+uint64_t c_grs_rounder(uint64_t value_in, const int sign_in, const int rm, const int input_width, const int output_width, const int compound);
+
 
 // Define the output struct using C bit-fields to ensure a memory layout
 // identical to the SystemVerilog 'struct packed'. The total size is 10 bits.
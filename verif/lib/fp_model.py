@@ -637,10 +637,11 @@ def fp_add(
         rounder_input >> (rounder_input_width - rounder_output_width)
     ) + increment
 
-    # Check for mantissa overflow from rounding
+    # Check for mantissa overflow from rounding. The rounded fraction has
+    # wrapped to zero, which is already the fraction of 1.0 * 2^(exp+1)
+    # (compound rounder in grs_rounder.v): only the exponent changes.
     if rounded_mant_no_implicit >> MANT_W:
         res_exp += 1
-        rounded_mant_no_implicit >>= 1
 
     final_mant = rounded_mant_no_implicit & ((1 << MANT_W) - 1)
 
@@ -804,12 +805,9 @@ def fp_mul(
         out_exp = EXP_ALL_ONES
         out_mant = MANT_ALL_ZEROS
     elif is_underflow:
-        if final_exp_rounded > 0:  # Rounded back up to smallest normal
-            out_exp = 1
-            out_mant = MANT_ALL_ZEROS
-        else:
-            out_exp = EXP_ALL_ZEROS
-            out_mant = rounded_mant_w_implicit & MANT_MASK
+        # A denormal that rounds up into the implicit bit becomes the smallest normal
+        out_exp = (rounded_mant_w_implicit >> MANT_W) & 1
+        out_mant = rounded_mant_w_implicit & MANT_MASK
     else:  # Normal number
         out_exp = final_exp_rounded
         out_mant = rounded_mant_w_implicit & MANT_MASK
@@ -12,9 +12,45 @@ virtual class fp_model_base #(type T = uvm_sequence_item) extends uvm_object;
     // MUST implement a function with this exact signature.
     pure virtual function void predict(T trans_in, ref T trans_out);
 
+    // +FAST_MODEL: models with a dual-path predictor (fp_fast.c) use it
+    bit fast;
+
+    // Coverage context of fp_sequence2_steered (-1 if none): predict() samples
+    // the observed operations into the steering coverage (fp_cov_steer.c)
+    int cov_handle = -1;
+
     // Standard constructor for a uvm_object
     function new(string name="fp_model_base");
         super.new(name);
+        fast = $test$plusargs("FAST_MODEL");
+    endfunction
+
+    // One-line summary for the scoreboard report, empty if there is nothing to report
+    virtual function string report();
+        return "";
+    endfunction
+
+    // Samples one observed operation into the steering coverage
+    protected function void sample_cov(longint unsigned a, longint unsigned b, int rm);
+        if (cov_handle >= 0)
+            c_fp_cov_sample(cov_handle, a, b, rm);
+    endfunction
+
+    // Prints the steering coverage per group, returns the one-line summary
+    protected function string cov_report();
+        if (cov_handle < 0)
+            return "";
+        c_fp_cov_report(cov_handle);
+        return $sformatf("Steering coverage of the observed operations: %0d/%0d bins",
+            c_fp_cov_hit(cov_handle), c_fp_cov_bins(cov_handle));
+    endfunction
+
+    // Native hit rate of the fp_fast.c predictor (op: 0 - fp_add, 1 - fp_mul)
+    protected function string fast_report(int op);
+        longint unsigned calls, hits;
+        c_fp_fast_counts(op, calls, hits);
+        return $sformatf("Fast predictor: %0d predictions, %0d native (%0.1f%%)",
+            calls, hits, calls ? 100.0 * hits / calls : 0.0);
     endfunction
 
 endclass
@@ -46,6 +46,9 @@ def load_libfp() -> CDLL:
         libfp.c_fp_add.restype = c_uint64
         libfp.c_fp_mul.argtypes = [c_uint64, c_uint64, ctypes.c_int, ctypes.c_int]
         libfp.c_fp_mul.restype = c_uint64
+        # Rounder
+        libfp.c_grs_rounder_sweep.argtypes = [ctypes.c_int, ctypes.c_int]
+        libfp.c_grs_rounder_sweep.restype = ctypes.c_int
     return libfp
 
 
@@ -685,6 +688,28 @@ def tests(width: int = 16, rms: Optional[List[str]] = None) -> List[Dict[str, An
     return all_failures
 
 
+def rounder_sweep() -> int:
+    """
+    Compare the C model of grs_rounder.v (GRS decision, compound incrementer)
+    with exact rounding of the discarded bits, exhaustively for all rounding
+    modes. This checks the C model, not the RTL.
+
+    Returns:
+        int: The total number of mismatches.
+    """
+    lib = load_libfp()
+    # (INPUT_WIDTH, OUTPUT_WIDTH) pairs, covering the grs_rounder_tb shape and
+    # the fp16 units' implicit-bit rounding with a few extra precision bits.
+    widths = [(8, 4), (12, 11), (14, 11), (16, 11), (20, 11), (22, 11)]
+    total = 0
+    print("\nCompound Rounder Equivalence Sweep")
+    for in_w, out_w in widths:
+        mismatches = lib.c_grs_rounder_sweep(in_w, out_w)
+        print(f"{'FAIL' if mismatches else 'PASS'} : grs_rounder {in_w}->{out_w} {mismatches} mismatches")
+        total += abs(mismatches)
+    return total
+
+
 def write_failure_log(
     failures: List[Dict[str, Any]], log_filename: str, start_time: datetime
 ):
@@ -746,6 +771,7 @@ def main() -> int:
         width_failures = tests(width, rms)
         results[width] = len(width_failures)
         all_failures.extend(width_failures)
+    rounder_errors = rounder_sweep()
 
     print()
     print("Final Summary:")
@@ -753,7 +779,9 @@ def main() -> int:
     for width, res in results.items():  # print results for each width separately:
         print(f"{'FAIL' if res else 'PASS'} : FP{width} {res} errors")
     print("-" * 100)
-    total_errors = len(all_failures)
+    print(f"{'FAIL' if rounder_errors else 'PASS'} : ROUNDER {rounder_errors} errors")
+    print("-" * 100)
+    total_errors = len(all_failures) + rounder_errors
     print(f"{'FAIL' if total_errors else 'PASS'} : TOTAL {total_errors} errors")
     print("-" * 100)
     print()
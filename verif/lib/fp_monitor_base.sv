@@ -3,6 +3,14 @@
 // Generic, parameterized base class for a monitor. It uses a queue to handle
 // pipelined designs and has a pure virtual task 'sample_inputs' that must
 // be implemented by a child class.
+//
+// Transactions come from obj_pool (sampled inputs from the child's
+// sample_inputs(), driven ones from the sequences) and are released here once
+// they have been written to the analysis port.
+//
+// For a burst item from the driver (burst_size() > 0) the next burst_size()
+// results are built from the sampled inputs alone and published in batches of
+// batch_size through batch_ap instead of one ap.write() each.
 
 `include "uvm_macros.svh"
 import uvm_pkg::*;
@@ -14,17 +22,23 @@ virtual class fp_monitor_base #(
 
     T_VIF vif;
     uvm_analysis_port #(T_TRANS) ap;
+    uvm_analysis_port #(trans_batch #(T_TRANS)) batch_ap;
     // Port to get the original transaction from the agent's FIFO
     uvm_get_port #(T_TRANS) get_port;
 
     T_TRANS input_queue[$];
     int pipeline_latency = -1; // Default to invalid
     int unsigned epsilon_delay = 1; // Default to a 1-timeunit delay
+    int unsigned batch_size = 64;   // Burst mode results per batch_ap.write()
+
+    protected trans_batch #(T_TRANS) batch;
 
     function new(string name, uvm_component parent);
         super.new(name, parent);
         ap = new("ap", this);
+        batch_ap = new("batch_ap", this);
         get_port = new("get_port", this);
+        batch = trans_batch #(T_TRANS)::type_id::create("batch");
     endfunction
 
     virtual function void build_phase(uvm_phase phase);
@@ -64,6 +78,7 @@ virtual class fp_monitor_base #(
         bit driver_is_active;
         bit local_q_has_items;
         bit started_flag = 0;
+        int burst_remaining = 0;
 
         @(posedge vif.rst_n);
 
@@ -75,14 +90,34 @@ virtual class fp_monitor_base #(
             pre_sample(1);
             driver_is_active = get_port.can_get();
             local_q_has_items = (input_queue.size() > 0);
-            if (driver_is_active && local_q_has_items) begin
+            if (burst_remaining == 0 && driver_is_active && local_q_has_items) begin
+                void'(get_port.try_peek(named_trans));
+                if (named_trans.burst_size() > 0) begin
+                    // The burst item stays with its sequence, it is not released to the pool
+                    started_flag = 1;
+                    get_port.get(named_trans);
+                    burst_remaining = named_trans.burst_size();
+                end
+            end
+            if (burst_remaining > 0 && local_q_has_items) begin
+                trans_out = input_queue.pop_front();
+                trans_out.set_name("burst");
+                sample_output(trans_out); // DUT-specific
+                batch.items.push_back(trans_out);
+                burst_remaining--;
+                if (batch.items.size() >= batch_size || burst_remaining == 0) begin
+                    publish_batch();
+                end
+            end else if (burst_remaining == 0 && driver_is_active && local_q_has_items) begin
                 started_flag = 1;
                 get_port.get(named_trans);
                 trans_out = input_queue.pop_front();
                 named_trans.inputs = trans_out.inputs;
+                obj_pool #(T_TRANS)::put(trans_out);
                 sample_output(named_trans); // DUT-specific
                 `uvm_info(get_type_name(), $sformatf("Collected transaction"), UVM_HIGH)
                 ap.write(named_trans);
+                obj_pool #(T_TRANS)::put(named_trans);
             end else if (driver_is_active != local_q_has_items && !started_flag) begin
                 // This else block helps debug synchronization problems.
                 `uvm_warning("MON_SYNC_WARN", $sformatf("Queue mismatch! Driver FIFO has item: %b, Local input queue has item: %b",
@@ -91,6 +126,16 @@ virtual class fp_monitor_base #(
         end
     endtask
 
+    // Writes the collected burst results and releases them to the pool
+    virtual function void publish_batch();
+        `uvm_info(get_type_name(), $sformatf("Collected batch of %0d transactions", batch.items.size()), UVM_HIGH)
+        batch_ap.write(batch);
+        foreach (batch.items[i]) begin
+            obj_pool #(T_TRANS)::put(batch.items[i]);
+        end
+        batch.items.delete();
+    endfunction
+
     // This task provides the #epsilon delay. It can be overridden in child
     // classes if a different delay is needed.
     virtual task pre_sample(int is_output);
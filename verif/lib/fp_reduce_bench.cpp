@@ -0,0 +1,281 @@
+// verif/lib/fp_reduce_bench.cpp
+//
+// Native benchmark of the floating-point reduction tree (fp_reduce.v,
+// reference model in fp_reduce_model.cpp).
+//
+// Self-check first: a WIDE node pair (n = 2) must give the correctly rounded
+// sum in every rounding mode (random operand pairs, exact sum in long double;
+// sums below twice the smallest normal are skipped, as the RTL flushes them).
+// Then, for vector lengths 8 .. 1024 and two input distributions
+//   uniform - uniform in [-1, 1],
+//   spread  - random sign, magnitude 2^[-12, 12] (fp16: 2^[-4, 4], so that
+//             no sum overflows), for cancellation and alignment,
+// it compares a sequential fp_add chain, the fp_add tree (WIDE = 0) and the
+// wide tree (WIDE = 1) against the exact sum: latency, mean and max error in
+// ulps, and the percentage of vectors whose result changes when the elements
+// are shuffled (order sensitivity).
+//
+// Build and run (see native.mk):
+//   make -f native.mk reduce
+//   build/native/fp_reduce_bench [--width 16|32] [--n N] [--vectors N] [--guard N] [--seed N]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "fp_model.h"
+}
+
+#include "fp_reduce_model.h"
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static const int n_list[] = {8, 64, 256, 1024};
+
+struct fp_fmt_s {
+    int exp_w;
+    int bias;
+    int mant_w;
+};
+
+static fp_fmt_s fp_fmt(int width) {
+    if (width == 64) return {11, 1023, 52};
+    if (width == 32) return {8, 127, 23};
+    return {5, 15, 10};
+}
+
+static long double fp_to_ld(uint64_t v, int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    const int sign = (v >> (width - 1)) & 1;
+    const int exp = (int)((v >> f.mant_w) & ((1ULL << f.exp_w) - 1));
+    const uint64_t mant = v & ((1ULL << f.mant_w) - 1);
+    long double m;
+    if (exp == (1 << f.exp_w) - 1) {
+        m = mant ? NAN : INFINITY;
+    } else if (exp == 0) {
+        m = ldexpl((long double)mant, 1 - f.bias - f.mant_w);
+    } else {
+        m = ldexpl((long double)((1ULL << f.mant_w) | mant), exp - f.bias - f.mant_w);
+    }
+    return sign ? -m : m;
+}
+
+// v rounded to the format (rm), results below the smallest normal flushed to zero
+static uint64_t fp_round_ld(long double v, int width, int rm) {
+    const fp_fmt_s f = fp_fmt(width);
+    const uint64_t sign = (v < 0) ? 1ULL << (width - 1) : 0;
+    const uint64_t exp_all_ones = (1ULL << f.exp_w) - 1;
+    if (v == 0) return 0;
+    int e;
+    frexpl(fabsl(v), &e);  // |v| in [2^(e-1), 2^e)
+    const long double s = ldexpl(fabsl(v), f.mant_w - (e - 1));
+    long double r;
+    if (rm == RNE) {
+        r = nearbyintl(s);
+    } else if (rm == RTZ) {
+        r = truncl(s);
+    } else if (rm == RPI) {
+        r = sign ? truncl(s) : ceill(s);
+    } else if (rm == RNI) {
+        r = sign ? ceill(s) : truncl(s);
+    } else {
+        r = roundl(s);
+    }
+    uint64_t sig = (uint64_t)r;
+    int exp = e - 1 + f.bias;
+    if (sig >> (f.mant_w + 1)) {
+        sig >>= 1;
+        exp++;
+    }
+    if (exp >= (int)exp_all_ones) return sign | (exp_all_ones << f.mant_w);
+    if (exp <= 0) return sign;
+    return sign | ((uint64_t)exp << f.mant_w) | (sig & ((1ULL << f.mant_w) - 1));
+}
+
+// Error of y in ulps of the exact value ref (normal ref only)
+static double ulp_err(uint64_t y, long double ref, int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    int e;
+    frexpl(ref, &e);
+    return (double)(fabsl(fp_to_ld(y, width) - ref) / ldexpl(1.0L, e - 1 - f.mant_w));
+}
+
+//----------------------------------------------------------------------------
+// Self-check
+//----------------------------------------------------------------------------
+
+// Random encoding, exponents within 'spread' of the middle of the range
+static uint64_t rand_fp(uint64_t* state, int width, int spread) {
+    const fp_fmt_s f = fp_fmt(width);
+    const uint64_t r = rand_u64(state);
+    const int exp = (int)(rand_u64(state) % (2 * spread + 1)) - spread + f.bias;
+    const uint64_t sign = (r >> 63) << (width - 1);
+    return sign | ((uint64_t)std::max(exp, 0) << f.mant_w) | (r & ((1ULL << f.mant_w) - 1));
+}
+
+static int self_check(int width, int guard_bits, int count, uint64_t seed) {
+    const fp_fmt_s f = fp_fmt(width);
+    const long double min_normal = ldexpl(1.0L, 1 - f.bias);
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + width;
+    int mismatches = 0;
+    for (int i = 0; i < count; i++) {
+        // fp16 over the whole range (denormals included), fp32 within 2^30
+        uint64_t x[2];
+        x[0] = rand_fp(&state, width, (width == 16) ? f.bias : 30);
+        x[1] = rand_fp(&state, width, (width == 16) ? f.bias : 30);
+        const long double sum = fp_to_ld(x[0], width) + fp_to_ld(x[1], width);
+        if (fabsl(sum) < 2 * min_normal) continue;
+        for (int rm = RNE; rm <= RNA; rm++) {
+            const uint64_t expected = fp_round_ld(sum, width, rm);
+            const uint64_t got = fp_reduce(x, 2, width, rm, 1, guard_bits);
+            if (got != expected) {
+                if (mismatches < 5)
+                    printf("  fp%d rm %d: %llx + %llx = %llx, expected %llx\n", width, rm, (unsigned long long)x[0],
+                           (unsigned long long)x[1], (unsigned long long)got, (unsigned long long)expected);
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+//----------------------------------------------------------------------------
+// Benchmark
+//----------------------------------------------------------------------------
+
+static uint64_t chain_sum(const uint64_t* x, int n, int width, int rm) {
+    uint64_t acc = x[0];
+    for (int i = 1; i < n; i++) acc = c_fp_add(acc, x[i], width, rm);
+    return acc;
+}
+
+struct method_stats_s {
+    double sum_ulp;
+    double max_ulp;
+    int order_changed;
+    int vectors;
+};
+
+static void record(method_stats_s& s, uint64_t y, long double exact, int width, bool changed) {
+    const double err = ulp_err(y, exact, width);
+    s.sum_ulp += err;
+    s.max_ulp = std::max(s.max_ulp, err);
+    s.order_changed += changed;
+    s.vectors++;
+}
+
+int main(int argc, char** argv) {
+    int width = 0;
+    int n_one = 0;
+    int vectors = 200;
+    int guard_bits = 8;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--width") && i + 1 < argc) {
+            width = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--n") && i + 1 < argc) {
+            n_one = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--vectors") && i + 1 < argc) {
+            vectors = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--guard") && i + 1 < argc) {
+            guard_bits = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [--width 16|32] [--n N] [--vectors N] [--guard N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if ((width && width != 16 && width != 32) || n_one < 0 || vectors < 1 || guard_bits < 2 ||
+        guard_bits > fp_reduce_max_guard(32)) {
+        fprintf(stderr, "--width must be 16 or 32, --vectors at least 1, --guard 2 .. %d\n",
+                fp_reduce_max_guard(32));
+        return 2;
+    }
+
+    std::vector<int> widths;
+    if (width) {
+        widths.push_back(width);
+    } else {
+        widths = {16, 32};
+    }
+    std::vector<int> ns;
+    if (n_one) {
+        ns.push_back(n_one);
+    } else {
+        ns.assign(n_list, n_list + sizeof(n_list) / sizeof(n_list[0]));
+    }
+
+    bool pass = true;
+    for (int w : widths) {
+        const int mismatches = self_check(w, guard_bits, 100000, seed);
+        printf("Self-check fp%d: WIDE node pair vs correctly rounded sum, 5 rounding modes: %d mismatches\n", w,
+               mismatches);
+        if (mismatches) pass = false;
+    }
+
+    printf("\nErrors vs the exact sum in ulps (RNE), %d vectors, guard bits %d, ORDER%% = results changed by a shuffle\n\n",
+           vectors, guard_bits);
+    printf("%-5s | %-7s | %-5s | %-16s | %-26s | %-26s | %-26s\n", "WIDTH", "DIST", "N", "LATENCY CH/TR/WD",
+           "CHAIN MEAN/MAX/ORDER%", "TREE MEAN/MAX/ORDER%", "WIDE MEAN/MAX/ORDER%");
+    for (int w : widths) {
+        const fp_fmt_s f = fp_fmt(w);
+        for (int dist = 0; dist < 2; dist++) {
+            for (int n : ns) {
+                uint64_t state = seed * 0x9E3779B97F4A7C15ULL + n * 2 + dist;
+                method_stats_s chain = {}, tree = {}, wide = {};
+                std::vector<uint64_t> x(n), xs(n);
+                for (int v = 0; v < vectors; v++) {
+                    for (int i = 0; i < n; i++) {
+                        if (dist == 0) {
+                            const long double u = (long double)(rand_u64(&state) >> 11) / (long double)(1ULL << 53);
+                            x[i] = fp_round_ld(2 * u - 1, w, RNE);
+                        } else {
+                            x[i] = rand_fp(&state, w, (w == 16) ? 4 : 12);
+                        }
+                    }
+                    long double exact = 0;
+                    for (int i = 0; i < n; i++) exact += fp_to_ld(x[i], w);
+                    if (fabsl(exact) < ldexpl(2.0L, 1 - f.bias)) continue;
+
+                    xs = x;
+                    for (int i = n - 1; i > 0; i--) std::swap(xs[i], xs[rand_u64(&state) % (i + 1)]);
+
+                    const uint64_t c = chain_sum(x.data(), n, w, RNE);
+                    const uint64_t t = fp_reduce(x.data(), n, w, RNE, 0, guard_bits);
+                    const uint64_t d = fp_reduce(x.data(), n, w, RNE, 1, guard_bits);
+                    record(chain, c, exact, w, c != chain_sum(xs.data(), n, w, RNE));
+                    record(tree, t, exact, w, t != fp_reduce(xs.data(), n, w, RNE, 0, guard_bits));
+                    record(wide, d, exact, w, d != fp_reduce(xs.data(), n, w, RNE, 1, guard_bits));
+                }
+
+                char lat[32], cs[32], ts[32], ds[32];
+                snprintf(lat, sizeof(lat), "%d/%d/%d", 4 * (n - 1), fp_reduce_latency(n, 0), fp_reduce_latency(n, 1));
+                const method_stats_s* stats[3] = {&chain, &tree, &wide};
+                char* out[3] = {cs, ts, ds};
+                for (int m = 0; m < 3; m++) {
+                    const method_stats_s& s = *stats[m];
+                    snprintf(out[m], 32, "%.2f/%.1f/%.0f", s.vectors ? s.sum_ulp / s.vectors : 0.0, s.max_ulp,
+                             s.vectors ? 100.0 * s.order_changed / s.vectors : 0.0);
+                }
+                printf("%-5d | %-7s | %-5d | %-16s | %-26s | %-26s | %-26s\n", w, dist ? "spread" : "uniform", n, lat,
+                       cs, ts, ds);
+            }
+        }
+    }
+
+    printf("\n%s : WIDE node pair correctly rounded\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
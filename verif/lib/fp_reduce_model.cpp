@@ -0,0 +1,188 @@
+// verif/lib/fp_reduce_model.cpp
+//
+// Bit-accurate reference of fp_reduce.v and fp_reduce_add.v
+// (see fp_reduce_model.h).
+//
+
+#include <vector>
+
+extern "C" {
+#include "fp_model.h"
+}
+
+#include "fp_reduce_model.h"
+
+typedef unsigned __int128 u128;
+
+struct fp_fmt_s {
+    int exp_w;
+    int bias;
+    int mant_w;
+};
+
+static fp_fmt_s fp_fmt(int width) {
+    if (width == 64) return {11, 1023, 52};
+    if (width == 32) return {8, 127, 23};
+    return {5, 15, 10};
+}
+
+// Value of the internal format of fp_reduce_add.v
+struct fp_wide_s {
+    bool nan;
+    bool inf;
+    int sign;
+    int exp;    // Signed, biased as the IEEE format
+    u128 mant;  // Leading one at mant_w - 1, or zero
+    int sticky;
+};
+
+int fp_reduce_max_guard(int width) { return 63 - (fp_fmt(width).mant_w + 1); }
+
+int fp_reduce_latency(int n, int wide) {
+    int levels = 0;
+    while ((1 << levels) < n) levels++;
+    return wide ? 2 + 3 * levels : 4 * levels;
+}
+
+static int msb_pos(u128 v) {
+    int pos = 0;
+    for (int i = 127; i >= 0; i--) {
+        if ((v >> i) & 1) {
+            pos = i;
+            break;
+        }
+    }
+    return pos;
+}
+
+// Leaf: unpack, denormals normalized from exponent 1
+static fp_wide_s wide_unpack(uint64_t x, const fp_fmt_s& f, int mant_w, int guard_bits) {
+    const uint64_t exp_all_ones = (1ULL << f.exp_w) - 1;
+    const uint64_t exp = (x >> f.mant_w) & exp_all_ones;
+    const uint64_t frac = x & ((1ULL << f.mant_w) - 1);
+    fp_wide_s w = {};
+    w.sign = (x >> (f.exp_w + f.mant_w)) & 1;
+    w.nan = (exp == exp_all_ones) && frac;
+    w.inf = (exp == exp_all_ones) && !frac;
+    const u128 full = ((u128)((exp != 0) ? (1ULL << f.mant_w) | frac : frac)) << guard_bits;
+    if (full == 0 || exp == exp_all_ones) return w;
+    const int shift = (mant_w - 1) - msb_pos(full);
+    w.mant = full << shift;
+    w.exp = ((exp == 0) ? 1 : (int)exp) - shift;
+    return w;
+}
+
+// fp_reduce_add.v
+static fp_wide_s wide_add(const fp_wide_s& a, const fp_wide_s& b, int mant_w) {
+    const int align_w = mant_w + 3;
+    const bool zero_a = (a.mant == 0);
+    const bool zero_b = (b.mant == 0);
+    const u128 ext_a = (a.mant << 3) | (u128)a.sticky;
+    const u128 ext_b = (b.mant << 3) | (u128)b.sticky;
+
+    // Stage 1: compare (sticky included) and align with jamming
+    const bool a_larger = zero_b || (!zero_a && (a.exp > b.exp || (a.exp == b.exp && ext_a >= ext_b)));
+    const fp_wide_s& l = a_larger ? a : b;
+    const u128 larger = a_larger ? ext_a : ext_b;
+    const u128 smaller = a_larger ? ext_b : ext_a;
+    const int diff = a_larger ? a.exp - b.exp : b.exp - a.exp;
+    u128 aligned = smaller;
+    if (diff != 0) {
+        const u128 shifted = (diff < 0 || diff >= align_w) ? 0 : smaller >> diff;
+        const bool lost = (diff < 0 || diff >= align_w) ? smaller != 0 : (shifted << diff) != smaller;
+        aligned = shifted | (u128)lost;
+    }
+
+    fp_wide_s r = {};
+    r.nan = a.nan || b.nan || (a.inf && b.inf && a.sign != b.sign);
+    r.inf = !r.nan && (a.inf || b.inf);
+    const int sign = r.inf ? (a.inf ? a.sign : b.sign) : l.sign;
+
+    // Stage 2: add or subtract, the larger never borrows
+    const u128 sum = (a.sign != b.sign) ? larger - aligned : larger + aligned;
+
+    // Stage 3: normalize, the 3 extra bits fold into the sticky bit
+    if (sum == 0) {
+        r.sign = r.inf ? sign : (a.sign && b.sign);
+        return r;
+    }
+    u128 norm;
+    int exp;
+    if ((sum >> align_w) & 1) {
+        norm = (sum >> 1) | (sum & 1);
+        exp = l.exp + 1;
+    } else {
+        const int shift = (align_w - 1) - msb_pos(sum);
+        norm = sum << shift;
+        exp = l.exp - shift;
+    }
+    r.sign = sign;
+    r.exp = exp;
+    r.mant = norm >> 3;
+    r.sticky = (norm & 7) != 0;
+    return r;
+}
+
+// Root: round and pack
+static uint64_t wide_round(const fp_wide_s& w, const fp_fmt_s& f, int mant_w, int rm) {
+    const uint64_t exp_all_ones = (1ULL << f.exp_w) - 1;
+    const uint64_t sign = (uint64_t)w.sign << (f.exp_w + f.mant_w);
+    if (w.nan) return (exp_all_ones << f.mant_w) | (1ULL << (f.mant_w - 1));
+    if (w.inf) return sign | (exp_all_ones << f.mant_w);
+    if (w.mant == 0) return sign;
+
+    const uint64_t value = (uint64_t)((w.mant << 1) | (u128)w.sticky);
+    const uint64_t rounded = c_grs_rounder(value, w.sign, rm, mant_w + 1, f.mant_w + 1, 1);
+    const int overflow = (rounded >> (f.mant_w + 1)) & 1;
+    const int exp = w.exp + overflow;
+    if (exp >= (int)exp_all_ones) return sign | (exp_all_ones << f.mant_w);
+    if (exp <= 0) return sign;
+    return sign | ((uint64_t)exp << f.mant_w) | (rounded & ((1ULL << f.mant_w) - 1));
+}
+
+uint64_t fp_reduce(const uint64_t* x, int n, int width, int rm, int wide, int guard_bits) {
+    const fp_fmt_s f = fp_fmt(width);
+    const uint64_t n_zero = 1ULL << (width - 1);
+    int n_p2 = 1;
+    while (n_p2 < n) n_p2 <<= 1;
+
+    if (!wide) {
+        std::vector<uint64_t> node(2 * n_p2 - 1);
+        for (int i = 0; i < n_p2; i++) node[n_p2 - 1 + i] = (i < n) ? x[i] : n_zero;
+        for (int i = n_p2 - 2; i >= 0; i--) node[i] = c_fp_add(node[2 * i + 1], node[2 * i + 2], width, rm);
+        return node[0];
+    }
+
+    const int mant_w = f.mant_w + 1 + guard_bits;
+    std::vector<fp_wide_s> node(2 * n_p2 - 1);
+    for (int i = 0; i < n_p2; i++) node[n_p2 - 1 + i] = wide_unpack((i < n) ? x[i] : n_zero, f, mant_w, guard_bits);
+    for (int i = n_p2 - 2; i >= 0; i--) node[i] = wide_add(node[2 * i + 1], node[2 * i + 2], mant_w);
+    return wide_round(node[0], f, mant_w, rm);
+}
+
+//----------------------------------------------------------------------------
+// DPI-C API
+//----------------------------------------------------------------------------
+
+static int dpi_width = 16;
+static int dpi_rm = RNE;
+static int dpi_wide = 0;
+static int dpi_guard_bits = 8;
+static std::vector<uint64_t> dpi_x;
+
+extern "C" void c_fp_reduce_reset(const int width, const int rm, const int wide, const int guard_bits) {
+    dpi_width = width;
+    dpi_rm = rm;
+    dpi_wide = wide;
+    dpi_guard_bits = guard_bits;
+    dpi_x.clear();
+}
+
+extern "C" void c_fp_reduce_push(uint64_t x) { dpi_x.push_back(x); }
+
+extern "C" uint64_t c_fp_reduce_finish() {
+    const uint64_t sum = dpi_x.empty() ? 0 : fp_reduce(dpi_x.data(), (int)dpi_x.size(), dpi_width, dpi_rm, dpi_wide,
+                                                       dpi_guard_bits);
+    dpi_x.clear();
+    return sum;
+}
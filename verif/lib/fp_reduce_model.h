@@ -0,0 +1,38 @@
+// verif/lib/fp_reduce_model.h
+//
+// Bit-accurate reference of the floating-point reduction tree
+// (rtl/verilog/fp/fp_reduce.v and its WIDE node fp_reduce_add.v).
+//
+// Tree order (the RTL order): the n elements are padded with -0 to the next
+// power of two; node i of the heap adds node 2i+1 (left) and node 2i+2
+// (right), the leaves are the elements in order and node 0 is the result.
+// - wide = 0: every node is c_fp_add (fp_model.c).
+// - wide = 1: the nodes add in the unrounded internal format of
+//   fp_reduce_add.v (exponent 2 bits wider, mantissa guard_bits wider, one
+//   sticky bit) and only the root rounds with c_grs_rounder.
+//
+// Used natively by fp_reduce_bench.cpp and from the fp_reduce testbench
+// through DPI-C (c_fp_reduce_*).
+//
+
+#ifndef FP_REDUCE_MODEL_H
+#define FP_REDUCE_MODEL_H
+
+#include <cstdint>
+
+// Largest guard_bits of the model: the root rounder input (mantissa, guard
+// bits and sticky) must fit in 64 bits
+int fp_reduce_max_guard(int width);
+
+// Pipeline latency of fp_reduce for n elements
+int fp_reduce_latency(int n, int wide);
+
+// Sum of the n >= 1 elements of x in the tree order above
+uint64_t fp_reduce(const uint64_t* x, int n, int width, int rm, int wide, int guard_bits);
+
+// DPI-C API: push the elements of one vector, then read the sum
+extern "C" void     c_fp_reduce_reset(const int width, const int rm, const int wide, const int guard_bits);
+extern "C" void     c_fp_reduce_push(uint64_t x);
+extern "C" uint64_t c_fp_reduce_finish();
+
+#endif // FP_REDUCE_MODEL_H
@@ -0,0 +1,328 @@
+// verif/lib/fp_replay.c
+//
+// Single-vector replay and failure minimization for fp_add / fp_mul.
+// See fp_replay.h for the overview.
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fp_model.h"
+#include "fp_replay.h"
+
+static const char* const replay_rm_names[5] = {"RNE", "RTZ", "RPI", "RNI", "RNA"};
+
+//------------------------------------------------------------------------------
+// Format helpers
+//------------------------------------------------------------------------------
+
+static int replay_exp_w(int width) {
+    return (width == 64) ? 11 : (width == 32) ? 8 : 5;
+}
+
+static int replay_mant_w(int width) {
+    return width - 1 - replay_exp_w(width);
+}
+
+static uint64_t replay_mask(int bits) {
+    return (bits >= 64) ? ~0ULL : ((1ULL << bits) - 1);
+}
+
+// Mirrors fp_utils_t::canonicalize(): one quiet NaN, -0 folded into +0
+static uint64_t replay_canonical(int width, uint64_t x) {
+    const int mant_w = replay_mant_w(width);
+    const uint64_t exp_max = replay_mask(replay_exp_w(width));
+    x &= replay_mask(width);
+    if (((x >> mant_w) & exp_max) == exp_max && (x & replay_mask(mant_w))) {
+        return (exp_max << mant_w) | (1ULL << (mant_w - 1));
+    }
+    if (x == (1ULL << (width - 1))) {
+        return 0;
+    }
+    return x;
+}
+
+int fp_replay_match(int width, uint64_t x, uint64_t y) {
+    return replay_canonical(width, x) == replay_canonical(width, y);
+}
+
+//------------------------------------------------------------------------------
+// Parsing
+//------------------------------------------------------------------------------
+
+static int replay_parse_rm(const char* s) {
+    for (int i = 0; i < 5; i++) {
+        if (!strncmp(s, replay_rm_names[i], 3)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Parses "0x<hex>" at s, returns 0 on success
+static int replay_parse_hex(const char* s, uint64_t* value) {
+    char* end;
+    if (strncmp(s, "0x", 2)) {
+        return -1;
+    }
+    *value = strtoull(s + 2, &end, 16);
+    return (end == s + 2) ? -1 : 0;
+}
+
+// Scoreboard line:
+//   ... [SCOREBOARD] PASS [name]: RM=RNE, inputs[0x3c00, 0x4000] -> result=0x4200 | Canonical: ...
+//   ... [SCOREBOARD] FAIL [name]: RM=RNE, inputs[0x3c00, 0x4000] -> DUT=0x4201, MODEL=0x4200 | ...
+static int replay_parse_log_line(const char* line, fp_replay_vec_s* v) {
+    const char* rm = strstr(line, "RM=");
+    const char* in = strstr(line, "inputs[");
+    if (!rm || !in || (v->rm = replay_parse_rm(rm + 3)) < 0) {
+        return 0;
+    }
+    const char* comma = strchr(in, ',');
+    if (!comma || replay_parse_hex(in + 7, &v->a) || replay_parse_hex(comma + 2, &v->b)) {
+        return 0;
+    }
+    const char* dut = strstr(in, "DUT=");
+    const char* result = strstr(in, "result=");
+    v->failing = dut != NULL;
+    v->has_dut = (dut && !replay_parse_hex(dut + 4, &v->dut)) || (!dut && result && !replay_parse_hex(result + 7, &v->dut));
+    return 1;
+}
+
+// fp_inverse_gen line: a b c rm expected (hex, rm decimal)
+static int replay_parse_vec_line(const char* line, fp_replay_vec_s* v) {
+    unsigned long long a, b, c, expected;
+    int rm;
+    if (line[0] == '#' || sscanf(line, "%llx %llx %llx %d %llx", &a, &b, &c, &rm, &expected) != 5 || rm < 0 || rm > 4) {
+        return 0;
+    }
+    v->a = a;
+    v->b = b;
+    v->rm = rm;
+    v->failing = 0;
+    v->has_dut = 0;
+    return 1;
+}
+
+// Returns 1 if the line holds a transaction
+int fp_replay_parse_line(const char* line, fp_replay_vec_s* v) {
+    memset(v, 0, sizeof(*v));
+    return replay_parse_log_line(line, v) || replay_parse_vec_line(line, v);
+}
+
+// Loads all transactions of a log or vector file, in issue order. Returns
+// their number (*vecs is malloc'ed) or -1 if the file cannot be read.
+int fp_replay_load(const char* path, fp_replay_vec_s** vecs) {
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        return -1;
+    }
+    char line[4096];
+    int n = 0, cap = 0, line_no = 0;
+    *vecs = NULL;
+    while (fgets(line, sizeof(line), fp)) {
+        fp_replay_vec_s v;
+        line_no++;
+        if (!fp_replay_parse_line(line, &v)) {
+            continue;
+        }
+        if (n == cap) {
+            cap = cap ? 2 * cap : 256;
+            *vecs = (fp_replay_vec_s*)realloc(*vecs, cap * sizeof(**vecs));
+        }
+        v.line = line_no;
+        (*vecs)[n++] = v;
+    }
+    fclose(fp);
+    return n;
+}
+
+int fp_replay_find_failing(const fp_replay_vec_s* vecs, int n) {
+    for (int i = 0; i < n; i++) {
+        if (vecs[i].failing) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//------------------------------------------------------------------------------
+// C model
+//------------------------------------------------------------------------------
+
+uint64_t fp_replay_model(const fp_replay_s* r, const fp_replay_vec_s* v, fp_trace_s* trace) {
+    fp_trace_s local;
+    if (!trace) {
+        trace = &local;
+    }
+    if (r->op == FP_REPLAY_OP_MUL) {
+        return c_fp_mul_trace(v->a, v->b, r->width, v->rm, trace);
+    }
+    return c_fp_add_trace(v->a, v->b, r->width, v->rm, trace);
+}
+
+void fp_replay_print_vec(const fp_replay_s* r, FILE* out, const char* label, const fp_replay_vec_s* v) {
+    const int digits = r->width / 4;
+    fprintf(out, "%s: a=0x%0*llx b=0x%0*llx rm=%s model=0x%0*llx", label, digits, (unsigned long long)v->a, digits, (unsigned long long)v->b,
+            replay_rm_names[v->rm], digits, (unsigned long long)fp_replay_model(r, v, NULL));
+    if (v->has_dut) {
+        fprintf(out, " logged_dut=0x%0*llx", digits, (unsigned long long)v->dut);
+    }
+    if (v->line) {
+        fprintf(out, " (line %d)", v->line);
+    }
+    fprintf(out, "\n");
+}
+
+static void replay_print_wide(FILE* out, const char* name, const uint64_t* x) {
+    if (x[1]) {
+        fprintf(out, "  %-12s 0x%llx%016llx\n", name, (unsigned long long)x[1], (unsigned long long)x[0]);
+    } else {
+        fprintf(out, "  %-12s 0x%llx\n", name, (unsigned long long)x[0]);
+    }
+}
+
+// C model intermediates of one transaction, in datapath order
+void fp_replay_print_model(const fp_replay_s* r, FILE* out, const fp_replay_vec_s* v) {
+    static const char* const class_names[FP_NUM_CLASSES] = {"zero", "denormal", "normal", "inf", "nan"};
+    fp_trace_s t;
+    const uint64_t result = fp_replay_model(r, v, &t);
+
+    fprintf(out, "C model (fp_%s, WIDTH=%d):\n", (r->op == FP_REPLAY_OP_MUL) ? "mul" : "add", r->width);
+    fprintf(out, "  %-12s %s / %s\n", "class", class_names[t.class_a], class_names[t.class_b]);
+    if (t.special) {
+        fprintf(out, "  %-12s 1\n", "special");
+    } else {
+        if (r->op == FP_REPLAY_OP_ADD) {
+            fprintf(out, "  %-12s %d\n", "exp_diff", t.exp_diff);
+            fprintf(out, "  %-12s 0x%llx\n", "mant_a", (unsigned long long)t.mant_a);
+            fprintf(out, "  %-12s 0x%llx\n", "mant_b", (unsigned long long)t.mant_b);
+            fprintf(out, "  %-12s %d\n", "op_is_sub", t.op_is_sub);
+            replay_print_wide(out, "mant_res", t.mant_res);
+            fprintf(out, "  %-12s %d\n", "exact_zero", t.exact_zero);
+        } else {
+            fprintf(out, "  %-12s 0x%llx\n", "mant_a", (unsigned long long)t.mant_a);
+            fprintf(out, "  %-12s 0x%llx\n", "mant_b", (unsigned long long)t.mant_b);
+            replay_print_wide(out, "mant_res", t.mant_res);
+        }
+        fprintf(out, "  %-12s %d\n", "exp_res", t.exp_res);
+        fprintf(out, "  %-12s %d\n", "norm_shift", t.norm_shift);
+        replay_print_wide(out, "round_in", t.round_in);
+        fprintf(out, "  %-12s %d%d%d\n", "grs", (t.grs >> 2) & 1, (t.grs >> 1) & 1, t.grs & 1);
+        fprintf(out, "  %-12s %d\n", "round_inc", t.round_inc);
+        fprintf(out, "  %-12s %d\n", "round_ovf", t.round_ovf);
+        fprintf(out, "  %-12s %d\n", "exp_ovf", t.exp_ovf);
+        fprintf(out, "  %-12s %d\n", "exp_unf", t.exp_unf);
+        fprintf(out, "  %-12s %d\n", "sign", t.sign);
+    }
+    fprintf(out, "  %-12s 0x%0*llx\n", "result", r->width / 4, (unsigned long long)result);
+}
+
+//------------------------------------------------------------------------------
+// DUT replay and minimization
+//------------------------------------------------------------------------------
+
+// Runs the window through the DUT. Returns 1 if the last transaction of the
+// window disagrees with the C model, 0 if it agrees and -1 on a DUT error.
+int fp_replay_fails(fp_replay_s* r, const fp_replay_vec_s* window, int n, uint64_t* dut_result) {
+    uint64_t* results = (uint64_t*)malloc(n * sizeof(*results));
+    r->runs++;
+    if (r->run(r->user, window, n, results) != 0) {
+        free(results);
+        return -1;
+    }
+    const uint64_t dut = results[n - 1];
+    free(results);
+    if (dut_result) {
+        *dut_result = dut;
+    }
+    return !fp_replay_match(r->width, dut, fp_replay_model(r, &window[n - 1], NULL));
+}
+
+// Tries one candidate, keeps it in window[0..*n-1] if it still fails
+static int replay_try(fp_replay_s* r, fp_replay_vec_s* window, int* n, const fp_replay_vec_s* cand, int cand_n) {
+    if (fp_replay_fails(r, cand, cand_n, NULL) != 1) {
+        return 0;
+    }
+    memmove(window, cand, cand_n * sizeof(*cand));
+    *n = cand_n;
+    return 1;
+}
+
+// Shrinks a failing window (the failing transaction last) in place:
+//   1. the failing transaction alone, else drop history entries one at a time;
+//   2. clear mantissa bits of a and b, LSB first;
+//   3. move the exponents towards the bias (fp_add: keeping their difference,
+//      fp_mul: keeping their sum) and switch to RNE.
+// Each step is kept only if the DUT still disagrees with the C model.
+// Returns -1 if the window does not fail to begin with.
+int fp_replay_minimize(fp_replay_s* r, fp_replay_vec_s* window, int* n) {
+    const int mant_w = replay_mant_w(r->width);
+    const int exp_max = (int)replay_mask(replay_exp_w(r->width));
+    const int bias = exp_max >> 1;
+    fp_replay_vec_s* cand = (fp_replay_vec_s*)malloc(*n * sizeof(*cand));
+
+    if (fp_replay_fails(r, window, *n, NULL) != 1) {
+        free(cand);
+        return -1;
+    }
+
+    // History
+    if (*n > 1 && !replay_try(r, window, n, &window[*n - 1], 1)) {
+        for (int i = 0; i < *n - 1;) {
+            memcpy(cand, window, i * sizeof(*cand));
+            memcpy(cand + i, window + i + 1, (*n - i - 1) * sizeof(*cand));
+            if (!replay_try(r, window, n, cand, *n - 1)) {
+                i++;
+            }
+        }
+    }
+
+    // Mantissa bits
+    fp_replay_vec_s* last = &window[*n - 1];
+    const fp_replay_vec_s orig = *last;
+    memcpy(cand, window, *n * sizeof(*cand));
+    for (int bit = 0; bit < mant_w; bit++) {
+        for (int k = 0; k < 2; k++) {
+            uint64_t* x = k ? &cand[*n - 1].b : &cand[*n - 1].a;
+            if (!((*x >> bit) & 1)) {
+                continue;
+            }
+            *x &= ~(1ULL << bit);
+            if (!replay_try(r, window, n, cand, *n)) {
+                *x |= 1ULL << bit;
+            }
+        }
+    }
+
+    // Exponents, only for two finite non-zero exponents
+    const int exp_a = (int)((last->a >> mant_w) & exp_max);
+    const int exp_b = (int)((last->b >> mant_w) & exp_max);
+    if (exp_a > 0 && exp_a < exp_max && exp_b > 0 && exp_b < exp_max && exp_a != bias) {
+        const int new_b = (r->op == FP_REPLAY_OP_MUL) ? exp_b + exp_a - bias : exp_b + bias - exp_a;
+        if (new_b > 0 && new_b < exp_max) {
+            const uint64_t exp_mask = (uint64_t)exp_max << mant_w;
+            cand[*n - 1].a = (last->a & ~exp_mask) | ((uint64_t)bias << mant_w);
+            cand[*n - 1].b = (last->b & ~exp_mask) | ((uint64_t)new_b << mant_w);
+            if (!replay_try(r, window, n, cand, *n)) {
+                cand[*n - 1] = *last;
+            }
+        }
+    }
+
+    // Rounding mode
+    if (last->rm != RNE) {
+        cand[*n - 1].rm = RNE;
+        replay_try(r, window, n, cand, *n);
+    }
+
+    // The logged DUT result no longer applies to a shrunk transaction
+    if (last->a != orig.a || last->b != orig.b || last->rm != orig.rm) {
+        last->has_dut = 0;
+        last->line = 0;
+    }
+    free(cand);
+    return 0;
+}
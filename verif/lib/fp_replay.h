@@ -0,0 +1,62 @@
+// verif/lib/fp_replay.h
+//
+// Single-vector replay and failure minimization for fp_add / fp_mul.
+//
+// Transactions are read from a UVM log (the SCOREBOARD PASS/FAIL lines of
+// base_scoreboard / fp_transaction::compare), from a vector file written by
+// fp_inverse_gen, or given directly. The failing transaction is replayed with
+// a window of the transactions issued before it, and the window and operands
+// are then shrunk while the DUT still disagrees with the C model.
+//
+// The DUT is reached through a callback, so the same code drives the
+// Verilator harness (fp_replay_vl.cpp) and native tests.
+//
+
+#ifndef FP_REPLAY_H
+#define FP_REPLAY_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "fp_model.h"
+
+#define FP_REPLAY_OP_ADD 0
+#define FP_REPLAY_OP_MUL 1
+
+// One transaction
+typedef struct {
+    uint64_t a, b;
+    int rm;
+    int failing;   // Logged as a mismatch
+    int has_dut;   // dut is the logged DUT result
+    uint64_t dut;
+    int line;      // Source line (0 if not from a file)
+} fp_replay_vec_s;
+
+// Runs window[0..n-1] back to back through the DUT and returns the results
+typedef int (*fp_replay_run_fn)(void* user, const fp_replay_vec_s* window, int n, uint64_t* results);
+
+typedef struct {
+    int op;
+    int width;
+    fp_replay_run_fn run;
+    void* user;
+    int runs;  // DUT runs so far
+} fp_replay_s;
+
+// Parsing
+int  fp_replay_parse_line(const char* line, fp_replay_vec_s* v);
+int  fp_replay_load(const char* path, fp_replay_vec_s** vecs);
+int  fp_replay_find_failing(const fp_replay_vec_s* vecs, int n);
+
+// C model
+uint64_t fp_replay_model(const fp_replay_s* r, const fp_replay_vec_s* v, fp_trace_s* trace);
+int      fp_replay_match(int width, uint64_t x, uint64_t y);
+void     fp_replay_print_vec(const fp_replay_s* r, FILE* out, const char* label, const fp_replay_vec_s* v);
+void     fp_replay_print_model(const fp_replay_s* r, FILE* out, const fp_replay_vec_s* v);
+
+// DUT replay
+int fp_replay_fails(fp_replay_s* r, const fp_replay_vec_s* window, int n, uint64_t* dut_result);
+int fp_replay_minimize(fp_replay_s* r, fp_replay_vec_s* window, int* n);
+
+#endif // FP_REPLAY_H
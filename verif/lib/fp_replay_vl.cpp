@@ -0,0 +1,313 @@
+// verif/lib/fp_replay_vl.cpp
+//
+// Verilator harness for single-vector replay of fp_add / fp_mul failures.
+//
+// Reads the failing transaction from a UVM log or a vector file (or takes it
+// from the command line), replays it with up to --history preceding
+// transactions through a Verilated instance of the unit, shrinks the window
+// and operands while the DUT still disagrees with the C model (fp_replay.c),
+// and dumps the RTL signals of every pipeline stage next to the C model's
+// intermediate values for the (minimized) failing transaction.
+//
+// The unit is Verilated with --prefix Vreplay and selected at build time
+// (see verilator.mk):
+//   REPLAY_DUT     - Unit name (top module), e.g. fp_add
+//   REPLAY_OP      - FP_REPLAY_OP_ADD or FP_REPLAY_OP_MUL
+//   REPLAY_WIDTH   - WIDTH the model was Verilated with
+//   REPLAY_LATENCY - Pipeline depth (VERIF_DECLARE_PIPELINE of the unit)
+//
+// Build and run:
+//   make -f verilator.mk replay DUT=fp_add WIDTH=16 REPLAY_ARGS="--log dsim.log"
+//   build/verilator/fp_add_16/fp_replay --log FILE | --vec FILE | --a HEX --b HEX [--rm N]
+//                                       [--index N] [--history N] [--no-minimize]
+//
+// Returns 1 if the failure reproduces, 0 if the DUT agrees with the C model.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "verilated.h"
+#include "verilated_vpi.h"
+#include "Vreplay.h"
+
+extern "C" {
+#include "fp_model.h"
+#include "fp_replay.h"
+}
+
+#define REPLAY_STR2(x) #x
+#define REPLAY_STR(x) REPLAY_STR2(x)
+#define REPLAY_DUT_NAME REPLAY_STR(REPLAY_DUT)
+
+// Internal signal of the unit, read through VPI
+struct replay_signal_s {
+    std::string name;  // Relative to the unit, submodule signals as <inst>.<name>
+    vpiHandle handle;
+    int stage;         // 0..REPLAY_LATENCY, -1: combinational, sampled every cycle
+};
+
+struct replay_dut_s {
+    VerilatedContext* ctx;
+    Vreplay* model;
+    std::vector<replay_signal_s> signals;
+    bool record;                                        // Snapshot the signals in every cycle
+    std::vector<std::vector<std::string>> snapshots;    // [cycle][signal]
+};
+
+// Pipeline stage a signal belongs to, from the naming convention of the units:
+// sN_* are the stage N registers, *_q / result the output register, a / b / rm
+// the inputs. Everything else is combinational.
+static int replay_stage(const std::string& name) {
+    const std::string base = name.substr(name.rfind('.') + 1);
+    if (base.size() > 2 && base[0] == 's' && isdigit((unsigned char)base[1])) {
+        const size_t us = base.find('_');
+        if (us != std::string::npos && us > 1) {
+            return atoi(base.c_str() + 1);
+        }
+    }
+    if (base == "a" || base == "b" || base == "rm") {
+        return 0;
+    }
+    if (base == "result" || (base.size() > 2 && base.compare(base.size() - 2, 2, "_q") == 0)) {
+        return REPLAY_LATENCY;
+    }
+    return -1;
+}
+
+static void replay_collect(replay_dut_s* d, vpiHandle scope, const std::string& prefix, int depth) {
+    vpiHandle it = vpi_iterate(vpiReg, scope);
+    if (it) {
+        while (vpiHandle h = vpi_scan(it)) {
+            const std::string name = prefix + vpi_get_str(vpiName, h);
+            if (name == "clk" || name == "rst_n") {
+                continue;
+            }
+            d->signals.push_back({name, h, replay_stage(name)});
+        }
+    }
+    if (depth == 0) {
+        return;
+    }
+    it = vpi_iterate(vpiModule, scope);
+    if (it) {
+        while (vpiHandle h = vpi_scan(it)) {
+            replay_collect(d, h, prefix + vpi_get_str(vpiName, h) + ".", depth - 1);
+        }
+    }
+}
+
+static void replay_snapshot(replay_dut_s* d) {
+    std::vector<std::string> values;
+    for (const replay_signal_s& s : d->signals) {
+        s_vpi_value v;
+        v.format = vpiHexStrVal;
+        vpi_get_value(s.handle, &v);
+        values.push_back(v.value.str);
+    }
+    d->snapshots.push_back(values);
+}
+
+static void replay_tick(replay_dut_s* d) {
+    d->model->clk = 1;
+    d->model->eval();
+    d->ctx->timeInc(1);
+    d->model->clk = 0;
+    d->model->eval();
+    d->ctx->timeInc(1);
+}
+
+// fp_replay_run_fn: resets the unit and issues the window back to back, one
+// transaction per cycle as the UVM driver does. The result of transaction i
+// is sampled REPLAY_LATENCY cycles after it was applied.
+static int replay_run(void* user, const fp_replay_vec_s* window, int n, uint64_t* results) {
+    replay_dut_s* d = (replay_dut_s*)user;
+    d->snapshots.clear();
+
+    d->model->rst_n = 0;
+    d->model->a = 0;
+    d->model->b = 0;
+    d->model->rm = 0;
+    replay_tick(d);
+    replay_tick(d);
+    d->model->rst_n = 1;
+    d->model->eval();
+
+    for (int cycle = 0; cycle < n + REPLAY_LATENCY; cycle++) {
+        if (cycle < n) {
+            d->model->a = window[cycle].a;
+            d->model->b = window[cycle].b;
+            d->model->rm = window[cycle].rm;
+        }
+        d->model->eval();
+        if (cycle >= REPLAY_LATENCY) {
+            results[cycle - REPLAY_LATENCY] = d->model->result;
+        }
+        if (d->record) {
+            replay_snapshot(d);
+        }
+        replay_tick(d);
+    }
+    return 0;
+}
+
+// Per-stage table of the RTL signals for the transaction applied at 'cycle'
+static void replay_print_rtl(const replay_dut_s* d, int cycle) {
+    printf("RTL (%s, WIDTH=%d, latency %d):\n", REPLAY_DUT_NAME, REPLAY_WIDTH, REPLAY_LATENCY);
+    for (int stage = 0; stage <= REPLAY_LATENCY; stage++) {
+        for (size_t i = 0; i < d->signals.size(); i++) {
+            if (d->signals[i].stage == stage) {
+                printf("  %-4s %-28s 0x%s\n", stage ? ("s" + std::to_string(stage)).c_str() : "in", d->signals[i].name.c_str(),
+                       d->snapshots[cycle + stage][i].c_str());
+            }
+        }
+    }
+
+    printf("RTL combinational signals, +k = k cycles after the transaction was applied:\n");
+    printf("  %-33s", "");
+    for (int k = 0; k < REPLAY_LATENCY; k++) {
+        printf(" %-18s", ("+" + std::to_string(k)).c_str());
+    }
+    printf("\n");
+    for (size_t i = 0; i < d->signals.size(); i++) {
+        if (d->signals[i].stage < 0) {
+            printf("  %-33s", d->signals[i].name.c_str());
+            for (int k = 0; k < REPLAY_LATENCY; k++) {
+                printf(" 0x%-16s", d->snapshots[cycle + k][i].c_str());
+            }
+            printf("\n");
+        }
+    }
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s --log FILE | --vec FILE | --a HEX --b HEX [--rm N] [--index N] [--history N] [--no-minimize]\n", prog);
+}
+
+int main(int argc, char** argv) {
+    const char* path = NULL;
+    fp_replay_vec_s single;
+    bool have_single = false;
+    int index = -1;
+    int history = REPLAY_LATENCY;
+    bool minimize = true;
+
+    memset(&single, 0, sizeof(single));
+    for (int i = 1; i < argc; i++) {
+        if ((!strcmp(argv[i], "--log") || !strcmp(argv[i], "--vec")) && i + 1 < argc) {
+            path = argv[++i];
+        } else if (!strcmp(argv[i], "--a") && i + 1 < argc) {
+            single.a = strtoull(argv[++i], NULL, 16);
+            have_single = true;
+        } else if (!strcmp(argv[i], "--b") && i + 1 < argc) {
+            single.b = strtoull(argv[++i], NULL, 16);
+            have_single = true;
+        } else if (!strcmp(argv[i], "--rm") && i + 1 < argc) {
+            single.rm = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--index") && i + 1 < argc) {
+            index = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--history") && i + 1 < argc) {
+            history = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--no-minimize")) {
+            minimize = false;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!path == !have_single || single.rm < 0 || single.rm > 4 || history < 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // Transactions
+    fp_replay_vec_s* vecs = &single;
+    int num_vecs = 1;
+    if (path) {
+        num_vecs = fp_replay_load(path, &vecs);
+        if (num_vecs < 0) {
+            perror(path);
+            return 2;
+        }
+        if (index < 0) {
+            index = fp_replay_find_failing(vecs, num_vecs);
+        }
+        if (index < 0) {
+            fprintf(stderr, "%s: no failing transaction among %d, select one with --index\n", path, num_vecs);
+            return 2;
+        }
+        if (index >= num_vecs) {
+            fprintf(stderr, "%s: --index %d out of range (%d transactions)\n", path, index, num_vecs);
+            return 2;
+        }
+    } else {
+        index = 0;
+    }
+    const int first = (index > history) ? index - history : 0;
+    int n = index - first + 1;
+    std::vector<fp_replay_vec_s> window(vecs + first, vecs + index + 1);
+
+    // Verilated unit
+    const auto start = std::chrono::steady_clock::now();
+    replay_dut_s d;
+    d.ctx = new VerilatedContext;
+    d.ctx->commandArgs(argc, argv);
+    d.model = new Vreplay{d.ctx};
+    d.record = false;
+    VerilatedVpi::callCbs(cbStartOfSimulation);
+    vpiHandle top = vpi_handle_by_name((PLI_BYTE8*)"TOP." REPLAY_DUT_NAME, NULL);
+    if (top) {
+        replay_collect(&d, top, "", 1);
+    } else {
+        fprintf(stderr, "Warning: no VPI scope for the unit, build with --vpi --public-flat-rw for the signal table\n");
+    }
+
+    fp_replay_s r;
+    r.op = REPLAY_OP;
+    r.width = REPLAY_WIDTH;
+    r.run = replay_run;
+    r.user = &d;
+    r.runs = 0;
+
+    fp_replay_print_vec(&r, stdout, "Failing", &window[n - 1]);
+    uint64_t dut_result = 0;
+    int fails = fp_replay_fails(&r, window.data(), n, &dut_result);
+    printf("Replayed with %d preceding transactions: DUT=0x%0*llx -> %s\n", n - 1, REPLAY_WIDTH / 4, (unsigned long long)dut_result,
+           fails ? "FAIL" : "PASS (does not reproduce, try a larger --history)");
+
+    if (fails && minimize) {
+        fp_replay_minimize(&r, window.data(), &n);
+        printf("Minimized to %d transaction%s:\n", n, (n == 1) ? "" : "s");
+        for (int i = 0; i < n; i++) {
+            fp_replay_print_vec(&r, stdout, (i == n - 1) ? "  Failing" : "  History", &window[i]);
+        }
+        // Vector file line, for fp_sequence2_inverse +INV_VECTORS
+        printf("  Vector: %0*llx %0*llx 0 %d %0*llx\n", REPLAY_WIDTH / 4, (unsigned long long)window[n - 1].a, REPLAY_WIDTH / 4,
+               (unsigned long long)window[n - 1].b, window[n - 1].rm, REPLAY_WIDTH / 4, (unsigned long long)fp_replay_model(&r, &window[n - 1], NULL));
+    }
+
+    // Final run with the signal snapshots
+    d.record = true;
+    fails = fp_replay_fails(&r, window.data(), n, &dut_result);
+    printf("\nDUT result 0x%0*llx\n", REPLAY_WIDTH / 4, (unsigned long long)dut_result);
+    if (!d.signals.empty()) {
+        replay_print_rtl(&d, n - 1);
+    }
+    fp_replay_print_model(&r, stdout, &window[n - 1]);
+
+    const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("\n%s : %d DUT runs in %.1f ms\n", fails ? "FAIL" : "PASS", r.runs, elapsed);
+
+    d.model->final();
+    delete d.model;
+    delete d.ctx;
+    if (vecs != &single) {
+        free(vecs);
+    }
+    return fails ? 1 : 0;
+}
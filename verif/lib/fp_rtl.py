@@ -0,0 +1,277 @@
+#!/usr/bin/env python3
+
+"""
+NumPy batch access to the Verilated RTL of the floating-point units.
+
+Each unit (fp_add, fp_mul, fp_exp, fp_recip) at one width is Verilated into a
+shared library (make -f verilator.mk pylib DUT=<unit> WIDTH=<width>, see
+verif/lib/fp_batch_vl.cpp) that streams operand arrays through the pipeline,
+one operation per cycle, and also holds the bit-accurate C model. So the RTL,
+the C model and the Python model (fp_model.py) can be compared three ways on
+the same vectors from a notebook:
+
+    from fp_rtl import FpRtl, random_operands, to_float
+    unit = FpRtl("fp_mul", 32, build=True)
+    a, b = random_operands(32, 10**6), random_operands(32, 10**6)
+    rtl = unit.run(a, b, rm=0)           # np.uint64 bit patterns
+    c = unit.model(a, b, rm=0)
+    assert (rtl == c).all()
+    y = to_float(rtl, 32)                # np.float32 values
+
+Operands are bit patterns (any integer dtype) or float arrays of the unit's
+width; rm is a scalar or an array of rounding modes (fp_model.RNE etc.).
+
+Run as a script for a three-way comparison, e.g.
+    python3 verif/lib/fp_rtl.py --dut fp_add --width 16 --count 1000000 --build
+"""
+# verif/lib/fp_rtl.py
+
+import argparse
+import ctypes
+import os
+import subprocess
+import time
+from typing import Dict, Optional
+
+import numpy as np
+
+from fp_model import RNE, fp_add as fp_add_py, fp_mul as fp_mul_py
+
+UNITS = ("fp_add", "fp_mul", "fp_exp", "fp_recip")
+UNARY_UNITS = ("fp_exp", "fp_recip")
+
+_FLOAT_TYPES = {16: np.float16, 32: np.float32, 64: np.float64}
+_UINT_TYPES = {16: np.uint16, 32: np.uint32, 64: np.uint64}
+_FORMATS = {16: (5, 10), 32: (8, 23), 64: (11, 52)}
+
+_U64_P = np.ctypeslib.ndpointer(dtype=np.uint64, flags="C_CONTIGUOUS")
+_U8_P = np.ctypeslib.ndpointer(dtype=np.uint8, flags="C_CONTIGUOUS")
+
+
+def workspace_root() -> str:
+    """Repository root (verilator.mk is run from there)."""
+    current_dir = os.path.dirname(os.path.abspath(__file__))
+    return os.path.abspath(os.path.join(current_dir, "..", ".."))
+
+
+def lib_path(dut: str, width: int) -> str:
+    """Path of the batch library of a unit, as built by verilator.mk."""
+    return os.path.join(workspace_root(), "build", "verilator", "batch", f"{dut}_{width}", "libfp_batch.so")
+
+
+def build_lib(dut: str, width: int) -> str:
+    """Verilates and links the batch library of a unit (needs Verilator)."""
+    cmd = ["make", "-f", "verilator.mk", "pylib", f"DUT={dut}", f"WIDTH={width}"]
+    print(f"Running: {' '.join(cmd)}")
+    subprocess.run(cmd, cwd=workspace_root(), check=True)
+    return lib_path(dut, width)
+
+
+def to_bits(x, width: int) -> np.ndarray:
+    """Bit patterns of x as np.uint64 (float arrays are cast to the width first)."""
+    x = np.asarray(x)
+    if x.dtype.kind == "f":
+        x = x.astype(_FLOAT_TYPES[width]).view(_UINT_TYPES[width])
+    bits = x.astype(np.uint64)
+    if width < 64:
+        bits &= np.uint64((1 << width) - 1)
+    return np.ascontiguousarray(bits)
+
+
+def to_float(bits, width: int) -> np.ndarray:
+    """Float values of bit patterns of the given width."""
+    return np.asarray(bits).astype(_UINT_TYPES[width]).view(_FLOAT_TYPES[width])
+
+
+def is_nan(bits: np.ndarray, width: int) -> np.ndarray:
+    """NaN mask of bit patterns."""
+    exp_w, mant_w = _FORMATS[width]
+    bits = np.asarray(bits, dtype=np.uint64)
+    exp = (bits >> np.uint64(mant_w)) & np.uint64((1 << exp_w) - 1)
+    mant = bits & np.uint64((1 << mant_w) - 1)
+    return (exp == np.uint64((1 << exp_w) - 1)) & (mant != 0)
+
+
+def random_operands(width: int, count: int, rng: Optional[np.random.Generator] = None) -> np.ndarray:
+    """
+    Random bit patterns: uniform bits, with one operand in 16 a zero, an
+    infinity, a NaN, a denormal or 1.0 (signs random).
+    """
+    rng = rng if rng is not None else np.random.default_rng()
+    exp_w, mant_w = _FORMATS[width]
+    bits = rng.integers(0, 2**64, size=count, dtype=np.uint64, endpoint=False)
+    if width < 64:
+        bits &= np.uint64((1 << width) - 1)
+    sign = bits & np.uint64(1 << (width - 1))
+    exp_ones = np.uint64(((1 << exp_w) - 1) << mant_w)
+    specials = np.array(
+        [0, int(exp_ones), int(exp_ones) | (1 << (mant_w - 1)), 1, ((1 << (exp_w - 1)) - 1) << mant_w],
+        dtype=np.uint64,
+    )
+    pick = rng.integers(0, 16 * len(specials), size=count)
+    mask = pick < len(specials)
+    bits[mask] = sign[mask] | specials[pick[mask]]
+    return bits
+
+
+class FpRtl:
+    """One Verilated instance of a floating-point unit at one width."""
+
+    def __init__(self, dut: str = "fp_add", width: int = 16, build: bool = False):
+        if dut not in UNITS:
+            raise ValueError(f"Unsupported unit {dut}, expected one of {UNITS}")
+        if width not in _FORMATS:
+            raise ValueError(f"Unsupported width: {width}")
+        self.dut = dut
+        self.width = width
+        self.unary = dut in UNARY_UNITS
+        self._handle = None
+
+        path = lib_path(dut, width)
+        if build or not os.path.exists(path):
+            build_lib(dut, width)
+        self._lib = ctypes.CDLL(path)
+        lib = self._lib
+        lib.fp_batch_open.restype = ctypes.c_void_p
+        lib.fp_batch_close.argtypes = [ctypes.c_void_p]
+        lib.fp_batch_latency.argtypes = [ctypes.c_void_p]
+        lib.fp_batch_latency.restype = ctypes.c_int
+        lib.fp_batch_cycles.argtypes = [ctypes.c_void_p]
+        lib.fp_batch_cycles.restype = ctypes.c_uint64
+        lib.fp_batch_run.argtypes = [ctypes.c_void_p, _U64_P, ctypes.c_void_p, _U8_P, _U64_P, ctypes.c_size_t]
+        lib.fp_batch_model.argtypes = [_U64_P, ctypes.c_void_p, _U8_P, _U64_P, ctypes.c_size_t]
+
+        self._handle = lib.fp_batch_open()
+        if not self._handle:
+            raise RuntimeError(f"{dut} WIDTH={width}: no result for a NaN operand, latency unknown")
+
+    @property
+    def latency(self) -> int:
+        """Pipeline latency in cycles (measured when the unit was opened)."""
+        return self._lib.fp_batch_latency(self._handle)
+
+    @property
+    def cycles(self) -> int:
+        """Cycles clocked since the unit was opened."""
+        return self._lib.fp_batch_cycles(self._handle)
+
+    def _operands(self, a, b, rm):
+        a = to_bits(a, self.width)
+        if self.unary:
+            b = None
+        elif b is None:
+            raise ValueError(f"{self.dut} needs two operands")
+        else:
+            b = to_bits(b, self.width)
+            if b.shape != a.shape:
+                raise ValueError("a and b differ in shape")
+        rm = np.ascontiguousarray(np.broadcast_to(np.asarray(rm, dtype=np.uint8), a.shape))
+        return a.ravel(), (None if b is None else b.ravel()), rm.ravel(), a.shape
+
+    def run(self, a, b=None, rm=RNE) -> np.ndarray:
+        """Results of the RTL, one operation per cycle, as np.uint64 bit patterns."""
+        a, b, rm, shape = self._operands(a, b, rm)
+        out = np.empty(a.size, dtype=np.uint64)
+        b_ptr = None if b is None else b.ctypes.data_as(ctypes.c_void_p)
+        self._lib.fp_batch_run(self._handle, a, b_ptr, rm, out, a.size)
+        return out.reshape(shape)
+
+    def model(self, a, b=None, rm=RNE) -> np.ndarray:
+        """Results of the C model for the same operands."""
+        a, b, rm, shape = self._operands(a, b, rm)
+        out = np.empty(a.size, dtype=np.uint64)
+        b_ptr = None if b is None else b.ctypes.data_as(ctypes.c_void_p)
+        self._lib.fp_batch_model(a, b_ptr, rm, out, a.size)
+        return out.reshape(shape)
+
+    def close(self) -> None:
+        """Releases the Verilated instance."""
+        if self._handle:
+            self._lib.fp_batch_close(self._handle)
+            self._handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+
+def python_model(dut: str, a: np.ndarray, b: np.ndarray, rm: np.ndarray, width: int) -> np.ndarray:
+    """Results of fp_model.py (fp_add / fp_mul only, one operation at a time)."""
+    op = {"fp_add": fp_add_py, "fp_mul": fp_mul_py}[dut]
+    digits = width // 4
+    out = np.empty(len(a), dtype=np.uint64)
+    for i, (x, y, r) in enumerate(zip(a.tolist(), b.tolist(), rm.tolist())):
+        out[i] = int(op(f"{x:0{digits}x}", f"{y:0{digits}x}", width, r)["hex"], 16)
+    return out
+
+
+def mismatches(x: np.ndarray, y: np.ndarray, width: int) -> np.ndarray:
+    """Indices where x and y differ (any NaN matches any NaN)."""
+    nan_x, nan_y = is_nan(x, width), is_nan(y, width)
+    return np.flatnonzero((x != y) & ~(nan_x & nan_y))
+
+
+def compare(dut: str, width: int, count: int, py_count: int, seed: int, build: bool) -> Dict[str, int]:
+    """Runs random vectors through the RTL, the C model and the Python model."""
+    rng = np.random.default_rng(seed)
+    a = random_operands(width, count, rng)
+    b = random_operands(width, count, rng)
+    rm = rng.integers(0, 5, size=count, dtype=np.uint8)
+
+    with FpRtl(dut, width, build) as unit:
+        start = time.perf_counter()
+        rtl = unit.run(a, b, rm)
+        t_rtl = time.perf_counter() - start
+        start = time.perf_counter()
+        c = unit.model(a, b, rm)
+        t_c = time.perf_counter() - start
+        latency = unit.latency
+
+    rtl_c = np.flatnonzero(rtl != c)
+    print(f"{dut} WIDTH={width}: latency {latency}, {count} vectors, random rounding modes")
+    print(f"RTL        : {count / t_rtl:12.0f} vectors/s")
+    print(f"C model    : {count / t_c:12.0f} vectors/s")
+    print(f"RTL vs C   : {len(rtl_c)} mismatches")
+    for i in rtl_c[:5]:
+        print(f"  a {int(a[i]):x} b {int(b[i]):x} rm {rm[i]}: RTL {int(rtl[i]):x}, C {int(c[i]):x}")
+
+    py_c = np.array([], dtype=np.int64)
+    py_n = min(py_count, count) if dut in ("fp_add", "fp_mul") else 0
+    if py_n:
+        start = time.perf_counter()
+        py = python_model(dut, a[:py_n], b[:py_n], rm[:py_n], width)
+        t_py = time.perf_counter() - start
+        py_c = mismatches(py, c[:py_n], width)
+        print(f"Python     : {py_n / t_py:12.0f} vectors/s")
+        print(f"Python vs C: {len(py_c)} mismatches in the first {py_n} vectors (NaN payloads ignored)")
+        for i in py_c[:5]:
+            print(f"  a {int(a[i]):x} b {int(b[i]):x} rm {rm[i]}: Python {int(py[i]):x}, C {int(c[i]):x}")
+
+    return {"rtl_c": len(rtl_c), "py_c": len(py_c), "py_count": py_n}
+
+
+def main() -> None:
+    """Three-way comparison from the command line."""
+    parser = argparse.ArgumentParser(description="Compare Verilated RTL, C model and Python model on random vectors")
+    parser.add_argument("--dut", choices=UNITS, default="fp_add", help="Unit")
+    parser.add_argument("--width", type=int, choices=[16, 32, 64], default=16, help="Width")
+    parser.add_argument("--count", type=int, default=1000000, help="Vectors through the RTL and the C model")
+    parser.add_argument("--py-count", type=int, default=2000, help="Vectors through the Python model")
+    parser.add_argument("--seed", type=int, default=1, help="Random seed")
+    parser.add_argument("--build", action="store_true", help="Rebuild the batch library first")
+    args = parser.parse_args()
+
+    result = compare(args.dut, args.width, args.count, args.py_count, args.seed, args.build)
+    if result["rtl_c"] or result["py_c"]:
+        print("\nFAIL : RTL, C model and Python model disagree")
+        raise SystemExit(1)
+    print("\nPASS : RTL, C model and Python model agree")
+
+
+if __name__ == "__main__":
+    main()
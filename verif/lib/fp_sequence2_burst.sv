@@ -0,0 +1,66 @@
+// verif/lib/fp_sequence2_burst.sv
+// Burst sequence for 2-input fp_add / fp_mul DUTs with parameterized WIDTH.
+//
+// Operands are generated up front into the burst arrays of one fp_transaction2
+// (with the same category distribution as fp_sequence2_random) and handed to
+// the driver as a single item, which streams them one per clock without
+// per-item sequencer handshakes (see fp_driver_base::drive_burst()). With
+// +BURST_VECTORS the driver streams a vector file instead.
+//
+// Plusargs:
+//   +BURST_LEN=<n>          Operands per burst (default burst_len)
+//   +BURST_COUNT=<n>        Number of bursts (default num_bursts)
+//   +BURST_VECTORS=<file>   Vector file to stream ("a b c rm expected" in hex, '#' comments)
+
+`include "uvm_macros.svh"
+import uvm_pkg::*;
+
+class fp_sequence2_burst #(
+    parameter int WIDTH = 16
+) extends uvm_sequence #(fp_transaction2 #(WIDTH));
+
+    `uvm_object_param_utils(fp_sequence2_burst #(WIDTH))
+
+    int burst_len = 1000;
+    int num_bursts = 10;
+    string vectors;
+
+    function new(string name = "fp_sequence2_burst");
+        super.new(name);
+    endfunction
+
+    virtual task body();
+        fp_transaction2 #(WIDTH) req;
+
+        void'($value$plusargs("BURST_LEN=%d", burst_len));
+        void'($value$plusargs("BURST_COUNT=%d", num_bursts));
+        void'($value$plusargs("BURST_VECTORS=%s", vectors));
+
+        // Burst items are not pooled, they own the operand arrays
+        if (vectors != "") begin
+            req = fp_transaction2 #(WIDTH)::type_id::create("burst");
+            req.burst_file = vectors;
+            start_item(req);
+            finish_item(req);
+            return;
+        end
+
+        repeat (num_bursts) begin
+            fp_transaction2 #(WIDTH) gen;
+            req = fp_transaction2 #(WIDTH)::type_id::create("burst");
+            gen = fp_transaction2 #(WIDTH)::type_id::create("gen");
+            req.burst_a = new[burst_len];
+            req.burst_b = new[burst_len];
+            req.burst_rm = new[burst_len];
+            foreach (req.burst_a[i]) begin
+                assert(gen.randomize());
+                req.burst_a[i] = gen.inputs[0];
+                req.burst_b[i] = gen.inputs[1];
+                req.burst_rm[i] = gen.rm;
+            end
+            start_item(req);
+            finish_item(req);
+        end
+    endtask
+
+endclass
@@ -0,0 +1,133 @@
+// verif/lib/fp_sequence2_inverse.sv
+// Inverse-constructed sequence for 2-input fp_add / fp_mul DUTs with parameterized WIDTH.
+//
+// Operands come from fp_inverse.c, which builds them analytically from a
+// targeted result property: exact result, GRS pattern, tie, rounding overflow,
+// overflow after rounding, cancellation depth, exact zero and the
+// normal/denormal boundary. Each target gets num_per_target transactions,
+// cycling its params and the rounding modes it supports. Targets the op cannot
+// reach (e.g. cancellation for fp_mul) are skipped.
+//
+// With +INV_VECTORS the operands are replayed from a vector file written by
+// fp_inverse_gen (native.mk) instead.
+//
+// Plusargs:
+//   +INV_TARGET=<n>      Only this FP_INV_* target (default: all)
+//   +INV_COUNT=<n>       Transactions per target (default num_per_target)
+//   +INV_SEED=<n>        Generator seed (default 1)
+//   +INV_VECTORS=<file>  Vector file to replay ("a b c rm expected" in hex, '#' comments)
+
+`include "uvm_macros.svh"
+`include "fp_macros.svh"
+import uvm_pkg::*;
+
+class fp_sequence2_inverse #(
+    parameter int WIDTH = 16
+) extends uvm_sequence #(fp_transaction2 #(WIDTH));
+
+    `uvm_object_param_utils(fp_sequence2_inverse #(WIDTH))
+
+    // Mirrors fp_inverse.h
+    localparam int FP_INV_GRS         = 1;
+    localparam int FP_INV_CANCEL      = 5;
+    localparam int FP_INV_NUM_TARGETS = 10;
+    localparam int FP_INV_EXP_ANY     = 32'h8000_0000;
+    localparam int FP_INV_OK          = 0;
+    localparam int FP_INV_UNSUPPORTED = -1;
+
+    localparam int MANT_W = fp_lib_pkg::get_mant_width(WIDTH);
+
+    int num_per_target = 200;
+    int op = 0;       // 0 - fp_add, 1 - fp_mul
+    int target = -1;  // -1 - all targets
+    int seed = 1;
+    string vectors;
+
+    function new(string name = "fp_sequence2_inverse");
+        super.new(name);
+    endfunction
+
+    virtual task body();
+        void'($value$plusargs("INV_TARGET=%d", target));
+        void'($value$plusargs("INV_COUNT=%d", num_per_target));
+        void'($value$plusargs("INV_SEED=%d", seed));
+        void'($value$plusargs("INV_VECTORS=%s", vectors));
+
+        if (vectors != "") begin
+            replay_vectors();
+        end else begin
+            if (c_fp_inv_init(op, WIDTH, seed) != 0) begin
+                `uvm_fatal(get_type_name(), $sformatf("c_fp_inv_init failed for op=%0d WIDTH=%0d", op, WIDTH))
+            end
+            for (int t = 0; t < FP_INV_NUM_TARGETS; t++) begin
+                if (target < 0 || t == target) begin
+                    drive_target(t);
+                end
+            end
+        end
+    endtask
+
+    // Drives num_per_target constructed transactions for one target
+    virtual task drive_target(int t);
+        int min_param = (t == FP_INV_CANCEL) ? 1 : 0;
+        int max_param = (t == FP_INV_GRS) ? 7 : (t == FP_INV_CANCEL) ? MANT_W : 0;
+        int count = 0;
+        int attempts = 0;
+
+        // Params and rounding modes are cycled, combinations the op does not support are skipped
+        while (count < num_per_target && attempts < 5 * num_per_target * (max_param - min_param + 1)) begin
+            fp_transaction2 #(WIDTH) req;
+            longint unsigned a_val, b_val, c_val;
+            int param = min_param + attempts % (max_param - min_param + 1);
+            int rm_val = (attempts / (max_param - min_param + 1)) % 5;
+            int rc;
+
+            attempts++;
+            rc = c_fp_inv_make(t, param, FP_INV_EXP_ANY, rm_val, -1, a_val, b_val, c_val);
+            if (rc == FP_INV_UNSUPPORTED) continue;
+            if (rc != FP_INV_OK) begin
+                `uvm_error(get_type_name(), $sformatf("c_fp_inv_make(target=%0d, param=%0d, rm=%0d) returned %0d", t, param, rm_val, rc))
+                continue;
+            end
+            `uvm_do_special_case("req", req, {
+                req.inputs[0] == a_val[WIDTH-1:0];
+                req.inputs[1] == b_val[WIDTH-1:0];
+                req.rm == rm_val;
+            })
+            count++;
+        end
+        `uvm_info(get_type_name(), $sformatf("Target %0d: %0d transactions", t, count), UVM_MEDIUM)
+    endtask
+
+    // Replays a vector file, the expected column is left to the scoreboard's model
+    virtual task replay_vectors();
+        int fd;
+        int count = 0;
+        string line;
+
+        fd = $fopen(vectors, "r");
+        if (fd == 0) begin
+            `uvm_fatal(get_type_name(), $sformatf("Cannot open vector file %s", vectors))
+        end
+        while ($fgets(line, fd)) begin
+            fp_transaction2 #(WIDTH) req;
+            longint unsigned a_val, b_val, c_val;
+            int rm_val;
+
+            if (line.len() == 0 || line[0] == "#" || line[0] == "\n") continue;
+            if ($sscanf(line, "%h %h %h %d", a_val, b_val, c_val, rm_val) != 4) begin
+                `uvm_error(get_type_name(), $sformatf("Malformed vector line: %s", line))
+                continue;
+            end
+            `uvm_do_special_case("req", req, {
+                req.inputs[0] == a_val[WIDTH-1:0];
+                req.inputs[1] == b_val[WIDTH-1:0];
+                req.rm == rm_val;
+            })
+            count++;
+        end
+        $fclose(fd);
+        `uvm_info(get_type_name(), $sformatf("Replayed %0d vectors from %s", count, vectors), UVM_LOW)
+    endtask
+
+endclass
@@ -19,7 +19,7 @@ class fp_sequence2_random #(
     virtual task body();
         repeat (num_trans) begin
             fp_transaction2 #(WIDTH) req;
-            req = fp_transaction2 #(WIDTH)::type_id::create("req");
+            req = obj_pool #(fp_transaction2 #(WIDTH))::get("req");  // Released by the monitor
             start_item(req);
             assert(req.randomize());
             finish_item(req);
@@ -0,0 +1,87 @@
+// verif/lib/fp_sequence2_steered.sv
+// Coverage-steered sequence for 2-input fp_add / fp_mul DUTs with parameterized WIDTH.
+//
+// Operands come from the closed-loop generator in fp_cov_steer.c: every new
+// transaction is biased toward the coverage bins (operand classes, exponent
+// difference, cancellation, GRS pattern, rounding overflow) that are still
+// unhit, and the sequence ends once all bins are hit.
+//
+// The coverage counts the operations the DUT ran: with a model handle (set
+// by the steered tests), the model samples every transaction the scoreboard
+// receives from the monitor, and reports the coverage at the end of the
+// test. Results still in the pipeline are not counted yet when the next
+// operands are drawn, so the sequence may run a few transactions past full
+// coverage. Without a model the sequence samples each transaction once the
+// driver has taken it, i.e. the stimulus, not the observed operations.
+//
+// Every run of the sequence gets its own coverage context (the handle
+// returned by c_fp_cov_init), so steered sequences of several units or widths
+// can run side by side.
+//
+// Plusargs:
+//   +COV_GEN=<n>   0 - fp_transaction2 distribution, 1 - uniform, 2 - steered (default)
+//   +COV_SEED=<n>  Generator seed (default 1)
+//   +COV_MAX=<n>   Maximum number of transactions (default num_trans)
+
+`include "uvm_macros.svh"
+`include "fp_macros.svh"
+import uvm_pkg::*;
+
+class fp_sequence2_steered #(
+    parameter int WIDTH = 16
+) extends uvm_sequence #(fp_transaction2 #(WIDTH));
+
+    `uvm_object_param_utils(fp_sequence2_steered #(WIDTH))
+
+    int num_trans = 10000;  // Upper bound, the sequence stops at full coverage
+    int op = 0;             // 0 - fp_add, 1 - fp_mul
+    int gen = 2;
+    int seed = 1;
+    bit stop_at_full = 1;
+    fp_model_base #(fp_transaction2 #(WIDTH)) model;  // Samples the observed operations
+
+    function new(string name = "fp_sequence2_steered");
+        super.new(name);
+    endfunction
+
+    virtual task body();
+        int cov;
+        int bins;
+        int count = 0;
+
+        void'($value$plusargs("COV_GEN=%d", gen));
+        void'($value$plusargs("COV_SEED=%d", seed));
+        void'($value$plusargs("COV_MAX=%d", num_trans));
+
+        cov = c_fp_cov_init(op, WIDTH, gen, seed);
+        if (cov < 0) begin
+            `uvm_fatal(get_type_name(), $sformatf("c_fp_cov_init failed for op=%0d WIDTH=%0d gen=%0d", op, WIDTH, gen))
+        end
+        bins = c_fp_cov_bins(cov);
+        if (model != null)
+            model.cov_handle = cov;
+
+        repeat (num_trans) begin
+            fp_transaction2 #(WIDTH) req;
+            longint unsigned a_val, b_val;
+            int rm_val;
+
+            c_fp_cov_next(cov, a_val, b_val, rm_val);
+            `uvm_do_special_case("req", req, {
+                req.inputs[0] == a_val[WIDTH-1:0];
+                req.inputs[1] == b_val[WIDTH-1:0];
+                req.rm == rm_val;
+            })
+            if (model == null)
+                c_fp_cov_sample(cov, a_val, b_val, rm_val);
+            count++;
+            if (stop_at_full && c_fp_cov_hit(cov) == bins) break;
+        end
+
+        `uvm_info(get_type_name(), $sformatf("Coverage %0d/%0d bins after %0d transactions (gen=%0d)",
+                                             c_fp_cov_hit(cov), bins, count, gen), UVM_LOW)
+        if (model == null)
+            c_fp_cov_report(cov);  // Else reported by the model at the end of the test
+    endtask
+
+endclass
@@ -0,0 +1,271 @@
+// verif/lib/fp_softmax_bench.cpp
+//
+// Native benchmark of the streaming softmax unit (fp_softmax.v, reference
+// model in fp_softmax_model.cpp).
+//
+// Self-check first: fp_exp against libm (fp16 exhaustive, fp32 / fp64
+// random, RNE) and fp_recip against the correctly rounded reciprocal. Then,
+// for row lengths 64 .. 4096 of random inputs uniform in [-range, range]:
+//   - throughput (elements / cycle) of the unit for the rows streamed back
+//     to back and in steady state (row length / accumulator period), and
+//     first-row latency (cycle model, in_valid always high),
+//   - accuracy of the unit order against a double softmax of the same
+//     inputs, next to a sequential two-pass order (max first, then one
+//     running fp_add sum): max error in ulps over the outputs that are normal
+//     in the reference, and max |sum(y) - 1|.
+//
+// Build and run (see native.mk):
+//   make -f native.mk softmax
+//   build/native/fp_softmax_bench [--width 16|32|64] [--len N] [--rows N] [--range R] [--seed N]
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "fp_model.h"
+}
+
+#include "fp_softmax_model.h"
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static const int len_list[] = {64, 128, 256, 512, 1024, 2048, 4096};
+
+struct fp_fmt_s {
+    int exp_w;
+    int bias;
+    int mant_w;
+};
+
+static fp_fmt_s fp_fmt(int width) {
+    if (width == 64) return {11, 1023, 52};
+    if (width == 32) return {8, 127, 23};
+    return {5, 15, 10};
+}
+
+static long double fp_to_ld(uint64_t v, int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    const int sign = (v >> (width - 1)) & 1;
+    const int exp = (int)((v >> f.mant_w) & ((1ULL << f.exp_w) - 1));
+    const uint64_t mant = v & ((1ULL << f.mant_w) - 1);
+    long double m;
+    if (exp == (1 << f.exp_w) - 1) {
+        m = mant ? NAN : INFINITY;
+    } else if (exp == 0) {
+        m = ldexpl((long double)mant, 1 - f.bias - f.mant_w);
+    } else {
+        m = ldexpl((long double)((1ULL << f.mant_w) | mant), exp - f.bias - f.mant_w);
+    }
+    return sign ? -m : m;
+}
+
+// Nearest normal value (ties to even), zero below the normal range
+static uint64_t fp_from_double(double d, int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    const uint64_t sign = (d < 0) ? 1ULL << (width - 1) : 0;
+    int e;
+    const double frac = frexp(fabs(d), &e);  // |d| = frac * 2^e, frac in [0.5, 1)
+    if (d == 0 || e - 1 < 1 - f.bias) return sign;
+    uint64_t sig = (uint64_t)nearbyint(ldexp(frac, f.mant_w + 1));
+    if (sig >> (f.mant_w + 1)) {
+        sig >>= 1;
+        e++;
+    }
+    if (e - 1 + f.bias >= (1 << f.exp_w) - 1) return sign | (((1ULL << f.exp_w) - 1) << f.mant_w);
+    return sign | ((uint64_t)(e - 1 + f.bias) << f.mant_w) | (sig & ((1ULL << f.mant_w) - 1));
+}
+
+// Error of y in ulps of the reference ref (normal ref only)
+static double ulp_err(uint64_t y, long double ref, int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    int e;
+    frexpl(ref, &e);
+    const long double ulp = ldexpl(1.0L, e - 1 - f.mant_w);
+    return (double)(fabsl(fp_to_ld(y, width) - ref) / ulp);
+}
+
+static bool ref_is_normal(long double ref, int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    return fabsl(ref) >= ldexpl(1.0L, 1 - f.bias) && fabsl(ref) <= ldexpl(2.0L, f.bias) * (1 - ldexpl(1.0L, -f.mant_w - 1));
+}
+
+//----------------------------------------------------------------------------
+// fp_exp / fp_recip self-check
+//----------------------------------------------------------------------------
+
+struct unit_check_s {
+    double exp_max_ulp;
+    double recip_max_ulp;
+    uint64_t count;
+};
+
+static void unit_check_one(uint64_t a, int width, unit_check_s& c) {
+    const long double x = fp_to_ld(a, width);
+    if (std::isnan(x) || std::isinf(x)) return;
+    const long double e = (width == 64) ? expl(x) : (long double)exp((double)x);
+    if (ref_is_normal(e, width)) c.exp_max_ulp = std::max(c.exp_max_ulp, ulp_err(c_fp_exp(a, width, RNE), e, width));
+    if (x != 0 && ref_is_normal(x, width)) {
+        const long double r = 1.0L / x;
+        if (ref_is_normal(r, width))
+            c.recip_max_ulp = std::max(c.recip_max_ulp, ulp_err(c_fp_recip(a, width, RNE), r, width));
+    }
+    c.count++;
+}
+
+// Exhaustive for fp16, 'count' random encodings otherwise (half of them
+// with |x| < 2^7 so the exponential is in range)
+static unit_check_s unit_check(int width, int count, uint64_t seed) {
+    unit_check_s c = {0, 0, 0};
+    if (width == 16) {
+        for (uint64_t a = 0; a < 0x10000; a++) unit_check_one(a, width, c);
+        return c;
+    }
+    const fp_fmt_s f = fp_fmt(width);
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + width;
+    for (int i = 0; i < count; i++) {
+        uint64_t a = rand_u64(&state);
+        if (width == 32) a &= 0xFFFFFFFFULL;
+        if (i & 1) {
+            const uint64_t exp = f.bias - 24 + rand_u64(&state) % 31;
+            a = (a & ~(((1ULL << f.exp_w) - 1) << f.mant_w)) | (exp << f.mant_w);
+        }
+        unit_check_one(a, width, c);
+    }
+    return c;
+}
+
+//----------------------------------------------------------------------------
+// Accuracy
+//----------------------------------------------------------------------------
+
+// Sequential two-pass order: max, one running sum, then the same output path
+static void softmax_two_pass(const uint64_t* x, int n, int width, int rm, uint64_t* y) {
+    const uint64_t sign_bit = 1ULL << (width - 1);
+    long double m_val = fp_to_ld(x[0], width);
+    uint64_t m = x[0];
+    for (int i = 1; i < n; i++) {
+        if (fp_to_ld(x[i], width) > m_val) {
+            m = x[i];
+            m_val = fp_to_ld(x[i], width);
+        }
+    }
+    uint64_t d = 0;
+    for (int i = 0; i < n; i++) d = c_fp_add(d, c_fp_exp(c_fp_add(x[i], m ^ sign_bit, width, rm), width, rm), width, rm);
+    const uint64_t r = c_fp_recip(d, width, rm);
+    for (int i = 0; i < n; i++) y[i] = c_fp_mul(c_fp_exp(c_fp_add(x[i], m ^ sign_bit, width, rm), width, rm), r, width, rm);
+}
+
+struct acc_stats_s {
+    double max_ulp;
+    double max_sum_err;
+};
+
+static void accumulate(const uint64_t* x, const uint64_t* y, int n, int width, acc_stats_s& s) {
+    long double m = fp_to_ld(x[0], width);
+    for (int i = 1; i < n; i++) m = std::max(m, fp_to_ld(x[i], width));
+    long double d = 0;
+    for (int i = 0; i < n; i++) d += expl(fp_to_ld(x[i], width) - m);
+    long double sum = 0;
+    for (int i = 0; i < n; i++) {
+        const long double ref = expl(fp_to_ld(x[i], width) - m) / d;
+        if (ref_is_normal(ref, width)) s.max_ulp = std::max(s.max_ulp, ulp_err(y[i], ref, width));
+        sum += fp_to_ld(y[i], width);
+    }
+    s.max_sum_err = std::max(s.max_sum_err, (double)fabsl(sum - 1));
+}
+
+int main(int argc, char** argv) {
+    int width = 0;
+    int len = 0;
+    int rows = 8;
+    double range = 8.0;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--width") && i + 1 < argc) {
+            width = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--len") && i + 1 < argc) {
+            len = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--rows") && i + 1 < argc) {
+            rows = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--range") && i + 1 < argc) {
+            range = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [--width 16|32|64] [--len N] [--rows N] [--range R] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if ((width && width != 16 && width != 32 && width != 64) || len < 0 || rows < 1) {
+        fprintf(stderr, "--width must be 16, 32 or 64, --rows at least 1\n");
+        return 2;
+    }
+
+    std::vector<int> widths;
+    if (width) {
+        widths.push_back(width);
+    } else {
+        widths = {16, 32};
+    }
+    std::vector<int> lens;
+    if (len) {
+        lens.push_back(len);
+    } else {
+        lens.assign(len_list, len_list + sizeof(len_list) / sizeof(len_list[0]));
+    }
+
+    // Self-check of the new units; fp64 fp_exp is bounded by its quadratic
+    // polynomial (about 2^-34 relative), so only fp16 / fp32 are held to 1 ulp
+    bool pass = true;
+    printf("Unit self-check (RNE, outputs normal in the reference)\n\n");
+    printf("%-5s | %-8s | %-12s | %-14s\n", "WIDTH", "INPUTS", "EXP MAX ULP", "RECIP MAX ULP");
+    const int check_widths[] = {16, 32, 64};
+    for (int w : check_widths) {
+        const unit_check_s c = unit_check(w, 200000, seed);
+        printf("%-5d | %-8llu | %-12.3f | %-14.3f\n", w, (unsigned long long)c.count, c.exp_max_ulp,
+               c.recip_max_ulp);
+        if ((w != 64 && c.exp_max_ulp > 1.0) || c.recip_max_ulp > 0.5) pass = false;
+    }
+
+    printf("\nRows of random inputs in [-%g, %g], %d rows per length, back to back\n\n", range, range, rows);
+    printf("%-5s | %-5s | %-8s | %-10s | %-7s | %-6s | %-11s | %-11s | %-12s | %-12s\n", "WIDTH", "LEN", "ELEM/CYC",
+           "STEADY E/C", "LATENCY", "PERIOD", "UNIT MAXULP", "UNIT SUMERR", "2PASS MAXULP", "2PASS SUMERR");
+    for (int w : widths) {
+        for (int n : lens) {
+            uint64_t state = seed * 0x9E3779B97F4A7C15ULL + n;
+            acc_stats_s unit = {0, 0};
+            acc_stats_s two_pass = {0, 0};
+            std::vector<uint64_t> x(n), y(n);
+            for (int r = 0; r < rows; r++) {
+                for (int i = 0; i < n; i++) {
+                    const double u = (double)(rand_u64(&state) >> 11) / (double)(1ULL << 53);
+                    x[i] = fp_from_double((2 * u - 1) * range, w);
+                }
+                fp_softmax_row(x.data(), n, w, RNE, y.data());
+                accumulate(x.data(), y.data(), n, w, unit);
+                softmax_two_pass(x.data(), n, w, RNE, y.data());
+                accumulate(x.data(), y.data(), n, w, two_pass);
+            }
+            const fp_softmax_timing_s t = fp_softmax_timing(std::vector<int>(rows, n), w);
+            printf("%-5d | %-5d | %-8.3f | %-10.3f | %-7llu | %-6llu | %-11.2f | %-11.2e | %-12.2f | %-12.2e\n", w, n,
+                   (double)n * rows / t.cycles, (double)n / t.acc_period, (unsigned long long)t.latency,
+                   (unsigned long long)t.acc_period, unit.max_ulp, unit.max_sum_err, two_pass.max_ulp,
+                   two_pass.max_sum_err);
+        }
+    }
+
+    printf("\n%s : fp_exp within 1 ulp (fp16, fp32), fp_recip correctly rounded\n", pass ? "PASS" : "FAIL");
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,309 @@
+// verif/lib/fp_softmax_model.cpp
+//
+// Bit-accurate reference of fp_softmax.v, fp_exp.v and fp_recip.v
+// (see fp_softmax_model.h).
+//
+
+#include <algorithm>
+
+extern "C" {
+#include "fp_model.h"
+}
+
+#include "fp_softmax_model.h"
+
+typedef unsigned __int128 u128;
+
+struct fp_fmt_s {
+    int exp_w;
+    int bias;
+    int mant_w;
+};
+
+static fp_fmt_s fp_fmt(int width) {
+    if (width == 64) return {11, 1023, 52};
+    if (width == 32) return {8, 127, 23};
+    return {5, 15, 10};
+}
+
+static uint64_t fp_pack(const fp_fmt_s& f, int sign, uint64_t exp, uint64_t frac) {
+    return ((uint64_t)sign << (f.exp_w + f.mant_w)) | (exp << f.mant_w) | frac;
+}
+
+static uint64_t fp_one(const fp_fmt_s& f) { return fp_pack(f, 0, f.bias, 0); }
+
+static uint64_t fp_qnan(const fp_fmt_s& f) {
+    return fp_pack(f, 0, (1ULL << f.exp_w) - 1, 1ULL << (f.mant_w - 1));
+}
+
+static uint64_t fp_neg(const fp_fmt_s& f, uint64_t v) { return v ^ (1ULL << (f.exp_w + f.mant_w)); }
+
+// Sign-magnitude order key of fp_softmax.v (ord_key), x > y <=> key(x) > key(y)
+static uint64_t fp_ord_key(const fp_fmt_s& f, uint64_t v) {
+    const int sign_pos = f.exp_w + f.mant_w;
+    const uint64_t mask = (sign_pos == 63) ? ~0ULL : (2ULL << sign_pos) - 1;
+    return ((v >> sign_pos) & 1) ? ~v & mask : v | (1ULL << sign_pos);
+}
+
+//----------------------------------------------------------------------------
+// fp_exp.v
+//----------------------------------------------------------------------------
+
+// log2(e) * 2^64 (65 bits) and ln(2) * 2^64
+static const u128 LOG2E_64 = ((u128)1 << 64) | 0x71547652B82FE177ULL;
+static const uint64_t LN2_64 = 0xB17217F7D1CF79ABULL;
+
+static int fp_exp_lut_bits(int width) { return (width == 64) ? 10 : (width == 32) ? 8 : 4; }
+
+// Floor square root of a Q2.2p value, bit by bit from bit p (isqrt in fp_exp.v)
+static u128 fp_isqrt(u128 v, int p) {
+    u128 root = 0;
+    for (int b = p; b >= 0; b--) {
+        const u128 trial = root | ((u128)1 << b);
+        if (trial * trial <= v) root = trial;
+    }
+    return root;
+}
+
+// 2^(j / 2^lut_bits) in Q1.p, built in q = p + 4 fraction bits (exp2_frac in fp_exp.v)
+static u128 fp_exp2_frac(int j, int p, int lut_bits) {
+    const int q = p + 4;
+    u128 root = (u128)1 << (q + 1);
+    u128 acc = (u128)1 << q;
+    for (int k = 1; k <= lut_bits; k++) {
+        root = fp_isqrt(root << q, q);
+        if (j & (1 << (lut_bits - k))) acc = (acc * root) >> q;
+    }
+    return (acc + ((u128)1 << (q - p - 1))) >> (q - p);
+}
+
+extern "C" uint64_t c_fp_exp(uint64_t a, const int width, const int rm) {
+    const fp_fmt_s f = fp_fmt(width);
+    const int lut_bits = fp_exp_lut_bits(width);
+    const int p = f.mant_w + 6;
+    const int g = std::min(p + f.exp_w, 64);
+    const int uw = p + f.exp_w + 1;
+    const uint64_t exp_all_ones = (1ULL << f.exp_w) - 1;
+
+    const int sign = (a >> (f.exp_w + f.mant_w)) & 1;
+    const uint64_t exp = (a >> f.mant_w) & exp_all_ones;
+    const uint64_t mant = a & ((1ULL << f.mant_w) - 1);
+
+    // Special cases
+    if (exp == exp_all_ones && mant != 0) return fp_qnan(f);
+    if (exp >= (uint64_t)(f.bias + f.exp_w - 1)) return sign ? 0 : fp_pack(f, 0, exp_all_ones, 0);
+    if (exp == 0) return fp_one(f);
+
+    // Stage 1: |a| * log2(e)
+    const u128 log2e = LOG2E_64 >> (64 - g);
+    const u128 prod = (u128)((1ULL << f.mant_w) | mant) * log2e;
+
+    // Stage 2: u in P fraction bits, u = n + j * 2^-lut_bits + r, t = r * ln(2)
+    const int shift = f.mant_w + g - p + f.bias - (int)exp;
+    const u128 uw_mask = ((u128)1 << uw) - 1;
+    const u128 mag = (shift >= 128) ? 0 : (prod >> shift) & uw_mask;
+    const u128 u = sign ? (-mag) & uw_mask : mag;
+    int64_t n = (int64_t)(u >> p);
+    if (n & (1LL << f.exp_w)) n -= 1LL << (f.exp_w + 1);  // Sign-extend EXP_W+1 bits
+    const uint64_t frac = (uint64_t)(u & (((u128)1 << p) - 1));
+    const int j = (int)(frac >> (p - lut_bits));
+    const uint64_t r = frac & ((1ULL << (p - lut_bits)) - 1);
+    const u128 ln2 = LN2_64 >> (64 - p);
+    const u128 t = ((u128)r * ln2) >> p;
+    const u128 lut = fp_exp2_frac(j, p, lut_bits);
+
+    // Stage 3: 2^f = T[j] * (1 + t + t^2 / 2), round and pack
+    const u128 poly = ((u128)1 << p) + t + ((t * t) >> (p + 1));
+    const u128 prod2 = lut * poly;
+    const uint64_t sig =
+        ((prod2 >> (2 * p + 1)) & 1) ? (2ULL << p) - 1 : (uint64_t)((prod2 >> p) & (((u128)2 << p) - 1));
+
+    const uint64_t rounded = c_grs_rounder(sig, 0, rm, p + 1, f.mant_w + 1, 1);
+    const int overflow = (rounded >> (f.mant_w + 1)) & 1;
+    const int64_t res_exp = n + f.bias + overflow;
+    if (res_exp >= (int64_t)exp_all_ones) return fp_pack(f, 0, exp_all_ones, 0);
+    if (res_exp <= 0) return 0;
+    return fp_pack(f, 0, (uint64_t)res_exp, rounded & ((1ULL << f.mant_w) - 1));
+}
+
+//----------------------------------------------------------------------------
+// fp_recip.v
+//----------------------------------------------------------------------------
+
+int fp_recip_latency(int width) {
+    const fp_fmt_s f = fp_fmt(width);
+    return (f.mant_w + 4 + 3) / 4 + 2;
+}
+
+extern "C" uint64_t c_fp_recip(uint64_t a, const int width, const int rm) {
+    const fp_fmt_s f = fp_fmt(width);
+    const uint64_t exp_all_ones = (1ULL << f.exp_w) - 1;
+    const int div_steps = f.mant_w + 4;
+
+    const int sign = (a >> (f.exp_w + f.mant_w)) & 1;
+    const uint64_t exp = (a >> f.mant_w) & exp_all_ones;
+    const uint64_t mant = a & ((1ULL << f.mant_w) - 1);
+
+    // Special cases (denormals are treated as zero)
+    if (exp == exp_all_ones && mant != 0) return fp_qnan(f);
+    if (exp == exp_all_ones) return fp_pack(f, sign, 0, 0);
+    if (exp == 0) return fp_pack(f, sign, exp_all_ones, 0);
+
+    // Restoring division of 2^(2*MANT_W+3) by 1.m: floor quotient and remainder
+    const uint64_t div = (1ULL << f.mant_w) | mant;
+    const u128 dividend = (u128)1 << (2 * f.mant_w + 3);
+    const uint64_t quo = (uint64_t)(dividend / div);
+    const int sticky = (dividend % div) != 0;
+
+    // Normalize: 2^(MANT_W+3) for 1.0, leading one at MANT_W+2 otherwise
+    const int top = (quo >> (div_steps - 1)) & 1;
+    const uint64_t steps_mask = (1ULL << div_steps) - 1;
+    const uint64_t to_round = top ? (quo | sticky) : (((quo << 1) | sticky) & steps_mask);
+
+    const uint64_t rounded = c_grs_rounder(to_round, sign, rm, div_steps, f.mant_w + 1, 1);
+    const int overflow = (rounded >> (f.mant_w + 1)) & 1;
+    const int64_t res_exp = 2 * f.bias - (int64_t)exp - !top + overflow;
+    if (res_exp >= (int64_t)exp_all_ones) return fp_pack(f, sign, exp_all_ones, 0);
+    if (res_exp <= 0) return fp_pack(f, sign, 0, 0);
+    return fp_pack(f, sign, (uint64_t)res_exp, rounded & ((1ULL << f.mant_w) - 1));
+}
+
+//----------------------------------------------------------------------------
+// fp_softmax.v
+//----------------------------------------------------------------------------
+
+struct fp_softmax_slots_s {
+    uint64_t m[FP_SOFTMAX_SLOTS];
+    uint64_t d[FP_SOFTMAX_SLOTS];
+    bool used[FP_SOFTMAX_SLOTS];
+};
+
+// One issue of the accumulator datapath: value x with weight w into slot s
+static void fp_softmax_update(const fp_fmt_s& f, int width, int rm, fp_softmax_slots_s& sl, int s, uint64_t x,
+                              uint64_t w) {
+    const bool swap = fp_ord_key(f, x) > fp_ord_key(f, sl.m[s]);
+    const uint64_t max = swap ? x : sl.m[s];
+    const uint64_t min = swap ? sl.m[s] : x;
+    const uint64_t e = c_fp_exp(c_fp_add(min, fp_neg(f, max), width, rm), width, rm);
+    const uint64_t prod = c_fp_mul(swap ? sl.d[s] : w, e, width, rm);
+    sl.d[s] = c_fp_add(prod, swap ? w : sl.d[s], width, rm);
+    sl.m[s] = max;
+}
+
+void fp_softmax_row(const uint64_t* x, int n, int width, int rm, uint64_t* y) {
+    const fp_fmt_s f = fp_fmt(width);
+    fp_softmax_slots_s sl = {};
+
+    // 1. Slots
+    for (int i = 0; i < n; i++) {
+        const int s = i % FP_SOFTMAX_SLOTS;
+        if (!sl.used[s]) {
+            sl.m[s] = x[i];
+            sl.d[s] = fp_one(f);
+            sl.used[s] = true;
+        } else {
+            fp_softmax_update(f, width, rm, sl, s, x[i], fp_one(f));
+        }
+    }
+
+    // 2. Pairwise merge
+    for (int half = 1; half < FP_SOFTMAX_SLOTS; half *= 2) {
+        for (int dst = 0; dst + half < FP_SOFTMAX_SLOTS; dst += 2 * half) {
+            if (sl.used[dst + half]) fp_softmax_update(f, width, rm, sl, dst, sl.m[dst + half], sl.d[dst + half]);
+        }
+    }
+
+    // 3. Output
+    const uint64_t r = c_fp_recip(sl.d[0], width, rm);
+    const uint64_t neg_m = fp_neg(f, sl.m[0]);
+    for (int i = 0; i < n; i++) {
+        y[i] = c_fp_mul(c_fp_exp(c_fp_add(x[i], neg_m, width, rm), width, rm), r, width, rm);
+    }
+}
+
+//----------------------------------------------------------------------------
+// Cycle model
+//----------------------------------------------------------------------------
+
+// Cycles from issue to the updated sum (ACC_AT) and from buffer read to output (OUT_AT)
+static const int64_t ACC_AT = 1 + FP_SOFTMAX_LAT_ADD + FP_SOFTMAX_LAT_EXP + FP_SOFTMAX_LAT_MUL + FP_SOFTMAX_LAT_ADD;
+static const int64_t OUT_AT = 1 + FP_SOFTMAX_LAT_ADD + FP_SOFTMAX_LAT_EXP + FP_SOFTMAX_LAT_MUL;
+
+// A_WAIT entered at cycle 'at' leaves once the last issue has left the
+// pipeline; returns the first cycle of the next state
+static int64_t fp_softmax_drain(int64_t at, int64_t last_issue) {
+    return std::max(at, last_issue + ACC_AT + 1) + 1;
+}
+
+fp_softmax_timing_s fp_softmax_timing(const std::vector<int>& lens, int width) {
+    const int64_t lat_recip = fp_recip_latency(width);
+    fp_softmax_timing_s t = {};
+
+    int64_t acc_free = 0;          // First cycle of A_FILL for the next row
+    int64_t job_free = 0;          // First cycle the hand-off register is empty
+    int64_t norm_free = 0;         // First cycle of N_IDLE
+    int64_t buf_free[2] = {0, 0};  // First cycle the row buffer is free
+    int64_t last_out = 0;
+
+    for (size_t k = 0; k < lens.size(); k++) {
+        const int64_t n = lens[k];
+        const int used = (int)std::min<int64_t>(n, FP_SOFTMAX_SLOTS);
+
+        // Accumulator: fill, then the merge rounds, each behind a pipeline drain
+        const int64_t fill = std::max(acc_free, buf_free[k % 2]);
+        int64_t last_issue = (n > FP_SOFTMAX_SLOTS) ? fill + n - 1 : -ACC_AT - 1;
+        int64_t state = fp_softmax_drain(fill + n, last_issue);
+        for (int half = 1; half < FP_SOFTMAX_SLOTS; half *= 2) {
+            const int cnt = FP_SOFTMAX_SLOTS / (2 * half);
+            for (int idx = 0; idx < cnt; idx++) {
+                if (idx * 2 * half + half < used) last_issue = state + idx;
+            }
+            state = fp_softmax_drain(state + cnt, last_issue);
+        }
+        const int64_t give = std::max(state, job_free);
+        acc_free = give + 1;
+        t.acc_period = acc_free - fill;
+
+        // Normalizer: take, reciprocal, output stream, flush
+        const int64_t take = std::max(give + 1, norm_free);
+        job_free = take + 1;
+        const int64_t first_read = take + 2 + lat_recip;
+        const int64_t last_read = first_read + n - 1;
+        buf_free[k % 2] = last_read + 1;
+        norm_free = last_read + OUT_AT + 2;
+        last_out = last_read + OUT_AT;
+
+        if (k == 0) t.latency = last_out + 1;
+    }
+    t.cycles = last_out + 1;
+    return t;
+}
+
+//----------------------------------------------------------------------------
+// DPI-C API
+//----------------------------------------------------------------------------
+
+static int dpi_width = 16;
+static int dpi_rm = RNE;
+static std::vector<uint64_t> dpi_x;
+static std::vector<uint64_t> dpi_y;
+
+extern "C" void c_fp_softmax_reset(const int width, const int rm) {
+    dpi_width = width;
+    dpi_rm = rm;
+    dpi_x.clear();
+    dpi_y.clear();
+}
+
+extern "C" void c_fp_softmax_push(uint64_t x) { dpi_x.push_back(x); }
+
+extern "C" int c_fp_softmax_finish() {
+    dpi_y.assign(dpi_x.size(), 0);
+    if (!dpi_x.empty()) fp_softmax_row(dpi_x.data(), (int)dpi_x.size(), dpi_width, dpi_rm, dpi_y.data());
+    dpi_x.clear();
+    return (int)dpi_y.size();
+}
+
+extern "C" uint64_t c_fp_softmax_result(const int i) {
+    return (i >= 0 && i < (int)dpi_y.size()) ? dpi_y[i] : 0;
+}
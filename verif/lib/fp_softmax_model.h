@@ -0,0 +1,68 @@
+// verif/lib/fp_softmax_model.h
+//
+// Bit-accurate reference of the streaming softmax unit (rtl/verilog/fp/fp_softmax.v)
+// and of the blocks it adds to the library, fp_exp.v and fp_recip.v, built on
+// the fp_add / fp_mul models (fp_model.c).
+//
+// Accumulation order of fp_softmax_row (the RTL order, one exponential per element):
+//   1. Element i goes to slot i % FP_SOFTMAX_SLOTS. The first element of a
+//      slot sets m = x, d = 1.0; every other element x updates the slot:
+//        e = c_fp_exp(c_fp_add(min(x, m), -max(x, m)))
+//        x >  m: d = c_fp_add(c_fp_mul(d, e), 1.0), m = x
+//        x <= m: d = c_fp_add(c_fp_mul(1.0, e), d)
+//      (x > m in sign-magnitude order, -0 < +0).
+//   2. The slots are merged pairwise in ROUNDS = log2(SLOTS) rounds: round r
+//      updates slot k with (x, weight) = (m[k + 2^r], d[k + 2^r]) for
+//      k = 0, 2^(r+1), ..., the same update with the weight in place of 1.0.
+//   3. y[i] = c_fp_mul(c_fp_exp(c_fp_add(x[i], -m[0])), c_fp_recip(d[0])).
+// The slot count is the fp_mul + fp_add latency, so the RTL takes one element
+// per cycle; the order does not depend on the timing.
+//
+// fp_softmax_timing replays the cycle behaviour of the unit for a sequence of
+// rows streamed back to back (in_valid always high): accumulator, pairwise
+// merge rounds with pipeline drains, hand-off, reciprocal and output stream,
+// and the two row buffers that let one row stream in while the previous one
+// streams out.
+//
+// Used natively by fp_softmax_bench.cpp and from the softmax testbench through
+// DPI-C (c_fp_softmax_*).
+//
+
+#ifndef FP_SOFTMAX_MODEL_H
+#define FP_SOFTMAX_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+// Accumulator slots (fp_mul + fp_add latency) and unit latencies of fp_softmax.v
+#define FP_SOFTMAX_SLOTS   8
+#define FP_SOFTMAX_LAT_ADD 4
+#define FP_SOFTMAX_LAT_MUL 4
+#define FP_SOFTMAX_LAT_EXP 3
+
+struct fp_softmax_timing_s {
+    uint64_t cycles;      // First input to last output of all rows
+    uint64_t latency;     // First input to last output of the first row
+    uint64_t acc_period;  // Cycles the accumulator spends on the last row
+};
+
+// Bit-accurate models of fp_exp.v and fp_recip.v (WIDTH 16, 32, 64)
+extern "C" uint64_t c_fp_exp(uint64_t a, const int width, const int rm);
+extern "C" uint64_t c_fp_recip(uint64_t a, const int width, const int rm);
+
+// Latency of fp_recip.v (STEPS_PER_STAGE = 4)
+int fp_recip_latency(int width);
+
+// Softmax of one row of n >= 1 elements in the accumulation order above
+void fp_softmax_row(const uint64_t* x, int n, int width, int rm, uint64_t* y);
+
+// Cycles of fp_softmax.v for rows of the given lengths, streamed back to back
+fp_softmax_timing_s fp_softmax_timing(const std::vector<int>& lens, int width);
+
+// DPI-C API: push a row element by element, then read the results
+extern "C" void     c_fp_softmax_reset(const int width, const int rm);
+extern "C" void     c_fp_softmax_push(uint64_t x);
+extern "C" int      c_fp_softmax_finish();
+extern "C" uint64_t c_fp_softmax_result(const int i);
+
+#endif // FP_SOFTMAX_MODEL_H
@@ -0,0 +1,341 @@
+// verif/lib/fp_sort_bench.cpp
+//
+// Native self-check and benchmark of the floating-point comparator, sorting
+// network and streaming top-k unit (fp_cmp.v, fp_sort.v, fp_topk.v;
+// reference model in fp_sort_model.cpp).
+//
+// Self-checks, for fp16 / fp32 / fp64:
+//   cmp    - fp_cmp against the host float / double comparison (fp16 widened
+//            to float): lt / eq / gt / unord, minimumNumber / maximumNumber,
+//            and totalOrder against its sign-magnitude definition;
+//   sort   - the network (scalar and SIMD) against std::sort with the same
+//            order, both directions, N = 2 .. 256;
+//   topk   - the streaming top-k against a partial sort of the whole row,
+//            rows of 1 .. 16 vectors.
+// Elements are random encodings with many duplicates, zeros of both signs,
+// infinities and NaNs.
+//
+// Then the benchmark: vectors per second of the scalar network, the SIMD
+// network and std::sort for fp32 vectors, next to the RTL layers,
+// compare-exchanges and latency.
+//
+// Build and run (see native.mk):
+//   make -f native.mk sort
+//   build/native/fp_sort_bench [--width 16|32|64] [--n N] [--k K] [--count N] [--seed N]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "fp_sort_model.h"
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static const int n_list[] = {2, 4, 8, 16, 32, 64, 128, 256};
+
+static int exp_w_of(int width) {
+    return (width == 64) ? 11 : (width == 32) ? 8 : 5;
+}
+
+static uint64_t mask_of(int width) {
+    return (width >= 64) ? ~0ULL : (1ULL << width) - 1;
+}
+
+// Random encoding: one in eight a special value, exponents near 1.0 and few
+// mantissa bits otherwise, so that vectors hold duplicates
+static uint64_t rand_element(uint64_t* state, int width) {
+    const int exp_w = exp_w_of(width);
+    const int mant_w = width - 1 - exp_w;
+    const uint64_t exp_all = (1ULL << exp_w) - 1;
+    const uint64_t r = rand_u64(state);
+    const uint64_t sign = (r & 1) << (width - 1);
+    switch ((r >> 1) & 15) {
+        case 0: return sign;                                                      // Zero
+        case 1: return sign | (exp_all << mant_w);                                // Infinity
+        case 2: return sign | (exp_all << mant_w) | ((r >> 8) & ((1ULL << mant_w) - 1)) | 1;  // NaN
+        case 3: return sign | ((r >> 8) & 3);                                     // Denormal
+        default: break;
+    }
+    const uint64_t exp = (exp_all >> 1) + ((r >> 8) % 9) - 4;
+    const uint64_t mant = ((r >> 16) & 7) << (mant_w - 3);
+    return sign | (exp << mant_w) | mant;
+}
+
+//----------------------------------------------------------------------------
+// cmp self-check
+//----------------------------------------------------------------------------
+
+static double to_double(uint64_t x, int width) {
+    if (width == 64) {
+        double d;
+        memcpy(&d, &x, sizeof(d));
+        return d;
+    }
+    if (width == 32) {
+        const uint32_t u = (uint32_t)x;
+        float f;
+        memcpy(&f, &u, sizeof(f));
+        return f;
+    }
+    // fp16, exact in double
+    const int sign = (x >> 15) & 1;
+    const int exp = (x >> 10) & 31;
+    const int mant = x & 1023;
+    double m;
+    if (exp == 31) {
+        m = mant ? NAN : INFINITY;
+    } else if (exp == 0) {
+        m = ldexp(mant, -24);
+    } else {
+        m = ldexp(1024 + mant, exp - 25);
+    }
+    return sign ? -m : m;
+}
+
+static long check_cmp(int width, long count, uint64_t seed) {
+    const int mant_w = width - 1 - exp_w_of(width);
+    const uint64_t qnan = (((1ULL << exp_w_of(width)) - 1) << mant_w) | (1ULL << (mant_w - 1));
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + width;
+    long mismatches = 0;
+    for (long i = 0; i < count; i++) {
+        const uint64_t a = rand_element(&state, width);
+        const uint64_t b = (rand_u64(&state) & 7) ? rand_element(&state, width) : a;
+        const double x = to_double(a, width), y = to_double(b, width);
+        const fp_cmp_s r = fp_cmp(a, b, width);
+
+        // IEEE comparison by the host
+        bool ok = r.lt == (x < y) && r.eq == (x == y) && r.gt == (x > y) && r.unord == (std::isnan(x) || std::isnan(y));
+
+        // minimumNumber / maximumNumber
+        uint64_t mn, mx;
+        if (std::isnan(x) && std::isnan(y)) {
+            mn = mx = qnan;
+        } else if (std::isnan(x)) {
+            mn = mx = b;
+        } else if (std::isnan(y)) {
+            mn = mx = a;
+        } else if (x == y) {
+            mn = std::signbit(x) ? a : b;  // -0 < +0, identical otherwise
+            mx = std::signbit(x) ? b : a;
+        } else {
+            mn = (x < y) ? a : b;
+            mx = (x < y) ? b : a;
+        }
+        ok = ok && r.min == mn && r.max == mx;
+
+        // totalOrder: sign first, then magnitude (reversed for negatives)
+        const int sa = (a >> (width - 1)) & 1, sb = (b >> (width - 1)) & 1;
+        const uint64_t ma = a & mask_of(width - 1), mb = b & mask_of(width - 1);
+        const int total = (sa != sb) ? sa : sa ? (ma >= mb) : (ma <= mb);
+        ok = ok && r.total_order == total;
+
+        if (!ok) {
+            if (mismatches < 5)
+                printf("  fp%d cmp %llx %llx: lt %d eq %d gt %d unord %d min %llx max %llx total %d\n", width,
+                       (unsigned long long)a, (unsigned long long)b, r.lt, r.eq, r.gt, r.unord,
+                       (unsigned long long)r.min, (unsigned long long)r.max, r.total_order);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+//----------------------------------------------------------------------------
+// sort / topk self-checks
+//----------------------------------------------------------------------------
+
+struct elem_s {
+    uint64_t data;
+    uint32_t idx;
+};
+
+static void reference_sort(std::vector<elem_s>& e, int width, int descending) {
+    std::sort(e.begin(), e.end(), [&](const elem_s& x, const elem_s& y) {
+        const uint64_t kx = fp_total_order_key(x.data, width), ky = fp_total_order_key(y.data, width);
+        if (kx != ky) return descending ? kx > ky : kx < ky;
+        return x.idx < y.idx;
+    });
+}
+
+static long check_sort(int width, int n, long vectors, uint64_t seed) {
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + width * 1000 + n;
+    std::vector<uint64_t> x(n), out(n), out_simd(n);
+    std::vector<uint32_t> idx(n), idx_simd(n);
+    std::vector<elem_s> e(n);
+    long mismatches = 0;
+    for (long v = 0; v < vectors; v++) {
+        const int descending = (int)(v & 1);
+        for (int i = 0; i < n; i++) {
+            x[i] = rand_element(&state, width);
+            e[i] = {x[i], (uint32_t)i};
+        }
+        reference_sort(e, width, descending);
+        fp_sort_network(x.data(), n, width, descending, out.data(), idx.data());
+        fp_sort_network_simd(x.data(), n, width, descending, out_simd.data(), idx_simd.data());
+        for (int r = 0; r < n; r++) {
+            if (out[r] != e[r].data || idx[r] != e[r].idx || out_simd[r] != e[r].data || idx_simd[r] != e[r].idx) {
+                if (mismatches < 5)
+                    printf("  fp%d sort n %d rank %d: network %llx@%u, simd %llx@%u, expected %llx@%u\n", width, n, r,
+                           (unsigned long long)out[r], idx[r], (unsigned long long)out_simd[r], idx_simd[r],
+                           (unsigned long long)e[r].data, e[r].idx);
+                mismatches++;
+                break;
+            }
+        }
+    }
+    return mismatches;
+}
+
+static long check_topk(int width, int n, int k, long rows, uint64_t seed) {
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + width * 1000 + n * 10 + k;
+    fp_topk_s t;
+    std::vector<uint64_t> x(n), out(k);
+    std::vector<uint32_t> idx(k);
+    long mismatches = 0;
+    for (long row = 0; row < rows; row++) {
+        const int descending = (int)(row & 1);
+        const int vectors = 1 + (int)(rand_u64(&state) % 16);
+        std::vector<elem_s> e;
+        fp_topk_reset(t, width, n, k, descending, 16);
+        int done = 0;
+        for (int v = 0; v < vectors; v++) {
+            for (int i = 0; i < n; i++) {
+                x[i] = rand_element(&state, width);
+                e.push_back({x[i], (uint32_t)(v * n + i)});
+            }
+            done = fp_topk_push(t, x.data(), v == vectors - 1, out.data(), idx.data());
+        }
+        reference_sort(e, width, descending);
+        bool ok = done == 1;
+        for (int r = 0; ok && r < k; r++) ok = out[r] == e[r].data && idx[r] == e[r].idx;
+        if (!ok) {
+            if (mismatches < 5) printf("  fp%d topk n %d k %d: row %ld differs\n", width, n, k, row);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+//----------------------------------------------------------------------------
+// Benchmark
+//----------------------------------------------------------------------------
+
+static double vectors_per_s(int method, int n, long vectors, uint64_t seed) {
+    uint64_t state = seed;
+    std::vector<uint64_t> x((size_t)n * 64), out(n);
+    std::vector<uint32_t> idx(n);
+    std::vector<elem_s> e(n);
+    for (auto& v : x) v = rand_element(&state, 32);
+    uint64_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (long v = 0; v < vectors; v++) {
+        const uint64_t* in = &x[(size_t)(v & 63) * n];
+        if (method == 0) {
+            fp_sort_network(in, n, 32, 1, out.data(), idx.data());
+        } else if (method == 1) {
+            fp_sort_network_simd(in, n, 32, 1, out.data(), idx.data());
+        } else {
+            for (int i = 0; i < n; i++) e[i] = {in[i], (uint32_t)i};
+            reference_sort(e, 32, 1);
+            out[0] = e[0].data;
+        }
+        sink += out[0];
+    }
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (sink == 1) printf(" ");  // Keep the work
+    return s > 0 ? vectors / s : 0.0;
+}
+
+int main(int argc, char** argv) {
+    int width = 0;
+    int n_one = 0;
+    int k = 4;
+    long count = 20000;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--width") && i + 1 < argc) {
+            width = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--n") && i + 1 < argc) {
+            n_one = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--k") && i + 1 < argc) {
+            k = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+            count = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [--width 16|32|64] [--n N] [--k K] [--count N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    const bool n_pow2 = n_one >= 0 && (n_one & (n_one - 1)) == 0;
+    if ((width && width != 16 && width != 32 && width != 64) || !n_pow2 || n_one == 1 || k < 1 || (k & (k - 1)) ||
+        count < 1) {
+        fprintf(stderr, "--width must be 16, 32 or 64, --n and --k powers of two (n >= 2), --count at least 1\n");
+        return 2;
+    }
+
+    std::vector<int> widths;
+    if (width) {
+        widths.push_back(width);
+    } else {
+        widths = {16, 32, 64};
+    }
+    std::vector<int> ns;
+    if (n_one) {
+        ns.push_back(n_one);
+    } else {
+        ns.assign(n_list, n_list + sizeof(n_list) / sizeof(n_list[0]));
+    }
+
+    long total_mismatches = 0;
+    printf("%-5s | %-26s | %-10s | %s\n", "WIDTH", "CHECK", "COUNT", "MISMATCHES");
+    for (int w : widths) {
+        const long m = check_cmp(w, count * 10, seed);
+        printf("%-5d | %-26s | %-10ld | %ld\n", w, "cmp", count * 10, m);
+        total_mismatches += m;
+        for (int n : ns) {
+            const long vectors = std::max(1L, count / n);
+            const long ms = check_sort(w, n, vectors, seed);
+            char name[64];
+            snprintf(name, sizeof(name), "sort n %d", n);
+            printf("%-5d | %-26s | %-10ld | %ld\n", w, name, vectors, ms);
+            total_mismatches += ms;
+            if (k <= n) {
+                const long rows = std::max(1L, count / (8 * n));
+                const long mt = check_topk(w, n, k, rows, seed);
+                snprintf(name, sizeof(name), "topk n %d k %d (rows)", n, k);
+                printf("%-5d | %-26s | %-10ld | %ld\n", w, name, rows, mt);
+                total_mismatches += mt;
+            }
+        }
+    }
+
+    printf("\nfp32 vectors per second (one thread), RTL: one vector per cycle\n\n");
+    printf("%-5s | %-6s | %-6s | %-8s | %-12s | %-12s | %-12s\n", "N", "LAYERS", "CX", "LATENCY", "SCALAR", "SIMD",
+           "STD::SORT");
+    for (int n : ns) {
+        const int log_n = __builtin_ctz(n);
+        const int layers = log_n * (log_n + 1) / 2;
+        const long vectors = std::max(1000L, 20000000L / (n * std::max(1, layers)));
+        printf("%-5d | %-6d | %-6d | %-8d | %-12.3g | %-12.3g | %-12.3g\n", n, layers, layers * n / 2,
+               fp_sort_latency(n, 1), vectors_per_s(0, n, vectors, seed), vectors_per_s(1, n, vectors, seed),
+               vectors_per_s(2, n, vectors, seed));
+    }
+
+    printf("\n%s : fp_cmp, sorting network and streaming top-k match the references\n",
+           total_mismatches ? "FAIL" : "PASS");
+    return total_mismatches ? 1 : 0;
+}
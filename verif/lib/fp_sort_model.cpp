@@ -0,0 +1,279 @@
+// verif/lib/fp_sort_model.cpp
+//
+// Reference of the comparator, sorting network and streaming top-k unit.
+// See fp_sort_model.h.
+//
+
+#include "fp_sort_model.h"
+
+#include <algorithm>
+#include <cstring>
+
+static int fp_exp_w(int width) {
+    return (width == 64) ? 11 : (width == 32) ? 8 : 5;
+}
+
+static uint64_t width_mask(int width) {
+    return (width >= 64) ? ~0ULL : (1ULL << width) - 1;
+}
+
+static int log2_int(int n) {
+    int l = 0;
+    while ((1 << l) < n) l++;
+    return l;
+}
+
+//----------------------------------------------------------------------------
+// fp_cmp
+//----------------------------------------------------------------------------
+
+uint64_t fp_total_order_key(uint64_t x, int width) {
+    const uint64_t sign = 1ULL << (width - 1);
+    x &= width_mask(width);
+    return (x & sign) ? (~x & width_mask(width)) : (x | sign);
+}
+
+fp_cmp_s fp_cmp(uint64_t a, uint64_t b, int width) {
+    const int mant_w = width - 1 - fp_exp_w(width);
+    const uint64_t exp_mask = (1ULL << fp_exp_w(width)) - 1;
+    const uint64_t mant_mask = (1ULL << mant_w) - 1;
+    const uint64_t qnan = (exp_mask << mant_w) | (1ULL << (mant_w - 1));
+    a &= width_mask(width);
+    b &= width_mask(width);
+
+    const int nan_a = ((a >> mant_w) & exp_mask) == exp_mask && (a & mant_mask);
+    const int nan_b = ((b >> mant_w) & exp_mask) == exp_mask && (b & mant_mask);
+    const int zero_a = (a & width_mask(width - 1)) == 0;
+    const int zero_b = (b & width_mask(width - 1)) == 0;
+    const uint64_t key_a = fp_total_order_key(a, width);
+    const uint64_t key_b = fp_total_order_key(b, width);
+
+    fp_cmp_s r;
+    r.total_order = key_a <= key_b;
+    r.unord = nan_a || nan_b;
+    r.eq = !r.unord && (a == b || (zero_a && zero_b));
+    r.lt = !r.unord && !r.eq && key_a < key_b;
+    r.gt = !r.unord && !r.eq && !(key_a < key_b);
+    if (nan_a && nan_b) {
+        r.min = r.max = qnan;
+    } else if (nan_a) {
+        r.min = r.max = b;
+    } else if (nan_b) {
+        r.min = r.max = a;
+    } else {
+        r.min = (key_a < key_b) ? a : b;
+        r.max = (key_a < key_b) ? b : a;
+    }
+    return r;
+}
+
+int fp_sort_latency(int n, int layers_per_stage) {
+    const int log_n = log2_int(n);
+    const int layers = log_n * (log_n + 1) / 2;
+    return (layers + layers_per_stage - 1) / layers_per_stage;
+}
+
+int fp_topk_latency(int n, int layers_per_stage) {
+    return fp_sort_latency(n, layers_per_stage) + 1;
+}
+
+//----------------------------------------------------------------------------
+// Sorting network
+//----------------------------------------------------------------------------
+
+// fp_sort_cx: does (x, x_idx) come first?
+static bool cx_first(uint64_t x, uint32_t x_idx, uint64_t y, uint32_t y_idx, int width, int descending) {
+    if (x == y) return x_idx < y_idx;
+    const bool x_le_y = fp_total_order_key(x, width) <= fp_total_order_key(y, width);
+    return descending ? !x_le_y : x_le_y;
+}
+
+void fp_sort_network(const uint64_t* x, int n, int width, int descending, uint64_t* out, uint32_t* idx) {
+    const int log_n = log2_int(n);
+    for (int i = 0; i < n; i++) {
+        out[i] = x[i] & width_mask(width);
+        idx[i] = i;
+    }
+    for (int p = 0; p < log_n; p++) {
+        for (int r = 0; r <= p; r++) {
+            const int dist = 1 << (p - r);
+            for (int i = 0; i < n; i++) {
+                if (i & dist) continue;
+                const int l = i + dist;
+                const bool up = (i & (2 << p)) == 0;
+                const bool x_first = cx_first(out[i], idx[i], out[l], idx[l], width, descending);
+                if (x_first != up) {
+                    std::swap(out[i], out[l]);
+                    std::swap(idx[i], idx[l]);
+                }
+            }
+        }
+    }
+}
+
+typedef uint64_t v4u64 __attribute__((vector_size(32)));
+
+void fp_sort_network_simd(const uint64_t* x, int n, int width, int descending, uint64_t* out, uint32_t* idx) {
+    const int log_n = log2_int(n);
+    const int idx_bits = log_n ? log_n : 1;
+    if (width + idx_bits > 64) {
+        fp_sort_network(x, n, width, descending, out, idx);
+        return;
+    }
+
+    // Packed word: rank key (ascending in the sort order) above the position,
+    // so the sort order is the unsigned order of the words
+    const uint64_t mask = width_mask(width);
+    std::vector<uint64_t> w(n);
+    for (int i = 0; i < n; i++) {
+        const uint64_t key = fp_total_order_key(x[i], width);
+        w[i] = ((descending ? ~key & mask : key) << idx_bits) | (uint64_t)i;
+    }
+
+    uint64_t* v = w.data();
+    for (int p = 0; p < log_n; p++) {
+        for (int r = 0; r <= p; r++) {
+            const int dist = 1 << (p - r);
+            for (int i0 = 0; i0 < n; i0 += 2 * dist) {
+                const bool up = (i0 & (2 << p)) == 0;
+                uint64_t* lo = v + i0;
+                uint64_t* hi = v + i0 + dist;
+                int t = 0;
+                for (; t + 4 <= dist; t += 4) {
+                    v4u64 a, b;
+                    memcpy(&a, lo + t, sizeof(a));
+                    memcpy(&b, hi + t, sizeof(b));
+                    const v4u64 m = (v4u64)(a < b);
+                    const v4u64 mn = (a & m) | (b & ~m);
+                    const v4u64 mx = (b & m) | (a & ~m);
+                    memcpy(lo + t, up ? &mn : &mx, sizeof(a));
+                    memcpy(hi + t, up ? &mx : &mn, sizeof(b));
+                }
+                for (; t < dist; t++) {
+                    const uint64_t a = lo[t], b = hi[t];
+                    const uint64_t mn = a < b ? a : b;
+                    const uint64_t mx = a < b ? b : a;
+                    lo[t] = up ? mn : mx;
+                    hi[t] = up ? mx : mn;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        idx[i] = (uint32_t)(v[i] & ((1ULL << idx_bits) - 1));
+        out[i] = x[idx[i]] & mask;
+    }
+}
+
+//----------------------------------------------------------------------------
+// Streaming top-k
+//----------------------------------------------------------------------------
+
+void fp_topk_reset(fp_topk_s& t, int width, int n, int k, int descending, int idx_w) {
+    t.width = width;
+    t.n = n;
+    t.k = k;
+    t.descending = descending;
+    t.idx_w = idx_w;
+    t.row_first = 1;
+    t.vec_base = 0;
+    t.run_data.assign(k, 0);
+    t.run_idx.assign(k, 0);
+}
+
+int fp_topk_push(fp_topk_s& t, const uint64_t* x, int last, uint64_t* out, uint32_t* idx) {
+    const uint32_t pos_mask = (t.idx_w >= 32) ? ~0U : (1U << t.idx_w) - 1;
+    std::vector<uint64_t> sorted(t.n);
+    std::vector<uint32_t> sorted_idx(t.n);
+    fp_sort_network_simd(x, t.n, t.width, t.descending, sorted.data(), sorted_idx.data());
+
+    // Top-k of the vector with row positions
+    std::vector<uint64_t> top(sorted.begin(), sorted.begin() + t.k);
+    std::vector<uint32_t> top_idx(t.k);
+    for (int i = 0; i < t.k; i++) top_idx[i] = (t.vec_base | sorted_idx[i]) & pos_mask;
+
+    if (t.row_first) {
+        t.run_data = top;
+        t.run_idx = top_idx;
+    } else {
+        // Better of run[i] and top[k-1-i]: bitonic; then the bitonic merger
+        std::vector<uint64_t> m(t.k);
+        std::vector<uint32_t> m_idx(t.k);
+        for (int i = 0; i < t.k; i++) {
+            const int j = t.k - 1 - i;
+            const bool run_first =
+                cx_first(t.run_data[i], t.run_idx[i], top[j], top_idx[j], t.width, t.descending);
+            m[i] = run_first ? t.run_data[i] : top[j];
+            m_idx[i] = run_first ? t.run_idx[i] : top_idx[j];
+        }
+        for (int dist = t.k / 2; dist >= 1; dist /= 2) {
+            for (int i = 0; i < t.k; i++) {
+                if (i & dist) continue;
+                if (!cx_first(m[i], m_idx[i], m[i + dist], m_idx[i + dist], t.width, t.descending)) {
+                    std::swap(m[i], m[i + dist]);
+                    std::swap(m_idx[i], m_idx[i + dist]);
+                }
+            }
+        }
+        t.run_data = m;
+        t.run_idx = m_idx;
+    }
+
+    t.row_first = last;
+    t.vec_base = last ? 0 : (t.vec_base + t.n) & pos_mask;
+    if (!last) return 0;
+    for (int i = 0; i < t.k; i++) {
+        out[i] = t.run_data[i];
+        idx[i] = t.run_idx[i];
+    }
+    return 1;
+}
+
+//----------------------------------------------------------------------------
+// DPI-C API
+//----------------------------------------------------------------------------
+
+static fp_topk_s dpi_topk;
+static std::vector<uint64_t> dpi_vec;
+static std::vector<uint64_t> dpi_out_data;
+static std::vector<uint32_t> dpi_out_idx;
+
+extern "C" int c_fp_cmp(uint64_t a, uint64_t b, const int width) {
+    const fp_cmp_s r = fp_cmp(a, b, width);
+    return (r.total_order << 4) | (r.unord << 3) | (r.gt << 2) | (r.eq << 1) | r.lt;
+}
+
+extern "C" uint64_t c_fp_cmp_min(uint64_t a, uint64_t b, const int width) {
+    return fp_cmp(a, b, width).min;
+}
+
+extern "C" uint64_t c_fp_cmp_max(uint64_t a, uint64_t b, const int width) {
+    return fp_cmp(a, b, width).max;
+}
+
+extern "C" void c_fp_topk_reset(const int width, const int n, const int k, const int descending, const int idx_w) {
+    fp_topk_reset(dpi_topk, width, n, k, descending, idx_w);
+    dpi_vec.clear();
+    dpi_out_data.assign(k, 0);
+    dpi_out_idx.assign(k, 0);
+}
+
+extern "C" void c_fp_topk_element(uint64_t x) {
+    dpi_vec.push_back(x);
+}
+
+extern "C" int c_fp_topk_vector(const int last) {
+    dpi_vec.resize(dpi_topk.n, 0);
+    const int done = fp_topk_push(dpi_topk, dpi_vec.data(), last, dpi_out_data.data(), dpi_out_idx.data());
+    dpi_vec.clear();
+    return done;
+}
+
+extern "C" uint64_t c_fp_topk_data(const int rank) {
+    return dpi_out_data[rank];
+}
+
+extern "C" int c_fp_topk_idx(const int rank) {
+    return (int)dpi_out_idx[rank];
+}
@@ -0,0 +1,79 @@
+// verif/lib/fp_sort_model.h
+//
+// Bit-accurate reference of the floating-point comparator (fp_cmp.v), the
+// bitonic sorting network (fp_sort.v, fp_sort_cx.v) and the streaming top-k
+// unit (fp_topk.v).
+//
+// Sort order: IEEE totalOrder, descending or ascending, identical encodings
+// by position (smaller first). The order is total, so a sort has exactly one
+// result; the network reference follows the RTL layer by layer anyway.
+//
+// Used natively by fp_sort_bench.cpp and from the fp_topk testbench through
+// DPI-C (c_fp_cmp*, c_fp_topk_*).
+//
+
+#ifndef FP_SORT_MODEL_H
+#define FP_SORT_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+// fp_cmp outputs
+struct fp_cmp_s {
+    int lt;
+    int eq;
+    int gt;
+    int unord;
+    uint64_t min;      // minimumNumber
+    uint64_t max;      // maximumNumber
+    int total_order;   // totalOrder(a, b)
+};
+
+fp_cmp_s fp_cmp(uint64_t a, uint64_t b, int width);
+
+// Unsigned key with key(a) <= key(b) exactly when totalOrder(a, b)
+uint64_t fp_total_order_key(uint64_t x, int width);
+
+// Pipeline latencies
+int fp_sort_latency(int n, int layers_per_stage);
+int fp_topk_latency(int n, int layers_per_stage);
+
+// Sorts the n (power of two) elements of x with the fp_sort network: out[r]
+// is the element of rank r, idx[r] its position in x.
+void fp_sort_network(const uint64_t* x, int n, int width, int descending, uint64_t* out, uint32_t* idx);
+
+// Same network on packed 64-bit words (order key above the position) with
+// GCC vector extensions, four compare-exchanges per instruction where the
+// partner distance allows it. Falls back to fp_sort_network() when the key
+// and the position do not fit in 64 bits (fp64).
+void fp_sort_network_simd(const uint64_t* x, int n, int width, int descending, uint64_t* out, uint32_t* idx);
+
+// Streaming top-k (fp_topk.v): push the vectors of a row, the last one with
+// last = 1, which returns the top-k of the row.
+struct fp_topk_s {
+    int width;
+    int n;
+    int k;
+    int descending;
+    int idx_w;
+    int row_first;
+    uint32_t vec_base;
+    std::vector<uint64_t> run_data;
+    std::vector<uint32_t> run_idx;
+};
+
+void fp_topk_reset(fp_topk_s& t, int width, int n, int k, int descending, int idx_w);
+// Returns 1 after the last vector of a row, with the top-k in out / idx
+int fp_topk_push(fp_topk_s& t, const uint64_t* x, int last, uint64_t* out, uint32_t* idx);
+
+// DPI-C API
+extern "C" int      c_fp_cmp(uint64_t a, uint64_t b, const int width);  // {total_order, unord, gt, eq, lt}
+extern "C" uint64_t c_fp_cmp_min(uint64_t a, uint64_t b, const int width);
+extern "C" uint64_t c_fp_cmp_max(uint64_t a, uint64_t b, const int width);
+extern "C" void     c_fp_topk_reset(const int width, const int n, const int k, const int descending, const int idx_w);
+extern "C" void     c_fp_topk_element(uint64_t x);       // Next element of the current vector
+extern "C" int      c_fp_topk_vector(const int last);    // Ends the vector, 1 if it ended a row
+extern "C" uint64_t c_fp_topk_data(const int rank);      // Top-k of the last row
+extern "C" int      c_fp_topk_idx(const int rank);
+
+#endif // FP_SORT_MODEL_H
@@ -26,6 +26,49 @@ class fp_transaction #(
         rm inside {`RNE, `RTZ, `RPI, `RNI, `RNA};
     }
 
+    localparam int IN_EXP_W  = fp_lib_pkg::get_exp_width(INPUT_WIDTH);
+    localparam int IN_MANT_W = fp_lib_pkg::get_mant_width(INPUT_WIDTH);
+
+    // Statistics bins: rounding mode (RNE..RNA, other) x class of the first two operands
+    localparam int NUM_RM_BINS    = 6;
+    localparam int NUM_CLASS_BINS = 5;  // zero, denormal, normal, inf, nan (FP_CLASS_* order)
+
+    // Same comparison as compare(), without the message
+    virtual function bit matches(uvm_sequence_item golden_trans_item);
+        fp_transaction #(NUM_INPUTS, INPUT_WIDTH, OUTPUT_WIDTH) golden_trans;
+        if (!$cast(golden_trans, golden_trans_item)) return 0;
+        return (fp_utils_t#(OUTPUT_WIDTH)::canonicalize(result) == fp_utils_t#(OUTPUT_WIDTH)::canonicalize(golden_trans.result))
+            && (this.rm == golden_trans.rm);
+    endfunction
+
+    static function int operand_class(logic [INPUT_WIDTH-1:0] x);
+        logic [IN_EXP_W-1:0]  exp  = x[INPUT_WIDTH-2 -: IN_EXP_W];
+        logic [IN_MANT_W-1:0] mant = x[IN_MANT_W-1:0];
+        if (exp == '0) return (mant == '0) ? 0 : 1;
+        if (exp == '1) return (mant == '0) ? 3 : 4;
+        return 2;
+    endfunction
+
+    static function int num_stat_bins();
+        return NUM_RM_BINS * NUM_CLASS_BINS * NUM_CLASS_BINS;
+    endfunction
+
+    static function string stat_bin_name(int bin);
+        string rm_names[NUM_RM_BINS] = '{"RNE", "RTZ", "RPI", "RNI", "RNA", "RM?"};
+        string class_names[NUM_CLASS_BINS] = '{"zero", "denormal", "normal", "inf", "nan"};
+        int class_a = (bin / NUM_CLASS_BINS) % NUM_CLASS_BINS;
+        int class_b = bin % NUM_CLASS_BINS;
+        if (NUM_INPUTS < 2) return $sformatf("%s %s", rm_names[bin / (NUM_CLASS_BINS * NUM_CLASS_BINS)], class_names[class_a]);
+        return $sformatf("%s %s/%s", rm_names[bin / (NUM_CLASS_BINS * NUM_CLASS_BINS)], class_names[class_a], class_names[class_b]);
+    endfunction
+
+    virtual function int stat_bin();
+        int rm_bin = (rm <= `RNA) ? int'(rm) : NUM_RM_BINS - 1;
+        int class_a = operand_class(inputs[0]);
+        int class_b = (NUM_INPUTS > 1) ? operand_class(inputs[1]) : 0;
+        return (rm_bin * NUM_CLASS_BINS + class_a) * NUM_CLASS_BINS + class_b;
+    endfunction
+
     // Override the compare function to handle FP-specific canonicalization.
     // It now returns a fully formatted log message for both PASS and FAIL cases.
     virtual function string compare(input uvm_sequence_item golden_trans_item, output bit is_match);
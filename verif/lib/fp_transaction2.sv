@@ -17,6 +17,12 @@ class fp_transaction2 #(
     rand fp_category_e category_a;
     rand fp_category_e category_b;
 
+    // Burst mode: operands streamed by the driver one per clock (see fp_sequence2_burst)
+    logic [WIDTH-1:0] burst_a[];
+    logic [WIDTH-1:0] burst_b[];
+    logic [2:0]       burst_rm[];
+    string            burst_file;  // Vector file loaded into the arrays by prepare_burst()
+
     `uvm_object_param_utils_begin(fp_transaction2 #(WIDTH))
         `uvm_field_array_int(inputs, UVM_ALL_ON)
         `uvm_field_int(result, UVM_ALL_ON)
@@ -37,6 +43,42 @@ class fp_transaction2 #(
         super.new(name);
     endfunction
 
+    virtual function int burst_size();
+        return burst_a.size();
+    endfunction
+
+    // Loads burst_file ("a b c rm expected" in hex, '#' comments, as written by fp_inverse_gen)
+    virtual function void prepare_burst();
+        int fd;
+        string line;
+        logic [WIDTH-1:0] a_q[$], b_q[$];
+        logic [2:0] rm_q[$];
+
+        if (burst_file == "" || burst_a.size() > 0) return;
+        fd = $fopen(burst_file, "r");
+        if (fd == 0) begin
+            `uvm_fatal("BURST", $sformatf("Cannot open vector file %s", burst_file))
+            return;
+        end
+        while ($fgets(line, fd)) begin
+            longint unsigned a_val, b_val, c_val;
+            int rm_val;
+            if (line.len() == 0 || line[0] == "#" || line[0] == "\n") continue;
+            if ($sscanf(line, "%h %h %h %d", a_val, b_val, c_val, rm_val) != 4) begin
+                `uvm_error("BURST", $sformatf("Malformed vector line: %s", line))
+                continue;
+            end
+            a_q.push_back(a_val[WIDTH-1:0]);
+            b_q.push_back(b_val[WIDTH-1:0]);
+            rm_q.push_back(rm_val[2:0]);
+        end
+        $fclose(fd);
+        burst_a = a_q;
+        burst_b = b_q;
+        burst_rm = rm_q;
+        `uvm_info("BURST", $sformatf("Loaded %0d vectors from %s", burst_a.size(), burst_file), UVM_LOW)
+    endfunction
+
     // Controls the probability distribution of the different categories.
     // 80% of inputs will be normal numbers, 20% will be special values.
     constraint category_dist_c {
@@ -0,0 +1,123 @@
+// verif/lib/int_model.c
+//
+// Bit-accurate C reference model of the integer library: the radix-4 divider
+// (int_div.v), the barrel shifter (int_shift.v) and the multiply-accumulate
+// (int_mac.v). The divider follows the RTL digit recurrence step by step,
+// the shifter and MAC reduce to their arithmetic definition modulo 2^WIDTH.
+// Checked against the C operators by int_model_check.c.
+//
+
+#include <stdint.h>
+
+#include "int_model.h"
+
+static uint64_t int_mask(const int width) {
+    return (width >= 64) ? ~0ULL : (1ULL << width) - 1;
+}
+
+static int int_clog2(const int n) {
+    int l = 0;
+    while ((1 << l) < n) l++;
+    return l;
+}
+
+uint64_t c_int_div(uint64_t a, uint64_t b, const int width, const int is_signed, uint64_t* rem) {
+    const uint64_t mask = int_mask(width);
+    const uint64_t sign_bit = 1ULL << (width - 1);
+    a &= mask;
+    b &= mask;
+
+    if (b == 0) {
+        if (rem) *rem = a;
+        return mask;
+    }
+
+    // Stage 1: operand magnitudes (-MIN = MIN, i.e. 2^(width-1) unsigned)
+    const int neg_a = is_signed && (a & sign_bit);
+    const int neg_b = is_signed && (b & sign_bit);
+    const uint64_t mag_a = neg_a ? (-a & mask) : a;
+    const uint64_t mag_b = neg_b ? (-b & mask) : b;
+
+    // Radix-4 digits, MSB first: r' = 4r + next two bits, subtract the largest
+    // of d, 2d, 3d that fits. r < d < 2^width, so r' and 3d fit in width + 2 bits.
+    const int digits = (width + 1) / 2;
+    const unsigned __int128 d1 = mag_b;
+    const unsigned __int128 d2 = d1 << 1;
+    const unsigned __int128 d3 = d1 + d2;
+    unsigned __int128 r = 0;
+    uint64_t q = 0;
+    for (int k = digits - 1; k >= 0; k--) {
+        r = (r << 2) | ((mag_a >> (2 * k)) & 3);
+        int digit = 0;
+        if (r >= d3) {
+            digit = 3;
+            r -= d3;
+        } else if (r >= d2) {
+            digit = 2;
+            r -= d2;
+        } else if (r >= d1) {
+            digit = 1;
+            r -= d1;
+        }
+        q = (q << 2) | digit;
+    }
+
+    // Final stage: signs
+    const uint64_t q_mag = q & mask;
+    const uint64_t r_mag = (uint64_t)r;
+    if (rem) *rem = neg_a ? (-r_mag & mask) : r_mag;
+    return (neg_a ^ neg_b) ? (-q_mag & mask) : q_mag;
+}
+
+uint64_t c_int_shift(uint64_t a, const int amount, const int width, const int op) {
+    const uint64_t mask = int_mask(width);
+    const int levels = int_clog2(width);
+    const int sh = amount & ((1 << levels) - 1);
+    a &= mask;
+
+    switch (op) {
+        case INT_SHIFT_SLL:
+            return (sh >= width) ? 0 : (a << sh) & mask;
+        case INT_SHIFT_SRL:
+            return (sh >= width) ? 0 : a >> sh;
+        case INT_SHIFT_SRA: {
+            const uint64_t fill = (a >> (width - 1)) ? mask : 0;
+            if (sh >= width) return fill;
+            return sh ? ((a >> sh) | (fill << (width - sh))) & mask : a;
+        }
+        case INT_SHIFT_ROL:
+        case INT_SHIFT_ROR: {
+            int r = sh % width;
+            if (op == INT_SHIFT_ROL) r = (width - r) % width;  // Rotate left by n = right by width - n
+            return r ? ((a >> r) | (a << (width - r))) & mask : a;
+        }
+        default:
+            return 0;
+    }
+}
+
+uint64_t c_int_mac(uint64_t a, uint64_t b, uint64_t c, const int width, const int acc_width, const int is_signed,
+                   const int sub) {
+    const uint64_t mask = int_mask(width);
+    const uint64_t acc_mask = int_mask(acc_width);
+    a &= mask;
+    b &= mask;
+    c &= acc_mask;
+
+    // 2*width-bit product, sign- or zero-extended (wraps modulo 2^64 >= 2^acc_width)
+    int64_t sa = (int64_t)a, sb = (int64_t)b;
+    if (is_signed && (a >> (width - 1))) sa -= (int64_t)1 << width;
+    if (is_signed && (b >> (width - 1))) sb -= (int64_t)1 << width;
+    const uint64_t prod = is_signed ? (uint64_t)(sa * sb) : a * b;
+
+    return (sub ? c - prod : c + prod) & acc_mask;
+}
+
+int int_div_latency(const int width, const int digits_per_stage) {
+    const int digits = (width + 1) / 2;
+    return 2 + (digits + digits_per_stage - 1) / digits_per_stage;
+}
+
+int int_mac_latency(const int mul_stages) {
+    return mul_stages + 1;
+}
@@ -0,0 +1,33 @@
+#ifndef INT_MODEL_H
+#define INT_MODEL_H
+
+#include <stdint.h>
+
+// Bit-accurate models of the integer library (rtl/verilog/int). Operands and
+// results are WIDTH-bit two's complement / unsigned values in the low bits of
+// a uint64_t (upper bits ignored on input, zero on output), WIDTH 2 .. 64.
+
+// int_shift operations (op input of int_shift.v)
+#define INT_SHIFT_SLL 0  // Logical shift left
+#define INT_SHIFT_SRL 1  // Logical shift right
+#define INT_SHIFT_SRA 2  // Arithmetic shift right
+#define INT_SHIFT_ROL 3  // Rotate left
+#define INT_SHIFT_ROR 4  // Rotate right
+
+// int_div: a / b truncating, remainder with the sign of a. x / 0 gives all
+// ones and remainder x, signed MIN / -1 gives MIN and remainder 0. Computed
+// with the radix-4 recurrence of the RTL.
+uint64_t c_int_div(uint64_t a, uint64_t b, const int width, const int is_signed, uint64_t* rem);
+
+// int_shift: amount is taken modulo 2^$clog2(width) (the RTL amount port)
+uint64_t c_int_shift(uint64_t a, const int amount, const int width, const int op);
+
+// int_mac: c + a * b or c - a * b (sub) modulo 2^acc_width, width <= 32, acc_width <= 64
+uint64_t c_int_mac(uint64_t a, uint64_t b, uint64_t c, const int width, const int acc_width, const int is_signed,
+                   const int sub);
+
+// Pipeline latencies of the RTL for the given parameters (int_shift: its LATENCY parameter)
+int int_div_latency(const int width, const int digits_per_stage);
+int int_mac_latency(const int mul_stages);
+
+#endif // INT_MODEL_H
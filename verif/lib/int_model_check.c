@@ -0,0 +1,229 @@
+// verif/lib/int_model_check.c
+//
+// Native self-check of the integer library model (int_model.c) against
+// independent references: the C division operators on 128-bit values for
+// int_div, a bit-by-bit definition for int_shift and 128-bit arithmetic for
+// int_mac.
+//
+// WIDTH 8 is checked exhaustively (all operand pairs, signed and unsigned;
+// all amounts and operations; MAC with a random c, add and subtract), wider
+// widths with --count random operands biased towards the corner values
+// (0, 1, -1, MIN, MAX). A latency table for the common configurations
+// follows.
+//
+// Build and run (see native.mk):
+//   make -f native.mk int
+//   build/native/int_model_check [--count N] [--seed N]
+//
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "int_model.h"
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint64_t mask_of(int width) {
+    return (width >= 64) ? ~0ULL : (1ULL << width) - 1;
+}
+
+static __int128 to_i128(uint64_t v, int width, int is_signed) {
+    v &= mask_of(width);
+    if (is_signed && ((v >> (width - 1)) & 1)) return (__int128)v - ((__int128)1 << width);
+    return (__int128)v;
+}
+
+// Random operand, one in four a corner value
+static uint64_t rand_operand(uint64_t* state, int width) {
+    const uint64_t mask = mask_of(width);
+    const uint64_t r = rand_u64(state);
+    if ((r & 3) == 0) {
+        const uint64_t corner[5] = {0, 1, mask, 1ULL << (width - 1), mask >> 1};
+        return corner[(r >> 2) % 5];
+    }
+    return (rand_u64(state) >> (rand_u64(state) % width)) & mask;  // Random magnitude
+}
+
+//----------------------------------------------------------------------------
+// References
+//----------------------------------------------------------------------------
+
+static uint64_t ref_div(uint64_t a, uint64_t b, int width, int is_signed, uint64_t* rem) {
+    const uint64_t mask = mask_of(width);
+    a &= mask;
+    b &= mask;
+    if (b == 0) {
+        *rem = a;
+        return mask;
+    }
+    const __int128 x = to_i128(a, width, is_signed);
+    const __int128 y = to_i128(b, width, is_signed);
+    *rem = (uint64_t)(x % y) & mask;
+    return (uint64_t)(x / y) & mask;
+}
+
+static uint64_t ref_shift(uint64_t a, int amount, int width, int op) {
+    int levels = 0;
+    while ((1 << levels) < width) levels++;
+    const int sh = amount & ((1 << levels) - 1);
+    const int msb = (a >> (width - 1)) & 1;
+    uint64_t y = 0;
+    for (int i = 0; i < width; i++) {
+        int bit;
+        if (op == INT_SHIFT_SLL) {
+            bit = (i - sh >= 0) ? (a >> (i - sh)) & 1 : 0;
+        } else if (op == INT_SHIFT_SRL || op == INT_SHIFT_SRA) {
+            bit = (i + sh < width) ? (a >> (i + sh)) & 1 : (op == INT_SHIFT_SRA) ? msb : 0;
+        } else if (op == INT_SHIFT_ROL) {
+            bit = (a >> (((i - sh) % width + width) % width)) & 1;
+        } else {
+            bit = (a >> ((i + sh) % width)) & 1;
+        }
+        y |= (uint64_t)bit << i;
+    }
+    return y;
+}
+
+static uint64_t ref_mac(uint64_t a, uint64_t b, uint64_t c, int width, int acc_width, int is_signed, int sub) {
+    const __int128 p = to_i128(a, width, is_signed) * to_i128(b, width, is_signed);
+    const __int128 acc = (__int128)(c & mask_of(acc_width));
+    return (uint64_t)(sub ? acc - p : acc + p) & mask_of(acc_width);
+}
+
+//----------------------------------------------------------------------------
+// Checks
+//----------------------------------------------------------------------------
+
+struct check_s {
+    long count;
+    long mismatches;
+};
+
+static void report(const char* op, int width, const char* mode, const struct check_s* c) {
+    printf("%-6s | %-5d | %-24s | %-10ld | %ld\n", op, width, mode, c->count, c->mismatches);
+}
+
+static void mismatch(struct check_s* c, const char* op, int width, uint64_t a, uint64_t b, uint64_t got,
+                     uint64_t expected) {
+    if (c->mismatches < 5)
+        printf("  %s%d: a %llx b %llx: got %llx, expected %llx\n", op, width, (unsigned long long)a,
+               (unsigned long long)b, (unsigned long long)got, (unsigned long long)expected);
+    c->mismatches++;
+}
+
+static void check_div(struct check_s* c, uint64_t a, uint64_t b, int width, int is_signed) {
+    uint64_t r, r_ref;
+    const uint64_t q = c_int_div(a, b, width, is_signed, &r);
+    const uint64_t q_ref = ref_div(a, b, width, is_signed, &r_ref);
+    if (q != q_ref) mismatch(c, "div", width, a, b, q, q_ref);
+    if (r != r_ref) mismatch(c, "rem", width, a, b, r, r_ref);
+    c->count++;
+}
+
+static void check_shift(struct check_s* c, uint64_t a, int amount, int width, int op) {
+    const uint64_t y = c_int_shift(a, amount, width, op);
+    const uint64_t y_ref = ref_shift(a, amount, width, op);
+    if (y != y_ref) mismatch(c, "shift", width, a, (uint64_t)(amount * 8 + op), y, y_ref);
+    c->count++;
+}
+
+static void check_mac(struct check_s* c, uint64_t a, uint64_t b, uint64_t acc, int width, int acc_width,
+                      int is_signed, int sub) {
+    const uint64_t y = c_int_mac(a, b, acc, width, acc_width, is_signed, sub);
+    const uint64_t y_ref = ref_mac(a, b, acc, width, acc_width, is_signed, sub);
+    if (y != y_ref) mismatch(c, "mac", width, a, b, y, y_ref);
+    c->count++;
+}
+
+int main(int argc, char** argv) {
+    long count = 1000000;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--count") && i + 1 < argc) {
+            count = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [--count N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (count < 1) {
+        fprintf(stderr, "--count must be at least 1\n");
+        return 2;
+    }
+
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+    long total_mismatches = 0;
+
+    printf("%-6s | %-5s | %-24s | %-10s | %s\n", "OP", "WIDTH", "MODE", "CHECKS", "MISMATCHES");
+
+    // Exhaustive 8-bit
+    for (int is_signed = 0; is_signed < 2; is_signed++) {
+        struct check_s c = {0, 0};
+        for (uint64_t a = 0; a < 256; a++)
+            for (uint64_t b = 0; b < 256; b++) check_div(&c, a, b, 8, is_signed);
+        report("div", 8, is_signed ? "signed, exhaustive" : "unsigned, exhaustive", &c);
+        total_mismatches += c.mismatches;
+    }
+    {
+        struct check_s c = {0, 0};
+        for (int op = INT_SHIFT_SLL; op <= INT_SHIFT_ROR; op++)
+            for (uint64_t a = 0; a < 256; a++)
+                for (int amount = 0; amount < 8; amount++) check_shift(&c, a, amount, 8, op);
+        report("shift", 8, "all ops, exhaustive", &c);
+        total_mismatches += c.mismatches;
+    }
+    for (int is_signed = 0; is_signed < 2; is_signed++) {
+        // Product width 16, accumulator 16 (exact), 24 (extended) and 12 (truncated)
+        static const int acc_widths[3] = {16, 24, 12};
+        struct check_s c = {0, 0};
+        for (int k = 0; k < 3; k++)
+            for (uint64_t a = 0; a < 256; a++)
+                for (uint64_t b = 0; b < 256; b++)
+                    check_mac(&c, a, b, rand_u64(&state), 8, acc_widths[k], is_signed, (int)((a ^ b) & 1));
+        report("mac", 8, is_signed ? "signed, exhaustive a,b" : "unsigned, exhaustive a,b", &c);
+        total_mismatches += c.mismatches;
+    }
+
+    // Random wider widths
+    static const int widths[4] = {13, 16, 32, 64};
+    for (int w = 0; w < 4; w++) {
+        const int width = widths[w];
+        struct check_s div = {0, 0}, shift = {0, 0}, mac = {0, 0};
+        for (long i = 0; i < count; i++) {
+            const int is_signed = (int)(rand_u64(&state) & 1);
+            const uint64_t a = rand_operand(&state, width);
+            const uint64_t b = rand_operand(&state, width);
+            check_div(&div, a, b, width, is_signed);
+            check_shift(&shift, a, (int)(rand_u64(&state) & 63), width, (int)(rand_u64(&state) % 5));
+            if (width <= 32)
+                check_mac(&mac, a, b, rand_u64(&state), width, 2 * width + 8 > 64 ? 64 : 2 * width + 8, is_signed,
+                          (int)(rand_u64(&state) & 1));
+        }
+        report("div", width, "random", &div);
+        report("shift", width, "random", &shift);
+        if (width <= 32) report("mac", width, "random", &mac);
+        total_mismatches += div.mismatches + shift.mismatches + mac.mismatches;
+    }
+
+    printf("\nLatency in cycles, one operation per cycle\n\n");
+    printf("%-5s | %-22s | %s\n", "WIDTH", "DIV DIGITS/STAGE 1/2/4", "MAC MUL_STAGES 1/2/4");
+    static const int lat_widths[3] = {16, 32, 64};
+    for (int w = 0; w < 3; w++) {
+        printf("%-5d | %2d / %2d / %-12d | %d / %d / %d\n", lat_widths[w], int_div_latency(lat_widths[w], 1),
+               int_div_latency(lat_widths[w], 2), int_div_latency(lat_widths[w], 4), int_mac_latency(1),
+               int_mac_latency(2), int_mac_latency(4));
+    }
+
+    printf("\n%s : int_div, int_shift and int_mac models match the references\n", total_mismatches ? "FAIL" : "PASS");
+    return total_mismatches ? 1 : 0;
+}
@@ -0,0 +1,211 @@
+// verif/lib/int_tput_vl.cpp
+//
+// Verilator throughput test for the integer library (rtl/verilog/int).
+//
+// Drives a new random operation into the Verilated unit every cycle (operands
+// biased towards 0, 1, -1, MIN and MAX, signedness / operation / sub random
+// per operation), checks every result against the bit-accurate C model
+// (int_model.c) LATENCY cycles later, and reports results per cycle (1.00
+// for a fully pipelined unit) and simulated cycles per second.
+//
+// The unit is Verilated with --prefix Vtput and selected at build time (see
+// verilator.mk):
+//   TPUT_DUT    - Unit name (top module), e.g. int_div
+//   TPUT_OP     - INT_TPUT_OP_DIV, INT_TPUT_OP_SHIFT or INT_TPUT_OP_MAC
+//   TPUT_WIDTH  - WIDTH the model was Verilated with (int_mac: <= 32)
+//   TPUT_STAGES - DIGITS_PER_STAGE (int_div), LATENCY (int_shift) or
+//                 MUL_STAGES (int_mac) the model was Verilated with
+//
+// Build and run:
+//   make -f verilator.mk tput INT_DUT=int_div INT_WIDTH=32 INT_STAGES=2
+//   build/verilator/int_div_32_2/int_tput [--cycles N] [--seed N]
+//
+// Returns 1 on any mismatch.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "verilated.h"
+#include "Vtput.h"
+
+extern "C" {
+#include "int_model.h"
+}
+
+#define INT_TPUT_OP_DIV   0
+#define INT_TPUT_OP_SHIFT 1
+#define INT_TPUT_OP_MAC   2
+
+#define TPUT_STR2(x) #x
+#define TPUT_STR(x) TPUT_STR2(x)
+#define TPUT_DUT_NAME TPUT_STR(TPUT_DUT)
+
+#if TPUT_OP == INT_TPUT_OP_DIV
+static const int tput_latency = int_div_latency(TPUT_WIDTH, TPUT_STAGES);
+#elif TPUT_OP == INT_TPUT_OP_SHIFT
+static const int tput_latency = TPUT_STAGES;
+#else
+static const int tput_latency = int_mac_latency(TPUT_STAGES);
+#endif
+
+static const int acc_width = 2 * TPUT_WIDTH;  // int_mac default ACC_WIDTH
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static uint64_t mask_of(int width) {
+    return (width >= 64) ? ~0ULL : (1ULL << width) - 1;
+}
+
+static uint64_t rand_operand(uint64_t* state, int width) {
+    const uint64_t mask = mask_of(width);
+    const uint64_t r = rand_u64(state);
+    if ((r & 3) == 0) {
+        const uint64_t corner[5] = {0, 1, mask, 1ULL << (width - 1), mask >> 1};
+        return corner[(r >> 2) % 5];
+    }
+    return (rand_u64(state) >> (rand_u64(state) % width)) & mask;
+}
+
+// One operation in flight
+struct tput_op_s {
+    uint64_t a;
+    uint64_t b;        // Divisor, shift amount or multiplier
+    uint64_t c;        // int_mac accumulator input
+    int mode;          // is_signed (int_div, int_mac) or op (int_shift)
+    int sub;           // int_mac
+    uint64_t expected;
+    uint64_t expected_rem;
+};
+
+static tput_op_s make_op(uint64_t* state) {
+    tput_op_s op = {};
+    op.a = rand_operand(state, TPUT_WIDTH);
+    op.b = rand_operand(state, TPUT_WIDTH);
+#if TPUT_OP == INT_TPUT_OP_DIV
+    op.mode = (int)(rand_u64(state) & 1);
+    op.expected = c_int_div(op.a, op.b, TPUT_WIDTH, op.mode, &op.expected_rem);
+#elif TPUT_OP == INT_TPUT_OP_SHIFT
+    op.b = rand_u64(state) & 63;
+    op.mode = (int)(rand_u64(state) % 5);
+    op.expected = c_int_shift(op.a, (int)op.b, TPUT_WIDTH, op.mode);
+#else
+    op.c = rand_u64(state) & mask_of(acc_width);
+    op.mode = (int)(rand_u64(state) & 1);
+    op.sub = (int)(rand_u64(state) & 1);
+    op.expected = c_int_mac(op.a, op.b, op.c, TPUT_WIDTH, acc_width, op.mode, op.sub);
+#endif
+    return op;
+}
+
+static void drive(Vtput* dut, const tput_op_s& op) {
+    dut->a = op.a;
+#if TPUT_OP == INT_TPUT_OP_DIV
+    dut->b = op.b;
+    dut->is_signed = op.mode;
+#elif TPUT_OP == INT_TPUT_OP_SHIFT
+    dut->amount = op.b;  // Upper bits dropped by the port width, as in the model
+    dut->op = op.mode;
+#else
+    dut->b = op.b;
+    dut->c = op.c;
+    dut->is_signed = op.mode;
+    dut->sub = op.sub;
+#endif
+}
+
+// Mismatch count of the result currently at the outputs
+static int check(Vtput* dut, const tput_op_s& op, long index) {
+#if TPUT_OP == INT_TPUT_OP_DIV
+    const uint64_t got = dut->quotient;
+    const uint64_t got_rem = dut->remainder;
+    if (got == op.expected && got_rem == op.expected_rem) return 0;
+    printf("  op %ld: %llx / %llx (signed %d): got %llx rem %llx, expected %llx rem %llx\n", index,
+           (unsigned long long)op.a, (unsigned long long)op.b, op.mode, (unsigned long long)got,
+           (unsigned long long)got_rem, (unsigned long long)op.expected, (unsigned long long)op.expected_rem);
+#else
+    const uint64_t got = dut->result;
+    if (got == op.expected) return 0;
+    printf("  op %ld: a %llx b %llx c %llx mode %d sub %d: got %llx, expected %llx\n", index,
+           (unsigned long long)op.a, (unsigned long long)op.b, (unsigned long long)op.c, op.mode, op.sub,
+           (unsigned long long)got, (unsigned long long)op.expected);
+#endif
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    long cycles = 1000000;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--cycles") && i + 1 < argc) {
+            cycles = atol(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [--cycles N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (cycles < 1) {
+        fprintf(stderr, "--cycles must be at least 1\n");
+        return 2;
+    }
+
+    VerilatedContext* ctx = new VerilatedContext;
+    Vtput* dut = new Vtput(ctx);
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+
+    dut->clk = 0;
+    dut->rst_n = 0;
+    dut->eval();
+    dut->rst_n = 1;
+    dut->eval();
+
+    // Operation t is driven in cycle t and its result is at the outputs in
+    // cycle t + latency, before that cycle's rising edge
+    std::vector<tput_op_s> in_flight(tput_latency + 1);
+    long results = 0;
+    long mismatches = 0;
+    const long total = cycles + tput_latency;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (long t = 0; t < total; t++) {
+        if (t < cycles) {
+            in_flight[t % (tput_latency + 1)] = make_op(&state);
+            drive(dut, in_flight[t % (tput_latency + 1)]);
+        }
+        dut->clk = 0;
+        dut->eval();
+        if (t >= tput_latency) {
+            const long index = t - tput_latency;
+            mismatches += check(dut, in_flight[index % (tput_latency + 1)], index);
+            results++;
+            if (mismatches >= 10) break;
+        }
+        dut->clk = 1;
+        dut->eval();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%s WIDTH=%d stages %d: latency %d, %ld operations in %ld cycles\n", TPUT_DUT_NAME, TPUT_WIDTH,
+           TPUT_STAGES, tput_latency, results, total);
+    printf("Throughput : %.2f results/cycle (%.2f after the pipeline fill)\n", (double)results / total,
+           (double)results / cycles);
+    printf("Simulation : %.0f cycles/s\n", seconds > 0 ? total / seconds : 0.0);
+    printf("\n%s : %ld mismatches against the C model\n", mismatches ? "FAIL" : "PASS", mismatches);
+
+    dut->final();
+    delete dut;
+    delete ctx;
+    return mismatches ? 1 : 0;
+}
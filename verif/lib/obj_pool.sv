@@ -0,0 +1,56 @@
+// verif/lib/obj_pool.sv
+// Free-list pool for transaction objects.
+//
+// One pool per object type (static members of each specialization). get()
+// returns a released object if there is one and creates a new one through the
+// factory otherwise, put() hands an object back. An object must only be put
+// back by the component at the end of its path, when nothing holds a handle
+// to it any more. Analysis subscribers that keep a transaction past write()
+// must copy it (as systolic_scoreboard does for its expected items).
+//
+// Pooled objects keep their previous field values, users overwrite all fields
+// they rely on (randomize(), the monitor's sampling, model predictions).
+//
+// Usage:
+//   req = obj_pool #(fp_transaction2 #(WIDTH))::get("req");
+//   ...
+//   obj_pool #(fp_transaction2 #(WIDTH))::put(req);
+
+`include "uvm_macros.svh"
+import uvm_pkg::*;
+
+class obj_pool #(type T = uvm_object);
+
+    static protected T free_list[$];
+
+    // Statistics
+    static int unsigned num_created;   // Objects created through the factory
+    static int unsigned num_reused;    // get() calls served from the free list
+    static int unsigned num_released;  // put() calls
+
+    static function T get(string name = "");
+        T obj;
+        if (free_list.size() > 0) begin
+            obj = free_list.pop_back();
+            obj.set_name(name);
+            num_reused++;
+        end else begin
+            obj = T::type_id::create(name);
+            num_created++;
+        end
+        return obj;
+    endfunction
+
+    static function void put(T obj);
+        if (obj == null) return;
+        free_list.push_back(obj);
+        num_released++;
+    endfunction
+
+    // One-line summary for the end-of-test report
+    static function string stats();
+        return $sformatf("%s: %0d created, %0d reused, %0d released, %0d free",
+            $typename(T), num_created, num_reused, num_released, free_list.size());
+    endfunction
+
+endclass
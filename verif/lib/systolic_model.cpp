@@ -0,0 +1,434 @@
+// verif/lib/systolic_model.cpp
+//
+// C++ reference for the multi-precision systolic array.
+// See systolic_model.h for the overview.
+//
+
+#include <algorithm>
+
+#include "systolic_model.h"
+
+static uint64_t mask_bits(int n) {
+    return (n >= 64) ? ~0ULL : (1ULL << n) - 1;
+}
+
+// Element idx of a row-major array of lw-bit elements packed into width-bit words
+static uint64_t packed_elem(const std::vector<uint64_t>& words, int width, int lw, int idx) {
+    const int bit = idx * lw;
+    return (words[bit / width] >> (bit % width)) & mask_bits(lw);
+}
+
+static int prec_lanes(int prec) {
+    return 1 << ((prec > SYSTOLIC_PREC_4X) ? SYSTOLIC_PREC_4X : prec);
+}
+
+//------------------------------------------------------------------------------
+// PE (pe2_mp)
+//------------------------------------------------------------------------------
+
+uint64_t systolic_pe_mac(const systolic_cfg_s& cfg, const systolic_mode_s& mode, uint64_t a, uint64_t b,
+                         uint64_t c_in) {
+    const int W = cfg.width;
+    const int Q = W / 4;
+    const int AQ = cfg.acc_width / 4;
+    const int lanes = prec_lanes(mode.prec);
+
+    // Split multiplier: quarter partial products of the same lane, at their natural shift
+    uint64_t product = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            if (i / (4 / lanes) != j / (4 / lanes)) {
+                continue;
+            }
+            const uint64_t pp = ((a >> (i * Q)) & mask_bits(Q)) * ((b >> (j * Q)) & mask_bits(Q));
+            product += pp << (Q * (i + j));
+        }
+    }
+
+    // Addend: lane products summed, or each in its ACC_WIDTH / lanes field
+    const int pw = 2 * W / lanes;
+    uint64_t addend = 0;
+    if (lanes == 1 || mode.lane_sum) {
+        for (int l = 0; l < lanes; l++) {
+            addend += (product >> (l * pw)) & mask_bits(pw);
+        }
+    } else {
+        const int field = cfg.acc_width / lanes;
+        for (int l = 0; l < lanes; l++) {
+            addend |= ((product >> (l * pw)) & mask_bits(pw) & mask_bits(field)) << (l * field);
+        }
+    }
+    addend &= mask_bits(cfg.acc_width);
+
+    // Segmented adder, carries killed at the boundaries of independent lanes
+    uint64_t c_out = 0;
+    uint64_t carry = 0;
+    for (int s = 0; s < 4; s++) {
+        const bool kill = !mode.lane_sum && lanes > 1 && s != 0 && (s % (4 / lanes)) == 0;
+        const uint64_t sum = ((c_in >> (s * AQ)) & mask_bits(AQ)) + ((addend >> (s * AQ)) & mask_bits(AQ)) +
+                             (kill ? 0 : carry);
+        c_out |= (sum & mask_bits(AQ)) << (s * AQ);
+        carry = sum >> AQ;
+    }
+    return c_out;
+}
+
+//------------------------------------------------------------------------------
+// Array (systolic_controller + systolic_array)
+//------------------------------------------------------------------------------
+
+std::vector<uint64_t> systolic_pack_b(const systolic_cfg_s& cfg, const systolic_mode_s& mode,
+                                      const std::vector<uint64_t>& b) {
+    const int lanes = prec_lanes(mode.prec);
+    if (lanes == 1 || !mode.lane_sum) {
+        return b;
+    }
+    // Lane l of PE row r is element (r * lanes + l) of the B column
+    const int lw = cfg.width / lanes;
+    std::vector<uint64_t> packed(cfg.rows * cfg.cols, 0);
+    for (int r = 0; r < cfg.rows; r++) {
+        for (int c = 0; c < cfg.cols; c++) {
+            for (int l = 0; l < lanes; l++) {
+                packed[r * cfg.cols + c] |= packed_elem(b, cfg.width, lw, (r * lanes + l) * cfg.cols + c) << (l * lw);
+            }
+        }
+    }
+    return packed;
+}
+
+std::vector<uint64_t> systolic_array_ref(const systolic_cfg_s& cfg, const systolic_mode_s& mode,
+                                         const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    const std::vector<uint64_t> b_active = systolic_pack_b(cfg, mode, b);
+    std::vector<uint64_t> c(cfg.rows * cfg.cols, 0);
+
+    // Row i of C leaves column j after passing the PEs of that column top to
+    // bottom; PE row r sees A[i][r] (the controller streams column r of A)
+    for (int i = 0; i < cfg.rows; i++) {
+        for (int j = 0; j < cfg.cols; j++) {
+            uint64_t acc = 0;
+            for (int r = 0; r < cfg.rows; r++) {
+                acc = systolic_pe_mac(cfg, mode, a[i * cfg.rows + r], b_active[r * cfg.cols + j], acc);
+            }
+            c[i * cfg.cols + j] = acc;
+        }
+    }
+    return c;
+}
+
+//------------------------------------------------------------------------------
+// Arithmetic reference
+//------------------------------------------------------------------------------
+
+std::vector<uint64_t> systolic_matmul_ref(const systolic_cfg_s& cfg, const systolic_mode_s& mode,
+                                          const std::vector<uint64_t>& a, const std::vector<uint64_t>& b) {
+    const int lanes = prec_lanes(mode.prec);
+    const int lw = cfg.width / lanes;
+    std::vector<uint64_t> c(cfg.rows * cfg.cols, 0);
+
+    for (int i = 0; i < cfg.rows; i++) {
+        for (int j = 0; j < cfg.cols; j++) {
+            uint64_t result = 0;
+            if (lanes == 1 || mode.lane_sum) {
+                // A is rows x (lanes * rows), B is (lanes * rows) x cols
+                const int depth = lanes * cfg.rows;
+                for (int k = 0; k < depth; k++) {
+                    result += packed_elem(a, cfg.width, lw, i * depth + k) * packed_elem(b, cfg.width, lw, k * cfg.cols + j);
+                }
+                result &= mask_bits(cfg.acc_width);
+            } else {
+                // One product per lane, each on its ACC_WIDTH / lanes field
+                const int field = cfg.acc_width / lanes;
+                for (int l = 0; l < lanes; l++) {
+                    uint64_t sum = 0;
+                    for (int k = 0; k < cfg.rows; k++) {
+                        sum += ((a[i * cfg.rows + k] >> (l * lw)) & mask_bits(lw)) *
+                               ((b[k * cfg.cols + j] >> (l * lw)) & mask_bits(lw));
+                    }
+                    result |= (sum & mask_bits(field)) << (l * field);
+                }
+            }
+            c[i * cfg.cols + j] = result;
+        }
+    }
+    return c;
+}
+
+uint64_t systolic_job_macs(const systolic_cfg_s& cfg, const systolic_mode_s& mode) {
+    return (uint64_t)cfg.rows * cfg.rows * cfg.cols * prec_lanes(mode.prec);
+}
+
+//------------------------------------------------------------------------------
+// Partitioning utilization model
+//------------------------------------------------------------------------------
+
+int systolic_job_period(int rows, int cols, int add_latency) {
+    return rows + (rows - 1) * add_latency + cols + 1;
+}
+
+int systolic_job_latency(int rows, int cols, int mul_latency, int add_latency) {
+    // B load, update, A skew to the last row (C_START_DELAY), C drain
+    return rows + 1 + rows * add_latency + mul_latency + rows + cols;
+}
+
+static uint64_t ceil_div(uint64_t a, uint64_t b) { return (a + b - 1) / b; }
+
+uint64_t systolic_gemm_jobs(const systolic_gemm_s& gemm, int rows, int cols) {
+    return ceil_div(gemm.m, rows) * ceil_div(gemm.k, rows) * ceil_div(gemm.n, cols);
+}
+
+systolic_trace_stats_s systolic_part_trace(const systolic_part_cfg_s& cfg, const std::vector<systolic_gemm_s>& trace,
+                                           systolic_part_policy_e policy) {
+    const int parts = cfg.part_rows * cfg.part_cols;
+    const int sub_rows = cfg.rows / cfg.part_rows;
+    const int sub_cols = cfg.cols / cfg.part_cols;
+    const uint64_t whole_period = systolic_job_period(cfg.rows, cfg.cols, cfg.add_latency);
+    const uint64_t part_period = systolic_job_period(sub_rows, sub_cols, cfg.add_latency);
+    const uint64_t whole_latency = systolic_job_latency(cfg.rows, cfg.cols, cfg.mul_latency, cfg.add_latency);
+    const uint64_t part_latency = systolic_job_latency(sub_rows, sub_cols, cfg.mul_latency, cfg.add_latency);
+
+    // Mode per GEMM
+    const size_t n = trace.size();
+    std::vector<bool> modes(n, parts > 1 && policy == SYSTOLIC_PART_ALWAYS);
+    if (parts > 1 && policy == SYSTOLIC_PART_ADAPTIVE && n) {
+        // Cheapest mode sequence over the trace: issue cycles of the jobs in
+        // each mode plus a drain per switch (Viterbi over the two modes)
+        std::vector<uint64_t> cost[2] = {std::vector<uint64_t>(n), std::vector<uint64_t>(n)};
+        std::vector<bool> from_other[2] = {std::vector<bool>(n), std::vector<bool>(n)};
+        for (size_t i = 0; i < n; i++) {
+            const uint64_t jobs_cost[2] = {systolic_gemm_jobs(trace[i], cfg.rows, cfg.cols) * whole_period,
+                                           ceil_div(systolic_gemm_jobs(trace[i], sub_rows, sub_cols), parts) * part_period};
+            const uint64_t drain[2] = {part_latency, whole_latency};  // Switching into the mode
+            for (int m = 0; m < 2; m++) {
+                uint64_t prev = 0;
+                if (i) {
+                    const uint64_t stay = cost[m][i-1];
+                    const uint64_t sw = cost[!m][i-1] + drain[m];
+                    from_other[m][i] = sw < stay;
+                    prev = std::min(stay, sw);
+                }
+                cost[m][i] = prev + jobs_cost[m];
+            }
+        }
+        int m = cost[1][n-1] < cost[0][n-1];
+        for (size_t i = n; i-- > 0;) {
+            modes[i] = m;
+            if (from_other[m][i]) m = !m;
+        }
+    }
+
+    systolic_trace_stats_s st = {};
+    // Start time of the next job per partition (whole array: entry 0), end of the last result
+    std::vector<uint64_t> free_at(parts, 0);
+    uint64_t end = 0;
+    bool part_mode = false;
+    bool started = false;
+
+    for (size_t i = 0; i < n; i++) {
+        const systolic_gemm_s& g = trace[i];
+        const uint64_t whole_jobs = systolic_gemm_jobs(g, cfg.rows, cfg.cols);
+        const uint64_t part_jobs = systolic_gemm_jobs(g, sub_rows, sub_cols);
+        const bool use_part = modes[i];
+
+        if (started && use_part != part_mode) {
+            // Drain, then every partition (or the whole array) starts together
+            st.switches++;
+            std::fill(free_at.begin(), free_at.end(), end);
+        }
+        part_mode = use_part;
+        started = true;
+        st.macs += (uint64_t)g.m * g.k * g.n;
+
+        if (use_part) {
+            for (uint64_t j = 0; j < part_jobs; j++) {
+                auto next = std::min_element(free_at.begin(), free_at.end());
+                end = std::max(end, *next + part_latency);
+                *next += part_period;
+            }
+            st.part_jobs += part_jobs;
+        } else {
+            if (whole_jobs) end = std::max(end, free_at[0] + (whole_jobs - 1) * whole_period + whole_latency);
+            free_at[0] += whole_jobs * whole_period;
+            st.whole_jobs += whole_jobs;
+        }
+    }
+
+    st.cycles = end;
+    st.utilization = end ? (double)st.macs / ((double)end * cfg.rows * cfg.cols) : 0.0;
+    return st;
+}
+
+//------------------------------------------------------------------------------
+// Controller cycle model
+//------------------------------------------------------------------------------
+
+// systolic_controller states and FIFO depth
+enum { S_IDLE, S_LOAD, S_WAIT_A, S_UPDATE, S_WAIT };
+static const int CTRL_FIFO_DEPTH = 4;
+
+systolic_ctrl_s systolic_ctrl_init(int rows, int cols, int mul_latency, int add_latency) {
+    systolic_ctrl_s ctrl = {};
+    ctrl.rows = rows;
+    ctrl.cols = cols;
+    ctrl.mul_latency = mul_latency;
+    ctrl.add_latency = add_latency;
+    ctrl.state = S_IDLE;
+    ctrl.c_start_sr.assign(rows * add_latency + mul_latency, false);
+    ctrl.done_sr.assign((rows - 1) * add_latency + cols, false);
+    ctrl.perf_enable = true;
+    return ctrl;
+}
+
+bool systolic_ctrl_in_ready(const systolic_ctrl_s& ctrl) {
+    return ctrl.fifo_count < CTRL_FIFO_DEPTH;
+}
+
+void systolic_ctrl_step(systolic_ctrl_s& ctrl, bool in_request) {
+    const systolic_ctrl_s q = ctrl;  // Register values of the cycle
+    const bool fifo_full = q.fifo_count == CTRL_FIFO_DEPTH;
+    const bool fifo_empty = q.fifo_count == 0;
+    const bool in_valid = in_request && !fifo_full;
+    const bool start_c = q.c_start_sr.empty() ? q.start_job : q.c_start_sr.back();
+    const bool c_pending = std::find(q.c_start_sr.begin(), q.c_start_sr.end(), true) != q.c_start_sr.end();
+    const bool b_update_done = q.done_sr.back();
+    const bool idle = q.state == S_IDLE && fifo_empty && !q.start_job && !q.a_active && !c_pending && !q.c_active;
+
+    if (q.perf_enable) {
+        systolic_perf_s& p = ctrl.perf;
+        p.perf_cycles++;
+        p.perf_busy += !idle;
+        p.perf_stall += in_request && !in_valid;
+        p.perf_b_load += q.state == S_LOAD;
+        p.perf_b_update += q.state == S_UPDATE || q.state == S_WAIT;
+        p.perf_drain += q.c_active;
+        p.perf_fifo_full += fifo_full;
+        p.perf_fifo_empty += fifo_empty;
+        p.perf_jobs += q.out_valid;
+    }
+
+    // Input FIFO
+    const bool pop = q.state == S_LOAD && q.load_cnt == q.rows - 1 && !fifo_empty;
+    ctrl.fifo_count = q.fifo_count + in_valid - pop;
+
+    // B load FSM
+    ctrl.b_update = false;
+    ctrl.start_job = false;
+    switch (q.state) {
+    case S_IDLE:
+        if (!fifo_empty) {
+            ctrl.state = S_LOAD;
+            ctrl.load_cnt = 0;
+        }
+        break;
+    case S_LOAD:
+        if (q.load_cnt == q.rows - 1) {
+            ctrl.state = q.a_active ? S_WAIT_A : S_UPDATE;
+            ctrl.b_update = ctrl.start_job = !q.a_active;
+        } else {
+            ctrl.load_cnt = q.load_cnt + 1;
+        }
+        break;
+    case S_WAIT_A:
+        if (!q.a_active) {
+            ctrl.state = S_UPDATE;
+            ctrl.b_update = ctrl.start_job = true;
+        }
+        break;
+    case S_UPDATE:
+        ctrl.state = S_WAIT;
+        break;
+    case S_WAIT:
+        if (b_update_done && !fifo_empty) {
+            ctrl.state = S_LOAD;
+            ctrl.load_cnt = 0;
+        } else if (b_update_done) {
+            ctrl.state = S_IDLE;
+        }
+        break;
+    }
+
+    // A streamer
+    if (q.start_job) {
+        ctrl.a_active = true;
+        ctrl.a_timer = 0;
+    } else if (q.a_active) {
+        ctrl.a_timer = q.a_timer + 1;
+        if (q.a_timer == (q.rows - 1) * q.add_latency + q.rows - 1) ctrl.a_active = false;
+    }
+
+    // C start delay and collection
+    if (!ctrl.c_start_sr.empty()) {
+        std::copy_backward(q.c_start_sr.begin(), q.c_start_sr.end() - 1, ctrl.c_start_sr.end());
+        ctrl.c_start_sr[0] = q.start_job;
+    }
+    ctrl.out_valid = false;
+    if (start_c) {
+        ctrl.c_active = true;
+        ctrl.c_timer = 0;
+    }
+    if (q.c_active) {
+        ctrl.c_timer = q.c_timer + 1;
+        if (q.c_timer == q.rows - 1 + q.cols - 1 + 1) {
+            ctrl.c_active = false;
+            ctrl.out_valid = true;
+        }
+    }
+
+    // b_update wavefront through the array
+    std::copy_backward(q.done_sr.begin(), q.done_sr.end() - 1, ctrl.done_sr.end());
+    ctrl.done_sr[0] = q.b_update;
+}
+
+uint32_t systolic_ctrl_csr_read(const systolic_ctrl_s& ctrl, int addr) {
+    const systolic_perf_s& p = ctrl.perf;
+    switch (addr) {
+    case SYSTOLIC_PERF_CTRL:       return ctrl.perf_enable;
+    case SYSTOLIC_PERF_CYCLES:     return p.perf_cycles;
+    case SYSTOLIC_PERF_BUSY:       return p.perf_busy;
+    case SYSTOLIC_PERF_STALL:      return p.perf_stall;
+    case SYSTOLIC_PERF_B_LOAD:     return p.perf_b_load;
+    case SYSTOLIC_PERF_B_UPDATE:   return p.perf_b_update;
+    case SYSTOLIC_PERF_DRAIN:      return p.perf_drain;
+    case SYSTOLIC_PERF_FIFO_FULL:  return p.perf_fifo_full;
+    case SYSTOLIC_PERF_FIFO_EMPTY: return p.perf_fifo_empty;
+    case SYSTOLIC_PERF_JOBS:       return p.perf_jobs;
+    default:                       return 0;
+    }
+}
+
+void systolic_ctrl_csr_write(systolic_ctrl_s& ctrl, int addr, uint32_t data) {
+    if (addr != SYSTOLIC_PERF_CTRL) return;
+    ctrl.perf_enable = data & 1;
+    if (data & 2) ctrl.perf = {};
+}
+
+const char* systolic_perf_name(int addr) {
+    static const char* const names[SYSTOLIC_PERF_REGS] = {
+        "perf_ctrl", "perf_cycles", "perf_busy", "perf_stall", "perf_b_load",
+        "perf_b_update", "perf_drain", "perf_fifo_full", "perf_fifo_empty", "perf_jobs",
+    };
+    return (addr >= 0 && addr < SYSTOLIC_PERF_REGS) ? names[addr] : "-";
+}
+
+//------------------------------------------------------------------------------
+// DPI-C
+//------------------------------------------------------------------------------
+
+static systolic_ctrl_s dpi_ctrl = systolic_ctrl_init(2, 2, 0, 1);
+
+extern "C" void c_systolic_perf_reset(const int rows, const int cols, const int mul_latency, const int add_latency) {
+    dpi_ctrl = systolic_ctrl_init(rows, cols, mul_latency, add_latency);
+}
+
+extern "C" int c_systolic_perf_step(const int in_request) {
+    const bool in_ready = systolic_ctrl_in_ready(dpi_ctrl);
+    systolic_ctrl_step(dpi_ctrl, in_request != 0);
+    return in_ready;
+}
+
+extern "C" unsigned int c_systolic_perf_read(const int addr) {
+    return systolic_ctrl_csr_read(dpi_ctrl, addr);
+}
+
+extern "C" void c_systolic_perf_write(const int addr, const unsigned int data) {
+    systolic_ctrl_csr_write(dpi_ctrl, addr, data);
+}
@@ -0,0 +1,201 @@
+// verif/lib/systolic_model.h
+//
+// C++ reference for the multi-precision systolic array (pe2_mp, systolic with
+// MULTI_PRECISION).
+//
+// Two independent models of one job:
+//   - systolic_array_ref(): the array as built, i.e. the controller's B
+//     packing and the PE grid, each PE bit-accurate to pe2_mp (quarter partial
+//     products, lane fields, segmented accumulator adder);
+//   - systolic_matmul_ref(): the arithmetic the mode stands for, from the
+//     unpacked lane elements.
+// systolic_model_check.cpp compares both over random jobs in every mode.
+// The partitioning utilization model is used by systolic_part_bench.cpp.
+// The controller cycle model at the end has the performance counters of
+// systolic_controller under the same names and CSR addresses, for diffing
+// against the RTL (systolic_perf_tb_top through DPI-C).
+//
+// Operands are the WIDTH-bit words of the a / b ports (row-major, as in
+// systolic_item::pack_a / pack_b), results the ACC_WIDTH-bit words of c.
+// Supports WIDTH <= 32 and ACC_WIDTH <= 64, both multiples of 4.
+//
+
+#ifndef SYSTOLIC_MODEL_H
+#define SYSTOLIC_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+// Precision modes: 1 << prec lanes of WIDTH >> prec bits
+#define SYSTOLIC_PREC_1X 0
+#define SYSTOLIC_PREC_2X 1
+#define SYSTOLIC_PREC_4X 2
+
+struct systolic_cfg_s {
+    int rows;
+    int cols;
+    int width;
+    int acc_width;
+};
+
+struct systolic_mode_s {
+    int prec;       // SYSTOLIC_PREC_*
+    bool lane_sum;  // Packed dot product (true) or independent lanes
+};
+
+// Lanes per element
+static inline int systolic_lanes(const systolic_mode_s& mode) { return 1 << mode.prec; }
+
+// One PE step: c_in + a * b in the given mode, as c_out of pe2_mp
+uint64_t systolic_pe_mac(const systolic_cfg_s& cfg, const systolic_mode_s& mode, uint64_t a, uint64_t b,
+                         uint64_t c_in);
+
+// Active weight of each PE (rows x cols words), as loaded by systolic_controller
+std::vector<uint64_t> systolic_pack_b(const systolic_cfg_s& cfg, const systolic_mode_s& mode,
+                                      const std::vector<uint64_t>& b);
+
+// c (rows x cols) of one job through the PE grid
+std::vector<uint64_t> systolic_array_ref(const systolic_cfg_s& cfg, const systolic_mode_s& mode,
+                                         const std::vector<uint64_t>& a, const std::vector<uint64_t>& b);
+
+// c (rows x cols) of one job from the lane elements
+std::vector<uint64_t> systolic_matmul_ref(const systolic_cfg_s& cfg, const systolic_mode_s& mode,
+                                          const std::vector<uint64_t>& a, const std::vector<uint64_t>& b);
+
+// Multiply-accumulates per job (rows * rows * cols * lanes)
+uint64_t systolic_job_macs(const systolic_cfg_s& cfg, const systolic_mode_s& mode);
+
+//------------------------------------------------------------------------------
+// Partitioning utilization model (systolic with PART_ROWS x PART_COLS)
+//------------------------------------------------------------------------------
+//
+// A trace of independent GEMMs runs in order, each split into array jobs of
+// A (rows x rows) * B (rows x cols), partial sums over k added by the host.
+// On the whole array the jobs of the trace issue back to back; partitioned,
+// every sub-array takes the next job as soon as it is free. Switching between
+// the two drains the array (part_active only follows part_mode when idle).
+// Cycle counts use the controller period and an approximate job latency.
+
+// C (m x n) = A (m x k) * B (k x n)
+struct systolic_gemm_s {
+    int m, k, n;
+};
+
+struct systolic_part_cfg_s {
+    int rows;
+    int cols;
+    int part_rows;  // Partitions down / across, must divide rows / cols
+    int part_cols;
+    int mul_latency;
+    int add_latency;
+};
+
+enum systolic_part_policy_e {
+    SYSTOLIC_PART_NEVER,     // Whole array only
+    SYSTOLIC_PART_ALWAYS,    // Partitions only
+    SYSTOLIC_PART_ADAPTIVE,  // Per GEMM, the cheapest mode sequence over the trace (jobs plus drains)
+};
+
+struct systolic_trace_stats_s {
+    uint64_t macs;         // Useful MACs (m * k * n over the trace)
+    uint64_t cycles;
+    uint64_t whole_jobs;
+    uint64_t part_jobs;
+    uint64_t switches;     // Mode switches (drains)
+    double utilization;    // macs / (cycles * rows * cols)
+};
+
+// Cycles between jobs of one controller: it loads the next B once the
+// b_update wavefront has reached the last PE
+int systolic_job_period(int rows, int cols, int add_latency);
+
+// Cycles from the start of a job's B load to its out_valid
+int systolic_job_latency(int rows, int cols, int mul_latency, int add_latency);
+
+// Jobs of a GEMM on a rows x cols (sub-)array
+uint64_t systolic_gemm_jobs(const systolic_gemm_s& gemm, int rows, int cols);
+
+systolic_trace_stats_s systolic_part_trace(const systolic_part_cfg_s& cfg, const std::vector<systolic_gemm_s>& trace,
+                                           systolic_part_policy_e policy);
+
+//------------------------------------------------------------------------------
+// Controller cycle model and performance counters (systolic_controller)
+//------------------------------------------------------------------------------
+//
+// Replays the registers of one controller cycle by cycle: input FIFO, B load
+// FSM, A streamer, C start delay and collection, and the b_update wavefront
+// of the array (b_update_done (ROWS-1) * ADD_LATENCY + COLS cycles after
+// b_update). The job port behaves as in systolic without partitions:
+// in_valid = in_request && in_ready.
+
+// Counter CSR word addresses, as PERF_* in systolic_controller
+enum systolic_perf_reg_e {
+    SYSTOLIC_PERF_CTRL,        // bit 0: enable, writing bit 1 clears
+    SYSTOLIC_PERF_CYCLES,
+    SYSTOLIC_PERF_BUSY,
+    SYSTOLIC_PERF_STALL,
+    SYSTOLIC_PERF_B_LOAD,
+    SYSTOLIC_PERF_B_UPDATE,
+    SYSTOLIC_PERF_DRAIN,
+    SYSTOLIC_PERF_FIFO_FULL,
+    SYSTOLIC_PERF_FIFO_EMPTY,
+    SYSTOLIC_PERF_JOBS,
+    SYSTOLIC_PERF_REGS
+};
+
+// Counters under their RTL register names (32 bits, wrapping)
+struct systolic_perf_s {
+    uint32_t perf_cycles;
+    uint32_t perf_busy;
+    uint32_t perf_stall;
+    uint32_t perf_b_load;
+    uint32_t perf_b_update;
+    uint32_t perf_drain;
+    uint32_t perf_fifo_full;
+    uint32_t perf_fifo_empty;
+    uint32_t perf_jobs;
+};
+
+struct systolic_ctrl_s {
+    int rows, cols, mul_latency, add_latency;
+    // Registers
+    int fifo_count;
+    int state;
+    int load_cnt;
+    bool b_update;
+    bool start_job;
+    bool a_active;
+    int a_timer;
+    std::vector<bool> c_start_sr;  // start_job delayed by C_START_DELAY, [0] newest
+    bool c_active;
+    int c_timer;
+    bool out_valid;
+    std::vector<bool> done_sr;     // b_update through the array to b_update_done, [0] newest
+    bool perf_enable;
+    systolic_perf_s perf;
+};
+
+// Controller after reset
+systolic_ctrl_s systolic_ctrl_init(int rows, int cols, int mul_latency, int add_latency);
+
+// in_ready of the current cycle
+bool systolic_ctrl_in_ready(const systolic_ctrl_s& ctrl);
+
+// One clock edge with in_request held in the cycle before it
+void systolic_ctrl_step(systolic_ctrl_s& ctrl, bool in_request);
+
+// CSR access; a write takes effect at the edge of the last step
+uint32_t systolic_ctrl_csr_read(const systolic_ctrl_s& ctrl, int addr);
+void systolic_ctrl_csr_write(systolic_ctrl_s& ctrl, int addr, uint32_t data);
+
+// Lower-case RTL name of a CSR (e.g. "perf_b_load")
+const char* systolic_perf_name(int addr);
+
+// DPI-C API over one controller model
+extern "C" void         c_systolic_perf_reset(const int rows, const int cols, const int mul_latency,
+                                              const int add_latency);
+extern "C" int          c_systolic_perf_step(const int in_request);  // Returns the in_ready of the cycle
+extern "C" unsigned int c_systolic_perf_read(const int addr);
+extern "C" void         c_systolic_perf_write(const int addr, const unsigned int data);
+
+#endif // SYSTOLIC_MODEL_H
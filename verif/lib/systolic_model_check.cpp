@@ -0,0 +1,177 @@
+// verif/lib/systolic_model_check.cpp
+//
+// Native self-check of the multi-precision systolic reference (systolic_model.cpp).
+//
+// For a set of array configurations and every precision mode, random jobs
+// (plus all-zero and all-ones operands) go through the bit-accurate PE grid
+// (controller B packing, split multiplier, segmented accumulator) and through
+// the plain matrix arithmetic the mode stands for; both must agree. The table
+// also lists the MACs per cycle of each mode at the array's issue rate of one
+// job per ROWS cycles.
+//
+// The controller cycle model must reproduce the job latency and period used
+// by the partitioning model (systolic_job_latency / systolic_job_period); its
+// performance counters are listed for a burst of 16 jobs offered back to back.
+//
+// Build and run (see native.mk):
+//   make -f native.mk systolic
+//   build/native/systolic_model_check [--jobs N] [--seed N]
+//
+// Returns non-zero on a mismatch.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "systolic_model.h"
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static const systolic_cfg_s cfg_list[] = {
+    {2, 2, 16, 40},  // systolic_mp_test
+    {4, 4, 16, 40},
+    {3, 5, 8, 20},
+    {4, 2, 32, 64},
+    {4, 4, 16, 16},  // Narrow accumulator, lane fields wrap
+};
+
+// Controller timing: rows, cols, mul_latency, add_latency
+static const int ctrl_list[][4] = {
+    {2, 2, 0, 1},
+    {4, 4, 0, 1},
+    {3, 5, 0, 0},
+    {8, 8, 1, 2},
+    {16, 16, 2, 3},
+};
+
+static void random_words(std::vector<uint64_t>& v, int width, uint64_t* state) {
+    const uint64_t mask = (width >= 64) ? ~0ULL : (1ULL << width) - 1;
+    for (uint64_t& w : v) {
+        w = rand_u64(state) & mask;
+    }
+}
+
+int main(int argc, char** argv) {
+    int jobs = 20000;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--jobs") && i + 1 < argc) {
+            jobs = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [--jobs N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+    uint64_t state = seed ? seed : 1;
+    int failures = 0;
+
+    printf("%-13s | %-5s | %-8s | %-8s | %-10s | %-7s | %-8s\n", "ARRAY", "LANES", "LANE_SUM", "MACS/JOB", "MACS/CYCLE",
+           "SPEEDUP", "MISMATCH");
+    for (const systolic_cfg_s& cfg : cfg_list) {
+        char name[32];
+        snprintf(name, sizeof(name), "%dx%d %d/%d", cfg.rows, cfg.cols, cfg.width, cfg.acc_width);
+        const double base_rate = (double)systolic_job_macs(cfg, {SYSTOLIC_PREC_1X, false}) / cfg.rows;
+
+        for (int prec = SYSTOLIC_PREC_1X; prec <= SYSTOLIC_PREC_4X; prec++) {
+            for (int lane_sum = 0; lane_sum < 2; lane_sum++) {
+                if (prec == SYSTOLIC_PREC_1X && lane_sum) {
+                    continue;  // Same as independent with one lane
+                }
+                const systolic_mode_s mode = {prec, lane_sum != 0};
+                std::vector<uint64_t> a(cfg.rows * cfg.rows), b(cfg.rows * cfg.cols);
+                int mismatches = 0;
+
+                for (int n = 0; n < jobs + 2; n++) {
+                    if (n < 2) {
+                        const uint64_t fill = n ? (1ULL << cfg.width) - 1 : 0;
+                        a.assign(a.size(), fill);
+                        b.assign(b.size(), fill);
+                    } else {
+                        random_words(a, cfg.width, &state);
+                        random_words(b, cfg.width, &state);
+                    }
+                    const std::vector<uint64_t> c_array = systolic_array_ref(cfg, mode, a, b);
+                    const std::vector<uint64_t> c_ref = systolic_matmul_ref(cfg, mode, a, b);
+                    if (c_array != c_ref) {
+                        if (!mismatches) {
+                            for (size_t k = 0; k < c_ref.size(); k++) {
+                                if (c_array[k] != c_ref[k]) {
+                                    fprintf(stderr, "%s lanes=%d lane_sum=%d job %d: c[%zu] array 0x%llx ref 0x%llx\n", name,
+                                            systolic_lanes(mode), lane_sum, n, k, (unsigned long long)c_array[k],
+                                            (unsigned long long)c_ref[k]);
+                                    break;
+                                }
+                            }
+                        }
+                        mismatches++;
+                    }
+                }
+
+                const double rate = (double)systolic_job_macs(cfg, mode) / cfg.rows;
+                printf("%-13s | %-5d | %-8s | %-8llu | %-10.0f | %-7.1f | %-8d\n", name, systolic_lanes(mode),
+                       lane_sum ? "yes" : "no", (unsigned long long)systolic_job_macs(cfg, mode), rate,
+                       rate / base_rate, mismatches);
+                failures += mismatches;
+            }
+        }
+    }
+
+    // Controller cycle model: single job latency, steady-state period, counters of a burst
+    int timing_failures = 0;
+    printf("\n%-13s | %-13s | %-13s", "CONTROLLER", "LATENCY/MODEL", "PERIOD/MODEL");
+    for (int r = SYSTOLIC_PERF_CYCLES; r < SYSTOLIC_PERF_REGS; r++) {
+        printf(" | %s", systolic_perf_name(r) + 5);
+    }
+    printf("\n");
+    for (const auto& c : ctrl_list) {
+        systolic_ctrl_s ctrl = systolic_ctrl_init(c[0], c[1], c[2], c[3]);
+        int load_at = -1, latency = -1;
+        for (int t = 0; latency < 0 && t < 10000; t++) {
+            if (ctrl.out_valid) latency = t - load_at;
+            systolic_ctrl_step(ctrl, t == 0);
+            if (load_at < 0 && ctrl.perf.perf_b_load) load_at = t;  // First B load cycle
+        }
+
+        ctrl = systolic_ctrl_init(c[0], c[1], c[2], c[3]);
+        int offered = 0, last_out = -1, period = -1;
+        for (int t = 0; t < 100000; t++) {
+            if (ctrl.out_valid) {
+                if (last_out >= 0) period = t - last_out;
+                last_out = t;
+            }
+            const bool request = offered < 16;
+            offered += request && systolic_ctrl_in_ready(ctrl);
+            systolic_ctrl_step(ctrl, request);
+            if (ctrl.perf.perf_jobs == 16) break;
+        }
+
+        const int latency_ref = systolic_job_latency(c[0], c[1], c[2], c[3]);
+        const int period_ref = systolic_job_period(c[0], c[1], c[3]);
+        timing_failures += (latency != latency_ref) + (period != period_ref);
+
+        char name[32], lat[32], per[32];
+        snprintf(name, sizeof(name), "%dx%d L%d+%d", c[0], c[1], c[2], c[3]);
+        snprintf(lat, sizeof(lat), "%d/%d", latency_ref, latency);
+        snprintf(per, sizeof(per), "%d/%d", period_ref, period);
+        printf("%-13s | %-13s | %-13s", name, lat, per);
+        for (int r = SYSTOLIC_PERF_CYCLES; r < SYSTOLIC_PERF_REGS; r++) {
+            printf(" | %*u", (int)strlen(systolic_perf_name(r) + 5), systolic_ctrl_csr_read(ctrl, r));
+        }
+        printf("\n");
+    }
+
+    printf("\n%s : %d jobs disagreed between the PE grid and the matrix reference, %d controller timing mismatches\n",
+           (failures || timing_failures) ? "FAIL" : "PASS", failures, timing_failures);
+    return (failures || timing_failures) ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+// verif/lib/systolic_part_bench.cpp
+//
+// Native utilization study of array partitioning (systolic with PART_ROWS x
+// PART_COLS, utilization model in systolic_model.cpp).
+//
+// For a set of array / partition shapes it generates random GEMM traces with
+// different size mixes and runs each trace on the whole array only, on the
+// partitions only, and adaptively (per GEMM, whichever finishes its jobs
+// sooner; a mode switch drains the array). Sizes are drawn per dimension:
+//   small - 1 .. sub-array size (a GEMM fits one partition),
+//   large - array size .. 4x array size,
+//   tiled - 1 .. 4x array size, multiples of the array size (no padded jobs).
+// The table shows the PE utilization (useful MACs / (cycles * PEs)) of each
+// policy, the adaptive speedup over the whole array and the mode switches.
+//
+// Build and run (see native.mk):
+//   make -f native.mk systolic_part
+//   build/native/systolic_part_bench [--rows N --cols N --part-rows N --part-cols N] [--gemms N] [--seed N]
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "systolic_model.h"
+
+static uint64_t rand_u64(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static const systolic_part_cfg_s cfg_list[] = {
+    {8, 8, 2, 2, 0, 1},
+    {16, 16, 2, 2, 0, 1},
+    {16, 16, 4, 4, 0, 1},
+    {16, 16, 2, 2, 2, 2},
+};
+
+struct bench_mix_s {
+    const char* name;
+    int small_pct;  // Percentage of small GEMMs
+    bool tiled;     // Others tiled rather than large
+};
+
+static const bench_mix_s mix_list[] = {
+    {"small", 100, false},
+    {"75/25", 75, false},
+    {"50/50", 50, false},
+    {"25/75", 25, false},
+    {"large", 0, false},
+    {"50/50t", 50, true},
+    {"tiled", 0, true},
+};
+
+static int rand_range(uint64_t* state, int lo, int hi) {
+    return lo + (int)(rand_u64(state) % (uint64_t)(hi - lo + 1));
+}
+
+static std::vector<systolic_gemm_s> make_trace(const systolic_part_cfg_s& cfg, const bench_mix_s& mix, int gemms,
+                                               uint64_t* state) {
+    const int sub_rows = cfg.rows / cfg.part_rows;
+    const int sub_cols = cfg.cols / cfg.part_cols;
+    std::vector<systolic_gemm_s> trace;
+    for (int i = 0; i < gemms; i++) {
+        if ((int)(rand_u64(state) % 100) < mix.small_pct) {
+            trace.push_back({rand_range(state, 1, sub_rows), rand_range(state, 1, sub_rows),
+                             rand_range(state, 1, sub_cols)});
+        } else if (mix.tiled) {
+            trace.push_back({cfg.rows * rand_range(state, 1, 4), cfg.rows * rand_range(state, 1, 4),
+                             cfg.cols * rand_range(state, 1, 4)});
+        } else {
+            trace.push_back({rand_range(state, cfg.rows, 4 * cfg.rows), rand_range(state, cfg.rows, 4 * cfg.rows),
+                             rand_range(state, cfg.cols, 4 * cfg.cols)});
+        }
+    }
+    return trace;
+}
+
+int main(int argc, char** argv) {
+    systolic_part_cfg_s one = {0, 0, 2, 2, 0, 1};
+    int gemms = 1000;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--rows") && i + 1 < argc) {
+            one.rows = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--cols") && i + 1 < argc) {
+            one.cols = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--part-rows") && i + 1 < argc) {
+            one.part_rows = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--part-cols") && i + 1 < argc) {
+            one.part_cols = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--gemms") && i + 1 < argc) {
+            gemms = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "Usage: %s [--rows N --cols N --part-rows N --part-cols N] [--gemms N] [--seed N]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<systolic_part_cfg_s> cfgs;
+    if (one.rows || one.cols) {
+        if (!one.rows) one.rows = one.cols;
+        if (!one.cols) one.cols = one.rows;
+        if (one.part_rows < 1 || one.part_cols < 1 || one.rows % one.part_rows || one.cols % one.part_cols) {
+            fprintf(stderr, "--part-rows / --part-cols must divide --rows / --cols\n");
+            return 2;
+        }
+        cfgs.push_back(one);
+    } else {
+        cfgs.assign(cfg_list, cfg_list + sizeof(cfg_list) / sizeof(cfg_list[0]));
+    }
+
+    printf("Utilization = useful MACs / (cycles * PEs), %d GEMMs per trace\n\n", gemms);
+    printf("%-7s | %-5s | %-7s | %-6s | %-11s | %-10s | %-14s | %-7s | %-8s\n", "ARRAY", "PARTS", "LAT M/A", "MIX",
+           "WHOLE UTIL%", "PART UTIL%", "ADAPTIVE UTIL%", "SPEEDUP", "SWITCHES");
+    for (const systolic_part_cfg_s& cfg : cfgs) {
+        for (const bench_mix_s& mix : mix_list) {
+            uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+            const std::vector<systolic_gemm_s> trace = make_trace(cfg, mix, gemms, &state);
+            const systolic_trace_stats_s whole = systolic_part_trace(cfg, trace, SYSTOLIC_PART_NEVER);
+            const systolic_trace_stats_s part = systolic_part_trace(cfg, trace, SYSTOLIC_PART_ALWAYS);
+            const systolic_trace_stats_s adaptive = systolic_part_trace(cfg, trace, SYSTOLIC_PART_ADAPTIVE);
+
+            char array[16], parts[16], lat[16];
+            snprintf(array, sizeof(array), "%dx%d", cfg.rows, cfg.cols);
+            snprintf(parts, sizeof(parts), "%dx%d", cfg.part_rows, cfg.part_cols);
+            snprintf(lat, sizeof(lat), "%d/%d", cfg.mul_latency, cfg.add_latency);
+            printf("%-7s | %-5s | %-7s | %-6s | %-11.1f | %-10.1f | %-14.1f | %-7.2f | %-8llu\n", array, parts, lat,
+                   mix.name, 100.0 * whole.utilization, 100.0 * part.utilization, 100.0 * adaptive.utilization,
+                   (double)whole.cycles / adaptive.cycles, (unsigned long long)adaptive.switches);
+        }
+    }
+    return 0;
+}
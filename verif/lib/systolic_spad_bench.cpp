@@ -0,0 +1,117 @@
+// verif/lib/systolic_spad_bench.cpp
+//
+// Native bandwidth study of the systolic tile subsystem (systolic_spad_model.cpp).
+//
+// For a set of array sizes and scratchpad bank counts it places the A, B and
+// C tiles in the scratchpad as sub-blocks of larger row-major matrices with
+// different row pitches:
+//   dense  - pitch = tile width (tiles stored back to back);
+//   pow2   - pitch 64 (rows of a 64-wide matrix): with tile rows narrower than
+//            the read port, consecutive rows start in the same bank;
+//   padded - pitch 64 + tile width, which skews consecutive rows by a tile
+//            row across the banks;
+// and, per layout, with the tiles resident in the scratchpad (reused by every
+// job) or written by the host for each job (one word per cycle). The table
+// shows the fetch / writeback cycles and conflicts of one job, the period of
+// each stage, the stage that bounds the job rate and the resulting MACs per
+// cycle and PE utilization.
+//
+// Build and run (see native.mk):
+//   make -f native.mk spad
+//   build/native/systolic_spad_bench [--rows N --cols N --banks N] [--add-latency N]
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "systolic_spad_model.h"
+
+struct bench_layout_s {
+    const char* name;
+    int pitch;  // 0: tile width
+    int pad;    // Added tile width
+};
+
+static const bench_layout_s layouts[] = {
+    {"dense", 0, 0},
+    {"pow2", 64, 0},
+    {"padded", 64, 1},
+};
+
+static const int size_list[] = {4, 8, 16};
+static const int bank_list[] = {4, 8, 16};
+
+static int layout_pitch(const bench_layout_s& l, int width) {
+    return (l.pitch ? l.pitch : width) + l.pad * width;
+}
+
+static void bench_row(const spad_cfg_s& cfg, const bench_layout_s& l, bool reuse) {
+    spad_job_s job;
+    job.a_base = 0;
+    job.a_stride = layout_pitch(l, cfg.rows);
+    job.b_base = cfg.ab_half_depth / 2;
+    job.b_stride = layout_pitch(l, cfg.cols);
+    job.c_base = 0;
+    job.c_stride = layout_pitch(l, cfg.cols);
+    job.host_words = reuse ? 0 : cfg.rows * cfg.rows + cfg.rows * cfg.cols;
+
+    const spad_job_stats_s st = spad_job(cfg, job);
+    const double macs = (double)cfg.rows * cfg.rows * cfg.cols / st.period;
+    char array[16], periods[32];
+    snprintf(array, sizeof(array), "%dx%d", cfg.rows, cfg.cols);
+    snprintf(periods, sizeof(periods), "%d/%d/%d/%d", st.period_controller, st.period_fetch, st.period_wb,
+             st.period_host);
+    printf("%-7s | %-5d | %-6s | %-5s | %-9llu | %-9llu | %-9llu | %-9llu | %-15s | %-10s | %-10.1f | %-5.1f\n", array,
+           cfg.banks, l.name, reuse ? "yes" : "no", (unsigned long long)st.fetch.cycles,
+           (unsigned long long)st.fetch.conflicts, (unsigned long long)st.wb.cycles,
+           (unsigned long long)st.wb.conflicts, periods, spad_bound_name(st.bound), macs,
+           100.0 * macs / (cfg.rows * cfg.cols));
+}
+
+int main(int argc, char** argv) {
+    int rows = 0, cols = 0, banks = 0, add_latency = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--rows") && i + 1 < argc) {
+            rows = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--cols") && i + 1 < argc) {
+            cols = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--banks") && i + 1 < argc) {
+            banks = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--add-latency") && i + 1 < argc) {
+            add_latency = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Usage: %s [--rows N --cols N --banks N] [--add-latency N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (banks & (banks - 1)) {
+        fprintf(stderr, "--banks must be a power of two\n");
+        return 2;
+    }
+
+    std::vector<spad_cfg_s> cfgs;
+    if (rows || cols || banks) {
+        cfgs.push_back({rows ? rows : 4, cols ? cols : (rows ? rows : 4), banks ? banks : 4, 4096, 4096, add_latency});
+    } else {
+        for (int size : size_list) {
+            for (int b : bank_list) {
+                cfgs.push_back({size, size, b, 4096, 4096, add_latency});
+            }
+        }
+    }
+
+    printf("Periods: controller/fetch/writeback/host cycles per job\n\n");
+    printf("%-7s | %-5s | %-6s | %-5s | %-9s | %-9s | %-9s | %-9s | %-15s | %-10s | %-10s | %-5s\n", "ARRAY", "BANKS",
+           "LAYOUT", "REUSE", "FETCH CYC", "FETCH CFL", "WB CYC", "WB CFL", "PERIODS", "BOUND", "MACS/CYCLE", "UTIL%");
+    for (const spad_cfg_s& cfg : cfgs) {
+        for (const bench_layout_s& l : layouts) {
+            bench_row(cfg, l, true);
+        }
+        bench_row(cfg, layouts[0], false);
+    }
+    return 0;
+}
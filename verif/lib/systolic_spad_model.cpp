@@ -0,0 +1,97 @@
+// verif/lib/systolic_spad_model.cpp
+//
+// Bandwidth and bank-conflict model of the systolic tile subsystem.
+// See systolic_spad_model.h for the overview.
+//
+
+#include <algorithm>
+
+#include "systolic_spad_model.h"
+
+static const char* const bound_names[4] = {"controller", "fetch", "writeback", "host"};
+
+std::vector<uint32_t> spad_tile_addrs(int rows, int cols, int base, int stride, int depth) {
+    std::vector<uint32_t> addrs;
+    addrs.reserve(rows * cols);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            addrs.push_back((uint32_t)(base + r * stride + c) % depth);
+        }
+    }
+    return addrs;
+}
+
+int spad_grant_prefix(const uint32_t* addrs, int lanes, int banks, bool* conflict) {
+    uint64_t used = 0;
+    *conflict = false;
+    for (int n = 0; n < lanes; n++) {
+        const uint64_t bank = 1ULL << (addrs[n] % banks);
+        if (used & bank) {
+            *conflict = true;
+            return n;
+        }
+        used |= bank;
+    }
+    return lanes;
+}
+
+spad_stream_s spad_stream(const std::vector<uint32_t>& addrs, int banks) {
+    spad_stream_s s = {0, 0, addrs.size()};
+    size_t ptr = 0;
+    while (ptr < addrs.size()) {
+        bool conflict;
+        const int lanes = (int)std::min<size_t>(banks, addrs.size() - ptr);
+        ptr += spad_grant_prefix(&addrs[ptr], lanes, banks, &conflict);
+        s.cycles++;
+        s.conflicts += conflict;
+    }
+    return s;
+}
+
+spad_job_stats_s spad_job(const spad_cfg_s& cfg, const spad_job_s& job) {
+    spad_job_stats_s st;
+
+    // A then B on the same read port, no idle cycle between them
+    const spad_stream_s a = spad_stream(spad_tile_addrs(cfg.rows, cfg.rows, job.a_base, job.a_stride, cfg.ab_half_depth),
+                                        cfg.banks);
+    const spad_stream_s b = spad_stream(spad_tile_addrs(cfg.rows, cfg.cols, job.b_base, job.b_stride, cfg.ab_half_depth),
+                                        cfg.banks);
+    st.fetch = {a.cycles + b.cycles, a.conflicts + b.conflicts, a.words + b.words};
+    st.wb = spad_stream(spad_tile_addrs(cfg.rows, cfg.cols, job.c_base, job.c_stride, cfg.c_half_depth), cfg.banks);
+
+    st.period_controller = cfg.rows + (cfg.rows - 1) * cfg.add_latency + cfg.cols + 1;
+    st.period_fetch = (int)st.fetch.cycles + 3;
+    st.period_wb = (int)st.wb.cycles + 1;
+    st.period_host = job.host_words;
+
+    const int periods[4] = {st.period_controller, st.period_fetch, st.period_wb, st.period_host};
+    st.bound = SPAD_BOUND_CONTROLLER;
+    for (int i = 1; i < 4; i++) {
+        if (periods[i] > periods[st.bound]) {
+            st.bound = (spad_bound_e)i;
+        }
+    }
+    st.period = periods[st.bound];
+    return st;
+}
+
+const char* spad_bound_name(spad_bound_e bound) {
+    return bound_names[bound];
+}
+
+//------------------------------------------------------------------------------
+// DPI-C API
+//------------------------------------------------------------------------------
+
+extern "C" void c_spad_job(int rows, int cols, int banks, int ab_half_depth, int c_half_depth, int add_latency,
+                           int a_base, int a_stride, int b_base, int b_stride, int c_base, int c_stride,
+                           int* fetch_cycles, int* fetch_conflicts, int* wb_cycles, int* wb_conflicts, int* period) {
+    const spad_cfg_s cfg = {rows, cols, banks, ab_half_depth, c_half_depth, add_latency};
+    const spad_job_s job = {a_base, a_stride, b_base, b_stride, c_base, c_stride, 0};
+    const spad_job_stats_s st = spad_job(cfg, job);
+    *fetch_cycles = (int)st.fetch.cycles;
+    *fetch_conflicts = (int)st.fetch.conflicts;
+    *wb_cycles = (int)st.wb.cycles;
+    *wb_conflicts = (int)st.wb.conflicts;
+    *period = st.period;
+}
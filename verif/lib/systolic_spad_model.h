@@ -0,0 +1,88 @@
+// verif/lib/systolic_spad_model.h
+//
+// Bandwidth and bank-conflict model of the systolic tile subsystem
+// (rtl/verilog/systolic/systolic_tile.v).
+//
+// Per job it replays what the RTL does with the job's tile addresses:
+//   - fetch: the A tile (rows x rows) and then the B tile (rows x cols) are
+//     read from the AB scratchpad, up to `banks` lanes per cycle, granted in
+//     lane order until a lane hits a bank already in use (spad.v);
+//   - writeback: the C tile (rows x cols) is written to the C scratchpad the
+//     same way.
+// Cycles and conflicts match the perf_fetch_* / perf_wb_* counters exactly.
+//
+// The steady-state job period is the slowest of the stages that overlap:
+//   - controller: rows + (rows - 1) * add_latency + cols + 1 cycles from one
+//     B load to the next (systolic_controller waits for the b_update wavefront
+//     to reach the last PE before loading the next B);
+//   - fetch: fetch cycles + 3 (start, last read data, hand-off);
+//   - writeback: writeback cycles + 1 (start);
+//   - host: words the host writes per job (one per cycle), 0 if the tiles are
+//     reused from the scratchpad.
+//
+// Used natively by systolic_spad_bench.cpp and from the tile testbench
+// through DPI-C (c_spad_job).
+//
+
+#ifndef SYSTOLIC_SPAD_MODEL_H
+#define SYSTOLIC_SPAD_MODEL_H
+
+#include <cstdint>
+#include <vector>
+
+struct spad_cfg_s {
+    int rows;
+    int cols;
+    int banks;          // Power of two
+    int ab_half_depth;  // Words per AB half (tile offsets wrap modulo this)
+    int c_half_depth;
+    int add_latency;
+};
+
+// Tile addresses are offsets within the half of the job
+struct spad_job_s {
+    int a_base, a_stride;
+    int b_base, b_stride;
+    int c_base, c_stride;
+    int host_words;  // Words the host writes for this job
+};
+
+struct spad_stream_s {
+    uint64_t cycles;     // Cycles with at least one lane granted
+    uint64_t conflicts;  // Cycles cut short by a bank conflict
+    uint64_t words;
+};
+
+enum spad_bound_e { SPAD_BOUND_CONTROLLER, SPAD_BOUND_FETCH, SPAD_BOUND_WRITEBACK, SPAD_BOUND_HOST };
+
+struct spad_job_stats_s {
+    spad_stream_s fetch;
+    spad_stream_s wb;
+    int period_controller;
+    int period_fetch;
+    int period_wb;
+    int period_host;
+    int period;          // Steady-state cycles per job
+    spad_bound_e bound;  // Stage that sets the period
+};
+
+// Row-major tile addresses, element (r, c) at (base + r * stride + c) % depth
+std::vector<uint32_t> spad_tile_addrs(int rows, int cols, int base, int stride, int depth);
+
+// Lanes granted for the next lanes (<= banks) of a request list, conflict set
+// if the prefix stopped on a bank in use
+int spad_grant_prefix(const uint32_t* addrs, int lanes, int banks, bool* conflict);
+
+// Streams an address list through the scratchpad port
+spad_stream_s spad_stream(const std::vector<uint32_t>& addrs, int banks);
+
+spad_job_stats_s spad_job(const spad_cfg_s& cfg, const spad_job_s& job);
+
+const char* spad_bound_name(spad_bound_e bound);
+
+// DPI-C API
+extern "C" void c_spad_job(int rows, int cols, int banks, int ab_half_depth, int c_half_depth, int add_latency,
+                           int a_base, int a_stride, int b_base, int b_stride, int c_base, int c_stride,
+                           int* fetch_cycles, int* fetch_conflicts, int* wb_cycles, int* wb_conflicts, int* period);
+
+#endif // SYSTOLIC_SPAD_MODEL_H
@@ -0,0 +1,19 @@
+// verif/lib/trans_batch.sv
+// Batch of completed transactions, published by fp_monitor_base in burst mode.
+//
+// The monitor reuses one batch object and releases its items to obj_pool
+// after the write, so subscribers copy what they keep.
+
+`include "uvm_macros.svh"
+import uvm_pkg::*;
+
+class trans_batch #(type T = uvm_sequence_item) extends uvm_object;
+    `uvm_object_param_utils(trans_batch #(T))
+
+    T items[$];
+
+    function new(string name = "trans_batch");
+        super.new(name);
+    endfunction
+
+endclass
@@ -0,0 +1,27 @@
+// verif/tests/fp_add/fp_add_burst_test.sv
+// Test that streams pre-generated operand arrays, one operand set per clock (fp_sequence2_burst).
+
+`include "uvm_macros.svh"
+import uvm_pkg::*;
+import fp_lib_pkg::*;
+
+class fp_add_burst_test #(
+    parameter int WIDTH = 16
+) extends fp_add_base_test #(WIDTH);
+    // `uvm_component_param_utils(fp_add_burst_test #(WIDTH))
+    `my_uvm_component_param_utils(fp_add_burst_test #(WIDTH), "fp_add_burst_test")
+
+    function new(string name = "fp_add_burst_test", uvm_component parent);
+        super.new(name, parent);
+    endfunction
+
+    virtual task run_phase(uvm_phase phase);
+        fp_sequence2_burst #(WIDTH) seq;
+        phase.raise_objection(this);
+        seq = fp_sequence2_burst #(WIDTH)::type_id::create("seq");
+        seq.start(env.agent.seqr);
+        #100ns;
+        phase.drop_objection(this);
+    endtask
+
+endclass
@@ -33,4 +33,11 @@ class fp_add_driver #(
         `uvm_info("DRIVER", $sformatf("Drove transaction: a=0x%h, b=0x%h, rm=%s", trans.inputs[0], trans.inputs[1], rm_str), UVM_HIGH)
     endtask
 
+    // Burst mode: one element of the burst arrays, no per-element logging
+    virtual task drive_burst_element(fp_transaction2 #(WIDTH) trans, int i);
+        vif.a <= trans.burst_a[i];
+        vif.b <= trans.burst_b[i];
+        vif.rm <= trans.burst_rm[i];
+    endtask
+
 endclass
@@ -13,6 +13,8 @@ import uvm_pkg::*;
 // bit [31:0] : int unsigned      : uint32_t
 // bit [63:0] : longint unsigned  : uint64_t
 import "DPI-C" function longint unsigned  c_fp_add(longint  unsigned a, longint  unsigned b, int width, int rm);
+// Dual-path predictor (fp_fast.c): host FPU where it provably matches c_fp_add, with +FAST_MODEL
+import "DPI-C" function longint unsigned  c_fp_add_fast(longint  unsigned a, longint  unsigned b, int width, int rm);
 
 class fp_add_model #(
     parameter int WIDTH = 16
@@ -25,10 +27,27 @@ class fp_add_model #(
     endfunction
 
     // The predict function is extremely simple as a wrapper over C implementation.
+    // It writes into the caller's preallocated golden object if there is one.
     virtual function void predict(fp_transaction2 #(WIDTH) trans_in, ref fp_transaction2 #(WIDTH) trans_out);
-        trans_out = new trans_in;
+        if (trans_out == null) begin
+            trans_out = new trans_in;
+        end else begin
+            trans_out.inputs = trans_in.inputs;
+            trans_out.rm = trans_in.rm;
+        end
         // Call the imported C function to get the golden result
-        trans_out.result = c_fp_add(trans_in.inputs[0], trans_in.inputs[1], WIDTH, trans_in.rm);
+        if (fast)
+            trans_out.result = c_fp_add_fast(trans_in.inputs[0], trans_in.inputs[1], WIDTH, trans_in.rm);
+        else
+            trans_out.result = c_fp_add(trans_in.inputs[0], trans_in.inputs[1], WIDTH, trans_in.rm);
+        sample_cov(trans_in.inputs[0], trans_in.inputs[1], trans_in.rm);
+    endfunction
+
+    virtual function string report();
+        string s = cov_report();
+        if (fast)
+            s = (s == "") ? fast_report(0) : {fast_report(0), "\n", s};
+        return s;
     endfunction
 
 endclass
@@ -18,7 +18,7 @@ class fp_add_monitor #(
     // It only creates and returns a transaction if inputs are valid.
     virtual task sample_inputs(output fp_transaction2 #(WIDTH) trans);
         if (! (^vif.monitor_cb.a === 1'bx) && ! (^vif.monitor_cb.b === 1'bx)) begin
-            trans = fp_transaction2 #(WIDTH)::type_id::create("trans_input");
+            trans = obj_pool #(fp_transaction2 #(WIDTH))::get("trans_input");
             trans.inputs[0] = vif.monitor_cb.a;
             trans.inputs[1] = vif.monitor_cb.b;
             trans.rm = vif.monitor_cb.rm;
@@ -19,6 +19,9 @@ package fp_add_pkg;
     // Sequences & Tests
     `include "fp_add_base_test.sv"
     `include "fp_add_random_test.sv"
+    `include "fp_add_steered_test.sv"
+    `include "fp_add_inverse_test.sv"
+    `include "fp_add_burst_test.sv"
     `include "fp_add_special_cases_sequence.sv"
     `include "fp_add_special_cases_test.sv"
     `include "fp_add_combined_sequence.sv"
@@ -0,0 +1,29 @@
+// verif/tests/fp_add/fp_add_steered_test.sv
+// Test that runs the coverage-steered sequence until all coverage bins are hit.
+
+`include "uvm_macros.svh"
+import uvm_pkg::*;
+import fp_lib_pkg::*;
+
+class fp_add_steered_test #(
+    parameter int WIDTH = 16
+) extends fp_add_base_test #(WIDTH);
+    // `uvm_component_param_utils(fp_add_steered_test #(WIDTH))
+    `my_uvm_component_param_utils(fp_add_steered_test #(WIDTH), "fp_add_steered_test")
+
+    function new(string name = "fp_add_steered_test", uvm_component parent);
+        super.new(name, parent);
+    endfunction
+
+    virtual task run_phase(uvm_phase phase);
+        fp_sequence2_steered #(WIDTH) seq;
+        phase.raise_objection(this);
+        seq = fp_sequence2_steered #(WIDTH)::type_id::create("seq");
+        seq.op = 0; // fp_add
+        seq.model = env.model;
+        seq.start(env.agent.seqr);
+        #100ns;
+        phase.drop_objection(this);
+    endtask
+
+endclass
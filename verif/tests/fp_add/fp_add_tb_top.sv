@@ -46,6 +46,9 @@ module fp_add_tb_top;
     // Define each test component that this testbench can be ran with (using +UVM_TESTNAME=...)
     typedef fp_add_special_cases_test #(WIDTH) fp_add_special_cases_test_t;
     typedef fp_add_random_test        #(WIDTH) fp_add_random_test_t;
+    typedef fp_add_steered_test       #(WIDTH) fp_add_steered_test_t;
+    typedef fp_add_inverse_test       #(WIDTH) fp_add_inverse_test_t;
+    typedef fp_add_burst_test         #(WIDTH) fp_add_burst_test_t;
     typedef fp_add_combined_test      #(WIDTH) fp_add_combined_test_t;
 
     // Main test execution block
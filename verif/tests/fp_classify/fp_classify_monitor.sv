@@ -18,7 +18,7 @@ class fp_classify_monitor #(
     // It only creates and returns a transaction if inputs are valid.
     virtual task sample_inputs(output fp_classify_transaction #(WIDTH) trans);
         if (! (^vif.monitor_cb.in === 1'bx)) begin
-            trans = fp_classify_transaction #(WIDTH)::type_id::create("trans_input");
+            trans = obj_pool #(fp_classify_transaction #(WIDTH))::get("trans_input");
             trans.inputs[0] = vif.monitor_cb.in;
         end else begin
             trans = null;
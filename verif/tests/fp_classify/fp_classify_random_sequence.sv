@@ -19,7 +19,7 @@ class fp_classify_random_sequence #(
     virtual task body();
         fp_classify_transaction #(WIDTH) req;
         repeat (num_trans) begin
-            req = fp_classify_transaction #(WIDTH)::type_id::create("req");
+            req = obj_pool #(fp_classify_transaction #(WIDTH))::get("req");  // Released by the monitor
             start_item(req);
             assert(req.randomize());
             finish_item(req);
@@ -90,7 +90,14 @@ class fp_classify_transaction #(
         return s;
     endfunction
 
-    // Override compare for the struct-based result
+    // Override matches / compare for the struct-based result: the base class
+    // 'result' is shadowed and never written
+    virtual function bit matches(uvm_sequence_item golden_trans_item);
+        fp_classify_transaction #(WIDTH) golden_trans;
+        if (!$cast(golden_trans, golden_trans_item)) return 0;
+        return result == golden_trans.result;
+    endfunction
+
     virtual function string compare(input uvm_sequence_item golden_trans_item, output bit is_match);
         fp_classify_transaction #(WIDTH) golden_trans;
         if (!$cast(golden_trans, golden_trans_item)) begin
@@ -32,6 +32,7 @@ class fp_mul_env #(
     function void connect_phase(uvm_phase phase);
         super.connect_phase(phase);
         agent.monitor.ap.connect(scoreboard.ap);
+        agent.monitor.batch_ap.connect(scoreboard.batch_ap);
     endfunction
 
 endclass
@@ -0,0 +1,28 @@
+// verif/tests/fp_mul/fp_mul_inverse_test.sv
+// Test that drives operands constructed for each targeted result property (fp_inverse.c).
+
+`include "uvm_macros.svh"
+import uvm_pkg::*;
+import fp_lib_pkg::*;
+
+class fp_mul_inverse_test #(
+    parameter int WIDTH = 16
+) extends fp_mul_base_test #(WIDTH);
+    // `uvm_component_param_utils(fp_mul_inverse_test #(WIDTH))
+    `my_uvm_component_param_utils(fp_mul_inverse_test #(WIDTH), "fp_mul_inverse_test")
+
+    function new(string name = "fp_mul_inverse_test", uvm_component parent);
+        super.new(name, parent);
+    endfunction
+
+    virtual task run_phase(uvm_phase phase);
+        fp_sequence2_inverse #(WIDTH) seq;
+        phase.raise_objection(this);
+        seq = fp_sequence2_inverse #(WIDTH)::type_id::create("seq");
+        seq.op = 1; // fp_mul
+        seq.start(env.agent.seqr);
+        #100ns;
+        phase.drop_objection(this);
+    endtask
+
+endclass
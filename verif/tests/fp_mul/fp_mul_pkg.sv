@@ -19,6 +19,9 @@ package fp_mul_pkg;
     // Sequences & Tests
     `include "fp_mul_base_test.sv"
     `include "fp_mul_random_test.sv"
+    `include "fp_mul_steered_test.sv"
+    `include "fp_mul_inverse_test.sv"
+    `include "fp_mul_burst_test.sv"
     `include "fp_mul_special_cases_sequence.sv"
     `include "fp_mul_special_cases_test.sv"
     `include "fp_mul_combined_sequence.sv"
@@ -43,6 +43,9 @@ module fp_mul_tb_top;
     // Define each test component that this testbench can be ran with (using +UVM_TESTNAME=...)
     typedef fp_mul_special_cases_test #(WIDTH) fp_mul_special_cases_test_t;
     typedef fp_mul_random_test        #(WIDTH) fp_mul_random_test_t;
+    typedef fp_mul_steered_test       #(WIDTH) fp_mul_steered_test_t;
+    typedef fp_mul_inverse_test       #(WIDTH) fp_mul_inverse_test_t;
+    typedef fp_mul_burst_test         #(WIDTH) fp_mul_burst_test_t;
     typedef fp_mul_combined_test      #(WIDTH) fp_mul_combined_test_t;
 
     // Main test execution block
@@ -0,0 +1,115 @@
+// verif/tests/fp_multi/fp_multi_pkg.sv
+// Test package of the combined fp_add / fp_mul / fp_classify testbench top.
+//
+// fp_multi_test builds one unmodified single-unit test per selected unit as
+// its child, named <dut>_<width>, for example uvm_test_top.fp_add_32.env.
+// The units are selected with
+//
+//   +FP_MULTI=<dut>:<width>[:<test>],...
+//
+// where <test> is the test name without the DUT prefix (default
+// combined_test), e.g. +FP_MULTI=fp_add:32,fp_mul:32:random_test. Without
+// the plusarg every unit runs its combined_test. The child tests run
+// concurrently, each on its own unit, and the simulation ends when all of
+// them dropped their objections. A unit can be selected only once.
+//
+// Other plusargs (+SB_VERBOSE, +BURST_LEN, +COV_SEED, ...) apply to every
+// child test that reads them.
+
+package fp_multi_pkg;
+    import uvm_pkg::*;
+    `include "uvm_macros.svh"
+
+    import fp_add_pkg::*;
+    import fp_mul_pkg::*;
+    import fp_classify_pkg::*;
+
+    // Creates the child test if the test name matches, for one of the widths
+    `define FP_MULTI_CREATE(PKG, TEST) \
+        if (kind == `"TEST`") begin \
+            case (width) \
+                16: return PKG::TEST #(16)::type_id::create(name, this); \
+                32: return PKG::TEST #(32)::type_id::create(name, this); \
+                64: return PKG::TEST #(64)::type_id::create(name, this); \
+                default: return null; \
+            endcase \
+        end
+
+    class fp_multi_test extends uvm_test;
+        `uvm_component_utils(fp_multi_test)
+
+        uvm_test tests[string];  // Child tests by <dut>_<width>
+
+        function new(string name = "fp_multi_test", uvm_component parent);
+            super.new(name, parent);
+        endfunction
+
+        // Child test <dut>_<test> #(width), null if there is no such test
+        function uvm_test create_test(string dut, int width, string test, string name);
+            string kind = {dut, "_", test};
+            `FP_MULTI_CREATE(fp_add_pkg, fp_add_special_cases_test)
+            `FP_MULTI_CREATE(fp_add_pkg, fp_add_random_test)
+            `FP_MULTI_CREATE(fp_add_pkg, fp_add_steered_test)
+            `FP_MULTI_CREATE(fp_add_pkg, fp_add_inverse_test)
+            `FP_MULTI_CREATE(fp_add_pkg, fp_add_burst_test)
+            `FP_MULTI_CREATE(fp_add_pkg, fp_add_combined_test)
+            `FP_MULTI_CREATE(fp_mul_pkg, fp_mul_special_cases_test)
+            `FP_MULTI_CREATE(fp_mul_pkg, fp_mul_random_test)
+            `FP_MULTI_CREATE(fp_mul_pkg, fp_mul_steered_test)
+            `FP_MULTI_CREATE(fp_mul_pkg, fp_mul_inverse_test)
+            `FP_MULTI_CREATE(fp_mul_pkg, fp_mul_burst_test)
+            `FP_MULTI_CREATE(fp_mul_pkg, fp_mul_combined_test)
+            `FP_MULTI_CREATE(fp_classify_pkg, fp_classify_special_cases_test)
+            `FP_MULTI_CREATE(fp_classify_pkg, fp_classify_random_test)
+            `FP_MULTI_CREATE(fp_classify_pkg, fp_classify_combined_test)
+            return null;
+        endfunction
+
+        // Splits s at every sep
+        static function void split(string s, byte sep, ref string parts[$]);
+            int start = 0;
+            parts.delete();
+            for (int i = 0; i <= s.len(); i++) begin
+                if (i == s.len() || s[i] == sep) begin
+                    parts.push_back(s.substr(start, i - 1));
+                    start = i + 1;
+                end
+            end
+        endfunction
+
+        virtual function void build_phase(uvm_phase phase);
+            string spec = "fp_add:16,fp_add:32,fp_add:64,fp_mul:16,fp_mul:32,fp_mul:64,fp_classify:16,fp_classify:32,fp_classify:64";
+            string entries[$];
+            super.build_phase(phase);
+
+            void'($value$plusargs("FP_MULTI=%s", spec));
+            split(spec, ",", entries);
+            foreach (entries[i]) begin
+                string fields[$];
+                string test = "combined_test";
+                string name;
+                int width;
+
+                split(entries[i], ":", fields);
+                if (fields.size() < 2 || fields.size() > 3) begin
+                    `uvm_fatal(get_type_name(), $sformatf("Bad +FP_MULTI entry '%s', expected <dut>:<width>[:<test>]", entries[i]))
+                end
+                width = fields[1].atoi();
+                if (fields.size() == 3) test = fields[2];
+                name = $sformatf("%s_%0d", fields[0], width);
+                if (tests.exists(name)) begin
+                    `uvm_fatal(get_type_name(), $sformatf("%s is selected twice in +FP_MULTI", name))
+                end
+                tests[name] = create_test(fields[0], width, test, name);
+                if (tests[name] == null) begin
+                    `uvm_fatal(get_type_name(), $sformatf("No test %s_%s for WIDTH=%0d", fields[0], test, width))
+                end
+                `uvm_info(get_type_name(), $sformatf("%s: %s_%s", name, fields[0], test), UVM_LOW)
+            end
+        endfunction
+
+    endclass
+
+    `undef FP_MULTI_CREATE
+
+endpackage
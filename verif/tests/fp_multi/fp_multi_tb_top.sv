@@ -0,0 +1,100 @@
+// verif/tests/fp_multi/fp_multi_tb_top.sv
+// Testbench top with fp_add, fp_mul and fp_classify at WIDTH 16, 32 and 64.
+//
+// All nine units are elaborated once, each with its own interface, on a
+// common clock and reset. fp_multi_test (fp_multi_pkg.sv)
+// selects at run time which of them get a test, so one elaborated image runs
+// any mix of the single-unit tests, several of them concurrently:
+//
+//   make -f dsim.mk run DUT=fp_multi TEST=test PLUSARGS="+FP_MULTI=fp_add:32,fp_mul:16:random_test"
+//
+// The virtual interface and the pipeline latency of each unit are set for
+// the subtree of its test only (uvm_test_top.<dut>_<width>), so the tests
+// do not see each other's configuration.
+
+`include "uvm_macros.svh"
+import uvm_pkg::*;
+import fp_multi_pkg::*;
+
+module fp_multi_tb_top;
+    // Not used: every width is elaborated. Declared so that the dsim.mk
+    // command line (-defparam WIDTH=...) applies unchanged.
+    parameter int WIDTH = 16;
+
+    // Clock and Reset signals
+    bit clk;
+    logic rst_n;
+
+    for (genvar i = 0; i < 3; i++) begin : g_width
+        localparam int W = 16 << i;  // 16, 32, 64
+
+        fp_add_if      #(W) add_if (clk, rst_n);
+        fp_mul_if      #(W) mul_if (clk, rst_n);
+        fp_classify_if #(W) classify_if (clk, rst_n);
+
+        fp_add #(W) add_dut (
+            .clk(add_if.clk),
+            .rst_n(add_if.rst_n),
+            .a(add_if.a),
+            .b(add_if.b),
+            .rm(add_if.rm),
+            .result(add_if.result)
+        );
+
+        fp_mul #(W) mul_dut (
+            .clk(mul_if.clk),
+            .rst_n(mul_if.rst_n),
+            .a(mul_if.a),
+            .b(mul_if.b),
+            .rm(mul_if.rm),
+            .result(mul_if.result)
+        );
+
+        fp_classify #(W) classify_dut (
+            .in             (classify_if.in             ),
+            .is_snan        (classify_if.is_snan        ),
+            .is_qnan        (classify_if.is_qnan        ),
+            .is_neg_inf     (classify_if.is_neg_inf     ),
+            .is_neg_normal  (classify_if.is_neg_normal  ),
+            .is_neg_denormal(classify_if.is_neg_denormal),
+            .is_neg_zero    (classify_if.is_neg_zero    ),
+            .is_pos_zero    (classify_if.is_pos_zero    ),
+            .is_pos_denormal(classify_if.is_pos_denormal),
+            .is_pos_normal  (classify_if.is_pos_normal  ),
+            .is_pos_inf     (classify_if.is_pos_inf     )
+        );
+
+        // Configuration of each unit, visible to its own test subtree only
+        initial begin
+            string add_scope      = $sformatf("uvm_test_top.fp_add_%0d*", W);
+            string mul_scope      = $sformatf("uvm_test_top.fp_mul_%0d*", W);
+            string classify_scope = $sformatf("uvm_test_top.fp_classify_%0d*", W);
+
+            uvm_config_db#(virtual fp_add_if #(W))::set(null, add_scope, "dut_vif", add_if);
+            uvm_config_db#(int)::set(null, add_scope, "pipeline_latency", int'(add_dut.PIPELINE_LATENCY));
+            uvm_config_db#(virtual fp_mul_if #(W))::set(null, mul_scope, "dut_vif", mul_if);
+            uvm_config_db#(int)::set(null, mul_scope, "pipeline_latency", int'(mul_dut.PIPELINE_LATENCY));
+            uvm_config_db#(virtual fp_classify_if #(W))::set(null, classify_scope, "dut_vif", classify_if);
+            uvm_config_db#(int)::set(null, classify_scope, "pipeline_latency", int'(classify_dut.PIPELINE_LATENCY));
+        end
+    end
+
+    // Clock generator
+    initial begin
+        clk = 0;
+        forever #5ns clk = ~clk; // 10ns period, 100MHz clock
+    end
+
+    // Reset generator
+    initial begin
+        rst_n = 0;
+        repeat(5) @(negedge clk);
+        rst_n = 1;
+    end
+
+    // Main test execution block
+    initial begin
+        run_test(); // +UVM_TESTNAME=fp_multi_test
+    end
+
+endmodule
@@ -0,0 +1,167 @@
+// Testbench for the streaming softmax unit (fp_softmax)
+//
+// Streams ROWS rows of random length (1 .. MAX_LEN, with the lengths around
+// the slot count always included) back to back and checks every output
+// bit-exactly against the reference model (fp_softmax_model.cpp through
+// DPI-C), together with out_last on the last element of each row. Inputs are
+// uniform in [-8, 8]; every third row holds back in_valid at random.
+//
+// Run with: make -f dsim.mk run DUT=fp_softmax WIDTH=16
+module fp_softmax_tb_top;
+    import fp_dpi_pkg::*;
+
+    parameter WIDTH   = 16;
+    parameter MAX_LEN = 128;
+    parameter ROWS    = 24;
+    parameter RM      = 0;   // RNE
+
+    import "DPI-C" function void             c_fp_softmax_reset(int width, int rm);
+    import "DPI-C" function void             c_fp_softmax_push(longint unsigned x);
+    import "DPI-C" function int              c_fp_softmax_finish();
+    import "DPI-C" function longint unsigned c_fp_softmax_result(int i);
+
+    reg clk;
+    reg rst_n;
+    reg [WIDTH-1:0] in_data;
+    reg in_valid;
+    reg in_last;
+    wire in_ready;
+    wire [WIDTH-1:0] out_data;
+    wire out_valid;
+    wire out_last;
+
+    fp_softmax #(
+        .WIDTH(WIDTH),
+        .MAX_LEN(MAX_LEN)
+    ) dut (
+        .clk(clk),
+        .rst_n(rst_n),
+        .rm(RM[2:0]),
+        .in_data(in_data),
+        .in_valid(in_valid),
+        .in_last(in_last),
+        .in_ready(in_ready),
+        .out_data(out_data),
+        .out_valid(out_valid),
+        .out_last(out_last)
+    );
+
+    // Expected outputs in order, with the last flag
+    typedef struct {
+        logic [WIDTH-1:0] y;
+        logic last;
+    } exp_t;
+
+    exp_t exp_q [$];
+    int errors = 0;
+    int results = 0;
+    int expected = 0;
+
+    function automatic logic [WIDTH-1:0] real_to_bits(real r);
+        if (WIDTH == 64) return c_real_to_fp64_bits(r);
+        if (WIDTH == 32) return c_real_to_fp32_bits(r);
+        return c_real_to_fp16_bits(r);
+    endfunction
+
+    // Clock generation
+    initial begin
+        clk = 0;
+        forever #5 clk = ~clk;
+    end
+
+    // Output checking
+    always @(posedge clk) begin
+        if (out_valid) begin
+            results++;
+            if (exp_q.size() == 0) begin
+                $display("  Unexpected output %h", out_data);
+                errors++;
+            end else begin
+                exp_t e = exp_q.pop_front();
+                if (out_data !== e.y || out_last !== e.last) begin
+                    $display("  Output %0d: %h last %b, expected %h last %b", results - 1, out_data, out_last, e.y,
+                             e.last);
+                    errors++;
+                end
+            end
+        end
+    end
+
+    // Streams one row; the expected outputs are queued when the row is complete
+    task automatic send_row(int len, bit gaps);
+        logic [WIDTH-1:0] x [$];
+        int n;
+        for (int i = 0; i < len; i++) begin
+            real u = $urandom_range(0, 1 << 20) / real'(1 << 20);
+            x.push_back(real_to_bits(16.0 * u - 8.0));
+        end
+
+        c_fp_softmax_reset(WIDTH, RM);
+        foreach (x[i]) c_fp_softmax_push(x[i]);
+        n = c_fp_softmax_finish();
+        for (int i = 0; i < n; i++) begin
+            exp_t e;
+            e.y = c_fp_softmax_result(i);
+            e.last = (i == n - 1);
+            exp_q.push_back(e);
+        end
+        expected += n;
+
+        foreach (x[i]) begin
+            if (gaps) begin
+                while ($urandom_range(0, 3) == 0) begin
+                    @(negedge clk);
+                    in_valid = 0;
+                    @(posedge clk);
+                end
+            end
+            @(negedge clk);
+            in_data = x[i];
+            in_last = (i == len - 1);
+            in_valid = 1;
+            @(posedge clk);
+            while (!in_ready) @(posedge clk);
+        end
+        @(negedge clk);
+        in_valid = 0;
+        in_last = 0;
+    endtask
+
+    // Test Sequence
+    initial begin
+        int fixed_lens [$] = '{1, 2, 7, 8, 9, 16, 17, MAX_LEN};
+
+        rst_n = 0;
+        in_data = 0;
+        in_valid = 0;
+        in_last = 0;
+
+        #20;
+        rst_n = 1;
+        #10;
+
+        for (int r = 0; r < ROWS; r++) begin
+            int len = (r < fixed_lens.size()) ? fixed_lens[r] : $urandom_range(1, MAX_LEN);
+            send_row(len, r % 3 == 2);
+        end
+
+        // Wait for all expected outputs, then 100 quiet cycles
+        begin
+            int idle_cycles = 0;
+            while (idle_cycles < 100) begin
+                @(posedge clk);
+                idle_cycles = (exp_q.size() == 0) ? idle_cycles + 1 : 0;
+            end
+        end
+
+        if (results != expected) begin
+            $display("  %0d outputs, expected %0d", results, expected);
+            errors++;
+        end
+        if (errors == 0)
+            $display("PASS : fp_softmax, %0d rows, %0d outputs", ROWS, results);
+        else
+            $display("FAIL : fp_softmax, %0d errors", errors);
+        $finish;
+    end
+endmodule
@@ -0,0 +1,273 @@
+// Testbench for the block floating point converter (fp_to_bfp) and the
+// block floating point systolic array (systolic_bfp)
+//
+// Converter: feeds BLOCKS random blocks of WIDTH-bit elements (a few
+// binades around a random exponent, with zeros, denormals and one block in
+// sixteen holding an infinity or a NaN), one block per cycle with random
+// gaps in in_valid, into two converters (MANT_W = 8 and 4), and checks the
+// shared exponent and every mantissa bit-exactly and in order against the
+// reference model (bfp_model.cpp through DPI-C).
+//
+// Array: runs JOBS random jobs (mantissas in +-(2^(MANT_W-1) - 1), block
+// exponents with one in sixteen NaN) through a ROWS x COLS systolic_bfp and
+// checks C, its block exponents, the NaN flags and the tag of every job
+// against C = A * B computed here.
+//
+// Run with: make -f dsim.mk run DUT=fp_to_bfp WIDTH=16
+module fp_to_bfp_tb_top;
+
+    parameter WIDTH  = 16;
+    parameter BLOCK  = 32;
+    parameter BLOCKS = 2000;
+    parameter ROWS   = 4;
+    parameter COLS   = 4;
+    parameter JOBS   = 200;
+
+    import "DPI-C" function void c_bfp_element(longint unsigned x);
+    import "DPI-C" function int  c_bfp_encode(int width, int mant_w);
+    import "DPI-C" function int  c_bfp_mant(int i);
+
+    localparam EXP_W  = (WIDTH == 32) ? 8 : 5;
+    localparam FRAC_W = WIDTH - 1 - EXP_W;
+
+    // Array operands: MXINT8 mantissas
+    localparam SA_MANT_W = 8;
+    localparam SA_ACC_W  = 2*SA_MANT_W - 1 + $clog2(ROWS);
+    localparam TAG_WIDTH = 8;
+
+    reg clk;
+    reg rst_n;
+
+    //----------------------------------------------------------------
+    // Converter
+    //----------------------------------------------------------------
+
+    reg [BLOCK*WIDTH-1:0] in_data;
+    reg in_valid;
+    wire [7:0] exp8, exp4;
+    wire [BLOCK*8-1:0] mant8;
+    wire [BLOCK*4-1:0] mant4;
+    wire valid8, valid4;
+
+    fp_to_bfp #(.WIDTH(WIDTH), .BLOCK(BLOCK), .MANT_W(8)) dut (
+        .clk(clk), .rst_n(rst_n),
+        .in_data(in_data), .in_valid(in_valid),
+        .out_exp(exp8), .out_mant(mant8), .out_valid(valid8)
+    );
+
+    fp_to_bfp #(.WIDTH(WIDTH), .BLOCK(BLOCK), .MANT_W(4)) dut4 (
+        .clk(clk), .rst_n(rst_n),
+        .in_data(in_data), .in_valid(in_valid),
+        .out_exp(exp4), .out_mant(mant4), .out_valid(valid4)
+    );
+
+    typedef struct {
+        logic [7:0] exp8;
+        logic [BLOCK*8-1:0] mant8;
+        logic [7:0] exp4;
+        logic [BLOCK*4-1:0] mant4;
+    } cvt_exp_t;
+
+    cvt_exp_t cvt_q [$];
+
+    //----------------------------------------------------------------
+    // Array
+    //----------------------------------------------------------------
+
+    reg [ROWS*ROWS*SA_MANT_W-1:0] a_mant;
+    reg [ROWS*8-1:0] a_exp;
+    reg [ROWS*COLS*SA_MANT_W-1:0] b_mant;
+    reg [COLS*8-1:0] b_exp;
+    reg [TAG_WIDTH-1:0] in_tag;
+    reg sa_in_valid;
+    wire sa_in_ready;
+    wire [ROWS*COLS*SA_ACC_W-1:0] c;
+    wire [ROWS*COLS*9-1:0] c_exp;
+    wire [ROWS*COLS-1:0] c_nan;
+    wire sa_out_valid;
+    wire [TAG_WIDTH-1:0] out_tag;
+
+    systolic_bfp #(
+        .ROWS(ROWS),
+        .COLS(COLS),
+        .MANT_W(SA_MANT_W),
+        .TAG_WIDTH(TAG_WIDTH)
+    ) sa (
+        .clk(clk), .rst_n(rst_n),
+        .a_mant(a_mant), .a_exp(a_exp), .b_mant(b_mant), .b_exp(b_exp),
+        .in_tag(in_tag), .in_valid(sa_in_valid), .in_ready(sa_in_ready),
+        .c(c), .c_exp(c_exp), .c_nan(c_nan), .out_valid(sa_out_valid), .out_tag(out_tag)
+    );
+
+    typedef struct {
+        logic [ROWS*COLS*SA_ACC_W-1:0] c;
+        logic [ROWS*COLS*9-1:0] c_exp;
+        logic [ROWS*COLS-1:0] c_nan;
+        logic [TAG_WIDTH-1:0] tag;
+    } sa_exp_t;
+
+    sa_exp_t sa_q [$];
+
+    int errors = 0;
+    int blocks_out = 0;
+    int jobs_out = 0;
+
+    // Random element: a few binades below base, zeros, denormals, or a special value
+    function automatic logic [WIDTH-1:0] rand_element(int base, bit special);
+        logic [WIDTH-1:0] x = '0;
+        int e = base - $urandom_range(0, 11);
+        x[WIDTH-1] = $urandom_range(0, 1);
+        x[FRAC_W-1:0] = $urandom;
+        if (special)
+            x[WIDTH-2:FRAC_W] = '1;
+        else if ($urandom_range(0, 7) == 0)
+            x[WIDTH-2:FRAC_W] = '0;                  // Zero or denormal
+        else
+            x[WIDTH-2:FRAC_W] = (e < 1) ? 1 : e;
+        if ($urandom_range(0, 15) == 0) x[WIDTH-2:0] = '0;
+        return x;
+    endfunction
+
+    // C = A * B on signed mantissas, with the block exponents of C
+    function automatic sa_exp_t matmul(logic [ROWS*ROWS*SA_MANT_W-1:0] a_m, logic [ROWS*8-1:0] a_e,
+                                       logic [ROWS*COLS*SA_MANT_W-1:0] b_m, logic [COLS*8-1:0] b_e);
+        sa_exp_t e;
+        for (int i = 0; i < ROWS; i++) begin
+            for (int j = 0; j < COLS; j++) begin
+                logic signed [SA_ACC_W-1:0] sum = '0;
+                for (int k = 0; k < ROWS; k++)
+                    sum += $signed(a_m[(i*ROWS + k)*SA_MANT_W +: SA_MANT_W]) * $signed(b_m[(k*COLS + j)*SA_MANT_W +: SA_MANT_W]);
+                e.c[(i*COLS + j)*SA_ACC_W +: SA_ACC_W] = sum;
+                e.c_exp[(i*COLS + j)*9 +: 9] = a_e[i*8 +: 8] + b_e[j*8 +: 8];
+                e.c_nan[i*COLS + j] = (&a_e[i*8 +: 8]) || (&b_e[j*8 +: 8]);
+            end
+        end
+        return e;
+    endfunction
+
+    // Clock generation
+    initial begin
+        clk = 0;
+        forever #5 clk = ~clk;
+    end
+
+    // Output checking
+    always @(posedge clk) begin
+        if (valid8 !== valid4) begin
+            $display("  Converter valids differ");
+            errors++;
+        end
+        if (valid8) begin
+            blocks_out++;
+            if (cvt_q.size() == 0) begin
+                $display("  Unexpected block, exponent %h", exp8);
+                errors++;
+            end else begin
+                cvt_exp_t e = cvt_q.pop_front();
+                if (exp8 !== e.exp8 || mant8 !== e.mant8 || exp4 !== e.exp4 || mant4 !== e.mant4) begin
+                    $display("  Block %0d: %h / %h, %h / %h, expected %h / %h, %h / %h", blocks_out - 1, exp8, mant8,
+                             exp4, mant4, e.exp8, e.mant8, e.exp4, e.mant4);
+                    errors++;
+                end
+            end
+        end
+        if (sa_out_valid) begin
+            jobs_out++;
+            if (sa_q.size() == 0) begin
+                $display("  Unexpected job, tag %0d", out_tag);
+                errors++;
+            end else begin
+                sa_exp_t e = sa_q.pop_front();
+                if (c !== e.c || c_exp !== e.c_exp || c_nan !== e.c_nan || out_tag !== e.tag) begin
+                    $display("  Job tag %0d: C %h exp %h nan %b, expected tag %0d C %h exp %h nan %b", out_tag, c,
+                             c_exp, c_nan, e.tag, e.c, e.c_exp, e.c_nan);
+                    errors++;
+                end
+            end
+        end
+    end
+
+    task automatic convert_blocks();
+        for (int b = 0; b < BLOCKS; b++) begin
+            logic [BLOCK*WIDTH-1:0] data;
+            cvt_exp_t e;
+            int base = $urandom_range(1, (1 << EXP_W) - 2);
+            int special_at = ($urandom_range(0, 15) == 0) ? $urandom_range(0, BLOCK - 1) : -1;
+
+            for (int i = 0; i < BLOCK; i++) data[i*WIDTH +: WIDTH] = rand_element(base, i == special_at);
+            for (int i = 0; i < BLOCK; i++) c_bfp_element(data[i*WIDTH +: WIDTH]);
+            e.exp8 = c_bfp_encode(WIDTH, 8);
+            for (int i = 0; i < BLOCK; i++) e.mant8[i*8 +: 8] = c_bfp_mant(i);
+            for (int i = 0; i < BLOCK; i++) c_bfp_element(data[i*WIDTH +: WIDTH]);
+            e.exp4 = c_bfp_encode(WIDTH, 4);
+            for (int i = 0; i < BLOCK; i++) e.mant4[i*4 +: 4] = c_bfp_mant(i);
+            cvt_q.push_back(e);
+
+            while ($urandom_range(0, 7) == 0) begin
+                @(negedge clk);
+                in_valid = 0;
+            end
+            @(negedge clk);
+            in_data = data;
+            in_valid = 1;
+        end
+        @(negedge clk);
+        in_valid = 0;
+    endtask
+
+    task automatic run_jobs();
+        for (int j = 0; j < JOBS; j++) begin
+            sa_exp_t e;
+            @(negedge clk);
+            for (int i = 0; i < ROWS*ROWS; i++) a_mant[i*SA_MANT_W +: SA_MANT_W] = $urandom_range(0, 254) - 127;
+            for (int i = 0; i < ROWS*COLS; i++) b_mant[i*SA_MANT_W +: SA_MANT_W] = $urandom_range(0, 254) - 127;
+            for (int i = 0; i < ROWS; i++) a_exp[i*8 +: 8] = ($urandom_range(0, 15) == 0) ? 8'hFF : $urandom_range(0, 254);
+            for (int i = 0; i < COLS; i++) b_exp[i*8 +: 8] = ($urandom_range(0, 15) == 0) ? 8'hFF : $urandom_range(0, 254);
+            in_tag = j;
+            sa_in_valid = 1;
+            @(posedge clk);
+            while (!sa_in_ready) @(posedge clk);
+            e = matmul(a_mant, a_exp, b_mant, b_exp);
+            e.tag = j;
+            sa_q.push_back(e);
+            @(negedge clk);
+            sa_in_valid = 0;
+        end
+    endtask
+
+    // Test Sequence
+    initial begin
+        rst_n = 0;
+        in_data = 0;
+        in_valid = 0;
+        a_mant = 0;
+        a_exp = 0;
+        b_mant = 0;
+        b_exp = 0;
+        in_tag = 0;
+        sa_in_valid = 0;
+
+        #20;
+        rst_n = 1;
+        #10;
+
+        fork
+            convert_blocks();
+            run_jobs();
+        join
+
+        // Drain: converter pipeline and the array jobs in flight
+        while (cvt_q.size() != 0 || sa_q.size() != 0) @(posedge clk);
+        repeat (100) @(posedge clk);
+
+        if (blocks_out != BLOCKS || jobs_out != JOBS) begin
+            $display("  %0d blocks and %0d jobs, expected %0d and %0d", blocks_out, jobs_out, BLOCKS, JOBS);
+            errors++;
+        end
+        if (errors == 0)
+            $display("PASS : fp_to_bfp, %0d blocks of %0d; systolic_bfp, %0d jobs", blocks_out, BLOCK, jobs_out);
+        else
+            $display("FAIL : fp_to_bfp / systolic_bfp, %0d errors", errors);
+        $finish;
+    end
+endmodule
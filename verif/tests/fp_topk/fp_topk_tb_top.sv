@@ -0,0 +1,197 @@
+// Testbench for the streaming top-k unit (fp_topk) and the comparator (fp_cmp)
+//
+// Feeds ROWS rows of 1 .. 8 random N-vectors, one vector per cycle with
+// random gaps in in_valid, and checks the top-k (elements and row positions)
+// of every row bit-exactly and in order against the reference model
+// (fp_sort_model.cpp through DPI-C). Elements are random encodings with few
+// mantissa bits, so rows hold duplicates; one in eight is a zero, an
+// infinity or a NaN. Every cycle, a separate fp_cmp instance compares the
+// first two elements of the vector and its flags, min and max are checked
+// against the model as well.
+//
+// Run with: make -f dsim.mk run DUT=fp_topk WIDTH=16
+module fp_topk_tb_top;
+
+    parameter WIDTH      = 16;
+    parameter N          = 8;
+    parameter K          = 4;
+    parameter DESCENDING = 1;
+    parameter IDX_W      = 16;
+    parameter ROWS       = 500;
+
+    import "DPI-C" function int              c_fp_cmp(longint unsigned a, longint unsigned b, int width);
+    import "DPI-C" function longint unsigned c_fp_cmp_min(longint unsigned a, longint unsigned b, int width);
+    import "DPI-C" function longint unsigned c_fp_cmp_max(longint unsigned a, longint unsigned b, int width);
+    import "DPI-C" function void             c_fp_topk_reset(int width, int n, int k, int descending, int idx_w);
+    import "DPI-C" function void             c_fp_topk_element(longint unsigned x);
+    import "DPI-C" function int              c_fp_topk_vector(int last);
+    import "DPI-C" function longint unsigned c_fp_topk_data(int rank);
+    import "DPI-C" function int              c_fp_topk_idx(int rank);
+
+    localparam EXP_W  = (WIDTH == 64) ? 11 : (WIDTH == 32) ? 8 : 5;
+    localparam MANT_W = WIDTH - 1 - EXP_W;
+    localparam BIAS   = (1 << (EXP_W - 1)) - 1;
+
+    reg clk;
+    reg rst_n;
+    reg [N*WIDTH-1:0] in_data;
+    reg in_valid;
+    reg in_last;
+    wire [K*WIDTH-1:0] out_data;
+    wire [K*IDX_W-1:0] out_idx;
+    wire out_valid;
+
+    fp_topk #(
+        .WIDTH(WIDTH),
+        .N(N),
+        .K(K),
+        .DESCENDING(DESCENDING),
+        .IDX_W(IDX_W)
+    ) dut (
+        .clk(clk),
+        .rst_n(rst_n),
+        .in_data(in_data),
+        .in_valid(in_valid),
+        .in_last(in_last),
+        .out_data(out_data),
+        .out_idx(out_idx),
+        .out_valid(out_valid)
+    );
+
+    wire cmp_lt, cmp_eq, cmp_gt, cmp_unord, cmp_total;
+    wire [WIDTH-1:0] cmp_min, cmp_max;
+
+    fp_cmp #(.WIDTH(WIDTH)) cmp (
+        .a(in_data[0 +: WIDTH]),
+        .b(in_data[WIDTH +: WIDTH]),
+        .lt(cmp_lt),
+        .eq(cmp_eq),
+        .gt(cmp_gt),
+        .unord(cmp_unord),
+        .min(cmp_min),
+        .max(cmp_max),
+        .total_order(cmp_total)
+    );
+
+    logic [K*WIDTH-1:0] exp_data_q [$];
+    logic [K*IDX_W-1:0] exp_idx_q [$];
+    int errors = 0;
+    int results = 0;
+    int cmp_checks = 0;
+
+    // Random element: few mantissa bits near 1.0, or a special value
+    function automatic logic [WIDTH-1:0] rand_element();
+        logic [WIDTH-1:0] x = '0;
+        x[WIDTH-1] = $urandom_range(0, 1);
+        x[WIDTH-2:MANT_W] = BIAS + $urandom_range(0, 8) - 4;
+        x[MANT_W-1 -: 3] = $urandom_range(0, 7);
+        case ($urandom_range(0, 15))
+            0: x[WIDTH-2:0] = '0;                                     // Zero
+            1: x[WIDTH-2:0] = {{EXP_W{1'b1}}, {MANT_W{1'b0}}};        // Infinity
+            2: x[WIDTH-2:0] = {{EXP_W{1'b1}}, 1'b1, {(MANT_W-1){1'b0}}};  // NaN
+            default: ;
+        endcase
+        return x;
+    endfunction
+
+    // Clock generation
+    initial begin
+        clk = 0;
+        forever #5 clk = ~clk;
+    end
+
+    // Output checking
+    always @(posedge clk) begin
+        if (out_valid) begin
+            results++;
+            if (exp_data_q.size() == 0) begin
+                $display("  Unexpected output %h", out_data);
+                errors++;
+            end else begin
+                logic [K*WIDTH-1:0] ed = exp_data_q.pop_front();
+                logic [K*IDX_W-1:0] ei = exp_idx_q.pop_front();
+                if (out_data !== ed || out_idx !== ei) begin
+                    $display("  Row %0d: %h / %h, expected %h / %h", results - 1, out_data, out_idx, ed, ei);
+                    errors++;
+                end
+            end
+        end
+    end
+
+    // Comparator checking, on the inputs of every cycle (they change at negedge)
+    always @(posedge clk) begin
+        if (rst_n) begin
+            int flags = c_fp_cmp(in_data[0 +: WIDTH], in_data[WIDTH +: WIDTH], WIDTH);
+            logic [WIDTH-1:0] e_min = c_fp_cmp_min(in_data[0 +: WIDTH], in_data[WIDTH +: WIDTH], WIDTH);
+            logic [WIDTH-1:0] e_max = c_fp_cmp_max(in_data[0 +: WIDTH], in_data[WIDTH +: WIDTH], WIDTH);
+            cmp_checks++;
+            if ({cmp_total, cmp_unord, cmp_gt, cmp_eq, cmp_lt} !== flags[4:0] || cmp_min !== e_min || cmp_max !== e_max) begin
+                $display("  fp_cmp %h %h: flags %b min %h max %h, expected %b %h %h", in_data[0 +: WIDTH],
+                         in_data[WIDTH +: WIDTH], {cmp_total, cmp_unord, cmp_gt, cmp_eq, cmp_lt}, cmp_min, cmp_max,
+                         flags[4:0], e_min, e_max);
+                errors++;
+            end
+        end
+    end
+
+    // Test Sequence
+    initial begin
+        rst_n = 0;
+        in_data = 0;
+        in_valid = 0;
+        in_last = 0;
+
+        #20;
+        rst_n = 1;
+        #10;
+
+        c_fp_topk_reset(WIDTH, N, K, DESCENDING, IDX_W);
+        for (int row = 0; row < ROWS; row++) begin
+            int vectors = $urandom_range(1, 8);
+            for (int v = 0; v < vectors; v++) begin
+                logic [N*WIDTH-1:0] data;
+                int last = (v == vectors - 1);
+
+                for (int i = 0; i < N; i++) begin
+                    data[i*WIDTH +: WIDTH] = rand_element();
+                    c_fp_topk_element(data[i*WIDTH +: WIDTH]);
+                end
+                if (c_fp_topk_vector(last)) begin
+                    logic [K*WIDTH-1:0] ed;
+                    logic [K*IDX_W-1:0] ei;
+                    for (int r = 0; r < K; r++) begin
+                        ed[r*WIDTH +: WIDTH] = c_fp_topk_data(r);
+                        ei[r*IDX_W +: IDX_W] = c_fp_topk_idx(r);
+                    end
+                    exp_data_q.push_back(ed);
+                    exp_idx_q.push_back(ei);
+                end
+
+                while ($urandom_range(0, 7) == 0) begin
+                    @(negedge clk);
+                    in_valid = 0;
+                end
+                @(negedge clk);
+                in_data = data;
+                in_last = last;
+                in_valid = 1;
+            end
+        end
+        @(negedge clk);
+        in_valid = 0;
+        in_last = 0;
+
+        // Drain the pipeline
+        repeat (dut.PIPELINE_LATENCY + 10) @(posedge clk);
+
+        if (results != ROWS) begin
+            $display("  %0d results, expected %0d", results, ROWS);
+            errors++;
+        end
+        if (errors == 0)
+            $display("PASS : fp_topk, N %0d, K %0d, %0d rows, %0d fp_cmp checks", N, K, results, cmp_checks);
+        else
+            $display("FAIL : fp_topk, %0d errors", errors);
+        $finish;
+    end
+endmodule
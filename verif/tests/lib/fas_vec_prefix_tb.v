@@ -0,0 +1,113 @@
+// verif/tests/lib/fas_vec_prefix_tb.v
+
+// `timescale 1ns / 1ps
+
+`include "adders.vh"  // \`ADDER_KOGGE_STONE, etc.
+
+// Exhaustive equivalence of every fas_vec_prefix topology against '+' / '-'.
+// Two widths are checked: a non-power-of-two width exercises the irregular
+// Brent-Kung / Han-Carlson trees, a power-of-two width the complete ones.
+module fas_vec_prefix_tb;
+
+    // --- Parameters ---
+    localparam W_A = 6;
+    localparam W_B = 8;
+    localparam NUM_TOPOLOGIES = 5; // `ADDER_BEHAVIORAL .. `ADDER_SKLANSKY
+
+    // --- Testbench Signals ---
+    reg  [W_B-1:0] tb_a;
+    reg  [W_B-1:0] tb_b;
+    reg            tb_cin;
+    reg            tb_add_nsub;  // 0: add, 1: subtract
+
+    wire [NUM_TOPOLOGIES*W_A-1:0] z_a;
+    wire [NUM_TOPOLOGIES-1:0]     cout_a;
+    wire [NUM_TOPOLOGIES*W_B-1:0] z_b;
+    wire [NUM_TOPOLOGIES-1:0]     cout_b;
+
+    // --- Instantiate one DUT per topology and width ---
+    genvar t;
+    generate
+        for (t = 0; t < NUM_TOPOLOGIES; t = t + 1) begin : dut
+            fas_vec_prefix #(.WIDTH(W_A), .TOPOLOGY(t)) u_a (
+                .a(tb_a[W_A-1:0]),
+                .b(tb_b[W_A-1:0]),
+                .cin(tb_cin),
+                .add_nsub(tb_add_nsub),
+                .z(z_a[t*W_A +: W_A]),
+                .cout(cout_a[t])
+            );
+            fas_vec_prefix #(.WIDTH(W_B), .TOPOLOGY(t)) u_b (
+                .a(tb_a),
+                .b(tb_b),
+                .cin(tb_cin),
+                .add_nsub(tb_add_nsub),
+                .z(z_b[t*W_B +: W_B]),
+                .cout(cout_b[t])
+            );
+        end
+    endgenerate
+
+    // --- Reference: {cout, z}, cout is the borrow for subtraction ---
+    function [W_B:0] reference;
+        input integer width;
+        input [W_B-1:0] a, b;
+        input cin, add_nsub;
+        reg [W_B+1:0] full;
+        begin
+            full = add_nsub ? ({2'b0, a} - {2'b0, b} - cin) : ({2'b0, a} + {2'b0, b} + cin);
+            reference = full & ((1 << width) - 1);
+            reference[width] = add_nsub ? full[W_B+1] : full[width];
+        end
+    endfunction
+
+    // --- Test sequence ---
+    integer a, b, cin, mode, k, errors, vectors;
+    reg [W_B:0] exp_a, exp_b;
+    initial begin
+        $display("--- Starting fas_vec_prefix testbench ---");
+        errors  = 0;
+        vectors = 0;
+        for (a = 0; a < (1 << W_B); a = a + 1) begin
+            for (b = 0; b < (1 << W_B); b = b + 1) begin
+                for (cin = 0; cin < 2; cin = cin + 1) begin
+                    for (mode = 0; mode < 2; mode = mode + 1) begin
+                        tb_a = a;
+                        tb_b = b;
+                        tb_cin = cin;
+                        tb_add_nsub = mode;
+                        #1;
+                        exp_a = reference(W_A, tb_a[W_A-1:0], tb_b[W_A-1:0], tb_cin, tb_add_nsub);
+                        exp_b = reference(W_B, tb_a, tb_b, tb_cin, tb_add_nsub);
+                        for (k = 0; k < NUM_TOPOLOGIES; k = k + 1) begin
+                            if ({cout_a[k], z_a[k*W_A +: W_A]} !== exp_a[W_A:0]) begin
+                                errors = errors + 1;
+                                $display("FAIL: topology %0d width %0d a=%b b=%b cin=%b mode=%b => z=%b cout=%b (expected z=%b cout=%b)",
+                                         k, W_A, tb_a[W_A-1:0], tb_b[W_A-1:0], tb_cin, tb_add_nsub,
+                                         z_a[k*W_A +: W_A], cout_a[k], exp_a[W_A-1:0], exp_a[W_A]);
+                            end
+                            if ({cout_b[k], z_b[k*W_B +: W_B]} !== exp_b) begin
+                                errors = errors + 1;
+                                $display("FAIL: topology %0d width %0d a=%b b=%b cin=%b mode=%b => z=%b cout=%b (expected z=%b cout=%b)",
+                                         k, W_B, tb_a, tb_b, tb_cin, tb_add_nsub,
+                                         z_b[k*W_B +: W_B], cout_b[k], exp_b[W_B-1:0], exp_b[W_B]);
+                            end
+                        end
+                        vectors = vectors + 1;
+                    end
+                end
+            end
+        end
+
+        if (errors == 0)
+            $display("PASS: All %0d topologies match '+' / '-' at widths %0d and %0d (%0d vectors)",
+                     NUM_TOPOLOGIES, W_A, W_B, vectors);
+        else
+            $display("FAIL: %0d mismatches", errors);
+
+        #10;
+        $display("--- fas_vec_prefix testbench completed ---");
+        $finish;
+    end
+
+endmodule
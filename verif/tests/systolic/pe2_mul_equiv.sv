@@ -0,0 +1,58 @@
+// Equivalence miter for the pe2 multiplier: one pe2 with the behavioral
+// multiplier (combinational product, MUL_LATENCY delay registers) and one
+// with the staged multiplier (MUL_STAGED = 1) on the same inputs. mismatch is
+// set in any cycle where an output differs. MUL_SIGNED applies to both.
+//
+// Formal: pe2_mul_equiv.sby checks the assertion below with SymbiYosys
+// (FORMAL defined). All state of pe2 is reachable from reset within
+// MUL_LATENCY + ADD_LATENCY + 2 cycles, so a bounded check deeper than that
+// covers every reachable state. Simulation: pe2_mul_equiv_tb_top.
+
+module pe2_mul_equiv #(
+    parameter WIDTH = 4,
+    parameter ACC_WIDTH = 9,
+    parameter MUL_LATENCY = 2,
+    parameter ADD_LATENCY = 1,
+    parameter MUL_SIGNED = 0
+) (
+    input  wire                 clk,
+    input  wire                 rst_n,
+    input  wire                 b_load,
+    input  wire                 b_update,
+    input  wire [WIDTH-1:0]     a_in,
+    input  wire [WIDTH-1:0]     b_in,
+    input  wire [ACC_WIDTH-1:0] c_in,
+    output wire                 mismatch
+);
+
+    wire [WIDTH-1:0]     ref_a_out, stg_a_out;
+    wire [WIDTH-1:0]     ref_b_out, stg_b_out;
+    wire [ACC_WIDTH-1:0] ref_c_out, stg_c_out;
+    wire                 ref_b_update_out, stg_b_update_out;
+
+    pe2 #(.WIDTH(WIDTH), .ACC_WIDTH(ACC_WIDTH), .MUL_LATENCY(MUL_LATENCY), .ADD_LATENCY(ADD_LATENCY), .MUL_STAGED(0), .MUL_SIGNED(MUL_SIGNED)) ref_pe (
+        .clk(clk), .rst_n(rst_n), .b_load(b_load), .b_update(b_update),
+        .a_in(a_in), .b_in(b_in), .c_in(c_in),
+        .a_out(ref_a_out), .b_out(ref_b_out), .c_out(ref_c_out), .b_update_out(ref_b_update_out)
+    );
+
+    pe2 #(.WIDTH(WIDTH), .ACC_WIDTH(ACC_WIDTH), .MUL_LATENCY(MUL_LATENCY), .ADD_LATENCY(ADD_LATENCY), .MUL_STAGED(1), .MUL_SIGNED(MUL_SIGNED)) stg_pe (
+        .clk(clk), .rst_n(rst_n), .b_load(b_load), .b_update(b_update),
+        .a_in(a_in), .b_in(b_in), .c_in(c_in),
+        .a_out(stg_a_out), .b_out(stg_b_out), .c_out(stg_c_out), .b_update_out(stg_b_update_out)
+    );
+
+    assign mismatch = (ref_a_out != stg_a_out) || (ref_b_out != stg_b_out) ||
+                      (ref_c_out != stg_c_out) || (ref_b_update_out != stg_b_update_out);
+
+`ifdef FORMAL
+    // Start from reset, then leave it released
+    reg init = 1'b1;
+    always @(posedge clk) init <= 1'b0;
+    always @(*) begin
+        assume (rst_n == !init);
+        if (!init) assert (!mismatch);
+    end
+`endif
+
+endmodule
@@ -3,6 +3,21 @@
 COMPILER = vcs
 TESTNAME ?= systolic_debug_test
 
+# MP=1 builds the multi-precision array (16-bit PEs), as systolic_mp_test expects:
+#   make -f verif/tests/systolic/systolic.mk MP=1 TESTNAME=systolic_mp_test
+MP ?= 0
+
+# STAGED=1 builds pe2 with the staged multiplier over MUL_LATENCY=2 registers:
+#   make -f verif/tests/systolic/systolic.mk STAGED=1 TESTNAME=systolic_random_test
+STAGED ?= 0
+
+# TOP=systolic_tile_tb_top runs the scratchpad tile subsystem testbench,
+# TOP=systolic_part_tb_top the array partitioning testbench,
+# TOP=systolic_perf_tb_top the controller performance counter testbench,
+# TOP=pe2_mul_equiv_tb_top the pe2 staged multiplier equivalence testbench:
+#   make -f verif/tests/systolic/systolic.mk TOP=systolic_tile_tb_top
+TOP ?= systolic_tb_top
+
 # Project Structure
 RTL_DIR      = rtl/verilog/systolic
 TEST_DIR     = verif/tests/systolic
@@ -12,6 +27,9 @@ VERIF_LIB_DIR= verif/lib
 # Using filelists is cleaner for complex hierarchies
 DUT_FILES    = -F $(TEST_DIR)/filelist.txt
 
+# DPI-C models
+C_MODEL_FILES = $(VERIF_LIB_DIR)/systolic_spad_model.cpp $(VERIF_LIB_DIR)/systolic_model.cpp
+
 # Include paths
 INCLUDE_DIRS = +incdir+$(VERIF_LIB_DIR) +incdir+$(TEST_DIR)
 
@@ -21,7 +39,21 @@ COMPILE_FLAGS = \
 	-ntb_opts uvm \
 	-debug_access+all \
 	-timescale=1ns/1ps \
-	-kdb
+	-kdb \
+	-top $(TOP)
+
+ifeq ($(MP),1)
+COMPILE_FLAGS += \
+	-pvalue+systolic_tb_top.WIDTH=16 \
+	-pvalue+systolic_tb_top.ACC_WIDTH=40 \
+	-pvalue+systolic_tb_top.MULTI_PRECISION=1
+endif
+
+ifeq ($(STAGED),1)
+COMPILE_FLAGS += \
+	-pvalue+systolic_tb_top.MUL_LATENCY=2 \
+	-pvalue+systolic_tb_top.MUL_STAGED=1
+endif
 
 RUN_FLAGS = \
 	+UVM_TESTNAME=$(TESTNAME) \
@@ -33,7 +65,7 @@ compile:
 	@echo "================================================================="
 	@echo " COMPILING SYSTOLIC TB..."
 	@echo "================================================================="
-	$(COMPILER) $(COMPILE_FLAGS) $(INCLUDE_DIRS) $(DUT_FILES) -l compile.log
+	$(COMPILER) $(COMPILE_FLAGS) $(INCLUDE_DIRS) $(DUT_FILES) $(C_MODEL_FILES) -l compile.log
 
 run:
 	@echo "================================================================="
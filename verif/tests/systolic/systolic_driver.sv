@@ -29,6 +29,8 @@ class systolic_driver #(
         vif.cb_drv.in_valid <= 0;
         vif.cb_drv.a <= 0;
         vif.cb_drv.b <= 0;
+        vif.cb_drv.prec <= 0;
+        vif.cb_drv.lane_sum <= 0;
         
         wait(vif.rst_n === 1'b1);
         @(vif.cb_drv);
@@ -39,6 +41,8 @@ class systolic_driver #(
             // Drive signals
             vif.cb_drv.a <= req.pack_a();
             vif.cb_drv.b <= req.pack_b();
+            vif.cb_drv.prec <= req.prec;
+            vif.cb_drv.lane_sum <= req.lane_sum;
             vif.cb_drv.in_valid <= 1'b1;
             
             // Wait for handshake
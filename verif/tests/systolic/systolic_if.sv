@@ -12,18 +12,20 @@ interface systolic_if #(
 );
     logic [ROWS*ROWS*WIDTH-1:0] a;
     logic [ROWS*COLS*WIDTH-1:0] b;
+    logic [1:0] prec;
+    logic lane_sum;
     logic in_valid;
     logic in_ready;
     logic [ROWS*COLS*ACC_WIDTH-1:0] c;
     logic out_valid;
 
     clocking cb_drv @(posedge clk);
-        output a, b, in_valid;
+        output a, b, prec, lane_sum, in_valid;
         input  in_ready;
     endclocking
 
     clocking cb_mon @(posedge clk);
-        input a, b, in_valid, in_ready, c, out_valid;
+        input a, b, prec, lane_sum, in_valid, in_ready, c, out_valid;
     endclocking
 
 endinterface
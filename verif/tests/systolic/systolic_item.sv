@@ -15,6 +15,19 @@ class systolic_item #(
     rand bit [WIDTH-1:0] b_matrix [ROWS][COLS];
     bit [ACC_WIDTH-1:0] c_matrix [ROWS][COLS];
 
+    // Precision mode (systolic MULTI_PRECISION): 1 << prec lanes per element,
+    // lane_sum selects the packed dot product over independent lanes
+    rand bit [1:0] prec;
+    rand bit lane_sum;
+
+    // Set by the tb top from its MULTI_PRECISION parameter
+    static bit multi_precision = 0;
+
+    constraint c_prec {
+        prec != 2'd3;
+        !multi_precision -> (prec == 2'd0 && lane_sum == 1'b0);
+    }
+
     `uvm_object_param_utils(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))
 
     function new(string name = "systolic_item");
@@ -77,6 +90,8 @@ class systolic_item #(
         this.a_matrix = rhs_.a_matrix;
         this.b_matrix = rhs_.b_matrix;
         this.c_matrix = rhs_.c_matrix;
+        this.prec = rhs_.prec;
+        this.lane_sum = rhs_.lane_sum;
     endfunction
 
     function bit do_compare(uvm_object rhs, uvm_comparer comparer);
@@ -85,11 +100,15 @@ class systolic_item #(
         return super.do_compare(rhs, comparer) &&
                (this.a_matrix == rhs_.a_matrix) &&
                (this.b_matrix == rhs_.b_matrix) &&
-               (this.c_matrix == rhs_.c_matrix);
+               (this.c_matrix == rhs_.c_matrix) &&
+               (this.prec == rhs_.prec) &&
+               (this.lane_sum == rhs_.lane_sum);
     endfunction
 
     function void do_print(uvm_printer printer);
         super.do_print(printer);
+        printer.print_int("prec", prec, 2);
+        printer.print_int("lane_sum", lane_sum, 1);
         foreach (a_matrix[i,j]) printer.print_int($sformatf("a_matrix[%0d][%0d]", i, j), a_matrix[i][j], WIDTH);
         foreach (b_matrix[i,j]) printer.print_int($sformatf("b_matrix[%0d][%0d]", i, j), b_matrix[i][j], WIDTH);
         foreach (c_matrix[i,j]) printer.print_int($sformatf("c_matrix[%0d][%0d]", i, j), c_matrix[i][j], ACC_WIDTH);
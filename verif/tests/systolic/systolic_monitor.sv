@@ -41,11 +41,14 @@ class systolic_monitor #(
         forever begin
             @(vif.cb_mon);
             if (vif.rst_n && vif.cb_mon.in_valid && vif.cb_mon.in_ready) begin
-                item = systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH)::type_id::create("item_in");
+                item = obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::get("item_in");
                 item.unpack_a(vif.cb_mon.a);
                 item.unpack_b(vif.cb_mon.b);
+                item.prec = vif.cb_mon.prec;
+                item.lane_sum = vif.cb_mon.lane_sum;
                 `uvm_info("MON", $sformatf("Sampled Input: A[0][0]=%0d B[0][0]=%0d", item.a_matrix[0][0], item.b_matrix[0][0]), UVM_HIGH)
                 ap_in.write(item);
+                obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::put(item);  // Subscribers copy what they keep
             end
         end
     endtask
@@ -55,10 +58,11 @@ class systolic_monitor #(
         forever begin
             @(vif.cb_mon);
             if (vif.rst_n && vif.cb_mon.out_valid) begin
-                item = systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH)::type_id::create("item_out");
+                item = obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::get("item_out");
                 item.unpack_c(vif.cb_mon.c);
                 `uvm_info("MON", $sformatf("Sampled Output: C[0][0]=%0d", item.c_matrix[0][0]), UVM_HIGH)
                 ap_out.write(item);
+                obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::put(item);
             end
         end
     endtask
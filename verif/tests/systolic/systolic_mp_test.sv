@@ -0,0 +1,42 @@
+// verif/tests/systolic/systolic_mp_test.sv
+// Test that walks the precision modes of the multi-precision array.
+// Needs the tb top built with WIDTH=16, ACC_WIDTH=40, MULTI_PRECISION=1 (systolic.mk MP=1).
+
+`include "uvm_macros.svh"
+import uvm_pkg::*;
+
+class systolic_mp_test extends uvm_test;
+    `uvm_component_utils(systolic_mp_test)
+
+    // Parameters must match DUT/Top
+    parameter ROWS = 2;
+    parameter COLS = 2;
+    parameter WIDTH = 16;
+    parameter ACC_WIDTH = 40;
+
+    systolic_env #(ROWS, COLS, WIDTH, ACC_WIDTH) env;
+
+    function new(string name, uvm_component parent);
+        super.new(name, parent);
+    endfunction
+
+    function void build_phase(uvm_phase phase);
+        super.build_phase(phase);
+        env = systolic_env #(ROWS, COLS, WIDTH, ACC_WIDTH)::type_id::create("env", this);
+    endfunction
+
+    task run_phase(uvm_phase phase);
+        systolic_mode_sequence #(ROWS, COLS, WIDTH, ACC_WIDTH) seq;
+
+        phase.raise_objection(this);
+
+        if (!systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH)::multi_precision)
+            `uvm_fatal("TEST", "systolic_tb_top was not built with MULTI_PRECISION=1")
+
+        seq = systolic_mode_sequence #(ROWS, COLS, WIDTH, ACC_WIDTH)::type_id::create("seq");
+        seq.start(env.agent.sequencer);
+
+        #100ns; // Wait for last outputs
+        phase.drop_objection(this);
+    endtask
+endclass
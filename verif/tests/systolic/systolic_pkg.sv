@@ -5,6 +5,9 @@ package systolic_pkg;
     import uvm_pkg::*;
     `include "uvm_macros.svh"
 
+    // From verif/lib, included rather than imported so systolic.mk still builds without fp_lib_pkg
+    `include "obj_pool.sv"
+
     `include "systolic_item.sv"
     `include "systolic_driver.sv"
     `include "systolic_monitor.sv"
@@ -14,5 +17,6 @@ package systolic_pkg;
     `include "systolic_sequence.sv"
     `include "systolic_random_test.sv"
     `include "systolic_debug_test.sv"
+    `include "systolic_mp_test.sv"
 
 endpackage
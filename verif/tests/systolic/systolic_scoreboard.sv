@@ -30,21 +30,59 @@ class systolic_scoreboard #(
     // Input Analysis Port Write
     function void write_in(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH) t);
         systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH) exp_item;
-        exp_item = systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH)::type_id::create("exp_item");
+        exp_item = obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::get("exp_item");
         exp_item.copy(t);
         
         // Calculate Expected Result (Matrix Multiplication)
+        if (t.prec == 0 || t.lane_sum) predict_lane_sum(t, exp_item);
+        else predict_independent(t, exp_item);
+        
+        exp_queue.push_back(exp_item);
+    endfunction
+
+    // C = A * B over (1 << prec) * ROWS deep rows of A / columns of B,
+    // stored as row-major WIDTH >> prec bit elements
+    function void predict_lane_sum(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH) t,
+                                   systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH) exp_item);
+        logic [ROWS*ROWS*WIDTH-1:0] a_flat = t.pack_a();
+        logic [ROWS*COLS*WIDTH-1:0] b_flat = t.pack_b();
+        int lanes = 1 << t.prec;
+        int lw = WIDTH / lanes;
+        longint unsigned mask = (64'd1 << lw) - 1;
+
         for (int i = 0; i < ROWS; i++) begin
             for (int j = 0; j < COLS; j++) begin
-                int sum = 0;
-                for (int k = 0; k < ROWS; k++) begin
-                    sum += t.a_matrix[i][k] * t.b_matrix[k][j];
+                longint unsigned sum = 0;
+                for (int k = 0; k < lanes*ROWS; k++) begin
+                    sum += ((a_flat >> ((i*lanes*ROWS + k)*lw)) & mask) * ((b_flat >> ((k*COLS + j)*lw)) & mask);
                 end
                 exp_item.c_matrix[i][j] = sum;
             end
         end
-        
-        exp_queue.push_back(exp_item);
+    endfunction
+
+    // One C = A * B per lane, on the ACC_WIDTH >> prec bit fields of C
+    function void predict_independent(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH) t,
+                                      systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH) exp_item);
+        int lanes = 1 << t.prec;
+        int lw = WIDTH / lanes;
+        int aw = ACC_WIDTH / lanes;
+        longint unsigned mask = (64'd1 << lw) - 1;
+        longint unsigned acc_mask = (64'd1 << aw) - 1;
+
+        for (int i = 0; i < ROWS; i++) begin
+            for (int j = 0; j < COLS; j++) begin
+                bit [ACC_WIDTH-1:0] c = 0;
+                for (int l = 0; l < lanes; l++) begin
+                    longint unsigned sum = 0;
+                    for (int k = 0; k < ROWS; k++) begin
+                        sum += ((t.a_matrix[i][k] >> (l*lw)) & mask) * ((t.b_matrix[k][j] >> (l*lw)) & mask);
+                    end
+                    c |= (ACC_WIDTH'(sum & acc_mask)) << (l*aw);
+                end
+                exp_item.c_matrix[i][j] = c;
+            end
+        end
     endfunction
 
     // Output Analysis Port Write
@@ -68,6 +106,12 @@ class systolic_scoreboard #(
             end
         end
         `uvm_info("SCB", "Transaction verified successfully", UVM_HIGH)
+        obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::put(exp_item);
+    endfunction
+
+    virtual function void report_phase(uvm_phase phase);
+        super.report_phase(phase);
+        `uvm_info("SCB", $sformatf("Object pool %s", obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::stats()), UVM_NONE)
     endfunction
 
 endclass
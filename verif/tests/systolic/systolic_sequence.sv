@@ -20,10 +20,12 @@ class systolic_random_sequence #(
     task body();
         systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH) item;
         repeat(20) begin
-            item = systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH)::type_id::create("item");
+            item = obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::get("item");
             start_item(item);
             if (!item.randomize()) `uvm_error("SEQ", "Randomization failed");
             finish_item(item);
+            // The driver is done with the item, the monitor samples its own copies from the bus
+            obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::put(item);
         end
     endtask
 
@@ -47,34 +49,82 @@ class systolic_debug_sequence #(
         
         // Case 1: Identity x Identity
         `uvm_info("SEQ", "Generating Identity x Identity", UVM_LOW)
-        item = systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH)::type_id::create("item_identity");
+        item = obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::get("item_identity");
         start_item(item);
         assert(item.randomize() with {
             foreach(a_matrix[i,j]) a_matrix[i][j] == (i==j ? 1 : 0);
             foreach(b_matrix[i,j]) b_matrix[i][j] == (i==j ? 1 : 0);
         });
         finish_item(item);
+        obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::put(item);
 
         // Case 2: Sparse (A[0][0]=1, B[0][0]=1, others 0)
         `uvm_info("SEQ", "Generating Sparse [0][0]", UVM_LOW)
-        item = systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH)::type_id::create("item_sparse");
+        item = obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::get("item_sparse");
         start_item(item);
         assert(item.randomize() with {
             foreach(a_matrix[i,j]) a_matrix[i][j] == (i==0 && j==0 ? 1 : 0);
             foreach(b_matrix[i,j]) b_matrix[i][j] == (i==0 && j==0 ? 1 : 0);
         });
         finish_item(item);
+        obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::put(item);
 
         // Case 3: Full 1s
         `uvm_info("SEQ", "Generating All 1s", UVM_LOW)
-        item = systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH)::type_id::create("item_ones");
+        item = obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::get("item_ones");
         start_item(item);
         assert(item.randomize() with {
             foreach(a_matrix[i,j]) a_matrix[i][j] == 1;
             foreach(b_matrix[i,j]) b_matrix[i][j] == 1;
         });
         finish_item(item);
+        obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::put(item);
 
     endtask
 
 endclass
+
+// Walks all precision modes (systolic MULTI_PRECISION) with random operands,
+// including back-to-back jobs of different modes
+class systolic_mode_sequence #(
+    parameter ROWS = 2,
+    parameter COLS = 2,
+    parameter WIDTH = 16,
+    parameter ACC_WIDTH = 40
+) extends uvm_sequence #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH));
+
+    `uvm_object_param_utils(systolic_mode_sequence #(ROWS, COLS, WIDTH, ACC_WIDTH))
+
+    int unsigned jobs_per_mode = 5;
+
+    function new(string name = "systolic_mode_sequence");
+        super.new(name);
+    endfunction
+
+    task body();
+        systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH) item;
+
+        for (int p = 0; p < 3; p++) begin
+            for (int s = 0; s < 2; s++) begin
+                `uvm_info("SEQ", $sformatf("Generating %0d x %0d-bit lanes, lane_sum=%0d", 1 << p, WIDTH >> p, s), UVM_LOW)
+                repeat (jobs_per_mode) begin
+                    item = obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::get("item_mode");
+                    start_item(item);
+                    if (!item.randomize() with { prec == p; lane_sum == s; }) `uvm_error("SEQ", "Randomization failed");
+                    finish_item(item);
+                    obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::put(item);
+                end
+            end
+        end
+
+        // Mode changes on every job
+        repeat (4 * jobs_per_mode) begin
+            item = obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::get("item_mixed");
+            start_item(item);
+            if (!item.randomize()) `uvm_error("SEQ", "Randomization failed");
+            finish_item(item);
+            obj_pool #(systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH))::put(item);
+        end
+    endtask
+
+endclass
@@ -8,6 +8,8 @@ module systolic_tb_top;
     parameter ACC_WIDTH = 9;
     parameter MUL_LATENCY = 0;
     parameter ADD_LATENCY = 1;
+    parameter MULTI_PRECISION = 0;
+    parameter MUL_STAGED = 0;
 
     logic clk;
     logic rst_n;
@@ -29,16 +31,38 @@ module systolic_tb_top;
         .WIDTH(WIDTH),
         .ACC_WIDTH(ACC_WIDTH),
         .MUL_LATENCY(MUL_LATENCY),
-        .ADD_LATENCY(ADD_LATENCY)
+        .ADD_LATENCY(ADD_LATENCY),
+        .MULTI_PRECISION(MULTI_PRECISION),
+        .MUL_STAGED(MUL_STAGED)
     ) dut (
         .clk(clk),
         .rst_n(rst_n),
         .a(intf.a),
         .b(intf.b),
+        .prec(intf.prec),
+        .lane_sum(intf.lane_sum),
+        .in_tag('0),
         .in_valid(intf.in_valid),
         .in_ready(intf.in_ready),
         .c(intf.c),
-        .out_valid(intf.out_valid)
+        .out_valid(intf.out_valid),
+        .out_tag(),
+        .part_mode(1'b0),
+        .part_active(),
+        .part_a('0),
+        .part_b('0),
+        .part_prec('0),
+        .part_lane_sum('0),
+        .part_in_tag('0),
+        .part_in_valid('0),
+        .part_in_ready(),
+        .part_c(),
+        .part_out_valid(),
+        .part_out_tag(),
+        .csr_addr('0),
+        .csr_wr(1'b0),
+        .csr_wdata(32'd0),
+        .csr_rdata()
     );
 
     // Clock generation
@@ -55,6 +79,7 @@ module systolic_tb_top;
 
     initial begin
         uvm_config_db#(virtual systolic_if #(ROWS, COLS, WIDTH, ACC_WIDTH))::set(null, "*", "vif", intf);
+        systolic_item #(ROWS, COLS, WIDTH, ACC_WIDTH)::multi_precision = MULTI_PRECISION;
         run_test();
     end
 
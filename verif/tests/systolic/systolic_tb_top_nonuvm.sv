@@ -28,10 +28,30 @@ module systolic_tb_top_nonuvm;
         .rst_n(rst_n),
         .a(a),
         .b(b),
+        .prec(2'd0),
+        .lane_sum(1'b0),
+        .in_tag('0),
         .in_valid(in_valid),
         .in_ready(in_ready),
         .c(c),
-        .out_valid(out_valid)
+        .out_valid(out_valid),
+        .out_tag(),
+        .part_mode(1'b0),
+        .part_active(),
+        .part_a('0),
+        .part_b('0),
+        .part_prec('0),
+        .part_lane_sum('0),
+        .part_in_tag('0),
+        .part_in_valid('0),
+        .part_in_ready(),
+        .part_c(),
+        .part_out_valid(),
+        .part_out_tag(),
+        .csr_addr('0),
+        .csr_wr(1'b0),
+        .csr_wdata(32'd0),
+        .csr_rdata()
     );
 
     // Helper to set A matrix elements
@@ -0,0 +1,194 @@
+# Makefile for the Verilator single-vector replay harness.
+#
+# Verilates one fp_add / fp_mul unit at one WIDTH together with
+# verif/lib/fp_replay_vl.cpp, which replays a failing transaction (from a UVM
+# log or a vector file) with its pipeline history, minimizes it and dumps the
+# per-stage RTL signals next to the C model intermediates. See TOOLING.md.
+#
+# Also builds the integer library throughput test (verif/lib/int_tput_vl.cpp)
+# for one rtl/verilog/int unit, WIDTH and stage parameter, and the Python
+# batch library (verif/lib/fp_batch_vl.cpp, used by verif/lib/fp_rtl.py) for
+# one fp_add / fp_mul / fp_exp / fp_recip unit at one WIDTH.
+#
+# Usage:
+#   make -f verilator.mk                 - Builds the harness for DUT / WIDTH.
+#   make -f verilator.mk replay          - Builds and runs the harness with REPLAY_ARGS.
+#   make -f verilator.mk tput            - Builds and runs the integer throughput test for INT_DUT / INT_WIDTH.
+#   make -f verilator.mk pylib           - Builds the Python batch library for DUT / WIDTH.
+#   make -f verilator.mk clean           - Removes the build directory.
+#
+# Example:
+#   make -f verilator.mk replay DUT=fp_mul WIDTH=32 REPLAY_ARGS="--log dsim.log"
+#   make -f verilator.mk replay DUT=fp_add WIDTH=16 REPLAY_ARGS="--a 3c01 --b 8400 --rm 4"
+#   make -f verilator.mk tput INT_DUT=int_div INT_WIDTH=64 INT_STAGES=2 TPUT_ARGS="--cycles 100000"
+#   make -f verilator.mk pylib DUT=fp_recip WIDTH=32
+
+SHELL := /bin/bash
+MAKEFLAGS += --no-builtin-rules
+
+#==============================================================================
+# Configurable Variables (can be overridden from the command line)
+#==============================================================================
+
+DUT           ?= fp_add
+WIDTH         ?= 16
+
+VERILATOR     ?= verilator
+CC            ?= gcc
+CFLAGS        ?= -O2 -Wall
+CXX           ?= g++
+CXXFLAGS      ?= -O2 -Wall -std=c++17
+BUILD_DIR     ?= build/verilator
+
+REPLAY_ARGS   ?=
+
+# Integer throughput test: INT_STAGES is DIGITS_PER_STAGE (int_div), LATENCY
+# (int_shift) or MUL_STAGES (int_mac)
+INT_DUT       ?= int_div
+INT_WIDTH     ?= 32
+INT_STAGES    ?= 1
+TPUT_ARGS     ?=
+
+#==============================================================================
+# Static Variables (derived from the above)
+#==============================================================================
+
+RTL_DIR       = rtl/verilog/fp
+RTL_LIB_DIR   = rtl/verilog/lib
+VERIF_LIB_DIR = verif/lib
+
+OBJ_DIR       = $(BUILD_DIR)/$(DUT)_$(WIDTH)
+REPLAY_BIN    = $(OBJ_DIR)/fp_replay
+
+DUT_FILE      = $(RTL_DIR)/$(DUT).v
+RTL_FILES     = $(RTL_LIB_DIR)/adders.v $(RTL_LIB_DIR)/compound_inc.v $(RTL_LIB_DIR)/fas.v $(RTL_LIB_DIR)/fas_vec.v \
+                $(RTL_LIB_DIR)/grs_round.v $(RTL_LIB_DIR)/grs_rounder.v $(DUT_FILE)
+
+# Pipeline depth from the unit's VERIF_DECLARE_PIPELINE(<latency>)
+LATENCY       = $(shell sed -n 's/.*VERIF_DECLARE_PIPELINE(\([0-9]*\)).*/\1/p' $(DUT_FILE) | head -1)
+REPLAY_OP     = $(if $(filter fp_mul,$(DUT)),FP_REPLAY_OP_MUL,FP_REPLAY_OP_ADD)
+
+# svdpi.h for the C model comes with Verilator
+VERILATOR_INCLUDE = $(shell $(VERILATOR) --getenv VERILATOR_ROOT)/include
+
+# The C model and replay core are C, so they are built with $(CC) and linked in
+C_SRCS        = $(VERIF_LIB_DIR)/fp_model.c $(VERIF_LIB_DIR)/fp_replay.c
+C_HDRS        = $(VERIF_LIB_DIR)/fp_model.h $(VERIF_LIB_DIR)/fp_replay.h
+C_OBJS        = $(patsubst $(VERIF_LIB_DIR)/%.c,$(OBJ_DIR)/%.o,$(C_SRCS))
+
+VERILATOR_FLAGS = \
+	--cc --exe --build -j 0 \
+	--vpi --public-flat-rw \
+	-Wno-fatal \
+	--top-module $(DUT) \
+	-GWIDTH=$(WIDTH) \
+	-I$(RTL_LIB_DIR) -I$(RTL_DIR) \
+	-Mdir $(OBJ_DIR) \
+	--prefix Vreplay \
+	-o fp_replay \
+	-CFLAGS "-O2 -I$(abspath $(VERIF_LIB_DIR)) -I$(VERILATOR_INCLUDE)/vltstd" \
+	-CFLAGS "-DREPLAY_DUT=$(DUT) -DREPLAY_OP=$(REPLAY_OP) -DREPLAY_WIDTH=$(WIDTH) -DREPLAY_LATENCY=$(LATENCY)" \
+	-LDFLAGS "$(abspath $(C_OBJS)) -lm"
+
+# Integer throughput test
+INT_RTL_DIR   = rtl/verilog/int
+INT_OBJ_DIR   = $(BUILD_DIR)/$(INT_DUT)_$(INT_WIDTH)_$(INT_STAGES)
+TPUT_BIN      = $(INT_OBJ_DIR)/int_tput
+INT_PARAM     = $(if $(filter int_div,$(INT_DUT)),DIGITS_PER_STAGE,$(if $(filter int_shift,$(INT_DUT)),LATENCY,MUL_STAGES))
+TPUT_OP       = $(if $(filter int_div,$(INT_DUT)),INT_TPUT_OP_DIV,$(if $(filter int_shift,$(INT_DUT)),INT_TPUT_OP_SHIFT,INT_TPUT_OP_MAC))
+INT_C_OBJS    = $(INT_OBJ_DIR)/int_model.o
+
+TPUT_FLAGS = \
+	--cc --exe --build -j 0 \
+	-Wno-fatal \
+	--top-module $(INT_DUT) \
+	-GWIDTH=$(INT_WIDTH) -G$(INT_PARAM)=$(INT_STAGES) \
+	-I$(RTL_LIB_DIR) -I$(INT_RTL_DIR) \
+	-Mdir $(INT_OBJ_DIR) \
+	--prefix Vtput \
+	-o int_tput \
+	-CFLAGS "-O2 -I$(abspath $(VERIF_LIB_DIR))" \
+	-CFLAGS "-DTPUT_DUT=$(INT_DUT) -DTPUT_OP=$(TPUT_OP) -DTPUT_WIDTH=$(INT_WIDTH) -DTPUT_STAGES=$(INT_STAGES)" \
+	-LDFLAGS "$(abspath $(INT_C_OBJS))"
+
+# Python batch library: the Verilated model and the C model, position
+# independent, linked into one shared object with the Verilator runtime
+BATCH_OBJ_DIR = $(BUILD_DIR)/batch/$(DUT)_$(WIDTH)
+BATCH_LIB     = $(BATCH_OBJ_DIR)/libfp_batch.so
+BATCH_UNARY   = $(if $(filter fp_exp fp_recip,$(DUT)),1,0)
+BATCH_C_SRCS  = $(VERIF_LIB_DIR)/fp_model.c
+BATCH_C_OBJS  = $(BATCH_OBJ_DIR)/fp_model.o
+BATCH_SRCS    = $(VERIF_LIB_DIR)/fp_batch_vl.cpp $(VERIF_LIB_DIR)/fp_softmax_model.cpp
+BATCH_RT_SRCS = $(VERILATOR_INCLUDE)/verilated.cpp $(wildcard $(VERILATOR_INCLUDE)/verilated_threads.cpp)
+
+BATCH_FLAGS = \
+	--cc --build -j 0 \
+	-Wno-fatal \
+	--top-module $(DUT) \
+	-GWIDTH=$(WIDTH) \
+	-I$(RTL_LIB_DIR) -I$(RTL_DIR) \
+	-Mdir $(BATCH_OBJ_DIR) \
+	--prefix Vbatch \
+	-CFLAGS "-O2 -fPIC"
+
+BATCH_CXXFLAGS = \
+	-fPIC -shared \
+	-I$(BATCH_OBJ_DIR) -I$(VERILATOR_INCLUDE) -I$(VERILATOR_INCLUDE)/vltstd -I$(VERIF_LIB_DIR) \
+	-DBATCH_DUT=$(DUT) -DBATCH_WIDTH=$(WIDTH) -DBATCH_UNARY=$(BATCH_UNARY) -DBATCH_MODEL=c_$(DUT)
+
+#==============================================================================
+# Targets
+#==============================================================================
+
+.PHONY: all replay tput pylib clean
+
+all: $(REPLAY_BIN)
+
+$(OBJ_DIR):
+	@mkdir -p $@
+
+$(OBJ_DIR)/%.o: $(VERIF_LIB_DIR)/%.c $(C_HDRS) | $(OBJ_DIR)
+	$(CC) $(CFLAGS) -I$(VERIF_LIB_DIR) -I$(VERILATOR_INCLUDE)/vltstd -c -o $@ $<
+
+$(REPLAY_BIN): $(C_OBJS) $(RTL_FILES) $(VERIF_LIB_DIR)/fp_replay_vl.cpp
+	@echo "--- Verilating $(DUT) WIDTH=$(WIDTH) (latency $(LATENCY)) ---"
+	$(VERILATOR) $(VERILATOR_FLAGS) $(RTL_FILES) $(VERIF_LIB_DIR)/fp_replay_vl.cpp
+
+replay: $(REPLAY_BIN)
+	@echo "--- Replaying on $(DUT) WIDTH=$(WIDTH) ---"
+	@$(REPLAY_BIN) $(REPLAY_ARGS)
+
+$(INT_OBJ_DIR):
+	@mkdir -p $@
+
+$(INT_OBJ_DIR)/int_model.o: $(VERIF_LIB_DIR)/int_model.c $(VERIF_LIB_DIR)/int_model.h | $(INT_OBJ_DIR)
+	$(CC) $(CFLAGS) -I$(VERIF_LIB_DIR) -c -o $@ $<
+
+$(TPUT_BIN): $(INT_C_OBJS) $(INT_RTL_DIR)/$(INT_DUT).v $(VERIF_LIB_DIR)/int_tput_vl.cpp
+	@echo "--- Verilating $(INT_DUT) WIDTH=$(INT_WIDTH) $(INT_PARAM)=$(INT_STAGES) ---"
+	$(VERILATOR) $(TPUT_FLAGS) $(INT_RTL_DIR)/$(INT_DUT).v $(VERIF_LIB_DIR)/int_tput_vl.cpp
+
+tput: $(TPUT_BIN)
+	@echo "--- Measuring throughput of $(INT_DUT) WIDTH=$(INT_WIDTH) ---"
+	@$(TPUT_BIN) $(TPUT_ARGS)
+
+$(BATCH_OBJ_DIR):
+	@mkdir -p $@
+
+$(BATCH_OBJ_DIR)/fp_model.o: $(BATCH_C_SRCS) $(C_HDRS) | $(BATCH_OBJ_DIR)
+	$(CC) $(CFLAGS) -fPIC -I$(VERIF_LIB_DIR) -I$(VERILATOR_INCLUDE)/vltstd -c -o $@ $<
+
+# The model archive (Vbatch__ALL.a or libVbatch.a, by Verilator version) is
+# linked with the runtime compiled here, not with libverilated.a
+$(BATCH_LIB): $(BATCH_C_OBJS) $(RTL_FILES) $(BATCH_SRCS) $(VERIF_LIB_DIR)/fp_softmax_model.h
+	@echo "--- Verilating $(DUT) WIDTH=$(WIDTH) for Python ---"
+	$(VERILATOR) $(BATCH_FLAGS) $(RTL_FILES)
+	$(CXX) $(CXXFLAGS) $(BATCH_CXXFLAGS) -o $@ $(BATCH_SRCS) $(BATCH_RT_SRCS) $(BATCH_C_OBJS) \
+		$$(ls $(BATCH_OBJ_DIR)/*.a | grep -v libverilated) -pthread -lm
+
+pylib: $(BATCH_LIB)
+	@echo "--- Built $(BATCH_LIB) ---"
+
+clean:
+	@echo "--- Cleaning up Verilator build ---"
+	rm -rf $(BUILD_DIR)